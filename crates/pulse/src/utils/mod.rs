@@ -22,7 +22,9 @@ pub async fn push_actions(
         .sign_transaction(&txn_json, &required_keys, &chain_info.chain_id)
         .await?;
     let signed_tx = SignedTransaction::new(txn, signed.signatures, vec![]);
-    let packed_tx = PackedTransaction::from_signed_transaction(signed_tx)?;
+    // Compresses when it helps (contract deploys, mostly); small
+    // transactions go out uncompressed.
+    let packed_tx = PackedTransaction::from_signed_transaction_compressed(signed_tx)?;
     let response = api_client.issue_tx(&packed_tx).await?;
     Ok(response.tx_id)
 }
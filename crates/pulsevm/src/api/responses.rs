@@ -1,6 +1,13 @@
-use pulsevm_core::{block::BlockTimestamp, id::Id, name::Name, utils::Base64Bytes};
+use pulsevm_core::{
+    block::{BlockTimestamp, SignedBlock},
+    id::Id,
+    name::Name,
+    transaction::{ActionTrace, TransactionTrace},
+    utils::Base64Bytes,
+};
 use pulsevm_crypto::Digest;
 use serde::Serialize;
+use serde_json::value::RawValue;
 
 #[derive(Serialize, Clone, Default)]
 pub struct GetInfoResponse {
@@ -31,6 +38,33 @@ pub struct GetInfoResponse {
 pub struct IssueTxResponse {
     #[serde(rename(serialize = "txID"))]
     pub tx_id: Id,
+    /// Trace of the speculative execution the transaction passed before it
+    /// was admitted to the mempool; console output, receipts and resource
+    /// usage are available to the caller without waiting for inclusion.
+    pub processed: TransactionTrace,
+}
+
+/// One event on the `pulsevm.subscribeBlocks` stream, pushed per accepted
+/// block. The header fields cover what explorers poll `get_info` for; the
+/// full block is included only when the subscription asked for it.
+#[derive(Serialize, Clone)]
+pub struct BlockNotification {
+    pub block_num: u32,
+    pub block_id: Id,
+    pub timestamp: BlockTimestamp,
+    pub producer: Name,
+    pub transaction_count: u32,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub block: Option<SignedBlock>,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct GetActionsResponse {
+    pub actions: Vec<ActionTrace>,
+    /// Total indexed actions for the account, across all pages.
+    pub total: u64,
+    /// `pos` that continues the walk, present only when more may remain.
+    pub next_pos: Option<u64>,
 }
 
 #[derive(Serialize, Clone, Default)]
@@ -39,6 +73,126 @@ pub struct GetCodeHashResponse {
     pub code_hash: Id,
 }
 
+#[derive(Serialize, Clone, Default)]
+pub struct ExecutionAccountingRow {
+    pub receiver: Name,
+    pub contract: Name,
+    pub action: Name,
+    pub count: u64,
+    pub wall_us: u64,
+    pub cpu_points: u64,
+    pub host_calls: u64,
+    pub ram_delta: i64,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct GetExecutionAccountingResponse {
+    pub first_block_num: u32,
+    pub last_block_num: u32,
+    pub blocks_aggregated: u32,
+    // Heaviest (receiver, contract, action) rows first, by wall time.
+    pub rows: Vec<ExecutionAccountingRow>,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct SlowTransactionAction {
+    pub receiver: Name,
+    pub contract: Name,
+    pub action: Name,
+    pub elapsed_us: u32,
+}
+
+/// One slow execution pass of a transaction; a transaction that was slow on
+/// several paths (push, verify, accept) appears once per pass.
+#[derive(Serialize, Clone, Default)]
+pub struct SlowTransactionRow {
+    pub trx_id: Id,
+    pub block_num: u32,
+    pub wall_us: u64,
+    pub cpu_us: u64,
+    pub net_bytes: u64,
+    pub host_calls: u64,
+    /// True action count; `actions` is truncated past the tracer's cap.
+    pub actions_total: u32,
+    pub actions: Vec<SlowTransactionAction>,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct GetSlowTransactionsResponse {
+    pub threshold_us: u64,
+    // Newest slow pass first.
+    pub records: Vec<SlowTransactionRow>,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct GetExecutionProfileResponse {
+    pub actions: u64,
+    pub p50_us: u64,
+    pub p95_us: u64,
+    pub p99_us: u64,
+    pub profiling_enabled: bool,
+    // Collapsed-stack lines for flamegraph tooling; empty unless the node
+    // runs with `profile_actions` enabled.
+    pub folded: String,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct FfiStatsSite {
+    pub name: String,
+    pub calls: u64,
+    pub cycles: u64,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct GetFfiStatsResponse {
+    pub enabled: bool,
+    // Blocks executed while the collector was enabled; the divisor for
+    // reading the site totals as per-block averages.
+    pub blocks: u64,
+    // Heaviest call sites first, by cycles.
+    pub sites: Vec<FfiStatsSite>,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct ReadOnlyCallResponse {
+    pub return_value: Base64Bytes,
+    pub console: String,
+    /// Metering points the call consumed; informational only, nothing is
+    /// billed to an account for a read-only call.
+    pub cpu_usage: u64,
+}
+
+#[derive(Serialize, Clone)]
+pub struct GetTableRowsResponse {
+    /// Pre-serialized JSON array, spliced together from the raw pages the
+    /// database returns. For a large scan, parsing every row into a
+    /// `serde_json::Value` just so the RPC layer can serialize it again
+    /// costs more than the scan itself; `RawValue` writes the page bytes
+    /// straight into the response body.
+    pub rows: Box<RawValue>,
+    pub more: bool,
+    pub next_key: String,
+    /// The same token as `next_key` under its own name, so clients can feed
+    /// it back as `cursor` without knowing which bound it maps to.
+    pub cursor: String,
+}
+
+#[derive(Serialize, Clone, Default)]
+pub struct GetTableRowsBinaryResponse {
+    /// Raw row bytes straight out of the database, each row prefixed with
+    /// its little-endian u32 length, base64 over the wire. The server does
+    /// no ABI conversion in this mode; decoding is the consumer's job.
+    pub rows: Base64Bytes,
+    pub more: bool,
+    pub next_key: String,
+    /// The same token as `next_key` under its own name, so clients can feed
+    /// it back as `cursor` without knowing which bound it maps to.
+    pub cursor: String,
+    /// sha256 of the code account's stored ABI, identifying the revision
+    /// the raw bytes decode against.
+    pub abi_hash: String,
+}
+
 #[derive(Serialize, Clone, Default)]
 pub struct GetRawABIResponse {
     pub account_name: Name,
@@ -1,24 +1,50 @@
 use std::{sync::Arc, time::Duration};
 
-use pulsevm_core::mempool::Mempool;
+use pulsevm_constants::BLOCK_INTERVAL_MS;
+use pulsevm_core::{
+    controller::Controller,
+    mempool::{Mempool, MempoolAdmission},
+};
+use spdlog::warn;
 use tokio::{
     sync::{Notify, RwLock},
     task::JoinHandle,
-    time::interval,
+    time::{Instant, interval},
 };
 
+// How often arriving transactions are speculatively executed into the
+// controller's pending block between block intervals. Short enough that a
+// transaction rarely waits long before execution, long enough that an idle
+// node isn't spinning on the controller lock.
+const PUMP_INTERVAL_MS: u64 = 25;
+
+// Minimum spacing between blocks when a transaction arrives on an
+// otherwise idle chain. Off-peak, a lone transaction gets a block within
+// roughly a pump tick plus this gap instead of waiting out the full block
+// interval; the gap keeps a sudden burst after a quiet stretch from
+// producing a flurry of one-transaction blocks.
+const MIN_BLOCK_GAP_MS: u64 = 50;
+
 #[derive(Clone)]
 pub struct BlockTimer {
+    pub controller: Arc<RwLock<Controller>>,
     pub mempool: Arc<RwLock<Mempool>>,
+    pub admission: Arc<MempoolAdmission>,
     pub notify_block_build: Arc<Notify>,
     pub server_address: Arc<RwLock<Option<String>>>,
     pub block_timer: Arc<RwLock<Option<JoinHandle<()>>>>,
 }
 
 impl BlockTimer {
-    pub fn new(mempool: Arc<RwLock<Mempool>>) -> Self {
+    pub fn new(
+        controller: Arc<RwLock<Controller>>,
+        mempool: Arc<RwLock<Mempool>>,
+        admission: Arc<MempoolAdmission>,
+    ) -> Self {
         BlockTimer {
+            controller,
             mempool,
+            admission,
             notify_block_build: Arc::new(Notify::new()),
             server_address: Arc::new(RwLock::new(None)),
             block_timer: Arc::new(RwLock::new(None)),
@@ -40,11 +66,47 @@ impl BlockTimer {
         self.notify_block_build.notify_one();
     }
 
-    pub async fn check_block_build(&self) {
-        let mempool = self.mempool.read().await;
+    pub async fn has_block_work(&self) -> bool {
+        // Transactions sitting in the admission shards count too; they get
+        // absorbed into the mempool when the block is actually built.
+        if !self.admission.is_empty() {
+            return true;
+        }
 
-        if mempool.has_transactions() {
-            self.request_block_build().await;
+        {
+            let mempool = self.mempool.read().await;
+
+            if mempool.has_transactions() {
+                return true;
+            }
+        }
+
+        // Transactions already executed into the pending block no longer
+        // sit in the mempool, but they still need a block sealed around
+        // them.
+        let controller = self.controller.read().await;
+        controller.has_pending_block_work()
+    }
+
+    /// Applies newly arrived transactions into the controller's pending
+    /// block, so by the time the block interval fires the block is already
+    /// executed and `build_block` only seals it. Cheap when idle: the
+    /// controller lock is only taken when there is something to apply.
+    pub async fn pump_pending_block(&self) {
+        if self.admission.is_empty() {
+            let mempool = self.mempool.read().await;
+            if !mempool.has_transactions() {
+                return;
+            }
+        }
+
+        // Same lock order as the BuildBlock handler: controller, then
+        // mempool.
+        let mut controller = self.controller.write().await;
+        let mut mempool = self.mempool.write().await;
+        mempool.absorb(&self.admission);
+        if let Err(e) = controller.pump_pending_block(&mut mempool) {
+            warn!("failed to pump pending block: {}", e);
         }
     }
 
@@ -55,10 +117,35 @@ impl BlockTimer {
 
 async fn build_block_timer(timer: BlockTimer) -> JoinHandle<()> {
     return tokio::spawn(async move {
-        let mut ticker = interval(Duration::from_millis(500));
+        let block_interval = Duration::from_millis(BLOCK_INTERVAL_MS as u64);
+        let min_gap = Duration::from_millis(MIN_BLOCK_GAP_MS);
+        let mut build_ticker = interval(block_interval);
+        let mut pump_ticker = interval(Duration::from_millis(PUMP_INTERVAL_MS));
+        let mut last_build = Instant::now();
+        // Whether the chain has been idle at some point since the last
+        // block was requested. A transaction arriving after an idle
+        // stretch is latency-sensitive and only waits out the minimum
+        // gap; when work is present back to back the chain is under
+        // sustained load and the full block interval applies, so peak
+        // cadence is unchanged.
+        let mut saw_idle = true;
         loop {
-            ticker.tick().await;
-            timer.check_block_build().await;
+            tokio::select! {
+                _ = build_ticker.tick() => {}
+                _ = pump_ticker.tick() => timer.pump_pending_block().await,
+            }
+
+            if !timer.has_block_work().await {
+                saw_idle = true;
+                continue;
+            }
+
+            let required_gap = if saw_idle { min_gap } else { block_interval };
+            if last_build.elapsed() >= required_gap {
+                timer.request_block_build().await;
+                last_build = Instant::now();
+                saw_idle = false;
+            }
         }
     });
 }
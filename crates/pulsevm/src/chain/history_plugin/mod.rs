@@ -1,31 +1,72 @@
-use pulsevm_core::{block::SignedBlock, error::ChainError};
-use tokio::sync::broadcast::Receiver;
+use std::sync::Arc;
 
+use pulsevm_core::{ChainError, controller::Controller, name::Name};
+use tokio::sync::RwLock;
+
+use crate::api::GetActionsResponse;
+
+/// Page size when the caller gives no limit.
+const DEFAULT_ACTIONS_PAGE: usize = 100;
+/// Hard ceiling on one page; each returned action costs one trace-log
+/// block read, so an unbounded limit would let a single query pin the
+/// controller lock for the whole history of a busy account.
+const MAX_ACTIONS_PAGE: usize = 1000;
+
+/// Account-history query layer over the controller's account-action
+/// index.
+///
+/// The index itself — receiver account → receive-sequence-ordered
+/// action locations — is maintained by the state-history writer thread
+/// as each accepted block's traces are appended, since the receive
+/// sequences only exist in execution traces and that thread already
+/// walks them. This plugin owns the query side: pagination policy and
+/// assembling `get_actions` pages without ever replaying a trace-log
+/// range.
+#[derive(Clone)]
 pub struct HistoryPlugin {
-    on_accepted_block: Receiver<SignedBlock>,
-    on_accepted_block_handle: Option<tokio::task::JoinHandle<()>>,
+    controller: Arc<RwLock<Controller>>,
 }
 
 impl HistoryPlugin {
-    pub fn new(on_accepted_block: Receiver<SignedBlock>) -> Self {
-        Self {
-            on_accepted_block,
-            on_accepted_block_handle: None,
-        }
+    pub fn new(controller: Arc<RwLock<Controller>>) -> Self {
+        Self { controller }
     }
 
-    fn initialize(&mut self) -> Result<(), ChainError> {
-        self.on_accepted_block_handle = Some(tokio::spawn({
-            let mut on_accepted_block = self.on_accepted_block.resubscribe();
-
-            async move {
-                while let Ok(block) = on_accepted_block.recv().await {
-                    // Handle the accepted block
-                    // For example, log it or store it in a database
-                    println!("Accepted block: {}", block.block_num());
-                }
-            }
-        }));
-        Ok(())
+    /// One page of `account`'s delivered actions, ordered by receive
+    /// sequence starting at `pos` (default 0). `next_pos`, when set, is
+    /// the `pos` that continues the walk on the next call.
+    pub async fn get_actions(
+        &self,
+        account: Name,
+        pos: Option<u64>,
+        limit: Option<u32>,
+    ) -> Result<GetActionsResponse, ChainError> {
+        let pos = pos.unwrap_or(0);
+        let limit = limit
+            .map(|l| l as usize)
+            .unwrap_or(DEFAULT_ACTIONS_PAGE)
+            .clamp(1, MAX_ACTIONS_PAGE);
+
+        let controller = self.controller.read().await;
+        let (actions, total) = controller.get_account_actions(&account, pos, limit)?;
+        drop(controller);
+
+        // Indexed actions always carry a receipt — the index is built
+        // from them — so a full page's last receive sequence tells the
+        // caller where the next page starts.
+        let next_pos = if actions.len() == limit {
+            actions
+                .last()
+                .and_then(|a| a.receipt.as_ref())
+                .map(|r| r.recv_sequence + 1)
+        } else {
+            None
+        };
+
+        Ok(GetActionsResponse {
+            actions,
+            total,
+            next_pos,
+        })
     }
 }
@@ -1,8 +1,13 @@
 mod block_timer;
 pub use block_timer::*;
 
+mod history_plugin;
+pub use history_plugin::*;
+
 mod network;
 pub use network::*;
 
 mod service;
 pub use service::*;
+
+pub mod wire;
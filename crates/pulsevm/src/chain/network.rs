@@ -1,16 +1,29 @@
-use std::{collections::HashMap, time::Duration};
+use std::{
+    collections::{HashMap, VecDeque},
+    sync::{
+        Arc, Mutex,
+        atomic::{AtomicU64, Ordering},
+    },
+    time::{Duration, Instant},
+};
 
-use pulsevm_core::{ChainError, id::NodeId};
+use pulsevm_core::{ChainError, id::NodeId, transaction::PackedTransaction};
 use pulsevm_crypto::Bytes;
 use pulsevm_grpc::appsender::{SendAppGossipMsg, app_sender_client::AppSenderClient};
 use pulsevm_proc_macros::{NumBytes, Read, Write};
 use pulsevm_serialization::{NumBytes, Read, Write};
+use spdlog::warn;
+use tokio::sync::{Notify, RwLock, Semaphore, mpsc};
 use tonic::Request;
 
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 #[repr(u16)]
 pub enum GossipType {
     Transaction = 0,
+    // Many packed transactions in one frame (`Vec<PackedTransaction>`
+    // payload), built by the gossip batcher. Single-transaction frames are
+    // still accepted from peers running older builds.
+    TransactionBatch = 1,
 }
 
 impl NumBytes for GossipType {
@@ -24,6 +37,7 @@ impl Read for GossipType {
         let value = u16::read(bytes, pos)?;
         match value {
             0 => Ok(GossipType::Transaction),
+            1 => Ok(GossipType::TransactionBatch),
             _ => Err(pulsevm_serialization::ReadError::CustomError(format!(
                 "invalid GossipType value: {}",
                 value
@@ -42,6 +56,37 @@ impl Write for GossipType {
     }
 }
 
+/// Scheduling class of an inbound gossip frame. Consensus-critical frames
+/// are dequeued before bulk ones and get a more generous per-peer budget,
+/// so they never wait behind transaction gossip under load.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum GossipClass {
+    Consensus,
+    Bulk,
+}
+
+impl GossipType {
+    pub fn class(&self) -> GossipClass {
+        match self {
+            // Transactions are the bulk traffic; blocks and votes reach us
+            // through consensus RPCs, not app gossip, so every type gossiped
+            // today is bulk. New consensus-critical types slot in here.
+            GossipType::Transaction | GossipType::TransactionBatch => GossipClass::Bulk,
+        }
+    }
+}
+
+/// Classifies a raw frame from its leading type tag without deserializing
+/// the payload, so the intake can prioritize and budget before spending any
+/// decode CPU. Unknown tags classify as bulk: a peer cannot earn priority
+/// with bytes we will fail to parse anyway.
+fn peek_class(msg: &[u8]) -> GossipClass {
+    match GossipType::read(msg, &mut 0) {
+        Ok(gossip_type) => gossip_type.class(),
+        Err(_) => GossipClass::Bulk,
+    }
+}
+
 #[derive(Debug, Clone, PartialEq, Eq, Write, Read, NumBytes)]
 pub struct Gossipable {
     pub gossip_type: GossipType,
@@ -73,6 +118,361 @@ impl Gossipable {
     }
 }
 
+/// How long a transaction may sit in the batcher before its frame is sent.
+/// Well under a block interval, so batching never delays inclusion.
+const BATCH_WINDOW: Duration = Duration::from_millis(10);
+/// Flush early once the batched transactions reach this many payload bytes,
+/// keeping frames comfortably inside one datagram-sized app-gossip message.
+const BATCH_MAX_BYTES: usize = 64 * 1024;
+
+/// Aggregates submitted transactions into `TransactionBatch` gossip frames.
+///
+/// Sending one app-gossip message per transaction costs a gRPC round trip to
+/// the engine each; at a few thousand TPS that per-message overhead dwarfs
+/// the payload. Submissions are queued, and a background task flushes one
+/// frame per time window (or earlier on the byte cap), so the steady-state
+/// send rate is frames per window, not per transaction. Send failures are
+/// logged, not returned: by the time a frame fails the submitter has long
+/// been answered, and the transaction still reaches peers via block gossip.
+pub struct GossipBatcher {
+    tx: mpsc::UnboundedSender<PackedTransaction>,
+}
+
+impl GossipBatcher {
+    pub fn spawn(network_manager: Arc<RwLock<NetworkManager>>) -> Self {
+        let (tx, rx) = mpsc::unbounded_channel();
+        tokio::spawn(batcher_loop(network_manager, rx));
+        GossipBatcher { tx }
+    }
+
+    /// Queues a transaction for the next gossip frame.
+    pub fn submit(&self, transaction: PackedTransaction) {
+        // Fails only if the batcher task is gone, i.e. at shutdown.
+        let _ = self.tx.send(transaction);
+    }
+}
+
+async fn batcher_loop(
+    network_manager: Arc<RwLock<NetworkManager>>,
+    mut rx: mpsc::UnboundedReceiver<PackedTransaction>,
+) {
+    // The outer recv blocks until there is traffic, so an idle node runs no
+    // timers at all; the window only starts with a batch's first transaction.
+    while let Some(first) = rx.recv().await {
+        let mut batch_bytes = first.num_bytes();
+        let mut batch = vec![first];
+        let deadline = Instant::now() + BATCH_WINDOW;
+
+        while batch_bytes < BATCH_MAX_BYTES {
+            let remaining = deadline.saturating_duration_since(Instant::now());
+            if remaining.is_zero() {
+                break;
+            }
+            match tokio::time::timeout(remaining, rx.recv()).await {
+                Ok(Some(transaction)) => {
+                    batch_bytes += transaction.num_bytes();
+                    batch.push(transaction);
+                }
+                // Channel closed; send what we have and let the outer loop
+                // exit on its next recv.
+                Ok(None) => break,
+                // Window elapsed.
+                Err(_) => break,
+            }
+        }
+
+        let gossipable = match Gossipable::new(GossipType::TransactionBatch, batch) {
+            Ok(gossipable) => gossipable,
+            Err(e) => {
+                warn!("failed to build transaction gossip batch: {}", e);
+                continue;
+            }
+        };
+        if let Err(e) = network_manager.read().await.gossip(gossipable).await {
+            warn!("failed to gossip transaction batch: {}", e);
+        }
+    }
+}
+
+/// Per-peer budget for bulk gossip payload bytes, refilled continuously.
+/// Honest peers batching at BATCH_MAX_BYTES per window sit well under this;
+/// a spam peer exhausts its own bucket without touching anyone else's.
+const BULK_BYTES_PER_SEC: f64 = 256.0 * 1024.0;
+const BULK_BURST_BYTES: f64 = 512.0 * 1024.0;
+/// Consensus-class frames are small and latency-sensitive; the budget only
+/// exists so a misbehaving peer cannot flood the priority queue.
+const CONSENSUS_BYTES_PER_SEC: f64 = 1024.0 * 1024.0;
+const CONSENSUS_BURST_BYTES: f64 = 1024.0 * 1024.0;
+/// Queued-but-undecoded frames per class; beyond this the oldest is dropped.
+/// Old bulk gossip is the right thing to shed — its transactions are likely
+/// already in the mempool or about to arrive again in a block.
+const BULK_QUEUE_MAX: usize = 1024;
+const CONSENSUS_QUEUE_MAX: usize = 4096;
+/// Concurrent decode jobs on the blocking pool, so a gossip burst cannot
+/// crowd out the pool's other users (signature recovery, state queries).
+const DECODE_CONCURRENCY: usize = 4;
+/// Minimum interval between drop-summary log lines.
+const DROP_REPORT_INTERVAL: Duration = Duration::from_secs(10);
+
+/// A continuously-refilling token bucket, charged in payload bytes.
+struct TokenBucket {
+    tokens: f64,
+    last_refill: Instant,
+}
+
+impl TokenBucket {
+    fn full(burst: f64, now: Instant) -> Self {
+        TokenBucket {
+            tokens: burst,
+            last_refill: now,
+        }
+    }
+
+    fn try_take(&mut self, now: Instant, rate: f64, burst: f64, cost: f64) -> bool {
+        let elapsed = now.saturating_duration_since(self.last_refill).as_secs_f64();
+        self.tokens = (self.tokens + elapsed * rate).min(burst);
+        self.last_refill = now;
+        if self.tokens < cost {
+            return false;
+        }
+        self.tokens -= cost;
+        true
+    }
+}
+
+struct PeerBuckets {
+    bulk: TokenBucket,
+    consensus: TokenBucket,
+    last_seen: Instant,
+}
+
+struct IntakeQueues {
+    consensus: VecDeque<(NodeId, Vec<u8>)>,
+    bulk: VecDeque<(NodeId, Vec<u8>)>,
+    peers: HashMap<NodeId, PeerBuckets>,
+}
+
+/// Inbound gossip intake: per-peer token buckets, two priority classes and
+/// bounded drop-oldest queues in front of the decode pool.
+///
+/// `app_gossip` used to hand every frame straight to `spawn_blocking`, so
+/// all peers shared one fate: a spam peer's frames consumed the same decode
+/// CPU as everyone else's, and nothing bounded the backlog. The intake
+/// classifies each frame from its type tag alone, charges the sending
+/// peer's bucket for the payload bytes, and queues survivors by class; a
+/// fixed-size worker pool drains consensus frames before bulk ones. Drops
+/// are counted and summarized periodically rather than logged per frame —
+/// under attack, per-drop logging is itself a resource leak.
+pub struct GossipIntake {
+    queues: Mutex<IntakeQueues>,
+    notify: Notify,
+    dropped_throttled: AtomicU64,
+    dropped_overflow: AtomicU64,
+    last_report: Mutex<Instant>,
+}
+
+impl GossipIntake {
+    /// Starts the intake and its decode worker. `decode` runs on the
+    /// blocking pool with the sending peer and the raw frame.
+    pub fn spawn<F>(decode: F) -> Arc<Self>
+    where
+        F: Fn(NodeId, Vec<u8>) + Send + Sync + 'static,
+    {
+        let now = Instant::now();
+        let intake = Arc::new(GossipIntake {
+            queues: Mutex::new(IntakeQueues {
+                consensus: VecDeque::new(),
+                bulk: VecDeque::new(),
+                peers: HashMap::new(),
+            }),
+            notify: Notify::new(),
+            dropped_throttled: AtomicU64::new(0),
+            dropped_overflow: AtomicU64::new(0),
+            last_report: Mutex::new(now),
+        });
+        tokio::spawn(intake_loop(intake.clone(), Arc::new(decode)));
+        intake
+    }
+
+    /// Admits or drops a raw frame from `peer`. Cheap enough for the
+    /// consensus-facing gRPC handler: one classify, one bucket charge, one
+    /// queue push — no deserialization.
+    pub fn submit(&self, peer: NodeId, msg: Vec<u8>) {
+        let class = peek_class(&msg);
+        let now = Instant::now();
+        let mut queues = self.queues.lock().unwrap();
+
+        let buckets = queues.peers.entry(peer).or_insert_with(|| PeerBuckets {
+            bulk: TokenBucket::full(BULK_BURST_BYTES, now),
+            consensus: TokenBucket::full(CONSENSUS_BURST_BYTES, now),
+            last_seen: now,
+        });
+        buckets.last_seen = now;
+        let cost = msg.len() as f64;
+        let admitted = match class {
+            GossipClass::Bulk => {
+                buckets
+                    .bulk
+                    .try_take(now, BULK_BYTES_PER_SEC, BULK_BURST_BYTES, cost)
+            }
+            GossipClass::Consensus => buckets.consensus.try_take(
+                now,
+                CONSENSUS_BYTES_PER_SEC,
+                CONSENSUS_BURST_BYTES,
+                cost,
+            ),
+        };
+        if !admitted {
+            drop(queues);
+            self.dropped_throttled.fetch_add(1, Ordering::Relaxed);
+            self.maybe_report(now);
+            return;
+        }
+
+        let (queue, max) = match class {
+            GossipClass::Consensus => (&mut queues.consensus, CONSENSUS_QUEUE_MAX),
+            GossipClass::Bulk => (&mut queues.bulk, BULK_QUEUE_MAX),
+        };
+        queue.push_back((peer, msg));
+        let overflowed = queue.len() > max;
+        if overflowed {
+            queue.pop_front();
+        }
+        drop(queues);
+        if overflowed {
+            self.dropped_overflow.fetch_add(1, Ordering::Relaxed);
+            self.maybe_report(now);
+        }
+        self.notify.notify_one();
+    }
+
+    /// Releases a departed peer's buckets. Peers that vanish without a
+    /// disconnect are swept once the table outgrows its expected size.
+    pub fn forget_peer(&self, peer: &NodeId) {
+        self.queues.lock().unwrap().peers.remove(peer);
+    }
+
+    fn maybe_report(&self, now: Instant) {
+        let mut last_report = self.last_report.lock().unwrap();
+        if now.saturating_duration_since(*last_report) < DROP_REPORT_INTERVAL {
+            return;
+        }
+        *last_report = now;
+        drop(last_report);
+
+        let throttled = self.dropped_throttled.swap(0, Ordering::Relaxed);
+        let overflow = self.dropped_overflow.swap(0, Ordering::Relaxed);
+        warn!(
+            "gossip intake dropped {} frames over peer budget, {} to queue overflow, in the last {:?}",
+            throttled, overflow, DROP_REPORT_INTERVAL
+        );
+
+        // Piggyback the sweep of idle peer buckets on the report path; it
+        // only matters under churn, which is when drops happen too.
+        let mut queues = self.queues.lock().unwrap();
+        queues
+            .peers
+            .retain(|_, b| now.saturating_duration_since(b.last_seen) < Duration::from_secs(60));
+    }
+}
+
+async fn intake_loop<F>(intake: Arc<GossipIntake>, decode: Arc<F>)
+where
+    F: Fn(NodeId, Vec<u8>) + Send + Sync + 'static,
+{
+    let decode_slots = Arc::new(Semaphore::new(DECODE_CONCURRENCY));
+    loop {
+        let next = {
+            let mut queues = intake.queues.lock().unwrap();
+            // Strict priority: bulk only moves while the consensus queue is
+            // empty. The consensus cap bounds how long bulk can starve.
+            queues
+                .consensus
+                .pop_front()
+                .or_else(|| queues.bulk.pop_front())
+        };
+        match next {
+            Some((peer, msg)) => {
+                // Holding the permit across the blocking job bounds decode
+                // parallelism; acquire fails only at shutdown.
+                let Ok(permit) = decode_slots.clone().acquire_owned().await else {
+                    return;
+                };
+                let decode = decode.clone();
+                tokio::task::spawn_blocking(move || {
+                    decode(peer, msg);
+                    drop(permit);
+                });
+            }
+            // notify_one stores a permit when nobody waits, so a submit
+            // racing this await is not lost.
+            None => intake.notify.notified().await,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn intake_without_worker() -> GossipIntake {
+        let now = Instant::now();
+        GossipIntake {
+            queues: Mutex::new(IntakeQueues {
+                consensus: VecDeque::new(),
+                bulk: VecDeque::new(),
+                peers: HashMap::new(),
+            }),
+            notify: Notify::new(),
+            dropped_throttled: AtomicU64::new(0),
+            dropped_overflow: AtomicU64::new(0),
+            last_report: Mutex::new(now),
+        }
+    }
+
+    #[test]
+    fn token_bucket_denies_past_burst_and_refills() {
+        let start = Instant::now();
+        let mut bucket = TokenBucket::full(100.0, start);
+        assert!(bucket.try_take(start, 10.0, 100.0, 100.0));
+        // Burst spent, nothing refilled yet.
+        assert!(!bucket.try_take(start, 10.0, 100.0, 1.0));
+        // One second at 10 tokens/sec covers a cost of 10, not 11.
+        let later = start + Duration::from_secs(1);
+        assert!(bucket.try_take(later, 10.0, 100.0, 10.0));
+        assert!(!bucket.try_take(later, 10.0, 100.0, 1.0));
+    }
+
+    #[test]
+    fn over_budget_peer_frames_are_dropped() {
+        let intake = intake_without_worker();
+        let peer = NodeId([1u8; 20]);
+        // A frame bigger than the bulk burst never fits.
+        let oversized = vec![0u8; BULK_BURST_BYTES as usize + 16];
+        intake.submit(peer, oversized);
+        assert_eq!(intake.dropped_throttled.load(Ordering::Relaxed), 1);
+        assert!(intake.queues.lock().unwrap().bulk.is_empty());
+        // A small frame from the same peer still gets through.
+        intake.submit(peer, vec![0u8; 64]);
+        assert_eq!(intake.queues.lock().unwrap().bulk.len(), 1);
+    }
+
+    #[test]
+    fn bulk_queue_overflow_drops_oldest() {
+        let intake = intake_without_worker();
+        // Tiny frames so the peer budget never interferes.
+        for i in 0..(BULK_QUEUE_MAX + 3) {
+            let peer = NodeId([(i % 251) as u8; 20]);
+            intake.submit(peer, vec![0u8; 4]);
+        }
+        let queues = intake.queues.lock().unwrap();
+        assert_eq!(queues.bulk.len(), BULK_QUEUE_MAX);
+        assert_eq!(intake.dropped_overflow.load(Ordering::Relaxed), 3);
+        // The survivors are the newest frames: the oldest senders are gone.
+        assert_eq!(queues.bulk.front().unwrap().0, NodeId([3u8; 20]));
+    }
+}
+
 pub struct ConnectedNode {
     #[allow(dead_code)]
     pub id: NodeId,
@@ -1,28 +1,50 @@
-use std::{collections::BTreeSet, str::FromStr, sync::Arc};
+use std::{
+    collections::BTreeSet,
+    num::NonZeroUsize,
+    str::FromStr,
+    sync::{Arc, OnceLock},
+};
 
-use jsonrpsee::{proc_macros::rpc, types::ErrorObjectOwned};
+use jsonrpsee::{
+    PendingSubscriptionSink, RpcModule, SubscriptionMessage, core::SubscriptionResult,
+    proc_macros::rpc, types::ErrorObjectOwned,
+};
+use lru::LruCache;
 use pulsevm_core::{
+    Database,
     abi::AbiDefinition,
     authorization_manager::AuthorizationManager,
     block::SignedBlock,
-    controller::Controller,
+    block_profiler::BLOCK_PROFILER,
+    controller::{Controller, HeadBlockHandle},
+    execution_accounting::EXEC_ACCOUNTING,
+    ffi_stats::FFI_STATS,
     crypto::{PublicKey, Signature},
     id::Id,
-    mempool::Mempool,
+    memory_ledger::MEMORY_LEDGER,
+    mempool::MempoolAdmission,
     name::Name,
+    slow_transactions::SLOW_TRX_LOG,
     time::{TimePoint, seconds},
-    transaction::{PackedTransaction, Transaction, TransactionCompression},
+    transaction::{PackedTransaction, Transaction, TransactionCompression, TransactionTrace},
     utils::{Base64Bytes, I32Flex},
 };
 use pulsevm_crypto::{Bytes, Digest};
 use pulsevm_serialization::Read;
-use serde_json::Value;
-use tokio::sync::RwLock;
+use serde::Deserialize;
+use serde_json::{Value, value::RawValue};
+use tokio::sync::{Mutex, RwLock, broadcast::error::RecvError};
 use tonic::async_trait;
 
 use crate::{
-    api::{GetCodeHashResponse, GetInfoResponse, GetRawABIResponse, IssueTxResponse},
-    chain::{GossipType, Gossipable, NetworkManager},
+    api::{
+        BlockNotification, ExecutionAccountingRow, FfiStatsSite, GetActionsResponse,
+        GetCodeHashResponse, GetExecutionAccountingResponse, GetExecutionProfileResponse,
+        GetFfiStatsResponse, GetInfoResponse, GetRawABIResponse, GetSlowTransactionsResponse,
+        GetTableRowsBinaryResponse, GetTableRowsResponse, IssueTxResponse, ReadOnlyCallResponse,
+        SlowTransactionAction, SlowTransactionRow,
+    },
+    chain::{GossipBatcher, HistoryPlugin, NetworkManager},
 };
 
 #[rpc(server)]
@@ -34,6 +56,7 @@ pub trait Rpc {
         compression: TransactionCompression,
         packed_context_free_data: Bytes,
         packed_trx: Bytes,
+        dry_run: Option<bool>,
     ) -> Result<IssueTxResponse, ErrorObjectOwned>;
 
     #[method(name = "pulsevm.getABI")]
@@ -46,6 +69,14 @@ pub trait Rpc {
         expected_core_symbol: Option<String>,
     ) -> Result<Value, ErrorObjectOwned>;
 
+    #[method(name = "pulsevm.getActions")]
+    async fn get_actions(
+        &self,
+        account_name: Name,
+        pos: Option<u64>,
+        limit: Option<u32>,
+    ) -> Result<GetActionsResponse, ErrorObjectOwned>;
+
     #[method(name = "pulsevm.getBlock")]
     async fn get_block(&self, block_num_or_id: String) -> Result<SignedBlock, ErrorObjectOwned>;
 
@@ -61,14 +92,39 @@ pub trait Rpc {
         code: Name,
         account: Name,
         symbol: Option<String>,
-    ) -> Result<Value, ErrorObjectOwned>;
+    ) -> Result<Box<RawValue>, ErrorObjectOwned>;
 
     #[method(name = "pulsevm.getCurrencyStats")]
     async fn get_currency_stats(
         &self,
         code: Name,
         symbol: String,
-    ) -> Result<Value, ErrorObjectOwned>;
+    ) -> Result<Box<RawValue>, ErrorObjectOwned>;
+
+    #[method(name = "pulsevm.getDbAllocationStats")]
+    async fn get_db_allocation_stats(&self) -> Result<Box<RawValue>, ErrorObjectOwned>;
+
+    #[method(name = "pulsevm.getDbCommitStats")]
+    async fn get_db_commit_stats(&self) -> Result<Box<RawValue>, ErrorObjectOwned>;
+
+    #[method(name = "pulsevm.getExecutionAccounting")]
+    async fn get_execution_accounting(
+        &self,
+        last_blocks: Option<u32>,
+    ) -> Result<GetExecutionAccountingResponse, ErrorObjectOwned>;
+
+    #[method(name = "pulsevm.getExecutionProfile")]
+    async fn get_execution_profile(
+        &self,
+        reset: Option<bool>,
+    ) -> Result<GetExecutionProfileResponse, ErrorObjectOwned>;
+
+    #[method(name = "pulsevm.getFfiStats")]
+    async fn get_ffi_stats(
+        &self,
+        enable: Option<bool>,
+        reset: Option<bool>,
+    ) -> Result<GetFfiStatsResponse, ErrorObjectOwned>;
 
     #[method(name = "pulsevm.getInfo")]
     async fn get_info(&self) -> Result<GetInfoResponse, ErrorObjectOwned>;
@@ -87,6 +143,12 @@ pub trait Rpc {
         candidate_keys: BTreeSet<PublicKey>,
     ) -> Result<BTreeSet<PublicKey>, ErrorObjectOwned>;
 
+    #[method(name = "pulsevm.getSlowTransactions")]
+    async fn get_slow_transactions(
+        &self,
+        threshold_us: Option<u64>,
+    ) -> Result<GetSlowTransactionsResponse, ErrorObjectOwned>;
+
     #[method(name = "pulsevm.getTableByScope")]
     async fn get_table_by_scope(
         &self,
@@ -96,7 +158,7 @@ pub trait Rpc {
         upper_bound: Option<String>,
         limit: Option<I32Flex>,
         reverse: Option<bool>,
-    ) -> Result<Value, ErrorObjectOwned>;
+    ) -> Result<Box<RawValue>, ErrorObjectOwned>;
 
     #[method(name = "pulsevm.getTableRows")]
     async fn get_table_rows(
@@ -114,49 +176,239 @@ pub trait Rpc {
         encode_type: Option<String>, //dec, hex , default=dec
         reverse: Option<bool>,
         show_payer: Option<bool>,
-    ) -> Result<Value, ErrorObjectOwned>;
+        cursor: Option<String>, //next_key from a previous page; resumes the walk there
+        max_response_bytes: Option<I32Flex>,
+    ) -> Result<GetTableRowsResponse, ErrorObjectOwned>;
+
+    /// Raw-row variant of `getTableRows` for service-to-service consumers
+    /// that re-encode rows anyway: rows come back as one base64 blob of
+    /// length-prefixed bytes plus the ABI hash, and the server skips the
+    /// ABI serializer entirely. Primary-index scans only.
+    #[method(name = "pulsevm.getTableRowsBinary")]
+    async fn get_table_rows_binary(
+        &self,
+        code: Name,
+        scope: String,
+        table: Name,
+        lower_bound: Option<String>,
+        upper_bound: Option<String>,
+        limit: Option<I32Flex>,
+        reverse: Option<bool>,
+        cursor: Option<String>,
+        max_response_bytes: Option<I32Flex>,
+    ) -> Result<GetTableRowsBinaryResponse, ErrorObjectOwned>;
+
+    #[method(name = "pulsevm.getTransactionTrace")]
+    async fn get_transaction_trace(
+        &self,
+        id: Id,
+    ) -> Result<TransactionTrace, ErrorObjectOwned>;
+
+    #[method(name = "pulsevm.readOnlyCall")]
+    async fn read_only_call(
+        &self,
+        account: Name,
+        action: Name,
+        data: Bytes,
+    ) -> Result<ReadOnlyCallResponse, ErrorObjectOwned>;
+
+    /// Pushes one [`BlockNotification`] per accepted block over the
+    /// websocket connection, replacing `get_info` + `get_block` polling
+    /// loops. Header fields only by default; pass `full_blocks = true`
+    /// to receive the whole signed block in each event.
+    #[subscription(name = "pulsevm.subscribeBlocks" => "pulsevm.newBlock", unsubscribe = "pulsevm.unsubscribeBlocks", item = BlockNotification)]
+    async fn subscribe_blocks(&self, full_blocks: Option<bool>) -> SubscriptionResult;
 }
 
+/// Rows per C++ `get_table_rows` call when paging. One request never
+/// materializes more than this many rows at once on the FFI side, however
+/// large the caller's limit is.
+const TABLE_ROWS_CHUNK: u32 = 256;
+/// Default/ceiling for a `get_table_rows` response body. The budget is
+/// checked between chunks, so a response can overshoot by at most one
+/// chunk of rows.
+const DEFAULT_TABLE_ROWS_BYTE_BUDGET: usize = 1 << 20;
+const MAX_TABLE_ROWS_BYTE_BUDGET: usize = 8 << 20;
+
+/// Recently served blocks kept around for `get_block`/`get_raw_block`.
+/// Pollers and explorers mostly ask for the last few heights; anything
+/// older ages out and falls back to the block log.
+const BLOCK_CACHE_CAPACITY: usize = 64;
+
 #[derive(Clone)]
 pub struct RpcService {
-    mempool: Arc<RwLock<Mempool>>,
+    admission: Arc<MempoolAdmission>,
     controller: Arc<RwLock<Controller>>,
-    network_manager: Arc<RwLock<NetworkManager>>,
+    // Aggregates submitted transactions into one gossip frame per window
+    // instead of one app-gossip send per transaction; holds the network
+    // manager handle the sends go through.
+    gossip_batcher: Arc<GossipBatcher>,
+    // Account-history queries go through the history plugin, which pages
+    // over the account-action index the state-history writer maintains.
+    history: HistoryPlugin,
+    // Direct database handle for pure-read queries, set at node
+    // initialization. Queries through it skip the controller lock — which
+    // block verification and acceptance hold for their whole duration —
+    // and only contend on the database's own reader/writer lock, whose
+    // critical sections are per-operation.
+    database: Arc<OnceLock<Database>>,
+    // Head-block handle and chain id published by the controller, set at
+    // node initialization. Head-dependent reads go through this instead of
+    // the controller lock, for the same reason as `database` above.
+    head: Arc<OnceLock<(HeadBlockHandle, Id)>>,
+    // `get_info` response built for the head block id it is keyed by.
+    // Monitoring systems poll `get_info` far more often than blocks are
+    // accepted, so between head changes the answer is a cached clone with
+    // a refreshed server time; when the head advances the key no longer
+    // matches and the next call rebuilds the entry.
+    info_cache: Arc<Mutex<Option<(Id, GetInfoResponse)>>>,
+    // Accepted blocks by height. Accepted blocks are immutable, so entries
+    // never need invalidation — they only age out of the LRU.
+    block_cache: Arc<Mutex<LruCache<u32, SignedBlock>>>,
+    // The jsonrpsee method table serving `handle_api_request`, built on
+    // first use and reused for every request after. Building it per
+    // request re-registered every method — pure allocation churn at RPC
+    // rates high enough that it showed up in CPU profiles.
+    rpc_module: Arc<OnceLock<RpcModule<RpcService>>>,
 }
 
 impl RpcService {
     pub fn new(
-        mempool: Arc<RwLock<Mempool>>,
+        admission: Arc<MempoolAdmission>,
         controller: Arc<RwLock<Controller>>,
         network_manager: Arc<RwLock<NetworkManager>>,
+        database: Arc<OnceLock<Database>>,
+        head: Arc<OnceLock<(HeadBlockHandle, Id)>>,
     ) -> Self {
+        let gossip_batcher = Arc::new(GossipBatcher::spawn(network_manager));
+        let history = HistoryPlugin::new(controller.clone());
         RpcService {
-            mempool,
+            admission,
             controller,
-            network_manager,
+            gossip_batcher,
+            history,
+            database,
+            head,
+            info_cache: Arc::new(Mutex::new(None)),
+            block_cache: Arc::new(Mutex::new(LruCache::new(
+                NonZeroUsize::new(BLOCK_CACHE_CAPACITY).unwrap(),
+            ))),
+            rpc_module: Arc::new(OnceLock::new()),
         }
     }
 
+    /// Database handle for read-only queries that don't need any other
+    /// controller state. `None` only before `initialize` has run.
+    fn query_database(&self) -> Result<Database, ErrorObjectOwned> {
+        self.database.get().cloned().ok_or_else(not_initialized)
+    }
+
+    /// Refuses a heavy request while the node is over its memory budget.
+    /// During a sync storm block verification is what matters; an RPC
+    /// caller gets a retryable overload error instead of piling more
+    /// allocation on a node already near the OOM killer.
+    fn shed_if_over_memory_budget(&self) -> Result<(), ErrorObjectOwned> {
+        if MEMORY_LEDGER.over_budget() {
+            return Err(ErrorObjectOwned::owned(
+                503,
+                "node_overloaded",
+                Some("node memory budget exhausted; retry shortly".to_string()),
+            ));
+        }
+        Ok(())
+    }
+
+    /// Head block and its id from the controller's published handle, without
+    /// taking the controller lock. Errors only before `initialize` has run.
+    fn head_block(&self) -> Result<(SignedBlock, Id), ErrorObjectOwned> {
+        let (handle, _) = self.head.get().ok_or_else(not_initialized)?;
+        handle.read().map(|head| head.clone()).map_err(|_| {
+            ErrorObjectOwned::owned(
+                500,
+                "internal_error",
+                Some("head block handle is poisoned".to_string()),
+            )
+        })
+    }
+
+    fn chain_id(&self) -> Result<Id, ErrorObjectOwned> {
+        self.head
+            .get()
+            .map(|(_, chain_id)| *chain_id)
+            .ok_or_else(not_initialized)
+    }
+
     pub async fn handle_api_request(
         &self,
         request_body: &str,
     ) -> Result<String, serde_json::Error> {
-        // Make sure `RpcService` implements your API trait
-        let module = self.clone().into_rpc();
+        let module = self.rpc_module.get_or_init(|| {
+            // The module captures a clone of the service as its context.
+            // That clone gets a fresh, never-filled module slot so the
+            // cached module doesn't hold an `Arc` cycle back to itself.
+            let mut context = self.clone();
+            context.rpc_module = Arc::new(OnceLock::new());
+            context.into_rpc()
+        });
 
         // Run the request and return the response
         let (resp, mut _stream) = module.raw_json_request(request_body, 1).await?;
-        //let resp: ResponseSuccess<u64> = serde_json::from_str::<Response<u64>>(&resp).unwrap().try_into().unwrap();
 
         Ok(resp)
     }
 }
 
+fn not_initialized() -> ErrorObjectOwned {
+    ErrorObjectOwned::owned(
+        503,
+        "not_initialized",
+        Some("node is not initialized".to_string()),
+    )
+}
+
+// Runs a synchronous FFI query on the tokio blocking pool, so a heavy table
+// scan never pins an async worker thread and cheap requests keep their
+// latency regardless of the query mix.
+async fn run_blocking<T, F>(task: F) -> Result<T, ErrorObjectOwned>
+where
+    F: FnOnce() -> Result<T, ErrorObjectOwned> + Send + 'static,
+    T: Send + 'static,
+{
+    tokio::task::spawn_blocking(task).await.map_err(|e| {
+        ErrorObjectOwned::owned(
+            500,
+            "internal_error",
+            Some(format!("query task failed: {}", e)),
+        )
+    })?
+}
+
+// Validates a JSON string from the C++ query layer and passes it through to
+// the response body verbatim. The previous shape parsed these strings into
+// `serde_json::Value` trees that jsonrpsee immediately re-serialized; for a
+// 50k-row response that double pass dominates the request.
+fn raw_json(response: String) -> Result<Box<RawValue>, ErrorObjectOwned> {
+    RawValue::from_string(response)
+        .map_err(|e| ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e))))
+}
+
+/// Shape of one C++ `get_table_rows` page, deserialized borrowing from the
+/// page string: the rows stay raw JSON slices and are spliced into the
+/// response as-is instead of being parsed into `Value` trees.
+#[derive(Deserialize)]
+struct TableRowsPage<'a> {
+    #[serde(borrow, default)]
+    rows: Vec<&'a RawValue>,
+    #[serde(default)]
+    more: bool,
+    #[serde(default)]
+    next_key: String,
+}
+
 #[async_trait]
 impl RpcServer for RpcService {
     async fn get_abi(&self, account_name: Name) -> Result<AbiDefinition, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let db = controller.database();
+        let db = self.query_database()?;
         let code_account = db.get_account(account_name.as_u64())?;
         let abi = AbiDefinition::read(code_account.get_abi().as_slice(), &mut 0).map_err(|e| {
             ErrorObjectOwned::owned(400, "abi_error", Some(format!("failed to read ABI: {}", e)))
@@ -169,38 +421,44 @@ impl RpcServer for RpcService {
         name: Name,
         expected_core_symbol: Option<String>,
     ) -> Result<Value, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let db = controller.database();
-        let head_block_time = controller.last_accepted_block().timestamp().to_time_point();
-        let head_block_num = controller.last_accepted_block().block_num();
+        let db = self.query_database()?;
+        let (head_block, _) = self.head_block()?;
+        let head_block_time = head_block.timestamp().to_time_point();
+        let head_block_num = head_block.block_num();
 
-        match expected_core_symbol {
-            Some(symbol) => {
-                let account_info_json = db.get_account_info_with_core_symbol(
+        run_blocking(move || {
+            let account_info_json = match expected_core_symbol {
+                Some(symbol) => db.get_account_info_with_core_symbol(
                     name.as_u64(),
                     &symbol,
                     head_block_num,
                     &head_block_time,
-                )?;
-                let account_info: Value =
-                    serde_json::from_str(&account_info_json).map_err(|e| {
-                        ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
-                    })?;
-                Ok(account_info)
-            }
-            None => {
-                let account_info_json = db.get_account_info_without_core_symbol(
+                )?,
+                None => db.get_account_info_without_core_symbol(
                     name.as_u64(),
                     head_block_num,
                     &head_block_time,
-                )?;
-                let account_info: Value =
-                    serde_json::from_str(&account_info_json).map_err(|e| {
-                        ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
-                    })?;
-                Ok(account_info)
-            }
-        }
+                )?,
+            };
+            serde_json::from_str(&account_info_json).map_err(|e| {
+                ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
+            })
+        })
+        .await
+    }
+
+    async fn get_actions(
+        &self,
+        account_name: Name,
+        pos: Option<u64>,
+        limit: Option<u32>,
+    ) -> Result<GetActionsResponse, ErrorObjectOwned> {
+        self.history
+            .get_actions(account_name, pos, limit)
+            .await
+            .map_err(|e| {
+                ErrorObjectOwned::owned(500, "history_error", Some(format!("{}", e)))
+            })
     }
 
     async fn get_block(&self, block_num_or_id: String) -> Result<SignedBlock, ErrorObjectOwned> {
@@ -211,8 +469,7 @@ impl RpcServer for RpcService {
         &self,
         account_name: Name,
     ) -> Result<GetCodeHashResponse, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let db = controller.database();
+        let db = self.query_database()?;
         let accnt_obj = db.get_account_metadata(account_name.as_u64())?;
         let code_hash = accnt_obj.get_code_hash();
         Ok(GetCodeHashResponse {
@@ -226,61 +483,152 @@ impl RpcServer for RpcService {
         code: Name,
         account: Name,
         symbol: Option<String>,
-    ) -> Result<Value, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let db = controller.database();
-        let response = match symbol {
-            Some(s) => {
-                let balance_str = db
+    ) -> Result<Box<RawValue>, ErrorObjectOwned> {
+        let db = self.query_database()?;
+        run_blocking(move || {
+            let balance_str = match symbol {
+                Some(s) => db
                     .get_currency_balance_with_symbol(code.as_u64(), account.as_u64(), &s)
                     .map_err(|e| {
                         ErrorObjectOwned::owned(500, "internal_error", Some(format!("{}", e)))
-                    })?;
-                let balance: Value = serde_json::from_str(&balance_str).map_err(|e| {
-                    ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
-                })?;
-                Ok(balance)
-            }
-            None => {
-                let balance_str = db
+                    })?,
+                None => db
                     .get_currency_balance_without_symbol(code.as_u64(), account.as_u64())
                     .map_err(|e| {
                         ErrorObjectOwned::owned(500, "internal_error", Some(format!("{}", e)))
-                    })?;
-                let balance: Value = serde_json::from_str(&balance_str).map_err(|e| {
-                    ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
-                })?;
-                Ok(balance)
-            }
-        };
-
-        return response;
+                    })?,
+            };
+            raw_json(balance_str)
+        })
+        .await
     }
 
     async fn get_currency_stats(
         &self,
         code: Name,
         symbol: String,
-    ) -> Result<Value, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let database = controller.database();
-        let response = database.get_currency_stats(code.as_u64(), symbol.as_str())?;
-        let stats: Value = serde_json::from_str(&response).map_err(|e| {
-            ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
-        })?;
-        Ok(stats)
+    ) -> Result<Box<RawValue>, ErrorObjectOwned> {
+        let database = self.query_database()?;
+        run_blocking(move || {
+            let response = database.get_currency_stats(code.as_u64(), symbol.as_str())?;
+            raw_json(response)
+        })
+        .await
+    }
+
+    async fn get_db_allocation_stats(&self) -> Result<Box<RawValue>, ErrorObjectOwned> {
+        let database = self.query_database()?;
+        run_blocking(move || {
+            let response = database.get_db_allocation_stats()?;
+            raw_json(response)
+        })
+        .await
+    }
+
+    async fn get_db_commit_stats(&self) -> Result<Box<RawValue>, ErrorObjectOwned> {
+        let database = self.query_database()?;
+        run_blocking(move || {
+            let response = database.get_db_commit_stats()?;
+            raw_json(response)
+        })
+        .await
+    }
+
+    async fn get_execution_accounting(
+        &self,
+        last_blocks: Option<u32>,
+    ) -> Result<GetExecutionAccountingResponse, ErrorObjectOwned> {
+        let snapshot = EXEC_ACCOUNTING.aggregate(last_blocks.map(|n| n as usize));
+        Ok(GetExecutionAccountingResponse {
+            first_block_num: snapshot.first_block_num,
+            last_block_num: snapshot.last_block_num,
+            blocks_aggregated: snapshot.blocks,
+            rows: snapshot
+                .rows
+                .into_iter()
+                .map(|row| ExecutionAccountingRow {
+                    receiver: row.receiver,
+                    contract: row.contract,
+                    action: row.action,
+                    count: row.costs.count,
+                    wall_us: row.costs.wall_us,
+                    cpu_points: row.costs.cpu_points,
+                    host_calls: row.costs.host_calls,
+                    ram_delta: row.costs.ram_delta,
+                })
+                .collect(),
+        })
+    }
+
+    async fn get_execution_profile(
+        &self,
+        reset: Option<bool>,
+    ) -> Result<GetExecutionProfileResponse, ErrorObjectOwned> {
+        let profiler = &*BLOCK_PROFILER;
+        let snapshot = profiler.snapshot();
+        let response = GetExecutionProfileResponse {
+            actions: snapshot.actions,
+            p50_us: snapshot.p50_us,
+            p95_us: snapshot.p95_us,
+            p99_us: snapshot.p99_us,
+            profiling_enabled: profiler.is_enabled(),
+            folded: snapshot.folded,
+        };
+        // Resetting after the read brackets a capture window around an
+        // incident without restarting the node.
+        if reset.unwrap_or(false) {
+            profiler.reset();
+        }
+        Ok(response)
+    }
+
+    async fn get_ffi_stats(
+        &self,
+        enable: Option<bool>,
+        reset: Option<bool>,
+    ) -> Result<GetFfiStatsResponse, ErrorObjectOwned> {
+        let stats = &*FFI_STATS;
+        // Toggling through the same call keeps a capture to three requests:
+        // enable, run the workload, read-and-reset.
+        if let Some(enable) = enable {
+            stats.set_enabled(enable);
+        }
+        let (sites, blocks) = stats.snapshot();
+        let response = GetFfiStatsResponse {
+            enabled: stats.is_enabled(),
+            blocks,
+            sites: sites
+                .into_iter()
+                .map(|site| FfiStatsSite {
+                    name: site.name.to_string(),
+                    calls: site.calls,
+                    cycles: site.cycles,
+                })
+                .collect(),
+        };
+        if reset.unwrap_or(false) {
+            stats.reset();
+        }
+        Ok(response)
     }
 
     async fn get_info(&self) -> Result<GetInfoResponse, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let head_block = controller.last_accepted_block();
-        let db = controller.database();
-        let head_block_id = head_block.id()?;
+        let (head_block, head_block_id) = self.head_block()?;
+
+        if let Some((cached_id, cached)) = self.info_cache.lock().await.as_ref() {
+            if *cached_id == head_block_id {
+                let mut response = cached.clone();
+                response.server_time = TimePoint::now().into();
+                return Ok(response);
+            }
+        }
 
-        Ok(GetInfoResponse {
+        let db = self.query_database()?;
+
+        let response = GetInfoResponse {
             server_version: "d133c641".to_owned(),
             server_time: TimePoint::now().into(),
-            chain_id: controller.chain_id().clone(),
+            chain_id: self.chain_id()?,
             head_block_num: head_block.block_num(),
             last_irreversible_block_num: head_block.block_num(),
             last_irreversible_block_id: head_block_id,
@@ -300,12 +648,14 @@ impl RpcServer for RpcService {
             total_net_weight: db.get_total_net_weight()?,
             earliest_available_block_num: 1,
             last_irreversible_block_time: head_block.timestamp().clone(),
-        })
+        };
+
+        *self.info_cache.lock().await = Some((head_block_id, response.clone()));
+        Ok(response)
     }
 
     async fn get_raw_abi(&self, account_name: Name) -> Result<GetRawABIResponse, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let db = controller.database();
+        let db = self.query_database()?;
         let account = db.get_account(account_name.as_u64())?;
         let account_metadata = db.get_account_metadata(account_name.as_u64())?;
 
@@ -327,14 +677,19 @@ impl RpcServer for RpcService {
         &self,
         block_num_or_id: String,
     ) -> Result<SignedBlock, ErrorObjectOwned> {
-        let controller = self.controller.clone();
-        let controller = controller.read().await;
-
         if let Ok(n) = block_num_or_id.parse::<u32>() {
+            if let Some(b) = self.block_cache.lock().await.get(&n) {
+                return Ok(b.clone());
+            }
+
+            let controller = self.controller.read().await;
             let block = controller.get_block_by_height(n)?;
 
             match block {
-                Some(b) => return Ok(b),
+                Some(b) => {
+                    self.block_cache.lock().await.put(n, b.clone());
+                    return Ok(b);
+                }
                 None => {
                     return Err(ErrorObjectOwned::owned(
                         404,
@@ -344,6 +699,7 @@ impl RpcServer for RpcService {
                 }
             }
         } else if let Ok(id) = Id::from_str(block_num_or_id.as_str()) {
+            let controller = self.controller.read().await;
             let block = controller.get_block(id)?;
 
             match block {
@@ -371,7 +727,9 @@ impl RpcServer for RpcService {
         compression: TransactionCompression,
         packed_context_free_data: Bytes,
         packed_trx: Bytes,
+        dry_run: Option<bool>,
     ) -> Result<IssueTxResponse, ErrorObjectOwned> {
+        self.shed_if_over_memory_budget()?;
         let packed_trx = PackedTransaction::new(
             signatures,
             compression,
@@ -379,31 +737,40 @@ impl RpcServer for RpcService {
             packed_trx,
         )?;
 
-        // Run transaction and revert it
-        {
+        // Run the transaction speculatively inside an undo session that is
+        // always discarded; a failure here rejects the transaction before it
+        // takes up mempool or block space, and the trace is returned to the
+        // caller either way.
+        let result = {
             let mut controller = self.controller.write().await;
             let pending_block_timestamp = TimePoint::now().into();
             controller.push_transaction(
                 &packed_trx,
                 &pending_block_timestamp,
                 &pulsevm_core::block::BlockStatus::Verifying,
-            )?;
-        }
+            )?
+        };
 
-        // Add to mempool
-        {
-            let mut mempool = self.mempool.write().await;
-            mempool.add_transaction(packed_trx.clone());
+        // Dry-run callers only want the trace; nothing is admitted or
+        // gossiped, so the chain state is untouched.
+        if dry_run.unwrap_or(false) {
+            return Ok(IssueTxResponse {
+                tx_id: packed_trx.id().clone(),
+                processed: result.trace,
+            });
         }
 
-        // Gossip
-        let nm = self.network_manager.read().await;
-        let gossipable_msg = Gossipable::new(GossipType::Transaction, packed_trx.clone())?;
-        nm.gossip(gossipable_msg).await?;
+        // Buffer for the mempool; only the owning admission shard is locked,
+        // so concurrent submissions don't serialize against block building
+        self.admission.submit(packed_trx.clone());
+
+        // Queue for gossip; the batcher folds concurrent submissions into
+        // one frame per window instead of one send per transaction.
+        self.gossip_batcher.submit(packed_trx.clone());
 
-        // Return a simple response
         Ok(IssueTxResponse {
             tx_id: packed_trx.id().clone(),
+            processed: result.trace,
         })
     }
 
@@ -412,8 +779,7 @@ impl RpcServer for RpcService {
         trx: Transaction,
         candidate_keys: BTreeSet<PublicKey>,
     ) -> Result<BTreeSet<PublicKey>, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let mut db = controller.database();
+        let mut db = self.query_database()?;
 
         let required_keys = AuthorizationManager::get_required_keys(
             &mut db,
@@ -433,23 +799,21 @@ impl RpcServer for RpcService {
         upper_bound: Option<String>,
         limit: Option<I32Flex>,
         reverse: Option<bool>,
-    ) -> Result<Value, ErrorObjectOwned> {
-        let controller = self.controller.read().await;
-        let db = controller.database();
-        let response = db.get_table_by_scope(
-            code.as_u64(),
-            table.as_u64(),
-            &lower_bound.unwrap_or_default(),
-            &upper_bound.unwrap_or_default(),
-            limit.unwrap_or(I32Flex(10)).0 as u32,
-            reverse.unwrap_or(false),
-        )?;
-
-        let response: Value = serde_json::from_str(&response).map_err(|e| {
-            ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
-        })?;
+    ) -> Result<Box<RawValue>, ErrorObjectOwned> {
+        let db = self.query_database()?;
+        run_blocking(move || {
+            let response = db.get_table_by_scope(
+                code.as_u64(),
+                table.as_u64(),
+                &lower_bound.unwrap_or_default(),
+                &upper_bound.unwrap_or_default(),
+                limit.unwrap_or(I32Flex(10)).0 as u32,
+                reverse.unwrap_or(false),
+            )?;
 
-        Ok(response)
+            raw_json(response)
+        })
+        .await
     }
 
     async fn get_table_rows(
@@ -467,29 +831,374 @@ impl RpcServer for RpcService {
         encode_type: Option<String>, //dec, hex , default=dec
         reverse: Option<bool>,
         show_payer: Option<bool>,
-    ) -> Result<Value, ErrorObjectOwned> {
+        cursor: Option<String>,
+        max_response_bytes: Option<I32Flex>,
+    ) -> Result<GetTableRowsResponse, ErrorObjectOwned> {
+        self.shed_if_over_memory_budget()?;
+        let db = self.query_database()?;
+
+        let reverse = reverse.unwrap_or(false);
+        let mut lower_bound = lower_bound.unwrap_or_default();
+        let mut upper_bound = upper_bound.unwrap_or_default();
+        // A cursor is the next_key of a previous page; it resumes the walk
+        // from that key in place of the original bound (the upper bound
+        // when walking in reverse).
+        if let Some(cursor) = cursor.filter(|c| !c.is_empty()) {
+            if reverse {
+                upper_bound = cursor;
+            } else {
+                lower_bound = cursor;
+            }
+        }
+
+        let row_limit = std::cmp::max(limit.unwrap_or(I32Flex(10)).0, 1) as u32;
+        let byte_budget = max_response_bytes
+            .map(|b| (b.0.max(1) as usize).min(MAX_TABLE_ROWS_BYTE_BUDGET))
+            .unwrap_or(DEFAULT_TABLE_ROWS_BYTE_BUDGET);
+
+        let json = json.unwrap_or(false);
+        let table_key = table_key.unwrap_or_default();
+        let index_position = index_position.unwrap_or(I32Flex(1)).0.to_string();
+        let encode_type = encode_type.unwrap_or_else(|| "dec".to_string());
+        let show_payer = show_payer.unwrap_or(false);
+
+        // The whole paging loop runs on the blocking pool: each chunk is a
+        // synchronous FFI call, and a budget's worth of them would otherwise
+        // pin an async worker for the full scan.
+        run_blocking(move || {
+            // Consult the table's row counts (chainbase maintains them on
+            // the table_id_object, so this is two O(log n) lookups) before
+            // committing to a scan. A missing or empty table — or a
+            // secondary index the contract never populated — answers
+            // immediately, without loading the ABI or walking anything,
+            // and a malformed table/index_position errors here instead of
+            // once per page.
+            let stats: Value = serde_json::from_str(&db.get_table_stats(
+                code.as_u64(),
+                &scope,
+                table.as_u64(),
+                &index_position,
+            )?)
+            .map_err(|e| {
+                ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
+            })?;
+            let index_row_count = stats
+                .get("index_row_count")
+                .and_then(Value::as_u64)
+                .unwrap_or(0);
+            if index_row_count == 0 {
+                return Ok(GetTableRowsResponse {
+                    rows: raw_json("[]".to_string())?,
+                    more: false,
+                    next_key: String::new(),
+                    cursor: String::new(),
+                });
+            }
+            // The index cannot yield more rows than it holds; don't page
+            // past it however large the caller's limit is.
+            let row_limit = row_limit.min(index_row_count.min(u32::MAX as u64) as u32);
+
+            // The rows accumulate as one growing JSON array, spliced raw
+            // out of the page strings; nothing row-shaped is ever parsed.
+            let mut rows_json = String::from("[");
+            let mut num_rows = 0u32;
+            let mut bytes_used = 0usize;
+            let mut more = false;
+            let mut next_key = String::new();
+
+            // Page through the table in bounded chunks over the
+            // iterator-based walk underneath, instead of materializing the
+            // whole range in one FFI call. Stops at whichever comes first of
+            // the row limit and the byte budget; a 10M-row table costs the
+            // caller as many pages as their budget allows, never one giant
+            // response.
+            loop {
+                let remaining = row_limit - num_rows;
+                let response = db.get_table_rows(
+                    json,
+                    code.as_u64(),
+                    &scope,
+                    table.as_u64(),
+                    &table_key,
+                    &lower_bound,
+                    &upper_bound,
+                    remaining.min(TABLE_ROWS_CHUNK),
+                    &key_type,
+                    &index_position,
+                    &encode_type,
+                    reverse,
+                    show_payer,
+                )?;
+
+                // Charge the page against the byte budget by its wire size.
+                // The envelope around the rows is a few dozen bytes, so this
+                // tracks the eventual response size closely without
+                // re-serializing every row just to measure it.
+                bytes_used += response.len();
+
+                let page: TableRowsPage = serde_json::from_str(&response).map_err(|e| {
+                    ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
+                })?;
+                for row in page.rows {
+                    if num_rows > 0 {
+                        rows_json.push(',');
+                    }
+                    rows_json.push_str(row.get());
+                    num_rows += 1;
+                }
+                more = page.more;
+                next_key = page.next_key;
+
+                if !more || num_rows >= row_limit || bytes_used >= byte_budget {
+                    break;
+                }
+                if next_key.is_empty() {
+                    // Nothing to resume from; don't spin on the same page.
+                    break;
+                }
+                if reverse {
+                    upper_bound = next_key.clone();
+                } else {
+                    lower_bound = next_key.clone();
+                }
+            }
+
+            rows_json.push(']');
+            let cursor = if more { next_key.clone() } else { String::new() };
+            Ok(GetTableRowsResponse {
+                rows: raw_json(rows_json)?,
+                more,
+                next_key,
+                cursor,
+            })
+        })
+        .await
+    }
+
+    async fn get_table_rows_binary(
+        &self,
+        code: Name,
+        scope: String,
+        table: Name,
+        lower_bound: Option<String>,
+        upper_bound: Option<String>,
+        limit: Option<I32Flex>,
+        reverse: Option<bool>,
+        cursor: Option<String>,
+        max_response_bytes: Option<I32Flex>,
+    ) -> Result<GetTableRowsBinaryResponse, ErrorObjectOwned> {
+        self.shed_if_over_memory_budget()?;
+        let db = self.query_database()?;
+
+        let reverse = reverse.unwrap_or(false);
+        let mut lower_bound = lower_bound.unwrap_or_default();
+        let mut upper_bound = upper_bound.unwrap_or_default();
+        if let Some(cursor) = cursor.filter(|c| !c.is_empty()) {
+            if reverse {
+                upper_bound = cursor;
+            } else {
+                lower_bound = cursor;
+            }
+        }
+
+        let row_limit = std::cmp::max(limit.unwrap_or(I32Flex(10)).0, 1) as u32;
+        let byte_budget = max_response_bytes
+            .map(|b| (b.0.max(1) as usize).min(MAX_TABLE_ROWS_BYTE_BUDGET))
+            .unwrap_or(DEFAULT_TABLE_ROWS_BYTE_BUDGET);
+
+        run_blocking(move || {
+            // Same bounded paging as the JSON endpoint, but the pages are
+            // opaque length-prefixed byte blobs that concatenate without
+            // any parsing; row counting is a walk over the length prefixes.
+            let mut blob: Vec<u8> = Vec::new();
+            let mut num_rows = 0u32;
+            let mut more = false;
+            let mut next_key = String::new();
+            let mut abi_hash = String::new();
+
+            loop {
+                let remaining = row_limit - num_rows;
+                let page = db.get_table_rows_binary(
+                    code.as_u64(),
+                    &scope,
+                    table.as_u64(),
+                    &lower_bound,
+                    &upper_bound,
+                    remaining.min(TABLE_ROWS_CHUNK),
+                    reverse,
+                )?;
+
+                let mut offset = 0usize;
+                while offset + 4 <= page.rows.len() {
+                    let len =
+                        u32::from_le_bytes(page.rows[offset..offset + 4].try_into().unwrap());
+                    offset += 4 + len as usize;
+                    num_rows += 1;
+                }
+                blob.extend_from_slice(&page.rows);
+                more = page.more;
+                next_key = page.next_key;
+                abi_hash = page.abi_hash;
+
+                if !more || num_rows >= row_limit || blob.len() >= byte_budget {
+                    break;
+                }
+                if next_key.is_empty() {
+                    // Nothing to resume from; don't spin on the same page.
+                    break;
+                }
+                if reverse {
+                    upper_bound = next_key.clone();
+                } else {
+                    lower_bound = next_key.clone();
+                }
+            }
+
+            let cursor = if more { next_key.clone() } else { String::new() };
+            Ok(GetTableRowsBinaryResponse {
+                rows: Base64Bytes(blob),
+                more,
+                next_key,
+                cursor,
+                abi_hash,
+            })
+        })
+        .await
+    }
+
+    async fn get_slow_transactions(
+        &self,
+        threshold_us: Option<u64>,
+    ) -> Result<GetSlowTransactionsResponse, ErrorObjectOwned> {
+        // Passing a threshold retunes the tracer for subsequent
+        // transactions; lowering it widens the net around an incident
+        // without restarting the node.
+        if let Some(threshold_us) = threshold_us {
+            SLOW_TRX_LOG.set_threshold_us(threshold_us);
+        }
+        Ok(GetSlowTransactionsResponse {
+            threshold_us: SLOW_TRX_LOG.threshold_us(),
+            records: SLOW_TRX_LOG
+                .snapshot()
+                .into_iter()
+                .map(|record| SlowTransactionRow {
+                    trx_id: record.trx_id,
+                    block_num: record.block_num,
+                    wall_us: record.wall_us,
+                    cpu_us: record.cpu_us,
+                    net_bytes: record.net_bytes,
+                    host_calls: record.host_calls,
+                    actions_total: record.actions_total,
+                    actions: record
+                        .actions
+                        .into_iter()
+                        .map(|action| SlowTransactionAction {
+                            receiver: action.receiver,
+                            contract: action.contract,
+                            action: action.action,
+                            elapsed_us: action.elapsed_us,
+                        })
+                        .collect(),
+                })
+                .collect(),
+        })
+    }
+
+    async fn get_transaction_trace(
+        &self,
+        id: Id,
+    ) -> Result<TransactionTrace, ErrorObjectOwned> {
         let controller = self.controller.read().await;
-        let db = controller.database();
-        let response = db.get_table_rows(
-            json.unwrap_or(false),
-            code.as_u64(),
-            &scope,
-            table.as_u64(),
-            &table_key.unwrap_or_default(),
-            &lower_bound.unwrap_or_default(),
-            &upper_bound.unwrap_or_default(),
-            limit.unwrap_or(I32Flex(10)).0 as u32,
-            &key_type,
-            &index_position.unwrap_or(I32Flex(1)).0.to_string(),
-            &encode_type.unwrap_or_else(|| "dec".to_string()),
-            reverse.unwrap_or(false),
-            show_payer.unwrap_or(false),
-        )?;
+        match controller.get_transaction_trace(&id) {
+            Ok(Some(trace)) => Ok(trace),
+            Ok(None) => Err(ErrorObjectOwned::owned(
+                404,
+                "not_found",
+                Some(format!("no trace recorded for transaction {}", id)),
+            )),
+            Err(e) => Err(ErrorObjectOwned::owned(
+                500,
+                "trace_error",
+                Some(format!("{}", e)),
+            )),
+        }
+    }
 
-        let rows: Value = serde_json::from_str(&response).map_err(|e| {
-            ErrorObjectOwned::owned(500, "serialization_error", Some(format!("{}", e)))
-        })?;
+    async fn read_only_call(
+        &self,
+        account: Name,
+        action: Name,
+        data: Bytes,
+    ) -> Result<ReadOnlyCallResponse, ErrorObjectOwned> {
+        self.shed_if_over_memory_budget()?;
+        let db = self.query_database()?;
+        let (head_block, _) = self.head_block()?;
+        let head_block_num = head_block.block_num();
+        // Only the runtime handle is taken under the controller lock; the
+        // call itself runs on the blocking pool with the write intrinsics
+        // unbound, so concurrent view calls never serialize against block
+        // building.
+        let wasm_runtime = self.controller.read().await.get_wasm_runtime().clone();
+
+        run_blocking(move || {
+            let (trace, cpu_usage) = Controller::read_only_call(
+                db,
+                wasm_runtime,
+                head_block_num,
+                account,
+                action,
+                data.into_vec(),
+            )?;
+            Ok(ReadOnlyCallResponse {
+                return_value: Base64Bytes(trace.return_value.into_vec()),
+                console: trace.console,
+                cpu_usage,
+            })
+        })
+        .await
+    }
+
+    async fn subscribe_blocks(
+        &self,
+        pending: PendingSubscriptionSink,
+        full_blocks: Option<bool>,
+    ) -> SubscriptionResult {
+        // Subscribe before accepting the handshake so a block committed
+        // in between is buffered rather than missed.
+        let mut rx = self.controller.read().await.subscribe_blocks();
+        let full_blocks = full_blocks.unwrap_or(false);
+        let sink = pending.accept().await?;
 
-        Ok(rows)
+        loop {
+            tokio::select! {
+                _ = sink.closed() => break,
+                event = rx.recv() => match event {
+                    Ok(event) => {
+                        let block = &event.block;
+                        let notification = BlockNotification {
+                            block_num: block.block_num(),
+                            block_id: event.block_id,
+                            timestamp: block.timestamp().clone(),
+                            producer: block.signed_block_header.header.producer,
+                            transaction_count: block.transactions.len() as u32,
+                            block: full_blocks.then(|| (**block).clone()),
+                        };
+                        if sink
+                            .send(SubscriptionMessage::from_json(&notification)?)
+                            .await
+                            .is_err()
+                        {
+                            break;
+                        }
+                    }
+                    // This subscriber fell a full buffer behind; skip
+                    // ahead instead of disconnecting — the stream stays
+                    // live and the gap is backfilled via `get_block`.
+                    Err(RecvError::Lagged(_)) => continue,
+                    Err(RecvError::Closed) => break,
+                },
+            }
+        }
+        Ok(())
     }
 }
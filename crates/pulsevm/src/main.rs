@@ -3,10 +3,13 @@ mod chain;
 mod state_history;
 
 use pulsevm_core::{
+    Database,
     config::{PLUGIN_VERSION, VERSION},
-    controller::Controller,
+    controller::{BlockReadHandle, Controller, HeadBlockHandle},
     id::{Id, NodeId},
-    mempool::Mempool,
+    mempool::{Mempool, MempoolAdmission},
+    mempool_journal::{self, MempoolJournal},
+    prevalidator::TransactionPrevalidator,
     transaction::PackedTransaction,
 };
 use pulsevm_grpc::{
@@ -20,11 +23,11 @@ use pulsevm_grpc::{
         vm_server::{Vm, VmServer},
     },
 };
-use pulsevm_serialization::{Read, Write};
+use pulsevm_serialization::Read;
 use spdlog::{debug, info, warn};
 use std::{
     net::{SocketAddr, TcpListener},
-    sync::{Arc, atomic::AtomicBool},
+    sync::{Arc, OnceLock, atomic::AtomicBool},
     time::{Duration, Instant},
 };
 use tokio::{
@@ -37,7 +40,7 @@ use tonic::transport::server::TcpIncoming;
 use tonic::{Request, Response, Status, transport::Server};
 
 use crate::{
-    chain::{BlockTimer, GossipType, Gossipable},
+    chain::{BlockTimer, GossipIntake, GossipType, Gossipable, RpcServer},
     state_history::StateHistoryServer,
 };
 
@@ -93,9 +96,36 @@ async fn main() {
         }
     });
 
+    // The JSON-RPC API over a persistent websocket, serving the same
+    // module as the HTTP handler plus the block subscription — push
+    // consumers (explorers) connect here instead of polling
+    // getInfo/getBlock over HTTP.
+    let rpc_ws_bind = std::env::var("RPC_WS_BIND").unwrap_or_else(|_| "0.0.0.0:9091".into());
+    let cancel_rpc_ws = cancel.clone();
+    let rpc_module = vm.rpc_service.clone().into_rpc();
+    let rpc_ws_handle = tokio::spawn(async move {
+        match jsonrpsee::server::Server::builder()
+            .build(&rpc_ws_bind)
+            .await
+        {
+            Ok(server) => {
+                info!("RPC WebSocket listening on {}", rpc_ws_bind);
+                let handle = server.start(rpc_module);
+                tokio::select! {
+                    _ = cancel_rpc_ws.cancelled() => {
+                        let _ = handle.stop();
+                    }
+                    _ = handle.clone().stopped() => {}
+                }
+            }
+            Err(e) => spdlog::error!("RPC WS server error: {:?}", e),
+        }
+    });
+
     // Keep listening
     let _ = runtime_handle.await;
     let _ = ws_handle.await;
+    let _ = rpc_ws_handle.await;
 
     // Gracefully shutdown
     info!("shutting down...");
@@ -151,7 +181,26 @@ pub struct VirtualMachine {
     server_addr: SocketAddr,
     controller: Arc<RwLock<Controller>>,
     mempool: Arc<RwLock<Mempool>>,
+    admission: Arc<MempoolAdmission>,
+    // Set once `initialize` knows the chain id and config; gossip received
+    // before that is dropped.
+    prevalidator: Arc<OnceLock<TransactionPrevalidator>>,
+    // Shared database handle for RPC queries, set at `initialize`. Lets
+    // pure read methods skip the controller lock entirely.
+    query_database: Arc<OnceLock<Database>>,
+    // Head-block handle and chain id, set at `initialize`, so the RPC layer
+    // serves head-dependent reads without the controller lock.
+    head_block: Arc<OnceLock<(HeadBlockHandle, Id)>>,
+    // Lock-free view over verified blocks, the head and the block cache,
+    // set at `initialize`. The block-fetch handlers serve from it so a
+    // consensus burst of GetBlock/GetAncestors never queues behind
+    // verify/accept, which hold the controller write lock throughout.
+    block_reads: Arc<OnceLock<BlockReadHandle>>,
     network_manager: Arc<RwLock<chain::NetworkManager>>,
+    // Inbound gossip funnel: per-peer rate limits and priority queues in
+    // front of the decode pool, so spam peers pay for their own bytes and
+    // consensus-class frames never wait behind transaction gossip.
+    gossip_intake: Arc<GossipIntake>,
     rpc_service: chain::RpcService,
     block_timer: Arc<RwLock<BlockTimer>>,
     ready_to_terminate: Arc<AtomicBool>,
@@ -161,21 +210,104 @@ impl VirtualMachine {
     pub fn new(server_addr: SocketAddr) -> Result<Self, Box<dyn std::error::Error>> {
         let controller = Arc::new(RwLock::new(Controller::new()));
         let mempool = Arc::new(RwLock::new(Mempool::new()));
+        let admission = Arc::new(MempoolAdmission::new());
         let network_manager = Arc::new(RwLock::new(chain::NetworkManager::new()));
-        let rpc_service =
-            chain::RpcService::new(mempool.clone(), controller.clone(), network_manager.clone());
-        let block_timer = Arc::new(RwLock::new(BlockTimer::new(mempool.clone())));
+        let query_database = Arc::new(OnceLock::new());
+        let head_block = Arc::new(OnceLock::new());
+        let rpc_service = chain::RpcService::new(
+            admission.clone(),
+            controller.clone(),
+            network_manager.clone(),
+            query_database.clone(),
+            head_block.clone(),
+        );
+        let block_timer = Arc::new(RwLock::new(BlockTimer::new(
+            controller.clone(),
+            mempool.clone(),
+            admission.clone(),
+        )));
+        let prevalidator: Arc<OnceLock<TransactionPrevalidator>> = Arc::new(OnceLock::new());
+        let gossip_intake = {
+            let admission = admission.clone();
+            let prevalidator = prevalidator.clone();
+            GossipIntake::spawn(move |peer, msg| {
+                decode_gossip_frame(&admission, &prevalidator, peer, msg)
+            })
+        };
 
         Ok(Self {
             server_addr,
             controller: controller,
             mempool: mempool,
+            admission: admission,
+            prevalidator,
+            query_database,
+            head_block,
+            block_reads: Arc::new(OnceLock::new()),
             network_manager: network_manager,
+            gossip_intake,
             rpc_service: rpc_service,
             block_timer,
             ready_to_terminate: Arc::new(AtomicBool::new(false)),
         })
     }
+
+    fn block_reads(&self) -> Result<&BlockReadHandle, Status> {
+        self.block_reads
+            .get()
+            .ok_or_else(|| Status::failed_precondition("vm not initialized"))
+    }
+}
+
+/// Decodes one admitted gossip frame and feeds its transactions through
+/// prevalidation into admission. Runs on the gossip intake's worker pool.
+fn decode_gossip_frame(
+    admission: &MempoolAdmission,
+    prevalidator: &OnceLock<TransactionPrevalidator>,
+    peer: NodeId,
+    data: Vec<u8>,
+) {
+    let gossipable = match Gossipable::read(&data, &mut 0) {
+        Err(e) => {
+            warn!("failed to read gossip from {:?}: {}", peer, e);
+            return;
+        }
+        Ok(gossipable) => gossipable,
+    };
+
+    // Batched frames carry many transactions; single-transaction
+    // frames still arrive from peers running older builds.
+    let txs: Vec<PackedTransaction> = match gossipable.gossip_type {
+        GossipType::Transaction => match gossipable.to_type::<PackedTransaction>() {
+            Err(e) => {
+                warn!("failed to parse gossip as packed transaction: {}", e);
+                return;
+            }
+            Ok(tx) => vec![tx],
+        },
+        // Batches bypass `to_type` so the ids of all uncompressed payloads
+        // come out of one batch-hash pass over the frame.
+        GossipType::TransactionBatch => {
+            match PackedTransaction::read_batch(gossipable.data.as_ref(), &mut 0) {
+                Err(e) => {
+                    warn!("failed to parse gossip as transaction batch: {}", e);
+                    return;
+                }
+                Ok(txs) => txs,
+            }
+        }
+    };
+
+    let Some(prevalidator) = prevalidator.get() else {
+        return; // not initialized yet, drop the gossip
+    };
+
+    for tx in txs {
+        match prevalidator.prevalidate(&tx) {
+            Ok(()) => admission.submit(tx),
+            Err(e) => debug!("dropping gossiped transaction {}: {}", tx.id(), e),
+        }
+    }
 }
 
 #[tonic::async_trait]
@@ -202,6 +334,47 @@ impl Vm for VirtualMachine {
             .initialize(&chain_id, &config_bytes, &genesis_bytes, db_path.as_str())
             .map_err(|e| Status::internal(format!("could not initialize controller: {}", e)))?;
 
+        let max_transaction_lifetime =
+            Controller::get_global_properties(&controller.database())
+                .map_err(|e| {
+                    Status::internal(format!("could not get global properties: {}", e))
+                })?
+                .get_chain_config()
+                .get_max_transaction_lifetime();
+        let _ = self.prevalidator.set(TransactionPrevalidator::new(
+            controller.chain_id().clone(),
+            max_transaction_lifetime,
+            controller.recovery_cache(),
+            controller.accepted_tx_filter(),
+            controller.database(),
+        ));
+        let _ = self.query_database.set(controller.database());
+        let _ = self
+            .head_block
+            .set((controller.head_block_handle(), controller.chain_id().clone()));
+
+        // Restore the mempool the previous run journaled, then attach the
+        // journal so every admission from here on survives the next
+        // restart. Journal trouble degrades to the old lose-the-mempool
+        // behavior, never to a failed initialization.
+        let journal_path = std::path::Path::new(db_path.as_str()).join("mempool.journal");
+        match MempoolJournal::open(&journal_path, mempool_journal::now_sec()) {
+            Ok((journal, restored)) => {
+                if !restored.is_empty() {
+                    info!("restored {} pending transactions from mempool journal", restored.len());
+                    let mut mempool = self.mempool.write().await;
+                    for transaction in restored {
+                        mempool.add_transaction(transaction);
+                    }
+                }
+                self.admission.set_journal(journal);
+            }
+            Err(e) => warn!("mempool journal unavailable: {}", e),
+        }
+        if let Some(handle) = controller.block_read_handle() {
+            let _ = self.block_reads.set(handle);
+        }
+
         let network_manager = Arc::clone(&self.network_manager);
         let mut network_manager = network_manager.write().await;
         network_manager.set_server_address(server_addr.clone());
@@ -223,8 +396,7 @@ impl Vm for VirtualMachine {
                 .to_vec(),
             height: controller.last_accepted_block().block_num() as u64,
             bytes: controller
-                .last_accepted_block()
-                .pack()
+                .pack_block(controller.last_accepted_block())
                 .map_err(|e| Status::internal(format!("could not pack block: {}", e)))?,
             timestamp: Some(controller.last_accepted_block().timestamp().into()),
         }));
@@ -255,8 +427,7 @@ impl Vm for VirtualMachine {
                 .to_vec(),
             height: controller.last_accepted_block().block_num() as u64,
             bytes: controller
-                .last_accepted_block()
-                .pack()
+                .pack_block(controller.last_accepted_block())
                 .map_err(|e| Status::internal(format!("could not pack block: {}", e)))?,
             timestamp: Some(controller.last_accepted_block().timestamp().into()),
         }));
@@ -336,6 +507,7 @@ impl Vm for VirtualMachine {
             .try_into()
             .map_err(|_| Status::invalid_argument("invalid node id"))?;
         network_manager.disconnected(node_id);
+        self.gossip_intake.forget_peer(&node_id);
         Ok(Response::new(()))
     }
 
@@ -348,6 +520,7 @@ impl Vm for VirtualMachine {
         let mut controller = controller.write().await;
         let mempool = self.mempool.clone();
         let mut mempool = mempool.write().await;
+        mempool.absorb(&self.admission);
         let block = controller
             .build_block(&mut mempool)
             .await
@@ -359,13 +532,15 @@ impl Vm for VirtualMachine {
             "block built with id {}, returning from build_block",
             block_id
         );
+        let packed = controller
+            .pack_block(&block)
+            .map_err(|e| Status::internal(format!("could not pack block: {}", e)))?;
         Ok(Response::new(vm::BuildBlockResponse {
             id: block_id.into(),
             parent_id: block.previous_id().as_bytes().to_vec(),
             height: block.block_num() as u64,
-            bytes: block
-                .pack()
-                .map_err(|e| Status::internal(format!("could not pack block: {}", e)))?,
+            bytes: chain::wire::compress_block_bytes(&packed)
+                .map_err(|e| Status::internal(format!("could not compress block: {}", e)))?,
             timestamp: Some(block.timestamp().into()),
             verify_with_context: false,
         }))
@@ -376,9 +551,13 @@ impl Vm for VirtualMachine {
         request: Request<vm::ParseBlockRequest>,
     ) -> Result<tonic::Response<vm::ParseBlockResponse>, Status> {
         debug!("parse_block called, parsing block...");
-        let controller = self.controller.read().await;
-        let block = controller
-            .parse_block(&request.get_ref().bytes)
+        let bytes = chain::wire::decompress_block_bytes(&request.get_ref().bytes)
+            .map_err(|e| Status::internal(format!("could not decompress block: {}", e)))?;
+        // Only header-level data is returned, so decode just the signed
+        // header and leave the transaction section as undecoded bounds.
+        // Parsing is pure and takes no lock, so it runs concurrently with
+        // whatever the controller is doing.
+        let block = Controller::parse_block_header(&bytes)
             .map_err(|_| Status::internal("could not parse block"))?;
         let block_id = block
             .id()
@@ -400,24 +579,27 @@ impl Vm for VirtualMachine {
         &self,
         request: Request<vm::GetBlockRequest>,
     ) -> Result<tonic::Response<vm::GetBlockResponse>, Status> {
-        let controller = self.controller.read().await;
         let block_id: Id = request
             .get_ref()
             .id
             .clone()
             .try_into()
             .map_err(|_| Status::invalid_argument("invalid block id"))?;
-        let block = controller
-            .get_block(block_id)
+        let block = self
+            .block_reads()?
+            .get_block(&block_id)
             .map_err(|_| Status::internal("could not get block"))?;
 
         if let Some(block) = block {
             debug!("block found with id {}, returning from get_block", block_id);
+            let packed = self
+                .block_reads()?
+                .pack_block(&block)
+                .map_err(|e| Status::internal(format!("could not pack block: {}", e)))?;
             return Ok(Response::new(vm::GetBlockResponse {
                 parent_id: block.previous_id().as_bytes().to_vec(),
-                bytes: block
-                    .pack()
-                    .map_err(|e| Status::internal(format!("could not pack block: {}", e)))?,
+                bytes: chain::wire::compress_block_bytes(&packed)
+                    .map_err(|e| Status::internal(format!("could not compress block: {}", e)))?,
                 height: block.block_num() as u64,
                 timestamp: Some(block.timestamp().into()),
                 verify_with_context: false,
@@ -444,7 +626,9 @@ impl Vm for VirtualMachine {
         debug!("block_verify called, verifying block...");
         let mut controller = self.controller.write().await;
         let mut mempool = self.mempool.write().await;
-        let block = match controller.parse_block(&request.get_ref().bytes) {
+        let bytes = chain::wire::decompress_block_bytes(&request.get_ref().bytes)
+            .map_err(|e| Status::internal(format!("could not decompress block: {}", e)))?;
+        let block = match Controller::parse_block(&bytes) {
             Ok(block) => block,
             Err(e) => {
                 warn!("failed parsing block for verification: {}", e);
@@ -588,29 +772,17 @@ impl Vm for VirtualMachine {
         &self,
         request: Request<vm::AppGossipMsg>,
     ) -> Result<tonic::Response<()>, Status> {
-        let data = request.get_ref().msg.as_slice();
-        let gossipable = match Gossipable::read(data, &mut 0) {
-            Err(e) => {
-                warn!("failed to read gossip: {}", e);
-                return Ok(Response::new(()));
-            }
-            Ok(gossipable) => gossipable,
-        };
-
-        if gossipable.gossip_type == GossipType::Transaction {
-            match gossipable.to_type::<PackedTransaction>() {
-                Err(e) => {
-                    warn!("failed to parse gossip as packed transaction: {}", e);
-                    return Ok(Response::new(()));
-                }
-                Ok(tx) => {
-                    let mempool = self.mempool.clone();
-                    let mut mempool = mempool.write().await;
-                    mempool.add_transaction(tx);
-                }
-            }
-        }
-
+        // Hand the raw frame to the intake, which charges the sending
+        // peer's rate budget and queues it by priority class; decoding,
+        // expiration and duplicate checks and signature recovery all happen
+        // on its bounded worker pool, and only fully vetted transactions
+        // reach the admission shards.
+        let msg = request.into_inner();
+        let node_id: NodeId = msg
+            .node_id
+            .try_into()
+            .map_err(|_| Status::invalid_argument("invalid node id"))?;
+        self.gossip_intake.submit(node_id, msg.msg);
         Ok(Response::new(()))
     }
 
@@ -626,8 +798,10 @@ impl Vm for VirtualMachine {
         request: Request<vm::GetAncestorsRequest>,
     ) -> Result<tonic::Response<vm::GetAncestorsResponse>, Status> {
         debug!("get_ancestors called, retrieving ancestors...");
-        let controller = self.controller.clone();
-        let controller = controller.read().await;
+        // Bootstrapping peers issue these in bulk; the walk runs entirely on
+        // the block read handle so it never blocks — or is blocked by —
+        // verification and acceptance.
+        let block_reads = self.block_reads()?;
         let deadline = Instant::now()
             + Duration::from_nanos(request.get_ref().max_blocks_retrival_time as u64);
         let mut ancestors: Vec<Vec<u8>> = Vec::new();
@@ -646,16 +820,20 @@ impl Vm for VirtualMachine {
                 break;
             }
 
-            let blk = match controller.get_block(current_id) {
+            let blk = match block_reads.get_block(&current_id) {
                 Ok(Some(blk)) => blk,
                 Ok(None) if !ancestors.is_empty() => break,
                 Ok(None) => return Err(Status::not_found("block not found")),
                 Err(e) => return Err(Status::internal(format!("could not get block: {}", e))),
             };
 
-            let blk_bytes = blk
-                .pack()
+            let packed = block_reads
+                .pack_block(&blk)
                 .map_err(|e| Status::internal(format!("could not pack block: {}", e)))?;
+            // Budget against the compressed size; that is what goes over
+            // the wire.
+            let blk_bytes = chain::wire::compress_block_bytes(&packed)
+                .map_err(|e| Status::internal(format!("could not compress block: {}", e)))?;
             if total_size + blk_bytes.len() > max_blocks_size && !ancestors.is_empty() {
                 break;
             }
@@ -688,13 +866,12 @@ impl Vm for VirtualMachine {
         request: Request<vm::BatchedParseBlockRequest>,
     ) -> Result<tonic::Response<vm::BatchedParseBlockResponse>, Status> {
         debug!("batched_parse_block called, parsing blocks...");
-        let controller = self.controller.clone();
-        let controller = controller.read().await;
         let mut parsed_blocks: Vec<ParseBlockResponse> = Vec::new();
 
         for block in request.get_ref().request.iter() {
-            let block = controller
-                .parse_block(&block)
+            let bytes = chain::wire::decompress_block_bytes(block.as_slice())
+                .map_err(|e| Status::internal(format!("could not decompress block: {}", e)))?;
+            let block = Controller::parse_block_header(&bytes)
                 .map_err(|_| Status::internal("could not parse block"))?;
             let block_id = block
                 .id()
@@ -726,10 +903,10 @@ impl Vm for VirtualMachine {
             "get_block_id_at_height called, retrieving block id at height {}...",
             request.get_ref().height
         );
-        let controller = self.controller.clone();
-        let controller = controller.read().await;
-
-        match controller.get_block_by_height(request.get_ref().height as u32) {
+        match self
+            .block_reads()?
+            .get_block_by_height(request.get_ref().height as u32)
+        {
             Ok(Some(block)) => {
                 let block_id = block
                     .id()
@@ -825,6 +1002,24 @@ impl Http for VirtualMachine {
         &self,
         request: Request<http::HandleSimpleHttpRequest>,
     ) -> Result<tonic::Response<http::HandleSimpleHttpResponse>, Status> {
+        // avalanchego forwards the request path, so a plain GET of the VM's
+        // /metrics endpoint can be answered here without going through the
+        // JSON-RPC dispatcher.
+        if request.get_ref().url.ends_with("/metrics") {
+            return Ok(Response::new(http::HandleSimpleHttpResponse {
+                code: 200,
+                headers: vec![Element {
+                    key: "Content-Type".to_string(),
+                    values: vec!["text/plain; version=0.0.4".to_string()],
+                }],
+                body: {
+                    let mut body = pulsevm_core::metrics::METRICS.render();
+                    body.push_str(&pulsevm_core::memory_ledger::MEMORY_LEDGER.render());
+                    body.into_bytes()
+                },
+            }));
+        }
+
         let body = std::str::from_utf8(request.get_ref().body.as_slice())
             .map_err(|_| Status::invalid_argument("invalid utf-8"))?;
         let resp = self
@@ -0,0 +1,93 @@
+use std::{
+    collections::{HashMap, VecDeque},
+    sync::{Arc, Mutex},
+};
+
+use tokio::sync::OnceCell;
+
+use crate::state_history::delta_filter::DeltaFilter;
+
+/// Identifies one block's payload sections: block number, the
+/// fetch_block / fetch_traces / fetch_deltas flags, and the session's
+/// delta filter. Sessions asking for different slices of the same block
+/// cache independently; an indexer fleet sharing one filter shares one
+/// build.
+#[derive(Clone, PartialEq, Eq, Hash)]
+pub struct PayloadKey {
+    pub block_num: u32,
+    pub fetch_block: bool,
+    pub fetch_traces: bool,
+    pub fetch_deltas: bool,
+    pub delta_filter: Option<Arc<DeltaFilter>>,
+}
+
+/// Shared cache of serialized payload sections (block, traces, deltas —
+/// everything in a GetBlocksResponseV0 frame after the head/position
+/// prefix). Those sections are immutable once a block is accepted, so N
+/// sessions replaying overlapping ranges can share one log read,
+/// decompression and pack per block instead of repeating the work per
+/// client.
+///
+/// Concurrent requests for the same block are single-flight: the first
+/// session runs the build, the rest await the same cell and get the same
+/// `Arc`. A failed build (block not appended yet) leaves the cell empty,
+/// so the next attempt retries instead of caching the error.
+pub struct PayloadCache {
+    capacity: usize,
+    inner: Mutex<Inner>,
+}
+
+struct Inner {
+    map: HashMap<PayloadKey, Arc<OnceCell<Arc<Vec<u8>>>>>,
+    // Insertion order; eviction drops the oldest key. Replays insert
+    // blocks in ascending order, so this ages out the blocks every
+    // catching-up client has already passed.
+    order: VecDeque<PayloadKey>,
+}
+
+impl PayloadCache {
+    pub fn new(capacity: usize) -> Self {
+        Self {
+            capacity,
+            inner: Mutex::new(Inner {
+                map: HashMap::new(),
+                order: VecDeque::new(),
+            }),
+        }
+    }
+
+    /// Returns the cached payload sections for `key`, building them with
+    /// `build` if no session has yet. Sessions already waiting on an
+    /// in-flight build for the same key share its result.
+    pub async fn get_or_build<F, Fut>(&self, key: PayloadKey, build: F) -> anyhow::Result<Arc<Vec<u8>>>
+    where
+        F: FnOnce() -> Fut,
+        Fut: Future<Output = anyhow::Result<Vec<u8>>>,
+    {
+        let cell = {
+            let mut inner = self.inner.lock().unwrap();
+            let inner = &mut *inner;
+            let cell = inner
+                .map
+                .entry(key.clone())
+                .or_insert_with(|| {
+                    inner.order.push_back(key);
+                    Arc::new(OnceCell::new())
+                })
+                .clone();
+            // Evicted entries only leave the map; sessions still awaiting
+            // an evicted cell hold their own Arc to it.
+            while inner.order.len() > self.capacity {
+                if let Some(old) = inner.order.pop_front() {
+                    inner.map.remove(&old);
+                }
+            }
+            cell
+        };
+
+        let value = cell
+            .get_or_try_init(|| async { build().await.map(Arc::new) })
+            .await?;
+        Ok(value.clone())
+    }
+}
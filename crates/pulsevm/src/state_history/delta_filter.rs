@@ -0,0 +1,217 @@
+use pulsevm_core::name::Name;
+use pulsevm_proc_macros::{NumBytes, Read, Write};
+use pulsevm_serialization::{Read, ReadError, VarUint32};
+
+/// Server-side filter for the deltas payload of a block, sent by the
+/// client as an optional tail on get_blocks_request_v0 (old clients end
+/// the message at fetch_deltas and get unfiltered deltas).
+///
+/// `tables` keeps only the named table_delta sections ("contract_row",
+/// "account", ...); empty keeps every table. `accounts` additionally
+/// keeps only rows whose code account matches, for the contract-scoped
+/// tables where rows carry one (contract_table, contract_row and the
+/// contract_index* tables); empty keeps every row.
+#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
+pub struct DeltaFilter {
+    pub tables: Vec<String>,
+    pub accounts: Vec<Name>,
+}
+
+impl DeltaFilter {
+    pub fn is_empty(&self) -> bool {
+        self.tables.is_empty() && self.accounts.is_empty()
+    }
+
+    /// Contract-scoped tables serialize rows as struct_version followed
+    /// by the code account; only those can be filtered by account.
+    fn account_scoped(table: &str) -> bool {
+        table.starts_with("contract_")
+    }
+}
+
+fn push_varuint(out: &mut Vec<u8>, value: u32) {
+    let mut v = value;
+    loop {
+        let mut b = (v & 0x7F) as u8;
+        v >>= 7;
+        if v != 0 {
+            b |= 0x80;
+        }
+        out.push(b);
+        if v == 0 {
+            break;
+        }
+    }
+}
+
+/// Advances past one packed row (present bool, varint length, payload),
+/// returning the slice bounds of the whole row.
+fn skip_row(payload: &[u8], pos: &mut usize) -> Result<(usize, usize), ReadError> {
+    let start = *pos;
+    u8::read(payload, pos)?; // present
+    let len = VarUint32::read(payload, pos)?.0 as usize;
+    if payload.len() < *pos + len {
+        return Err(ReadError::NotEnoughBytes);
+    }
+    *pos += len;
+    Ok((start, *pos))
+}
+
+/// Rewrites a stored deltas payload keeping only what `filter` asks for.
+/// The walk is structural — table names, row counts and row lengths —
+/// so excluded tables and rows are skipped by length without decoding
+/// their contents; only the code account is peeked from rows of
+/// contract-scoped tables when an account filter is set. The output is
+/// the same table_delta[] encoding with corrected counts.
+pub fn filter_deltas(payload: &[u8], filter: &DeltaFilter) -> Result<Vec<u8>, ReadError> {
+    let mut pos = 0;
+    let num_tables = VarUint32::read(payload, &mut pos)?.0 as usize;
+
+    let mut kept_tables: u32 = 0;
+    let mut body: Vec<u8> = Vec::new();
+
+    for _ in 0..num_tables {
+        let header_start = pos;
+        let _struct_version = VarUint32::read(payload, &mut pos)?;
+        let name = String::read(payload, &mut pos)?;
+        let header_end = pos;
+        let num_rows = VarUint32::read(payload, &mut pos)?.0 as usize;
+
+        let keep_table = filter.tables.is_empty() || filter.tables.iter().any(|t| *t == name);
+        if !keep_table {
+            for _ in 0..num_rows {
+                skip_row(payload, &mut pos)?;
+            }
+            continue;
+        }
+
+        if filter.accounts.is_empty() || !DeltaFilter::account_scoped(&name) {
+            // Whole section survives; copy it verbatim.
+            let rows_start = pos;
+            for _ in 0..num_rows {
+                skip_row(payload, &mut pos)?;
+            }
+            body.extend_from_slice(&payload[header_start..header_end]);
+            push_varuint(&mut body, num_rows as u32);
+            body.extend_from_slice(&payload[rows_start..pos]);
+            kept_tables += 1;
+            continue;
+        }
+
+        let mut rows: Vec<u8> = Vec::new();
+        let mut kept_rows: u32 = 0;
+        for _ in 0..num_rows {
+            let (row_start, row_end) = skip_row(payload, &mut pos)?;
+            // Peek the code account: rows of contract-scoped tables are
+            // struct_version followed by the code name.
+            let mut peek = row_start;
+            u8::read(payload, &mut peek)?; // present
+            VarUint32::read(payload, &mut peek)?; // row length
+            VarUint32::read(payload, &mut peek)?; // row struct_version
+            let code = u64::read(payload, &mut peek)?;
+            if filter.accounts.iter().any(|a| a.as_u64() == code) {
+                rows.extend_from_slice(&payload[row_start..row_end]);
+                kept_rows += 1;
+            }
+        }
+        if kept_rows > 0 {
+            body.extend_from_slice(&payload[header_start..header_end]);
+            push_varuint(&mut body, kept_rows);
+            body.extend_from_slice(&rows);
+            kept_tables += 1;
+        }
+    }
+
+    let mut out = Vec::with_capacity(5 + body.len());
+    push_varuint(&mut out, kept_tables);
+    out.extend_from_slice(&body);
+    Ok(out)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn push_string(out: &mut Vec<u8>, s: &str) {
+        push_varuint(out, s.len() as u32);
+        out.extend_from_slice(s.as_bytes());
+    }
+
+    fn push_row(out: &mut Vec<u8>, present: bool, row: &[u8]) {
+        out.push(present as u8);
+        push_varuint(out, row.len() as u32);
+        out.extend_from_slice(row);
+    }
+
+    // A contract-scoped row: struct_version varint, then the code name.
+    fn contract_row(code: u64) -> Vec<u8> {
+        let mut row = vec![0u8];
+        row.extend_from_slice(&code.to_le_bytes());
+        row.extend_from_slice(b"rest-of-row");
+        row
+    }
+
+    fn sample_payload() -> Vec<u8> {
+        let mut p = Vec::new();
+        push_varuint(&mut p, 2); // two tables
+        push_varuint(&mut p, 0); // struct_version
+        push_string(&mut p, "account");
+        push_varuint(&mut p, 1);
+        push_row(&mut p, true, b"account-row");
+        push_varuint(&mut p, 0);
+        push_string(&mut p, "contract_row");
+        push_varuint(&mut p, 2);
+        push_row(&mut p, true, &contract_row(7));
+        push_row(&mut p, false, &contract_row(9));
+        p
+    }
+
+    #[test]
+    fn table_filter_drops_other_tables() {
+        let filter = DeltaFilter {
+            tables: vec!["contract_row".to_string()],
+            accounts: vec![],
+        };
+        let out = filter_deltas(&sample_payload(), &filter).unwrap();
+
+        let mut pos = 0;
+        assert_eq!(VarUint32::read(&out, &mut pos).unwrap().0, 1);
+        VarUint32::read(&out, &mut pos).unwrap();
+        assert_eq!(String::read(&out, &mut pos).unwrap(), "contract_row");
+        assert_eq!(VarUint32::read(&out, &mut pos).unwrap().0, 2);
+    }
+
+    #[test]
+    fn account_filter_drops_other_rows_and_empty_tables() {
+        let filter = DeltaFilter {
+            tables: vec![],
+            accounts: vec![Name::new(9)],
+        };
+        let out = filter_deltas(&sample_payload(), &filter).unwrap();
+
+        let mut pos = 0;
+        // "account" is not contract-scoped and survives untouched; the
+        // contract_row section keeps only the code-9 row.
+        assert_eq!(VarUint32::read(&out, &mut pos).unwrap().0, 2);
+        VarUint32::read(&out, &mut pos).unwrap();
+        assert_eq!(String::read(&out, &mut pos).unwrap(), "account");
+        assert_eq!(VarUint32::read(&out, &mut pos).unwrap().0, 1);
+        skip_row(&out, &mut pos).unwrap();
+        VarUint32::read(&out, &mut pos).unwrap();
+        assert_eq!(String::read(&out, &mut pos).unwrap(), "contract_row");
+        assert_eq!(VarUint32::read(&out, &mut pos).unwrap().0, 1);
+        let (start, _) = skip_row(&out, &mut pos).unwrap();
+        assert_eq!(out[start], 0); // the deleted (present = false) row
+        assert_eq!(pos, out.len());
+    }
+
+    #[test]
+    fn empty_filter_is_identity() {
+        let payload = sample_payload();
+        let filter = DeltaFilter {
+            tables: vec![],
+            accounts: vec![],
+        };
+        assert_eq!(filter_deltas(&payload, &filter).unwrap(), payload);
+    }
+}
@@ -1,3 +1,5 @@
+mod cache;
+mod delta_filter;
 mod request;
 mod session;
 mod types;
@@ -11,17 +13,26 @@ use tokio::{
 };
 use tokio_util::sync::CancellationToken;
 
-use crate::{VirtualMachine, state_history::session::Session};
+use crate::{
+    VirtualMachine,
+    state_history::{cache::PayloadCache, session::Session},
+};
+
+// Blocks' payload sections kept hot for sessions replaying overlapping
+// ranges; bounded so a lone deep-history replay cannot pin the heap.
+const PAYLOAD_CACHE_BLOCKS: usize = 256;
 
 #[derive(Clone)]
 pub struct StateHistoryServer {
     controller: Arc<RwLock<Controller>>,
+    payload_cache: Arc<PayloadCache>,
 }
 
 impl StateHistoryServer {
     pub fn new(vm: VirtualMachine) -> Self {
         Self {
             controller: vm.controller.clone(),
+            payload_cache: Arc::new(PayloadCache::new(PAYLOAD_CACHE_BLOCKS)),
         }
     }
 
@@ -43,9 +54,10 @@ impl StateHistoryServer {
                     let (stream, peer): (tokio::net::TcpStream, SocketAddr) = accept_res?;
                     stream.set_nodelay(true).ok();
                     let controller = self.controller.clone();
+                    let payload_cache = self.payload_cache.clone();
 
                     tokio::spawn(async move {
-                        let mut session = Session::new(peer, controller);
+                        let mut session = Session::new(peer, controller, payload_cache);
                         if let Err(e) = session.start(stream).await {
                             eprintln!("{} conn error: {e:?}", peer);
                         }
@@ -12,8 +12,7 @@ use futures_util::{SinkExt, StreamExt};
 use pulsevm_core::{
     controller::Controller, state_history::SHIP_ABI, transaction::TransactionTrace,
 };
-use pulsevm_crypto::Bytes;
-use pulsevm_serialization::{Read, Write};
+use pulsevm_serialization::{NumBytes, Read, Write};
 use spdlog::{debug, error, info, warn};
 use tokio::{
     sync::{
@@ -26,16 +25,20 @@ use tokio_tungstenite::accept_async;
 use tungstenite::Message;
 
 use crate::state_history::{
+    cache::{PayloadCache, PayloadKey},
+    delta_filter::{DeltaFilter, filter_deltas},
     request::RequestType,
     types::{
-        BlockPosition, GetBlocksAckRequestV0, GetBlocksRequestV0, GetBlocksResponseV0,
-        GetStatusResult, TransactionTraceV0,
+        BlockPosition, GetBlocksAckRequestV0, GetBlocksRequestV0, GetStatusResult,
+        TransactionTraceV0,
     },
 };
 
 pub struct Session {
     peer: SocketAddr,
     controller: Arc<RwLock<Controller>>,
+    // Payload sections shared across all sessions; see PayloadCache.
+    payload_cache: Arc<PayloadCache>,
     current_request: Option<GetBlocksRequestV0>,
     to_send_block_num: u32,
     // streaming control
@@ -44,10 +47,15 @@ pub struct Session {
 }
 
 impl Session {
-    pub fn new(peer: SocketAddr, controller: Arc<RwLock<Controller>>) -> Self {
+    pub fn new(
+        peer: SocketAddr,
+        controller: Arc<RwLock<Controller>>,
+        payload_cache: Arc<PayloadCache>,
+    ) -> Self {
         Self {
             peer,
             controller,
+            payload_cache,
             current_request: None,
             to_send_block_num: 0,
             stream_cancel: None,
@@ -94,10 +102,22 @@ impl Session {
                             let _ = tx_out.send(Message::Binary(packed)).await;
                         }
                         RequestType::GetBlocksRequestV0 => {
+                            let mut pos = 1;
                             let mut request =
-                                GetBlocksRequestV0::read(&b, &mut 1).map_err(|e| {
+                                GetBlocksRequestV0::read(&b, &mut pos).map_err(|e| {
                                     anyhow!("failed to parse GetBlocksRequestV0: {:?}", e)
                                 })?;
+                            // Optional trailing delta filter; old clients end
+                            // the message at fetch_deltas and get everything.
+                            let delta_filter = if pos < b.len() {
+                                Some(DeltaFilter::read(&b, &mut pos).map_err(|e| {
+                                    anyhow!("failed to parse delta filter: {:?}", e)
+                                })?)
+                            } else {
+                                None
+                            };
+                            let delta_filter =
+                                delta_filter.filter(|f| !f.is_empty()).map(Arc::new);
                             self.update_current_request(&mut request).await?;
 
                             // Initialize window (fallback if zero)
@@ -124,88 +144,119 @@ impl Session {
 
                             // Spawn background producer
                             let ctrl = self.controller.clone();
+                            let payload_cache = self.payload_cache.clone();
                             let start_from = self.to_send_block_num;
                             let tx_clone = tx_out.clone();
                             let budget = in_flight_budget.clone();
 
                             self.stream_handle = Some(tokio::spawn(async move {
-                                let mut next = start_from;
+                                // Pipelined reader: up to PREFETCH_DEPTH block
+                                // responses are built (log reads, decompression,
+                                // packing) concurrently on their own tasks,
+                                // ahead of the send loop. Sends stay strictly
+                                // in block order. Backpressure is end-to-end:
+                                // the ACK window gates sends, and tx_clone is a
+                                // bounded channel into the socket writer, so a
+                                // slow socket suspends the whole pipeline
+                                // instead of buffering a million blocks.
+                                const PREFETCH_DEPTH: usize = 8;
+
+                                let spawn_fetch = |block_num: u32| {
+                                    let ctrl = ctrl.clone();
+                                    let cache = payload_cache.clone();
+                                    let request = request.clone();
+                                    let delta_filter = delta_filter.clone();
+                                    tokio::spawn(async move {
+                                        make_block_frame_for(
+                                            ctrl,
+                                            cache,
+                                            &request,
+                                            delta_filter,
+                                            block_num,
+                                        )
+                                        .await
+                                    })
+                                };
+
+                                let mut next_fetch = start_from;
+                                let mut pending: std::collections::VecDeque<(
+                                    u32,
+                                    JoinHandle<Result<Vec<u8>>>,
+                                )> = std::collections::VecDeque::new();
 
-                                loop {
+                                'stream: loop {
                                     // cooperative cancel
                                     if stop_rx.has_changed().unwrap_or(false) {
                                         break;
                                     }
 
-                                    // backpressure window
-                                    let current = budget.load(Ordering::SeqCst);
-                                    if current <= 0 {
-                                        tokio::time::sleep(Duration::from_millis(3)).await;
-                                        continue;
-                                    }
-                                    if budget
-                                        .compare_exchange(
-                                            current,
-                                            current - 1,
-                                            Ordering::SeqCst,
-                                            Ordering::SeqCst,
-                                        )
-                                        .is_err()
+                                    // keep the pipeline full
+                                    while pending.len() < PREFETCH_DEPTH
+                                        && (request.end_block_num == 0
+                                            || next_fetch <= request.end_block_num)
                                     {
-                                        // lost the race for a slot; retry acquisition
-                                        continue;
+                                        pending.push_back((next_fetch, spawn_fetch(next_fetch)));
+                                        next_fetch = next_fetch.saturating_add(1);
                                     }
-                                    // slot acquired: fall through and stream this block
-
-                                    match make_block_response_for(ctrl.clone(), &request, next)
-                                        .await
-                                    {
-                                        Ok(resp) => {
-                                            match resp.pack() {
-                                                Ok(bytes) => {
-                                                    if tx_clone
-                                                        .send(Message::Binary(bytes))
-                                                        .await
-                                                        .is_err()
-                                                    {
-                                                        // writer/socket is gone, stop
-                                                        break;
-                                                    }
-                                                    next = next.saturating_add(1);
-
-                                                    if request.end_block_num > 0
-                                                        && next > request.end_block_num
-                                                    {
-                                                        break;
-                                                    }
-                                                }
-                                                Err(e) => {
-                                                    error!(
-                                                        "[ship] failed to pack block response for block {next}: {e}"
-                                                    );
-                                                    // give window slot back
-                                                    budget.fetch_add(1, Ordering::SeqCst);
-                                                    tokio::time::sleep(Duration::from_millis(5))
-                                                        .await;
-                                                }
-                                            }
-                                        }
-                                        Err(e) => {
-                                            // Likely "block not ready yet" — backoff and retry
-                                            // return slot because nothing was sent
+                                    let Some((block_num, handle)) = pending.pop_front() else {
+                                        break; // bounded range fully sent
+                                    };
+
+                                    let bytes = match handle.await {
+                                        Ok(Ok(bytes)) => bytes,
+                                        Ok(Err(e)) => {
+                                            // Likely "block not ready yet" at the
+                                            // head — backoff, then retry this block
+                                            // at the front; later prefetches stay
+                                            // queued and retry in turn if needed.
                                             warn!(
-                                                "[ship] make_block_response_for failed for block {next}: {e}"
+                                                "[ship] failed to build response for block {block_num}: {e}"
                                             );
-                                            budget.fetch_add(1, Ordering::SeqCst);
                                             tokio::time::sleep(Duration::from_millis(500)).await;
+                                            pending.push_front((block_num, spawn_fetch(block_num)));
+                                            continue;
+                                        }
+                                        Err(e) => {
+                                            error!(
+                                                "[ship] prefetch task for block {block_num} panicked: {e}"
+                                            );
+                                            break;
+                                        }
+                                    };
+
+                                    // backpressure window (ACK-driven)
+                                    loop {
+                                        if stop_rx.has_changed().unwrap_or(false) {
+                                            break 'stream;
+                                        }
+                                        let current = budget.load(Ordering::SeqCst);
+                                        if current <= 0 {
+                                            tokio::time::sleep(Duration::from_millis(3)).await;
+                                            continue;
+                                        }
+                                        if budget
+                                            .compare_exchange(
+                                                current,
+                                                current - 1,
+                                                Ordering::SeqCst,
+                                                Ordering::SeqCst,
+                                            )
+                                            .is_ok()
+                                        {
+                                            break; // slot acquired
                                         }
+                                        // lost the race for a slot; retry acquisition
                                     }
 
-                                    // react quickly to cancellation
-                                    if stop_rx.has_changed().unwrap_or(false) {
+                                    if tx_clone.send(Message::Binary(bytes)).await.is_err() {
+                                        // writer/socket is gone, stop
                                         break;
                                     }
                                 }
+
+                                for (_, handle) in pending {
+                                    handle.abort();
+                                }
                             }));
                         }
                         RequestType::GetBlocksAckRequestV0 => {
@@ -320,114 +371,264 @@ impl Session {
     }
 }
 
-// Builds a GetBlocksResponseV0 for a specific block number.
-// Replace internals with your real "get block by number" logic.
-// As-is, it waits until head >= block_num and then returns head as the block payload.
-async fn make_block_response_for(
+/// Appends a value's serialized form to the frame, sized exactly.
+/// `num_bytes` can over-estimate (varint length prefixes), so the frame is
+/// grown to the estimate, written, and trimmed back to what was written.
+fn append_packed<T: Write>(frame: &mut Vec<u8>, value: &T) -> Result<()> {
+    let start = frame.len();
+    frame.resize(start + value.num_bytes(), 0);
+    let mut pos = start;
+    value.write(frame, &mut pos)?;
+    frame.truncate(pos);
+    Ok(())
+}
+
+/// Appends the presence byte and varint length that `Option<Bytes>`
+/// serialization would produce, without needing the payload in a `Bytes`
+/// first; the payload itself follows via `extend_from_slice` or a direct
+/// `write` into the frame.
+fn append_payload_header(frame: &mut Vec<u8>, len: usize) {
+    frame.push(1);
+    let mut v = len as u32;
+    loop {
+        let mut b = (v & 0x7F) as u8;
+        v >>= 7;
+        if v != 0 {
+            b |= 0x80;
+        }
+        frame.push(b);
+        if v == 0 {
+            break;
+        }
+    }
+}
+
+/// Appends a payload as `Some(Bytes)` would serialize it, packing the value
+/// straight into the frame instead of through an intermediate `Vec`. The
+/// declared length is `num_bytes`, matching what packing into a `Bytes`
+/// produced before; readers parse the value and ignore any estimate slack.
+fn append_packed_payload<T: Write>(frame: &mut Vec<u8>, value: &T) -> Result<()> {
+    let n = value.num_bytes();
+    append_payload_header(frame, n);
+    let start = frame.len();
+    frame.resize(start + n, 0);
+    let mut pos = start;
+    value.write(frame, &mut pos)?;
+    Ok(())
+}
+
+// Builds the packed GetBlocksResponseV0 frame for a specific block number.
+// The head/position prefix moves with the chain and is rebuilt per send;
+// the payload sections are immutable per block and come from the shared
+// PayloadCache, so overlapping replays cost one build per block.
+async fn make_block_frame_for(
     controller: Arc<RwLock<Controller>>,
+    cache: Arc<PayloadCache>,
     request: &GetBlocksRequestV0,
+    delta_filter: Option<Arc<DeltaFilter>>,
     block_num: u32,
-) -> Result<GetBlocksResponseV0> {
-    let controller = controller.read().await;
-    let head = controller.last_accepted_block();
-
-    // Serveability bound: only advertise/serve blocks actually appended to block_log.
-    // last_accepted can run ~1 block ahead of what is on disk, and read_block would
-    // then return NotFound, stalling the reader. Bound the head to the on-disk last block.
-    let serveable = controller.block_log().map(|l| l.last_block()).unwrap_or(0);
+) -> Result<Vec<u8>> {
+    // Fixed-size response prefix; the payloads below follow in field order.
+    let mut frame: Vec<u8> = Vec::with_capacity(256);
+    {
+        let controller = controller.read().await;
+        let head = controller.last_accepted_block();
+
+        // Serveability bound: only advertise/serve blocks actually appended to block_log.
+        // last_accepted can run ~1 block ahead of what is on disk, and read_block would
+        // then return NotFound, stalling the reader. Bound the head to the on-disk last block.
+        let serveable = controller.block_log().map(|l| l.last_block()).unwrap_or(0);
 
-    if serveable < block_num {
-        return Err(anyhow!("block {block_num} not yet available"));
-    }
+        if serveable < block_num {
+            return Err(anyhow!("block {block_num} not yet available"));
+        }
 
-    let head_block_id = head.id()?;
-    let this_block_id = controller.get_block_id(block_num).await?.ok_or(anyhow!(
-        "block {block_num} not found, may not be available yet",
-    ))?;
-
-    // Get the previous block if it exists
-    let mut previous_block: Option<BlockPosition> = None;
-    if block_num > 1 {
-        if let Some(prev_id) = controller.get_block_id(block_num - 1).await? {
-            previous_block = Some(BlockPosition {
-                block_num: block_num - 1,
-                block_id: prev_id,
-            });
+        let head_block_id = head.id()?;
+        let this_block_id = controller.get_block_id(block_num).await?.ok_or(anyhow!(
+            "block {block_num} not found, may not be available yet",
+        ))?;
+
+        // Get the previous block if it exists
+        let mut previous_block: Option<BlockPosition> = None;
+        if block_num > 1 {
+            if let Some(prev_id) = controller.get_block_id(block_num - 1).await? {
+                previous_block = Some(BlockPosition {
+                    block_num: block_num - 1,
+                    block_id: prev_id,
+                });
+            }
         }
+
+        let serveable_head_id = controller
+            .get_block_id(serveable)
+            .await?
+            .unwrap_or(head_block_id);
+
+        append_packed(&mut frame, &1u8)?; // get_blocks_result_v0 variant
+        append_packed(
+            &mut frame,
+            &BlockPosition {
+                block_num: serveable,
+                block_id: serveable_head_id,
+            },
+        )?;
+        append_packed(
+            &mut frame,
+            &BlockPosition {
+                block_num: head.block_num(),
+                block_id: head_block_id,
+            },
+        )?;
+        append_packed(
+            &mut frame,
+            &Some(BlockPosition {
+                block_num,
+                block_id: this_block_id,
+            }),
+        )?;
+        append_packed(&mut frame, &previous_block)?;
     }
+    // The read lock is released before awaiting the shared build: the
+    // builder takes its own read lock, and holding ours across the await
+    // could deadlock behind a queued writer.
+
+    let key = PayloadKey {
+        block_num,
+        fetch_block: request.fetch_block,
+        fetch_traces: request.fetch_traces,
+        fetch_deltas: request.fetch_deltas,
+        delta_filter: delta_filter.clone(),
+    };
+    let sections = cache
+        .get_or_build(key, || {
+            build_payload_sections(
+                controller.clone(),
+                request.fetch_block,
+                request.fetch_traces,
+                request.fetch_deltas,
+                delta_filter,
+                block_num,
+            )
+        })
+        .await?;
+    frame.extend_from_slice(&sections);
 
-    let mut block: Option<Bytes> = None;
-    if request.fetch_block {
+    Ok(frame)
+}
+
+// Builds the serialized block/traces/deltas sections of the frame — the
+// expensive part: log reads, decompression, parsing and packing. Payloads
+// are copied exactly once, from the packed block / the memory-mapped log
+// pages directly into the section buffer; the PayloadCache runs this once
+// per block however many sessions ask.
+async fn build_payload_sections(
+    controller: Arc<RwLock<Controller>>,
+    fetch_block: bool,
+    fetch_traces: bool,
+    fetch_deltas: bool,
+    delta_filter: Option<Arc<DeltaFilter>>,
+    block_num: u32,
+) -> Result<Vec<u8>> {
+    let controller = controller.read().await;
+    let mut sections: Vec<u8> = Vec::new();
+
+    if fetch_block {
         let signed_block = match controller
             .get_block_by_height(block_num)
-            .map_err(|e| anyhow!("failed to get block {block_num} by id {this_block_id:?}: {e}"))?
+            .map_err(|e| anyhow!("failed to get block {block_num}: {e}"))?
         {
             Some(b) => b,
             None => {
                 error!(
-                    "[ship] get_block returned None for block {block_num} id {this_block_id:?} (read_block failed for synced block); aborting response build",
+                    "[ship] get_block returned None for block {block_num} (read_block failed for synced block); aborting response build",
                 );
-                return Err(anyhow!(
-                    "get_block returned None for block {block_num} id {this_block_id:?}",
-                ));
+                return Err(anyhow!("get_block returned None for block {block_num}"));
             }
         };
-        let signed_block_packed = signed_block.pack()?;
-        block = Some(Bytes::new(signed_block_packed));
+        append_packed_payload(&mut sections, &signed_block)?;
+    } else {
+        sections.push(0);
     }
 
-    let mut traces: Option<Bytes> = None;
-    if request.fetch_traces {
-        let trace_log = controller.trace_log();
-
-        if let Some(log) = trace_log {
-            if let Ok(packed_traces) = log.read_block(block_num) {
-                let transaction_traces: Vec<TransactionTrace> =
-                    Vec::read(&packed_traces, &mut 0)
-                        .map_err(|e| anyhow!("failed to read traces for block {block_num}: {e}"))?;
-                let converted_traces = transaction_traces
-                    .iter()
-                    .map(|t| TransactionTraceV0::from(t))
-                    .collect::<Vec<TransactionTraceV0>>();
-                let packed_converted_traces = converted_traces.pack()?;
-                traces = Some(Bytes::new(packed_converted_traces));
+    let mut wrote_traces = false;
+    if fetch_traces {
+        if let Some(log) = controller.trace_log() {
+            // Parse straight off the memory-mapped log pages; only the
+            // converted traces get packed into the outgoing section.
+            match log.read_block_with(block_num, |payload| {
+                Vec::<TransactionTrace>::read(payload, &mut 0)
+            }) {
+                Ok(parsed) => {
+                    let transaction_traces = parsed.map_err(|e| {
+                        anyhow!("failed to read traces for block {block_num}: {e}")
+                    })?;
+                    let converted_traces = transaction_traces
+                        .iter()
+                        .map(|t| TransactionTraceV0::from(t))
+                        .collect::<Vec<TransactionTraceV0>>();
+                    append_packed_payload(&mut sections, &converted_traces)?;
+                    wrote_traces = true;
+                }
+                Err(e) => {
+                    // The state-history writer appends asynchronously, so a
+                    // block can land in block_log before its traces land
+                    // here. Only blocks pruned off the front of the log are
+                    // legitimately (and permanently) absent; anything else
+                    // fails the build so the session retries instead of the
+                    // cache pinning a trace-less section for every client.
+                    let pruned = log.range().is_some_and(|(first, _)| block_num < first);
+                    if !pruned {
+                        return Err(anyhow!(
+                            "traces for block {block_num} not yet available: {e}"
+                        ));
+                    }
+                }
             }
         }
     }
+    if !wrote_traces {
+        sections.push(0);
+    }
 
-    let mut deltas: Option<Bytes> = None;
-    if request.fetch_deltas {
-        let chain_state_log = controller.chain_state_log();
-
-        if let Some(log) = chain_state_log {
-            if let Ok(packed_deltas) = log.read_block(block_num) {
-                deltas = Some(Bytes::new(packed_deltas));
+    let mut wrote_deltas = false;
+    if fetch_deltas {
+        if let Some(log) = controller.chain_state_log() {
+            // Deltas are stored pre-packed; unfiltered they go from the
+            // mapped log pages into the section in a single copy, and a
+            // session filter rewrites them table by table while decoding
+            // only the lengths and names it needs.
+            match log.read_block_with(block_num, |payload| {
+                if let Some(filter) = &delta_filter {
+                    let filtered = filter_deltas(payload, filter)?;
+                    append_payload_header(&mut sections, filtered.len());
+                    sections.extend_from_slice(&filtered);
+                } else {
+                    append_payload_header(&mut sections, payload.len());
+                    sections.extend_from_slice(payload);
+                }
+                Ok::<(), pulsevm_serialization::ReadError>(())
+            }) {
+                Ok(Ok(())) => wrote_deltas = true,
+                Ok(Err(e)) => {
+                    return Err(anyhow!(
+                        "failed to filter deltas for block {block_num}: {e}"
+                    ));
+                }
+                Err(e) => {
+                    // Same pruned-versus-lagging distinction as traces.
+                    let pruned = log.range().is_some_and(|(first, _)| block_num < first);
+                    if !pruned {
+                        return Err(anyhow!(
+                            "deltas for block {block_num} not yet available: {e}"
+                        ));
+                    }
+                }
             }
         }
     }
+    if !wrote_deltas {
+        sections.push(0);
+    }
 
-    let serveable_head_id = controller
-        .get_block_id(serveable)
-        .await?
-        .unwrap_or(head_block_id);
-
-    Ok(GetBlocksResponseV0 {
-        variant: 1,
-        head: BlockPosition {
-            block_num: serveable,
-            block_id: serveable_head_id,
-        },
-        last_irreversible: BlockPosition {
-            block_num: head.block_num(),
-            block_id: head_block_id,
-        },
-        this_block: Some(BlockPosition {
-            block_num,
-            block_id: this_block_id,
-        }),
-        prev_block: previous_block,
-        block: block,
-        traces: traces,
-        deltas: deltas,
-    })
+    Ok(sections)
 }
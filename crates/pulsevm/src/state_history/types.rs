@@ -228,7 +228,9 @@ impl From<&TransactionTrace> for TransactionTraceV0 {
                     at.account_ram_deltas.clone(),
                     None,
                     None,
-                    Bytes::new(at.return_value.clone()),
+                    // Refcount bump; the payload was copied out of wasm
+                    // memory once and is shared all the way to the log.
+                    at.return_value.clone(),
                 )
             })
             .collect();
@@ -262,6 +262,17 @@ impl PulseVmClient {
         let params = serde_json::to_value(packed_trx)?;
         self.rpc_call("pulsevm.issueTx", Some(params)).await
     }
+
+    /// Send any `pulsevm.*` method and return the raw `result` JSON, for
+    /// callers (benchmarks, ops tooling) that need a method without a typed
+    /// wrapper.
+    pub async fn rpc_value(
+        &self,
+        method: &str,
+        params: Option<Value>,
+    ) -> Result<Value, ClientError> {
+        self.rpc_call(method, params).await
+    }
 }
 
 #[cfg(test)]
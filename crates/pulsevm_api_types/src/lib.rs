@@ -109,4 +109,8 @@ pub struct ChainInfoResponse {
 pub struct IssueTxResponse {
     #[serde(rename(serialize = "txID", deserialize = "txID"))]
     pub tx_id: Id,
+    /// Trace of the server's speculative pre-execution, kept as raw JSON so
+    /// the client does not need the full trace type surface.
+    #[serde(default)]
+    pub processed: Option<serde_json::Value>,
 }
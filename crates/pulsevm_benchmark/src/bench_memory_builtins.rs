@@ -0,0 +1,92 @@
+use std::hint::black_box;
+use std::time::Instant;
+
+// Micro-benchmarks the data paths behind the wasm memory builtins: the old
+// staged approach (bounds-checked read into a fresh Vec, then write back)
+// against the direct-view approach now used by memcpy/memmove/memset/memcmp
+// (copy_within / fill / subslice cmp on the linear memory). Sizes cover the
+// small fixed copies contracts make constantly (16B, 64B) and a page-sized
+// serialized row (4KB).
+
+const SIZES: &[usize] = &[16, 64, 4096];
+const ITERATIONS: u32 = 1_000_000;
+const RUNS: usize = 5;
+
+fn time<F: FnMut()>(mut f: F) -> f64 {
+    let mut best = f64::MAX;
+    for _ in 0..RUNS {
+        let start = Instant::now();
+        for _ in 0..ITERATIONS {
+            f();
+        }
+        let elapsed = start.elapsed().as_secs_f64();
+        best = best.min(elapsed);
+    }
+    // Nanoseconds per operation, best of RUNS.
+    best * 1e9 / ITERATIONS as f64
+}
+
+fn main() {
+    println!(
+        "{:<10} {:>8} {:>12} {:>12} {:>8}",
+        "builtin", "size", "staged ns", "direct ns", "speedup"
+    );
+
+    for &size in SIZES {
+        // One contiguous buffer standing in for wasm linear memory, with
+        // disjoint source and destination ranges.
+        let mut memory = vec![0u8; size * 2 + 64];
+        for (i, b) in memory.iter_mut().enumerate() {
+            *b = i as u8;
+        }
+        let src = 0..size;
+        let dest_start = size + 64;
+
+        // memcpy: staged = read into scratch, write back; direct = copy_within.
+        let staged = time(|| {
+            let mut buf = vec![0u8; size];
+            buf.copy_from_slice(black_box(&memory[src.clone()]));
+            memory[dest_start..dest_start + size].copy_from_slice(&buf);
+        });
+        let direct = time(|| {
+            black_box(&mut memory).copy_within(src.clone(), dest_start);
+        });
+        report("memcpy", size, staged, direct);
+
+        // memset: staged = build a filled scratch, write back; direct = fill.
+        let staged = time(|| {
+            let buf = vec![0x5au8; size];
+            memory[dest_start..dest_start + size].copy_from_slice(black_box(&buf));
+        });
+        let direct = time(|| {
+            black_box(&mut memory)[dest_start..dest_start + size].fill(0x5a);
+        });
+        report("memset", size, staged, direct);
+
+        // memcmp: staged = copy both operands out, compare; direct = compare
+        // the subslices in place.
+        let staged = time(|| {
+            let mut a = vec![0u8; size];
+            a.copy_from_slice(black_box(&memory[src.clone()]));
+            let mut b = vec![0u8; size];
+            b.copy_from_slice(&memory[dest_start..dest_start + size]);
+            black_box(a.cmp(&b));
+        });
+        let direct = time(|| {
+            let mem = black_box(&memory);
+            black_box(mem[src.clone()].cmp(&mem[dest_start..dest_start + size]));
+        });
+        report("memcmp", size, staged, direct);
+    }
+}
+
+fn report(builtin: &str, size: usize, staged: f64, direct: f64) {
+    println!(
+        "{:<10} {:>8} {:>12.1} {:>12.1} {:>7.1}x",
+        builtin,
+        size,
+        staged,
+        direct,
+        staged / direct
+    );
+}
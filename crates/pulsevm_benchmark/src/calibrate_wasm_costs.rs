@@ -0,0 +1,32 @@
+use pulsevm_core::wasm_costs::{self, calibration};
+
+// Micro-benchmarks each wasm operator class through the baseline Cranelift
+// backend and prints measured costs next to the shipped cost table, so
+// drift between billed CPU and wall time shows up as a ratio away from 1.
+// Run on the reference hosts when repricing the table; a repricing bumps
+// WASM_COST_TABLE_VERSION and ships with a protocol upgrade.
+fn main() {
+    println!(
+        "wasm operator cost calibration (table version {})",
+        wasm_costs::WASM_COST_TABLE_VERSION
+    );
+    println!("{:<24} {:>8} {:>10} {:>8}", "class", "shipped", "measured", "ratio");
+
+    let measurements = match calibration::calibrate() {
+        Ok(measurements) => measurements,
+        Err(e) => {
+            eprintln!("calibration failed: {}", e);
+            std::process::exit(1);
+        }
+    };
+
+    for m in measurements {
+        println!(
+            "{:<24} {:>8} {:>10.2} {:>8.2}",
+            m.class,
+            m.shipped_cost,
+            m.measured_units,
+            m.measured_units / m.shipped_cost as f64
+        );
+    }
+}
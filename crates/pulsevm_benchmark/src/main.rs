@@ -22,6 +22,7 @@ use pulsevm_core::{
     time::TimePointSec,
     transaction::{Action, PackedTransaction, Transaction, TransactionHeader},
 };
+use pulsevm_name_macro::name;
 use pulsevm_proc_macros::{NumBytes, Read, Write};
 use pulsevm_serialization::Write;
 use serde_json::json;
@@ -60,7 +61,7 @@ async fn main() {
         .execute_transaction(
             &create_account(
                 &private_key,
-                Name::from_str("pulse.token").unwrap(),
+                Name::new(name!("pulse.token")),
                 controller.chain_id().clone(),
             )
             .unwrap(),
@@ -76,7 +77,7 @@ async fn main() {
         .execute_transaction(
             &create_account(
                 &private_key,
-                Name::from_str("alice").unwrap(),
+                Name::new(name!("alice")),
                 controller.chain_id().clone(),
             )
             .unwrap(),
@@ -92,7 +93,7 @@ async fn main() {
         .execute_transaction(
             &create_account(
                 &private_key,
-                Name::from_str("bob").unwrap(),
+                Name::new(name!("bob")),
                 controller.chain_id().clone(),
             )
             .unwrap(),
@@ -118,7 +119,7 @@ async fn main() {
         .execute_transaction(
             &set_code(
                 &private_key,
-                Name::from_str("pulse.token").unwrap(),
+                Name::new(name!("pulse.token")),
                 pulse_token_contract,
                 controller.chain_id().clone(),
             )
@@ -131,7 +132,7 @@ async fn main() {
         .execute_transaction(
             &set_abi(
                 &private_key,
-                Name::from_str("pulse.token").unwrap(),
+                Name::new(name!("pulse.token")),
                 packed_abi_bytes,
                 controller.chain_id().clone(),
             )
@@ -145,15 +146,15 @@ async fn main() {
         .execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                Name::from_str("create").unwrap(),
+                Name::new(name!("pulse.token")),
+                Name::new(name!("create")),
                 &Create {
-                    issuer: Name::from_str("pulse.token").unwrap(),
+                    issuer: Name::new(name!("pulse.token")),
                     max_supply: Asset::new(100000000, Symbol::from_str("4,EOS").unwrap()),
                 },
                 controller.chain_id().clone(),
                 vec![PermissionLevel::new(
-                    Name::from_str("pulse.token").unwrap().as_u64(),
+                    Name::new(name!("pulse.token")).as_u64(),
                     ACTIVE_NAME.as_u64(),
                 )],
             )
@@ -167,10 +168,10 @@ async fn main() {
         .execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                Name::from_str("issue").unwrap(),
+                Name::new(name!("pulse.token")),
+                Name::new(name!("issue")),
                 &Issue {
-                    to: Name::from_str("pulse.token").unwrap(),
+                    to: Name::new(name!("pulse.token")),
                     quantity: Asset {
                         amount: 100000000,
                         symbol: Symbol::from_str("4,EOS").unwrap(),
@@ -179,7 +180,7 @@ async fn main() {
                 },
                 controller.chain_id().clone(),
                 vec![PermissionLevel::new(
-                    Name::from_str("pulse.token").unwrap().as_u64(),
+                    Name::new(name!("pulse.token")).as_u64(),
                     ACTIVE_NAME.as_u64(),
                 )],
             )
@@ -193,11 +194,11 @@ async fn main() {
         .execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                Name::from_str("transfer").unwrap(),
+                Name::new(name!("pulse.token")),
+                Name::new(name!("transfer")),
                 &Transfer {
-                    from: Name::from_str("pulse.token").unwrap(),
-                    to: Name::from_str("alice").unwrap(),
+                    from: Name::new(name!("pulse.token")),
+                    to: Name::new(name!("alice")),
                     quantity: Asset {
                         amount: 100000000,
                         symbol: Symbol::from_str("4,EOS").unwrap(),
@@ -206,7 +207,7 @@ async fn main() {
                 },
                 controller.chain_id().clone(),
                 vec![PermissionLevel::new(
-                    Name::from_str("pulse.token").unwrap().as_u64(),
+                    Name::new(name!("pulse.token")).as_u64(),
                     ACTIVE_NAME.as_u64(),
                 )],
             )
@@ -221,11 +222,11 @@ async fn main() {
             .execute_transaction(
                 &call_contract(
                     &private_key,
-                    Name::from_str("pulse.token").unwrap(),
-                    Name::from_str("transfer").unwrap(),
+                    Name::new(name!("pulse.token")),
+                    Name::new(name!("transfer")),
                     &Transfer {
-                        from: Name::from_str("alice").unwrap(),
-                        to: Name::from_str("bob").unwrap(),
+                        from: Name::new(name!("alice")),
+                        to: Name::new(name!("bob")),
                         quantity: Asset {
                             amount: 5000,
                             symbol: Symbol::from_str("4,EOS").unwrap(),
@@ -234,7 +235,7 @@ async fn main() {
                     },
                     controller.chain_id().clone(),
                     vec![PermissionLevel::new(
-                        Name::from_str("alice").unwrap().as_u64(),
+                        Name::new(name!("alice")).as_u64(),
                         ACTIVE_NAME.as_u64(),
                     )],
                 )
@@ -271,10 +272,10 @@ fn create_account(
         ),
         vec![],
         vec![Action::new(
-            Name::from_str("pulse")?,
-            Name::from_str("newaccount")?,
+            Name::new(name!("pulse")),
+            Name::new(name!("newaccount")),
             NewAccount {
-                creator: Name::from_str("pulse")?,
+                creator: Name::new(name!("pulse")),
                 name: account,
                 owner: authority.clone(),
                 active: authority.clone(),
@@ -309,8 +310,8 @@ fn set_code(
         ),
         vec![],
         vec![Action::new(
-            Name::from_str("pulse").unwrap(),
-            Name::from_str("setcode").unwrap(),
+            Name::new(name!("pulse")),
+            Name::new(name!("setcode")),
             SetCode {
                 account,
                 vm_type: 0,
@@ -344,8 +345,8 @@ fn set_abi(
         ),
         vec![],
         vec![Action::new(
-            Name::from_str("pulse").unwrap(),
-            Name::from_str("setabi").unwrap(),
+            Name::new(name!("pulse")),
+            Name::new(name!("setabi")),
             SetAbi {
                 account,
                 abi: Arc::new(abi_bytes.into()),
@@ -0,0 +1,165 @@
+//! Mainnet shadow bench: capture a range of real blocks from a production
+//! node's block log and replay them against the local build with per-phase
+//! timing breakdowns.
+//!
+//! Synthetic transfer loops do not exercise the real contract mix, so this
+//! is the honest way to evaluate execution changes: replay the same captured
+//! blocks before and after a change and diff the phase totals.
+//!
+//! Capture, on (a copy of) the production node's database directory:
+//!
+//!     mainnet_shadow_bench capture <node_db_dir> <first> <last> <out_dir>
+//!
+//! `first` must be the revision of the state snapshot the replay will start
+//! from — it becomes the replay anchor and is not re-executed; blocks
+//! `first+1..=last` are. The captured blocks land in `<out_dir>` as a
+//! standalone block log in the node's own `StateHistoryLog` format.
+//!
+//! Replay, against a state directory holding `shared_memory.bin` at the
+//! anchor revision plus the captured block log (or with `--snapshot` to
+//! restore the state image into the directory first):
+//!
+//!     mainnet_shadow_bench replay <state_dir> <genesis.json> <chain_id> [--snapshot <file>]
+//!
+//! The replay itself is the controller's own block-log replay path, so the
+//! bench measures exactly the code a node runs when catching up. Replayed
+//! blocks skip signature and authorization checks by design, so the auth
+//! phase reads zero here; decode runs on the pipelined reader thread and
+//! overlaps execution, which is why the phase shares need not sum to 100%.
+
+use std::{env, fs, process::exit, str::FromStr, time::Instant};
+
+use pulsevm_core::{
+    controller::Controller,
+    exec_phases::{EXEC_PHASES, PHASE_NAMES},
+    id::Id,
+    state_history::StateHistoryLog,
+};
+use serde_json::json;
+
+#[tokio::main]
+async fn main() {
+    let args: Vec<String> = env::args().collect();
+    match args.get(1).map(String::as_str) {
+        Some("capture") if args.len() == 6 => capture(&args[2], &args[3], &args[4], &args[5]),
+        Some("replay") if args.len() == 5 || args.len() == 7 => {
+            let snapshot = match (args.get(5).map(String::as_str), args.get(6)) {
+                (Some("--snapshot"), Some(path)) => Some(path.clone()),
+                (None, None) => None,
+                _ => return usage(),
+            };
+            replay(&args[2], &args[3], &args[4], snapshot)
+        }
+        _ => usage(),
+    }
+}
+
+fn usage() {
+    eprintln!("usage:");
+    eprintln!("  mainnet_shadow_bench capture <node_db_dir> <first> <last> <out_dir>");
+    eprintln!("  mainnet_shadow_bench replay <state_dir> <genesis.json> <chain_id> [--snapshot <file>]");
+    exit(2);
+}
+
+fn capture(node_db_dir: &str, first: &str, last: &str, out_dir: &str) {
+    let first: u32 = first.parse().expect("first must be a block number");
+    let last: u32 = last.parse().expect("last must be a block number");
+    assert!(first <= last, "first must not be past last");
+
+    let src = StateHistoryLog::open_with_magic(node_db_dir, "block_log", 0)
+        .expect("failed to open source block log");
+    let (log_first, log_last) = src.range().expect("source block log is empty");
+    assert!(
+        first >= log_first && last <= log_last,
+        "requested range {}..={} outside the log's {}..={}",
+        first,
+        last,
+        log_first,
+        log_last
+    );
+
+    fs::create_dir_all(out_dir).expect("failed to create output directory");
+    let dst = StateHistoryLog::open_with_magic(out_dir, "block_log", 0)
+        .expect("failed to open output block log");
+    assert!(
+        dst.range().is_none(),
+        "output directory already contains a block log"
+    );
+
+    for block_num in first..=last {
+        let id = src
+            .get_block_id(block_num)
+            .expect("failed to read block id");
+        let payload = src.read_block(block_num).expect("failed to read block");
+        dst.append_relaxed(id, &payload)
+            .expect("failed to append captured block");
+    }
+    dst.sync().expect("failed to sync captured block log");
+
+    println!(
+        "captured blocks {}..={} into {} (anchor {}, {} to replay)",
+        first,
+        last,
+        out_dir,
+        first,
+        last - first
+    );
+}
+
+fn replay(state_dir: &str, genesis_path: &str, chain_id: &str, snapshot: Option<String>) {
+    let chain_id = Id::from_str(chain_id).expect("invalid chain id");
+    let genesis = fs::read(genesis_path).expect("failed to read genesis file");
+
+    // The producer key is required by initialize but the bench never
+    // produces or signs a block with it.
+    let mut config = json!({
+        "producer_name": "pulse",
+        "producer_key": "PVT_K1_5G7JEG7CWZkGfnaQePCcJSNgocGFoeCxG1pU7r1B6rY2gueez",
+    });
+    if let Some(path) = snapshot {
+        config["snapshot_restore_path"] = json!(path);
+    }
+    let config_bytes = config.to_string().into_bytes();
+
+    // Read the range up front; the controller owns the log from initialize
+    // on. The first block is the anchor and is not executed.
+    let (first, last) = {
+        let log = StateHistoryLog::open_with_magic(state_dir, "block_log", 0)
+            .expect("failed to open captured block log");
+        log.range().expect("captured block log is empty")
+    };
+    let blocks = last - first;
+
+    EXEC_PHASES.set_enabled(true);
+    let mut controller = Controller::new();
+    let start = Instant::now();
+    controller
+        .initialize(&chain_id, &config_bytes, &genesis, state_dir)
+        .expect("replay failed");
+    let wall = start.elapsed();
+    controller.shutdown().expect("failed to shut down");
+
+    let snap = EXEC_PHASES.snapshot();
+    let wall_ms = wall.as_secs_f64() * 1e3;
+    println!();
+    println!(
+        "replayed {} blocks ({}..={}) in {:.1} ms — {:.1} blocks/s",
+        blocks,
+        first + 1,
+        last,
+        wall_ms,
+        blocks as f64 / wall.as_secs_f64()
+    );
+    println!();
+    println!("{:<8} {:>12} {:>10} {:>9}", "phase", "total_ms", "count", "share");
+    for (i, name) in PHASE_NAMES.iter().enumerate() {
+        let total_ms = snap.total_us[i] as f64 / 1e3;
+        println!(
+            "{:<8} {:>12.1} {:>10} {:>8.1}%",
+            name,
+            total_ms,
+            snap.counts[i],
+            100.0 * total_ms / wall_ms
+        );
+    }
+}
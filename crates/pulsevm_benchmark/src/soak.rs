@@ -0,0 +1,756 @@
+//! End-to-end TPS soak harness: a load generator driving a real node over
+//! its JSON-RPC interface with a configurable transaction mix, phased load
+//! (warm-up, ramp, sustain), and a latency/throughput report.
+//!
+//! The in-process benchmark (`main.rs`) measures raw controller execution;
+//! this harness is the acceptance gate for whole-node changes — every
+//! submission goes through signature recovery, speculative execution,
+//! admission and gossip exactly as a wallet's would, and latency is the
+//! full RPC round trip.
+//!
+//!     soak <node_url> [--key <PVT_K1_…>] [--chain-id <hex>]
+//!          [--tps <n>] [--warmup <secs>] [--ramp <secs>] [--sustain <secs>]
+//!          [--workers <n>] [--mix transfer:90,inline:8,multisig:2]
+//!          [--skip-setup]
+//!
+//! `node_url` is the chain's RPC base (e.g. `http://127.0.0.1:9650/ext/bc/<id>/rpc`).
+//! `--key` must hold the `pulse` authority so setup can create the soak
+//! accounts; it defaults to the development key the other benches use.
+//!
+//! Mix classes:
+//!   transfer  — one pulse_token transfer, one authorization
+//!   inline    — transfer into an account that itself carries the token
+//!               contract, so the notification dispatches a second wasm
+//!               invocation (the cross-contract leg)
+//!   multisig  — transfer from a threshold-2 account, two signatures
+//!
+//! Warm-up results are discarded; ramp and sustain are reported separately,
+//! and the sustain percentiles are the acceptance numbers. Node-side
+//! counters (blocks produced, execution phase profile, per-contract
+//! accounting) are fetched over RPC after the run.
+
+use std::{
+    env,
+    process::exit,
+    str::FromStr,
+    sync::{
+        Arc, Mutex,
+        atomic::{AtomicU64, Ordering},
+    },
+    time::{Duration, Instant, SystemTime, UNIX_EPOCH},
+};
+
+use pulsevm_api_client::PulseVmClient;
+use pulsevm_core::{
+    ACTIVE_NAME, ChainError, PULSE_NAME,
+    abi::AbiDefinition,
+    asset::{Asset, Symbol},
+    authority::{Authority, KeyWeight, PermissionLevel},
+    crypto::PrivateKey,
+    id::Id,
+    name::Name,
+    pulse_contract::{NewAccount, SetAbi, SetCode},
+    time::TimePointSec,
+    transaction::{Action, PackedTransaction, Transaction, TransactionHeader},
+};
+use pulsevm_name_macro::name;
+use pulsevm_proc_macros::{NumBytes, Read, Write};
+use pulsevm_serialization::Write;
+use serde_json::json;
+use tokio::sync::mpsc;
+
+const DEFAULT_KEY: &str = "PVT_K1_5G7JEG7CWZkGfnaQePCcJSNgocGFoeCxG1pU7r1B6rY2gueez";
+const DEFAULT_CHAIN_ID: &str = "c8c4a47932fc0a938972f48f32489e7e91f024697e498ceb3d3c3afcf28f68b6";
+/// Warm-up runs at this fraction of the target rate.
+const WARMUP_FRACTION: f64 = 0.1;
+/// Scheduler tick; load is dispensed as the integral of the rate curve over
+/// these ticks, so the pacing error is bounded by one tick.
+const TICK: Duration = Duration::from_millis(10);
+
+#[derive(Clone)]
+struct Config {
+    url: String,
+    key: PrivateKey,
+    chain_id: Id,
+    tps: f64,
+    warmup: Duration,
+    ramp: Duration,
+    sustain: Duration,
+    workers: usize,
+    /// Cumulative percentage thresholds for (transfer, inline); the
+    /// remainder is multisig.
+    mix_transfer: u64,
+    mix_inline: u64,
+    skip_setup: bool,
+}
+
+#[derive(Clone, Copy, PartialEq, Eq, Debug)]
+enum Phase {
+    Warmup,
+    Ramp,
+    Sustain,
+}
+
+#[derive(Clone, Copy)]
+enum TxClass {
+    Transfer,
+    Inline,
+    Multisig,
+}
+
+impl TxClass {
+    fn label(&self) -> &'static str {
+        match self {
+            TxClass::Transfer => "transfer",
+            TxClass::Inline => "inline",
+            TxClass::Multisig => "multisig",
+        }
+    }
+}
+
+#[derive(Default)]
+struct PhaseStats {
+    latencies_us: Vec<u64>,
+    ok: u64,
+    errors: u64,
+    shed: u64,
+    first_send: Option<Instant>,
+    last_send: Option<Instant>,
+}
+
+#[tokio::main]
+async fn main() {
+    let config = match parse_args() {
+        Some(config) => config,
+        None => return usage(),
+    };
+
+    let client = Arc::new(PulseVmClient::new(&config.url));
+    let info = client.get_info().await.unwrap_or_else(|e| {
+        eprintln!("cannot reach node at {}: {}", config.url, e);
+        exit(1);
+    });
+    println!(
+        "node {} — head block {} ({})",
+        info.server_version_string, info.head_block_num, info.head_block_time
+    );
+
+    let accounts = SoakAccounts::new();
+    if !config.skip_setup {
+        if let Err(e) = setup(&client, &config, &accounts).await {
+            eprintln!("setup failed: {}", e);
+            eprintln!("(rerun with --skip-setup if the soak accounts already exist)");
+            exit(1);
+        }
+    }
+
+    let head_before = info.head_block_num;
+    let report = run_load(client.clone(), &config, Arc::new(accounts)).await;
+    print_report(&config, &report);
+    print_node_counters(&client, head_before).await;
+}
+
+fn usage() {
+    eprintln!("usage:");
+    eprintln!("  soak <node_url> [--key <PVT_K1_...>] [--chain-id <hex>]");
+    eprintln!("       [--tps <n>] [--warmup <secs>] [--ramp <secs>] [--sustain <secs>]");
+    eprintln!("       [--workers <n>] [--mix transfer:90,inline:8,multisig:2]");
+    eprintln!("       [--skip-setup]");
+    exit(2);
+}
+
+fn parse_args() -> Option<Config> {
+    let args: Vec<String> = env::args().collect();
+    let url = args.get(1)?.clone();
+    if url.starts_with("--") {
+        return None;
+    }
+
+    let mut config = Config {
+        url,
+        key: PrivateKey::from_str(DEFAULT_KEY).ok()?,
+        chain_id: Id::from_str(DEFAULT_CHAIN_ID).ok()?,
+        tps: 200.0,
+        warmup: Duration::from_secs(10),
+        ramp: Duration::from_secs(30),
+        sustain: Duration::from_secs(120),
+        workers: 32,
+        mix_transfer: 90,
+        mix_inline: 98,
+        skip_setup: false,
+    };
+
+    let mut i = 2;
+    while i < args.len() {
+        let value = |i: usize| args.get(i + 1).cloned();
+        match args[i].as_str() {
+            "--key" => config.key = PrivateKey::from_str(&value(i)?).ok()?,
+            "--chain-id" => config.chain_id = Id::from_str(&value(i)?).ok()?,
+            "--tps" => config.tps = value(i)?.parse().ok()?,
+            "--warmup" => config.warmup = Duration::from_secs(value(i)?.parse().ok()?),
+            "--ramp" => config.ramp = Duration::from_secs(value(i)?.parse().ok()?),
+            "--sustain" => config.sustain = Duration::from_secs(value(i)?.parse().ok()?),
+            "--workers" => config.workers = value(i)?.parse().ok()?,
+            "--mix" => {
+                let (transfer, inline) = parse_mix(&value(i)?)?;
+                config.mix_transfer = transfer;
+                config.mix_inline = transfer + inline;
+            }
+            "--skip-setup" => {
+                config.skip_setup = true;
+                i += 1;
+                continue;
+            }
+            _ => return None,
+        }
+        i += 2;
+    }
+    if config.tps <= 0.0 || config.workers == 0 {
+        return None;
+    }
+    Some(config)
+}
+
+/// Parses "transfer:90,inline:8,multisig:2" into (transfer, inline)
+/// percentages; the three must sum to 100.
+fn parse_mix(spec: &str) -> Option<(u64, u64)> {
+    let mut transfer = 0u64;
+    let mut inline = 0u64;
+    let mut multisig = 0u64;
+    for part in spec.split(',') {
+        let (class, pct) = part.split_once(':')?;
+        let pct: u64 = pct.parse().ok()?;
+        match class {
+            "transfer" => transfer = pct,
+            "inline" => inline = pct,
+            "multisig" => multisig = pct,
+            _ => return None,
+        }
+    }
+    if transfer + inline + multisig != 100 {
+        return None;
+    }
+    Some((transfer, inline))
+}
+
+/// The fixed account set the soak runs against. `payer` funds simple and
+/// inline transfers, `msig` is a threshold-2 account whose transfers need
+/// both `authority_key` and `msig_key`, and `sink` carries the token
+/// contract so transfers into it dispatch a second wasm invocation.
+struct SoakAccounts {
+    token: Name,
+    payer: Name,
+    receiver: Name,
+    sink: Name,
+    msig: Name,
+    msig_key: PrivateKey,
+}
+
+impl SoakAccounts {
+    fn new() -> Self {
+        SoakAccounts {
+            token: Name::new(name!("soak.token")),
+            payer: Name::new(name!("soakpayer")),
+            receiver: Name::new(name!("soakrecv")),
+            sink: Name::new(name!("soaksink")),
+            msig: Name::new(name!("soakmsig")),
+            msig_key: PrivateKey::random(),
+        }
+    }
+}
+
+async fn setup(
+    client: &PulseVmClient,
+    config: &Config,
+    accounts: &SoakAccounts,
+) -> Result<(), String> {
+    let key = &config.key;
+    let chain_id = &config.chain_id;
+    let single = Authority::new(
+        1,
+        vec![KeyWeight::new(key.get_public_key().inner().clone(), 1)],
+        vec![],
+        vec![],
+    );
+    // Both keys must sign every transfer from the multisig account; the
+    // authority requires its keys strictly ascending.
+    let mut msig_keys = vec![
+        KeyWeight::new(key.get_public_key().inner().clone(), 1),
+        KeyWeight::new(accounts.msig_key.get_public_key().inner().clone(), 1),
+    ];
+    msig_keys.sort_by(|a, b| a.key.cmp(&b.key).cmp(&0));
+    let dual = Authority::new(2, msig_keys, vec![], vec![]);
+
+    println!("creating soak accounts...");
+    for (name, authority) in [
+        (accounts.token, &single),
+        (accounts.payer, &single),
+        (accounts.receiver, &single),
+        (accounts.sink, &single),
+        (accounts.msig, &dual),
+    ] {
+        let trx = sign_one(
+            key,
+            chain_id,
+            Action::new(
+                PULSE_NAME,
+                Name::new(name!("newaccount")),
+                NewAccount {
+                    creator: PULSE_NAME,
+                    name,
+                    owner: authority.clone(),
+                    active: authority.clone(),
+                }
+                .pack()
+                .unwrap(),
+                vec![PermissionLevel::new(
+                    PULSE_NAME.as_u64(),
+                    ACTIVE_NAME.as_u64(),
+                )],
+            ),
+        )?;
+        client
+            .issue_tx(&trx)
+            .await
+            .map_err(|e| format!("newaccount {}: {}", name, e))?;
+    }
+
+    println!("deploying pulse_token to {} and {}...", accounts.token, accounts.sink);
+    let root = std::path::Path::new(env!("CARGO_MANIFEST_DIR"))
+        .parent()
+        .unwrap()
+        .parent()
+        .unwrap();
+    let wasm = std::fs::read(root.join("reference_contracts/pulse_token.wasm"))
+        .map_err(|e| format!("reading pulse_token.wasm: {}", e))?;
+    let abi_json = std::fs::read(root.join("reference_contracts/pulse_token.abi"))
+        .map_err(|e| format!("reading pulse_token.abi: {}", e))?;
+    let abi: AbiDefinition =
+        serde_json::from_slice(&abi_json).map_err(|e| format!("parsing abi: {}", e))?;
+    let abi_bytes = abi.pack().unwrap();
+    for contract in [accounts.token, accounts.sink] {
+        let auth = vec![PermissionLevel::new(contract.as_u64(), ACTIVE_NAME.as_u64())];
+        let trx = sign_one(
+            key,
+            chain_id,
+            Action::new(
+                PULSE_NAME,
+                Name::new(name!("setcode")),
+                SetCode {
+                    account: contract,
+                    vm_type: 0,
+                    vm_version: 0,
+                    code: Arc::new(wasm.clone().into()),
+                }
+                .pack()
+                .unwrap(),
+                auth.clone(),
+            ),
+        )?;
+        client
+            .issue_tx(&trx)
+            .await
+            .map_err(|e| format!("setcode {}: {}", contract, e))?;
+        let trx = sign_one(
+            key,
+            chain_id,
+            Action::new(
+                PULSE_NAME,
+                Name::new(name!("setabi")),
+                SetAbi {
+                    account: contract,
+                    abi: Arc::new(abi_bytes.clone().into()),
+                }
+                .pack()
+                .unwrap(),
+                auth,
+            ),
+        )?;
+        client
+            .issue_tx(&trx)
+            .await
+            .map_err(|e| format!("setabi {}: {}", contract, e))?;
+    }
+
+    println!("creating and distributing SOAK supply...");
+    let symbol = Symbol::from_str("4,SOAK").unwrap();
+    let token_auth = vec![PermissionLevel::new(
+        accounts.token.as_u64(),
+        ACTIVE_NAME.as_u64(),
+    )];
+    let trx = sign_one(
+        key,
+        chain_id,
+        Action::new(
+            accounts.token,
+            Name::new(name!("create")),
+            Create {
+                issuer: accounts.token,
+                max_supply: Asset::new(1_000_000_000_0000, symbol),
+            }
+            .pack()
+            .unwrap(),
+            token_auth.clone(),
+        ),
+    )?;
+    client
+        .issue_tx(&trx)
+        .await
+        .map_err(|e| format!("create SOAK: {}", e))?;
+    let trx = sign_one(
+        key,
+        chain_id,
+        Action::new(
+            accounts.token,
+            Name::new(name!("issue")),
+            Issue {
+                to: accounts.token,
+                quantity: Asset::new(1_000_000_000_0000, symbol),
+                memo: "soak supply".to_string(),
+            }
+            .pack()
+            .unwrap(),
+            token_auth.clone(),
+        ),
+    )?;
+    client
+        .issue_tx(&trx)
+        .await
+        .map_err(|e| format!("issue SOAK: {}", e))?;
+    for funded in [accounts.payer, accounts.msig] {
+        let trx = sign_one(
+            key,
+            chain_id,
+            Action::new(
+                accounts.token,
+                Name::new(name!("transfer")),
+                Transfer {
+                    from: accounts.token,
+                    to: funded,
+                    quantity: Asset::new(100_000_000_0000, symbol),
+                    memo: "soak funding".to_string(),
+                }
+                .pack()
+                .unwrap(),
+                token_auth.clone(),
+            ),
+        )?;
+        client
+            .issue_tx(&trx)
+            .await
+            .map_err(|e| format!("funding {}: {}", funded, e))?;
+    }
+    Ok(())
+}
+
+async fn run_load(
+    client: Arc<PulseVmClient>,
+    config: &Config,
+    accounts: Arc<SoakAccounts>,
+) -> Vec<(Phase, PhaseStats)> {
+    let stats: Arc<Vec<Mutex<PhaseStats>>> = Arc::new(vec![
+        Mutex::new(PhaseStats::default()),
+        Mutex::new(PhaseStats::default()),
+        Mutex::new(PhaseStats::default()),
+    ]);
+    let seq = Arc::new(AtomicU64::new(0));
+    // A bounded queue of (phase) send tokens; when the node cannot keep up
+    // the queue fills and the scheduler counts shed load instead of letting
+    // latency measurements degrade into queueing time.
+    let (tx, rx) = mpsc::channel::<Phase>(config.workers * 2);
+    let rx = Arc::new(tokio::sync::Mutex::new(rx));
+
+    let mut workers = Vec::new();
+    for _ in 0..config.workers {
+        let client = client.clone();
+        let config = config.clone();
+        let accounts = accounts.clone();
+        let stats = stats.clone();
+        let seq = seq.clone();
+        let rx = rx.clone();
+        workers.push(tokio::spawn(async move {
+            loop {
+                let phase = {
+                    let mut rx = rx.lock().await;
+                    match rx.recv().await {
+                        Some(phase) => phase,
+                        None => break,
+                    }
+                };
+                let n = seq.fetch_add(1, Ordering::Relaxed);
+                let class = pick_class(&config, n);
+                let trx = match build_soak_tx(&config, &accounts, class, n) {
+                    Ok(trx) => trx,
+                    Err(e) => {
+                        eprintln!("failed to build {} tx: {}", class.label(), e);
+                        continue;
+                    }
+                };
+                let start = Instant::now();
+                let result = client.issue_tx(&trx).await;
+                let elapsed = start.elapsed();
+                let mut slot = stats[phase as usize].lock().unwrap();
+                slot.first_send.get_or_insert(start);
+                slot.last_send = Some(start + elapsed);
+                match result {
+                    Ok(_) => {
+                        slot.ok += 1;
+                        slot.latencies_us.push(elapsed.as_micros() as u64);
+                    }
+                    Err(e) => {
+                        if slot.errors == 0 {
+                            eprintln!("first {} error: {}", class.label(), e);
+                        }
+                        slot.errors += 1;
+                    }
+                }
+            }
+        }));
+    }
+
+    // Scheduler: dispense tokens as the integral of the phase rate curve.
+    let total = config.warmup + config.ramp + config.sustain;
+    let started = Instant::now();
+    let mut budget = 0.0f64;
+    let mut ticker = tokio::time::interval(TICK);
+    loop {
+        ticker.tick().await;
+        let elapsed = started.elapsed();
+        if elapsed >= total {
+            break;
+        }
+        let (phase, rate) = phase_rate(config, elapsed);
+        budget += rate * TICK.as_secs_f64();
+        while budget >= 1.0 {
+            budget -= 1.0;
+            if tx.try_send(phase).is_err() {
+                stats[phase as usize].lock().unwrap().shed += 1;
+            }
+        }
+    }
+    drop(tx);
+    for worker in workers {
+        let _ = worker.await;
+    }
+
+    let mut collected = Vec::new();
+    for (i, phase) in [Phase::Warmup, Phase::Ramp, Phase::Sustain].into_iter().enumerate() {
+        let slot = std::mem::take(&mut *stats[i].lock().unwrap());
+        collected.push((phase, slot));
+    }
+    collected
+}
+
+fn phase_rate(config: &Config, elapsed: Duration) -> (Phase, f64) {
+    let warmup_rate = (config.tps * WARMUP_FRACTION).max(1.0);
+    if elapsed < config.warmup {
+        return (Phase::Warmup, warmup_rate);
+    }
+    let into_ramp = elapsed - config.warmup;
+    if into_ramp < config.ramp {
+        let progress = into_ramp.as_secs_f64() / config.ramp.as_secs_f64();
+        return (
+            Phase::Ramp,
+            warmup_rate + (config.tps - warmup_rate) * progress,
+        );
+    }
+    (Phase::Sustain, config.tps)
+}
+
+fn pick_class(config: &Config, n: u64) -> TxClass {
+    // Deterministic low-discrepancy walk over 0..100 instead of an RNG; the
+    // realized mix matches the requested one to within one transaction per
+    // hundred.
+    let slot = (n * 61) % 100;
+    if slot < config.mix_transfer {
+        TxClass::Transfer
+    } else if slot < config.mix_inline {
+        TxClass::Inline
+    } else {
+        TxClass::Multisig
+    }
+}
+
+fn build_soak_tx(
+    config: &Config,
+    accounts: &SoakAccounts,
+    class: TxClass,
+    seq: u64,
+) -> Result<PackedTransaction, ChainError> {
+    let symbol = Symbol::from_str("4,SOAK").unwrap();
+    let (from, to) = match class {
+        TxClass::Transfer => (accounts.payer, accounts.receiver),
+        TxClass::Inline => (accounts.payer, accounts.sink),
+        TxClass::Multisig => (accounts.msig, accounts.receiver),
+    };
+    let action = Action::new(
+        accounts.token,
+        Name::new(name!("transfer")),
+        Transfer {
+            from,
+            to,
+            quantity: Asset::new(1, symbol),
+            // The sequence uniquifies the transaction id; everything else in
+            // the header is identical across the run.
+            memo: format!("soak {}", seq),
+        }
+        .pack()
+        .unwrap(),
+        vec![PermissionLevel::new(from.as_u64(), ACTIVE_NAME.as_u64())],
+    );
+    let now = SystemTime::now()
+        .duration_since(UNIX_EPOCH)
+        .unwrap()
+        .as_secs() as u32;
+    let trx = Transaction::new(
+        TransactionHeader::new(
+            TimePointSec::new(now + 300),
+            0,
+            0,
+            0u32.into(),
+            0,
+            0u32.into(),
+        ),
+        vec![],
+        vec![action],
+    );
+    let signed = trx.sign(&config.key, &config.chain_id)?;
+    let signed = match class {
+        TxClass::Multisig => signed.sign(&accounts.msig_key, &config.chain_id)?,
+        _ => signed,
+    };
+    PackedTransaction::from_signed_transaction(signed)
+}
+
+fn sign_one(
+    key: &PrivateKey,
+    chain_id: &Id,
+    action: Action,
+) -> Result<PackedTransaction, String> {
+    let now = SystemTime::now()
+        .duration_since(UNIX_EPOCH)
+        .unwrap()
+        .as_secs() as u32;
+    let trx = Transaction::new(
+        TransactionHeader::new(
+            TimePointSec::new(now + 300),
+            0,
+            0,
+            0u32.into(),
+            0,
+            0u32.into(),
+        ),
+        vec![],
+        vec![action],
+    );
+    let signed = trx
+        .sign(key, chain_id)
+        .map_err(|e| format!("signing: {}", e))?;
+    PackedTransaction::from_signed_transaction(signed).map_err(|e| format!("packing: {}", e))
+}
+
+fn percentile(sorted_us: &[u64], q: f64) -> u64 {
+    if sorted_us.is_empty() {
+        return 0;
+    }
+    let idx = ((sorted_us.len() - 1) as f64 * q).round() as usize;
+    sorted_us[idx]
+}
+
+fn print_report(config: &Config, report: &[(Phase, PhaseStats)]) {
+    println!();
+    println!(
+        "soak report — target {} TPS, mix transfer:{} inline:{} multisig:{}",
+        config.tps,
+        config.mix_transfer,
+        config.mix_inline - config.mix_transfer,
+        100 - config.mix_inline,
+    );
+    for (phase, stats) in report {
+        let mut sorted = stats.latencies_us.clone();
+        sorted.sort_unstable();
+        let wall = match (stats.first_send, stats.last_send) {
+            (Some(first), Some(last)) => (last - first).as_secs_f64(),
+            _ => 0.0,
+        };
+        let tps = if wall > 0.0 { stats.ok as f64 / wall } else { 0.0 };
+        println!(
+            "  {:>7?}: {:>7} ok {:>5} err {:>5} shed | {:>8.1} TPS | p50 {:>7} us  p99 {:>7} us  p999 {:>7} us  max {:>7} us",
+            phase,
+            stats.ok,
+            stats.errors,
+            stats.shed,
+            tps,
+            percentile(&sorted, 0.50),
+            percentile(&sorted, 0.99),
+            percentile(&sorted, 0.999),
+            sorted.last().copied().unwrap_or(0),
+        );
+    }
+    if let Some((_, sustain)) = report.iter().find(|(p, _)| *p == Phase::Sustain) {
+        if sustain.shed > 0 || sustain.errors > 0 {
+            println!(
+                "  NOTE: sustain shed {} and failed {} submissions — the node did not hold the target rate",
+                sustain.shed, sustain.errors
+            );
+        }
+    }
+}
+
+async fn print_node_counters(client: &PulseVmClient, head_before: u32) {
+    println!();
+    println!("node-side counters:");
+    match client.get_info().await {
+        Ok(info) => println!(
+            "  blocks produced during run: {} (head {} -> {})",
+            info.head_block_num.saturating_sub(head_before),
+            head_before,
+            info.head_block_num
+        ),
+        Err(e) => println!("  getInfo failed: {}", e),
+    }
+    match client
+        .rpc_value("pulsevm.getExecutionProfile", Some(json!({"reset": false})))
+        .await
+    {
+        Ok(profile) => println!(
+            "  execution profile: {}",
+            serde_json::to_string_pretty(&profile).unwrap_or_default()
+        ),
+        Err(e) => println!("  getExecutionProfile failed: {}", e),
+    }
+    match client
+        .rpc_value(
+            "pulsevm.getExecutionAccounting",
+            Some(json!({"last_blocks": 120})),
+        )
+        .await
+    {
+        Ok(accounting) => println!(
+            "  execution accounting (last 120 blocks): {}",
+            serde_json::to_string_pretty(&accounting).unwrap_or_default()
+        ),
+        Err(e) => println!("  getExecutionAccounting failed: {}", e),
+    }
+}
+
+#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
+struct Issue {
+    to: Name,
+    quantity: Asset,
+    memo: String,
+}
+
+#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
+struct Transfer {
+    from: Name,
+    to: Name,
+    quantity: Asset,
+    memo: String,
+}
+
+#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
+struct Create {
+    issuer: Name,
+    max_supply: Asset,
+}
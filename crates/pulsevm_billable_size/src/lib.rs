@@ -3,8 +3,14 @@ pub const BILLABLE_ALIGNMENT: u64 = 16;
 pub trait BillableSize {
     const OVERHEAD: u64;
     const VALUE: u64;
+
+    /// `VALUE` rounded up to `BILLABLE_ALIGNMENT`, evaluated at compile time.
+    /// This is the fixed per-row charge; callers only add the dynamic payload
+    /// length on top.
+    const BILLABLE_SIZE: u64 =
+        ((Self::VALUE + BILLABLE_ALIGNMENT - 1) / BILLABLE_ALIGNMENT) * BILLABLE_ALIGNMENT;
 }
 
 pub const fn billable_size_v<T: BillableSize>() -> u64 {
-    return ((T::VALUE + BILLABLE_ALIGNMENT - 1) / BILLABLE_ALIGNMENT) * BILLABLE_ALIGNMENT;
+    T::BILLABLE_SIZE
 }
@@ -0,0 +1,324 @@
+// Regression suite over the full action path: `Controller::execute_transaction`
+// end to end (which drives `ApplyContext::exec` underneath), the db intrinsic
+// families through minimal wasm contracts, authorization checking, and
+// serialization round-trips. Criterion writes its JSON estimates under
+// target/criterion; the bench workflow saves them as baselines so runs can be
+// compared across commits.
+mod common;
+
+use common::{
+    Transfer, call_contract_raw, create_account, multi_action_transaction, set_code,
+    setup_token_chain,
+};
+use criterion::{BatchSize, BenchmarkId, Criterion, Throughput, criterion_group, criterion_main};
+use pulsevm_core::{
+    ACTIVE_NAME,
+    asset::{Asset, Symbol},
+    authorization_manager::AuthorizationManager,
+    crypto::PublicKey,
+    time::microseconds,
+    transaction::{Action, PackedTransaction},
+    wat2wasm,
+};
+use pulsevm_ffi::PermissionLevel;
+use pulsevm_name::Name;
+use pulsevm_name_macro::name;
+use pulsevm_serialization::{Read, Write};
+use std::{cell::Cell, collections::BTreeSet, hint::black_box, str::FromStr};
+
+// Rows touched per action by the db contracts below; every family performs
+// store, lookup, update and remove over this many rows, so one action is
+// 4 * DB_ROWS intrinsic calls.
+const DB_ROWS: u64 = 64;
+
+static DB_PRIMARY_WAST: &str = r#"(module
+ (import "env" "db_store_i64" (func $db_store_i64 (param i64 i64 i64 i64 i32 i32) (result i32)))
+ (import "env" "db_find_i64" (func $db_find_i64 (param i64 i64 i64 i64) (result i32)))
+ (import "env" "db_update_i64" (func $db_update_i64 (param i32 i64 i32 i32)))
+ (import "env" "db_remove_i64" (func $db_remove_i64 (param i32)))
+ (table 0 funcref)
+ (memory $0 1)
+ (export "memory" (memory $0))
+ (export "apply" (func $apply))
+ (func $apply (param $receiver i64) (param $code i64) (param $action i64)
+  (local $i i64)
+  (local $itr i32)
+  (local.set $i (i64.const 0))
+  (block $stored
+   (loop $store
+    (br_if $stored (i64.ge_u (local.get $i) (i64.const 64)))
+    (drop
+     (call $db_store_i64
+      (local.get $receiver)
+      (i64.const 0)
+      (local.get $receiver)
+      (local.get $i)
+      (i32.const 0)
+      (i32.const 8)
+     )
+    )
+    (local.set $i (i64.add (local.get $i) (i64.const 1)))
+    (br $store)
+   )
+  )
+  (local.set $i (i64.const 0))
+  (block $walked
+   (loop $walk
+    (br_if $walked (i64.ge_u (local.get $i) (i64.const 64)))
+    (local.set $itr
+     (call $db_find_i64
+      (local.get $code)
+      (local.get $receiver)
+      (i64.const 0)
+      (local.get $i)
+     )
+    )
+    (call $db_update_i64
+     (local.get $itr)
+     (local.get $receiver)
+     (i32.const 0)
+     (i32.const 8)
+    )
+    (call $db_remove_i64 (local.get $itr))
+    (local.set $i (i64.add (local.get $i) (i64.const 1)))
+    (br $walk)
+   )
+  )
+ )
+)"#;
+
+static DB_IDX64_WAST: &str = r#"(module
+ (import "env" "db_idx64_store" (func $db_idx64_store (param i64 i64 i64 i64 i32) (result i32)))
+ (import "env" "db_idx64_find_primary" (func $db_idx64_find_primary (param i64 i64 i64 i32 i64) (result i32)))
+ (import "env" "db_idx64_update" (func $db_idx64_update (param i32 i64 i32)))
+ (import "env" "db_idx64_remove" (func $db_idx64_remove (param i32)))
+ (table 0 funcref)
+ (memory $0 1)
+ (export "memory" (memory $0))
+ (export "apply" (func $apply))
+ (func $apply (param $receiver i64) (param $code i64) (param $action i64)
+  (local $i i64)
+  (local $itr i32)
+  (local.set $i (i64.const 0))
+  (block $stored
+   (loop $store
+    (br_if $stored (i64.ge_u (local.get $i) (i64.const 64)))
+    (i64.store (i32.const 0) (local.get $i))
+    (drop
+     (call $db_idx64_store
+      (local.get $receiver)
+      (i64.const 0)
+      (local.get $receiver)
+      (local.get $i)
+      (i32.const 0)
+     )
+    )
+    (local.set $i (i64.add (local.get $i) (i64.const 1)))
+    (br $store)
+   )
+  )
+  (local.set $i (i64.const 0))
+  (block $walked
+   (loop $walk
+    (br_if $walked (i64.ge_u (local.get $i) (i64.const 64)))
+    (local.set $itr
+     (call $db_idx64_find_primary
+      (local.get $code)
+      (local.get $receiver)
+      (i64.const 0)
+      (i32.const 8)
+      (local.get $i)
+     )
+    )
+    (call $db_idx64_update
+     (local.get $itr)
+     (local.get $receiver)
+     (i32.const 0)
+    )
+    (call $db_idx64_remove (local.get $itr))
+    (local.set $i (i64.add (local.get $i) (i64.const 1)))
+    (br $walk)
+   )
+  )
+ )
+)"#;
+
+fn transfer_action(memo: String) -> Action {
+    Action::new(
+        Name::new(name!("pulse.token")),
+        Name::new(name!("transfer")),
+        Transfer {
+            from: Name::new(name!("alice")),
+            to: Name::new(name!("bob")),
+            quantity: Asset {
+                amount: 1,
+                symbol: Symbol::from_str("4,EOS").unwrap(),
+            },
+            memo,
+        }
+        .pack()
+        .unwrap(),
+        vec![PermissionLevel::new(
+            Name::new(name!("alice")).as_u64(),
+            ACTIVE_NAME.as_u64(),
+        )],
+    )
+}
+
+// Transaction ids are recorded in the dedup table on execution, so every
+// iteration builds a fresh transaction (unique memo / action data) in the
+// untimed setup closure and only the execution itself is measured.
+fn bench_execute_transaction(c: &mut Criterion) {
+    let (mut controller, private_key, pending_block_timestamp, block_status) = setup_token_chain();
+    let chain_id = controller.chain_id().clone();
+
+    let mut group = c.benchmark_group("execute_transaction");
+    for &num_actions in &[1usize, 4, 16] {
+        group.throughput(Throughput::Elements(num_actions as u64));
+        let counter = Cell::new(0u64);
+        group.bench_with_input(
+            BenchmarkId::new("transfer_actions", num_actions),
+            &num_actions,
+            |b, &num_actions| {
+                b.iter_batched(
+                    || {
+                        let n = counter.get();
+                        counter.set(n + 1);
+                        let actions = (0..num_actions)
+                            .map(|i| transfer_action(format!("{}-{}", n, i)))
+                            .collect();
+                        multi_action_transaction(&private_key, actions, chain_id.clone()).unwrap()
+                    },
+                    |trx| {
+                        controller
+                            .execute_transaction(&trx, &pending_block_timestamp, &block_status)
+                            .unwrap();
+                    },
+                    BatchSize::SmallInput,
+                )
+            },
+        );
+    }
+    group.finish();
+}
+
+fn bench_db_intrinsics(c: &mut Criterion) {
+    let (mut controller, private_key, pending_block_timestamp, block_status) = setup_token_chain();
+    let chain_id = controller.chain_id().clone();
+
+    let mut group = c.benchmark_group("db_intrinsics");
+    for (account, wast) in [("dbprimary", DB_PRIMARY_WAST), ("dbsecondary", DB_IDX64_WAST)] {
+        let contract = Name::from_str(account).unwrap();
+        controller
+            .execute_transaction(
+                &create_account(&private_key, contract, chain_id.clone()).unwrap(),
+                &pending_block_timestamp,
+                &block_status,
+            )
+            .unwrap();
+        controller
+            .execute_transaction(
+                &set_code(
+                    &private_key,
+                    contract,
+                    wat2wasm(wast).unwrap(),
+                    chain_id.clone(),
+                )
+                .unwrap(),
+                &pending_block_timestamp,
+                &block_status,
+            )
+            .unwrap();
+
+        // Each action performs store/find/update/remove over DB_ROWS rows and
+        // leaves the table empty, so iterations are independent.
+        group.throughput(Throughput::Elements(4 * DB_ROWS));
+        let counter = Cell::new(0u64);
+        group.bench_function(BenchmarkId::new("round_trip", account), |b| {
+            b.iter_batched(
+                || {
+                    let n = counter.get();
+                    counter.set(n + 1);
+                    call_contract_raw(
+                        &private_key,
+                        contract,
+                        Name::new(name!("run")),
+                        n.to_le_bytes().to_vec(),
+                        chain_id.clone(),
+                        vec![PermissionLevel::new(contract.as_u64(), ACTIVE_NAME.as_u64())],
+                    )
+                    .unwrap()
+                },
+                |trx| {
+                    controller
+                        .execute_transaction(&trx, &pending_block_timestamp, &block_status)
+                        .unwrap();
+                },
+                BatchSize::SmallInput,
+            )
+        });
+    }
+    group.finish();
+}
+
+fn bench_check_authorization(c: &mut Criterion) {
+    let (controller, private_key, _pending_block_timestamp, _block_status) = setup_token_chain();
+    let db = controller.database();
+    let actions = vec![transfer_action("auth bench".to_string())];
+    let provided_keys: BTreeSet<PublicKey> = BTreeSet::from([private_key.get_public_key()]);
+
+    c.bench_function("check_authorization/transfer", |b| {
+        b.iter(|| {
+            AuthorizationManager::check_authorization(
+                &db,
+                black_box(&actions),
+                &provided_keys,
+                &BTreeSet::new(),
+                microseconds(0),
+                &BTreeSet::new(),
+            )
+            .unwrap()
+        })
+    });
+}
+
+fn bench_serialization(c: &mut Criterion) {
+    let (controller, private_key, _pending_block_timestamp, _block_status) = setup_token_chain();
+    let chain_id = controller.chain_id().clone();
+
+    let mut group = c.benchmark_group("serialization");
+    for &size in &[64usize, 1024, 8192] {
+        let packed = call_contract_raw(
+            &private_key,
+            Name::new(name!("pulse.token")),
+            Name::new(name!("transfer")),
+            vec![7u8; size],
+            chain_id.clone(),
+            vec![PermissionLevel::new(
+                Name::new(name!("alice")).as_u64(),
+                ACTIVE_NAME.as_u64(),
+            )],
+        )
+        .unwrap();
+        let bytes = packed.pack().unwrap();
+        group.throughput(Throughput::Bytes(bytes.len() as u64));
+
+        group.bench_function(BenchmarkId::new("pack", size), |b| {
+            b.iter(|| black_box(&packed).pack().unwrap())
+        });
+        group.bench_function(BenchmarkId::new("unpack", size), |b| {
+            b.iter(|| {
+                let mut pos = 0;
+                PackedTransaction::read(black_box(&bytes), &mut pos).unwrap()
+            })
+        });
+    }
+    group.finish();
+}
+
+criterion_group! {
+    name = benches;
+    config = Criterion::default().significance_level(0.1);
+    targets = bench_execute_transaction, bench_db_intrinsics, bench_check_authorization, bench_serialization
+}
+criterion_main!(benches);
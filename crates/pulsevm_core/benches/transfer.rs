@@ -1,49 +1,18 @@
-use chrono::Utc;
+mod common;
+
+use common::{Transfer, call_contract, setup_token_chain};
 use criterion::{Criterion, criterion_group, criterion_main};
 use pulsevm_core::{
-    ACTIVE_NAME, ChainError, PULSE_NAME,
-    abi::AbiDefinition,
+    ACTIVE_NAME,
     asset::{Asset, Symbol},
     block::{BlockStatus, BlockTimestamp},
     controller::Controller,
     crypto::PrivateKey,
-    id::Id,
-    pulse_contract::{NewAccount, SetCode},
-    transaction::{Action, PackedTransaction, Transaction, TransactionHeader},
 };
-use pulsevm_ffi::{Authority, KeyWeight, PermissionLevel, TimePointSec};
+use pulsevm_ffi::PermissionLevel;
 use pulsevm_name::Name;
-use pulsevm_proc_macros::{NumBytes, Read, Write};
-use pulsevm_serialization::Write;
-use serde_json::json;
-use std::{
-    fs,
-    path::{Path, PathBuf},
-    str::FromStr,
-    sync::Arc,
-};
-use tempfile::env::temp_dir;
-
-#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
-struct Issue {
-    to: Name,
-    quantity: Asset,
-    memo: String,
-}
-
-#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
-struct Transfer {
-    from: Name,
-    to: Name,
-    quantity: Asset,
-    memo: String,
-}
-
-#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
-struct Create {
-    issuer: Name,
-    max_supply: Asset,
-}
+use pulsevm_name_macro::name;
+use std::str::FromStr;
 
 fn bench(
     controller: &mut Controller,
@@ -55,11 +24,11 @@ fn bench(
         .execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                Name::from_str("transfer").unwrap(),
+                Name::new(name!("pulse.token")),
+                Name::new(name!("transfer")),
                 &Transfer {
-                    from: Name::from_str("alice").unwrap(),
-                    to: Name::from_str("bob").unwrap(),
+                    from: Name::new(name!("alice")),
+                    to: Name::new(name!("bob")),
                     quantity: Asset {
                         amount: 1,
                         symbol: Symbol::from_str("4,EOS").unwrap(),
@@ -68,7 +37,7 @@ fn bench(
                 },
                 controller.chain_id().clone(),
                 vec![PermissionLevel::new(
-                    Name::from_str("alice").unwrap().as_u64(),
+                    Name::new(name!("alice")).as_u64(),
                     ACTIVE_NAME.as_u64(),
                 )],
             )
@@ -80,171 +49,7 @@ fn bench(
 }
 
 fn criterion_benchmark(c: &mut Criterion) {
-    let chain_id =
-        Id::from_str("c8c4a47932fc0a938972f48f32489e7e91f024697e498ceb3d3c3afcf28f68b6").unwrap();
-    let private_key =
-        PrivateKey::from_str("PVT_K1_5G7JEG7CWZkGfnaQePCcJSNgocGFoeCxG1pU7r1B6rY2gueez").unwrap();
-    let mut controller = Controller::new();
-    let config_bytes = json!({
-        "producer_name": "pulse",
-        "producer_key": private_key.to_string(),
-    })
-    .to_string()
-    .into_bytes();
-    let genesis_bytes = generate_genesis(&private_key);
-    let temp_path = get_temp_dir().to_str().unwrap().to_string();
-    controller
-        .initialize(
-            &chain_id,
-            &config_bytes,
-            &genesis_bytes.to_vec(),
-            temp_path.as_str(),
-        )
-        .unwrap();
-    let pending_block_timestamp = controller.last_accepted_block().timestamp().clone();
-    let block_status = BlockStatus::Benchmarking;
-
-    // Create 'pulse.token' account
-    controller
-        .execute_transaction(
-            &create_account(
-                &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                controller.chain_id().clone(),
-            )
-            .unwrap(),
-            &pending_block_timestamp,
-            &block_status,
-        )
-        .unwrap();
-
-    // Create 'alice' account
-    controller
-        .execute_transaction(
-            &create_account(
-                &private_key,
-                Name::from_str("alice").unwrap(),
-                controller.chain_id().clone(),
-            )
-            .unwrap(),
-            &pending_block_timestamp,
-            &block_status,
-        )
-        .unwrap();
-
-    // Create 'bob' account
-    controller
-        .execute_transaction(
-            &create_account(
-                &private_key,
-                Name::from_str("bob").unwrap(),
-                controller.chain_id().clone(),
-            )
-            .unwrap(),
-            &pending_block_timestamp,
-            &block_status,
-        )
-        .unwrap();
-
-    let root = Path::new(env!("CARGO_MANIFEST_DIR"))
-        .parent()
-        .unwrap()
-        .parent()
-        .unwrap();
-    let pulse_token_contract =
-        fs::read(root.join(Path::new("reference_contracts/pulse_token.wasm"))).unwrap();
-    let pulse_token_abi =
-        fs::read(root.join(Path::new("reference_contracts/pulse_token.abi"))).unwrap();
-    let packed_abi: AbiDefinition = serde_json::from_slice(&pulse_token_abi).unwrap();
-    let packed_abi_bytes = packed_abi.pack().unwrap();
-    controller
-        .execute_transaction(
-            &set_code(
-                &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                pulse_token_contract,
-                controller.chain_id().clone(),
-            )
-            .unwrap(),
-            &pending_block_timestamp,
-            &block_status,
-        )
-        .unwrap();
-
-    controller
-        .execute_transaction(
-            &call_contract(
-                &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                Name::from_str("create").unwrap(),
-                &Create {
-                    issuer: Name::from_str("pulse.token").unwrap(),
-                    max_supply: Asset::new(1000000000, Symbol::from_str("4,EOS").unwrap()),
-                },
-                controller.chain_id().clone(),
-                vec![PermissionLevel::new(
-                    Name::from_str("pulse.token").unwrap().as_u64(),
-                    ACTIVE_NAME.as_u64(),
-                )],
-            )
-            .unwrap(),
-            &pending_block_timestamp,
-            &block_status,
-        )
-        .unwrap();
-
-    controller
-        .execute_transaction(
-            &call_contract(
-                &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                Name::from_str("issue").unwrap(),
-                &Issue {
-                    to: Name::from_str("pulse.token").unwrap(),
-                    quantity: Asset {
-                        amount: 100000000,
-                        symbol: Symbol::from_str("4,EOS").unwrap(),
-                    },
-                    memo: "Initial transfer".to_string(),
-                },
-                controller.chain_id().clone(),
-                vec![PermissionLevel::new(
-                    Name::from_str("pulse.token").unwrap().as_u64(),
-                    ACTIVE_NAME.as_u64(),
-                )],
-            )
-            .unwrap(),
-            &pending_block_timestamp,
-            &block_status,
-        )
-        .unwrap();
-
-    controller
-        .execute_transaction(
-            &call_contract(
-                &private_key,
-                Name::from_str("pulse.token").unwrap(),
-                Name::from_str("transfer").unwrap(),
-                &Transfer {
-                    from: Name::from_str("pulse.token").unwrap(),
-                    to: Name::from_str("alice").unwrap(),
-                    quantity: Asset {
-                        amount: 100000000,
-                        symbol: Symbol::from_str("4,EOS").unwrap(),
-                    },
-                    memo: "Initial transfer".to_string(),
-                },
-                controller.chain_id().clone(),
-                vec![PermissionLevel::new(
-                    Name::from_str("pulse.token").unwrap().as_u64(),
-                    ACTIVE_NAME.as_u64(),
-                )],
-            )
-            .unwrap(),
-            &pending_block_timestamp,
-            &block_status,
-        )
-        .unwrap();
+    let (mut controller, private_key, pending_block_timestamp, block_status) = setup_token_chain();
 
     c.bench_function("transfer", |b| {
         b.iter(|| {
@@ -258,150 +63,6 @@ fn criterion_benchmark(c: &mut Criterion) {
     });
 }
 
-fn call_contract<T: Write>(
-    private_key: &PrivateKey,
-    account: Name,
-    action: Name,
-    action_data: &T,
-    chain_id: Id,
-    permissions: Vec<PermissionLevel>,
-) -> Result<PackedTransaction, ChainError> {
-    let trx = Transaction::new(
-        TransactionHeader::new(
-            TimePointSec::new(u32::MAX),
-            0,
-            0,
-            0u32.into(),
-            0,
-            0u32.into(),
-        ),
-        vec![],
-        vec![Action::new(
-            account,
-            action,
-            action_data.pack().unwrap(),
-            permissions,
-        )],
-    )
-    .sign(&private_key, &chain_id)?;
-    let packed_trx = PackedTransaction::from_signed_transaction(trx)?;
-    Ok(packed_trx)
-}
-
-fn create_account(
-    private_key: &PrivateKey,
-    account: Name,
-    chain_id: Id,
-) -> Result<PackedTransaction, ChainError> {
-    let authority = Authority::new(
-        1,
-        vec![KeyWeight::new(
-            private_key.get_public_key().inner().clone(),
-            1,
-        )],
-        vec![],
-        vec![],
-    );
-    let trx = Transaction::new(
-        TransactionHeader::new(
-            TimePointSec::new(u32::MAX),
-            0,
-            0,
-            0u32.into(),
-            0,
-            0u32.into(),
-        ),
-        vec![],
-        vec![Action::new(
-            Name::from_str("pulse")?,
-            Name::from_str("newaccount")?,
-            NewAccount {
-                creator: Name::from_str("pulse")?,
-                name: account,
-                owner: authority.clone(),
-                active: authority.clone(),
-            }
-            .pack()
-            .unwrap(),
-            vec![PermissionLevel::new(
-                PULSE_NAME.as_u64(),
-                ACTIVE_NAME.as_u64(),
-            )],
-        )],
-    );
-    let trx = trx.sign(&private_key, &chain_id)?;
-    let packed_trx = PackedTransaction::from_signed_transaction(trx)?;
-    Ok(packed_trx)
-}
-
-fn set_code(
-    private_key: &PrivateKey,
-    account: Name,
-    wasm_bytes: Vec<u8>,
-    chain_id: Id,
-) -> Result<PackedTransaction, ChainError> {
-    let trx = Transaction::new(
-        TransactionHeader::new(
-            TimePointSec::new(u32::MAX),
-            0,
-            0,
-            0u32.into(),
-            0,
-            0u32.into(),
-        ),
-        vec![],
-        vec![Action::new(
-            Name::from_str("pulse").unwrap(),
-            Name::from_str("setcode").unwrap(),
-            SetCode {
-                account,
-                vm_type: 0,
-                vm_version: 0,
-                code: Arc::new(wasm_bytes.into()),
-            }
-            .pack()
-            .unwrap(),
-            vec![PermissionLevel::new(account.as_u64(), ACTIVE_NAME.as_u64())],
-        )],
-    )
-    .sign(&private_key, &chain_id)?;
-    let packed_trx = PackedTransaction::from_signed_transaction(trx)?;
-    Ok(packed_trx)
-}
-
-fn get_temp_dir() -> PathBuf {
-    let temp_dir_name = format!("db_{}.pulsevm", Utc::now().format("%Y%m%d%H%M%S"));
-    let res = temp_dir().join(Path::new(&temp_dir_name));
-    res
-}
-
-fn generate_genesis(private_key: &PrivateKey) -> Vec<u8> {
-    let genesis = json!(
-    {
-        "initial_timestamp": "2023-01-01T00:00:00",
-        "initial_key": "PUB_K1_8XeW7H2JhKFP8Wjw31cv4j4Bpw4in8MVMrtmfUunJV4gSVBzqZ",
-        "initial_configuration": {
-            "max_block_net_usage": 1048576,
-            "target_block_net_usage_pct": 1000,
-            "max_transaction_net_usage": 524288,
-            "base_per_transaction_net_usage": 12,
-            "net_usage_leeway": 500,
-            "context_free_discount_net_usage_num": 20,
-            "context_free_discount_net_usage_den": 100,
-            "max_block_cpu_usage": 200000,
-            "target_block_cpu_usage_pct": 2500,
-            "max_transaction_cpu_usage": 150000,
-            "min_transaction_cpu_usage": 100,
-            "max_transaction_lifetime": 3600,
-            "max_inline_action_size": 4096,
-            "max_inline_action_depth": 6,
-            "max_authority_depth": 6,
-            "max_action_return_value_size": 256
-        }
-    });
-    genesis.to_string().into_bytes()
-}
-
 criterion_group! {
     name = benches;
     // This can be any expression that returns a `Criterion` object.
@@ -1,5 +1,100 @@
+use std::{env, fs, path::PathBuf, sync::Arc};
+
+use sha2::Digest;
+use wasmer::{
+    sys::CompilerConfig,
+    wasmparser::Operator,
+};
+use wasmer_compiler_llvm::{LLVM, LLVMOptLevel};
+use wasmer_middlewares::Metering;
+
+// The metering cost table the runtime compiles with; included straight from
+// the crate source so the embedded artifacts carry the exact same metering
+// instrumentation as a module compiled at runtime for the same code hash.
+#[allow(dead_code)]
+#[path = "src/chain/wasm_costs.rs"]
+mod wasm_costs;
+
+// System contracts every chain runs from genesis. Their wasm is in-repo and
+// known at build time, so paying an LLVM compile for them on first execution
+// is pure waste — precompile them here and embed the artifacts.
+const SYSTEM_CONTRACTS: &[(&str, &str)] = &[
+    ("pulse_bios", "../../reference_contracts/pulse_bios.wasm"),
+    ("pulse_system", "../../reference_contracts/pulse_system.wasm"),
+];
+
+// Mirrors `WasmRuntime::optimized_engine`: LLVM at aggressive optimization
+// with NaN canonicalization and the shared metering middleware. Tunables are
+// a runtime concern (they shape memories at instantiation) and are not part
+// of the serialized artifact.
+fn optimized_engine() -> wasmer::Engine {
+    let mut compiler = LLVM::default();
+    let metering = Arc::new(Metering::new(
+        1_000,
+        wasm_costs::operator_cost as fn(&Operator) -> u64,
+    ));
+    compiler.push_middleware(metering);
+    LLVM::canonicalize_nans(&mut compiler, true);
+    LLVM::opt_level(&mut compiler, LLVMOptLevel::Aggressive);
+    compiler.into()
+}
+
+fn precompile_system_contracts() {
+    let out_dir = PathBuf::from(env::var("OUT_DIR").unwrap());
+
+    println!("cargo:rerun-if-changed=src/chain/wasm_costs.rs");
+    for (_, wasm_path) in SYSTEM_CONTRACTS {
+        println!("cargo:rerun-if-changed={}", wasm_path);
+    }
+
+    // Artifacts are native code for the machine this build script runs on;
+    // under cross-compilation they could never deserialize at runtime, so
+    // ship an empty table and let those targets compile the system contracts
+    // at genesis like any other contract.
+    let mut entries = String::new();
+    if env::var("HOST") == env::var("TARGET") {
+        for (name, wasm_path) in SYSTEM_CONTRACTS {
+            let code = fs::read(wasm_path)
+                .unwrap_or_else(|e| panic!("failed to read {}: {}", wasm_path, e));
+            // Same keying as the runtime cache: sha256 of the on-chain wasm
+            // (what setcode stores as the code hash).
+            let code_hash: [u8; 32] = sha2::Sha256::digest(&code).into();
+
+            let engine = optimized_engine();
+            let module = wasmer::Module::new(&engine, code.as_slice())
+                .unwrap_or_else(|e| panic!("failed to compile {}: {}", wasm_path, e));
+            let artifact_path = out_dir.join(format!("{}.wasmu", name));
+            module
+                .serialize_to_file(&artifact_path)
+                .unwrap_or_else(|e| panic!("failed to serialize {}: {}", name, e));
+
+            entries.push_str(&format!(
+                "    EmbeddedArtifact {{\n        name: {:?},\n        code_hash: {:?},\n        artifact: include_bytes!({:?}),\n    }},\n",
+                name,
+                code_hash,
+                artifact_path.display().to_string(),
+            ));
+        }
+    }
+
+    let table = format!(
+        "// Generated by build.rs; see `WasmRuntime::seed_embedded_modules`.\n\
+         pub struct EmbeddedArtifact {{\n\
+         \x20   pub name: &'static str,\n\
+         \x20   pub code_hash: [u8; 32],\n\
+         \x20   pub artifact: &'static [u8],\n\
+         }}\n\
+         \n\
+         pub static EMBEDDED_SYSTEM_CONTRACTS: &[EmbeddedArtifact] = &[\n{}];\n",
+        entries
+    );
+    fs::write(out_dir.join("embedded_system_contracts.rs"), table).unwrap();
+}
+
 fn main() {
     // Apple Silicon Homebrew path; adjust if needed
     println!("cargo:rustc-link-search=native=/opt/homebrew/opt/libffi/lib");
     println!("cargo:rustc-link-lib=ffi");
+
+    precompile_system_contracts();
 }
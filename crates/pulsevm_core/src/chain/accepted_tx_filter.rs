@@ -0,0 +1,165 @@
+use std::sync::{Arc, Mutex};
+
+use crate::chain::{
+    id::Id,
+    time::{TimePoint, seconds},
+};
+
+// Bits per generation: 1 MiB each, 2 MiB for the pair. At four probes per id
+// that holds several hundred thousand unexpired ids below a one-percent false
+// positive rate, and a false positive only costs one database probe.
+const FILTER_BITS: usize = 1 << 23;
+const FILTER_WORDS: usize = FILTER_BITS / 64;
+
+// Probes per id. The id is already a sha256 digest of the signed content, so
+// the bit indices are read straight out of its bytes instead of re-hashing.
+const FILTER_PROBES: usize = 4;
+
+// How long a generation takes new inserts before it is demoted. Matches the
+// protocol's default max transaction lifetime (one hour); a chain configured
+// with a longer lifetime just ages ids out of the filter early, which is safe
+// (see the false-negative note below).
+const FILTER_WINDOW_SECONDS: i64 = 60 * 60;
+
+struct Inner {
+    current: Box<[u64]>,
+    previous: Box<[u64]>,
+    rotate_at: TimePoint,
+}
+
+/// Rolling two-generation Bloom filter over the transaction ids the
+/// controller has accepted into the chainbase dedup table.
+///
+/// Admission consults this before speculatively executing a gossiped
+/// transaction. A miss proves the id was not accepted by this process within
+/// the last window, so the common fresh-transaction case never probes the
+/// database; a hit falls through to the authoritative
+/// `is_known_unexpired_transaction` lookup, so a false positive costs one
+/// probe and never rejects a fresh transaction. False negatives (a restart
+/// empties the filter, or an id ages out before its configured expiration)
+/// only mean a duplicate reaches speculative execution and is caught there by
+/// `record_transaction`, exactly as every duplicate was before the filter.
+#[derive(Clone)]
+pub struct AcceptedTxFilter {
+    inner: Arc<Mutex<Inner>>,
+}
+
+impl AcceptedTxFilter {
+    pub fn new() -> Self {
+        Self {
+            inner: Arc::new(Mutex::new(Inner {
+                current: vec![0u64; FILTER_WORDS].into_boxed_slice(),
+                previous: vec![0u64; FILTER_WORDS].into_boxed_slice(),
+                rotate_at: TimePoint::now() + seconds(FILTER_WINDOW_SECONDS),
+            })),
+        }
+    }
+
+    pub fn insert(&self, id: &Id) {
+        self.insert_at(id, TimePoint::now());
+    }
+
+    pub fn insert_at(&self, id: &Id, now: TimePoint) {
+        let mut inner = self
+            .inner
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+
+        Self::rotate_if_due(&mut inner, now);
+        for position in Self::bit_positions(id) {
+            inner.current[position / 64] |= 1u64 << (position % 64);
+        }
+    }
+
+    pub fn maybe_contains(&self, id: &Id) -> bool {
+        self.maybe_contains_at(id, TimePoint::now())
+    }
+
+    pub fn maybe_contains_at(&self, id: &Id, now: TimePoint) -> bool {
+        let mut inner = self
+            .inner
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+
+        Self::rotate_if_due(&mut inner, now);
+        let positions = Self::bit_positions(id);
+        let hit = |bits: &[u64]| {
+            positions
+                .iter()
+                .all(|&p| bits[p / 64] & (1u64 << (p % 64)) != 0)
+        };
+        hit(&inner.current) || hit(&inner.previous)
+    }
+
+    // `current` takes new inserts and both generations are probed, so an id
+    // stays visible for at least one full window after insertion and at most
+    // two. Rotation is lazy: it happens on the next insert or probe after the
+    // deadline, and a gap longer than two windows clears both generations.
+    fn rotate_if_due(inner: &mut Inner, now: TimePoint) {
+        if now < inner.rotate_at {
+            return;
+        }
+        let both_stale = now >= inner.rotate_at + seconds(FILTER_WINDOW_SECONDS);
+        std::mem::swap(&mut inner.current, &mut inner.previous);
+        inner.current.fill(0);
+        if both_stale {
+            inner.previous.fill(0);
+        }
+        inner.rotate_at = now + seconds(FILTER_WINDOW_SECONDS);
+    }
+
+    fn bit_positions(id: &Id) -> [usize; FILTER_PROBES] {
+        let bytes = id.as_bytes();
+        let mut positions = [0usize; FILTER_PROBES];
+        for (i, position) in positions.iter_mut().enumerate() {
+            let chunk = u32::from_le_bytes(bytes[i * 4..i * 4 + 4].try_into().unwrap());
+            *position = chunk as usize & (FILTER_BITS - 1);
+        }
+        positions
+    }
+}
+
+impl Default for AcceptedTxFilter {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::str::FromStr;
+
+    fn make_id(fill: u8) -> Id {
+        Id::new([fill; 32])
+    }
+
+    #[test]
+    fn test_inserted_id_is_found() {
+        let filter = AcceptedTxFilter::new();
+        let id =
+            Id::from_str("e19b30bc0bfabfab01c9260469fab7529ae88987b2eb337dac5650305226b38e")
+                .unwrap();
+        assert!(!filter.maybe_contains(&id));
+        filter.insert(&id);
+        assert!(filter.maybe_contains(&id));
+        assert!(!filter.maybe_contains(&make_id(7)));
+    }
+
+    #[test]
+    fn test_id_survives_one_rotation_and_ages_out() {
+        let filter = AcceptedTxFilter::new();
+        let id = make_id(42);
+        let start = TimePoint::now();
+        filter.insert_at(&id, start);
+
+        // One window later the id has been demoted to the previous
+        // generation but is still visible.
+        let one_window = start + seconds(FILTER_WINDOW_SECONDS);
+        assert!(filter.maybe_contains_at(&id, one_window));
+
+        // Two more windows later both generations have turned over.
+        let three_windows = start + seconds(3 * FILTER_WINDOW_SECONDS);
+        assert!(!filter.maybe_contains_at(&id, three_windows));
+    }
+}
@@ -1,8 +1,9 @@
 use pulsevm_proc_macros::{NumBytes, Read, Write};
+use serde::Serialize;
 
 use crate::chain::Name;
 
-#[derive(Debug, Clone, PartialEq, Eq, Read, Write, NumBytes)]
+#[derive(Debug, Clone, PartialEq, Eq, Read, Write, NumBytes, Serialize)]
 pub struct AccountDelta {
     pub account: Name,
     pub delta: i64,
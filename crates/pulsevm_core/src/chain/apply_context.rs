@@ -1,6 +1,7 @@
 use std::{
     collections::{BTreeMap, BTreeSet, VecDeque},
-    sync::{Arc, RwLock},
+    sync::{Arc, LazyLock, Mutex, RwLock},
+    time::{Duration, Instant},
     u64,
 };
 
@@ -21,7 +22,13 @@ use crate::{
     chain::{
         authority::PermissionLevel,
         authorization_manager::AuthorizationManager,
+        block::BlockStatus,
+        block_profiler::BLOCK_PROFILER,
         controller::Controller,
+        exec_phases::{EXEC_PHASES, Phase},
+        execution_accounting::EXEC_ACCOUNTING,
+        native_token,
+        state_diff::{STATE_DIFF_HUB, StateDiffEvent, StateDiffOp},
         transaction::{Action, ActionReceipt, generate_action_digest},
         transaction_context::TransactionContext,
         utils::pulse_assert,
@@ -33,7 +40,7 @@ use crate::{
 
 struct ApplyContextInner {
     action: Action,                       // The action being applied
-    action_return_value: Option<Vec<u8>>, // Return value of the action
+    action_return_value: Option<Bytes>, // Return value of the action
     start: i64,                           // Start time in microseconds
     privileged: bool,
     account_ram_deltas: BTreeMap<Name, i64>, // RAM usage deltas for accounts
@@ -48,6 +55,89 @@ struct ApplyContextInner {
     index_double_cache: IndexDoubleIteratorCache, // Cache for index double iterators
     index_long_double_cache: IndexLongDoubleIteratorCache, // Cache for index long double iterators
     cpu_limit: i64,                          // CPU limit for the current action
+    next_prefetch: VecDeque<(i32, u64)>, // Prefetched db_next_i64 results (iterator, primary)
+    next_prefetch_from: i32,             // Iterator whose successor sits at the front of the buffer
+    host_calls: u64,                     // Stateful host calls issued so far, for accounting
+}
+
+// How many rows a single db_next_i64 bridge crossing prefetches. Tight
+// contract iteration loops pay the FFI cost once per batch instead of once
+// per row; anything unused is dropped when the walk ends or the table
+// changes shape.
+const DB_NEXT_PREFETCH: usize = 32;
+
+// Upper bound on rows walked by a single `db_prefetch_range` hint, so one
+// host call cannot touch an unbounded slice of a table.
+const DB_PREFETCH_RANGE_CAP: usize = 256;
+
+/// The capacity-bearing containers of an [`ApplyContextInner`], recycled
+/// across actions instead of reallocated. The six iterator caches in
+/// particular hold two hash maps and two vectors each, all of which a busy
+/// contract action regrows from empty; pooling keeps those allocations warm
+/// block to block. The scalar fields and the RAM-delta map are not pooled —
+/// they are cheap to build and a `BTreeMap` frees its nodes on clear anyway.
+#[derive(Default)]
+struct ApplyScratch {
+    notified: VecDeque<(Name, u32)>,
+    inline_actions: Vec<u32>,
+    context_free_inline_actions: Vec<u32>,
+    keyval_cache: KeyValueIteratorCache,
+    index64_cache: Index64IteratorCache,
+    index128_cache: Index128IteratorCache,
+    index256_cache: Index256IteratorCache,
+    index_double_cache: IndexDoubleIteratorCache,
+    index_long_double_cache: IndexLongDoubleIteratorCache,
+    next_prefetch: VecDeque<(i32, u64)>,
+}
+
+// Idle scratch sets kept for reuse; enough for a deep inline-action chain
+// without letting a pathological block pin memory indefinitely.
+const MAX_POOLED_SCRATCH: usize = 64;
+
+// Process-wide like the other pools; apply contexts are also built on the
+// read-only call path, which has no controller handle to own a pool.
+static APPLY_SCRATCH_POOL: LazyLock<Mutex<Vec<ApplyScratch>>> =
+    LazyLock::new(|| Mutex::new(Vec::new()));
+
+impl ApplyScratch {
+    fn acquire() -> Self {
+        APPLY_SCRATCH_POOL
+            .lock()
+            .ok()
+            .and_then(|mut pool| pool.pop())
+            .unwrap_or_default()
+    }
+
+    fn release(mut self) {
+        // Clearing is also a safety requirement: the iterator caches hold
+        // raw pointers that must not outlive the action that cached them.
+        self.notified.clear();
+        self.inline_actions.clear();
+        self.context_free_inline_actions.clear();
+        self.keyval_cache.clear();
+        self.index64_cache.clear();
+        self.index128_cache.clear();
+        self.index256_cache.clear();
+        self.index_double_cache.clear();
+        self.index_long_double_cache.clear();
+        self.next_prefetch.clear();
+        if let Ok(mut pool) = APPLY_SCRATCH_POOL.lock() {
+            if pool.len() < MAX_POOLED_SCRATCH {
+                pool.push(self);
+            }
+        }
+    }
+}
+
+impl ApplyContextInner {
+    // Drop prefetched db_next_i64 results. Called whenever rows are inserted
+    // or removed, since the buffered successors may no longer be accurate.
+    // Updates never move a row (the primary key is immutable), so they keep
+    // the buffer.
+    fn invalidate_next_prefetch(&mut self) {
+        self.next_prefetch.clear();
+        self.next_prefetch_from = -1;
+    }
 }
 
 #[derive(Clone)]
@@ -78,6 +168,7 @@ impl ApplyContext {
         context_free: bool
     ) -> Result<Self, ChainError> {
         let pending_block_timestamp = trx_context.pending_block_timestamp()?;
+        let scratch = ApplyScratch::acquire();
 
         Ok(ApplyContext {
             wasm_runtime,
@@ -96,17 +187,20 @@ impl ApplyContext {
                 start: Utc::now().timestamp_micros(),
                 privileged: false,
                 account_ram_deltas: BTreeMap::new(),
-                notified: VecDeque::new(),
-                inline_actions: Vec::new(),
-                context_free_inline_actions: Vec::new(),
+                notified: scratch.notified,
+                inline_actions: scratch.inline_actions,
+                context_free_inline_actions: scratch.context_free_inline_actions,
                 recurse_depth: depth,
-                keyval_cache: KeyValueIteratorCache::new(),
-                index64_cache: Index64IteratorCache::new(),
-                index128_cache: Index128IteratorCache::new(),
-                index256_cache: Index256IteratorCache::new(),
-                index_double_cache: IndexDoubleIteratorCache::new(),
-                index_long_double_cache: IndexLongDoubleIteratorCache::new(),
+                keyval_cache: scratch.keyval_cache,
+                index64_cache: scratch.index64_cache,
+                index128_cache: scratch.index128_cache,
+                index256_cache: scratch.index256_cache,
+                index_double_cache: scratch.index_double_cache,
+                index_long_double_cache: scratch.index_long_double_cache,
                 cpu_limit,
+                next_prefetch: scratch.next_prefetch,
+                next_prefetch_from: -1,
+                host_calls: 0,
             })),
         })
     }
@@ -154,6 +248,16 @@ impl ApplyContext {
             )?;
         }
 
+        // Sibling subtrees execute strictly in ordinal order. Running them
+        // concurrently is not an option in this model even when their
+        // receivers are disjoint: every action draws from the global and
+        // per-account receipt sequence counters in ordinal order, appends to
+        // the ordered receipt-digest list behind the action merkle root, and
+        // writes through the transaction's single chainbase undo session,
+        // whose object ids are assigned sequentially. The billing timer's
+        // pause/resume nesting is per-transaction as well. Intra-block
+        // parallelism lives at the transaction level, where the
+        // conflict-partitioned schedule isolates writers.
         for action_ordinal in context_free_inline_actions.iter() {
             trx_context.execute_action(*action_ordinal, recurse_depth + 1)?;
         }
@@ -166,12 +270,20 @@ impl ApplyContext {
     }
 
     pub fn exec_one(&mut self) -> Result<u64, ChainError> {
-        let receiver_account = self.db.get_account_metadata(self.receiver.as_u64())?;
+        let span_start = Instant::now();
+        let mut wasm_elapsed = Duration::ZERO;
+        let receiver_account = self
+            .trx_context
+            .cached_account_metadata(self.receiver.as_u64())?;
         let mut cpu_used = 100; // Base usage is always 100 instructions
-        let action = {
+        let (action, host_calls_before, ram_before) = {
             let mut inner = self.inner.write()?;
             inner.privileged = receiver_account.is_privileged();
-            inner.action.clone()
+            (
+                inner.action.clone(),
+                inner.host_calls,
+                inner.account_ram_deltas.values().sum::<i64>(),
+            )
         };
 
         let native =
@@ -182,27 +294,51 @@ impl ApplyContext {
 
         // Does the receiver account have a contract deployed?
         if !receiver_account.get_code_hash().empty() {
-            // Separate context here because we need to release the lock on inner before executing the Wasm code, which may call back into the context and cause deadlock if we hold the lock.
-            let cpu_limit = {
-                let inner = self.inner.read()?;
-                inner.cpu_limit
-            };
-
-            cpu_used += self.wasm_runtime.run(
-                self.receiver.clone(),
-                action.clone(),
-                self.clone(),
-                self.db.clone(),
-                receiver_account.get_code_hash(),
-                cpu_limit,
-            )?;
+            if !self.context_free
+                && native_token::handles(&self.receiver, &action, receiver_account.get_code_hash())
+            {
+                // The audited reference token image: execute transfer/issue
+                // natively through the same context primitives the wasm
+                // intrinsics use, skipping instantiation and metering.
+                cpu_used += native_token::apply(self, &action)?;
+            } else {
+                // Separate context here because we need to release the lock on inner before executing the Wasm code, which may call back into the context and cause deadlock if we hold the lock.
+                let cpu_limit = {
+                    let inner = self.inner.read()?;
+                    inner.cpu_limit
+                };
+                // Bound this dispatch's metering by the wall-clock budget the
+                // transaction has left, so a compute loop that never makes a
+                // host call still stops at the deadline.
+                let cpu_limit = self.trx_context.clamp_cpu_limit_to_deadline(cpu_limit);
+
+                let wasm_start = Instant::now();
+                cpu_used += self.wasm_runtime.run(
+                    self.receiver.clone(),
+                    action.clone(),
+                    self.clone(),
+                    self.db.clone(),
+                    receiver_account.get_code_hash(),
+                    cpu_limit,
+                )?;
+                wasm_elapsed = wasm_start.elapsed();
+            }
         }
 
         let act_digest = {
             let inner = self.inner.read()?;
+            // Refcount bump, not a buffer copy: the digest borrows the same
+            // allocation the wasm host call produced.
             generate_action_digest(&action, inner.action_return_value.clone())
         };
-        let first_receiver_account = self.db.get_account_metadata(action.account().as_u64())?;
+        // An inline fan-out to one contract hits the same-account branch on
+        // every action; the first receiver is the account already looked up.
+        let first_receiver_account = if action.account() == &self.receiver {
+            receiver_account
+        } else {
+            self.trx_context
+                .cached_account_metadata(action.account().as_u64())?
+        };
         let mut receipt = ActionReceipt::new(
             self.receiver.clone(),
             act_digest,
@@ -223,6 +359,38 @@ impl ApplyContext {
             .add_executed_action_receipt_digest(receipt.digest()?)?;
         self.finalize_trace(receipt)?;
 
+        BLOCK_PROFILER.record_action(
+            &self.receiver,
+            action.account(),
+            action.name(),
+            span_start.elapsed(),
+            wasm_elapsed,
+        );
+        EXEC_PHASES.record(Phase::Wasm, wasm_elapsed);
+        // The native remainder of the span: apply handlers, the receipt
+        // bookkeeping above, and the chainbase intrinsics the wasm called
+        // back into.
+        EXEC_PHASES.record(Phase::Apply, span_start.elapsed() - wasm_elapsed);
+
+        // Host calls and RAM deltas accumulate per transaction on the shared
+        // inner state, so this action's share is the change across its run.
+        let (host_calls, ram_delta) = {
+            let inner = self.inner.read()?;
+            (
+                inner.host_calls - host_calls_before,
+                inner.account_ram_deltas.values().sum::<i64>() - ram_before,
+            )
+        };
+        EXEC_ACCOUNTING.record_action(
+            &self.receiver,
+            action.account(),
+            action.name(),
+            span_start.elapsed(),
+            cpu_used,
+            host_calls,
+            ram_delta,
+        );
+
         Ok(cpu_used)
     }
 
@@ -234,6 +402,9 @@ impl ApplyContext {
                 trace.receipt = Some(receipt);
                 trace.set_elapsed((Utc::now().timestamp_micros() - inner.start) as u32);
                 trace.account_ram_deltas = inner.account_ram_deltas.clone();
+                // Shares the allocation with the apply context; large query
+                // payloads reach trace storage without another copy.
+                trace.return_value = inner.action_return_value.clone().unwrap_or_default();
             })?;
         Ok(())
     }
@@ -311,6 +482,14 @@ impl ApplyContext {
         self.db.is_account(account.as_u64())
     }
 
+    // Called from `context_aware_check`, so every stateful host call is
+    // attributed to the action that issued it for execution accounting.
+    pub fn count_host_call(&self) {
+        if let Ok(mut inner) = self.inner.write() {
+            inner.host_calls += 1;
+        }
+    }
+
     pub fn execute_inline(&mut self, a: &Action) -> Result<(), ChainError> {
         let action = {
             let inner = self.inner.read()?;
@@ -371,9 +550,13 @@ impl ApplyContext {
             }
         }
 
-        let inline_receiver = a.account();
+        let inline_receiver = *a.account();
+        // Repeated fan-out payloads (airdrops) collapse onto one shared
+        // allocation instead of each inline carrying its own copy.
+        let mut act = a.clone();
+        act.data = self.trx_context.memoize_action_data(act.data)?;
         let scheduled_ordinal =
-            self.schedule_action_from_action(a.clone(), &inline_receiver, false)?;
+            self.schedule_action_from_action(act, &inline_receiver, false)?;
         let mut inner = self.inner.write()?;
         inner.inline_actions.push(scheduled_ordinal);
 
@@ -396,9 +579,11 @@ impl ApplyContext {
             )),
         )?;
 
-        let inline_receiver = a.account();
+        let inline_receiver = *a.account();
+        let mut act = a.clone();
+        act.data = self.trx_context.memoize_action_data(act.data)?;
         let scheduled_ordinal =
-            self.schedule_action_from_action(a.clone(), &inline_receiver, true)?;
+            self.schedule_action_from_action(act, &inline_receiver, true)?;
         let mut inner = self.inner.write()?;
         inner.context_free_inline_actions.push(scheduled_ordinal);
 
@@ -411,20 +596,16 @@ impl ApplyContext {
         receiver: &Name,
         context_free: bool,
     ) -> Result<u32, ChainError> {
-        let scheduled_action_ordinal = self.trx_context.schedule_action_from_ordinal(
+        // The context's own action is an owned clone, so the push behind
+        // this schedule cannot invalidate it — no refetch needed, unlike the
+        // reference-holding C++ original this was ported from.
+        self.trx_context.schedule_action_from_ordinal(
             ordinal_of_action_to_schedule,
             receiver,
             context_free,
             self.action_ordinal,
             self.first_receiver_action_ordinal,
-        )?;
-
-        {
-            let mut inner = self.inner.write()?;
-            inner.action = self.trx_context.get_action_trace(self.action_ordinal)?.act;
-        }
-
-        Ok(scheduled_action_ordinal)
+        )
     }
 
     pub fn schedule_action_from_action(
@@ -433,20 +614,15 @@ impl ApplyContext {
         receiver: &Name,
         context_free: bool,
     ) -> Result<u32, ChainError> {
-        let scheduled_action_ordinal = self.trx_context.schedule_action(
+        // As in `schedule_action_from_ordinal`: the owned action clone
+        // survives the push, so the per-inline refetch is dropped.
+        self.trx_context.schedule_action(
             act_to_schedule,
             receiver,
             context_free,
             self.action_ordinal,
             self.first_receiver_action_ordinal,
-        )?;
-
-        {
-            let mut inner = self.inner.write()?;
-            inner.action = self.trx_context.get_action_trace(self.action_ordinal)?.act;
-        }
-
-        Ok(scheduled_action_ordinal)
+        )
     }
 
     pub fn get_context_free_data(
@@ -505,6 +681,7 @@ impl ApplyContext {
         primary_key: u64,
         data: Bytes,
     ) -> Result<i32, ChainError> {
+        let table_name = table;
         let table = self.find_or_create_table(*self.receiver, scope, table, payer)?;
         let table = unsafe { &*table };
         pulse_assert(
@@ -516,17 +693,23 @@ impl ApplyContext {
 
         let res = {
             let mut inner = self.inner.write()?;
+            inner.invalidate_next_prefetch();
             let obj =
                 self.db
-                    .create_key_value_object(table, payer, primary_key, &data.0.as_slice())?;
+                    .create_key_value_object(table, payer, primary_key, &data.as_slice())?;
             let obj = unsafe { &*obj };
-            inner.keyval_cache.cache_table(&table)?;
-            inner.keyval_cache.add(obj)?
+            inner.keyval_cache.cache_table(&table);
+            inner.keyval_cache.add(obj)
         };
 
         let billable_size = data.len() as i64 + billable_size_v::<KeyValueObject>() as i64;
         self.update_db_usage(&payer.into(), billable_size)?;
 
+        // Refcount bump, not a copy: the event shares the row's allocation.
+        self.record_state_diff(StateDiffOp::Store, scope, table_name, primary_key, || {
+            data.clone()
+        });
+
         Ok(res)
     }
 
@@ -538,7 +721,7 @@ impl ApplyContext {
     ) -> Result<(), ChainError> {
         let payer = payer.as_u64();
         let new_size = data.as_ref().len() as i64;
-        let (old_size, old_payer, new_payer) = {
+        let (old_size, old_payer, new_payer, diff) = {
             let inner = self.inner.read()?;
             let obj = inner.keyval_cache.get(iterator)?;
             let table_obj = inner.keyval_cache.get_table(obj.get_table_id())?;
@@ -546,6 +729,17 @@ impl ApplyContext {
                 table_obj.get_code().to_uint64_t() == self.receiver.as_u64(),
                 ChainError::TransactionError(format!("db access violation",)),
             )?;
+            // Looked up only while some diff subscription exists; the row's
+            // names live behind the table object, not in the arguments.
+            let diff = if STATE_DIFF_HUB.is_active() {
+                Some((
+                    table_obj.get_scope().to_uint64_t(),
+                    table_obj.get_table().to_uint64_t(),
+                    obj.get_primary_key(),
+                ))
+            } else {
+                None
+            };
             let old_payer = obj.get_payer().to_uint64_t();
             let new_payer = if payer == 0 {
                 obj.get_payer().to_uint64_t()
@@ -555,7 +749,7 @@ impl ApplyContext {
             let old_size = obj.get_value().size() as i64;
             self.db
                 .update_key_value_object(obj, new_payer, data.as_ref())?;
-            (old_size, old_payer, new_payer)
+            (old_size, old_payer, new_payer, diff)
         };
 
         let overhead = billable_size_v::<KeyValueObject>() as i64;
@@ -569,47 +763,140 @@ impl ApplyContext {
             self.update_db_usage(&Name::new(new_payer), new_size - old_size)?;
         }
 
+        if let Some((scope, table, primary_key)) = diff {
+            self.record_state_diff(StateDiffOp::Update, scope, table, primary_key, || {
+                Bytes::new(data.as_ref().to_vec())
+            });
+        }
+
         Ok(())
     }
 
-    pub fn db_get_i64(
+    /// Runs `f` over a borrowed view of the row value behind `iterator`.
+    /// The slice points straight into chainbase and stays valid for the
+    /// duration of the call (the inner read lock is held), so callers can
+    /// copy the value exactly once — e.g. directly into wasm linear
+    /// memory — instead of staging it through an intermediate buffer.
+    pub fn db_get_i64_with<R>(
         &self,
         iterator: i32,
-        buffer: &mut Vec<u8>,
-        buffer_size: usize,
-    ) -> Result<i32, ChainError> {
+        f: impl FnOnce(&[u8]) -> R,
+    ) -> Result<R, ChainError> {
         let inner = self.inner.read()?;
         let obj = inner.keyval_cache.get(iterator)?;
-        let s = obj.get_value().size();
-        if buffer_size == 0 {
-            return Ok(s as i32);
-        }
-        let copy_size = core::cmp::min(buffer_size, s);
-        if buffer.len() < copy_size {
-            buffer.resize(copy_size, 0);
-        }
-        buffer[..copy_size].copy_from_slice(&obj.get_value().as_slice()[..copy_size]);
-        Ok(copy_size as i32)
+        Ok(f(obj.get_value().as_slice()))
     }
 
     pub fn db_remove_i64(&mut self, iterator: i32) -> Result<(), ChainError> {
-        let delta = {
+        let (delta, diff) = {
             let mut inner = self.inner.write()?;
+            inner.invalidate_next_prefetch();
+            // The row's names and key are gone once the removal runs, so
+            // capture them up front — but only while some diff subscription
+            // exists.
+            let diff = if STATE_DIFF_HUB.is_active() {
+                let obj = inner.keyval_cache.get(iterator)?;
+                let table_obj = inner.keyval_cache.get_table(obj.get_table_id())?;
+                Some((
+                    table_obj.get_scope().to_uint64_t(),
+                    table_obj.get_table().to_uint64_t(),
+                    obj.get_primary_key(),
+                ))
+            } else {
+                None
+            };
             let delta =
                 self.db
                     .db_remove_i64(&mut inner.keyval_cache, iterator, self.receiver.as_u64())?;
-            delta
+            (delta, diff)
         };
 
         self.update_db_usage(&Name::new(self.receiver.as_u64()), -delta)?;
 
+        if let Some((scope, table, primary_key)) = diff {
+            self.record_state_diff(StateDiffOp::Remove, scope, table, primary_key, Bytes::default);
+        }
+
         Ok(())
     }
 
+    // Feeds the live diff stream behind [`STATE_DIFF_HUB`]. Only verify and
+    // accept passes record — theirs are the writes that can commit;
+    // speculative and building executions roll back by construction. The
+    // value closure runs only on a filter match, so unmatched writes never
+    // materialize a row copy.
+    fn record_state_diff(
+        &self,
+        op: StateDiffOp,
+        scope: u64,
+        table: u64,
+        primary_key: u64,
+        value: impl FnOnce() -> Bytes,
+    ) {
+        if !STATE_DIFF_HUB.matches(self.receiver.as_u64(), table) {
+            return;
+        }
+        if !matches!(
+            self.trx_context.block_status(),
+            BlockStatus::Verifying | BlockStatus::Accepting
+        ) {
+            return;
+        }
+        STATE_DIFF_HUB.record(StateDiffEvent {
+            code: self.receiver.clone(),
+            scope: Name::new(scope),
+            table: Name::new(table),
+            primary_key,
+            op,
+            value: value(),
+        });
+    }
+
     pub fn db_next_i64(&mut self, iterator: i32, primary: &mut u64) -> Result<i32, ChainError> {
         let mut inner = self.inner.write()?;
-        self.db
-            .db_next_i64(&mut inner.keyval_cache, iterator, primary)
+
+        // Serve sequential walks from the prefetch buffer so a tight
+        // iteration loop crosses the bridge once per batch, not once per row.
+        if inner.next_prefetch_from == iterator {
+            if let Some((next, pk)) = inner.next_prefetch.pop_front() {
+                if next >= 0 {
+                    *primary = pk;
+                    inner.next_prefetch_from = next;
+                } else {
+                    // Terminal entry: end iterator (or -1), nothing follows.
+                    inner.invalidate_next_prefetch();
+                }
+                return Ok(next);
+            }
+        }
+
+        inner.invalidate_next_prefetch();
+
+        let mut iterators = [0i32; DB_NEXT_PREFETCH];
+        let mut primaries = [0u64; DB_NEXT_PREFETCH];
+        let filled = self.db.db_next_i64_batch(
+            &mut inner.keyval_cache,
+            iterator,
+            &mut iterators,
+            &mut primaries,
+        )?;
+
+        if filled == 0 {
+            return Ok(-1); // empty batch window; cannot happen with DB_NEXT_PREFETCH > 0
+        }
+
+        let first = iterators[0];
+        if first >= 0 {
+            *primary = primaries[0];
+            inner.next_prefetch_from = first;
+            for i in 1..filled {
+                inner
+                    .next_prefetch
+                    .push_back((iterators[i], primaries[i]));
+            }
+        }
+
+        Ok(first)
     }
 
     pub fn db_previous_i64(&mut self, iterator: i32, primary: &mut u64) -> Result<i32, ChainError> {
@@ -648,6 +935,65 @@ impl ApplyContext {
             .db_upperbound_i64(&mut inner.keyval_cache, code, scope, table, primary)
     }
 
+    /// Warm-up hint for an upcoming `[lower, upper]` primary-key scan: walks
+    /// up to [`DB_PREFETCH_RANGE_CAP`] rows through the bridge in batches,
+    /// materializing them into the iterator cache (which faults the backing
+    /// chainbase pages in) and leaving the successor chain in the readahead
+    /// buffer, so the following lowerbound/next loop is served without
+    /// per-row crossings. Purely an optimization: the walk observes exactly
+    /// what it would have observed without the hint.
+    pub fn db_prefetch_range(
+        &mut self,
+        code: u64,
+        scope: u64,
+        table: u64,
+        lower: u64,
+        upper: u64,
+    ) -> Result<(), ChainError> {
+        if upper < lower {
+            return Ok(());
+        }
+        let mut inner = self.inner.write()?;
+        let first = self
+            .db
+            .db_lowerbound_i64(&mut inner.keyval_cache, code, scope, table, lower)?;
+        if first < 0 {
+            return Ok(());
+        }
+
+        inner.invalidate_next_prefetch();
+        let mut current = first;
+        let mut walked = 0;
+        'walk: while walked < DB_PREFETCH_RANGE_CAP {
+            let mut iterators = [0i32; DB_NEXT_PREFETCH];
+            let mut primaries = [0u64; DB_NEXT_PREFETCH];
+            let filled = self.db.db_next_i64_batch(
+                &mut inner.keyval_cache,
+                current,
+                &mut iterators,
+                &mut primaries,
+            )?;
+            if filled == 0 {
+                break;
+            }
+            for i in 0..filled {
+                inner.next_prefetch.push_back((iterators[i], primaries[i]));
+                if iterators[i] < 0 {
+                    break 'walk; // end of table: terminal entry buffered
+                }
+                current = iterators[i];
+                walked += 1;
+                // Keys past `upper` stop the walk; the entry stays buffered
+                // since it is still the truthful successor.
+                if primaries[i] > upper {
+                    break 'walk;
+                }
+            }
+        }
+        inner.next_prefetch_from = first;
+        Ok(())
+    }
+
     pub fn db_idx64_store(
         &mut self,
         scope: u64,
@@ -671,8 +1017,8 @@ impl ApplyContext {
                 .db
                 .create_index64_object(table, payer, primary_key, secondary_key)?;
             let obj = unsafe { &*obj };
-            inner.index64_cache.cache_table(&table)?;
-            inner.index64_cache.add(obj)?
+            inner.index64_cache.cache_table(&table);
+            inner.index64_cache.add(obj)
         };
 
         let billable_size = billable_size_v::<Index64Object>() as i64;
@@ -851,8 +1197,8 @@ impl ApplyContext {
                 .db
                 .create_index128_object(table, payer, primary_key, secondary_key)?;
             let obj = unsafe { &*obj };
-            inner.index128_cache.cache_table(&table)?;
-            inner.index128_cache.add(obj)?
+            inner.index128_cache.cache_table(&table);
+            inner.index128_cache.add(obj)
         };
 
         let billable_size = billable_size_v::<Index128Object>() as i64;
@@ -1034,8 +1380,8 @@ impl ApplyContext {
                 .db
                 .create_index256_object(table, payer, primary_key, secondary_key)?;
             let obj = unsafe { &*obj };
-            inner.index256_cache.cache_table(&table)?;
-            inner.index256_cache.add(obj)?
+            inner.index256_cache.cache_table(&table);
+            inner.index256_cache.add(obj)
         };
 
         let billable_size = billable_size_v::<Index256Object>() as i64;
@@ -1217,8 +1563,8 @@ impl ApplyContext {
                 .db
                 .create_idx_double_object(table, payer, primary_key, secondary_key)?;
             let obj = unsafe { &*obj };
-            inner.index_double_cache.cache_table(&table)?;
-            inner.index_double_cache.add(obj)?
+            inner.index_double_cache.cache_table(&table);
+            inner.index_double_cache.add(obj)
         };
 
         let billable_size = billable_size_v::<IndexDoubleObject>() as i64;
@@ -1410,8 +1756,8 @@ impl ApplyContext {
                 self.db
                     .create_idx_long_double_object(table, payer, primary_key, secondary_key)?;
             let obj = unsafe { &*obj };
-            inner.index_long_double_cache.cache_table(&table)?;
-            inner.index_long_double_cache.add(obj)?
+            inner.index_long_double_cache.cache_table(&table);
+            inner.index_long_double_cache.add(obj)
         };
 
         let billable_size = billable_size_v::<IndexLongDoubleObject>() as i64;
@@ -1640,7 +1986,7 @@ impl ApplyContext {
         return Ok(());
     }
 
-    pub fn set_action_return_value(&self, value: Vec<u8>) -> Result<(), ChainError> {
+    pub fn set_action_return_value(&self, value: Bytes) -> Result<(), ChainError> {
         let mut inner = self.inner.write()?;
         inner.action_return_value = Some(value);
         Ok(())
@@ -1650,15 +1996,17 @@ impl ApplyContext {
         &mut self,
         receiver_account: &AccountMetadataObject,
     ) -> Result<u64, ChainError> {
-        self.db.next_recv_sequence(receiver_account)
+        self.trx_context
+            .next_recv_sequence(self.receiver.as_u64(), receiver_account)
     }
 
     pub fn next_auth_sequence(&mut self, actor: u64) -> Result<u64, ChainError> {
-        self.db.next_auth_sequence(actor)
+        let account_metadata = self.trx_context.cached_account_metadata(actor)?;
+        self.trx_context.next_auth_sequence(actor, account_metadata)
     }
 
     pub fn next_global_sequence(&mut self) -> Result<u64, ChainError> {
-        self.db.next_global_sequence()
+        self.trx_context.next_global_sequence()
     }
 
     pub fn is_privileged(&self) -> Result<bool, ChainError> {
@@ -1680,6 +2028,35 @@ impl ApplyContext {
         Ok(inner.account_ram_deltas.clone())
     }
 
+    /// Stateful host calls this context's action issued, read back by the
+    /// transaction context for its per-transaction total.
+    pub fn host_calls(&self) -> Result<u64, ChainError> {
+        let inner = self.inner.read()?;
+        Ok(inner.host_calls)
+    }
+
+    /// Returns this context's container set to the scratch pool once the
+    /// action is done with it. A pooled wasm session may still hold a clone
+    /// of this context, but it never reads through it again before being
+    /// reset for its next action, so taking the containers out is safe.
+    pub fn recycle(&self) -> Result<(), ChainError> {
+        let mut inner = self.inner.write()?;
+        ApplyScratch {
+            notified: std::mem::take(&mut inner.notified),
+            inline_actions: std::mem::take(&mut inner.inline_actions),
+            context_free_inline_actions: std::mem::take(&mut inner.context_free_inline_actions),
+            keyval_cache: std::mem::take(&mut inner.keyval_cache),
+            index64_cache: std::mem::take(&mut inner.index64_cache),
+            index128_cache: std::mem::take(&mut inner.index128_cache),
+            index256_cache: std::mem::take(&mut inner.index256_cache),
+            index_double_cache: std::mem::take(&mut inner.index_double_cache),
+            index_long_double_cache: std::mem::take(&mut inner.index_long_double_cache),
+            next_prefetch: std::mem::take(&mut inner.next_prefetch),
+        }
+        .release();
+        Ok(())
+    }
+
     pub fn pause_billing_timer(&self) -> Result<(), ChainError> {
         self.trx_context.pause_billing_timer()?;
         Ok(())
@@ -62,7 +62,7 @@ impl Asset {
     }
 
     #[must_use]
-    pub fn is_valid(&self) -> bool {
+    pub const fn is_valid(&self) -> bool {
         self.is_amount_within_range() && self.symbol.is_valid()
     }
 }
@@ -70,27 +70,40 @@ impl Asset {
 impl fmt::Display for Asset {
     fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
         let precision = usize::from(self.symbol.precision());
-        let code = self.symbol.code();
 
-        if precision == 0 {
-            return write!(f, "{} {}", self.amount, code);
+        // Fixed-point integer-to-string on the stack, digits emitted least
+        // significant first with the decimal point dropped in at the
+        // precision boundary. A sign, 19 magnitude digits and the point fit
+        // in 32 bytes with room to spare, so formatting a quantity — which
+        // happens in every transfer trace — never allocates.
+        let negative = self.amount < 0;
+        let mut magnitude = self.amount.unsigned_abs();
+        let mut buf = [0u8; 32];
+        let mut pos = buf.len();
+        let mut emitted = 0;
+        loop {
+            if emitted == precision && precision != 0 {
+                pos -= 1;
+                buf[pos] = b'.';
+            }
+            pos -= 1;
+            buf[pos] = b'0' + (magnitude % 10) as u8;
+            magnitude /= 10;
+            emitted += 1;
+            // Keep going until the magnitude is spent and at least one
+            // digit sits left of the point ("0.0001", not ".0001").
+            if magnitude == 0 && emitted > precision {
+                break;
+            }
+        }
+        if negative {
+            pos -= 1;
+            buf[pos] = b'-';
         }
 
-        // Work on the magnitude and emit the sign separately, so the digit
-        // arithmetic never has to account for a leading '-'.
-        let negative = self.amount < 0;
-        let magnitude = self.amount.unsigned_abs();
-        let digits = format!("{:0width$}", magnitude, width = precision + 1);
-        let split = digits.len() - precision;
-
-        write!(
-            f,
-            "{}{}.{} {}",
-            if negative { "-" } else { "" },
-            &digits[..split],
-            &digits[split..],
-            code
-        )
+        // Every byte written above is ASCII.
+        let amount = std::str::from_utf8(&buf[pos..]).map_err(|_| fmt::Error)?;
+        write!(f, "{} {}", amount, self.symbol.code())
     }
 }
 
@@ -180,10 +193,18 @@ impl FromStr for Asset {
             )));
         }
 
-        let combined = format!("{}{}", whole, fraction);
-        let magnitude = combined
-            .parse::<u64>()
-            .map_err(|e| ParseAssetError(format!("invalid amount: {}", e)))?;
+        // Accumulate the fixed-point magnitude straight from the digit runs
+        // instead of concatenating them into a heap string first; the bytes
+        // were validated as ASCII digits above.
+        let mut magnitude: u64 = 0;
+        for b in whole.bytes().chain(fraction.bytes()) {
+            magnitude = magnitude
+                .checked_mul(10)
+                .and_then(|m| m.checked_add(u64::from(b - b'0')))
+                .ok_or_else(|| {
+                    ParseAssetError(format!("invalid amount: {}", amount_str))
+                })?;
+        }
 
         if magnitude > MAX_AMOUNT as u64 {
             return Err(ParseAssetError(
@@ -230,6 +251,12 @@ mod tests {
             .to_string(),
             "1000000 USD"
         );
+        // Worst case for the stack buffer: sign + 19 digits + point at
+        // maximum precision.
+        assert_eq!(
+            Asset::new(-MAX_AMOUNT, sys(18)).to_string(),
+            "-4.611686018427387903 SYS"
+        );
     }
 
     #[test]
@@ -84,9 +84,10 @@ impl Symbol {
     }
 
     /// Mirrors nodeos `symbol::valid()`: precision within range and a
-    /// well-formed code.
+    /// well-formed code. `const` end to end, so constant symbols validate
+    /// at compile time.
     #[must_use]
-    pub fn is_valid(&self) -> bool {
+    pub const fn is_valid(&self) -> bool {
         self.precision() <= MAX_PRECISION && self.code().is_valid()
     }
 }
@@ -79,22 +79,34 @@ impl SymbolCode {
     }
 
     /// Mirrors nodeos `symbol_code::valid()`: 1-7 uppercase ASCII bytes,
-    /// all remaining bytes zero.
+    /// all remaining bytes zero. Checked without a per-byte loop — the
+    /// significant bytes are range-tested in parallel with masked byte-wise
+    /// subtractions — and `const`, so constant codes validate at compile
+    /// time and the transfer path pays a handful of word operations.
     #[must_use]
-    pub fn is_valid(&self) -> bool {
-        let mut sym = self.as_u64();
-        let mut i = 0;
-        while i < SYMBOL_CODE_MAX_LEN {
-            let c = (sym & 0xFF) as u8;
-            if !c.is_ascii_uppercase() {
-                break;
-            }
-            sym >>= 8;
-            i += 1;
+    pub const fn is_valid(&self) -> bool {
+        let v = self.as_u64();
+        // Empty, or a byte in the eighth position (codes hold at most 7).
+        if v == 0 || v >= 1 << 56 {
+            return false;
+        }
+        // Mask covering every byte up to and including the top non-zero
+        // one; an embedded zero byte below it (e.g. "EOS\0X") sits inside
+        // the mask and fails the lower-bound test.
+        let n_bytes = (71 - v.leading_zeros() as u64) / 8;
+        let mask = (1u64 << (8 * n_bytes)) - 1;
+        let high = 0x8080_8080_8080_8080u64 & mask;
+        // Uppercase ASCII is below 0x80, so a set high bit anywhere
+        // disqualifies — and its absence guarantees the subtractions below
+        // never borrow across byte lanes.
+        if v & high != 0 {
+            return false;
         }
-        // i > 0 rejects the empty code; sym == 0 rejects trailing garbage
-        // after the letters, e.g. "EOS\0X".
-        i > 0 && sym == 0
+        let lo = 0x4141_4141_4141_4141u64 & mask; // 'A' in every lane
+        let hi = 0x5A5A_5A5A_5A5A_5A5Au64 & mask; // 'Z' in every lane
+        let ge_a = ((v | high) - lo) & high == high;
+        let le_z = ((hi | high) - v) & high == high;
+        ge_a && le_z
     }
 
     /// Number of characters in the code. Only meaningful for valid codes.
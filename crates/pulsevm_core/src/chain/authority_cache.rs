@@ -0,0 +1,64 @@
+use std::{
+    num::NonZeroUsize,
+    sync::{Arc, LazyLock, Mutex},
+};
+
+use lru::LruCache;
+use pulsevm_ffi::{Authority, PermissionObject};
+
+// Flattened authority trees keyed by (actor, permission, last_updated). Every
+// permission walk in the authority checker re-reads the shared_authority bytes
+// out of chainbase and rebuilds an owned Authority; for hot accounts that is
+// the same tree over and over. Keying on last_updated makes entries
+// self-invalidating: updateauth rewrites the timestamp and chainbase undo
+// rolls it back, so a hit can never return a stale tree even across
+// speculative execution, failed transactions, or reorgs — no invalidation
+// hooks in the mutation paths are needed.
+#[derive(Clone)]
+pub struct AuthorityCache {
+    inner: Arc<Mutex<LruCache<(u64, u64, i64), Arc<Authority>>>>,
+}
+
+// A few thousand distinct (account, permission) pairs covers the working set
+// of active signers; stale versions of a rewritten permission age out.
+const AUTHORITY_CACHE_CAPACITY: usize = 8192;
+
+pub static AUTHORITY_CACHE: LazyLock<AuthorityCache> = LazyLock::new(AuthorityCache::new);
+
+impl AuthorityCache {
+    pub fn new() -> Self {
+        Self {
+            inner: Arc::new(Mutex::new(LruCache::new(
+                NonZeroUsize::new(AUTHORITY_CACHE_CAPACITY).unwrap(),
+            ))),
+        }
+    }
+
+    pub fn resolve(&self, perm: &PermissionObject) -> Arc<Authority> {
+        let key = (
+            perm.get_owner().to_uint64_t(),
+            perm.get_name().to_uint64_t(),
+            perm.get_last_updated_us(),
+        );
+
+        if let Ok(mut cache) = self.inner.lock() {
+            if let Some(authority) = cache.get(&key) {
+                return authority.clone();
+            }
+        }
+
+        let authority = Arc::new(perm.get_authority().to_authority());
+
+        if let Ok(mut cache) = self.inner.lock() {
+            cache.put(key, authority.clone());
+        }
+
+        authority
+    }
+}
+
+impl Default for AuthorityCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
@@ -5,7 +5,8 @@ use pulsevm_ffi::{Database, Microseconds};
 
 use crate::crypto::PublicKey;
 
-use super::authority::{Authority, KeyWeight, PermissionLevel, PermissionLevelWeight};
+use super::authority::{Authority, KeyWeight, PermissionLevel, PermissionLevelWeight, WaitWeight};
+use super::authority_cache::AUTHORITY_CACHE;
 
 pub struct AuthorityChecker<'a> {
     recursion_depth_limit: u16,
@@ -65,32 +66,60 @@ impl<'a> AuthorityChecker<'a> {
         authority: &Authority,
         recursion_depth: u16,
     ) -> Result<bool, ChainError> {
-        let mut total_weight = 0u32;
-
-        for key in authority.keys() {
-            total_weight += self.visit_key_weight(key)? as u32;
+        // Keys visited while failing to satisfy this authority did not
+        // actually authorize anything; restore used_keys on the unsatisfied
+        // path so all_keys_used() only counts keys that contributed.
+        let saved_used_keys = self.used_keys.clone();
+
+        enum Factor<'f> {
+            Key(&'f KeyWeight),
+            Account(&'f PermissionLevelWeight),
+            Wait(&'f WaitWeight),
         }
 
-        if total_weight >= authority.threshold() {
-            return Ok(true);
+        // Tally greedily from the heaviest factor down so the threshold is
+        // reached with as few visits — and as few permission tree walks — as
+        // possible. At equal weight, keys sort ahead of accounts ahead of
+        // waits: a provided-key lookup is cheaper than recursing into a
+        // sub-authority.
+        let mut factors: Vec<(u16, u8, Factor)> = Vec::with_capacity(
+            authority.keys().len() + authority.accounts().len() + authority.waits().len(),
+        );
+        for key in authority.keys() {
+            factors.push((key.weight, 0, Factor::Key(key)));
         }
-
         for permission in authority.accounts() {
-            total_weight +=
-                self.visit_permission_level_weight(db, permission, recursion_depth)? as u32;
+            factors.push((permission.weight, 1, Factor::Account(permission)));
         }
-
-        if total_weight >= authority.threshold() {
-            return Ok(true);
+        for wait in authority.waits() {
+            factors.push((wait.weight, 2, Factor::Wait(wait)));
         }
+        factors.sort_by(|(wa, ra, _), (wb, rb, _)| wb.cmp(wa).then(ra.cmp(rb)));
 
-        for wait in authority.waits() {
-            if self.provided_delay >= Microseconds::new(wait.wait_sec as i64 * 1_000_000) {
-                total_weight += wait.weight as u32;
+        let mut total_weight = 0u32;
+
+        for (_, _, factor) in factors.iter() {
+            total_weight += match factor {
+                Factor::Key(key) => self.visit_key_weight(key)? as u32,
+                Factor::Account(permission) => {
+                    self.visit_permission_level_weight(db, permission, recursion_depth)? as u32
+                }
+                Factor::Wait(wait) => {
+                    if self.provided_delay >= Microseconds::new(wait.wait_sec as i64 * 1_000_000) {
+                        wait.weight as u32
+                    } else {
+                        0
+                    }
+                }
+            };
+
+            if total_weight >= authority.threshold() {
+                return Ok(true);
             }
         }
 
-        Ok(total_weight >= authority.threshold())
+        self.used_keys = saved_used_keys;
+        Ok(false)
     }
 
     pub fn visit_key_weight(&mut self, key: &KeyWeight) -> Result<u16, ChainError> {
@@ -144,6 +173,7 @@ impl<'a> AuthorityChecker<'a> {
         }
 
         let auth = unsafe { &*auth };
+        let authority = AUTHORITY_CACHE.resolve(auth);
 
         // mark as being evaluated to detect cycles
         self.cached_permissions.insert(
@@ -151,11 +181,7 @@ impl<'a> AuthorityChecker<'a> {
             PermissionCacheStatus::BeingEvaluated,
         );
 
-        let satisfied = self.satisfied(
-            db,
-            &auth.get_authority().to_authority(),
-            recursion_depth + 1,
-        )?;
+        let satisfied = self.satisfied(db, &authority, recursion_depth + 1)?;
 
         if satisfied {
             self.cached_permissions.insert(
@@ -176,6 +176,41 @@ impl AuthorizationManager {
         candidate_keys: &BTreeSet<PublicKey>,
         provided_delay: Microseconds,
     ) -> Result<BTreeSet<PublicKey>, ChainError> {
+        // Fast path for the dominant wallet shape: one candidate key. When
+        // that key appears directly in every declared permission's authority
+        // with enough weight to meet the threshold on its own, the
+        // key→permission reverse index answers with one probe per
+        // authorization and the required set is exactly that key — no
+        // authority tree walk. Waits can only add weight, so a key that
+        // clears the threshold alone clears it under any delay. Anything
+        // else — key absent from an authority, underweight, or several
+        // candidate keys — falls through to the full checker below.
+        if candidate_keys.len() == 1 {
+            let key = candidate_keys.first().expect("len checked above");
+            let packed = key.inner().packed_bytes();
+            let mut declared_auths = 0usize;
+            let mut satisfied = true;
+            'actions: for act in trx.actions.iter() {
+                for declared_auth in act.authorization() {
+                    declared_auths += 1;
+                    match db.key_satisfies_permission_alone(
+                        &packed,
+                        declared_auth.actor,
+                        declared_auth.permission,
+                    )? {
+                        Some(true) => {}
+                        _ => {
+                            satisfied = false;
+                            break 'actions;
+                        }
+                    }
+                }
+            }
+            if declared_auths > 0 && satisfied {
+                return Ok(BTreeSet::from([key.clone()]));
+            }
+        }
+
         let global_properties = unsafe { &*db.get_global_properties()? };
         let chain_config = global_properties.get_chain_config();
         let provided_permissions = BTreeSet::<PermissionLevel>::new();
@@ -4,13 +4,17 @@ use pulsevm_crypto::{Digest, FixedBytes};
 use pulsevm_error::ChainError;
 use pulsevm_ffi::{BlockTimestamp, Database};
 use pulsevm_proc_macros::{NumBytes, Read, Write};
-use pulsevm_serialization::Write;
+use pulsevm_serialization::{Read as _, ReadError, ReadRef, Write};
 use serde::{Serialize, ser::SerializeStruct};
 use spdlog::{info, warn};
 
 use crate::{
-    chain::{Name, id::Id, transaction::TransactionReceipt},
-    crypto::Signature,
+    chain::{
+        Name,
+        id::Id,
+        transaction::{TransactionReceipt, TransactionReceiptRef},
+    },
+    crypto::{Signature, SigningProvider},
     utils::pulse_assert,
 };
 
@@ -139,6 +143,24 @@ impl SignedBlock {
         self.signed_block_header.header.calculate_id()
     }
 
+    /// Decodes either wire format: compact v2 payloads identify themselves
+    /// through their magic prefix, everything else is a v1 pack.
+    pub fn from_wire(bytes: &[u8]) -> Result<Self, ReadError> {
+        if super::wire_v2::is_v2(bytes) {
+            super::wire_v2::decode(bytes)
+        } else {
+            Self::read(bytes, &mut 0)
+        }
+    }
+
+    /// Signs the header digest with the producer's signing provider,
+    /// replacing the placeholder signature `new` leaves in place.
+    pub fn sign(&mut self, signer: &dyn SigningProvider) -> Result<(), ChainError> {
+        let digest = self.signed_block_header.header.digest()?;
+        self.signed_block_header.signature = signer.sign(&digest.0.into())?;
+        Ok(())
+    }
+
     pub fn previous_id(&self) -> &Id {
         &self.signed_block_header.header.previous
     }
@@ -189,6 +211,150 @@ impl SignedBlock {
     }
 }
 
+/// Borrowed view of a [`SignedBlock`] decoded directly over the gossip
+/// buffer: the header is materialized (it is small and fixed-cost) but every
+/// transaction's packed payloads stay slices into the buffer, so header-level
+/// consumers (`parse_block`, ancestor scans) allocate nothing per
+/// transaction. [`SignedBlockRef::into_owned`] performs the full owned
+/// decode, including unpacking and validating every transaction.
+#[derive(Debug, Clone)]
+pub struct SignedBlockRef<'a> {
+    pub signed_block_header: SignedBlockHeader,
+    pub transactions: Vec<TransactionReceiptRef<'a>>,
+    pub block_extensions: Vec<(u16, Vec<u8>)>,
+}
+
+impl<'a> SignedBlockRef<'a> {
+    pub fn id(&self) -> Result<Id, ChainError> {
+        self.signed_block_header.header.calculate_id()
+    }
+
+    /// Borrowed-view counterpart of [`SignedBlock::from_wire`].
+    pub fn from_wire(bytes: &'a [u8]) -> Result<Self, ReadError> {
+        if super::wire_v2::is_v2(bytes) {
+            super::wire_v2::decode_ref(bytes)
+        } else {
+            Self::read_ref(bytes, &mut 0)
+        }
+    }
+
+    pub fn previous_id(&self) -> &Id {
+        &self.signed_block_header.header.previous
+    }
+
+    pub fn block_num(&self) -> u32 {
+        self.signed_block_header.header.block_num()
+    }
+
+    pub fn timestamp(&self) -> &BlockTimestamp {
+        &self.signed_block_header.header.timestamp
+    }
+
+    pub fn into_owned(self) -> Result<SignedBlock, ChainError> {
+        let mut transactions = VecDeque::with_capacity(self.transactions.len());
+        for receipt in self.transactions {
+            transactions.push_back(receipt.into_owned()?);
+        }
+        Ok(SignedBlock {
+            signed_block_header: self.signed_block_header,
+            transactions,
+            block_extensions: self.block_extensions,
+        })
+    }
+}
+
+/// Header-only decode of a block, for consumers that vote before they
+/// execute. Only the signed header is materialized — id, parent, height and
+/// timestamp all come from it — and the transaction section is recorded as
+/// bounds into the caller's buffer without being walked at all (even
+/// [`SignedBlockRef`] scans every receipt to delimit it).
+/// [`LazyBlock::decode_payload`] performs the deferred per-transaction
+/// decode, so during consensus storms the blocks that never get executed
+/// never pay it.
+#[derive(Debug, Clone)]
+pub struct LazyBlock<'a> {
+    pub signed_block_header: SignedBlockHeader,
+    /// Undecoded transaction and extension section.
+    payload: &'a [u8],
+    /// `Some(flags)` when `payload` is in the v2 wire format.
+    v2_flags: Option<u8>,
+}
+
+impl<'a> LazyBlock<'a> {
+    /// Header-only counterpart of [`SignedBlock::from_wire`].
+    pub fn from_wire(bytes: &'a [u8]) -> Result<Self, ReadError> {
+        if super::wire_v2::is_v2(bytes) {
+            let (signed_block_header, flags, pos) = super::wire_v2::decode_header(bytes)?;
+            Ok(LazyBlock {
+                signed_block_header,
+                payload: &bytes[pos..],
+                v2_flags: Some(flags),
+            })
+        } else {
+            let mut pos = 0;
+            let signed_block_header = SignedBlockHeader::read(bytes, &mut pos)?;
+            Ok(LazyBlock {
+                signed_block_header,
+                payload: &bytes[pos..],
+                v2_flags: None,
+            })
+        }
+    }
+
+    pub fn id(&self) -> Result<Id, ChainError> {
+        self.signed_block_header.header.calculate_id()
+    }
+
+    pub fn previous_id(&self) -> &Id {
+        &self.signed_block_header.header.previous
+    }
+
+    pub fn block_num(&self) -> u32 {
+        self.signed_block_header.header.block_num()
+    }
+
+    pub fn timestamp(&self) -> &BlockTimestamp {
+        &self.signed_block_header.header.timestamp
+    }
+
+    /// Decodes the deferred transaction section into the owned block the
+    /// execute path needs, unpacking and validating every transaction. The
+    /// work skipped at parse time is paid here, exactly once, and only for
+    /// blocks that actually execute.
+    pub fn decode_payload(&self) -> Result<SignedBlock, ReadError> {
+        match self.v2_flags {
+            None => {
+                let mut pos = 0;
+                let transactions = VecDeque::<TransactionReceipt>::read(self.payload, &mut pos)?;
+                let block_extensions = Vec::<(u16, Vec<u8>)>::read(self.payload, &mut pos)?;
+                Ok(SignedBlock {
+                    signed_block_header: self.signed_block_header.clone(),
+                    transactions,
+                    block_extensions,
+                })
+            }
+            Some(flags) => super::wire_v2::decode_payload(
+                self.signed_block_header.clone(),
+                flags,
+                self.payload,
+            ),
+        }
+    }
+}
+
+impl<'a> ReadRef<'a> for SignedBlockRef<'a> {
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let signed_block_header = SignedBlockHeader::read(bytes, pos)?;
+        let transactions = Vec::<TransactionReceiptRef>::read_ref(bytes, pos)?;
+        let block_extensions = Vec::<(u16, Vec<u8>)>::read(bytes, pos)?;
+        Ok(SignedBlockRef {
+            signed_block_header,
+            transactions,
+            block_extensions,
+        })
+    }
+}
+
 impl Serialize for SignedBlock {
     fn serialize<S>(&self, serializer: S) -> Result<S::Ok, S::Error>
     where
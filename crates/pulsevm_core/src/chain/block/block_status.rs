@@ -4,5 +4,10 @@ pub enum BlockStatus {
     Building,
     Verifying,
     Accepting,
+    // Replaying blocks already in the local block log at startup. These are
+    // below the trusted irreversible height — their signatures and
+    // authorities were checked before they were accepted — so both are
+    // skipped during replay.
+    Replaying,
     Benchmarking, // Only used for benchmarking, not for actual block production
 }
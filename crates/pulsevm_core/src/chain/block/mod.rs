@@ -7,4 +7,6 @@ pub use block_status::*;
 mod block;
 pub use block::*;
 
+pub mod wire_v2;
+
 pub use pulsevm_ffi::BlockTimestamp;
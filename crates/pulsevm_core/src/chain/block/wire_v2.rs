@@ -0,0 +1,377 @@
+//! Compact v2 encoding of [`SignedBlock`] for gossip and the block log.
+//!
+//! The v1 layout spends fixed-width integers on fields that are almost
+//! always zero (`confirmed`, `schedule_version`, the placeholder producer
+//! and extension vectors) and four bytes on every receipt's
+//! `cpu_usage_us`. v2 elides fields at their default value behind a flags
+//! byte, varint-encodes the small integers, and delta-encodes the receipt
+//! cpu sequence, which clusters around the block's typical action cost
+//! and so usually fits one or two LEB128 bytes.
+//!
+//! Consensus safety: the block id and the producer signature both hash
+//! the canonical v1 pack of the header, and transaction signatures cover
+//! the packed transaction bytes. v2 therefore only re-arranges the
+//! envelope — every `PackedTransaction` is embedded in its v1 encoding
+//! byte for byte, and decoding re-materializes exactly the structures the
+//! v1 decoder would. There is no handshake with peers: v2 payloads are
+//! self-identifying through the magic prefix and both decoders stay live
+//! forever, so emission can be switched per node once the fleet decodes
+//! v2 (`NodeConfig::block_wire_v2`).
+//!
+//! The header timestamp stays a fixed u32 slot: current slot values need
+//! five LEB128 bytes, and a self-contained wire format has no previous
+//! block to delta against.
+
+use std::collections::VecDeque;
+
+use pulsevm_crypto::Digest;
+use pulsevm_ffi::BlockTimestamp;
+use pulsevm_serialization::{
+    NumBytes, Read, ReadError, ReadRef, VarInt32, VarUint32, Write, WriteError,
+};
+
+use crate::{
+    chain::{
+        Name,
+        block::{BlockHeader, SignedBlock, SignedBlockHeader, SignedBlockRef},
+        id::Id,
+        transaction::{
+            PackedTransaction, PackedTransactionRef, TransactionReceipt, TransactionReceiptHeader,
+            TransactionReceiptRef, TransactionStatus,
+        },
+    },
+    crypto::Signature,
+};
+
+/// Prefix distinguishing a v2 payload from a v1 pack. A v1 block starts
+/// with the timestamp slot as u32 little-endian followed by the producer
+/// name; colliding with the magic would take a slot of `u32::MAX` (tens
+/// of thousands of years out) and a producer name whose low bytes spell
+/// "PVB2", so sniffing on the prefix is sound.
+pub const BLOCK_WIRE_V2_MAGIC: [u8; 8] = [0xFF, 0xFF, 0xFF, 0xFF, b'P', b'V', b'B', b'2'];
+
+// Field-elision flags: a set bit means the field is present on the wire,
+// a clear bit means the decoder fills in the default.
+const FLAG_CONFIRMED: u8 = 1 << 0;
+const FLAG_SCHEDULE_VERSION: u8 = 1 << 1;
+const FLAG_NEW_PRODUCERS: u8 = 1 << 2;
+const FLAG_HEADER_EXTENSIONS: u8 = 1 << 3;
+const FLAG_BLOCK_EXTENSIONS: u8 = 1 << 4;
+const FLAG_ALL: u8 = FLAG_CONFIRMED
+    | FLAG_SCHEDULE_VERSION
+    | FLAG_NEW_PRODUCERS
+    | FLAG_HEADER_EXTENSIONS
+    | FLAG_BLOCK_EXTENSIONS;
+
+/// True when the bytes carry the v2 magic and should go through
+/// [`decode`] instead of the v1 `Read` impl.
+#[inline]
+pub fn is_v2(bytes: &[u8]) -> bool {
+    bytes.len() > BLOCK_WIRE_V2_MAGIC.len()
+        && bytes[..BLOCK_WIRE_V2_MAGIC.len()] == BLOCK_WIRE_V2_MAGIC
+}
+
+/// Encodes a block in the v2 wire format.
+pub fn encode(block: &SignedBlock) -> Result<Vec<u8>, WriteError> {
+    let header = &block.signed_block_header.header;
+
+    let mut flags = 0u8;
+    if header.confirmed != 0 {
+        flags |= FLAG_CONFIRMED;
+    }
+    if header.schedule_version != 0 {
+        flags |= FLAG_SCHEDULE_VERSION;
+    }
+    if header.new_producers.is_some() {
+        flags |= FLAG_NEW_PRODUCERS;
+    }
+    if !header.header_extensions.is_empty() {
+        flags |= FLAG_HEADER_EXTENSIONS;
+    }
+    if !block.block_extensions.is_empty() {
+        flags |= FLAG_BLOCK_EXTENSIONS;
+    }
+
+    // v2 never exceeds v1 by more than the magic and flags byte.
+    let mut out = Vec::with_capacity(block.num_bytes() + BLOCK_WIRE_V2_MAGIC.len() + 1);
+    out.extend_from_slice(&BLOCK_WIRE_V2_MAGIC);
+    out.push(flags);
+    put(&mut out, &header.timestamp)?;
+    put(&mut out, &header.producer)?;
+    put(&mut out, &header.previous)?;
+    put(&mut out, &header.transaction_mroot)?;
+    put(&mut out, &header.action_mroot)?;
+    if header.confirmed != 0 {
+        put(&mut out, &VarUint32(header.confirmed as u32))?;
+    }
+    if header.schedule_version != 0 {
+        put(&mut out, &VarUint32(header.schedule_version))?;
+    }
+    if let Some(new_producers) = &header.new_producers {
+        put(&mut out, new_producers)?;
+    }
+    if !header.header_extensions.is_empty() {
+        put(&mut out, &header.header_extensions)?;
+    }
+    put(&mut out, &block.signed_block_header.signature)?;
+
+    put(&mut out, &VarUint32::from(block.transactions.len()))?;
+    let mut prev_cpu = 0u32;
+    for receipt in &block.transactions {
+        let receipt_header = receipt.header();
+        put(&mut out, &receipt_header.status)?;
+        // Wrapping difference reinterpreted as i32: total and invertible
+        // for any u32 pair, and small when consecutive receipts cost
+        // about the same. The transaction variant byte is elided — it is
+        // always 1 today and `TransactionReceipt::new` restores it.
+        put(
+            &mut out,
+            &VarInt32(receipt_header.cpu_usage_us.wrapping_sub(prev_cpu) as i32),
+        )?;
+        prev_cpu = receipt_header.cpu_usage_us;
+        put(&mut out, &receipt_header.net_usage_words)?;
+        put(&mut out, receipt.trx())?;
+    }
+    if !block.block_extensions.is_empty() {
+        put(&mut out, &block.block_extensions)?;
+    }
+    Ok(out)
+}
+
+/// Decodes a v2 payload into an owned block, unpacking and validating
+/// every transaction like the v1 `Read` impl does.
+pub fn decode(bytes: &[u8]) -> Result<SignedBlock, ReadError> {
+    let (signed_block_header, flags, pos) = decode_header(bytes)?;
+    decode_payload(signed_block_header, flags, &bytes[pos..])
+}
+
+/// Header-only decode of a v2 payload: the materialized signed header, the
+/// flags byte and the offset where the transaction section starts. The
+/// lazy-parse fast path (`LazyBlock`) records the rest of the buffer as
+/// undecoded bounds instead of walking the receipts.
+pub fn decode_header(bytes: &[u8]) -> Result<(SignedBlockHeader, u8, usize), ReadError> {
+    let mut pos = 0;
+    let (signed_block_header, flags) = read_signed_header(bytes, &mut pos)?;
+    Ok((signed_block_header, flags, pos))
+}
+
+/// Decodes the transaction section deferred by [`decode_header`], paying
+/// the per-transaction unpack and validation skipped at parse time.
+pub fn decode_payload(
+    signed_block_header: SignedBlockHeader,
+    flags: u8,
+    payload: &[u8],
+) -> Result<SignedBlock, ReadError> {
+    let mut pos = 0;
+    let count = VarUint32::read(payload, &mut pos)?.0 as usize;
+    let mut transactions = VecDeque::with_capacity(count);
+    let mut prev_cpu = 0u32;
+    for _ in 0..count {
+        let (receipt_header, cpu) = read_receipt_header(payload, &mut pos, prev_cpu)?;
+        prev_cpu = cpu;
+        let trx = PackedTransaction::read(payload, &mut pos)?;
+        transactions.push_back(TransactionReceipt::new(receipt_header, trx));
+    }
+
+    let block_extensions = if flags & FLAG_BLOCK_EXTENSIONS != 0 {
+        Vec::<(u16, Vec<u8>)>::read(payload, &mut pos)?
+    } else {
+        vec![]
+    };
+    Ok(SignedBlock {
+        signed_block_header,
+        transactions,
+        block_extensions,
+    })
+}
+
+/// Borrowed-view counterpart of [`decode`]: transaction payloads stay
+/// slices into the buffer, mirroring `SignedBlockRef::read_ref` for v1.
+pub fn decode_ref<'a>(bytes: &'a [u8]) -> Result<SignedBlockRef<'a>, ReadError> {
+    let mut pos = 0;
+    let (signed_block_header, flags) = read_signed_header(bytes, &mut pos)?;
+
+    let count = VarUint32::read(bytes, &mut pos)?.0 as usize;
+    let mut transactions = Vec::with_capacity(count);
+    let mut prev_cpu = 0u32;
+    for _ in 0..count {
+        let (receipt_header, cpu) = read_receipt_header(bytes, &mut pos, prev_cpu)?;
+        prev_cpu = cpu;
+        let trx = PackedTransactionRef::read_ref(bytes, &mut pos)?;
+        transactions.push(TransactionReceiptRef::new(receipt_header, trx));
+    }
+
+    let block_extensions = if flags & FLAG_BLOCK_EXTENSIONS != 0 {
+        Vec::<(u16, Vec<u8>)>::read(bytes, &mut pos)?
+    } else {
+        vec![]
+    };
+    Ok(SignedBlockRef {
+        signed_block_header,
+        transactions,
+        block_extensions,
+    })
+}
+
+fn read_signed_header(bytes: &[u8], pos: &mut usize) -> Result<(SignedBlockHeader, u8), ReadError> {
+    if !is_v2(bytes) {
+        return Err(ReadError::ParseError);
+    }
+    *pos += BLOCK_WIRE_V2_MAGIC.len();
+    let flags = u8::read(bytes, pos)?;
+    // Unknown flag bits mean a format newer than this decoder; refusing
+    // beats silently dropping fields a future version added.
+    if flags & !FLAG_ALL != 0 {
+        return Err(ReadError::ParseError);
+    }
+    let timestamp = BlockTimestamp::read(bytes, pos)?;
+    let producer = Name::read(bytes, pos)?;
+    let previous = Id::read(bytes, pos)?;
+    let transaction_mroot = Digest::read(bytes, pos)?;
+    let action_mroot = Digest::read(bytes, pos)?;
+    let confirmed = if flags & FLAG_CONFIRMED != 0 {
+        u16::try_from(VarUint32::read(bytes, pos)?.0).map_err(|_| ReadError::Overflow)?
+    } else {
+        0
+    };
+    let schedule_version = if flags & FLAG_SCHEDULE_VERSION != 0 {
+        VarUint32::read(bytes, pos)?.0
+    } else {
+        0
+    };
+    let new_producers = if flags & FLAG_NEW_PRODUCERS != 0 {
+        Some(Vec::<u8>::read(bytes, pos)?)
+    } else {
+        None
+    };
+    let header_extensions = if flags & FLAG_HEADER_EXTENSIONS != 0 {
+        Vec::<(u16, Vec<u8>)>::read(bytes, pos)?
+    } else {
+        vec![]
+    };
+    let signature = Signature::read(bytes, pos)?;
+    Ok((
+        SignedBlockHeader {
+            header: BlockHeader {
+                timestamp,
+                producer,
+                confirmed,
+                previous,
+                transaction_mroot,
+                action_mroot,
+                schedule_version,
+                new_producers,
+                header_extensions,
+            },
+            signature,
+        },
+        flags,
+    ))
+}
+
+fn read_receipt_header(
+    bytes: &[u8],
+    pos: &mut usize,
+    prev_cpu: u32,
+) -> Result<(TransactionReceiptHeader, u32), ReadError> {
+    let status = TransactionStatus::read(bytes, pos)?;
+    let cpu_usage_us = prev_cpu.wrapping_add(VarInt32::read(bytes, pos)?.0 as u32);
+    let net_usage_words = VarUint32::read(bytes, pos)?;
+    Ok((
+        TransactionReceiptHeader::new(status, cpu_usage_us, net_usage_words),
+        cpu_usage_us,
+    ))
+}
+
+fn put<T: Write + NumBytes>(out: &mut Vec<u8>, value: &T) -> Result<(), WriteError> {
+    let mut pos = out.len();
+    out.resize(pos + value.num_bytes(), 0);
+    value.write(out, &mut pos)?;
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::chain::transaction::SignedTransaction;
+
+    fn sample_block() -> SignedBlock {
+        let mut block = SignedBlock::default();
+        for cpu in [1500u32, 1480, 2100] {
+            let trx = PackedTransaction::from_signed_transaction(SignedTransaction::default())
+                .unwrap();
+            block.transactions.push_back(TransactionReceipt::new(
+                TransactionReceiptHeader::new(TransactionStatus::Executed, cpu, VarUint32(12)),
+                trx,
+            ));
+        }
+        block
+    }
+
+    #[test]
+    fn round_trips_and_elides_defaults() {
+        let block = sample_block();
+        let wire = encode(&block).unwrap();
+        assert!(is_v2(&wire));
+        // Everything behind the flags byte is at its default, and the
+        // elision plus varints more than pay for the magic prefix.
+        assert_eq!(wire[BLOCK_WIRE_V2_MAGIC.len()], 0);
+        assert!(wire.len() < block.pack().unwrap().len());
+
+        let decoded = decode(&wire).unwrap();
+        assert_eq!(decoded.pack().unwrap(), block.pack().unwrap());
+        assert_eq!(decoded.id().unwrap(), block.id().unwrap());
+
+        let decoded_ref = decode_ref(&wire).unwrap();
+        assert_eq!(
+            decoded_ref.into_owned().unwrap().pack().unwrap(),
+            block.pack().unwrap()
+        );
+    }
+
+    #[test]
+    fn round_trips_non_default_header_fields() {
+        let mut block = sample_block();
+        block.signed_block_header.header.confirmed = 3;
+        block.signed_block_header.header.schedule_version = 7;
+        block.signed_block_header.header.new_producers = Some(vec![1, 2, 3]);
+        block.signed_block_header.header.header_extensions = vec![(1, vec![9])];
+        block.block_extensions = vec![(2, vec![8, 8])];
+
+        let wire = encode(&block).unwrap();
+        assert_eq!(wire[BLOCK_WIRE_V2_MAGIC.len()], FLAG_ALL);
+        let decoded = decode(&wire).unwrap();
+        assert_eq!(decoded.pack().unwrap(), block.pack().unwrap());
+    }
+
+    #[test]
+    fn v1_bytes_are_not_mistaken_for_v2() {
+        let block = sample_block();
+        let packed = block.pack().unwrap();
+        assert!(!is_v2(&packed));
+        assert!(decode(&packed).is_err());
+    }
+
+    #[test]
+    fn lazy_block_defers_payload_decode() {
+        use crate::chain::block::LazyBlock;
+
+        let block = sample_block();
+        for wire in [block.pack().unwrap(), encode(&block).unwrap()] {
+            let lazy = LazyBlock::from_wire(&wire).unwrap();
+            assert_eq!(lazy.id().unwrap(), block.id().unwrap());
+            assert_eq!(lazy.block_num(), block.block_num());
+            assert_eq!(
+                lazy.decode_payload().unwrap().pack().unwrap(),
+                block.pack().unwrap()
+            );
+        }
+    }
+
+    #[test]
+    fn rejects_unknown_flag_bits() {
+        let mut wire = encode(&sample_block()).unwrap();
+        wire[BLOCK_WIRE_V2_MAGIC.len()] |= 1 << 7;
+        assert!(decode(&wire).is_err());
+    }
+}
@@ -0,0 +1,206 @@
+use std::{
+    collections::HashMap,
+    num::NonZeroUsize,
+    sync::{
+        Arc, Mutex, OnceLock,
+        atomic::{AtomicU32, Ordering},
+        mpsc::{Receiver, SyncSender, sync_channel},
+    },
+    thread::JoinHandle,
+};
+
+use lru::LruCache;
+
+use crate::chain::{block::SignedBlock, state_history::StateHistoryLog};
+
+/// Decoded blocks kept around; sized for the ranges explorers page through,
+/// a few screens of history at a time.
+const BLOCK_CACHE_CAPACITY: usize = 256;
+/// Blocks read and decoded ahead of a detected sequential scan.
+const PREFETCH_DEPTH: u32 = 32;
+/// Blocks within this distance of the head stay in a hot set that scan
+/// traffic cannot evict; syncing peers cluster their requests here.
+const HOT_WINDOW: u32 = 64;
+
+/// Decode cache with readahead for block-log lookups.
+///
+/// `get_block_by_height` used to read and deserialize a full `SignedBlock`
+/// per call, so an explorer scanning a range paid the decode cost serially
+/// on every request. Decoded blocks are immutable once in the log, so they
+/// are cached in an LRU, and when two lookups arrive for consecutive
+/// heights the next `PREFETCH_DEPTH` blocks are read and decoded on a
+/// background thread, keeping the scan ahead of the requester.
+///
+/// Misses are coalesced: concurrent lookups for the same height share one
+/// log read and decode instead of each doing their own, which is the common
+/// case while several peers sync the same recent range. Blocks within
+/// `HOT_WINDOW` of the head live in a separate hot set so a long historical
+/// scan cannot evict the blocks sync traffic is about to ask for.
+pub struct BlockCache {
+    block_log: Arc<StateHistoryLog>,
+    cache: Arc<Mutex<LruCache<u32, SignedBlock>>>,
+    // Recent blocks near the head, exempt from LRU eviction.
+    hot: Mutex<HashMap<u32, SignedBlock>>,
+    head_height: AtomicU32,
+    // One cell per height being loaded; followers block on the leader's
+    // `OnceLock` instead of issuing their own read.
+    in_flight: Mutex<HashMap<u32, Arc<OnceLock<Option<SignedBlock>>>>>,
+    // Height of the most recent lookup, for sequential-access detection.
+    last_height: AtomicU32,
+    tx: Option<SyncSender<u32>>,
+    handle: Option<JoinHandle<()>>,
+}
+
+impl BlockCache {
+    pub fn spawn(block_log: Arc<StateHistoryLog>) -> Self {
+        let cache = Arc::new(Mutex::new(LruCache::new(
+            NonZeroUsize::new(BLOCK_CACHE_CAPACITY).unwrap(),
+        )));
+        // Depth 1: a scan only ever needs one prefetch batch in flight, and
+        // requests arriving while the worker is busy are simply dropped —
+        // the next lookup re-detects the pattern.
+        let (tx, rx) = sync_channel(1);
+        let worker_log = block_log.clone();
+        let worker_cache = cache.clone();
+        let handle = std::thread::Builder::new()
+            .name("block-prefetch".to_string())
+            .spawn(move || prefetch_loop(worker_log, worker_cache, rx))
+            .expect("failed to spawn block prefetch thread");
+        BlockCache {
+            block_log,
+            cache,
+            hot: Mutex::new(HashMap::new()),
+            head_height: AtomicU32::new(0),
+            in_flight: Mutex::new(HashMap::new()),
+            last_height: AtomicU32::new(u32::MAX),
+            tx: Some(tx),
+            handle: Some(handle),
+        }
+    }
+
+    /// Returns the cached block for `height` if present, and triggers
+    /// readahead when this lookup continues a sequential scan. Call on every
+    /// lookup, hit or miss, so the detection sees the full access pattern.
+    pub fn lookup(&self, height: u32) -> Option<SignedBlock> {
+        let previous = self.last_height.swap(height, Ordering::Relaxed);
+        if previous != u32::MAX && height == previous.wrapping_add(1) {
+            if let Some(tx) = &self.tx {
+                // Best effort: a full channel means the worker is already
+                // prefetching this neighborhood.
+                let _ = tx.try_send(height + 1);
+            }
+        }
+        if let Ok(hot) = self.hot.lock() {
+            if let Some(block) = hot.get(&height) {
+                return Some(block.clone());
+            }
+        }
+        match self.cache.lock() {
+            Ok(mut cache) => cache.get(&height).cloned(),
+            Err(_) => None, // treat a poisoned cache as empty
+        }
+    }
+
+    /// Reads and decodes `height` from the block log, coalescing concurrent
+    /// misses: the first caller does the work while later callers for the
+    /// same height block on its result. `None` means the height is not in
+    /// the log. The decoded block is left in the cache.
+    pub fn load(&self, height: u32) -> Option<SignedBlock> {
+        let cell = match self.in_flight.lock() {
+            Ok(mut in_flight) => in_flight
+                .entry(height)
+                .or_insert_with(|| Arc::new(OnceLock::new()))
+                .clone(),
+            // Poisoned flight table: skip coalescing and read directly.
+            Err(_) => return self.read_and_decode(height),
+        };
+        let block = cell.get_or_init(|| self.read_and_decode(height)).clone();
+        if let Ok(mut in_flight) = self.in_flight.lock() {
+            // Only the cell this load went through; a later load may have
+            // started a fresh one for the same height already.
+            if in_flight.get(&height).is_some_and(|c| Arc::ptr_eq(c, &cell)) {
+                in_flight.remove(&height);
+            }
+        }
+        if let Some(block) = &block {
+            self.insert(height, block.clone());
+        }
+        block
+    }
+
+    /// Stores a block decoded by the caller on a cache miss. Blocks near the
+    /// head go to the hot set, everything else to the LRU.
+    pub fn insert(&self, height: u32, block: SignedBlock) {
+        let head = self.head_height.load(Ordering::Relaxed);
+        if height.saturating_add(HOT_WINDOW) >= head {
+            if let Ok(mut hot) = self.hot.lock() {
+                hot.insert(height, block);
+                return;
+            }
+        }
+        if let Ok(mut cache) = self.cache.lock() {
+            cache.put(height, block);
+        }
+    }
+
+    /// Advances the head height and demotes hot entries that fell out of the
+    /// window into the LRU. Called on every accepted block.
+    pub fn set_head(&self, height: u32) {
+        self.head_height.store(height, Ordering::Relaxed);
+        let floor = height.saturating_sub(HOT_WINDOW);
+        if let Ok(mut hot) = self.hot.lock() {
+            let demoted: Vec<u32> = hot.keys().filter(|h| **h < floor).copied().collect();
+            for height in demoted {
+                if let Some(block) = hot.remove(&height) {
+                    if let Ok(mut cache) = self.cache.lock() {
+                        cache.put(height, block);
+                    }
+                }
+            }
+        }
+    }
+
+    fn read_and_decode(&self, height: u32) -> Option<SignedBlock> {
+        // A read past the log's end is a miss; the caller reports it as an
+        // unknown block.
+        let bytes = self.block_log.read_block(height).ok()?;
+        SignedBlock::from_wire(bytes.as_slice()).ok()
+    }
+}
+
+impl Drop for BlockCache {
+    fn drop(&mut self) {
+        // Closing the channel stops the worker after its current batch.
+        self.tx.take();
+        if let Some(handle) = self.handle.take() {
+            let _ = handle.join();
+        }
+    }
+}
+
+fn prefetch_loop(
+    block_log: Arc<StateHistoryLog>,
+    cache: Arc<Mutex<LruCache<u32, SignedBlock>>>,
+    rx: Receiver<u32>,
+) {
+    while let Ok(start) = rx.recv() {
+        for height in start..start.saturating_add(PREFETCH_DEPTH) {
+            if let Ok(mut cache) = cache.lock() {
+                if cache.contains(&height) {
+                    continue;
+                }
+            }
+            // Past the log's end or unreadable: stop this batch quietly, the
+            // foreground path reports errors to the caller.
+            let Ok(bytes) = block_log.read_block(height) else {
+                break;
+            };
+            let Ok(block) = SignedBlock::from_wire(bytes.as_slice()) else {
+                break;
+            };
+            if let Ok(mut cache) = cache.lock() {
+                cache.put(height, block);
+            }
+        }
+    }
+}
@@ -0,0 +1,256 @@
+use std::{
+    collections::HashMap,
+    sync::{
+        LazyLock, Mutex,
+        atomic::{AtomicBool, AtomicU64, Ordering},
+    },
+    time::Duration,
+};
+
+use crate::chain::name::Name;
+
+// Log2 microsecond buckets: bucket i holds actions that took [2^(i-1), 2^i)
+// microseconds, with the last bucket absorbing everything above ~half an
+// hour. Recording is one clock subtraction and one relaxed increment.
+const HISTOGRAM_BUCKETS: usize = 32;
+
+// Distinct (receiver, contract, action) spans kept while profiling is
+// enabled. Past the cap new span keys are dropped rather than evicting
+// existing ones, so a long capture cannot grow without bound.
+const FOLDED_CAPACITY: usize = 4096;
+
+/// Process-wide execution profiler fed from `ApplyContext::exec_one`.
+///
+/// The percentile histogram is always on: it is a fixed array of relaxed
+/// atomics, cheap enough to pay on every action. The per-span aggregation
+/// behind flamegraph export is gated on the `profile_actions` node config
+/// flag and folds each action into a `receiver;contract::action` stack with
+/// the time spent inside the wasm instance split out as a child frame, in
+/// the collapsed-stack text format flamegraph tooling consumes directly.
+pub static BLOCK_PROFILER: LazyLock<BlockProfiler> = LazyLock::new(BlockProfiler::new);
+
+#[derive(Clone, Copy, PartialEq, Eq, Hash)]
+struct SpanKey {
+    receiver: u64,
+    account: u64,
+    action: u64,
+}
+
+#[derive(Default)]
+struct SpanStats {
+    count: u64,
+    total_us: u64,
+    wasm_us: u64,
+}
+
+pub struct BlockProfiler {
+    enabled: AtomicBool,
+    buckets: [AtomicU64; HISTOGRAM_BUCKETS],
+    spans: Mutex<HashMap<SpanKey, SpanStats>>,
+}
+
+/// Point-in-time view served over RPC.
+pub struct ProfileSnapshot {
+    pub actions: u64,
+    pub p50_us: u64,
+    pub p95_us: u64,
+    pub p99_us: u64,
+    pub folded: String,
+}
+
+impl BlockProfiler {
+    fn new() -> Self {
+        Self {
+            enabled: AtomicBool::new(false),
+            buckets: [const { AtomicU64::new(0) }; HISTOGRAM_BUCKETS],
+            spans: Mutex::new(HashMap::new()),
+        }
+    }
+
+    pub fn set_enabled(&self, enabled: bool) {
+        self.enabled.store(enabled, Ordering::Relaxed);
+    }
+
+    pub fn is_enabled(&self) -> bool {
+        self.enabled.load(Ordering::Relaxed)
+    }
+
+    pub fn record_action(
+        &self,
+        receiver: &Name,
+        account: &Name,
+        action: &Name,
+        total: Duration,
+        wasm: Duration,
+    ) {
+        let total_us = total.as_micros() as u64;
+        self.buckets[Self::bucket_for(total_us)].fetch_add(1, Ordering::Relaxed);
+
+        if !self.is_enabled() {
+            return;
+        }
+
+        let key = SpanKey {
+            receiver: receiver.as_u64(),
+            account: account.as_u64(),
+            action: action.as_u64(),
+        };
+        let Ok(mut spans) = self.spans.lock() else {
+            return; // a poisoned capture just stops aggregating
+        };
+        if spans.len() >= FOLDED_CAPACITY && !spans.contains_key(&key) {
+            return;
+        }
+        let stats = spans.entry(key).or_default();
+        stats.count += 1;
+        stats.total_us += total_us;
+        stats.wasm_us += wasm.as_micros() as u64;
+    }
+
+    /// Collapsed-stack lines, one per frame, weighted in microseconds. The
+    /// wasm time appears as a child frame so the flamegraph separates guest
+    /// execution from native apply/intrinsic overhead.
+    pub fn export_folded(&self) -> String {
+        let Ok(spans) = self.spans.lock() else {
+            return String::new();
+        };
+        let mut lines: Vec<String> = Vec::with_capacity(spans.len() * 2);
+        for (key, stats) in spans.iter() {
+            let stack = format!(
+                "{};{}::{}",
+                Name::new(key.receiver),
+                Name::new(key.account),
+                Name::new(key.action)
+            );
+            let native_us = stats.total_us.saturating_sub(stats.wasm_us);
+            lines.push(format!("{} {}", stack, native_us));
+            if stats.wasm_us > 0 {
+                lines.push(format!("{};wasm {}", stack, stats.wasm_us));
+            }
+        }
+        lines.sort();
+        let mut out = lines.join("\n");
+        if !out.is_empty() {
+            out.push('\n');
+        }
+        out
+    }
+
+    pub fn snapshot(&self) -> ProfileSnapshot {
+        let counts: Vec<u64> = self
+            .buckets
+            .iter()
+            .map(|b| b.load(Ordering::Relaxed))
+            .collect();
+        let actions: u64 = counts.iter().sum();
+        ProfileSnapshot {
+            actions,
+            p50_us: Self::percentile(&counts, actions, 0.50),
+            p95_us: Self::percentile(&counts, actions, 0.95),
+            p99_us: Self::percentile(&counts, actions, 0.99),
+            folded: self.export_folded(),
+        }
+    }
+
+    /// Drops the folded capture and zeroes the histogram, for bracketing a
+    /// capture window around an incident.
+    pub fn reset(&self) {
+        if let Ok(mut spans) = self.spans.lock() {
+            spans.clear();
+        }
+        for bucket in &self.buckets {
+            bucket.store(0, Ordering::Relaxed);
+        }
+    }
+
+    fn bucket_for(us: u64) -> usize {
+        ((64 - us.leading_zeros()) as usize).min(HISTOGRAM_BUCKETS - 1)
+    }
+
+    // Upper bound of the bucket the requested quantile lands in; with log2
+    // buckets the answer is within 2x of the true latency, which is enough
+    // to tell a 200µs action path from a 20ms one.
+    fn percentile(counts: &[u64], total: u64, quantile: f64) -> u64 {
+        if total == 0 {
+            return 0;
+        }
+        let rank = ((total as f64) * quantile).ceil() as u64;
+        let mut seen = 0u64;
+        for (i, count) in counts.iter().enumerate() {
+            seen += count;
+            if seen >= rank {
+                return if i == 0 { 0 } else { 1u64 << i };
+            }
+        }
+        1u64 << (HISTOGRAM_BUCKETS - 1)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use std::str::FromStr;
+
+    fn make_profiler() -> BlockProfiler {
+        BlockProfiler::new()
+    }
+
+    #[test]
+    fn test_percentiles_from_histogram() {
+        let profiler = make_profiler();
+        let name = Name::new(name!("alice"));
+        for _ in 0..99 {
+            profiler.record_action(
+                &name,
+                &name,
+                &name,
+                Duration::from_micros(100),
+                Duration::ZERO,
+            );
+        }
+        profiler.record_action(
+            &name,
+            &name,
+            &name,
+            Duration::from_micros(50_000),
+            Duration::ZERO,
+        );
+        let snapshot = profiler.snapshot();
+        assert_eq!(snapshot.actions, 100);
+        // 100µs lands in the (64, 128] bucket; the stray 50ms action only
+        // surfaces at the very top of the distribution.
+        assert_eq!(snapshot.p50_us, 128);
+        assert_eq!(snapshot.p95_us, 128);
+        assert!(snapshot.p99_us <= 128);
+    }
+
+    #[test]
+    fn test_folded_export_gated_on_enabled() {
+        let profiler = make_profiler();
+        let receiver = Name::new(name!("alice"));
+        let contract = Name::new(name!("token"));
+        let action = Name::new(name!("transfer"));
+
+        profiler.record_action(
+            &receiver,
+            &contract,
+            &action,
+            Duration::from_micros(300),
+            Duration::from_micros(200),
+        );
+        assert!(profiler.export_folded().is_empty());
+
+        profiler.set_enabled(true);
+        profiler.record_action(
+            &receiver,
+            &contract,
+            &action,
+            Duration::from_micros(300),
+            Duration::from_micros(200),
+        );
+        let folded = profiler.export_folded();
+        assert!(folded.contains("alice;token::transfer 100\n"));
+        assert!(folded.contains("alice;token::transfer;wasm 200\n"));
+    }
+}
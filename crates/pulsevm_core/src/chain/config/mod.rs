@@ -1,5 +1,5 @@
 mod node_config;
-pub use node_config::NodeConfig;
+pub use node_config::{DbMapMode, NodeConfig};
 
 use crate::name::Name;
 use pulsevm_constants::PERCENT_100;
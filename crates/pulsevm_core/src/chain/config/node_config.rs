@@ -12,8 +12,140 @@ pub struct NodeConfig {
     // Size of the memory mapped database in bytes
     #[serde(default = "default_db_size")]
     pub db_size: u64,
+    // Optimistic concurrency mode for block building: transactions that fail
+    // speculative execution while overlapping state another transaction
+    // already touched are retried once at the end of the block instead of
+    // being dropped outright
+    #[serde(default)]
+    pub occ_mode: bool,
+    // Collect per-action execution spans (receiver, contract, action, wasm
+    // time) into the flamegraph-exportable capture served over
+    // `pulsevm.getExecutionProfile`; the percentile histogram behind the same
+    // endpoint is always on regardless of this flag
+    #[serde(default)]
+    pub profile_actions: bool,
+    // How chainbase maps the state database file into memory: "mapped" (plain
+    // shared mmap, the default), "mapped_private" (copy-on-write, written back
+    // at exit), "heap" (copied at startup into an anonymous hugepage-backed
+    // mapping) or "locked" (heap plus mlock)
+    #[serde(default)]
+    pub db_map_mode: DbMapMode,
+    // Interleave the database mapping across all NUMA nodes instead of letting
+    // pages pile up on whichever node first touches them; only affects
+    // anonymous and copy-on-write pages, so pair it with a non-"mapped" mode
+    #[serde(default)]
+    pub db_numa_interleave: bool,
+    // CPUs the execution worker threads pin to, e.g. one socket's cores on
+    // a dual-socket validator. Workers stripe over the list by index, and
+    // first-touch then keeps wasm memories and warm database pages local
+    // to that package. Empty or absent means no pinning
+    #[serde(default)]
+    pub exec_cpu_affinity: Option<Vec<usize>>,
+    // Path to a full state snapshot to restore from when the node starts
+    // without an existing state database; blocks accepted after the snapshot
+    // was taken are caught up from the block log
+    #[serde(default)]
+    pub snapshot_restore_path: Option<String>,
+    // Differential snapshot applied on top of the restored full snapshot;
+    // must have been built against that same full snapshot
+    #[serde(default)]
+    pub snapshot_restore_delta_path: Option<String>,
+    // Durability window for the state-history group commit, in milliseconds.
+    // Appends are flushed immediately but fsynced at most once per window
+    // across the block, trace and chain-state logs; 0 (the default) syncs
+    // after every drained batch. A crash loses at most the window's tail,
+    // which is truncated on the next start
+    #[serde(default)]
+    pub sh_sync_window_ms: u64,
+    // Append state-history log entries through io_uring: the entry write,
+    // its fsync and the index record go to the kernel as one linked
+    // submission instead of separate syscalls. Linux only; falls back to
+    // buffered appends (with a startup warning) when the ring cannot be
+    // set up, so it is safe to enable everywhere
+    #[serde(default)]
+    pub sh_io_uring: bool,
+    // Keep at most this many recent blocks in the hot block log. At
+    // startup, older entries are migrated into immutable archive
+    // segments under the cold directory and served from there
+    // transparently; unset means the block log stays single-tier
+    #[serde(default)]
+    pub block_log_hot_blocks: Option<u32>,
+    // Where the cold block-log segments live; defaults to "cold" inside
+    // the database directory. Point it at cheap storage — a second
+    // disk, NFS, an object-store mount — only the per-block index stays
+    // on the hot tier
+    #[serde(default)]
+    pub block_log_cold_dir: Option<String>,
+    // Keep full transaction traces for at most this many recent blocks.
+    // Older trace-log entries are incrementally rewritten into reduced
+    // segments under the cold directory — receipts and RAM deltas stay,
+    // action inputs, console output and return values go — a bounded
+    // batch per accepted block, so retention never pays one big rewrite.
+    // Unset keeps every trace in full forever
+    #[serde(default)]
+    pub trace_log_full_blocks: Option<u32>,
+    // When set, a snapshot of the state database is written to this path on
+    // clean shutdown, once the database file has been flushed and closed
+    #[serde(default)]
+    pub snapshot_write_path: Option<String>,
+    // Full snapshot to diff against when writing the shutdown snapshot: with
+    // this set the write produces a differential snapshot containing only
+    // the chunks changed since that base, instead of a full image
+    #[serde(default)]
+    pub snapshot_delta_base_path: Option<String>,
+    // Byte budget for the in-memory compiled wasm module cache. Entries are
+    // weighted by module size, so one huge contract no longer counts the
+    // same as a thousand small ones; past the budget the least recently
+    // used modules are evicted, with frequently dispatched ones protected
+    #[serde(default = "default_wasm_cache_max_bytes")]
+    pub wasm_cache_max_bytes: u64,
+    // Emit blocks in the compact v2 wire format (varints, default-field
+    // elision) instead of the v1 pack. Decoding always accepts both formats
+    // — v2 payloads are self-identifying — so this only controls what this
+    // node writes to gossip and its block log; leave it off until every
+    // peer in the fleet decodes v2
+    #[serde(default)]
+    pub block_wire_v2: bool,
+    // Collective byte budget for the peer-driven buffers the node memory
+    // ledger tracks: fork-store resident blocks, in-flight gossip block
+    // decodes and the state-history writer queue. Past the budget, block
+    // decodes are refused (the consensus engine redelivers) and heavy RPC
+    // requests are shed with a retryable overload error, instead of the
+    // buffers growing until the kernel OOM-kills the node. 0 disables
+    // the cap
+    #[serde(default = "default_memory_budget_bytes")]
+    pub memory_budget_bytes: u64,
+}
+
+#[derive(Debug, Clone, Copy, Default, Deserialize)]
+#[serde(rename_all = "snake_case")]
+pub enum DbMapMode {
+    #[default]
+    Mapped,
+    MappedPrivate,
+    Heap,
+    Locked,
+}
+
+impl From<DbMapMode> for pulsevm_ffi::DbMapMode {
+    fn from(mode: DbMapMode) -> Self {
+        match mode {
+            DbMapMode::Mapped => pulsevm_ffi::DbMapMode::Mapped,
+            DbMapMode::MappedPrivate => pulsevm_ffi::DbMapMode::MappedPrivate,
+            DbMapMode::Heap => pulsevm_ffi::DbMapMode::Heap,
+            DbMapMode::Locked => pulsevm_ffi::DbMapMode::Locked,
+        }
+    }
 }
 
 fn default_db_size() -> u64 {
     20 * 1024 * 1024 * 1024 // 20 GB
 }
+
+fn default_wasm_cache_max_bytes() -> u64 {
+    1024 * 1024 * 1024 // 1 GB
+}
+
+fn default_memory_budget_bytes() -> u64 {
+    2 * 1024 * 1024 * 1024 // 2 GB
+}
@@ -1,34 +1,59 @@
 use core::fmt;
 use std::{
     collections::{BTreeSet, HashMap, HashSet, VecDeque},
-    sync::LazyLock,
+    path::{Path, PathBuf},
+    sync::{Arc, RwLock},
+    time::{Duration, Instant},
 };
 
 use crate::{
     PULSE_NAME,
-    block::{BlockStatus, SignedBlock},
+    block::{BlockStatus, LazyBlock, SignedBlock, SignedBlockRef},
     chain::{
         apply_context::ApplyContext,
         authorization_manager::AuthorizationManager,
-        block::BlockHeader,
+        block::{BlockHeader, wire_v2},
         config::{
             DELETEAUTH_NAME, LINKAUTH_NAME, NEWACCOUNT_NAME, SETABI_NAME, SETCODE_NAME,
             UNLINKAUTH_NAME, UPDATEAUTH_NAME, eos_percent,
         },
+        cpu_affinity,
+        db_flusher::DbFlusher,
+        accepted_tx_filter::AcceptedTxFilter,
+        block_profiler::BLOCK_PROFILER,
+        exec_phases::{EXEC_PHASES, Phase},
+        execution_accounting::EXEC_ACCOUNTING,
+        execution_schedule::{ExecutionSchedule, transaction_footprint},
+        fork_store::ForkStore,
         id::Id,
+        block_cache::BlockCache,
+        memory_ledger::MEMORY_LEDGER,
         mempool::Mempool,
+        metrics::METRICS,
         name::Name,
         pulse_contract::{
             deleteauth, linkauth, newaccount, setabi, setcode, unlinkauth, updateauth,
         },
+        recovery_cache::RecoveryCache,
         resource_limits::ResourceLimitsManager,
-        state_history::StateHistoryLog,
-        transaction::{PackedTransaction, TransactionReceipt, TransactionTrace},
+        sequence_counters::SequenceCounters,
+        snapshot,
+        state_diff::STATE_DIFF_HUB,
+        state_history::{
+            AccountActionIndex, ShIoBackend, StateHistoryLog, StateHistoryWriter,
+            TransactionTraceIndex,
+        },
+        tapos_ring::TaposRing,
+        transaction::{
+            ActionTrace, PackedTransaction, SignedTransaction, Transaction, TransactionReceipt,
+            TransactionTrace,
+        },
         transaction_context::{TransactionContext, TransactionResult},
         utils::make_ratio,
         wasm_runtime::WasmRuntime,
     },
     config::NodeConfig,
+    crypto::{InProcessSigningProvider, PublicKey, SigningProvider},
     transaction::Action,
 };
 
@@ -36,48 +61,237 @@ use pulsevm_constants::{
     BLOCK_CPU_USAGE_AVERAGE_WINDOW_MS, BLOCK_INTERVAL_MS, BLOCK_SIZE_AVERAGE_WINDOW_MS,
     MAXIMUM_ELASTIC_RESOURCE_MULTIPLIER,
 };
-use pulsevm_crypto::{Digest, merkle};
+use pulsevm_crypto::{Digest, IncrementalMerkle, merkle_parallel};
 use pulsevm_error::ChainError;
+use cxx::UniquePtr;
 use pulsevm_ffi::{
     BlockTimestamp, CxxGenesisState, Database, ElasticLimitParameters, GlobalPropertyObject,
-    TimePoint, seconds,
+    TimePoint, UndoSession, ffi_stats::FFI_STATS, seconds,
 };
 use pulsevm_grpc::vm;
 use pulsevm_serialization::{Read, Write};
 use spdlog::{debug, error, info, warn};
+use tokio::sync::broadcast;
 
 pub type ApplyHandlerFn = fn(&mut ApplyContext, &mut Database, &Action) -> Result<(), ChainError>;
-pub type ApplyHandlerMap = HashMap<
-    (Name, Name, Name), // (receiver, contract, action)
-    ApplyHandlerFn,
->;
-
-pub static APPLY_HANDLERS: LazyLock<ApplyHandlerMap> = LazyLock::new(|| {
-    let mut m: ApplyHandlerMap = HashMap::new();
-    m.insert((PULSE_NAME, PULSE_NAME, NEWACCOUNT_NAME), newaccount);
-    m.insert((PULSE_NAME, PULSE_NAME, SETCODE_NAME), setcode);
-    m.insert((PULSE_NAME, PULSE_NAME, SETABI_NAME), setabi);
-    m.insert((PULSE_NAME, PULSE_NAME, UPDATEAUTH_NAME), updateauth);
-    m.insert((PULSE_NAME, PULSE_NAME, DELETEAUTH_NAME), deleteauth);
-    m.insert((PULSE_NAME, PULSE_NAME, LINKAUTH_NAME), linkauth);
-    m.insert((PULSE_NAME, PULSE_NAME, UNLINKAUTH_NAME), unlinkauth);
-    m
-});
+
+/// Shared handle to the last accepted block and its id, published by the
+/// controller on every head change so readers (the RPC layer) can serve
+/// head-dependent queries without taking the controller lock.
+pub type HeadBlockHandle = Arc<RwLock<(SignedBlock, Id)>>;
+
+/// Read-only view over every block the node can serve: verified-but-
+/// unaccepted blocks, the accepted head, and the decoded-block cache over
+/// the block log. Cloned out of the controller at initialization so the
+/// gRPC block-fetch handlers (GetBlock, GetAncestors, GetBlockIdAtHeight)
+/// answer without the controller lock, which verification and acceptance
+/// hold for their whole duration — consensus read bursts no longer queue
+/// behind state transitions.
+#[derive(Clone)]
+pub struct BlockReadHandle {
+    verified: Arc<RwLock<ForkStore>>,
+    head: HeadBlockHandle,
+    cache: Arc<BlockCache>,
+    // Snapshot of `NodeConfig::block_wire_v2` at handle creation, so the
+    // lock-free fetch handlers emit the same wire format the controller does.
+    wire_v2: bool,
+}
+
+impl BlockReadHandle {
+    pub fn get_block_by_height(&self, height: u32) -> Result<Option<SignedBlock>, ChainError> {
+        {
+            let head = self.head.read()?;
+            if height == head.0.block_num() {
+                return Ok(Some(head.0.clone()));
+            }
+        }
+
+        // The lookup also feeds the cache's sequential-scan detection, so it
+        // runs on every call whether or not it hits.
+        if let Some(block) = self.cache.lookup(height) {
+            return Ok(Some(block));
+        }
+        Ok(self.cache.load(height))
+    }
+
+    pub fn get_block(&self, id: &Id) -> Result<Option<SignedBlock>, ChainError> {
+        if let Some(block) = self.verified.read()?.get(id)? {
+            return Ok(Some(block));
+        }
+
+        self.get_block_by_height(BlockHeader::num_from_id(id))
+    }
+
+    /// Same format selection as [`Controller::pack_block`].
+    pub fn pack_block(&self, block: &SignedBlock) -> Result<Vec<u8>, ChainError> {
+        if self.wire_v2 {
+            wire_v2::encode(block)
+                .map_err(|e| ChainError::SerializationError(format!("failed to pack block: {}", e)))
+        } else {
+            block
+                .pack()
+                .map_err(|e| ChainError::SerializationError(format!("failed to pack block: {}", e)))
+        }
+    }
+}
+
+// Upper bound on expired dedup entries swept per block. The sweep runs inside
+// the block's undo session, so it is consensus state: with a fixed quota and
+// the ordered by_expiration index every validator removes the same oldest
+// entries at a given block, and an expiry storm drains over subsequent blocks
+// instead of adding unbounded time to one of them.
+const EXPIRED_TX_SWEEP_PER_BLOCK: u32 = 1000;
+
+// Metering budget for a read-only view call. Generous compared to what a
+// sensible view function needs, but bounded, because these calls run outside
+// the chain's billing machinery and are never charged to an account.
+const READ_ONLY_CALL_CPU_LIMIT: i64 = 50_000_000;
+
+// Largest share of the block CPU budget one first authorizer may bill inside
+// a single block, in percent. This is subjective, producer-local policy (it
+// affects which transactions we pack, never their validity): a single
+// account's burst gets spread over several blocks instead of consuming a
+// whole interval and pushing everyone else's transactions out.
+const ACCOUNT_BLOCK_CPU_PCT: u64 = 25;
+
+// Buffered accepted blocks per subscriber on the block broadcast channel.
+// A subscriber that falls this far behind starts losing events (broadcast
+// drops the oldest) and must resync through `get_block`; acceptance itself
+// never waits on a slow consumer.
+const BLOCK_BROADCAST_CAPACITY: usize = 64;
+
+/// One accepted block as published on the block broadcast. The block and
+/// its execution traces both ride behind an `Arc` — the traces are the
+/// same allocation handed to the state-history writer — so hanging
+/// another consumer off the channel costs reference counts, not copies.
+#[derive(Clone)]
+pub struct AcceptedBlockEvent {
+    pub block_id: Id,
+    pub block: Arc<SignedBlock>,
+    pub traces: Arc<Vec<TransactionTrace>>,
+}
+
+/// A block under speculative construction. Transactions are executed into
+/// `session` as they arrive (see [`Controller::pump_pending_block`]), so
+/// when the block interval fires, sealing is just merkle roots and a
+/// signature instead of a full execution pass over the mempool.
+struct PendingBlock {
+    session: UniquePtr<UndoSession>,
+    // Preferred id this block builds on; a preference change makes the
+    // speculative work stale and the pending block is abandoned.
+    base_id: Id,
+    timestamp: BlockTimestamp,
+    transaction_receipts: VecDeque<TransactionReceipt>,
+    action_mroot: IncrementalMerkle,
+    applied_footprint: HashSet<u64>,
+    conflict_tail: Vec<PackedTransaction>,
+    // Production-side CPU accounting: billed microseconds packed into this
+    // block so far, the block's budget (the configured per-block maximum),
+    // and the per-first-authorizer share already used. Transactions that
+    // don't fit are deferred to the next block, never failed.
+    cpu_budget_us: u64,
+    cpu_usage_us: u64,
+    account_cpu_us: HashMap<u64, u64>,
+}
+
+/// Post-state of the most recent successful block verification, kept open
+/// so that accepting the same block commits this session instead of
+/// replaying and re-executing it. Chainbase undo sessions nest, so only
+/// one verification can be retained at a time; any path that needs a fresh
+/// root session discards it first.
+struct VerifiedState {
+    session: UniquePtr<UndoSession>,
+    // Block the session's base state sits on; reuse requires it to still
+    // be the last accepted block at acceptance time.
+    parent_id: Id,
+    block_id: Id,
+    // Traces from the verification pass, for the state-history logs at
+    // acceptance.
+    transaction_traces: Vec<TransactionTrace>,
+    // Ids already packed into verified-but-unaccepted blocks when this
+    // pending block started; see the dedup note in `start_pending_block`.
+    pending_tx_ids: HashSet<Id>,
+}
 
 pub struct Controller {
     wasm_runtime: WasmRuntime,
     last_accepted_block: SignedBlock,
     last_accepted_block_id: Id,
+    // Mirror of the two fields above behind their published handle; only
+    // ever written through `set_last_accepted`.
+    head_handle: HeadBlockHandle,
     preferred_id: Id,
     db: Database,
-    verified_blocks: HashMap<Id, SignedBlock>,
+    // Shared with the published `BlockReadHandle`; mutated only while the
+    // controller itself is exclusively held, so block-fetch readers never
+    // contend with anything longer than a map operation. The store caps its
+    // resident bytes by spilling deep forks to disk and prunes dead branches
+    // on finality, so a consensus stall cannot grow it without bound.
+    verified_blocks: Arc<RwLock<ForkStore>>,
     chain_id: Id,
     state: vm::State,
-
-    block_log: Option<StateHistoryLog>,
-    trace_log: Option<StateHistoryLog>,
-    chain_state_log: Option<StateHistoryLog>,
+    recovery_cache: RecoveryCache,
+    // Rolling filter over accepted unexpired transaction ids, shared with the
+    // prevalidator so re-gossiped executed transactions are dropped before
+    // speculative execution.
+    accepted_tx_filter: AcceptedTxFilter,
+    // Prefixes of the last 64k accepted blocks, so a transaction's
+    // reference-block check is one array index; fed by `set_last_accepted`.
+    tapos_ring: TaposRing,
+
+    block_log: Option<Arc<StateHistoryLog>>,
+    // Decoded-block LRU with sequential readahead, serving the block
+    // lookups explorers issue in ranges.
+    block_cache: Option<Arc<BlockCache>>,
+    trace_log: Option<Arc<StateHistoryLog>>,
+    // Transaction id -> (block num, payload offset) sidecar over the trace
+    // log, so a single trace is found without scanning blocks.
+    trace_index: Option<Arc<TransactionTraceIndex>>,
+    // Receiver account -> receive-sequence-ordered action locations, the
+    // index behind paged account-history queries.
+    account_index: Option<Arc<AccountActionIndex>>,
+    chain_state_log: Option<Arc<StateHistoryLog>>,
+    // Appends to the three logs above go through this thread so block
+    // acceptance never pays their fsync latency inline.
+    sh_writer: Option<StateHistoryWriter>,
+    // Whether the next chain-state append is the first ever for this
+    // log. Tracked here because the writer may still be draining the
+    // genesis delta when the next block is accepted, so the log's own
+    // range can't be trusted for this decision.
+    chain_state_fresh: bool,
+    // Sweeps the chainbase mapping in small writeback batches so commits
+    // never leave the kernel gigabytes of dirty pages to flush at once.
+    db_flusher: Option<DbFlusher>,
+    // Directory holding the state database, remembered for writing a
+    // shutdown snapshot after the database file is closed.
+    db_path: Option<PathBuf>,
     node_config: Option<NodeConfig>,
+    // Signs produced block headers. Held as a provider rather than the raw
+    // key so deployments can swap in an external signer without touching
+    // the block production path; the default is the in-process producer
+    // key, which keeps signing off the network entirely.
+    block_signer: Option<Arc<dyn SigningProvider>>,
+    // Speculatively executed block being assembled between intervals; the
+    // timer pumps mempool transactions into it continuously and
+    // `build_block` only seals it.
+    pending_block: Option<PendingBlock>,
+    // Still-open session from the latest successful verification; see
+    // `VerifiedState`. Mutually exclusive with `pending_block`.
+    verified_state: Option<VerifiedState>,
+    // Retained undo session reused across speculative executions; see
+    // `push_transaction`. Only held while no block-level session is open,
+    // and torn down before one opens (sessions stack).
+    speculative_session: Option<UniquePtr<UndoSession>>,
+    // Rust-side shadow of the action sequence counters for the session
+    // lineage currently open on the database; flushed to chainbase once
+    // per block and cleared whenever that lineage is unwound. See
+    // `SequenceCounters`.
+    sequence_shadow: SequenceCounters,
+    // Every accepted block is published here for push-style consumers
+    // (the RPC block subscription). Sending is wait-free and a send with
+    // no subscribers is a no-op, so acceptance pays nothing when nobody
+    // listens; slow subscribers lag and drop rather than backpressure.
+    block_broadcast: broadcast::Sender<AcceptedBlockEvent>,
 }
 
 #[derive(Debug)]
@@ -102,16 +316,33 @@ impl Controller {
             wasm_runtime,
             last_accepted_block: SignedBlock::default(),
             last_accepted_block_id: Id::default(),
+            head_handle: Arc::new(RwLock::new((SignedBlock::default(), Id::default()))),
             preferred_id: Id::default(),
             db: Database::default(),
-            verified_blocks: HashMap::new(),
+            verified_blocks: Arc::new(RwLock::new(ForkStore::new())),
             chain_id: Id::default(),
             state: vm::State::Unspecified,
+            recovery_cache: RecoveryCache::new(),
+            accepted_tx_filter: AcceptedTxFilter::new(),
+            tapos_ring: TaposRing::new(),
 
             block_log: None,
+            block_cache: None,
             trace_log: None,
+            trace_index: None,
+            account_index: None,
             chain_state_log: None,
+            sh_writer: None,
+            chain_state_fresh: true,
+            db_flusher: None,
+            db_path: None,
             node_config: None,
+            block_signer: None,
+            pending_block: None,
+            verified_state: None,
+            speculative_session: None,
+            sequence_shadow: SequenceCounters::default(),
+            block_broadcast: broadcast::channel(BLOCK_BROADCAST_CAPACITY).0,
         }
     }
 
@@ -135,45 +366,250 @@ impl Controller {
         })?);
 
         // Initialize database
-        self.db = Database::new(&db_path, self.node_config.as_ref().unwrap().db_size)
-            .map_err(|e| ChainError::InternalError(format!("failed to open database: {}", e)))?;
+        let node_config = self.node_config.as_ref().unwrap();
+        BLOCK_PROFILER.set_enabled(node_config.profile_actions);
+        if let Some(cpus) = &node_config.exec_cpu_affinity {
+            cpu_affinity::set_exec_cpus(cpus.clone());
+        }
+        self.block_signer = Some(Arc::new(InProcessSigningProvider::new(
+            node_config.producer_key.clone(),
+        )));
+
+        // Bootstrap from a snapshot when there is no state database yet;
+        // any blocks past the snapshot are replayed from the block log
+        // further down.
+        if let Some(snapshot_path) = &node_config.snapshot_restore_path {
+            if !Path::new(db_path).join("shared_memory.bin").exists() {
+                let mut revision = snapshot::restore_snapshot(
+                    Path::new(snapshot_path),
+                    Path::new(db_path),
+                    chain_id,
+                )?;
+                info!(
+                    "restored state snapshot {} at revision {}",
+                    snapshot_path, revision
+                );
+                // A differential snapshot fast-forwards the restored image
+                // past the full snapshot's revision before any block replay.
+                if let Some(delta_path) = &node_config.snapshot_restore_delta_path {
+                    revision = snapshot::apply_delta_snapshot(
+                        Path::new(delta_path),
+                        Path::new(db_path),
+                        chain_id,
+                        revision,
+                    )?;
+                    info!(
+                        "applied differential snapshot {} up to revision {}",
+                        delta_path, revision
+                    );
+                }
+            }
+        }
+
+        let db_open_start = Instant::now();
+        self.db = Database::new_with_map_mode(
+            &db_path,
+            node_config.db_size,
+            node_config.db_map_mode.into(),
+            node_config.db_numa_interleave,
+        )
+        .map_err(|e| ChainError::InternalError(format!("failed to open database: {}", e)))?;
         self.db.add_indices()?;
+        info!(
+            "startup stage: database open and indices {:?}",
+            db_open_start.elapsed()
+        );
+
+        // Warm the mapping from the previous run's access profile before the
+        // first blocks execute, instead of letting them fault the working
+        // set in over several minutes. A missing or stale profile warms
+        // nothing; the flusher thread keeps the profile current from here.
+        let hot_pages_profile = Path::new(db_path).join("hot_pages.profile");
+        match self
+            .db
+            .prefault_hot_pages(&hot_pages_profile.to_string_lossy())
+        {
+            Ok(pages) if pages > 0 => {
+                info!("prefaulted {} hot database pages from access profile", pages)
+            }
+            Ok(_) => {}
+            Err(e) => warn!("failed to prefault hot database pages: {}", e),
+        }
+
+        self.db_flusher = Some(DbFlusher::spawn(self.db.clone(), hot_pages_profile));
+        self.db_path = Some(PathBuf::from(db_path));
+
+        // Deep forks spill next to the database; until this point (and in
+        // tests) the fork store keeps every verified block resident.
+        self.verified_blocks
+            .write()?
+            .set_spill_dir(Path::new(db_path).join("fork_spill"))?;
+
+        // Persist compiled wasm modules next to the database so hot contracts
+        // come back up without LLVM recompilation after a restart
+        self.wasm_runtime
+            .set_artifact_dir(&Path::new(db_path).join("wasm_cache"))?;
+        self.wasm_runtime
+            .set_cache_limit(node_config.wasm_cache_max_bytes)?;
+
+        // Budget for the node memory ledger; the decode and RPC admission
+        // points start throttling once the accounted subsystems pass it.
+        MEMORY_LEDGER.set_budget(node_config.memory_budget_bytes);
 
         // Parse genesis bytes
         let genesis_json = std::str::from_utf8(genesis_bytes).map_err(|e| {
             ChainError::ParseError(format!("failed to parse genesis bytes as UTF-8: {}", e))
         })?;
-        let genesis = CxxGenesisState::new(genesis_json)
+        self.chain_id = chain_id.clone();
+        let sh_backend = if node_config.sh_io_uring {
+            ShIoBackend::Uring
+        } else {
+            ShIoBackend::Std
+        };
+
+        // The three state-history logs each scan backwards for their last
+        // entry, and the trace indices rebuild their tails — all independent
+        // of each other and of genesis parsing. Open them as one parallel
+        // startup stage instead of the serial chain a deploy restart used to
+        // pay, and log per-stage timings so a slow restart points at its
+        // culprit.
+        let stage_start = Instant::now();
+        let (block_log_opened, trace_opened, chain_state_opened, genesis) =
+            std::thread::scope(|s| {
+                let block_log = s.spawn(|| {
+                    let t = Instant::now();
+                    let log = StateHistoryLog::open_with_backend(&db_path, "block_log", 0, sh_backend);
+                    (log, t.elapsed())
+                });
+                let trace = s.spawn(|| {
+                    let t = Instant::now();
+                    let log = StateHistoryLog::open_with_backend(&db_path, "trace_log", 0, sh_backend);
+                    let index = TransactionTraceIndex::open(&db_path, "trace_log");
+                    let accounts = AccountActionIndex::open(&db_path, "trace_log");
+                    (log, index, accounts, t.elapsed())
+                });
+                let chain_state = s.spawn(|| {
+                    let t = Instant::now();
+                    let log =
+                        StateHistoryLog::open_with_backend(&db_path, "chain_state_log", 0, sh_backend);
+                    (log, t.elapsed())
+                });
+
+                // The C++ genesis object is not Send, so its parse runs here
+                // on the caller's thread, overlapping the log opens.
+                let t = Instant::now();
+                let genesis = CxxGenesisState::new(genesis_json);
+                let genesis_elapsed = t.elapsed();
+
+                let (block_log, block_elapsed) =
+                    block_log.join().expect("block log open thread panicked");
+                let (trace_log, trace_index, account_index, trace_elapsed) =
+                    trace.join().expect("trace log open thread panicked");
+                let (chain_state_log, chain_state_elapsed) =
+                    chain_state.join().expect("chain state log open thread panicked");
+
+                info!(
+                    "startup stage: block_log {:?}, trace artifacts {:?}, chain_state_log {:?}, genesis parse {:?} ({:?} wall)",
+                    block_elapsed,
+                    trace_elapsed,
+                    chain_state_elapsed,
+                    genesis_elapsed,
+                    stage_start.elapsed()
+                );
+
+                (
+                    block_log,
+                    (trace_log, trace_index, account_index),
+                    chain_state_log,
+                    genesis,
+                )
+            });
+
+        let genesis = genesis
             .map_err(|e| ChainError::ParseError(format!("failed to parse genesis: {}", e)))?;
         // TODO: Validate genesis state
-        self.chain_id = chain_id.clone();
-        self.block_log = Some(
-            StateHistoryLog::open_with_magic(&db_path, "block_log", 0).map_err(|e| {
-                ChainError::InternalError(format!("failed to open block log: {}", e))
-            })?,
-        );
-        self.trace_log = Some(
-            StateHistoryLog::open_with_magic(&db_path, "trace_log", 0).map_err(|e| {
-                ChainError::InternalError(format!("failed to open trace log: {}", e))
-            })?,
-        );
-        self.chain_state_log = Some(
-            StateHistoryLog::open_with_magic(&db_path, "chain_state_log", 0).map_err(|e| {
-                ChainError::InternalError(format!("failed to open chain state log: {}", e))
-            })?,
-        );
+        self.block_log = Some(Arc::new(block_log_opened.map_err(|e| {
+            ChainError::InternalError(format!("failed to open block log: {}", e))
+        })?));
+        if let Some(hot_blocks) = node_config.block_log_hot_blocks {
+            let block_log = self.block_log.as_ref().unwrap();
+            let cold_dir = node_config
+                .block_log_cold_dir
+                .clone()
+                .map(PathBuf::from)
+                .unwrap_or_else(|| Path::new(db_path).join("cold"));
+            block_log.set_cold_dir(&cold_dir).map_err(|e| {
+                ChainError::InternalError(format!("failed to attach cold block log tier: {}", e))
+            })?;
+            // Migrate anything beyond the hot budget now, before replay —
+            // reads fetch archived blocks transparently either way.
+            if let Some((first, last)) = block_log.range() {
+                if last - first + 1 > hot_blocks {
+                    let keep_from = last.saturating_sub(hot_blocks) + 1;
+                    info!(
+                        "archiving block log below {} to cold tier at {}",
+                        keep_from,
+                        cold_dir.display()
+                    );
+                    block_log.archive_before(keep_from).map_err(|e| {
+                        ChainError::InternalError(format!(
+                            "failed to archive block log to cold tier: {}",
+                            e
+                        ))
+                    })?;
+                }
+            }
+        }
+        self.block_cache = Some(Arc::new(BlockCache::spawn(
+            self.block_log.as_ref().unwrap().clone(),
+        )));
+        let (trace_log, trace_index, account_index) = trace_opened;
+        self.trace_log = Some(Arc::new(trace_log.map_err(|e| {
+            ChainError::InternalError(format!("failed to open trace log: {}", e))
+        })?));
+        if node_config.trace_log_full_blocks.is_some() {
+            // Reduced trace segments share the block log's cold directory;
+            // segment names are prefixed per log, so the two never collide.
+            let cold_dir = node_config
+                .block_log_cold_dir
+                .clone()
+                .map(PathBuf::from)
+                .unwrap_or_else(|| Path::new(db_path).join("cold"));
+            self.trace_log
+                .as_ref()
+                .unwrap()
+                .set_cold_dir(&cold_dir)
+                .map_err(|e| {
+                    ChainError::InternalError(format!(
+                        "failed to attach reduced trace tier: {}",
+                        e
+                    ))
+                })?;
+        }
+        self.trace_index = Some(Arc::new(trace_index.map_err(|e| {
+            ChainError::InternalError(format!("failed to open trace index: {}", e))
+        })?));
+        self.account_index = Some(Arc::new(account_index.map_err(|e| {
+            ChainError::InternalError(format!("failed to open account index: {}", e))
+        })?));
+        self.chain_state_log = Some(Arc::new(chain_state_opened.map_err(|e| {
+            ChainError::InternalError(format!("failed to open chain state log: {}", e))
+        })?));
+        self.chain_state_fresh = self.chain_state_log.as_ref().unwrap().range().is_none();
+        self.sh_writer = Some(StateHistoryWriter::spawn(Duration::from_millis(
+            node_config.sh_sync_window_ms,
+        )));
 
         // Set our last accepted block to the genesis block
-        self.last_accepted_block = SignedBlock::new(
+        self.set_last_accepted(SignedBlock::new(
             Id::default(),
             genesis.get_initial_timestamp().into(),
             PULSE_NAME, // Use the provided producer name from genesis
             VecDeque::new(),
             Digest::default(),
             Digest::default(), // Placeholder action merkle root
-        );
-        self.last_accepted_block_id = self.last_accepted_block.id()?;
-        self.preferred_id = self.last_accepted_block.id()?;
+        ))?;
+        self.preferred_id = self.last_accepted_block_id;
 
         let revision = self.db.revision();
         info!("database revision: {}", revision);
@@ -228,14 +664,21 @@ impl Controller {
 
                 info!("block log contains blocks from {} to {}", start, end);
 
-                self.last_accepted_block = self.get_block_by_height(end)?.ok_or_else(|| {
+                // Crash recovery or a cold start with an intact block log:
+                // the state database is behind the log head, so re-execute
+                // the gap before serving anything.
+                if (revision as u32) < end {
+                    self.replay_block_log(revision as u32 + 1, end)?;
+                }
+
+                let head = self.get_block_by_height(end)?.ok_or_else(|| {
                     ChainError::DatabaseError(format!(
                         "failed to retrieve last block from block log at height {}",
                         end
                     ))
                 })?;
-                self.last_accepted_block_id = self.last_accepted_block.id()?;
-                self.preferred_id = self.last_accepted_block.id()?;
+                self.set_last_accepted(head)?;
+                self.preferred_id = self.last_accepted_block_id;
             }
         }
 
@@ -245,21 +688,61 @@ impl Controller {
     pub fn shutdown(&self) -> Result<(), ChainError> {
         // Explicitly close the database
         info!("shutting down controller and closing database");
+        let revision = self.db.revision();
         self.db.close()?;
         info!("database closed successfully");
+
+        // With the database closed the data file on disk is complete, so a
+        // snapshot taken now captures a consistent image.
+        if let (Some(path), Some(db_path)) = (
+            self.node_config
+                .as_ref()
+                .and_then(|c| c.snapshot_write_path.as_ref()),
+            self.db_path.as_ref(),
+        ) {
+            let base = self
+                .node_config
+                .as_ref()
+                .and_then(|c| c.snapshot_delta_base_path.as_ref())
+                .filter(|base| Path::new(base.as_str()).exists());
+            if let Some(base) = base {
+                // Diff against the configured full snapshot so mirrors only
+                // need to fetch the changed chunks.
+                info!("writing differential state snapshot to {}", path);
+                snapshot::write_delta_snapshot(
+                    db_path,
+                    Path::new(base),
+                    Path::new(path),
+                    &self.chain_id,
+                    revision,
+                )?;
+            } else {
+                info!("writing state snapshot to {}", path);
+                snapshot::write_snapshot(db_path, Path::new(path), &self.chain_id, revision)?;
+            }
+            info!("state snapshot written at revision {}", revision);
+        }
+
         Ok(())
     }
 
-    pub async fn build_block(&mut self, mempool: &mut Mempool) -> Result<SignedBlock, ChainError> {
+    /// Opens a fresh pending block on top of the current preferred id.
+    fn start_pending_block(&mut self, mempool: &mut Mempool) -> Result<(), ChainError> {
+        // The retained verification session and the pending block cannot
+        // share the undo stack; speculative building supersedes it. The same
+        // goes for the retained speculative-execution session.
+        self.discard_verified_state()?;
+        self.discard_speculative_session()?;
+        // Fresh lineage for the pending block; nothing shadowed may carry
+        // over from whatever ran before.
+        self.sequence_shadow.clear();
+
         let mut db = self.db.clone();
-        let mut root_session = db.create_undo_session(true)?; // As we are building the block, drop the changes once built
-        let mut transaction_receipts: VecDeque<TransactionReceipt> = VecDeque::new();
-        let mut action_receipt_digests: VecDeque<Digest> = VecDeque::new();
         let timestamp: BlockTimestamp = TimePoint::now().into();
-        let block_status = BlockStatus::Building;
+        let session = db.create_undo_session(true)?; // Speculative; dropped once the block is sealed
 
         // Clear expired transactions from the database
-        db.clear_expired_input_transactions(&timestamp.into())?;
+        db.clear_expired_input_transactions(&timestamp.into(), EXPIRED_TX_SWEEP_PER_BLOCK)?;
 
         // Transactions already present in a verified-but-not-yet-accepted block
         // must not be included again. At build time the earlier block has not
@@ -272,89 +755,385 @@ impl Controller {
         // Defer such transactions instead of dropping them: if the pending block
         // is accepted they are removed from the mempool then; if it is rejected
         // on a fork they remain available for a later block.
-        let pending_tx_ids: HashSet<Id> = self
-            .verified_blocks
-            .values()
-            .flat_map(|b| b.transactions.iter().map(|r| r.trx().id().clone()))
-            .collect();
-        let mut deferred: Vec<PackedTransaction> = Vec::new();
+        let pending_tx_ids: HashSet<Id> = self.verified_blocks.read()?.transaction_ids()?;
 
         // We need to build on top of preferred id, so rollback state if needed
         self.replay_accepted_state_to(self.preferred_id, &BlockStatus::Building, mempool)?;
 
+        let cpu_budget_us = Controller::get_global_properties(&self.db)?
+            .get_chain_config()
+            .get_max_block_cpu_usage() as u64;
+
+        self.pending_block = Some(PendingBlock {
+            session,
+            base_id: self.preferred_id,
+            timestamp,
+            transaction_receipts: VecDeque::new(),
+            action_mroot: IncrementalMerkle::new(),
+            applied_footprint: HashSet::new(),
+            conflict_tail: Vec::new(),
+            pending_tx_ids,
+            cpu_budget_us,
+            cpu_usage_us: 0,
+            account_cpu_us: HashMap::new(),
+        });
+        Ok(())
+    }
+
+    /// Tears down the speculative block, undoing its session and returning
+    /// its transactions to the mempool so they are reconsidered for the
+    /// next one. Must be called before any other undo session is opened on
+    /// the database (verification, acceptance): sessions stack, and work
+    /// executed on top of abandoned speculative state would be wrong.
+    fn abandon_pending_block(&mut self, mempool: &mut Mempool) -> Result<(), ChainError> {
+        if let Some(mut pending) = self.pending_block.take() {
+            for receipt in &pending.transaction_receipts {
+                mempool.add_transaction(receipt.trx().clone());
+            }
+            for transaction in pending.conflict_tail.drain(..) {
+                mempool.add_transaction(transaction);
+            }
+            pending
+                .session
+                .pin_mut()
+                .undo()
+                .map_err(|e| ChainError::DatabaseError(format!("failed to undo changes: {}", e)))?;
+            // The counters shadowed while building died with the session.
+            self.sequence_shadow.clear();
+            // The unwind may resurrect tables removed while building.
+            self.db.clear_absent_table_cache()?;
+            self.db.clear_resolved_table_cache()?;
+            self.db.clear_permission_link_mirror()?;
+            self.db.clear_key_permission_mirror()?;
+        }
+        Ok(())
+    }
+
+    /// Unwinds the retained speculative session, if any (see
+    /// [`Controller::push_transaction`]). Like
+    /// [`Controller::abandon_pending_block`], this must run before any
+    /// other root undo session is opened on the database.
+    fn discard_speculative_session(&mut self) -> Result<(), ChainError> {
+        if let Some(mut session) = self.speculative_session.take() {
+            session
+                .pin_mut()
+                .undo()
+                .map_err(|e| ChainError::DatabaseError(format!("failed to undo changes: {}", e)))?;
+            self.db.clear_absent_table_cache()?;
+            self.db.clear_resolved_table_cache()?;
+            self.db.clear_permission_link_mirror()?;
+            self.db.clear_key_permission_mirror()?;
+        }
+        Ok(())
+    }
+
+    /// Unwinds the retained verification session, if any. Like
+    /// [`Controller::abandon_pending_block`], this must run before any
+    /// other root undo session is opened on the database.
+    fn discard_verified_state(&mut self) -> Result<(), ChainError> {
+        if let Some(mut state) = self.verified_state.take() {
+            state
+                .session
+                .pin_mut()
+                .undo()
+                .map_err(|e| ChainError::DatabaseError(format!("failed to undo changes: {}", e)))?;
+            // The sequence flush done at the end of the verification pass
+            // was part of this session; its shadow must not outlive it.
+            self.sequence_shadow.clear();
+            self.db.clear_absent_table_cache()?;
+            self.db.clear_resolved_table_cache()?;
+            self.db.clear_permission_link_mirror()?;
+            self.db.clear_key_permission_mirror()?;
+        }
+        Ok(())
+    }
+
+    /// Applies whatever the mempool currently holds into the pending block,
+    /// opening one if necessary. The block timer calls this continuously
+    /// between intervals, so execution overlaps transaction arrival and
+    /// `build_block` finds the work already done. A pending block whose
+    /// base no longer matches the preferred id is abandoned first; its
+    /// transactions return to the mempool and re-apply on the new base.
+    pub fn pump_pending_block(&mut self, mempool: &mut Mempool) -> Result<(), ChainError> {
+        if self
+            .pending_block
+            .as_ref()
+            .is_some_and(|p| p.base_id != self.preferred_id)
+        {
+            self.abandon_pending_block(mempool)?;
+        }
+
+        if self.pending_block.is_none() {
+            // Don't hold an open session while idle; wait for work.
+            if !mempool.has_transactions() {
+                return Ok(());
+            }
+            self.start_pending_block(mempool)?;
+        }
+
+        let mut pending = self.pending_block.take().expect("pending block started above");
+        match self.apply_mempool_to_pending(&mut pending, mempool) {
+            Ok(()) => {
+                self.pending_block = Some(pending);
+                Ok(())
+            }
+            Err(e) => {
+                // Database-level failure: give the transactions back and
+                // drop the session rather than sealing over bad state.
+                self.pending_block = Some(pending);
+                let _ = self.abandon_pending_block(mempool);
+                Err(e)
+            }
+        }
+    }
+
+    /// Whether the pending block holds executed transactions waiting to be
+    /// sealed. Such transactions have already left the mempool, so the
+    /// block timer checks here too when deciding to request a build.
+    pub fn has_pending_block_work(&self) -> bool {
+        self.pending_block
+            .as_ref()
+            .is_some_and(|p| !p.transaction_receipts.is_empty())
+    }
+
+    /// Drains the mempool into `pending`, executing each transaction in a
+    /// child session squashed into the pending block's session.
+    fn apply_mempool_to_pending(
+        &mut self,
+        pending: &mut PendingBlock,
+        mempool: &mut Mempool,
+    ) -> Result<(), ChainError> {
+        let mut db = self.db.clone();
+        let block_status = BlockStatus::Building;
+        let mut deferred: Vec<PackedTransaction> = Vec::new();
+        let mut throttled: Vec<PackedTransaction> = Vec::new();
+        let account_cpu_cap_us = pending.cpu_budget_us * ACCOUNT_BLOCK_CPU_PCT / 100;
+
+        // Optimistic concurrency mode: a transaction that fails speculative
+        // execution while its (code, scope) footprint overlaps state another
+        // transaction in this block already touched may simply have raced that
+        // transaction. Instead of dropping it, queue it on a conflict tail and
+        // re-execute it serially once the main pass has settled the state it
+        // raced with.
+        let occ_mode = self
+            .node_config
+            .as_ref()
+            .map(|c| c.occ_mode)
+            .unwrap_or(false);
+
         // Get transactions from the mempool
         while let Some(transaction) = mempool.pop_transaction() {
-            if pending_tx_ids.contains(transaction.id()) {
+            // Block CPU budget exhausted: put this one back and stop
+            // packing. The rest of the mempool waits for the next block;
+            // nothing is failed by running out of room.
+            if pending.cpu_usage_us >= pending.cpu_budget_us {
+                mempool.add_transaction(transaction);
+                break;
+            }
+
+            if pending.pending_tx_ids.contains(transaction.id()) {
                 deferred.push(transaction);
                 continue;
             }
 
+            // Subjective per-account throttle: once a first authorizer has
+            // billed its share of this block, its remaining transactions
+            // move to the next one.
+            let first_authorizer = transaction.get_transaction().first_authorizer();
+            if let Some(payer) = first_authorizer {
+                let used = pending.account_cpu_us.get(&payer).copied().unwrap_or(0);
+                if used >= account_cpu_cap_us {
+                    throttled.push(transaction);
+                    continue;
+                }
+            }
+
             let mut child_session = db.create_undo_session(true)?;
             let transaction_result =
-                self.execute_transaction(&transaction, &timestamp, &block_status);
+                self.execute_transaction(&transaction, &pending.timestamp, &block_status);
 
             match transaction_result {
                 Ok(result) => {
-                    child_session.pin_mut().squash().map_err(|e| {
+                    // O(1) merge into the block's root session; the root is
+                    // undone or pushed wholesale at the end of the block, so
+                    // the per-object duplicate compression squash() does is
+                    // pure overhead here.
+                    child_session.pin_mut().squash_fast().map_err(|e| {
                         ChainError::DatabaseError(format!(
                             "failed to commit transaction changes: {}",
                             e
                         ))
                     })?; // Push changes to upstream session
 
+                    if occ_mode {
+                        pending
+                            .applied_footprint
+                            .extend(transaction_footprint(&transaction));
+                    }
+
+                    pending.cpu_usage_us += result.billed_cpu_time_us as u64;
+                    if let Some(payer) = first_authorizer {
+                        *pending.account_cpu_us.entry(payer).or_insert(0) +=
+                            result.billed_cpu_time_us as u64;
+                    }
+
                     // Add the transaction to the block
                     let receipt = TransactionReceipt::new(result.trace.receipt, transaction);
-                    transaction_receipts.push_back(receipt);
-                    action_receipt_digests.extend(result.action_receipt_digests);
+                    pending.transaction_receipts.push_back(receipt);
+                    for digest in result.action_receipt_digests {
+                        pending.action_mroot.append(digest);
+                    }
+                }
+                Err(e) => {
+                    child_session.pin_mut().undo().map_err(|e| {
+                        ChainError::DatabaseError(format!("failed to undo changes: {}", e))
+                    })?; // Revert changes made during this transaction
+                    self.db.clear_absent_table_cache()?;
+                    self.db.clear_resolved_table_cache()?;
+                    self.db.clear_permission_link_mirror()?;
+                    self.db.clear_key_permission_mirror()?;
+
+                    let conflicting = occ_mode
+                        && transaction_footprint(&transaction)
+                            .iter()
+                            .any(|key| pending.applied_footprint.contains(key));
+
+                    if conflicting {
+                        debug!(
+                            "transaction {} failed speculative execution, retrying in conflict tail: {}",
+                            transaction.id(),
+                            e
+                        );
+                        pending.conflict_tail.push(transaction);
+                    } else {
+                        warn!(
+                            "transaction {} failed to execute, dropping: {}",
+                            transaction.id(),
+                            e
+                        );
+                    }
+                }
+            }
+        }
+
+        // Return deferred and throttled transactions to the mempool for a
+        // later block.
+        for tx in deferred.into_iter().chain(throttled) {
+            mempool.add_transaction(tx);
+        }
+
+        Ok(())
+    }
+
+    pub async fn build_block(&mut self, mempool: &mut Mempool) -> Result<SignedBlock, ChainError> {
+        // Absorb anything still waiting, then seal what has already been
+        // executed between intervals.
+        self.pump_pending_block(mempool)?;
+
+        let Some(mut pending) = self.pending_block.take() else {
+            return Err(ChainError::NetworkError(format!(
+                "built block has no transactions"
+            )));
+        };
+
+        let mut db = self.db.clone();
+        let block_status = BlockStatus::Building;
+
+        // Serial re-execution of the conflicting tail; a transaction that
+        // still fails here is genuinely invalid and gets dropped.
+        for transaction in std::mem::take(&mut pending.conflict_tail) {
+            let mut child_session = db.create_undo_session(true)?;
+            let transaction_result =
+                self.execute_transaction(&transaction, &pending.timestamp, &block_status);
+
+            match transaction_result {
+                Ok(result) => {
+                    child_session.pin_mut().squash_fast().map_err(|e| {
+                        ChainError::DatabaseError(format!(
+                            "failed to commit transaction changes: {}",
+                            e
+                        ))
+                    })?;
+
+                    pending.cpu_usage_us += result.billed_cpu_time_us as u64;
+
+                    let receipt = TransactionReceipt::new(result.trace.receipt, transaction);
+                    pending.transaction_receipts.push_back(receipt);
+                    for digest in result.action_receipt_digests {
+                        pending.action_mroot.append(digest);
+                    }
                 }
                 Err(e) => {
                     warn!(
-                        "transaction {} failed to execute, dropping: {}",
+                        "transaction {} failed conflict-tail re-execution, dropping: {}",
                         transaction.id(),
                         e
                     );
 
                     child_session.pin_mut().undo().map_err(|e| {
                         ChainError::DatabaseError(format!("failed to undo changes: {}", e))
-                    })?; // Revert changes made during this transaction
+                    })?;
+                    self.db.clear_absent_table_cache()?;
+                    self.db.clear_resolved_table_cache()?;
+                    self.db.clear_permission_link_mirror()?;
+                    self.db.clear_key_permission_mirror()?;
                 }
             }
         }
 
-        // Return deferred transactions to the mempool for a later block.
-        for tx in deferred {
-            mempool.add_transaction(tx);
-        }
-
         // Don't build a block if we have no transactions
-        if transaction_receipts.len() == 0 {
+        if pending.transaction_receipts.len() == 0 {
+            pending
+                .session
+                .pin_mut()
+                .undo()
+                .map_err(|e| ChainError::DatabaseError(format!("failed to undo changes: {}", e)))?;
+            self.sequence_shadow.clear();
+            self.db.clear_absent_table_cache()?;
+            self.db.clear_resolved_table_cache()?;
+            self.db.clear_permission_link_mirror()?;
+            self.db.clear_key_permission_mirror()?;
             return Err(ChainError::NetworkError(format!(
                 "built block has no transactions"
             )));
         }
 
-        // Create a new block
-        let transaction_mroot = self.calculate_trx_merkle(&transaction_receipts)?;
-        let action_mroot = self.calculate_action_merkle(&mut action_receipt_digests)?;
-        let block = SignedBlock::new(
-            self.preferred_id,
-            timestamp,
+        // Seal: merkle roots and signature over the already-executed block.
+        let transaction_mroot = self.calculate_trx_merkle(&pending.transaction_receipts)?;
+        let action_mroot = pending.action_mroot.root();
+        let mut block = SignedBlock::new(
+            pending.base_id,
+            pending.timestamp,
             self.node_config.as_ref().unwrap().producer_name, // Use producer name from config
-            transaction_receipts,
+            pending.transaction_receipts,
             transaction_mroot,
             action_mroot,
         );
 
+        // Sign the header in process; the producer key never leaves the node.
+        if let Some(signer) = &self.block_signer {
+            block.sign(signer.as_ref())?;
+        }
+
         // We built this block so no need to verify it again
-        self.verified_blocks.insert(
+        self.verified_blocks.write()?.insert(
             block.signed_block_header.header.calculate_id()?,
             block.clone(),
-        );
+        )?;
 
-        root_session
+        pending
+            .session
             .pin_mut()
             .undo()
             .map_err(|e| ChainError::DatabaseError(format!("failed to undo changes: {}", e)))?; // Revert changes made during this transaction
+        // The built block's counters died with its session; acceptance
+        // re-executes it (or commits the verification pass) and re-derives
+        // them there.
+        self.sequence_shadow.clear();
+        self.db.clear_absent_table_cache()?;
+        self.db.clear_resolved_table_cache()?;
+        self.db.clear_permission_link_mirror()?;
+        self.db.clear_key_permission_mirror()?;
 
         Ok(block)
     }
@@ -364,14 +1143,16 @@ impl Controller {
         block: &SignedBlock,
         mempool: &mut Mempool,
     ) -> Result<(), ChainError> {
-        if self.verified_blocks.contains_key(&block.id()?) {
+        if self.verified_blocks.read()?.contains(&block.id()?) {
             return Ok(());
         } else if let Some(block_log) = &self.block_log {
             if let Ok(existing_block) = block_log.read_block(block.block_num()) {
-                let existing_block = SignedBlock::read(existing_block.as_slice(), &mut 0)?;
+                let existing_block = SignedBlock::from_wire(existing_block.as_slice())?;
 
                 if existing_block.id()? == block.id()? {
-                    self.verified_blocks.insert(block.id()?, block.clone());
+                    self.verified_blocks
+                        .write()?
+                        .insert(block.id()?, block.clone())?;
                     warn!(
                         "block {} already exists in block log, skipping verification",
                         block.id()?
@@ -393,22 +1174,63 @@ impl Controller {
         // Verify the block
         block.validate_syntactically(&self.db)?;
 
+        // Verification must not run on top of speculative pending-block
+        // state; its transactions go back to the mempool. The same goes for
+        // a previously retained verification session: only one can stay
+        // open, so verifying a new block supersedes it.
+        self.abandon_pending_block(mempool)?;
+        self.discard_verified_state()?;
+        self.discard_speculative_session()?;
+
+        // One block-level session is the only undo scope of the whole pass:
+        // `execute_transaction_with_keys` opens no per-transaction session,
+        // so every transaction writes through this root directly. That is
+        // sound here because a known-good block is all-or-nothing — any
+        // transaction failing fails verification and the root unwinds below.
+        // Per-transaction isolation exists only on the build path, where a
+        // failing candidate is skipped rather than block-fatal.
         let mut root_session = self.db.create_undo_session(true)?;
         let parent_block_id = block.previous_id();
         let block_status = BlockStatus::Verifying;
-        self.replay_accepted_state_to(parent_block_id.clone(), &block_status, mempool)?;
-        let (_transaction_traces, transaction_mroot, action_mroot) =
-            self.execute_block(block, &block_status, mempool)?;
-
-        // Validate the block's transaction and action merkle roots
-        block.validate_semantically(transaction_mroot, action_mroot)?;
-
-        self.verified_blocks.insert(block.id()?, block.clone());
+        let exec_result = self
+            .replay_accepted_state_to(parent_block_id.clone(), &block_status, mempool)
+            .and_then(|()| self.execute_block(block, &block_status, mempool))
+            .and_then(|(transaction_traces, transaction_mroot, action_mroot)| {
+                // Validate the block's transaction and action merkle roots
+                block.validate_semantically(transaction_mroot, action_mroot)?;
+                Ok(transaction_traces)
+            });
+        let transaction_traces = match exec_result {
+            Ok(transaction_traces) => transaction_traces,
+            Err(e) => {
+                // Unwind the half-verified state explicitly (rather than via
+                // the session's drop) so the caches keyed to this lineage
+                // are torn down with it.
+                root_session.pin_mut().undo().map_err(|e| {
+                    ChainError::DatabaseError(format!("failed to undo changes: {}", e))
+                })?;
+                self.sequence_shadow.clear();
+                self.db.clear_absent_table_cache()?;
+                self.db.clear_resolved_table_cache()?;
+                self.db.clear_permission_link_mirror()?;
+                self.db.clear_key_permission_mirror()?;
+                return Err(e);
+            }
+        };
 
-        root_session
-            .pin_mut()
-            .undo()
-            .map_err(|e| ChainError::DatabaseError(format!("failed to undo changes: {}", e)))?; // Revert changes made during this transaction
+        self.verified_blocks
+            .write()?
+            .insert(block.id()?, block.clone())?;
+
+        // Keep the session open instead of undoing it: consensus accepting
+        // this block next is the common case, and acceptance then commits
+        // this state directly instead of executing the block a second time.
+        self.verified_state = Some(VerifiedState {
+            session: root_session,
+            parent_id: parent_block_id.clone(),
+            block_id: block.id()?,
+            transaction_traces,
+        });
 
         Ok(())
     }
@@ -416,39 +1238,131 @@ impl Controller {
     pub fn accept_block(&mut self, block_id: &Id, mempool: &mut Mempool) -> Result<(), ChainError> {
         let block = {
             self.verified_blocks
-                .get(block_id)
-                .cloned()
+                .read()?
+                .get(block_id)?
                 .ok_or(ChainError::NetworkError(format!(
                     "block with id {} not verified",
                     block_id
                 )))?
         };
 
-        let mut root_session = self.db.create_undo_session(true)?;
-        let block_status = BlockStatus::Accepting;
-        let parent_block_id = block.previous_id();
-        self.replay_accepted_state_to(parent_block_id.clone(), &block_status, mempool)?;
-        let (transaction_traces, _transaction_mroot, _action_mroot) = self
-            .execute_block(&block, &block_status, mempool)
-            .map_err(|e| {
-                ChainError::DatabaseError(format!("failed to execute block {}: {}", block_id, e))
-            })?;
-        let packed_block = block.pack().map_err(|e| {
+        // Acceptance commits state; any speculative pending-block session
+        // must be unwound first (its transactions return to the mempool and
+        // the accepted block's are removed again below), along with the
+        // retained speculative-execution session.
+        self.abandon_pending_block(mempool)?;
+        self.discard_speculative_session()?;
+
+        // A retained verification session for exactly this block on top of
+        // the current head already holds the post-state; anything else is
+        // stale and must be unwound before a fresh root session opens.
+        let reusable = self.verified_state.as_ref().is_some_and(|s| {
+            s.block_id == *block_id && s.parent_id == self.last_accepted_block_id
+        });
+        if !reusable {
+            self.discard_verified_state()?;
+        }
+
+        let packed_block = self.pack_block(block).map_err(|e| {
             ChainError::TransactionError(format!("failed to pack block {}: {}", block_id, e))
         })?;
-        root_session
-            .pin_mut()
-            .push()
-            .map_err(|e| ChainError::TransactionError(format!("failed to commit block: {}", e)))?;
-        self.block_log
-            .as_ref()
-            .map(|log| log.append(block_id.clone(), &packed_block));
-        self.store_traces(block_id, &transaction_traces)?;
+        let transaction_traces = if let Some(mut state) = self.verified_state.take() {
+            // Commit the verification pass instead of re-executing the
+            // block. The Accepting-only side effects of execute_block still
+            // apply: included transactions leave the mempool, and the
+            // accounting window opened at verification is sealed here.
+            {
+                let _t = EXEC_PHASES.timer(Phase::Commit);
+                state.session.pin_mut().push().map_err(|e| {
+                    ChainError::TransactionError(format!("failed to commit block: {}", e))
+                })?;
+            }
+            for receipt in &block.transactions {
+                mempool.remove_transaction(receipt.trx().id());
+            }
+            EXEC_ACCOUNTING.seal_block(block.block_num());
+            state.transaction_traces
+        } else {
+            let mut root_session = self.db.create_undo_session(true)?;
+            let block_status = BlockStatus::Accepting;
+            let parent_block_id = block.previous_id();
+            let exec_result = self
+                .replay_accepted_state_to(parent_block_id.clone(), &block_status, mempool)
+                .and_then(|()| self.execute_block(&block, &block_status, mempool));
+            let (transaction_traces, _transaction_mroot, _action_mroot) = match exec_result {
+                Ok(result) => result,
+                Err(e) => {
+                    // Unwind explicitly (rather than via the session's drop)
+                    // so the caches keyed to this lineage are torn down with
+                    // it; consensus will retry the acceptance.
+                    root_session.pin_mut().undo().map_err(|e| {
+                        ChainError::DatabaseError(format!("failed to undo changes: {}", e))
+                    })?;
+                    self.sequence_shadow.clear();
+                    self.db.clear_absent_table_cache()?;
+                    self.db.clear_resolved_table_cache()?;
+                    self.db.clear_permission_link_mirror()?;
+                    self.db.clear_key_permission_mirror()?;
+                    return Err(ChainError::DatabaseError(format!(
+                        "failed to execute block {}: {}",
+                        block_id, e
+                    )));
+                }
+            };
+            {
+                let _t = EXEC_PHASES.timer(Phase::Commit);
+                root_session.pin_mut().push().map_err(|e| {
+                    ChainError::TransactionError(format!("failed to commit block: {}", e))
+                })?;
+            }
+            transaction_traces
+        };
+        // Hand the three state-history appends to the writer thread;
+        // acceptance only blocks here if the writer's queue is full.
+        if let (Some(writer), Some(block_log)) = (&self.sh_writer, &self.block_log) {
+            writer.submit(block_log, block_id.clone(), packed_block);
+        }
+        // Shared between the state-history writer and the accepted-block
+        // broadcast below; neither side copies the traces.
+        let transaction_traces = Arc::new(transaction_traces);
+        self.store_traces(block_id, transaction_traces.clone())?;
         self.store_chain_state(block_id)?;
-        self.verified_blocks.remove(block_id);
-        self.last_accepted_block = block.clone();
-        self.last_accepted_block_id = block.id()?;
-        self.db.commit(block.block_num() as i64)?;
+        {
+            let mut verified = self.verified_blocks.write()?;
+            verified.remove(block_id)?;
+            // Finality: sibling forks at or below the accepted height can
+            // never be accepted now; drop them and their spill files.
+            verified.prune_finalized(block.block_num());
+        }
+        self.set_last_accepted(block.clone())?;
+        {
+            let _t = EXEC_PHASES.timer(Phase::Commit);
+            self.db.commit(block.block_num() as i64)?;
+        }
+
+        // These ids are now in the dedup table; remember them so admission
+        // can drop re-gossiped copies without probing the database.
+        for receipt in &block.transactions {
+            self.accepted_tx_filter.insert(receipt.trx().id());
+        }
+
+        METRICS.set_db_free_memory(self.db.free_memory_bytes());
+
+        // Publish to push subscribers. The block moves into the Arc and
+        // the traces share the writer's allocation, so the send costs
+        // reference counts whether or not anyone is subscribed.
+        let block = Arc::new(block);
+        if self.block_broadcast.receiver_count() > 0 {
+            let _ = self.block_broadcast.send(AcceptedBlockEvent {
+                block_id: block_id.clone(),
+                block: block.clone(),
+                traces: transaction_traces,
+            });
+        }
+        // Likewise for table-change subscribers: the writes matched during
+        // this block's execution pass go out as one batch, now that they
+        // are committed.
+        STATE_DIFF_HUB.publish(block.block_num(), block_id);
 
         if self.get_state() == &vm::State::NormalOp {
             info!(
@@ -471,8 +1385,8 @@ impl Controller {
     pub fn reject_block(&mut self, block_id: &Id, mempool: &mut Mempool) -> Result<(), ChainError> {
         let block = {
             self.verified_blocks
-                .get(block_id)
-                .cloned()
+                .read()?
+                .get(block_id)?
                 .ok_or(ChainError::NetworkError(format!(
                     "block with id {} not verified",
                     block_id
@@ -484,7 +1398,17 @@ impl Controller {
             mempool.add_transaction(receipt.trx().clone());
         }
 
-        self.verified_blocks.remove(block_id);
+        // The retained verification state for a rejected block will never
+        // be accepted; unwind it.
+        if self
+            .verified_state
+            .as_ref()
+            .is_some_and(|s| s.block_id == *block_id)
+        {
+            self.discard_verified_state()?;
+        }
+
+        self.verified_blocks.write()?.remove(block_id)?;
 
         Ok(())
     }
@@ -495,37 +1419,130 @@ impl Controller {
         block_status: &BlockStatus,
         mempool: &mut Mempool,
     ) -> Result<(Vec<TransactionTrace>, Digest, Digest), ChainError> {
+        let exec_start = Instant::now();
+        // This block executes on a fresh root session over its parent's
+        // state; any shadowed counters from a previous lineage are stale.
+        self.sequence_shadow.clear();
+        // Start a fresh accounting window; a verify pass followed by an
+        // accept pass of the same block keeps only the final one.
+        EXEC_ACCOUNTING.begin_block();
+        // Same discipline for the state-diff stream: matched writes queue
+        // per pass and only acceptance publishes.
+        STATE_DIFF_HUB.begin_block();
+        // Divisor for the per-block averages the FFI cycle counters report.
+        FFI_STATS.count_block();
         let mut transaction_traces: Vec<TransactionTrace> = Vec::new();
-        let mut transaction_receipts: VecDeque<TransactionReceipt> = VecDeque::new();
-        let mut action_receipt_digests: VecDeque<Digest> = VecDeque::new();
-
-        self.db
-            .clear_expired_input_transactions(&block.timestamp().to_time_point())?;
+        let mut action_mroot = IncrementalMerkle::new();
 
-        for receipt in &block.transactions {
-            // Verify the transaction
-            let result = self.execute_transaction(
-                receipt.trx(),
-                &block.signed_block_header.header.timestamp,
-                block_status,
-            )?;
+        self.db.clear_expired_input_transactions(
+            &block.timestamp().to_time_point(),
+            EXPIRED_TX_SWEEP_PER_BLOCK,
+        )?;
 
-            // Add trace to traces
-            transaction_traces.push(result.trace.clone());
-            transaction_receipts.push_back(TransactionReceipt::new(
-                result.trace.receipt,
-                receipt.trx().clone(),
-            ));
-            action_receipt_digests.extend(result.action_receipt_digests);
+        // Partition the block into conflict-free lanes by declared (code, scope)
+        // footprint and recover signature keys per lane on a worker pool. The
+        // apply loop below stays serial (the chainbase undo stack is a single
+        // writer), but it no longer pays per-transaction key recovery and the
+        // lane order gives a deterministic merge when every lane is drained in
+        // block order.
+        let recovered_keys = if block_status == &BlockStatus::Replaying {
+            // Replayed blocks skip signature checks entirely, so there are
+            // no keys to recover.
+            HashMap::new()
+        } else {
+            let _t = EXEC_PHASES.timer(Phase::Auth);
+            let block_transactions: Vec<&PackedTransaction> =
+                block.transactions.iter().map(|r| r.trx()).collect();
+            let schedule = ExecutionSchedule::build(&block_transactions);
+            schedule.recover_keys(
+                &block_transactions,
+                &self.chain_id,
+                Some(&self.recovery_cache),
+            )?
+        };
 
-            // Remove from mempool if we have it
-            if block_status == &BlockStatus::Accepting {
-                mempool.remove_transaction(receipt.trx().id());
-            }
-        }
+        // Receipt assembly — a pack and a sha256 per transaction — runs on a
+        // pipeline worker, overlapping the serialization with the next
+        // transaction's execution on this thread. The worker owns each
+        // receipt and hands the ordered digest list back once the block is
+        // drained; everything that writes chainbase (finalization, net-usage
+        // windows) stays on this thread, the undo stack is a single writer.
+        let (receipt_sender, receipt_receiver) =
+            std::sync::mpsc::channel::<TransactionReceipt>();
+        let mut trx_digests = std::thread::scope(
+            |scope| -> Result<VecDeque<Digest>, ChainError> {
+                let digester =
+                    scope.spawn(move || -> Result<VecDeque<Digest>, ChainError> {
+                        // Keep the digester on the execution package too;
+                        // it hashes buffers the apply thread just wrote.
+                        cpu_affinity::pin_worker(0);
+                        let mut digests = VecDeque::new();
+                        while let Ok(receipt) = receipt_receiver.recv() {
+                            let digest = receipt.digest().map_err(|e| {
+                                ChainError::TransactionError(format!(
+                                    "failed to calculate transaction digest: {}",
+                                    e
+                                ))
+                            })?;
+                            digests.push_back(digest);
+                        }
+                        Ok(digests)
+                    });
+
+                let applied: Result<(), ChainError> = (|| {
+                    for receipt in &block.transactions {
+                        // Verify the transaction
+                        let result = self.execute_transaction_with_keys(
+                            receipt.trx(),
+                            &block.signed_block_header.header.timestamp,
+                            block_status,
+                            recovered_keys.get(receipt.trx().id()),
+                        )?;
+
+                        // Add trace to traces
+                        transaction_traces.push(result.trace.clone());
+                        // A send can only fail once the worker is gone; the
+                        // failure then surfaces from its join below.
+                        let _ = receipt_sender.send(TransactionReceipt::new(
+                            result.trace.receipt,
+                            receipt.trx().clone(),
+                        ));
+                        for digest in result.action_receipt_digests {
+                            action_mroot.append(digest);
+                        }
+
+                        // Remove from mempool if we have it
+                        if block_status == &BlockStatus::Accepting {
+                            mempool.remove_transaction(receipt.trx().id());
+                        }
+                    }
+                    Ok(())
+                })();
+
+                // Closing the channel ends the worker's recv loop; reap it
+                // either way, then surface the apply loop's error first —
+                // it is the root cause when both sides failed.
+                drop(receipt_sender);
+                let digests = digester.join();
+                applied?;
+                digests.map_err(|_| {
+                    ChainError::InternalError("receipt digest worker panicked".to_string())
+                })?
+            },
+        )?;
 
-        let transaction_mroot = self.calculate_trx_merkle(&transaction_receipts)?;
-        let action_mroot = self.calculate_action_merkle(&mut action_receipt_digests)?;
+        // Write the block's sequence increments back to chainbase in one
+        // crossing, inside the caller's root session so an unwound block
+        // also unwinds the counters.
+        self.sequence_shadow.flush(&mut self.db)?;
+
+        let (transaction_mroot, action_mroot) = {
+            let _t = EXEC_PHASES.timer(Phase::Merkle);
+            (
+                merkle_parallel(&mut trx_digests),
+                action_mroot.root(),
+            )
+        };
 
         // Update resource limits
         let global_property = Controller::get_global_properties(&self.db)?;
@@ -561,6 +1578,11 @@ impl Controller {
         )?;
         ResourceLimitsManager::process_block_usage(&mut self.db, block.block_num())?;
 
+        METRICS.observe_block_execution(exec_start.elapsed());
+        if block_status == &BlockStatus::Accepting {
+            EXEC_ACCOUNTING.seal_block(block.block_num());
+        }
+
         Ok((transaction_traces, transaction_mroot, action_mroot))
     }
 
@@ -572,11 +1594,156 @@ impl Controller {
         pending_block_timestamp: &BlockTimestamp,
         block_status: &BlockStatus,
     ) -> Result<TransactionResult, ChainError> {
-        let mut db = self.db.clone();
-        let _undo_session = db.create_undo_session(true)?;
-        let result =
-            self.execute_transaction(transaction, pending_block_timestamp, block_status)?;
-        return Ok(result);
+        // A block-level session may be open (the timer builds the pending
+        // block continuously); nest a throwaway session on top of it rather
+        // than retaining one below it — sessions stack and must unwind LIFO.
+        if self.pending_block.is_some() || self.verified_state.is_some() {
+            let mut db = self.db.clone();
+            let _undo_session = db.create_undo_session(true)?;
+            let saved_shadow = self.sequence_shadow.clone();
+            let result =
+                self.execute_transaction(transaction, pending_block_timestamp, block_status);
+            // The throwaway session unwinds on drop; the sequence increments
+            // adopted on success unwind with it.
+            self.sequence_shadow = saved_shadow;
+            drop(_undo_session);
+            self.db.clear_absent_table_cache()?;
+            self.db.clear_resolved_table_cache()?;
+            self.db.clear_permission_link_mirror()?;
+            self.db.clear_key_permission_mirror()?;
+            return result;
+        }
+
+        // Speculative executions roll back unconditionally, so consecutive
+        // calls share one retained session: opened lazily, reverted back to
+        // base state after each execution, reused for the next. Mempool
+        // pre-validation bursts then pay one session construction instead of
+        // one per transaction. The session is torn down before any block
+        // machinery opens a root session (see discard_speculative_session).
+        if self.speculative_session.is_none() {
+            let mut db = self.db.clone();
+            self.speculative_session = Some(db.create_undo_session(true)?);
+            METRICS.count_speculative_session_open();
+        } else {
+            METRICS.count_speculative_session_reuse();
+        }
+
+        let saved_shadow = self.sequence_shadow.clone();
+        let result = self.execute_transaction(transaction, pending_block_timestamp, block_status);
+        // Whatever the outcome, the state below reverts; sequence increments
+        // adopted on success revert with it.
+        self.sequence_shadow = saved_shadow;
+
+        // Revert whether execution succeeded or failed. A revert that itself
+        // fails leaves the session's base state unknown, so drop the session
+        // (its destructor unwinds) instead of reusing it.
+        let revert_start = Instant::now();
+        if let Err(e) = self
+            .speculative_session
+            .as_mut()
+            .unwrap()
+            .pin_mut()
+            .revert()
+        {
+            self.speculative_session = None;
+            self.db.clear_absent_table_cache()?;
+            self.db.clear_resolved_table_cache()?;
+            self.db.clear_permission_link_mirror()?;
+            self.db.clear_key_permission_mirror()?;
+            return Err(ChainError::DatabaseError(format!(
+                "failed to revert speculative session: {}",
+                e
+            )));
+        }
+        METRICS.observe_speculative_session_revert(revert_start.elapsed());
+        self.db.clear_absent_table_cache()?;
+        self.db.clear_resolved_table_cache()?;
+        self.db.clear_permission_link_mirror()?;
+        self.db.clear_key_permission_mirror()?;
+
+        result
+    }
+
+    // Executes a single action as a view call: the module is instantiated
+    // with the state-mutating intrinsics unbound (they trap if reached), so
+    // the call runs with no undo session at all and is safe to execute on any
+    // database handle in parallel with block building. Native handlers,
+    // notifications and inline actions are not dispatched — this is strictly
+    // the receiver contract's own `apply`. Takes its handles by value rather
+    // than `&self` so the RPC layer can run it off the controller lock.
+    pub fn read_only_call(
+        db: Database,
+        mut wasm_runtime: WasmRuntime,
+        head_block_num: u32,
+        account: Name,
+        action_name: Name,
+        data: Vec<u8>,
+    ) -> Result<(ActionTrace, u64), ChainError> {
+        let metadata = db.get_account_metadata(account.as_u64())?;
+        if metadata.get_code_hash().empty() {
+            return Err(ChainError::TransactionError(format!(
+                "account {} has no contract deployed",
+                account
+            )));
+        }
+
+        let action = Action::new(account.clone(), action_name, data, vec![]);
+
+        // A synthetic unsigned transaction backs the transaction-introspection
+        // intrinsics (read_transaction, transaction_size, expiration, tapos).
+        let mut transaction = Transaction::default();
+        transaction.actions = vec![action.clone()];
+        let packed = PackedTransaction::from_signed_transaction(SignedTransaction::new(
+            transaction,
+            BTreeSet::new(),
+            vec![],
+        ))?;
+
+        let pending_block_timestamp: BlockTimestamp = TimePoint::now().into();
+        let mut trx_context = TransactionContext::new(
+            db.clone(),
+            wasm_runtime.clone(),
+            head_block_num + 1,
+            pending_block_timestamp,
+            packed.id(),
+            BlockStatus::Verifying,
+            packed.clone(),
+            // Read-only calls never produce receipts, so the counters are
+            // never read; a fresh shadow is fine.
+            SequenceCounters::default(),
+        );
+        let ordinal = trx_context.schedule_action(action.clone(), &account, false, 0, 0)?;
+
+        let apply_context = ApplyContext::new(
+            db.clone(),
+            wasm_runtime.clone(),
+            trx_context.clone(),
+            action.clone(),
+            account.clone(),
+            ordinal,
+            0,
+            READ_ONLY_CALL_CPU_LIMIT,
+            false,
+        )?;
+
+        let start = Instant::now();
+        let (cpu_used, return_value) = wasm_runtime.run_read_only(
+            account,
+            action,
+            apply_context,
+            db,
+            metadata.get_code_hash(),
+            READ_ONLY_CALL_CPU_LIMIT,
+        )?;
+
+        // No receipt: receipts draw from the global and per-account sequence
+        // counters, which are database writes.
+        trx_context.modify_action_trace(ordinal, |trace| {
+            trace.set_elapsed(start.elapsed().as_micros() as u32);
+            trace.return_value = return_value.unwrap_or_default();
+        })?;
+
+        Ok((trx_context.get_action_trace(ordinal)?, cpu_used))
     }
 
     // This function will execute a transaction and commit it to the database
@@ -586,6 +1753,24 @@ impl Controller {
         packed_transaction: &PackedTransaction,
         pending_block_timestamp: &BlockTimestamp,
         block_status: &BlockStatus,
+    ) -> Result<TransactionResult, ChainError> {
+        self.execute_transaction_with_keys(
+            packed_transaction,
+            pending_block_timestamp,
+            block_status,
+            None,
+        )
+    }
+
+    // Same as `execute_transaction`, but accepts signature keys that were
+    // already recovered (e.g. by the lane scheduler in `execute_block`) so the
+    // expensive recovery is not repeated on the serial apply path.
+    pub fn execute_transaction_with_keys(
+        &mut self,
+        packed_transaction: &PackedTransaction,
+        pending_block_timestamp: &BlockTimestamp,
+        block_status: &BlockStatus,
+        recovered_keys: Option<&BTreeSet<PublicKey>>,
     ) -> Result<TransactionResult, ChainError> {
         let signed_transaction = packed_transaction.get_signed_transaction();
 
@@ -594,15 +1779,48 @@ impl Controller {
             .transaction()
             .validate(pending_block_timestamp)?;
 
-        // Verify authority
-        AuthorizationManager::check_authorization(
-            &mut self.db,
-            &signed_transaction.transaction().actions,
-            &signed_transaction.recovered_keys(&self.chain_id)?,
-            &BTreeSet::new(),
-            seconds(signed_transaction.transaction().header.delay_sec.into()),
-            &BTreeSet::new(),
-        )?;
+        // Reference-block check against the accepted chain: one ring index,
+        // no block lookup. Replayed blocks passed it when first accepted.
+        if block_status != &BlockStatus::Replaying {
+            let header = &signed_transaction.transaction().header;
+            self.tapos_ring
+                .verify(header.ref_block_num, header.ref_block_prefix)?;
+        }
+
+        // Blocks replayed from the local block log had their signatures and
+        // authorities checked before they were accepted, so both are skipped
+        // below the trusted irreversible height.
+        if block_status != &BlockStatus::Replaying {
+            let _t = EXEC_PHASES.timer(Phase::Auth);
+            let owned_keys;
+            let recovered_keys = match recovered_keys {
+                Some(keys) => keys,
+                None => {
+                    // A transaction is typically executed several times (push,
+                    // build, verify, accept); recover once and cache by id.
+                    owned_keys = match self.recovery_cache.get(packed_transaction.id()) {
+                        Some(keys) => keys,
+                        None => {
+                            let keys = signed_transaction.recovered_keys(&self.chain_id)?;
+                            self.recovery_cache
+                                .put(packed_transaction.id().clone(), keys.clone());
+                            keys
+                        }
+                    };
+                    &owned_keys
+                }
+            };
+
+            // Verify authority
+            AuthorizationManager::check_authorization(
+                &mut self.db,
+                &signed_transaction.transaction().actions,
+                recovered_keys,
+                &BTreeSet::new(),
+                seconds(signed_transaction.transaction().header.delay_sec.into()),
+                &BTreeSet::new(),
+            )?;
+        }
 
         let mut trx_context = TransactionContext::new(
             self.db.clone(),
@@ -612,6 +1830,10 @@ impl Controller {
             packed_transaction.id(),
             *block_status,
             packed_transaction.clone(),
+            // The transaction increments sequence counters on a clone of
+            // the block-level shadow; the caller adopts the result's copy
+            // only if it squashes the transaction's session.
+            self.sequence_shadow.clone(),
         );
 
         let trx = packed_transaction.get_transaction();
@@ -619,9 +1841,19 @@ impl Controller {
             packed_transaction.get_unprunable_size()?,
             packed_transaction.get_prunable_size()?,
             &trx,
+            // check_authorization above already resolved every declared actor
+            // and permission except on replay, where it is skipped.
+            block_status != &BlockStatus::Replaying,
         )?;
         trx_context.exec(&trx)?;
-        let result = trx_context.finalize()?;
+        let mut result = trx_context.finalize()?;
+
+        // The transaction executed fully: its sequence increments become the
+        // shadow the next transaction continues from. On any failure above
+        // they are dropped here along with the caller's child session.
+        // Callers whose session rolls back even on success restore the
+        // shadow themselves (see `push_transaction`).
+        self.sequence_shadow = std::mem::take(&mut result.sequence_counters);
 
         Ok(result)
     }
@@ -630,14 +1862,78 @@ impl Controller {
         &self.last_accepted_block
     }
 
+    /// Id of the last accepted block, as stored at acceptance time. Prefer
+    /// this over `last_accepted_block().id()?`, which rehashes the header.
+    pub fn last_accepted_block_id(&self) -> &Id {
+        &self.last_accepted_block_id
+    }
+
+    /// Handle the RPC layer reads the head block through without taking the
+    /// controller lock; refreshed on every head change.
+    pub fn head_block_handle(&self) -> HeadBlockHandle {
+        self.head_handle.clone()
+    }
+
+    /// Subscribe to accepted blocks as they are committed. Each event
+    /// carries the block id, the accepted block and its execution traces,
+    /// all `Arc`-shared; see [`BLOCK_BROADCAST_CAPACITY`] for the lag
+    /// behavior.
+    pub fn subscribe_blocks(&self) -> broadcast::Receiver<AcceptedBlockEvent> {
+        self.block_broadcast.subscribe()
+    }
+
+    /// Handle the gRPC block-fetch handlers read blocks through without the
+    /// controller lock; available once `initialize` has opened the block
+    /// log and its cache.
+    pub fn block_read_handle(&self) -> Option<BlockReadHandle> {
+        self.block_cache.as_ref().map(|cache| BlockReadHandle {
+            verified: self.verified_blocks.clone(),
+            head: self.head_handle.clone(),
+            cache: cache.clone(),
+            wire_v2: self.node_config.as_ref().is_some_and(|c| c.block_wire_v2),
+        })
+    }
+
+    // Single path for head updates, so the published handle can never drift
+    // from the controller's own fields.
+    fn set_last_accepted(&mut self, block: SignedBlock) -> Result<(), ChainError> {
+        self.last_accepted_block_id = block.id()?;
+        self.last_accepted_block = block;
+        self.tapos_ring.record(&self.last_accepted_block_id);
+        if let Ok(mut head) = self.head_handle.write() {
+            *head = (
+                self.last_accepted_block.clone(),
+                self.last_accepted_block_id,
+            );
+        }
+        if let Some(cache) = &self.block_cache {
+            cache.set_head(self.last_accepted_block.block_num());
+        }
+        Ok(())
+    }
+
     pub fn get_block_by_height(&self, height: u32) -> Result<Option<SignedBlock>, ChainError> {
         if height == self.last_accepted_block.block_num() {
             return Ok(Some(self.last_accepted_block.clone()));
         }
 
-        // Query DB
+        // The lookup also feeds the cache's sequential-scan detection, so it
+        // runs on every call whether or not it hits.
+        if let Some(cache) = &self.block_cache {
+            if let Some(block) = cache.lookup(height) {
+                return Ok(Some(block));
+            }
+            // Miss: the cache owns the log read so that concurrent requests
+            // for the same height share a single decode.
+            return Ok(cache.load(height));
+        }
+
+        // No cache before initialization: query the block log directly.
         let res = match self.block_log()?.read_block(height) {
-            Ok(block) => Some(SignedBlock::read(block.as_slice(), &mut 0)?),
+            Ok(block) => {
+                let block = SignedBlock::from_wire(block.as_slice())?;
+                Some(block)
+            }
             Err(_) => None,
         };
 
@@ -654,8 +1950,8 @@ impl Controller {
     }
 
     pub fn get_block(&self, id: Id) -> Result<Option<SignedBlock>, ChainError> {
-        if self.verified_blocks.contains_key(&id) {
-            return Ok(self.verified_blocks.get(&id).cloned());
+        if let Some(block) = self.verified_blocks.read()?.get(&id)? {
+            return Ok(Some(block));
         }
 
         let num = BlockHeader::num_from_id(&id);
@@ -663,22 +1959,81 @@ impl Controller {
         self.get_block_by_height(num)
     }
 
-    pub fn parse_block(&self, bytes: &Vec<u8>) -> Result<SignedBlock, ControllerError> {
-        let mut pos = 0;
-        let block = SignedBlock::read(bytes, &mut pos)
+    // Pure decode of the caller's bytes — no controller state is read, so
+    // the ParseBlock handlers call these without any lock at all. Both
+    // wire formats are accepted: compact v2 payloads carry a magic prefix,
+    // anything else decodes as a v1 pack.
+    pub fn parse_block(bytes: &Vec<u8>) -> Result<SignedBlock, ControllerError> {
+        let block = SignedBlock::from_wire(bytes)
             .map_err(|e| ControllerError::GenesisError(format!("Failed to parse block: {}", e)))?;
         Ok(block)
     }
 
+    // Zero-copy variant of `parse_block`: decodes over the caller's buffer
+    // without copying or unpacking transaction payloads. For consumers that
+    // only need header-level data (id, parent, height, timestamp); call
+    // `SignedBlockRef::into_owned` to get the fully validated owned block.
+    pub fn parse_block_ref<'a>(bytes: &'a [u8]) -> Result<SignedBlockRef<'a>, ControllerError> {
+        let block = SignedBlockRef::from_wire(bytes)
+            .map_err(|e| ControllerError::GenesisError(format!("Failed to parse block: {}", e)))?;
+        Ok(block)
+    }
+
+    // Fastest parse of all: only the signed header is decoded and the
+    // transaction section is kept as undecoded bounds. This is what the
+    // ParseBlock handlers want — consensus votes on header data alone, and
+    // during a storm most parsed blocks are never executed. Call
+    // `LazyBlock::decode_payload` when one is.
+    pub fn parse_block_header<'a>(bytes: &'a [u8]) -> Result<LazyBlock<'a>, ControllerError> {
+        let block = LazyBlock::from_wire(bytes)
+            .map_err(|e| ControllerError::GenesisError(format!("Failed to parse block: {}", e)))?;
+        Ok(block)
+    }
+
+    /// Encodes a block for gossip and the block log in whichever wire
+    /// format this node is configured to emit. Decoding is format-agnostic
+    /// either way, so flipping `block_wire_v2` needs no migration.
+    pub fn pack_block(&self, block: &SignedBlock) -> Result<Vec<u8>, ChainError> {
+        let v2 = self.node_config.as_ref().is_some_and(|c| c.block_wire_v2);
+        if v2 {
+            wire_v2::encode(block)
+                .map_err(|e| ChainError::SerializationError(format!("failed to pack block: {}", e)))
+        } else {
+            block
+                .pack()
+                .map_err(|e| ChainError::SerializationError(format!("failed to pack block: {}", e)))
+        }
+    }
+
     pub fn set_preferred_id(&mut self, id: Id) {
         self.preferred_id = id;
     }
 
+    /// Dispatches native action handlers. The handler set is fixed at
+    /// compile time and every entry lives on the system contract, so one
+    /// pair of u64 compares rejects contract actions and a match over
+    /// constant action names replaces hashing three names per dispatch.
     pub fn find_apply_handler(receiver: &Name, scope: &Name, act: &Name) -> Option<ApplyHandlerFn> {
-        if let Some(handler) = APPLY_HANDLERS.get(&(*receiver, *scope, *act)) {
-            return Some(*handler);
+        if *receiver != PULSE_NAME || *scope != PULSE_NAME {
+            return None;
+        }
+        const NEWACCOUNT: u64 = NEWACCOUNT_NAME.as_u64();
+        const SETCODE: u64 = SETCODE_NAME.as_u64();
+        const SETABI: u64 = SETABI_NAME.as_u64();
+        const UPDATEAUTH: u64 = UPDATEAUTH_NAME.as_u64();
+        const DELETEAUTH: u64 = DELETEAUTH_NAME.as_u64();
+        const LINKAUTH: u64 = LINKAUTH_NAME.as_u64();
+        const UNLINKAUTH: u64 = UNLINKAUTH_NAME.as_u64();
+        match act.as_u64() {
+            NEWACCOUNT => Some(newaccount),
+            SETCODE => Some(setcode),
+            SETABI => Some(setabi),
+            UPDATEAUTH => Some(updateauth),
+            DELETEAUTH => Some(deleteauth),
+            LINKAUTH => Some(linkauth),
+            UNLINKAUTH => Some(unlinkauth),
+            _ => None,
         }
-        None
     }
 
     pub fn get_wasm_runtime(&self) -> &WasmRuntime {
@@ -701,6 +2056,16 @@ impl Controller {
         &self.chain_id
     }
 
+    // Shared handle so admission-side signature recovery warms the same cache
+    // the execution paths read from.
+    pub fn recovery_cache(&self) -> RecoveryCache {
+        self.recovery_cache.clone()
+    }
+
+    pub fn accepted_tx_filter(&self) -> AcceptedTxFilter {
+        self.accepted_tx_filter.clone()
+    }
+
     pub fn calculate_trx_merkle(
         &self,
         receipts: &VecDeque<TransactionReceipt>,
@@ -717,22 +2082,15 @@ impl Controller {
             trx_digests.push_back(digest);
         }
 
-        Ok(merkle(&mut trx_digests))
-    }
-
-    pub fn calculate_action_merkle(
-        &self,
-        digests: &mut VecDeque<Digest>,
-    ) -> Result<Digest, ChainError> {
-        Ok(merkle(digests))
+        Ok(merkle_parallel(&mut trx_digests))
     }
 
     pub fn trace_log(&self) -> Option<&StateHistoryLog> {
-        self.trace_log.as_ref()
+        self.trace_log.as_deref()
     }
 
     pub fn chain_state_log(&self) -> Option<&StateHistoryLog> {
-        self.chain_state_log.as_ref()
+        self.chain_state_log.as_deref()
     }
 
     pub async fn get_block_id(&self, block_num: u32) -> Result<Option<Id>, ChainError> {
@@ -763,63 +2121,180 @@ impl Controller {
 
     pub fn block_log(&self) -> Result<&StateHistoryLog, ChainError> {
         self.block_log
-            .as_ref()
+            .as_deref()
             .ok_or_else(|| ChainError::InternalError("block log not initialized".to_string()))
     }
 
     pub fn store_traces(
         &mut self,
         block_id: &Id,
-        transaction_traces: &Vec<TransactionTrace>,
+        transaction_traces: Arc<Vec<TransactionTrace>>,
     ) -> Result<(), ChainError> {
-        match &self.trace_log {
-            None => {
-                return Err(ChainError::InternalError(
-                    "trace log not initialized".to_string(),
-                ));
-            }
-            Some(trace_log) => {
-                let packed_transaction_traces = transaction_traces.pack().map_err(|e| {
-                    ChainError::TransactionError(format!(
-                        "failed to pack transaction traces for block {}: {}",
-                        block_id, e
-                    ))
-                })?;
+        let trace_log = self.trace_log.as_ref().ok_or_else(|| {
+            ChainError::InternalError("trace log not initialized".to_string())
+        })?;
+        let writer = self.sh_writer.as_ref().ok_or_else(|| {
+            ChainError::InternalError("state-history writer not running".to_string())
+        })?;
 
-                trace_log
-                    .append(block_id.clone(), &packed_transaction_traces)
-                    .map_err(|e| {
-                        ChainError::InternalError(format!("failed to append to trace log: {}", e))
-                    })?;
+        // Traces are handed over unpacked; the writer thread serializes
+        // and appends them, so neither cost lands on block acceptance. The
+        // writer also files each trace's payload offset in the trace index
+        // and each delivered action in the account-action index.
+        writer.submit_traces(
+            trace_log,
+            block_id.clone(),
+            transaction_traces,
+            self.trace_index.clone(),
+            self.account_index.clone(),
+        );
 
-                return Ok(());
+        // Tiered retention: each accepted block funds one bounded
+        // reduction pass on the writer thread, so traces aging out of the
+        // full window trickle into the reduced tier continuously instead
+        // of being rewritten in one spike.
+        if let Some(full_blocks) = self
+            .node_config
+            .as_ref()
+            .and_then(|c| c.trace_log_full_blocks)
+        {
+            let block_num = u32::from_be_bytes(block_id.0.0[0..4].try_into().unwrap());
+            if block_num > full_blocks {
+                writer.submit_trace_reduction(trace_log, block_num - full_blocks + 1);
             }
         }
+        Ok(())
     }
 
-    pub fn store_chain_state(&mut self, block_id: &Id) -> Result<(), ChainError> {
-        match &self.chain_state_log {
-            None => {
-                return Err(ChainError::InternalError(
-                    "chain state log not initialized".to_string(),
-                ));
-            }
-            Some(chain_state_log) => {
-                let fresh = chain_state_log.range().is_none();
-                let chain_state = self.db.pack_deltas(fresh)?;
-
-                chain_state_log
-                    .append(block_id.clone(), &chain_state)
-                    .map_err(|e| {
-                        ChainError::InternalError(format!(
-                            "failed to append to chain state log: {}",
-                            e
-                        ))
-                    })?;
+    /// Trace of one transaction: an index probe for (block num, payload
+    /// offset), then one read of the owning block's trace payload with
+    /// deserialization starting straight at the stored offset. `None` for
+    /// transactions this node never traced (or traced before the index
+    /// existed).
+    ///
+    /// Indexed offsets point into the full payload; once tiered retention
+    /// has reduced a block its traces were re-packed and shifted, so a
+    /// failed or mismatched offset probe falls back to scanning the
+    /// block's traces by id — old blocks pay a linear pass, the recent
+    /// ones the index was built for stay one read.
+    pub fn get_transaction_trace(&self, id: &Id) -> Result<Option<TransactionTrace>, ChainError> {
+        let Some(index) = self.trace_index.as_ref() else {
+            return Ok(None);
+        };
+        let Some((block_num, offset)) = index.lookup(id) else {
+            return Ok(None);
+        };
+        let trace_log = self.trace_log().ok_or_else(|| {
+            ChainError::InternalError("trace log not initialized".to_string())
+        })?;
+        let trace = trace_log
+            .read_block_with(block_num, |payload| {
+                let mut pos = offset as usize;
+                match TransactionTrace::read(payload, &mut pos) {
+                    Ok(trace) if &trace.id == id => Ok(Some(trace)),
+                    _ => find_trace_by_id(payload, id),
+                }
+            })
+            .map_err(|e| {
+                ChainError::InternalError(format!(
+                    "failed to read trace block {}: {}",
+                    block_num, e
+                ))
+            })?
+            .map_err(|e| {
+                ChainError::InternalError(format!(
+                    "failed to unpack trace for {} in block {}: {:?}",
+                    id, block_num, e
+                ))
+            })?;
+        let Some(trace) = trace else {
+            return Err(ChainError::InternalError(format!(
+                "trace index entry for {} points at block {} which holds no such trace",
+                id, block_num
+            )));
+        };
+        Ok(Some(trace))
+    }
 
-                return Ok(());
-            }
+    /// One page of an account's delivered actions, ordered by receive
+    /// sequence starting at `pos`, plus the account's total indexed
+    /// count. Each returned action costs one index slice probe and one
+    /// `read_block_with` of its owning block, deserializing the owning
+    /// trace straight at its stored offset — no trace-log range replay.
+    pub fn get_account_actions(
+        &self,
+        account: &Name,
+        pos: u64,
+        limit: usize,
+    ) -> Result<(Vec<ActionTrace>, u64), ChainError> {
+        let Some(index) = self.account_index.as_ref() else {
+            return Ok((Vec::new(), 0));
+        };
+        let (entries, total) = index.read_page(account.as_u64(), pos, limit);
+        if entries.is_empty() {
+            return Ok((Vec::new(), total));
+        }
+        let trace_log = self
+            .trace_log()
+            .ok_or_else(|| ChainError::InternalError("trace log not initialized".to_string()))?;
+        let mut actions = Vec::with_capacity(entries.len());
+        for entry in entries {
+            // Same staleness rule as `get_transaction_trace`: a reduced
+            // block shifted every stored offset, so a failed probe falls
+            // back to matching the delivered action by receiver and
+            // receive sequence, which survive reduction in the receipt.
+            let action = trace_log
+                .read_block_with(entry.block_num, |payload| {
+                    let mut read_pos = entry.offset as usize;
+                    if let Ok(trace) = TransactionTrace::read(payload, &mut read_pos) {
+                        if let Some(action) = trace
+                            .action_traces()
+                            .iter()
+                            .find(|at| at.action_ordinal == entry.action_ordinal)
+                        {
+                            return Ok(Some(action.clone()));
+                        }
+                    }
+                    find_action_by_receipt(payload, account.as_u64(), entry.recv_sequence)
+                })
+                .map_err(|e| {
+                    ChainError::InternalError(format!(
+                        "failed to read trace block {}: {}",
+                        entry.block_num, e
+                    ))
+                })?
+                .map_err(|e| {
+                    ChainError::InternalError(format!(
+                        "failed to unpack trace at block {} offset {}: {:?}",
+                        entry.block_num, entry.offset, e
+                    ))
+                })?
+                .ok_or_else(|| {
+                    ChainError::InternalError(format!(
+                        "account index entry for {} seq {} points at missing ordinal {} in block {}",
+                        account, entry.recv_sequence, entry.action_ordinal, entry.block_num
+                    ))
+                })?;
+            actions.push(action);
         }
+        Ok((actions, total))
+    }
+
+    pub fn store_chain_state(&mut self, block_id: &Id) -> Result<(), ChainError> {
+        let chain_state_log = self.chain_state_log.as_ref().ok_or_else(|| {
+            ChainError::InternalError("chain state log not initialized".to_string())
+        })?;
+        let writer = self.sh_writer.as_ref().ok_or_else(|| {
+            ChainError::InternalError("state-history writer not running".to_string())
+        })?;
+
+        // Deltas must be packed now, against the database as of this
+        // block; only the append itself moves to the writer thread.
+        let fresh = self.chain_state_fresh;
+        let chain_state = self.db.pack_deltas(fresh)?;
+        self.chain_state_fresh = false;
+        writer.submit(chain_state_log, block_id.clone(), chain_state);
+        Ok(())
     }
 
     pub fn set_state(&mut self, state: vm::State) {
@@ -845,14 +2320,14 @@ impl Controller {
         while cursor != self.last_accepted_block_id {
             let block = self
                 .verified_blocks
-                .get(&cursor)
+                .read()?
+                .get(&cursor)?
                 .ok_or_else(|| {
                     ChainError::NetworkError(format!(
                         "block {} not found in verified blocks",
                         cursor
                     ))
-                })?
-                .clone();
+                })?;
             let prev = block.previous_id().clone();
             path.push(block);
             cursor = prev;
@@ -870,6 +2345,141 @@ impl Controller {
 
         Ok(())
     }
+
+    /// Re-executes blocks `first..=last` from the block log to bring the
+    /// state database back up to the log head. The replay is pipelined: a
+    /// reader thread reads and decodes blocks ahead through a bounded
+    /// channel while this thread executes fully prepared blocks, so log
+    /// I/O and deserialization overlap execution. Everything in the log is
+    /// below the trusted irreversible height, so blocks run with
+    /// `BlockStatus::Replaying`, which skips signature recovery and
+    /// authority checks wholly. Each block is committed individually; an
+    /// interrupted replay resumes from wherever the revision stopped.
+    fn replay_block_log(&mut self, first: u32, last: u32) -> Result<(), ChainError> {
+        /// Blocks the reader may decode ahead of execution.
+        const REPLAY_PIPELINE_DEPTH: usize = 16;
+
+        info!("replaying blocks {} to {} from the block log", first, last);
+
+        // Anchor on the block just below the gap so pending block numbers
+        // line up during execution.
+        let anchor = self.get_block_by_height(first - 1)?.ok_or_else(|| {
+            ChainError::DatabaseError(format!(
+                "failed to retrieve replay anchor block at height {}",
+                first - 1
+            ))
+        })?;
+        self.set_last_accepted(anchor)?;
+
+        let block_log = self
+            .block_log
+            .clone()
+            .ok_or_else(|| ChainError::InternalError("block log not initialized".to_string()))?;
+        let (tx, rx) = std::sync::mpsc::sync_channel::<Result<SignedBlock, ChainError>>(
+            REPLAY_PIPELINE_DEPTH,
+        );
+        let reader = std::thread::Builder::new()
+            .name("replay-reader".to_string())
+            .spawn(move || {
+                for height in first..=last {
+                    let decode_timer = EXEC_PHASES.timer(Phase::Decode);
+                    let block = block_log
+                        .read_block(height)
+                        .map_err(|e| {
+                            ChainError::InternalError(format!(
+                                "failed to read block {} from block log: {}",
+                                height, e
+                            ))
+                        })
+                        .and_then(|bytes| Ok(SignedBlock::from_wire(&bytes)?));
+                    drop(decode_timer);
+                    let failed = block.is_err();
+                    if tx.send(block).is_err() || failed {
+                        // Execution stopped early, or nothing further can
+                        // decode; either way the pipeline is done.
+                        break;
+                    }
+                }
+            })
+            .map_err(|e| {
+                ChainError::InternalError(format!("failed to spawn replay reader: {}", e))
+            })?;
+
+        // Scratch mempool: `Replaying` never touches it.
+        let mut mempool = Mempool::new();
+        let block_status = BlockStatus::Replaying;
+        let result = (|| -> Result<(), ChainError> {
+            while let Ok(block) = rx.recv() {
+                let block = block?;
+                let mut root_session = self.db.create_undo_session(true)?;
+                self.execute_block(&block, &block_status, &mut mempool)?;
+                let commit_timer = EXEC_PHASES.timer(Phase::Commit);
+                root_session.pin_mut().push().map_err(|e| {
+                    ChainError::TransactionError(format!("failed to commit block: {}", e))
+                })?;
+                self.set_last_accepted(block)?;
+                self.db
+                    .commit(self.last_accepted_block.block_num() as i64)?;
+                drop(commit_timer);
+
+                let block_num = self.last_accepted_block.block_num();
+                if block_num % 1000 == 0 {
+                    info!("replayed up to block {} of {}", block_num, last);
+                }
+            }
+            Ok(())
+        })();
+
+        // Unblock the reader if execution bailed out early, then reap it.
+        drop(rx);
+        let _ = reader.join();
+        result?;
+
+        info!("replayed {} blocks from the block log", last - first + 1);
+        Ok(())
+    }
+}
+
+/// Linear scan of a block's trace payload for the trace with the given
+/// transaction id. The fallback path for index offsets staled by trace
+/// reduction; ids survive reduction, offsets do not.
+fn find_trace_by_id(
+    payload: &[u8],
+    id: &Id,
+) -> Result<Option<TransactionTrace>, pulsevm_serialization::ReadError> {
+    let mut pos = 0usize;
+    let count = usize::read(payload, &mut pos)?;
+    for _ in 0..count {
+        let trace = TransactionTrace::read(payload, &mut pos)?;
+        if &trace.id == id {
+            return Ok(Some(trace));
+        }
+    }
+    Ok(None)
+}
+
+/// Linear scan of a block's trace payload for the action delivered to
+/// `receiver` at `recv_sequence`. Both live in the action receipt, which
+/// trace reduction keeps, so this recovers account-index entries whose
+/// stored offset and ordinal no longer line up.
+fn find_action_by_receipt(
+    payload: &[u8],
+    receiver: u64,
+    recv_sequence: u64,
+) -> Result<Option<ActionTrace>, pulsevm_serialization::ReadError> {
+    let mut pos = 0usize;
+    let count = usize::read(payload, &mut pos)?;
+    for _ in 0..count {
+        let trace = TransactionTrace::read(payload, &mut pos)?;
+        if let Some(action) = trace.action_traces().iter().find(|at| {
+            at.receipt.as_ref().is_some_and(|r| {
+                r.receiver.as_u64() == receiver && r.recv_sequence == recv_sequence
+            })
+        }) {
+            return Ok(Some(action.clone()));
+        }
+    }
+    Ok(None)
 }
 
 #[cfg(test)]
@@ -896,6 +2506,7 @@ mod tests {
     };
 
     use super::*;
+    use pulsevm_name_macro::name;
 
     #[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
     struct Create {
@@ -957,10 +2568,10 @@ mod tests {
             TransactionHeader::new(TimePointSec::maximum(), 0, 0, 0u32.into(), 0, 0u32.into()),
             vec![],
             vec![Action::new(
-                Name::from_str("pulse")?,
-                Name::from_str("newaccount")?,
+                Name::new(name!("pulse")),
+                Name::new(name!("newaccount")),
                 NewAccount {
-                    creator: Name::from_str("pulse")?,
+                    creator: Name::new(name!("pulse")),
                     name: account,
                     owner: Authority::new(
                         1,
@@ -998,8 +2609,8 @@ mod tests {
             TransactionHeader::new(TimePointSec::maximum(), 0, 0, 0u32.into(), 0, 0u32.into()),
             vec![],
             vec![Action::new(
-                Name::from_str("pulse").unwrap(),
-                Name::from_str("setcode").unwrap(),
+                Name::new(name!("pulse")),
+                Name::new(name!("setcode")),
                 SetCode {
                     account,
                     vm_type: 0,
@@ -1065,12 +2676,12 @@ mod tests {
         let chain_id = controller.chain_id().clone();
         let block_status = BlockStatus::Building;
         controller.execute_transaction(
-            &create_account(&private_key, Name::from_str("glenn")?, chain_id)?,
+            &create_account(&private_key, Name::new(name!("glenn")), chain_id)?,
             &pending_block_timestamp,
             &block_status,
         )?;
         controller.execute_transaction(
-            &create_account(&private_key, Name::from_str("marshall")?, chain_id)?,
+            &create_account(&private_key, Name::new(name!("marshall")), chain_id)?,
             &pending_block_timestamp,
             &block_status,
         )?;
@@ -1085,7 +2696,7 @@ mod tests {
         controller.execute_transaction(
             &set_code(
                 &private_key,
-                Name::from_str("glenn")?,
+                Name::new(name!("glenn")),
                 pulse_token_contract,
                 chain_id,
             )?,
@@ -1096,10 +2707,10 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("glenn")?,
-                Name::from_str("create")?,
+                Name::new(name!("glenn")),
+                Name::new(name!("create")),
                 &Create {
-                    issuer: Name::from_str("glenn")?,
+                    issuer: Name::new(name!("glenn")),
                     max_supply: Asset::new(1000000, Symbol(1162826500)),
                 },
                 chain_id,
@@ -1111,10 +2722,10 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("glenn")?,
-                Name::from_str("issue")?,
+                Name::new(name!("glenn")),
+                Name::new(name!("issue")),
                 &Issue {
-                    to: Name::from_str("glenn")?,
+                    to: Name::new(name!("glenn")),
                     quantity: Asset {
                         amount: 1000000,
                         symbol: Symbol(1162826500), // "PLUS" in ASCII
@@ -1130,11 +2741,11 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("glenn")?,
-                Name::from_str("transfer")?,
+                Name::new(name!("glenn")),
+                Name::new(name!("transfer")),
                 &Transfer {
-                    from: Name::from_str("glenn")?,
-                    to: Name::from_str("marshall")?,
+                    from: Name::new(name!("glenn")),
+                    to: Name::new(name!("marshall")),
                     quantity: Asset {
                         amount: 5000,
                         symbol: Symbol(1162826500), // "PLUS" in ASCII
@@ -1181,12 +2792,12 @@ mod tests {
         let chain_id = controller.chain_id().clone();
         let block_status = BlockStatus::Building;
         controller.execute_transaction(
-            &create_account(&private_key, Name::from_str("testapi")?, chain_id)?,
+            &create_account(&private_key, Name::new(name!("testapi")), chain_id)?,
             &pending_block_timestamp,
             &block_status,
         )?;
         controller.execute_transaction(
-            &create_account(&private_key, Name::from_str("testapi2")?, chain_id)?,
+            &create_account(&private_key, Name::new(name!("testapi2")), chain_id)?,
             &pending_block_timestamp,
             &block_status,
         )?;
@@ -1200,7 +2811,7 @@ mod tests {
         controller.execute_transaction(
             &set_code(
                 &private_key,
-                Name::from_str("testapi")?,
+                Name::new(name!("testapi")),
                 contract.clone(),
                 chain_id,
             )?,
@@ -1210,7 +2821,7 @@ mod tests {
         controller.execute_transaction(
             &set_code(
                 &private_key,
-                Name::from_str("testapi2")?,
+                Name::new(name!("testapi2")),
                 contract,
                 chain_id,
             )?,
@@ -1221,8 +2832,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("pg")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("pg")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1232,8 +2843,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("pl")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("pl")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1243,8 +2854,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("pu")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("pu")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1254,8 +2865,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1g")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1g")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1265,8 +2876,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1l")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1l")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1276,8 +2887,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1u")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1u")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1296,10 +2907,10 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("tia")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("tia")),
                 &TestInvalidAccess {
-                    code: Name::from_str("testapi")?,
+                    code: Name::new(name!("testapi")),
                     val: 10,
                     index: 0,
                     store: true,
@@ -1313,10 +2924,10 @@ mod tests {
         let mut result = controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi2")?,
-                Name::from_str("tia")?,
+                Name::new(name!("testapi2")),
+                Name::new(name!("tia")),
                 &TestInvalidAccess {
-                    code: Name::from_str("testapi")?,
+                    code: Name::new(name!("testapi")),
                     val: 20,
                     index: 0,
                     store: true,
@@ -1332,10 +2943,10 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("tia")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("tia")),
                 &TestInvalidAccess {
-                    code: Name::from_str("testapi")?,
+                    code: Name::new(name!("testapi")),
                     val: 10,
                     index: 0,
                     store: false,
@@ -1348,10 +2959,10 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("tia")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("tia")),
                 &TestInvalidAccess {
-                    code: Name::from_str("testapi")?,
+                    code: Name::new(name!("testapi")),
                     val: 10,
                     index: 1,
                     store: true,
@@ -1365,10 +2976,10 @@ mod tests {
         result = controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi2")?,
-                Name::from_str("tia")?,
+                Name::new(name!("testapi2")),
+                Name::new(name!("tia")),
                 &TestInvalidAccess {
-                    code: Name::from_str("testapi")?,
+                    code: Name::new(name!("testapi")),
                     val: 20,
                     index: 1,
                     store: true,
@@ -1384,10 +2995,10 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("tia")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("tia")),
                 &TestInvalidAccess {
-                    code: Name::from_str("testapi")?,
+                    code: Name::new(name!("testapi")),
                     val: 10,
                     index: 1,
                     store: false,
@@ -1432,12 +3043,12 @@ mod tests {
         let chain_id = controller.chain_id().clone();
         let block_status = BlockStatus::Building;
         controller.execute_transaction(
-            &create_account(&private_key, Name::from_str("testapi")?, chain_id)?,
+            &create_account(&private_key, Name::new(name!("testapi")), chain_id)?,
             &pending_block_timestamp,
             &block_status,
         )?;
         controller.execute_transaction(
-            &create_account(&private_key, Name::from_str("testapi2")?, chain_id)?,
+            &create_account(&private_key, Name::new(name!("testapi2")), chain_id)?,
             &pending_block_timestamp,
             &block_status,
         )?;
@@ -1452,7 +3063,7 @@ mod tests {
         controller.execute_transaction(
             &set_code(
                 &private_key,
-                Name::from_str("testapi")?,
+                Name::new(name!("testapi")),
                 contract.clone(),
                 chain_id,
             )?,
@@ -1463,8 +3074,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1g")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1g")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1475,8 +3086,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1store")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1store")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1487,8 +3098,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1check")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1check")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1499,8 +3110,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s2g")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s2g")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1511,8 +3122,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s2store")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s2store")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1523,8 +3134,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s2check")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s2check")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1535,8 +3146,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s2autoinc")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s2autoinc")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1547,8 +3158,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s2autoinc1")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s2autoinc1")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1559,8 +3170,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s2autoinc2")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s2autoinc2")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1571,8 +3182,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s3g")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s3g")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1583,8 +3194,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("sdg")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("sdg")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1595,8 +3206,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("sldg")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("sldg")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1608,7 +3219,7 @@ mod tests {
             let result = controller.execute_transaction(
                 &call_contract(
                     &private_key,
-                    Name::from_str("testapi").unwrap(),
+                    Name::new(name!("testapi")),
                     Name::from_str(action).unwrap(),
                     &Vec::<u8>::new(),
                     chain_id,
@@ -1716,8 +3327,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1skcache")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1skcache")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1728,8 +3339,8 @@ mod tests {
         controller.execute_transaction(
             &call_contract(
                 &private_key,
-                Name::from_str("testapi")?,
-                Name::from_str("s1pkcache")?,
+                Name::new(name!("testapi")),
+                Name::new(name!("s1pkcache")),
                 &Vec::<u8>::new(),
                 chain_id,
             )?,
@@ -1773,7 +3384,7 @@ mod tests {
                 1,
                 1.into(),
             ),
-            create_account(&private_key, Name::from_str("testapi")?, chain_id)?,
+            create_account(&private_key, Name::new(name!("testapi")), chain_id)?,
         ));
         let block = SignedBlock::new(
             controller.last_accepted_block().id()?,
@@ -1817,7 +3428,7 @@ mod tests {
         let chain_id = controller.chain_id().clone();
         let block_status = BlockStatus::Building;
         let result = controller.push_transaction(
-            &create_account(&private_key, Name::from_str("testapi")?, chain_id)?,
+            &create_account(&private_key, Name::new(name!("testapi")), chain_id)?,
             &pending_block_timestamp,
             &block_status,
         )?;
@@ -0,0 +1,64 @@
+//! CPU pinning for execution worker threads.
+//!
+//! On dual-socket validators, a worker scheduled onto the remote socket
+//! pays roughly double for every chainbase page and wasm linear-memory
+//! access. Pinning the execution workers to a configured CPU list keeps
+//! them on the package that owns those pages: Linux allocates anonymous
+//! pages on the node that first touches them, so once the workers are
+//! pinned, the wasm memory pool's recycled regions and the warm parts of
+//! the database mapping settle node-local on their own. Pair this with
+//! `db_numa_interleave` only when the state is deliberately spread across
+//! both sockets.
+//!
+//! The CPU list comes from `NodeConfig::exec_cpu_affinity` and is set once
+//! at controller initialization. Workers are striped over the list by
+//! worker index, so a pool of the same size lands on the same cores block
+//! after block — that stable worker-to-core mapping is what gives lanes
+//! their cache and NUMA stickiness.
+
+use std::sync::OnceLock;
+
+use spdlog::warn;
+
+static EXEC_CPUS: OnceLock<Vec<usize>> = OnceLock::new();
+
+/// Installs the CPU list execution workers pin to. Empty lists are
+/// ignored; a second call is too (the config is parsed once).
+pub fn set_exec_cpus(cpus: Vec<usize>) {
+    if cpus.is_empty() {
+        return;
+    }
+    let _ = EXEC_CPUS.set(cpus);
+}
+
+/// The CPU worker `worker` should run on, striped round-robin over the
+/// configured list; `None` when no affinity is configured.
+pub fn exec_cpu_for(worker: usize) -> Option<usize> {
+    EXEC_CPUS.get().map(|cpus| cpus[worker % cpus.len()])
+}
+
+/// Pins the calling thread to worker `worker`'s CPU. A no-op without
+/// configuration; a failed pin is logged and execution proceeds unpinned —
+/// affinity is a performance knob, never a correctness requirement.
+pub fn pin_worker(worker: usize) {
+    if let Some(cpu) = exec_cpu_for(worker) {
+        if !pin_current_thread(cpu) {
+            warn!("failed to pin execution worker {} to cpu {}", worker, cpu);
+        }
+    }
+}
+
+#[cfg(target_os = "linux")]
+fn pin_current_thread(cpu: usize) -> bool {
+    unsafe {
+        let mut set: libc::cpu_set_t = std::mem::zeroed();
+        libc::CPU_SET(cpu, &mut set);
+        // 0 pins the calling thread.
+        libc::sched_setaffinity(0, std::mem::size_of::<libc::cpu_set_t>(), &set) == 0
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn pin_current_thread(_cpu: usize) -> bool {
+    false
+}
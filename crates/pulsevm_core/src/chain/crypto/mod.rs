@@ -6,3 +6,6 @@ pub use public_key::PublicKey;
 
 mod signature;
 pub use signature::Signature;
+
+mod signing_provider;
+pub use signing_provider::{InProcessSigningProvider, SigningProvider};
@@ -75,8 +75,12 @@ impl<'de> Deserialize<'de> for PublicKey {
         D: serde::Deserializer<'de>,
     {
         let s = String::deserialize(deserializer)?;
-        let cxx_key = pulsevm_ffi::parse_public_key(&s)
-            .map_err(|e| serde::de::Error::custom(format!("Failed to parse public key: {}", e)))?;
+        let cxx_key = pulsevm_ffi::parse_public_key(&s).map_err(|e| {
+            serde::de::Error::custom(format!(
+                "Failed to parse public key: {}",
+                pulsevm_ffi::strip_error_code(e.what())
+            ))
+        })?;
         Ok(PublicKey { inner: cxx_key })
     }
 }
@@ -99,8 +103,9 @@ impl NumBytes for PublicKey {
 impl Read for PublicKey {
     fn read(bytes: &[u8], pos: &mut usize) -> Result<Self, ReadError> {
         let packed = FixedBytes::<34>::read(bytes, pos)?;
-        let cxx_key = pulsevm_ffi::parse_public_key_from_bytes(packed.as_ref())
-            .map_err(|e| ReadError::CustomError(e.to_string()))?;
+        let cxx_key = pulsevm_ffi::parse_public_key_from_bytes(packed.as_ref()).map_err(|e| {
+            ReadError::CustomError(pulsevm_ffi::strip_error_code(e.what()).to_string())
+        })?;
         Ok(PublicKey { inner: cxx_key })
     }
 }
@@ -124,8 +129,9 @@ impl FromStr for PublicKey {
     type Err = ChainError;
 
     fn from_str(s: &str) -> Result<Self, Self::Err> {
-        let cxx_key =
-            pulsevm_ffi::parse_public_key(s).map_err(|e| ChainError::ParseError(e.to_string()))?;
+        let cxx_key = pulsevm_ffi::parse_public_key(s).map_err(|e| {
+            ChainError::ParseError(pulsevm_ffi::strip_error_code(e.what()).to_string())
+        })?;
         Ok(PublicKey { inner: cxx_key })
     }
 }
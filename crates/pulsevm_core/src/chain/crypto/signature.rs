@@ -24,8 +24,9 @@ impl Signature {
     }
 
     pub fn recover_public_key(&self, digest: &Digest) -> Result<PublicKey, ChainError> {
-        let cxx_pk = recover_public_key_from_signature(&self.inner, &digest)
-            .map_err(|e| ChainError::TransactionError(e.to_string()))?;
+        let cxx_pk = recover_public_key_from_signature(&self.inner, &digest).map_err(|e| {
+            ChainError::TransactionError(pulsevm_ffi::strip_error_code(e.what()).to_string())
+        })?;
         Ok(PublicKey::new(cxx_pk))
     }
 }
@@ -95,8 +96,12 @@ impl<'de> Deserialize<'de> for Signature {
             where
                 E: serde::de::Error,
             {
-                let cxx_sig = pulsevm_ffi::parse_signature(v)
-                    .map_err(|e| E::custom(format!("failed to parse signature: {}", e)))?;
+                let cxx_sig = pulsevm_ffi::parse_signature(v).map_err(|e| {
+                    E::custom(format!(
+                        "failed to parse signature: {}",
+                        pulsevm_ffi::strip_error_code(e.what())
+                    ))
+                })?;
                 Ok(Signature { inner: cxx_sig })
             }
         }
@@ -114,8 +119,9 @@ impl NumBytes for Signature {
 impl Read for Signature {
     fn read(bytes: &[u8], pos: &mut usize) -> Result<Self, ReadError> {
         let packed = FixedBytes::<66>::read(bytes, pos)?;
-        let cxx_key = pulsevm_ffi::parse_signature_from_bytes(packed.as_ref())
-            .map_err(|e| ReadError::CustomError(e.to_string()))?;
+        let cxx_key = pulsevm_ffi::parse_signature_from_bytes(packed.as_ref()).map_err(|e| {
+            ReadError::CustomError(pulsevm_ffi::strip_error_code(e.what()).to_string())
+        })?;
         Ok(Signature { inner: cxx_key })
     }
 }
@@ -143,7 +149,10 @@ impl FromStr for Signature {
 
     fn from_str(s: &str) -> Result<Self, Self::Err> {
         let cxx_sig = pulsevm_ffi::parse_signature(s).map_err(|e| {
-            ChainError::TransactionError(format!("failed to parse signature: {}", e))
+            ChainError::TransactionError(format!(
+                "failed to parse signature: {}",
+                pulsevm_ffi::strip_error_code(e.what())
+            ))
         })?;
         Ok(Signature { inner: cxx_sig })
     }
@@ -0,0 +1,60 @@
+use pulsevm_error::ChainError;
+
+use crate::{
+    crypto::{PrivateKey, PublicKey, Signature},
+    utils::Digest,
+};
+
+/// Source of block-producer signatures. The block production path signs
+/// through this trait instead of a concrete key so the producer key can be
+/// held wherever the deployment wants — in process for the hot path, or
+/// behind an external wallet for setups that require it — without the
+/// controller knowing the difference.
+pub trait SigningProvider: Send + Sync {
+    /// The public key signatures from this provider recover to.
+    fn public_key(&self) -> PublicKey;
+
+    /// Sign a digest with the producer key.
+    fn sign(&self, digest: &Digest) -> Result<Signature, ChainError>;
+}
+
+/// Signing provider that keeps the producer key resident in the node
+/// process, so signing a block is a local secp256k1 operation instead of a
+/// round trip to a wallet daemon. The key lives behind the FFI shared
+/// pointer for the lifetime of the node and is never serialized or logged
+/// (`PrivateKey`'s `Debug` only prints the public key). External wallets
+/// such as keosd remain the right tool for interactive and API signing;
+/// the block cadence is too hot to leave the process.
+pub struct InProcessSigningProvider {
+    key: PrivateKey,
+}
+
+impl InProcessSigningProvider {
+    pub fn new(key: PrivateKey) -> Self {
+        InProcessSigningProvider { key }
+    }
+}
+
+impl SigningProvider for InProcessSigningProvider {
+    fn public_key(&self) -> PublicKey {
+        self.key.get_public_key()
+    }
+
+    fn sign(&self, digest: &Digest) -> Result<Signature, ChainError> {
+        self.key.sign(digest)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_in_process_signatures_recover_to_provider_key() {
+        let provider = InProcessSigningProvider::new(PrivateKey::random());
+        let digest: Digest = [0x42u8; 32].into();
+        let signature = provider.sign(&digest).unwrap();
+        let recovered = signature.recover_public_key(&digest).unwrap();
+        assert_eq!(recovered, provider.public_key());
+    }
+}
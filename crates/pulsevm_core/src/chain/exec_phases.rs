@@ -0,0 +1,145 @@
+use std::{
+    sync::{
+        LazyLock,
+        atomic::{AtomicBool, AtomicU64, Ordering},
+    },
+    time::{Duration, Instant},
+};
+
+/// Wall time spent in each phase of block execution, process-wide.
+///
+/// The collector exists for differential benchmarking: replaying the same
+/// captured blocks against two builds and diffing these totals says which
+/// phase a change actually moved, where an end-to-end blocks-per-second
+/// number cannot. It is disabled by default — recording is then a relaxed
+/// load and a branch — and enabled by the shadow-bench driver (or anything
+/// else that wants the breakdown) via `set_enabled`.
+///
+/// Phase boundaries follow the natural seams of the execution path: block
+/// decode, signature recovery plus authorization checks, guest wasm
+/// execution, the native remainder of action apply (handlers and chainbase
+/// intrinsics, which is not separable from them without per-call timers),
+/// merkle root computation, and undo-session commit. Replayed blocks skip
+/// signature and authorization checks by design, so the auth phase reads
+/// zero under replay.
+pub static EXEC_PHASES: LazyLock<ExecPhases> = LazyLock::new(ExecPhases::new);
+
+#[derive(Clone, Copy)]
+pub enum Phase {
+    Decode = 0,
+    Auth,
+    Wasm,
+    Apply,
+    Merkle,
+    Commit,
+}
+
+const NUM_PHASES: usize = 6;
+
+pub const PHASE_NAMES: [&str; NUM_PHASES] =
+    ["decode", "auth", "wasm", "apply", "merkle", "commit"];
+
+/// Point-in-time totals, index-aligned with [`PHASE_NAMES`].
+#[derive(Clone, Copy, Default)]
+pub struct PhaseSnapshot {
+    pub total_us: [u64; NUM_PHASES],
+    pub counts: [u64; NUM_PHASES],
+}
+
+pub struct ExecPhases {
+    enabled: AtomicBool,
+    total_us: [AtomicU64; NUM_PHASES],
+    counts: [AtomicU64; NUM_PHASES],
+}
+
+impl ExecPhases {
+    fn new() -> Self {
+        Self {
+            enabled: AtomicBool::new(false),
+            total_us: [const { AtomicU64::new(0) }; NUM_PHASES],
+            counts: [const { AtomicU64::new(0) }; NUM_PHASES],
+        }
+    }
+
+    pub fn set_enabled(&self, enabled: bool) {
+        self.enabled.store(enabled, Ordering::Relaxed);
+    }
+
+    pub fn is_enabled(&self) -> bool {
+        self.enabled.load(Ordering::Relaxed)
+    }
+
+    pub fn record(&self, phase: Phase, elapsed: Duration) {
+        if !self.is_enabled() {
+            return;
+        }
+        let idx = phase as usize;
+        self.total_us[idx].fetch_add(elapsed.as_micros() as u64, Ordering::Relaxed);
+        self.counts[idx].fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Scope guard timing one phase span; records on drop. When the
+    /// collector is disabled the guard never reads the clock.
+    pub fn timer(&'static self, phase: Phase) -> PhaseTimer {
+        PhaseTimer {
+            phases: self,
+            phase,
+            start: self.is_enabled().then(Instant::now),
+        }
+    }
+
+    pub fn snapshot(&self) -> PhaseSnapshot {
+        let mut snap = PhaseSnapshot::default();
+        for i in 0..NUM_PHASES {
+            snap.total_us[i] = self.total_us[i].load(Ordering::Relaxed);
+            snap.counts[i] = self.counts[i].load(Ordering::Relaxed);
+        }
+        snap
+    }
+
+    pub fn reset(&self) {
+        for i in 0..NUM_PHASES {
+            self.total_us[i].store(0, Ordering::Relaxed);
+            self.counts[i].store(0, Ordering::Relaxed);
+        }
+    }
+}
+
+pub struct PhaseTimer {
+    phases: &'static ExecPhases,
+    phase: Phase,
+    start: Option<Instant>,
+}
+
+impl Drop for PhaseTimer {
+    fn drop(&mut self) {
+        if let Some(start) = self.start {
+            self.phases.record(self.phase, start.elapsed());
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn disabled_collector_records_nothing() {
+        let phases = ExecPhases::new();
+        phases.record(Phase::Wasm, Duration::from_micros(100));
+        assert_eq!(phases.snapshot().counts[Phase::Wasm as usize], 0);
+    }
+
+    #[test]
+    fn records_and_resets() {
+        let phases = ExecPhases::new();
+        phases.set_enabled(true);
+        phases.record(Phase::Merkle, Duration::from_micros(250));
+        phases.record(Phase::Merkle, Duration::from_micros(250));
+        let snap = phases.snapshot();
+        assert_eq!(snap.total_us[Phase::Merkle as usize], 500);
+        assert_eq!(snap.counts[Phase::Merkle as usize], 2);
+        phases.reset();
+        assert_eq!(phases.snapshot().counts[Phase::Merkle as usize], 0);
+    }
+}
@@ -0,0 +1,256 @@
+use std::{
+    collections::{HashMap, VecDeque},
+    sync::{LazyLock, Mutex},
+    time::Duration,
+};
+
+use crate::chain::name::Name;
+
+// Sealed per-block cost maps kept for querying; at one block every two
+// seconds this is a bit over four minutes of history.
+const RETAINED_BLOCKS: usize = 128;
+
+// Distinct (receiver, contract, action) keys accumulated for one block. Past
+// the cap new keys are dropped rather than evicting existing ones, so a
+// block full of unique inline actions cannot grow the map without bound.
+const MAX_KEYS_PER_BLOCK: usize = 1024;
+
+/// Per-contract execution ledger for capacity planning.
+///
+/// Every executed action folds its wall time, wasm metering points, stateful
+/// host calls and RAM delta into the current block's cost map, keyed by
+/// (receiver, contract, action). When a block is accepted the map is sealed
+/// into a ring of the last [`RETAINED_BLOCKS`] blocks, which
+/// `pulsevm.getExecutionAccounting` aggregates on demand — so "which
+/// contract is eating the CPU budget" is answerable from the node itself,
+/// with attribution the flat histograms in [`crate::chain::metrics`] cannot
+/// give.
+pub static EXEC_ACCOUNTING: LazyLock<ExecutionAccounting> =
+    LazyLock::new(ExecutionAccounting::new);
+
+#[derive(Clone, Copy, PartialEq, Eq, Hash)]
+struct ActionKey {
+    receiver: u64,
+    account: u64,
+    action: u64,
+}
+
+#[derive(Default, Clone, Copy)]
+pub struct ActionCosts {
+    pub count: u64,
+    pub wall_us: u64,
+    pub cpu_points: u64,
+    pub host_calls: u64,
+    pub ram_delta: i64,
+}
+
+impl ActionCosts {
+    fn merge(&mut self, other: &ActionCosts) {
+        self.count += other.count;
+        self.wall_us += other.wall_us;
+        self.cpu_points += other.cpu_points;
+        self.host_calls += other.host_calls;
+        self.ram_delta += other.ram_delta;
+    }
+}
+
+/// One aggregated row of the queryable view.
+pub struct AccountingRow {
+    pub receiver: Name,
+    pub contract: Name,
+    pub action: Name,
+    pub costs: ActionCosts,
+}
+
+/// Aggregation over the most recent sealed blocks, heaviest rows first.
+pub struct AccountingSnapshot {
+    pub first_block_num: u32,
+    pub last_block_num: u32,
+    pub blocks: u32,
+    pub rows: Vec<AccountingRow>,
+}
+
+struct Inner {
+    // Costs accumulated since `begin_block`; discarded when the same block
+    // is re-executed (verify then accept) so nothing is counted twice.
+    current: HashMap<ActionKey, ActionCosts>,
+    // Sealed blocks, oldest first.
+    blocks: VecDeque<(u32, HashMap<ActionKey, ActionCosts>)>,
+}
+
+pub struct ExecutionAccounting {
+    inner: Mutex<Inner>,
+}
+
+impl ExecutionAccounting {
+    fn new() -> Self {
+        Self {
+            inner: Mutex::new(Inner {
+                current: HashMap::new(),
+                blocks: VecDeque::new(),
+            }),
+        }
+    }
+
+    pub fn record_action(
+        &self,
+        receiver: &Name,
+        account: &Name,
+        action: &Name,
+        wall: Duration,
+        cpu_points: u64,
+        host_calls: u64,
+        ram_delta: i64,
+    ) {
+        let key = ActionKey {
+            receiver: receiver.as_u64(),
+            account: account.as_u64(),
+            action: action.as_u64(),
+        };
+        let mut inner = self.lock();
+        if inner.current.len() >= MAX_KEYS_PER_BLOCK && !inner.current.contains_key(&key) {
+            return;
+        }
+        let costs = inner.current.entry(key).or_default();
+        costs.count += 1;
+        costs.wall_us += wall.as_micros() as u64;
+        costs.cpu_points += cpu_points;
+        costs.host_calls += host_calls;
+        costs.ram_delta += ram_delta;
+    }
+
+    /// Drops whatever the previous execution pass accumulated. Called at the
+    /// top of block execution, so a block that runs twice (verify, then
+    /// accept) only keeps the final pass.
+    pub fn begin_block(&self) {
+        self.lock().current.clear();
+    }
+
+    /// Seals the current map under `block_num` and trims the ring. Called
+    /// only for the accepting pass, so speculative and verify-only execution
+    /// never lands in the retained history.
+    pub fn seal_block(&self, block_num: u32) {
+        let mut inner = self.lock();
+        let sealed = std::mem::take(&mut inner.current);
+        inner.blocks.push_back((block_num, sealed));
+        while inner.blocks.len() > RETAINED_BLOCKS {
+            inner.blocks.pop_front();
+        }
+    }
+
+    /// Merges the newest `last_blocks` sealed blocks (all retained blocks
+    /// when `None`) into one row set, sorted by wall time descending.
+    pub fn aggregate(&self, last_blocks: Option<usize>) -> AccountingSnapshot {
+        let inner = self.lock();
+        let take = last_blocks
+            .unwrap_or(inner.blocks.len())
+            .min(inner.blocks.len());
+        let window = inner.blocks.iter().skip(inner.blocks.len() - take);
+
+        let mut first_block_num = 0;
+        let mut last_block_num = 0;
+        let mut merged: HashMap<ActionKey, ActionCosts> = HashMap::new();
+        for (i, (block_num, costs)) in window.enumerate() {
+            if i == 0 {
+                first_block_num = *block_num;
+            }
+            last_block_num = *block_num;
+            for (key, cost) in costs {
+                merged.entry(*key).or_default().merge(cost);
+            }
+        }
+
+        let mut rows: Vec<AccountingRow> = merged
+            .into_iter()
+            .map(|(key, costs)| AccountingRow {
+                receiver: Name::new(key.receiver),
+                contract: Name::new(key.account),
+                action: Name::new(key.action),
+                costs,
+            })
+            .collect();
+        rows.sort_by(|a, b| b.costs.wall_us.cmp(&a.costs.wall_us));
+
+        AccountingSnapshot {
+            first_block_num,
+            last_block_num,
+            blocks: take as u32,
+            rows,
+        }
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, Inner> {
+        // A panic mid-update at worst loses one action's costs; the ledger
+        // stays usable.
+        self.inner
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use std::str::FromStr;
+
+    fn record(ledger: &ExecutionAccounting, receiver: &str, wall_us: u64) {
+        let receiver = Name::from_str(receiver).unwrap();
+        let contract = Name::new(name!("token"));
+        let action = Name::new(name!("transfer"));
+        ledger.record_action(
+            &receiver,
+            &contract,
+            &action,
+            Duration::from_micros(wall_us),
+            wall_us * 10,
+            2,
+            16,
+        );
+    }
+
+    #[test]
+    fn test_aggregate_merges_and_sorts_blocks() {
+        let ledger = ExecutionAccounting::new();
+        ledger.begin_block();
+        record(&ledger, "alice", 100);
+        record(&ledger, "alice", 100);
+        record(&ledger, "bob", 500);
+        ledger.seal_block(10);
+        ledger.begin_block();
+        record(&ledger, "alice", 100);
+        ledger.seal_block(11);
+
+        let snapshot = ledger.aggregate(None);
+        assert_eq!(snapshot.first_block_num, 10);
+        assert_eq!(snapshot.last_block_num, 11);
+        assert_eq!(snapshot.blocks, 2);
+        assert_eq!(snapshot.rows.len(), 2);
+        // bob's single heavy action outweighs alice's three cheap ones.
+        assert_eq!(snapshot.rows[0].receiver, Name::new(name!("bob")));
+        assert_eq!(snapshot.rows[0].costs.wall_us, 500);
+        assert_eq!(snapshot.rows[1].costs.count, 3);
+        assert_eq!(snapshot.rows[1].costs.cpu_points, 3000);
+        assert_eq!(snapshot.rows[1].costs.ram_delta, 48);
+
+        // Only the newest block.
+        let snapshot = ledger.aggregate(Some(1));
+        assert_eq!(snapshot.first_block_num, 11);
+        assert_eq!(snapshot.rows.len(), 1);
+        assert_eq!(snapshot.rows[0].costs.count, 1);
+    }
+
+    #[test]
+    fn test_begin_block_discards_previous_pass() {
+        let ledger = ExecutionAccounting::new();
+        ledger.begin_block();
+        record(&ledger, "alice", 100);
+        // Re-execution of the same block starts over.
+        ledger.begin_block();
+        record(&ledger, "alice", 100);
+        ledger.seal_block(5);
+
+        let snapshot = ledger.aggregate(None);
+        assert_eq!(snapshot.rows[0].costs.count, 1);
+    }
+}
@@ -0,0 +1,290 @@
+use std::collections::{BTreeSet, HashMap, HashSet};
+use std::thread;
+
+use pulsevm_error::ChainError;
+
+use crate::{
+    chain::{id::Id, recovery_cache::RecoveryCache, transaction::PackedTransaction},
+    crypto::PublicKey,
+};
+
+// A transaction's footprint is the set of (code, scope) pairs it may touch:
+// for every action, the contract account it targets plus each authorizing
+// actor (the scopes contracts conventionally write to). Two transactions
+// whose footprints overlap must execute in block order; disjoint ones can be
+// prepared independently.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+struct FootprintKey(u64);
+
+// Partitions a block's transactions into conflict-free lanes using the
+// statically declared (code, scope) sets. Transactions within a lane keep
+// their block order, and lanes are emitted ordered by their first
+// transaction, so iterating lanes in order and transactions within each lane
+// visits the block deterministically.
+//
+// The chainbase undo stack is a single writer over one shared mapping, so the
+// apply phase itself stays serial; what the lanes buy us is the ability to
+// run the per-transaction preparation work (signature key recovery, which
+// dominates pre-execution cost) on a worker pool, one worker per lane, while
+// keeping a deterministic merge order. A block where everything conflicts
+// degenerates to a single lane and behaves exactly like the old serial path.
+pub struct ExecutionSchedule {
+    lanes: Vec<Vec<usize>>,
+}
+
+// Raw footprint keys of a transaction: the contract accounts its actions
+// target plus every authorizing actor. Used both for lane partitioning and
+// for the optimistic-concurrency conflict check in block building.
+pub fn transaction_footprint(trx: &PackedTransaction) -> BTreeSet<u64> {
+    let mut keys = BTreeSet::new();
+    let transaction = trx.get_transaction();
+    for action in transaction
+        .actions
+        .iter()
+        .chain(transaction.context_free_actions.iter())
+    {
+        keys.insert(action.account().as_u64());
+        for auth in action.authorization().iter() {
+            keys.insert(auth.actor());
+        }
+    }
+    keys
+}
+
+impl ExecutionSchedule {
+    pub fn build(transactions: &[&PackedTransaction]) -> Self {
+        let mut parent: Vec<usize> = (0..transactions.len()).collect();
+
+        fn find(parent: &mut Vec<usize>, mut i: usize) -> usize {
+            while parent[i] != i {
+                parent[i] = parent[parent[i]]; // path halving
+                i = parent[i];
+            }
+            i
+        }
+
+        // Union transactions that share any footprint key.
+        let mut owner_by_key: HashMap<FootprintKey, usize> = HashMap::new();
+        for (index, trx) in transactions.iter().enumerate() {
+            for key in Self::footprint(trx) {
+                match owner_by_key.get(&key) {
+                    Some(&owner) => {
+                        let a = find(&mut parent, owner);
+                        let b = find(&mut parent, index);
+                        if a != b {
+                            // Attach the later root under the earlier one so
+                            // lane identity follows the first transaction.
+                            let (lo, hi) = if a < b { (a, b) } else { (b, a) };
+                            parent[hi] = lo;
+                        }
+                    }
+                    None => {
+                        owner_by_key.insert(key, index);
+                    }
+                }
+            }
+        }
+
+        // Collect lanes keyed by root, ordered by first transaction index.
+        let mut lane_of_root: HashMap<usize, usize> = HashMap::new();
+        let mut lanes: Vec<Vec<usize>> = Vec::new();
+        for index in 0..transactions.len() {
+            let root = find(&mut parent, index);
+            let lane = *lane_of_root.entry(root).or_insert_with(|| {
+                lanes.push(Vec::new());
+                lanes.len() - 1
+            });
+            lanes[lane].push(index);
+        }
+
+        Self { lanes }
+    }
+
+    pub fn lanes(&self) -> &[Vec<usize>] {
+        &self.lanes
+    }
+
+    fn footprint(trx: &PackedTransaction) -> BTreeSet<FootprintKey> {
+        transaction_footprint(trx)
+            .into_iter()
+            .map(FootprintKey)
+            .collect()
+    }
+
+    // Recovers the signing keys of every transaction in one batched parallel
+    // pass over the whole block and returns them keyed by transaction id, so
+    // the serial apply loop can skip the per-transaction recovery cost.
+    //
+    // The batch is striped at transaction granularity rather than per lane:
+    // recovery is a pure function of the transaction and chain id, so it is
+    // not bound by the conflict partition, and a block dominated by one big
+    // lane still spreads its signatures across every core. Duplicate
+    // transaction ids (re-gossiped copies) are recovered once.
+    pub fn recover_keys(
+        &self,
+        transactions: &[&PackedTransaction],
+        chain_id: &Id,
+        cache: Option<&RecoveryCache>,
+    ) -> Result<HashMap<Id, BTreeSet<PublicKey>>, ChainError> {
+        recover_keys_batched(transactions, chain_id, cache)
+    }
+}
+
+// Block-wide batched signature recovery; see `ExecutionSchedule::recover_keys`.
+// Transactions whose keys are already in the recovery cache skip the batch
+// entirely, and fresh results are written back for the later replays of the
+// same block.
+pub fn recover_keys_batched(
+    transactions: &[&PackedTransaction],
+    chain_id: &Id,
+    cache: Option<&RecoveryCache>,
+) -> Result<HashMap<Id, BTreeSet<PublicKey>>, ChainError> {
+    let mut cached: HashMap<Id, BTreeSet<PublicKey>> = HashMap::new();
+
+    // Recover each unique transaction id once.
+    let mut unique: Vec<&PackedTransaction> = Vec::with_capacity(transactions.len());
+    let mut seen: HashSet<&Id> = HashSet::new();
+    for trx in transactions {
+        if !seen.insert(trx.id()) {
+            continue;
+        }
+        match cache.and_then(|c| c.get(trx.id())) {
+            Some(keys) => {
+                cached.insert(trx.id().clone(), keys);
+            }
+            None => unique.push(trx),
+        }
+    }
+
+    let recover =
+        |trx: &PackedTransaction| -> Result<(Id, BTreeSet<PublicKey>), ChainError> {
+            let keys = trx.get_signed_transaction().recovered_keys(chain_id)?;
+            Ok((trx.id().clone(), keys))
+        };
+
+    let mut result = cached;
+    result.reserve(unique.len());
+
+    if unique.len() <= 2 {
+        for trx in unique {
+            let (id, keys) = recover(trx)?;
+            if let Some(c) = cache {
+                c.put(id, keys.clone());
+            }
+            result.insert(id, keys);
+        }
+        return Ok(result);
+    }
+
+    let workers = thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1)
+        .min(unique.len());
+
+    let recovered: Vec<Result<(Id, BTreeSet<PublicKey>), ChainError>> = thread::scope(|scope| {
+        let mut handles = Vec::with_capacity(workers);
+        for worker in 0..workers {
+            let unique = &unique;
+            let recover = &recover;
+            handles.push(scope.spawn(move || {
+                // A stable worker-index-to-core mapping (when affinity is
+                // configured) keeps each worker's share of the block on the
+                // same package block after block.
+                crate::chain::cpu_affinity::pin_worker(worker);
+                // Transactions are striped across workers; output order does
+                // not matter because results are keyed by id.
+                unique
+                    .iter()
+                    .skip(worker)
+                    .step_by(workers)
+                    .map(|trx| recover(trx))
+                    .collect::<Vec<_>>()
+            }));
+        }
+        handles
+            .into_iter()
+            .flat_map(|h| h.join().expect("key recovery worker panicked"))
+            .collect()
+    });
+
+    for item in recovered {
+        let (id, keys) = item?;
+        if let Some(c) = cache {
+            c.put(id, keys.clone());
+        }
+        result.insert(id, keys);
+    }
+
+    Ok(result)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use std::str::FromStr;
+
+    use pulsevm_ffi::TimePointSec;
+
+    use crate::{
+        ACTIVE_NAME,
+        chain::{
+            authority::PermissionLevel,
+            name::Name,
+            transaction::{Action, SignedTransaction, Transaction, TransactionHeader},
+        },
+    };
+
+    fn make_trx(account: &str, actor: &str) -> PackedTransaction {
+        let trx = Transaction::new(
+            TransactionHeader::new(TimePointSec::maximum(), 0, 0, 0u32.into(), 0, 0u32.into()),
+            vec![],
+            vec![Action::new(
+                Name::from_str(account).unwrap(),
+                Name::new(name!("transfer")),
+                vec![actor.len() as u8],
+                vec![PermissionLevel::new(
+                    Name::from_str(actor).unwrap().as_u64(),
+                    ACTIVE_NAME.as_u64(),
+                )],
+            )],
+        );
+        PackedTransaction::from_signed_transaction(SignedTransaction::new(
+            trx,
+            Default::default(),
+            vec![],
+        ))
+        .unwrap()
+    }
+
+    #[test]
+    fn test_disjoint_transactions_get_separate_lanes() {
+        let a = make_trx("tokena", "alice");
+        let b = make_trx("tokenb", "bob");
+        let schedule = ExecutionSchedule::build(&[&a, &b]);
+        assert_eq!(schedule.lanes().len(), 2);
+        assert_eq!(schedule.lanes()[0], vec![0]);
+        assert_eq!(schedule.lanes()[1], vec![1]);
+    }
+
+    #[test]
+    fn test_shared_scope_transactions_share_a_lane() {
+        let a = make_trx("tokena", "alice");
+        let b = make_trx("tokenb", "alice"); // same authorizing actor
+        let c = make_trx("tokenb", "bob"); // same contract as b
+        let schedule = ExecutionSchedule::build(&[&a, &b, &c]);
+        assert_eq!(schedule.lanes().len(), 1);
+        assert_eq!(schedule.lanes()[0], vec![0, 1, 2]);
+    }
+
+    #[test]
+    fn test_lane_order_is_deterministic() {
+        let a = make_trx("tokena", "alice");
+        let b = make_trx("tokenb", "bob");
+        let c = make_trx("tokena", "carol"); // joins a's lane
+        let schedule = ExecutionSchedule::build(&[&a, &b, &c]);
+        assert_eq!(schedule.lanes().len(), 2);
+        assert_eq!(schedule.lanes()[0], vec![0, 2]);
+        assert_eq!(schedule.lanes()[1], vec![1]);
+    }
+}
@@ -0,0 +1,306 @@
+use std::{
+    collections::{BTreeMap, HashMap, HashSet},
+    fs,
+    path::PathBuf,
+};
+
+use pulsevm_error::ChainError;
+use pulsevm_serialization::Write;
+
+use crate::chain::{block::SignedBlock, id::Id, memory_ledger::MEMORY_LEDGER};
+
+// Verified blocks resident in memory before the store starts spilling the
+// deepest ones to disk. Tip-adjacent blocks — the ones consensus is about to
+// accept or reject — always stay resident; only a deep fork backlog pays a
+// disk read on re-access.
+const DEFAULT_MAX_RESIDENT_BYTES: usize = 256 << 20;
+
+/// Fork store for verified-but-unaccepted blocks.
+///
+/// Functionally the `HashMap<Id, SignedBlock>` it replaces, plus the three
+/// properties a consensus stall demands: a height index so finality can
+/// prune every dead fork entry in O(1) amortized per block (not a full
+/// scan), byte accounting with spill-to-disk so thousands of held blocks
+/// cost files instead of RSS, and removal that cleans up its spill file.
+/// Without a spill directory (before `Controller::initialize`, and in
+/// tests) the store keeps everything resident, matching the old behavior.
+pub struct ForkStore {
+    blocks: HashMap<Id, Entry>,
+    // Ids by height, oldest first; drives both finality pruning and the
+    // spill policy (deepest blocks spill first).
+    by_height: BTreeMap<u32, Vec<Id>>,
+    resident_bytes: usize,
+    max_resident_bytes: usize,
+    spill_dir: Option<PathBuf>,
+}
+
+struct Entry {
+    height: u32,
+    // Serialized size of the block, counted against the resident budget
+    // while the block is in memory.
+    bytes: usize,
+    repr: Repr,
+}
+
+enum Repr {
+    Resident(SignedBlock),
+    // The block's packed bytes live at `spill_path(id)`.
+    Spilled,
+}
+
+impl ForkStore {
+    pub fn new() -> Self {
+        Self {
+            blocks: HashMap::new(),
+            by_height: BTreeMap::new(),
+            resident_bytes: 0,
+            max_resident_bytes: DEFAULT_MAX_RESIDENT_BYTES,
+            spill_dir: None,
+        }
+    }
+
+    /// Enables spilling under `dir`, clearing any files a previous run left
+    /// behind; entries spilled before a crash are useless without their
+    /// in-memory index.
+    pub fn set_spill_dir(&mut self, dir: PathBuf) -> Result<(), ChainError> {
+        let _ = fs::remove_dir_all(&dir);
+        fs::create_dir_all(&dir).map_err(|e| {
+            ChainError::InternalError(format!("failed to create fork spill dir: {}", e))
+        })?;
+        self.spill_dir = Some(dir);
+        Ok(())
+    }
+
+    pub fn insert(&mut self, id: Id, block: SignedBlock) -> Result<(), ChainError> {
+        let height = block.block_num();
+        let bytes = block.pack().map(|b| b.len()).unwrap_or(0);
+
+        if let Some(previous) = self.blocks.insert(
+            id,
+            Entry {
+                height,
+                bytes,
+                repr: Repr::Resident(block),
+            },
+        ) {
+            // Same id re-verified; replace in place without double counting.
+            self.drop_repr(&id, &previous);
+        } else {
+            self.by_height.entry(height).or_default().push(id);
+        }
+        self.resident_bytes += bytes;
+        self.enforce_budget();
+        self.publish_resident();
+        Ok(())
+    }
+
+    pub fn contains(&self, id: &Id) -> bool {
+        self.blocks.contains_key(id)
+    }
+
+    /// The block by id, cloned from memory or decoded from its spill file.
+    pub fn get(&self, id: &Id) -> Result<Option<SignedBlock>, ChainError> {
+        match self.blocks.get(id) {
+            None => Ok(None),
+            Some(entry) => match &entry.repr {
+                Repr::Resident(block) => Ok(Some(block.clone())),
+                Repr::Spilled => self.read_spilled(id).map(Some),
+            },
+        }
+    }
+
+    pub fn remove(&mut self, id: &Id) -> Result<Option<SignedBlock>, ChainError> {
+        let Some(entry) = self.blocks.remove(id) else {
+            return Ok(None);
+        };
+        if let Some(ids) = self.by_height.get_mut(&entry.height) {
+            ids.retain(|other| other != id);
+            if ids.is_empty() {
+                self.by_height.remove(&entry.height);
+            }
+        }
+        match entry.repr {
+            Repr::Resident(block) => {
+                self.resident_bytes = self.resident_bytes.saturating_sub(entry.bytes);
+                self.publish_resident();
+                Ok(Some(block))
+            }
+            Repr::Spilled => {
+                let block = self.read_spilled(id)?;
+                self.remove_spill_file(id);
+                Ok(Some(block))
+            }
+        }
+    }
+
+    /// Drops every entry at `height` and below. Once a block at that height
+    /// is final, nothing on another branch at or below it can ever be
+    /// accepted; this is where a stalled node's backlog is reclaimed.
+    pub fn prune_finalized(&mut self, height: u32) {
+        let keep = self.by_height.split_off(&(height + 1));
+        let dead = std::mem::replace(&mut self.by_height, keep);
+        for ids in dead.values() {
+            for id in ids {
+                if let Some(entry) = self.blocks.remove(id) {
+                    self.drop_repr(id, &entry);
+                }
+            }
+        }
+        self.publish_resident();
+    }
+
+    /// Ids of every transaction packed into any stored block, for the
+    /// build-path dedup; spilled blocks are decoded for the walk.
+    pub fn transaction_ids(&self) -> Result<HashSet<Id>, ChainError> {
+        let mut ids = HashSet::new();
+        for (id, entry) in self.blocks.iter() {
+            let spilled;
+            let block = match &entry.repr {
+                Repr::Resident(block) => block,
+                Repr::Spilled => {
+                    spilled = self.read_spilled(id)?;
+                    &spilled
+                }
+            };
+            ids.extend(block.transactions.iter().map(|r| r.trx().id().clone()));
+        }
+        Ok(ids)
+    }
+
+    // Spills the deepest resident blocks until the resident set fits the
+    // budget. A no-op without a spill directory.
+    fn enforce_budget(&mut self) {
+        let Some(dir) = self.spill_dir.clone() else {
+            return;
+        };
+        if self.resident_bytes <= self.max_resident_bytes {
+            return;
+        }
+
+        let ordered: Vec<Id> = self.by_height.values().flatten().cloned().collect();
+        for id in ordered {
+            if self.resident_bytes <= self.max_resident_bytes {
+                break;
+            }
+            let Some(entry) = self.blocks.get_mut(&id) else {
+                continue;
+            };
+            if let Repr::Resident(block) = &entry.repr {
+                let Ok(bytes) = block.pack() else {
+                    continue;
+                };
+                if fs::write(Self::spill_path_in(&dir, &id), bytes).is_err() {
+                    // Disk trouble: keep the block resident rather than
+                    // lose it; the budget is advisory, correctness is not.
+                    continue;
+                }
+                entry.repr = Repr::Spilled;
+                self.resident_bytes = self.resident_bytes.saturating_sub(entry.bytes);
+            }
+        }
+    }
+
+    // Mirrors the resident set into the node memory ledger after every
+    // mutation, so the shared budget sees fork backlog alongside the other
+    // accounted subsystems.
+    fn publish_resident(&self) {
+        MEMORY_LEDGER.set_fork_store_bytes(self.resident_bytes as u64);
+    }
+
+    fn drop_repr(&mut self, id: &Id, entry: &Entry) {
+        match entry.repr {
+            Repr::Resident(_) => {
+                self.resident_bytes = self.resident_bytes.saturating_sub(entry.bytes);
+            }
+            Repr::Spilled => self.remove_spill_file(id),
+        }
+    }
+
+    fn read_spilled(&self, id: &Id) -> Result<SignedBlock, ChainError> {
+        let dir = self.spill_dir.as_ref().ok_or_else(|| {
+            ChainError::InternalError("spilled block without a spill dir".to_string())
+        })?;
+        let bytes = fs::read(Self::spill_path_in(dir, id)).map_err(|e| {
+            ChainError::InternalError(format!("failed to read spilled block {}: {}", id, e))
+        })?;
+        SignedBlock::from_wire(&bytes).map_err(|e| {
+            ChainError::SerializationError(format!("failed to decode spilled block {}: {}", id, e))
+        })
+    }
+
+    fn remove_spill_file(&self, id: &Id) {
+        if let Some(dir) = &self.spill_dir {
+            let _ = fs::remove_file(Self::spill_path_in(dir, id));
+        }
+    }
+
+    fn spill_path_in(dir: &PathBuf, id: &Id) -> PathBuf {
+        dir.join(format!("{}.blk", id))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::chain::block::BlockTimestamp;
+    use crate::chain::name::Name;
+    use std::collections::VecDeque;
+
+    fn block_at(height: u32) -> (Id, SignedBlock) {
+        // `previous` carries the height: block_num() is previous + 1.
+        let mut parent_bytes = [0u8; 32];
+        parent_bytes[0..4].copy_from_slice(&(height - 1).to_be_bytes());
+        let block = SignedBlock::new(
+            Id::new(parent_bytes),
+            BlockTimestamp::new(height),
+            Name::default(),
+            VecDeque::new(),
+            Default::default(),
+            Default::default(),
+        );
+        (block.id().unwrap(), block)
+    }
+
+    #[test]
+    fn test_prune_finalized_drops_at_and_below() {
+        let mut store = ForkStore::new();
+        for height in [5u32, 6, 6, 7] {
+            let (id, block) = block_at(height);
+            store.insert(id, block).unwrap();
+        }
+        // Two entries collide at the same id for height 6; the map holds 3.
+        assert_eq!(store.blocks.len(), 3);
+
+        store.prune_finalized(6);
+        assert_eq!(store.blocks.len(), 1);
+        let (id7, _) = block_at(7);
+        assert!(store.contains(&id7));
+        assert_eq!(store.by_height.len(), 1);
+    }
+
+    #[test]
+    fn test_spill_and_reload_round_trip() {
+        let dir = std::env::temp_dir().join(format!("pulsevm_fork_store_{}", std::process::id()));
+        let mut store = ForkStore::new();
+        store.set_spill_dir(dir.clone()).unwrap();
+        // Force everything past the budget so inserts spill immediately.
+        store.max_resident_bytes = 0;
+
+        let (id, block) = block_at(10);
+        store.insert(id, block.clone()).unwrap();
+        assert_eq!(store.resident_bytes, 0);
+        assert!(matches!(
+            store.blocks.get(&id).unwrap().repr,
+            Repr::Spilled
+        ));
+
+        let reloaded = store.get(&id).unwrap().unwrap();
+        assert_eq!(reloaded.id().unwrap(), block.id().unwrap());
+
+        // Removal returns the block and deletes its file.
+        let removed = store.remove(&id).unwrap().unwrap();
+        assert_eq!(removed.id().unwrap(), block.id().unwrap());
+        assert!(fs::read_dir(&dir).unwrap().next().is_none());
+        let _ = fs::remove_dir_all(&dir);
+    }
+}
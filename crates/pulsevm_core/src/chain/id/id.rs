@@ -65,8 +65,8 @@ impl Serialize for Id {
     where
         S: serde::Serializer,
     {
-        let hex_string = hex::encode(self.0);
-        serializer.serialize_str(&hex_string)
+        // FixedBytes serializes through its stack hex buffer; no String.
+        self.0.serialize(serializer)
     }
 }
 
@@ -82,7 +82,7 @@ impl<'de> Deserialize<'de> for Id {
 
 impl fmt::Display for Id {
     fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
-        write!(f, "{}", hex::encode(self.0))
+        fmt::Display::fmt(&self.0, f)
     }
 }
 
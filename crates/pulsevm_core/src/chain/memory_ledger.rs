@@ -0,0 +1,217 @@
+use std::{
+    fmt::Write,
+    sync::{
+        LazyLock,
+        atomic::{AtomicU64, Ordering},
+    },
+};
+
+/// Default collective budget for the accounted subsystems. Steady-state
+/// usage sits far below this — the fork store alone self-limits its
+/// resident set — so the cap only binds during sync storms, when
+/// thousands of gossiped blocks are held, decoded and logged at once.
+pub const DEFAULT_MEMORY_BUDGET_BYTES: u64 = 2 << 30;
+
+/// Node-wide memory accountant.
+///
+/// The node has several places that buffer unbounded peer-driven data:
+/// verified-but-unaccepted blocks in the fork store, gossiped block
+/// containers mid-decode, and payloads queued for the state-history
+/// writer thread. Each is individually reasonable; during a sync storm
+/// they grow together and the kernel's OOM killer becomes the de facto
+/// backpressure. This ledger makes the sum visible and enforceable:
+/// subsystems report usage with one relaxed atomic store or add, and the
+/// admission points — block decode, heavy RPC — consult the total
+/// against a configurable budget and throttle instead of allocating.
+///
+/// Like [`crate::chain::metrics::METRICS`], everything here is a relaxed
+/// atomic; a reservation that races past the budget by one in-flight
+/// decode is fine, because the budget guards against runaway growth, not
+/// exact accounting.
+pub static MEMORY_LEDGER: LazyLock<MemoryLedger> = LazyLock::new(MemoryLedger::new);
+
+pub struct MemoryLedger {
+    // Resident bytes in the fork store, mirrored after every mutation;
+    // a gauge, because the store already does its own byte accounting.
+    fork_store_bytes: AtomicU64,
+    // Decoded-block buffers currently being inflated from gossip
+    // containers, held as reservations for the decode's duration.
+    block_decode_bytes: AtomicU64,
+    // Payload bytes queued for the state-history writer thread and not
+    // yet written out.
+    state_history_bytes: AtomicU64,
+    // The configured cap; 0 disables enforcement (the ledger still
+    // accounts, for the metrics endpoint).
+    budget_bytes: AtomicU64,
+}
+
+impl MemoryLedger {
+    fn new() -> Self {
+        Self {
+            fork_store_bytes: AtomicU64::new(0),
+            block_decode_bytes: AtomicU64::new(0),
+            state_history_bytes: AtomicU64::new(0),
+            budget_bytes: AtomicU64::new(DEFAULT_MEMORY_BUDGET_BYTES),
+        }
+    }
+
+    pub fn set_budget(&self, bytes: u64) {
+        self.budget_bytes.store(bytes, Ordering::Relaxed);
+    }
+
+    pub fn set_fork_store_bytes(&self, bytes: u64) {
+        self.fork_store_bytes.store(bytes, Ordering::Relaxed);
+    }
+
+    pub fn add_state_history_queued(&self, bytes: u64) {
+        self.state_history_bytes.fetch_add(bytes, Ordering::Relaxed);
+    }
+
+    pub fn sub_state_history_queued(&self, bytes: u64) {
+        // fetch_update for the saturation: a plain fetch_sub that raced an
+        // asymmetric size estimate could wrap the gauge to the stratosphere.
+        let _ = self
+            .state_history_bytes
+            .fetch_update(Ordering::Relaxed, Ordering::Relaxed, |v| {
+                Some(v.saturating_sub(bytes))
+            });
+    }
+
+    /// Reserves `bytes` against the budget for an in-flight block decode,
+    /// or refuses when the ledger is already over. The reservation is
+    /// released on drop — it covers the decode window, which is exactly
+    /// what multiplies under a sync storm — so callers hold it for the
+    /// duration of the inflation.
+    pub fn try_reserve_block_decode(&self, bytes: u64) -> Option<MemoryReservation<'_>> {
+        self.block_decode_bytes.fetch_add(bytes, Ordering::Relaxed);
+        let budget = self.budget_bytes.load(Ordering::Relaxed);
+        if budget != 0 && self.accounted_total() > budget {
+            self.block_decode_bytes.fetch_sub(bytes, Ordering::Relaxed);
+            return None;
+        }
+        Some(MemoryReservation {
+            counter: &self.block_decode_bytes,
+            bytes,
+        })
+    }
+
+    /// Sum of everything the subsystems have reported.
+    pub fn accounted_total(&self) -> u64 {
+        self.fork_store_bytes.load(Ordering::Relaxed)
+            + self.block_decode_bytes.load(Ordering::Relaxed)
+            + self.state_history_bytes.load(Ordering::Relaxed)
+    }
+
+    /// Whether the accounted total exceeds the budget; the shed check for
+    /// work that is cheaper refused than served, like heavy RPC reads.
+    pub fn over_budget(&self) -> bool {
+        let budget = self.budget_bytes.load(Ordering::Relaxed);
+        budget != 0 && self.accounted_total() > budget
+    }
+
+    /// Renders the ledger's gauges in Prometheus text exposition format,
+    /// for appending to the `/metrics` body.
+    pub fn render(&self) -> String {
+        let mut out = String::with_capacity(1024);
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_memory_fork_store_bytes",
+            "Resident bytes held by the verified-block fork store",
+            self.fork_store_bytes.load(Ordering::Relaxed),
+        );
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_memory_block_decode_bytes",
+            "Bytes reserved by in-flight gossip block decodes",
+            self.block_decode_bytes.load(Ordering::Relaxed),
+        );
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_memory_state_history_queued_bytes",
+            "Payload bytes queued for the state-history writer thread",
+            self.state_history_bytes.load(Ordering::Relaxed),
+        );
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_memory_budget_bytes",
+            "Configured collective budget for the accounted subsystems (0 = uncapped)",
+            self.budget_bytes.load(Ordering::Relaxed),
+        );
+        out
+    }
+
+    fn render_gauge(out: &mut String, name: &str, help: &str, value: u64) {
+        let _ = writeln!(out, "# HELP {name} {help}");
+        let _ = writeln!(out, "# TYPE {name} gauge");
+        let _ = writeln!(out, "{name} {value}");
+    }
+}
+
+/// An accounted in-flight allocation; releases its bytes on drop.
+pub struct MemoryReservation<'a> {
+    counter: &'a AtomicU64,
+    bytes: u64,
+}
+
+impl Drop for MemoryReservation<'_> {
+    fn drop(&mut self) {
+        self.counter.fetch_sub(self.bytes, Ordering::Relaxed);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_reservation_respects_budget_and_releases() {
+        let ledger = MemoryLedger::new();
+        ledger.set_budget(1000);
+        ledger.set_fork_store_bytes(600);
+
+        let first = ledger.try_reserve_block_decode(300);
+        assert!(first.is_some());
+        assert_eq!(ledger.accounted_total(), 900);
+
+        // A second decode would push the total past the budget.
+        assert!(ledger.try_reserve_block_decode(300).is_none());
+        assert_eq!(ledger.accounted_total(), 900);
+
+        drop(first);
+        assert_eq!(ledger.accounted_total(), 600);
+        assert!(ledger.try_reserve_block_decode(300).is_some());
+    }
+
+    #[test]
+    fn test_zero_budget_means_uncapped() {
+        let ledger = MemoryLedger::new();
+        ledger.set_budget(0);
+        ledger.set_fork_store_bytes(u64::MAX / 2);
+        assert!(!ledger.over_budget());
+        assert!(ledger.try_reserve_block_decode(1 << 30).is_some());
+    }
+
+    #[test]
+    fn test_state_history_gauge_saturates() {
+        let ledger = MemoryLedger::new();
+        ledger.add_state_history_queued(100);
+        ledger.sub_state_history_queued(40);
+        assert_eq!(ledger.accounted_total(), 60);
+        // Over-subtraction clamps at zero instead of wrapping.
+        ledger.sub_state_history_queued(1000);
+        assert_eq!(ledger.accounted_total(), 0);
+    }
+
+    #[test]
+    fn test_render_gauges() {
+        let ledger = MemoryLedger::new();
+        ledger.set_budget(2048);
+        ledger.set_fork_store_bytes(512);
+        ledger.add_state_history_queued(64);
+
+        let text = ledger.render();
+        assert!(text.contains("pulsevm_memory_fork_store_bytes 512\n"));
+        assert!(text.contains("pulsevm_memory_state_history_queued_bytes 64\n"));
+        assert!(text.contains("pulsevm_memory_budget_bytes 2048\n"));
+    }
+}
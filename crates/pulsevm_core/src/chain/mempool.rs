@@ -1,6 +1,10 @@
-use std::collections::{HashSet, VecDeque};
+use std::cmp::Reverse;
+use std::collections::{BTreeMap, HashMap, HashSet};
+use std::sync::{Mutex, OnceLock};
 
-use crate::chain::{id::Id, transaction::PackedTransaction};
+use crate::chain::{
+    id::Id, mempool_journal::MempoolJournal, metrics::METRICS, transaction::PackedTransaction,
+};
 
 #[derive(Debug, Clone)]
 pub enum MempoolError {
@@ -15,58 +19,360 @@ impl std::fmt::Display for MempoolError {
     }
 }
 
-pub struct Mempool {
-    transactions_list: VecDeque<PackedTransaction>,
-    transactions_map: HashSet<Id>,
+pub const MAX_MEMPOOL_SIZE: usize = 10000;
+
+/// Scoring hook used to order the mempool; higher scores pop first. The
+/// default scores every transaction equally, which degenerates to arrival
+/// order (the chain has no transaction fees to bid with), but a node can
+/// plug in its own policy at construction.
+pub type ScoreFn = fn(&PackedTransaction) -> u64;
+
+fn default_score(_transaction: &PackedTransaction) -> u64 {
+    0
 }
 
-pub const MAX_MEMPOOL_SIZE: usize = 10000;
+// Selection order: higher score first, arrival order among equals.
+type PriorityKey = (Reverse<u64>, u64);
+
+struct MempoolEntry {
+    transaction: PackedTransaction,
+    priority: PriorityKey,
+    expiration: u32,
+    sender: Option<u64>,
+}
+
+/// Indexed mempool. Transactions are held once in `entries` and referenced
+/// from three ordered/keyed indexes, so admission, selection, targeted
+/// removal and expiry pruning are all O(log n) instead of scanning the pool.
+pub struct Mempool {
+    entries: HashMap<Id, MempoolEntry>,
+    // Ordered by (score desc, arrival); `pop_transaction` takes the front.
+    by_priority: BTreeMap<PriorityKey, Id>,
+    // Ordered by expiration so `expire_before` only touches what it removes.
+    by_expiration: BTreeMap<(u32, u64), Id>,
+    // First authorizer -> pending ids, for per-sender lookups and eviction.
+    by_sender: HashMap<u64, HashSet<Id>>,
+    score: ScoreFn,
+    next_sequence: u64,
+}
 
 impl Mempool {
     pub fn new() -> Self {
+        Self::with_score(default_score)
+    }
+
+    pub fn with_score(score: ScoreFn) -> Self {
         Self {
-            transactions_list: VecDeque::new(),
-            transactions_map: HashSet::new(),
+            entries: HashMap::new(),
+            by_priority: BTreeMap::new(),
+            by_expiration: BTreeMap::new(),
+            by_sender: HashMap::new(),
+            score,
+            next_sequence: 0,
         }
     }
 
     pub fn add_transaction(&mut self, transaction: PackedTransaction) -> bool {
-        if self.transactions_list.len() >= MAX_MEMPOOL_SIZE {
-            return false; // mempool is full
-        }
-        if !self.transactions_map.insert(transaction.id().clone()) {
+        if self.entries.contains_key(transaction.id()) {
             return false; // already present
         }
-        self.transactions_list.push_back(transaction);
+
+        let score = (self.score)(&transaction);
+
+        if self.entries.len() >= MAX_MEMPOOL_SIZE {
+            // Full: admit only if the newcomer outscores the current worst,
+            // which then gets evicted to make room.
+            match self.by_priority.last_key_value() {
+                Some((&(Reverse(worst_score), _), worst_id)) if score > worst_score => {
+                    let worst_id = worst_id.clone();
+                    self.remove_transaction(&worst_id);
+                }
+                _ => return false,
+            }
+        }
+
+        let sequence = self.next_sequence;
+        self.next_sequence += 1;
+
+        let priority = (Reverse(score), sequence);
+        let expiration = transaction
+            .get_transaction()
+            .header
+            .expiration()
+            .sec_since_epoch();
+        let sender = transaction.get_transaction().first_authorizer();
+        let id = transaction.id().clone();
+
+        self.by_priority.insert(priority, id.clone());
+        self.by_expiration.insert((expiration, sequence), id.clone());
+        if let Some(sender) = sender {
+            self.by_sender.entry(sender).or_default().insert(id.clone());
+        }
+        self.entries.insert(
+            id,
+            MempoolEntry {
+                transaction,
+                priority,
+                expiration,
+                sender,
+            },
+        );
+        METRICS.set_mempool_depth(self.entries.len());
         true
     }
 
     pub fn pop_transaction(&mut self) -> Option<PackedTransaction> {
-        if let Some(transaction) = self.transactions_list.pop_front() {
-            self.transactions_map.remove(transaction.id());
-            return Some(transaction);
-        }
-
-        return None;
+        let (_, id) = self.by_priority.pop_first()?;
+        let entry = self.entries.remove(&id).expect("mempool indexes out of sync");
+        self.unlink_secondary(&id, &entry);
+        METRICS.set_mempool_depth(self.entries.len());
+        Some(entry.transaction)
     }
 
     pub fn remove_transaction(&mut self, tx_id: &Id) {
-        if let Some(index) = self.transactions_list.iter().position(|x| x.id() == tx_id) {
-            self.transactions_list.remove(index);
-            self.transactions_map.remove(tx_id);
+        if let Some(entry) = self.entries.remove(tx_id) {
+            self.by_priority.remove(&entry.priority);
+            self.unlink_secondary(tx_id, &entry);
+            METRICS.set_mempool_depth(self.entries.len());
         }
     }
 
     pub fn has_transactions(&self) -> bool {
-        self.transactions_list.len() > 0
+        !self.entries.is_empty()
+    }
+
+    /// Number of pending transactions authorized by `sender`.
+    pub fn sender_pending(&self, sender: u64) -> usize {
+        self.by_sender.get(&sender).map_or(0, |ids| ids.len())
     }
 
     // Prune transactions that are included in a new block or expired
     pub fn prune(&mut self, pending_ids: &HashSet<Id>) {
-        self.transactions_list
-            .retain(|tx| !pending_ids.contains(tx.id()));
         for tx_id in pending_ids {
-            self.transactions_map.remove(tx_id);
+            self.remove_transaction(tx_id);
+        }
+    }
+
+    /// Drop every transaction whose expiration is at or before `now`
+    /// (seconds since epoch); touches only the expired prefix.
+    pub fn expire_before(&mut self, now: u32) {
+        while let Some((&(expiration, _), id)) = self.by_expiration.first_key_value() {
+            if expiration > now {
+                break;
+            }
+            let id = id.clone();
+            self.remove_transaction(&id);
         }
     }
+
+    /// Move everything buffered in `admission` into this mempool.
+    pub fn absorb(&mut self, admission: &MempoolAdmission) {
+        for transaction in admission.drain() {
+            self.add_transaction(transaction);
+        }
+    }
+
+    fn unlink_secondary(&mut self, id: &Id, entry: &MempoolEntry) {
+        self.by_expiration.remove(&(entry.expiration, entry.priority.1));
+        if let Some(sender) = entry.sender {
+            if let Some(ids) = self.by_sender.get_mut(&sender) {
+                ids.remove(id);
+                if ids.is_empty() {
+                    self.by_sender.remove(&sender);
+                }
+            }
+        }
+    }
+}
+
+pub const MEMPOOL_ADMISSION_SHARDS: usize = 16;
+
+/// Concurrent admission buffer in front of the mempool. Incoming
+/// transactions are bucketed by transaction-id prefix into independently
+/// locked shards, so gossip ingestion and RPC submission only contend when
+/// two transactions land in the same shard — never against each other
+/// globally and never against block building. The block-building path
+/// periodically combines the shards into the real mempool with `drain`
+/// (via `Mempool::absorb`), which locks one shard at a time; deduplication
+/// and priority ordering happen there.
+pub struct MempoolAdmission {
+    shards: Vec<Mutex<Vec<PackedTransaction>>>,
+    // Restart journal, attached once the node knows its data directory.
+    // Admissions before that (there are none in practice — the journal is
+    // wired during initialization) simply aren't journaled.
+    journal: OnceLock<MempoolJournal>,
+}
+
+impl MempoolAdmission {
+    pub fn new() -> Self {
+        Self {
+            shards: (0..MEMPOOL_ADMISSION_SHARDS)
+                .map(|_| Mutex::new(Vec::new()))
+                .collect(),
+            journal: OnceLock::new(),
+        }
+    }
+
+    /// Attaches the restart journal; every subsequent `submit` is also
+    /// queued to it. A second call is ignored.
+    pub fn set_journal(&self, journal: MempoolJournal) {
+        let _ = self.journal.set(journal);
+    }
+
+    fn shard_for(&self, id: &Id) -> &Mutex<Vec<PackedTransaction>> {
+        &self.shards[id.as_bytes()[0] as usize % self.shards.len()]
+    }
+
+    /// Buffer a transaction; only the owning shard is locked. A poisoned
+    /// shard is recovered into, never dropped.
+    pub fn submit(&self, transaction: PackedTransaction) {
+        // Journaling is a non-blocking channel send; the disk write happens
+        // on the journal's own thread.
+        if let Some(journal) = self.journal.get() {
+            journal.append(&transaction);
+        }
+        let shard = self.shard_for(transaction.id());
+        let mut buffer = shard.lock().unwrap_or_else(|poisoned| poisoned.into_inner());
+        buffer.push(transaction);
+    }
+
+    /// Combining drain: empties every shard, one lock at a time, and
+    /// returns the buffered transactions.
+    pub fn drain(&self) -> Vec<PackedTransaction> {
+        let mut drained = Vec::new();
+        for shard in &self.shards {
+            let mut buffer = shard.lock().unwrap_or_else(|poisoned| poisoned.into_inner());
+            drained.append(&mut buffer);
+        }
+        drained
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.shards.iter().all(|shard| {
+            shard
+                .lock()
+                .unwrap_or_else(|poisoned| poisoned.into_inner())
+                .is_empty()
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use std::str::FromStr;
+
+    use pulsevm_ffi::TimePointSec;
+
+    use crate::{
+        ACTIVE_NAME,
+        chain::{
+            authority::PermissionLevel,
+            name::Name,
+            transaction::{Action, SignedTransaction, Transaction, TransactionHeader},
+        },
+    };
+
+    fn make_trx(actor: &str, data: u8, expiration: u32) -> PackedTransaction {
+        let trx = Transaction::new(
+            TransactionHeader::new(
+                TimePointSec::new(expiration),
+                0,
+                0,
+                0u32.into(),
+                0,
+                0u32.into(),
+            ),
+            vec![],
+            vec![Action::new(
+                Name::new(name!("token")),
+                Name::new(name!("transfer")),
+                vec![data],
+                vec![PermissionLevel::new(
+                    Name::from_str(actor).unwrap().as_u64(),
+                    ACTIVE_NAME.as_u64(),
+                )],
+            )],
+        );
+        PackedTransaction::from_signed_transaction(SignedTransaction::new(
+            trx,
+            Default::default(),
+            vec![],
+        ))
+        .unwrap()
+    }
+
+    #[test]
+    fn test_default_order_is_fifo() {
+        let mut mempool = Mempool::new();
+        let a = make_trx("alice", 1, 100);
+        let b = make_trx("bob", 2, 100);
+        assert!(mempool.add_transaction(a.clone()));
+        assert!(mempool.add_transaction(b.clone()));
+        assert!(!mempool.add_transaction(a.clone())); // duplicate
+        assert_eq!(mempool.pop_transaction().unwrap().id(), a.id());
+        assert_eq!(mempool.pop_transaction().unwrap().id(), b.id());
+        assert!(!mempool.has_transactions());
+    }
+
+    #[test]
+    fn test_custom_score_orders_selection() {
+        // Score by the first action data byte: higher pops first.
+        fn score(trx: &PackedTransaction) -> u64 {
+            trx.get_transaction().actions[0].data()[0] as u64
+        }
+        let mut mempool = Mempool::with_score(score);
+        let low = make_trx("alice", 1, 100);
+        let high = make_trx("bob", 9, 100);
+        mempool.add_transaction(low.clone());
+        mempool.add_transaction(high.clone());
+        assert_eq!(mempool.pop_transaction().unwrap().id(), high.id());
+        assert_eq!(mempool.pop_transaction().unwrap().id(), low.id());
+    }
+
+    #[test]
+    fn test_expire_before_drops_only_expired() {
+        let mut mempool = Mempool::new();
+        let stale = make_trx("alice", 1, 50);
+        let fresh = make_trx("bob", 2, 200);
+        mempool.add_transaction(stale.clone());
+        mempool.add_transaction(fresh.clone());
+        mempool.expire_before(100);
+        assert_eq!(mempool.sender_pending(Name::new(name!("alice")).as_u64()), 0);
+        assert_eq!(mempool.pop_transaction().unwrap().id(), fresh.id());
+        assert!(!mempool.has_transactions());
+    }
+
+    #[test]
+    fn test_admission_shards_combine_into_mempool() {
+        let admission = MempoolAdmission::new();
+        let a = make_trx("alice", 1, 100);
+        let b = make_trx("bob", 2, 100);
+        std::thread::scope(|scope| {
+            scope.spawn(|| admission.submit(a.clone()));
+            scope.spawn(|| admission.submit(b.clone()));
+        });
+        assert!(!admission.is_empty());
+        let mut mempool = Mempool::new();
+        mempool.absorb(&admission);
+        assert!(admission.is_empty());
+        assert!(mempool.has_transactions());
+        let popped: HashSet<Id> = std::iter::from_fn(|| mempool.pop_transaction())
+            .map(|tx| tx.id().clone())
+            .collect();
+        assert_eq!(popped, HashSet::from([a.id().clone(), b.id().clone()]));
+    }
+
+    #[test]
+    fn test_remove_transaction_unlinks_indexes() {
+        let mut mempool = Mempool::new();
+        let a = make_trx("alice", 1, 100);
+        mempool.add_transaction(a.clone());
+        mempool.remove_transaction(a.id());
+        assert!(!mempool.has_transactions());
+        assert_eq!(mempool.sender_pending(Name::new(name!("alice")).as_u64()), 0);
+        // Re-adding after removal must succeed.
+        assert!(mempool.add_transaction(a));
+    }
 }
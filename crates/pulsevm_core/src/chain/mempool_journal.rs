@@ -0,0 +1,392 @@
+//! Append-only journal that carries the mempool across restarts.
+//!
+//! A restart used to drop every pending transaction and wait ~30s for
+//! gossip to repopulate the pool. The journal records each admitted
+//! transaction as it arrives and replays the survivors at startup, so a
+//! deploy restores thousands of pending transactions in well under a
+//! second.
+//!
+//! Writes happen off the admission path: `append` hands the transaction
+//! to a dedicated writer thread over a bounded channel (the same shape as
+//! the state-history writer), so gossip ingestion and RPC submission
+//! never wait on disk. The journal is best-effort by design — a full
+//! queue drops the write rather than stalling admission, and durability
+//! is buffered-write only; the authoritative copy of anything that
+//! matters is the chain itself.
+//!
+//! On-disk format: an 8-byte magic, then one frame per transaction of
+//! `[u32 len][u32 expiration][len bytes of packed PackedTransaction]`,
+//! all little-endian. Replay stops at the first short or oversized frame
+//! and truncates there, which makes a torn tail from a crash harmless.
+//! Entries are never deleted in place: replay rewrites the file with only
+//! the unexpired survivors, and the writer thread re-compacts by
+//! expiration whenever the file grows past a threshold, so the journal
+//! stays bounded by the pool's natural turnover.
+
+use std::{
+    fs::{File, OpenOptions},
+    io::{BufWriter, Read as _, Write as _},
+    path::{Path, PathBuf},
+    sync::mpsc::{Receiver, SyncSender, TrySendError, sync_channel},
+    time::{SystemTime, UNIX_EPOCH},
+};
+
+use pulsevm_error::ChainError;
+use pulsevm_serialization::{Read, Write};
+use spdlog::{error, warn};
+
+use crate::chain::transaction::PackedTransaction;
+
+const JOURNAL_MAGIC: u64 = 0x4c4e_4a4d_4556_4c50; // "PLVEMJNL"
+
+/// Pending appends the writer may run ahead of disk before `append`
+/// starts dropping instead of blocking the admission path.
+const QUEUE_DEPTH: usize = 4096;
+
+/// A frame longer than this is treated as corruption, not data; no
+/// transaction approaches it.
+const MAX_FRAME_BYTES: u32 = 16 * 1024 * 1024;
+
+/// File size past which the writer thread re-compacts the journal by
+/// dropping expired frames.
+const COMPACT_THRESHOLD_BYTES: u64 = 64 * 1024 * 1024;
+
+/// Seconds since epoch, the time base transaction expirations use.
+pub fn now_sec() -> u32 {
+    SystemTime::now()
+        .duration_since(UNIX_EPOCH)
+        .map(|d| d.as_secs() as u32)
+        .unwrap_or(0)
+}
+
+/// Handle to the journal's writer thread; cheap to clone and share with
+/// every admission site.
+#[derive(Clone)]
+pub struct MempoolJournal {
+    sender: SyncSender<PackedTransaction>,
+}
+
+impl MempoolJournal {
+    /// Opens (or creates) the journal at `path`, replays every entry that
+    /// has not expired by `now`, rewrites the file compacted to just those
+    /// survivors, and spawns the writer thread. Returns the handle and the
+    /// survivors, oldest first, for the caller to feed into the mempool.
+    pub fn open(path: &Path, now: u32) -> Result<(Self, Vec<PackedTransaction>), ChainError> {
+        let survivors = replay(path, now)
+            .map_err(|e| ChainError::InternalError(format!("failed to replay mempool journal: {}", e)))?;
+        rewrite(path, &survivors)
+            .map_err(|e| ChainError::InternalError(format!("failed to compact mempool journal: {}", e)))?;
+
+        let file = OpenOptions::new()
+            .create(true)
+            .append(true)
+            .open(path)
+            .map_err(|e| ChainError::InternalError(format!("failed to open mempool journal: {}", e)))?;
+
+        let (sender, receiver) = sync_channel(QUEUE_DEPTH);
+        let journal_path = path.to_path_buf();
+        std::thread::Builder::new()
+            .name("mempool-journal".into())
+            .spawn(move || writer_loop(journal_path, file, receiver))
+            .map_err(|e| {
+                ChainError::InternalError(format!("failed to spawn mempool journal thread: {}", e))
+            })?;
+
+        Ok((Self { sender }, survivors))
+    }
+
+    /// Queues `transaction` for journaling. Never blocks: if the writer is
+    /// a full queue behind, the entry is dropped — this transaction simply
+    /// won't survive a restart, same as before the journal existed.
+    pub fn append(&self, transaction: &PackedTransaction) {
+        match self.sender.try_send(transaction.clone()) {
+            Ok(()) => {}
+            Err(TrySendError::Full(_)) => {
+                warn!("mempool journal writer behind; dropping journal entry");
+            }
+            Err(TrySendError::Disconnected(_)) => {}
+        }
+    }
+}
+
+fn writer_loop(path: PathBuf, file: File, receiver: Receiver<PackedTransaction>) {
+    let mut bytes_written = file.metadata().map(|m| m.len()).unwrap_or(0);
+    let mut writer = BufWriter::new(file);
+
+    while let Ok(transaction) = receiver.recv() {
+        // Serialization happens here, off the admission path.
+        let payload = match transaction.pack() {
+            Ok(payload) => payload,
+            Err(e) => {
+                error!("failed to pack transaction for mempool journal: {}", e);
+                continue;
+            }
+        };
+        let expiration = transaction
+            .get_transaction()
+            .header
+            .expiration()
+            .sec_since_epoch();
+        if let Err(e) = write_frame(&mut writer, expiration, &payload) {
+            error!("failed to append to mempool journal: {}", e);
+            continue;
+        }
+        // Flush per entry (not fsync): an admitted transaction reaches the
+        // page cache right away, and a clean restart replays it even if
+        // the OS never got around to writing it back.
+        if let Err(e) = writer.flush() {
+            error!("failed to flush mempool journal: {}", e);
+        }
+        bytes_written += 8 + payload.len() as u64;
+
+        if bytes_written > COMPACT_THRESHOLD_BYTES {
+            match compact(&path, now_sec()) {
+                Ok(file) => {
+                    bytes_written = file.metadata().map(|m| m.len()).unwrap_or(0);
+                    writer = BufWriter::new(file);
+                }
+                Err(e) => error!("failed to compact mempool journal: {}", e),
+            }
+        }
+    }
+}
+
+fn write_frame<W: std::io::Write>(
+    mut w: W,
+    expiration: u32,
+    payload: &[u8],
+) -> std::io::Result<()> {
+    w.write_all(&(payload.len() as u32).to_le_bytes())?;
+    w.write_all(&expiration.to_le_bytes())?;
+    w.write_all(payload)
+}
+
+/// Reads every journaled transaction that expires after `now`. A missing
+/// file is an empty journal; a bad magic or a torn frame ends the replay
+/// at that point rather than failing it.
+fn replay(path: &Path, now: u32) -> std::io::Result<Vec<PackedTransaction>> {
+    let mut data = Vec::new();
+    match File::open(path) {
+        Ok(mut file) => {
+            file.read_to_end(&mut data)?;
+        }
+        Err(e) if e.kind() == std::io::ErrorKind::NotFound => return Ok(Vec::new()),
+        Err(e) => return Err(e),
+    }
+
+    if data.len() < 8 || data[..8] != JOURNAL_MAGIC.to_le_bytes() {
+        if !data.is_empty() {
+            warn!("mempool journal has unrecognized header; starting fresh");
+        }
+        return Ok(Vec::new());
+    }
+
+    let mut survivors = Vec::new();
+    let mut offset = 8usize;
+    while offset + 8 <= data.len() {
+        let len = u32::from_le_bytes(data[offset..offset + 4].try_into().unwrap());
+        let expiration = u32::from_le_bytes(data[offset + 4..offset + 8].try_into().unwrap());
+        offset += 8;
+        if len > MAX_FRAME_BYTES || offset + len as usize > data.len() {
+            warn!("mempool journal has torn tail; truncating replay there");
+            break;
+        }
+        let frame = &data[offset..offset + len as usize];
+        offset += len as usize;
+        if expiration <= now {
+            continue;
+        }
+        match PackedTransaction::read(frame, &mut 0) {
+            Ok(transaction) => survivors.push(transaction),
+            Err(e) => {
+                // One undecodable entry doesn't invalidate what framed
+                // correctly after it.
+                warn!("skipping undecodable mempool journal entry: {:?}", e);
+            }
+        }
+    }
+    Ok(survivors)
+}
+
+/// Rewrites the journal to contain exactly `transactions`, via tmp file
+/// and rename so a crash mid-rewrite leaves either the old or the new
+/// file, never a half-written one.
+fn rewrite(path: &Path, transactions: &[PackedTransaction]) -> std::io::Result<()> {
+    let tmp = tmp_path(path);
+    {
+        let mut writer = BufWriter::new(File::create(&tmp)?);
+        writer.write_all(&JOURNAL_MAGIC.to_le_bytes())?;
+        for transaction in transactions {
+            let payload = transaction
+                .pack()
+                .map_err(|e| std::io::Error::other(format!("pack failed: {}", e)))?;
+            let expiration = transaction
+                .get_transaction()
+                .header
+                .expiration()
+                .sec_since_epoch();
+            write_frame(&mut writer, expiration, &payload)?;
+        }
+        writer.flush()?;
+        writer.get_ref().sync_all()?;
+    }
+    std::fs::rename(&tmp, path)?;
+    fsync_parent_dir(path)
+}
+
+/// Drops expired frames by replaying and rewriting, then reopens the file
+/// for appending.
+fn compact(path: &Path, now: u32) -> std::io::Result<File> {
+    let survivors = replay(path, now)?;
+    rewrite(path, &survivors)?;
+    OpenOptions::new().append(true).open(path)
+}
+
+fn tmp_path(path: &Path) -> PathBuf {
+    // Append ".tmp" to the full filename rather than using
+    // `with_extension`, which swaps the last extension component.
+    let mut os = path.as_os_str().to_owned();
+    os.push(".tmp");
+    PathBuf::from(os)
+}
+
+fn fsync_parent_dir(path: &Path) -> std::io::Result<()> {
+    #[cfg(unix)]
+    {
+        if let Some(parent) = path.parent() {
+            File::open(parent)?.sync_all()?;
+        }
+    }
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use std::str::FromStr;
+    use std::sync::atomic::{AtomicU32, Ordering};
+
+    use pulsevm_ffi::TimePointSec;
+
+    use crate::{
+        ACTIVE_NAME,
+        chain::{
+            authority::PermissionLevel,
+            name::Name,
+            transaction::{Action, SignedTransaction, Transaction, TransactionHeader},
+        },
+    };
+
+    /// Unique scratch dir per test, cleaned up on drop. std-only, no
+    /// tempfile dependency.
+    struct TestDir(PathBuf);
+    impl TestDir {
+        fn new(tag: &str) -> Self {
+            static N: AtomicU32 = AtomicU32::new(0);
+            let dir = std::env::temp_dir().join(format!(
+                "mempool-journal-test-{tag}-{}-{}",
+                std::process::id(),
+                N.fetch_add(1, Ordering::Relaxed)
+            ));
+            std::fs::create_dir_all(&dir).unwrap();
+            TestDir(dir)
+        }
+        fn journal_path(&self) -> PathBuf {
+            self.0.join("mempool.journal")
+        }
+    }
+    impl Drop for TestDir {
+        fn drop(&mut self) {
+            let _ = std::fs::remove_dir_all(&self.0);
+        }
+    }
+
+    fn make_trx(actor: &str, data: u8, expiration: u32) -> PackedTransaction {
+        let trx = Transaction::new(
+            TransactionHeader::new(
+                TimePointSec::new(expiration),
+                0,
+                0,
+                0u32.into(),
+                0,
+                0u32.into(),
+            ),
+            vec![],
+            vec![Action::new(
+                Name::new(name!("token")),
+                Name::new(name!("transfer")),
+                vec![data],
+                vec![PermissionLevel::new(
+                    Name::from_str(actor).unwrap().as_u64(),
+                    ACTIVE_NAME.as_u64(),
+                )],
+            )],
+        );
+        PackedTransaction::from_signed_transaction(SignedTransaction::new(
+            trx,
+            Default::default(),
+            vec![],
+        ))
+        .unwrap()
+    }
+
+    fn append_sync(path: &Path, transactions: &[PackedTransaction]) {
+        // Drive frames through the same writer the journal thread uses,
+        // without depending on thread scheduling in a test.
+        let survivors = replay(path, 0).unwrap();
+        let mut all = survivors;
+        all.extend_from_slice(transactions);
+        rewrite(path, &all).unwrap();
+    }
+
+    #[test]
+    fn replay_restores_unexpired_transactions() {
+        let dir = TestDir::new("replay");
+        let path = dir.journal_path();
+        let stale = make_trx("alice", 1, 50);
+        let fresh = make_trx("bob", 2, 200);
+        append_sync(&path, &[stale, fresh.clone()]);
+
+        let (journal, survivors) = MempoolJournal::open(&path, 100).unwrap();
+        assert_eq!(survivors.len(), 1);
+        assert_eq!(survivors[0].id(), fresh.id());
+        drop(journal);
+
+        // The open compacted the file: a second replay at the same clock
+        // sees only the survivor, without re-filtering the stale entry.
+        let reread = replay(&path, 0).unwrap();
+        assert_eq!(reread.len(), 1);
+        assert_eq!(reread[0].id(), fresh.id());
+    }
+
+    #[test]
+    fn torn_tail_truncates_instead_of_failing() {
+        let dir = TestDir::new("torn");
+        let path = dir.journal_path();
+        let trx = make_trx("alice", 1, 200);
+        append_sync(&path, &[trx.clone()]);
+
+        // Simulate a crash mid-append: a frame header promising more bytes
+        // than the file holds.
+        let mut data = std::fs::read(&path).unwrap();
+        data.extend_from_slice(&1000u32.to_le_bytes());
+        data.extend_from_slice(&200u32.to_le_bytes());
+        data.extend_from_slice(&[0xab; 10]);
+        std::fs::write(&path, &data).unwrap();
+
+        let survivors = replay(&path, 100).unwrap();
+        assert_eq!(survivors.len(), 1);
+        assert_eq!(survivors[0].id(), trx.id());
+    }
+
+    #[test]
+    fn missing_or_foreign_file_is_an_empty_journal() {
+        let dir = TestDir::new("fresh");
+        let path = dir.journal_path();
+        assert!(replay(&path, 0).unwrap().is_empty());
+
+        std::fs::write(&path, b"not a journal").unwrap();
+        assert!(replay(&path, 0).unwrap().is_empty());
+    }
+}
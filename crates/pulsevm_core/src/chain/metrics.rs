@@ -0,0 +1,399 @@
+use std::{
+    fmt::Write,
+    sync::{
+        LazyLock,
+        atomic::{AtomicU64, Ordering},
+    },
+    time::Duration,
+};
+
+// Log2 microsecond buckets, the same shape the block profiler uses: bucket i
+// holds observations in [2^(i-1), 2^i) microseconds. Rendering converts the
+// bounds to seconds for Prometheus.
+const HISTOGRAM_BUCKETS: usize = 32;
+
+/// Process-wide operational counters served as Prometheus text exposition
+/// over the node's `/metrics` HTTP path.
+///
+/// Everything here is a relaxed atomic: recording is one `fetch_add` or
+/// `store`, so the hot paths (block execution, wasm intrinsic dispatch,
+/// mempool mutation, the state-history writer thread) pay nothing they would
+/// not already pay for a counter in a register. Aggregation — cumulative
+/// bucket sums, rate math, free-memory trending — is the scraper's job.
+pub static METRICS: LazyLock<NodeMetrics> = LazyLock::new(NodeMetrics::new);
+
+pub struct NodeMetrics {
+    // Wall time of `Controller::execute_block`, covering every block the node
+    // builds, verifies, accepts or replays.
+    block_exec_buckets: [AtomicU64; HISTOGRAM_BUCKETS],
+    block_exec_total_us: AtomicU64,
+    // Stateful wasm intrinsic invocations. Every host function that touches
+    // chain state funnels through `context_aware_check`, which is also where
+    // each call crosses into the chainbase FFI layer — so this one counter
+    // stands in for both "intrinsic calls" and "FFI round trips".
+    host_calls: AtomicU64,
+    // Compiled-module cache in the wasm runtime, one count per dispatch.
+    wasm_cache_hits: AtomicU64,
+    wasm_cache_misses: AtomicU64,
+    // Modules dropped by the cache's byte-budget enforcement, and the bytes
+    // currently held; a climbing eviction rate with a full budget is the
+    // signature of cache thrash worth a bigger `wasm_cache_max_bytes`.
+    wasm_cache_evictions: AtomicU64,
+    wasm_cache_bytes: AtomicU64,
+    // Metering points left in the wasm instance currently executing, sampled
+    // at every stateful host call (see `context_aware_check`). Gives a
+    // watchdog or scraper a live view of in-flight gas consumption instead
+    // of waiting for the action boundary; between actions it holds the last
+    // sampled value.
+    wasm_remaining_points: AtomicU64,
+    // Per-transaction wall time, billed CPU and net usage, observed at
+    // `TransactionContext::finalize` — once per execution pass, so a
+    // transaction that runs on the push, verify and accept paths counts on
+    // each. The flat tail these expose is what the slow-transaction ring in
+    // `crate::chain::slow_transactions` attributes to individual
+    // transactions.
+    trx_wall_buckets: [AtomicU64; HISTOGRAM_BUCKETS],
+    trx_wall_total_us: AtomicU64,
+    trx_cpu_buckets: [AtomicU64; HISTOGRAM_BUCKETS],
+    trx_cpu_total_us: AtomicU64,
+    trx_net_buckets: [AtomicU64; HISTOGRAM_BUCKETS],
+    trx_net_total_bytes: AtomicU64,
+    // Pending transactions after the most recent mempool mutation.
+    mempool_depth: AtomicU64,
+    // Latency of individual state-history log appends, measured on the
+    // writer thread (group-commit syncs are not included).
+    sh_append_buckets: [AtomicU64; HISTOGRAM_BUCKETS],
+    sh_append_total_us: AtomicU64,
+    // Unallocated bytes left in the chainbase shared-memory segment,
+    // refreshed after each accepted block.
+    db_free_memory_bytes: AtomicU64,
+    // Lifecycle of the retained speculative undo session (see
+    // `Controller::push_transaction`): sessions opened fresh against
+    // chainbase vs. executions served by reverting the retained one, and the
+    // latency of those reverts. Reuses staying well ahead of opens is the
+    // point of retaining the session.
+    spec_session_opens: AtomicU64,
+    spec_session_reuses: AtomicU64,
+    spec_session_revert_buckets: [AtomicU64; HISTOGRAM_BUCKETS],
+    spec_session_revert_total_us: AtomicU64,
+}
+
+impl NodeMetrics {
+    fn new() -> Self {
+        Self {
+            block_exec_buckets: [const { AtomicU64::new(0) }; HISTOGRAM_BUCKETS],
+            block_exec_total_us: AtomicU64::new(0),
+            host_calls: AtomicU64::new(0),
+            wasm_cache_hits: AtomicU64::new(0),
+            wasm_cache_misses: AtomicU64::new(0),
+            wasm_cache_evictions: AtomicU64::new(0),
+            wasm_cache_bytes: AtomicU64::new(0),
+            wasm_remaining_points: AtomicU64::new(0),
+            trx_wall_buckets: [const { AtomicU64::new(0) }; HISTOGRAM_BUCKETS],
+            trx_wall_total_us: AtomicU64::new(0),
+            trx_cpu_buckets: [const { AtomicU64::new(0) }; HISTOGRAM_BUCKETS],
+            trx_cpu_total_us: AtomicU64::new(0),
+            trx_net_buckets: [const { AtomicU64::new(0) }; HISTOGRAM_BUCKETS],
+            trx_net_total_bytes: AtomicU64::new(0),
+            mempool_depth: AtomicU64::new(0),
+            sh_append_buckets: [const { AtomicU64::new(0) }; HISTOGRAM_BUCKETS],
+            sh_append_total_us: AtomicU64::new(0),
+            db_free_memory_bytes: AtomicU64::new(0),
+            spec_session_opens: AtomicU64::new(0),
+            spec_session_reuses: AtomicU64::new(0),
+            spec_session_revert_buckets: [const { AtomicU64::new(0) }; HISTOGRAM_BUCKETS],
+            spec_session_revert_total_us: AtomicU64::new(0),
+        }
+    }
+
+    pub fn observe_block_execution(&self, elapsed: Duration) {
+        let us = elapsed.as_micros() as u64;
+        self.block_exec_buckets[Self::bucket_for(us)].fetch_add(1, Ordering::Relaxed);
+        self.block_exec_total_us.fetch_add(us, Ordering::Relaxed);
+    }
+
+    pub fn count_host_call(&self) {
+        self.host_calls.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn count_wasm_cache_hit(&self) {
+        self.wasm_cache_hits.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn count_wasm_cache_miss(&self) {
+        self.wasm_cache_misses.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn count_wasm_cache_eviction(&self) {
+        self.wasm_cache_evictions.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn set_wasm_cache_bytes(&self, bytes: u64) {
+        self.wasm_cache_bytes.store(bytes, Ordering::Relaxed);
+    }
+
+    pub fn set_wasm_remaining_points(&self, points: u64) {
+        self.wasm_remaining_points.store(points, Ordering::Relaxed);
+    }
+
+    pub fn observe_transaction(&self, wall_us: u64, cpu_us: u64, net_bytes: u64) {
+        self.trx_wall_buckets[Self::bucket_for(wall_us)].fetch_add(1, Ordering::Relaxed);
+        self.trx_wall_total_us.fetch_add(wall_us, Ordering::Relaxed);
+        self.trx_cpu_buckets[Self::bucket_for(cpu_us)].fetch_add(1, Ordering::Relaxed);
+        self.trx_cpu_total_us.fetch_add(cpu_us, Ordering::Relaxed);
+        self.trx_net_buckets[Self::bucket_for(net_bytes)].fetch_add(1, Ordering::Relaxed);
+        self.trx_net_total_bytes.fetch_add(net_bytes, Ordering::Relaxed);
+    }
+
+    pub fn set_mempool_depth(&self, depth: usize) {
+        self.mempool_depth.store(depth as u64, Ordering::Relaxed);
+    }
+
+    pub fn observe_state_history_append(&self, elapsed: Duration) {
+        let us = elapsed.as_micros() as u64;
+        self.sh_append_buckets[Self::bucket_for(us)].fetch_add(1, Ordering::Relaxed);
+        self.sh_append_total_us.fetch_add(us, Ordering::Relaxed);
+    }
+
+    pub fn set_db_free_memory(&self, bytes: u64) {
+        self.db_free_memory_bytes.store(bytes, Ordering::Relaxed);
+    }
+
+    pub fn count_speculative_session_open(&self) {
+        self.spec_session_opens.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn count_speculative_session_reuse(&self) {
+        self.spec_session_reuses.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn observe_speculative_session_revert(&self, elapsed: Duration) {
+        let us = elapsed.as_micros() as u64;
+        self.spec_session_revert_buckets[Self::bucket_for(us)].fetch_add(1, Ordering::Relaxed);
+        self.spec_session_revert_total_us.fetch_add(us, Ordering::Relaxed);
+    }
+
+    /// Renders the registry in Prometheus text exposition format 0.0.4.
+    pub fn render(&self) -> String {
+        let mut out = String::with_capacity(4096);
+        Self::render_histogram(
+            &mut out,
+            "pulsevm_block_execution_seconds",
+            "Wall time spent executing one block",
+            &self.block_exec_buckets,
+            self.block_exec_total_us.load(Ordering::Relaxed),
+        );
+        Self::render_counter(
+            &mut out,
+            "pulsevm_host_calls_total",
+            "Stateful wasm intrinsic calls (each one is a chainbase FFI round trip)",
+            self.host_calls.load(Ordering::Relaxed),
+        );
+        Self::render_counter(
+            &mut out,
+            "pulsevm_wasm_cache_hits_total",
+            "Wasm dispatches served from the compiled-module cache",
+            self.wasm_cache_hits.load(Ordering::Relaxed),
+        );
+        Self::render_counter(
+            &mut out,
+            "pulsevm_wasm_cache_misses_total",
+            "Wasm dispatches that had to load or compile a module",
+            self.wasm_cache_misses.load(Ordering::Relaxed),
+        );
+        Self::render_counter(
+            &mut out,
+            "pulsevm_wasm_cache_evictions_total",
+            "Modules dropped by the wasm cache's byte-budget enforcement",
+            self.wasm_cache_evictions.load(Ordering::Relaxed),
+        );
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_wasm_cache_bytes",
+            "Bytes currently held by the compiled-module cache",
+            self.wasm_cache_bytes.load(Ordering::Relaxed),
+        );
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_wasm_remaining_points",
+            "Metering points left in the currently executing wasm instance, sampled at host calls",
+            self.wasm_remaining_points.load(Ordering::Relaxed),
+        );
+        Self::render_histogram(
+            &mut out,
+            "pulsevm_transaction_wall_seconds",
+            "Wall time of one transaction execution pass",
+            &self.trx_wall_buckets,
+            self.trx_wall_total_us.load(Ordering::Relaxed),
+        );
+        Self::render_histogram(
+            &mut out,
+            "pulsevm_transaction_cpu_seconds",
+            "Billed CPU time of one transaction execution pass",
+            &self.trx_cpu_buckets,
+            self.trx_cpu_total_us.load(Ordering::Relaxed),
+        );
+        Self::render_bytes_histogram(
+            &mut out,
+            "pulsevm_transaction_net_bytes",
+            "Net usage billed to one transaction execution pass",
+            &self.trx_net_buckets,
+            self.trx_net_total_bytes.load(Ordering::Relaxed),
+        );
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_mempool_depth",
+            "Pending transactions in the mempool",
+            self.mempool_depth.load(Ordering::Relaxed),
+        );
+        Self::render_histogram(
+            &mut out,
+            "pulsevm_state_history_append_seconds",
+            "Latency of one state-history log append on the writer thread",
+            &self.sh_append_buckets,
+            self.sh_append_total_us.load(Ordering::Relaxed),
+        );
+        Self::render_gauge(
+            &mut out,
+            "pulsevm_chainbase_free_memory_bytes",
+            "Unallocated bytes in the chainbase shared-memory segment",
+            self.db_free_memory_bytes.load(Ordering::Relaxed),
+        );
+        Self::render_counter(
+            &mut out,
+            "pulsevm_speculative_session_opens_total",
+            "Speculative undo sessions opened fresh against chainbase",
+            self.spec_session_opens.load(Ordering::Relaxed),
+        );
+        Self::render_counter(
+            &mut out,
+            "pulsevm_speculative_session_reuses_total",
+            "Speculative executions served by reverting the retained undo session",
+            self.spec_session_reuses.load(Ordering::Relaxed),
+        );
+        Self::render_histogram(
+            &mut out,
+            "pulsevm_speculative_session_revert_seconds",
+            "Latency of reverting the retained speculative undo session",
+            &self.spec_session_revert_buckets,
+            self.spec_session_revert_total_us.load(Ordering::Relaxed),
+        );
+        out
+    }
+
+    fn bucket_for(us: u64) -> usize {
+        ((64 - us.leading_zeros()) as usize).min(HISTOGRAM_BUCKETS - 1)
+    }
+
+    fn render_counter(out: &mut String, name: &str, help: &str, value: u64) {
+        let _ = writeln!(out, "# HELP {name} {help}");
+        let _ = writeln!(out, "# TYPE {name} counter");
+        let _ = writeln!(out, "{name} {value}");
+    }
+
+    fn render_gauge(out: &mut String, name: &str, help: &str, value: u64) {
+        let _ = writeln!(out, "# HELP {name} {help}");
+        let _ = writeln!(out, "# TYPE {name} gauge");
+        let _ = writeln!(out, "{name} {value}");
+    }
+
+    fn render_histogram(
+        out: &mut String,
+        name: &str,
+        help: &str,
+        buckets: &[AtomicU64; HISTOGRAM_BUCKETS],
+        total_us: u64,
+    ) {
+        let _ = writeln!(out, "# HELP {name} {help}");
+        let _ = writeln!(out, "# TYPE {name} histogram");
+        let mut cumulative = 0u64;
+        for (i, bucket) in buckets.iter().enumerate() {
+            cumulative += bucket.load(Ordering::Relaxed);
+            // Bucket i holds [2^(i-1), 2^i) µs, so its inclusive upper bound
+            // in seconds is 2^i µs.
+            let le = (1u64 << i) as f64 / 1_000_000.0;
+            let _ = writeln!(out, "{name}_bucket{{le=\"{le}\"}} {cumulative}");
+        }
+        let _ = writeln!(out, "{name}_bucket{{le=\"+Inf\"}} {cumulative}");
+        let _ = writeln!(out, "{name}_sum {}", total_us as f64 / 1_000_000.0);
+        let _ = writeln!(out, "{name}_count {cumulative}");
+    }
+
+    // Same log2 buckets as `render_histogram`, but the observations are byte
+    // counts: bucket i holds [2^(i-1), 2^i) bytes and bounds render as bytes.
+    fn render_bytes_histogram(
+        out: &mut String,
+        name: &str,
+        help: &str,
+        buckets: &[AtomicU64; HISTOGRAM_BUCKETS],
+        total_bytes: u64,
+    ) {
+        let _ = writeln!(out, "# HELP {name} {help}");
+        let _ = writeln!(out, "# TYPE {name} histogram");
+        let mut cumulative = 0u64;
+        for (i, bucket) in buckets.iter().enumerate() {
+            cumulative += bucket.load(Ordering::Relaxed);
+            let le = 1u64 << i;
+            let _ = writeln!(out, "{name}_bucket{{le=\"{le}\"}} {cumulative}");
+        }
+        let _ = writeln!(out, "{name}_bucket{{le=\"+Inf\"}} {cumulative}");
+        let _ = writeln!(out, "{name}_sum {total_bytes}");
+        let _ = writeln!(out, "{name}_count {cumulative}");
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_render_counters_and_gauges() {
+        let metrics = NodeMetrics::new();
+        metrics.count_host_call();
+        metrics.count_host_call();
+        metrics.count_wasm_cache_hit();
+        metrics.count_wasm_cache_miss();
+        metrics.set_mempool_depth(42);
+        metrics.set_db_free_memory(1024);
+        metrics.set_wasm_remaining_points(777);
+
+        let text = metrics.render();
+        assert!(text.contains("pulsevm_host_calls_total 2\n"));
+        assert!(text.contains("pulsevm_wasm_cache_hits_total 1\n"));
+        assert!(text.contains("pulsevm_wasm_cache_misses_total 1\n"));
+        assert!(text.contains("pulsevm_wasm_remaining_points 777\n"));
+        assert!(text.contains("pulsevm_mempool_depth 42\n"));
+        assert!(text.contains("pulsevm_chainbase_free_memory_bytes 1024\n"));
+    }
+
+    #[test]
+    fn test_histogram_buckets_are_cumulative() {
+        let metrics = NodeMetrics::new();
+        metrics.observe_block_execution(Duration::from_micros(100));
+        metrics.observe_block_execution(Duration::from_micros(100));
+        metrics.observe_block_execution(Duration::from_millis(50));
+
+        let text = metrics.render();
+        // 100µs lands in the le=128µs bucket; the 50ms block only shows up
+        // in later buckets and the totals.
+        assert!(text.contains("pulsevm_block_execution_seconds_bucket{le=\"0.000128\"} 2\n"));
+        assert!(text.contains("pulsevm_block_execution_seconds_bucket{le=\"+Inf\"} 3\n"));
+        assert!(text.contains("pulsevm_block_execution_seconds_count 3\n"));
+        assert!(text.contains("pulsevm_block_execution_seconds_sum 0.0502\n"));
+    }
+
+    #[test]
+    fn test_transaction_histograms() {
+        let metrics = NodeMetrics::new();
+        metrics.observe_transaction(100, 50, 200);
+        metrics.observe_transaction(300, 50, 200);
+
+        let text = metrics.render();
+        assert!(text.contains("pulsevm_transaction_wall_seconds_bucket{le=\"0.000128\"} 1\n"));
+        assert!(text.contains("pulsevm_transaction_wall_seconds_count 2\n"));
+        assert!(text.contains("pulsevm_transaction_cpu_seconds_count 2\n"));
+        // 200 bytes lands in the le=256 bucket; the sum stays in bytes.
+        assert!(text.contains("pulsevm_transaction_net_bytes_bucket{le=\"256\"} 2\n"));
+        assert!(text.contains("pulsevm_transaction_net_bytes_sum 400\n"));
+    }
+}
@@ -1,22 +1,45 @@
 pub mod abi;
+pub mod accepted_tx_filter;
 pub mod account;
 pub mod apply_context;
 pub mod asset;
+pub mod authority_cache;
 pub mod authority_checker;
 pub mod authorization_manager;
 pub mod block;
+pub mod block_cache;
+pub mod block_profiler;
 pub mod config;
 pub mod controller;
+pub mod cpu_affinity;
 pub mod crypto;
+pub mod db_flusher;
+pub mod exec_phases;
+pub mod execution_accounting;
+pub mod execution_schedule;
+pub mod fork_store;
 pub mod id;
+pub mod memory_ledger;
 pub mod mempool;
+pub mod mempool_journal;
+pub mod metrics;
+pub mod native_token;
+pub mod prevalidator;
 pub mod pulse_contract;
+pub mod recovery_cache;
 pub mod resource;
 pub mod resource_limits;
+pub mod sequence_counters;
+pub mod slow_transactions;
+pub mod snapshot;
+pub mod state_diff;
 pub mod state_history;
+pub mod tapos_ring;
 pub mod transaction;
 pub mod transaction_context;
 pub mod utils;
+pub mod wasm_costs;
+pub mod wasm_memory;
 pub mod wasm_runtime;
 mod webassembly;
 
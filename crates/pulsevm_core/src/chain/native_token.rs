@@ -0,0 +1,293 @@
+use pulsevm_crypto::Bytes;
+use pulsevm_error::ChainError;
+use pulsevm_ffi::CxxDigest;
+use pulsevm_name_macro::name;
+use pulsevm_proc_macros::{NumBytes, Read, Write};
+use pulsevm_serialization::{Read as ReadTrait, Write as WriteTrait};
+
+use crate::chain::{
+    apply_context::ApplyContext,
+    asset::Asset,
+    name::Name,
+    transaction::Action,
+    utils::pulse_assert,
+};
+
+/// Native fast path for the reference token contract.
+///
+/// The overwhelming majority of actions on our chains are `transfer`s
+/// executing the exact wasm image shipped as
+/// `reference_contracts/pulse_token.wasm`. For that one audited code hash
+/// this module executes `transfer` and `issue` directly in Rust, through the
+/// same `ApplyContext` database and authorization primitives the wasm
+/// intrinsics use — so rows, payers, RAM deltas, notifications and receipt
+/// sequences come out byte-identical to the wasm run — while skipping
+/// instantiation, metering and the host-call boundary entirely.
+///
+/// The path engages only when the deployed code hash matches
+/// [`PULSE_TOKEN_CODE_HASH`] exactly; any other code, any other action of
+/// the contract, and every notification delivery still runs the wasm.
+/// Activation is a pure function of chain state, so every node running this
+/// build takes the same path for the same action.
+///
+/// CPU is billed from the fixed schedule below instead of the wasm's
+/// metering counter. The schedule is deterministic (a base per action plus
+/// a per-memo-byte term, mirroring the only data-dependent loop in the
+/// contract), but it is not the metering count the wasm would have
+/// produced — enabling this path is a coordinated upgrade, like any change
+/// to the metering schedule itself.
+
+/// sha256 of `reference_contracts/pulse_token.wasm`, the only code image
+/// this fast path stands in for.
+const PULSE_TOKEN_CODE_HASH: [u8; 32] = [
+    0xd0, 0xbb, 0xc7, 0x5f, 0x82, 0x16, 0xda, 0xb3, 0x07, 0xfa, 0x41, 0x1d, 0x49, 0x92, 0xf8,
+    0x1a, 0xb3, 0x94, 0x70, 0x7a, 0xb0, 0xd9, 0x5a, 0x41, 0x61, 0x11, 0xaf, 0x92, 0x0d, 0x0f,
+    0xa3, 0x84,
+];
+
+const TRANSFER_NAME: Name = Name::new(name!("transfer"));
+const ISSUE_NAME: Name = Name::new(name!("issue"));
+const ACCOUNTS_TABLE: Name = Name::new(name!("accounts"));
+const STAT_TABLE: Name = Name::new(name!("stat"));
+
+// Deterministic CPU points for the native executions. Sized to sit in the
+// same range as the metered wasm run so resource planning carries over.
+const TRANSFER_BASE_CPU: u64 = 2500;
+const ISSUE_BASE_CPU: u64 = 2000;
+const MEMO_BYTE_CPU: u64 = 2;
+
+#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
+struct TransferAction {
+    from: Name,
+    to: Name,
+    quantity: Asset,
+    memo: String,
+}
+
+#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
+struct IssueAction {
+    to: Name,
+    quantity: Asset,
+    memo: String,
+}
+
+/// Row layout of the contract's `stat` table.
+#[derive(Debug, Clone, PartialEq, Eq, Hash, Read, Write, NumBytes)]
+struct CurrencyStats {
+    supply: Asset,
+    max_supply: Asset,
+    issuer: Name,
+}
+
+/// Whether `action` is a primary execution of the audited token code. Only
+/// the first delivery qualifies (receiver == code account); notification
+/// deliveries run whatever code the notified account deployed.
+pub fn handles(receiver: &Name, action: &Action, code_hash: &CxxDigest) -> bool {
+    if receiver != action.account() {
+        return false;
+    }
+    let act = action.name().as_u64();
+    if act != TRANSFER_NAME.as_u64() && act != ISSUE_NAME.as_u64() {
+        return false;
+    }
+    code_hash.as_slice() == PULSE_TOKEN_CODE_HASH
+}
+
+/// Executes the action natively and returns the CPU points to bill. Callers
+/// must have checked [`handles`] first.
+pub fn apply(context: &mut ApplyContext, action: &Action) -> Result<u64, ChainError> {
+    if action.name().as_u64() == TRANSFER_NAME.as_u64() {
+        transfer(context, action)
+    } else {
+        issue(context, action)
+    }
+}
+
+fn transfer(context: &mut ApplyContext, act: &Action) -> Result<u64, ChainError> {
+    let t = act
+        .data_as::<TransferAction>()
+        .map_err(|e| ChainError::TransactionError(format!("failed to deserialize data: {}", e)))?;
+    let code = *act.account();
+
+    pulse_assert(
+        t.from != t.to,
+        ChainError::TransactionError("cannot transfer to self".into()),
+    )?;
+    context.require_authorization(&t.from, None)?;
+    pulse_assert(
+        context.is_account(&t.to)?,
+        ChainError::TransactionError("to account does not exist".into()),
+    )?;
+
+    let sym_code = t.quantity.symbol().code().as_u64();
+    let (_, st) = get_currency_stats(context, &code, sym_code, "unable to find key")?;
+
+    context.require_recipient(&t.from)?;
+    context.require_recipient(&t.to)?;
+
+    pulse_assert(
+        t.quantity.is_valid(),
+        ChainError::TransactionError("invalid quantity".into()),
+    )?;
+    pulse_assert(
+        t.quantity.amount() > 0,
+        ChainError::TransactionError("must transfer positive quantity".into()),
+    )?;
+    pulse_assert(
+        t.quantity.symbol() == st.supply.symbol(),
+        ChainError::TransactionError("symbol precision mismatch".into()),
+    )?;
+    pulse_assert(
+        t.memo.len() <= 256,
+        ChainError::TransactionError("memo has more than 256 bytes".into()),
+    )?;
+
+    // The recipient pays for a newly opened balance row when they
+    // authorized the transfer, matching the contract's payer choice.
+    let payer = if context.has_authorization(&t.to)? {
+        t.to
+    } else {
+        t.from
+    };
+
+    sub_balance(context, &code, &t.from, &t.quantity)?;
+    add_balance(context, &code, &t.to, &t.quantity, &payer)?;
+
+    Ok(TRANSFER_BASE_CPU + t.memo.len() as u64 * MEMO_BYTE_CPU)
+}
+
+fn issue(context: &mut ApplyContext, act: &Action) -> Result<u64, ChainError> {
+    let i = act
+        .data_as::<IssueAction>()
+        .map_err(|e| ChainError::TransactionError(format!("failed to deserialize data: {}", e)))?;
+    let code = *act.account();
+
+    pulse_assert(
+        i.quantity.symbol().is_valid(),
+        ChainError::TransactionError("invalid symbol name".into()),
+    )?;
+    pulse_assert(
+        i.memo.len() <= 256,
+        ChainError::TransactionError("memo has more than 256 bytes".into()),
+    )?;
+
+    let sym_code = i.quantity.symbol().code().as_u64();
+    let (stat_itr, st) = get_currency_stats(
+        context,
+        &code,
+        sym_code,
+        "token with symbol does not exist, create token before issue",
+    )?;
+
+    pulse_assert(
+        i.to == st.issuer,
+        ChainError::TransactionError("tokens can only be issued to issuer account".into()),
+    )?;
+    context.require_authorization(&st.issuer, None)?;
+    pulse_assert(
+        i.quantity.is_valid(),
+        ChainError::TransactionError("invalid quantity".into()),
+    )?;
+    pulse_assert(
+        i.quantity.amount() > 0,
+        ChainError::TransactionError("must issue positive quantity".into()),
+    )?;
+    pulse_assert(
+        i.quantity.symbol() == st.supply.symbol(),
+        ChainError::TransactionError("symbol precision mismatch".into()),
+    )?;
+    pulse_assert(
+        i.quantity.amount() <= st.max_supply.amount() - st.supply.amount(),
+        ChainError::TransactionError("quantity exceeds available supply".into()),
+    )?;
+
+    let updated = CurrencyStats {
+        supply: Asset::new(st.supply.amount() + i.quantity.amount(), *st.supply.symbol()),
+        ..st.clone()
+    };
+    context.db_update_i64(stat_itr, &Name::new(0), pack_row(&updated)?)?;
+
+    add_balance(context, &code, &st.issuer, &i.quantity, &st.issuer)?;
+
+    Ok(ISSUE_BASE_CPU + i.memo.len() as u64 * MEMO_BYTE_CPU)
+}
+
+fn get_currency_stats(
+    context: &mut ApplyContext,
+    code: &Name,
+    sym_code: u64,
+    missing_msg: &str,
+) -> Result<(i32, CurrencyStats), ChainError> {
+    // The stat table is scoped by the symbol code, with the symbol code as
+    // the primary key as well.
+    let itr = context.db_find_i64(code.as_u64(), sym_code, STAT_TABLE.as_u64(), sym_code)?;
+    pulse_assert(
+        itr >= 0,
+        ChainError::TransactionError(missing_msg.to_string()),
+    )?;
+    let st = read_row::<CurrencyStats>(context, itr)?;
+    Ok((itr, st))
+}
+
+fn sub_balance(
+    context: &mut ApplyContext,
+    code: &Name,
+    owner: &Name,
+    value: &Asset,
+) -> Result<(), ChainError> {
+    let sym_code = value.symbol().code().as_u64();
+    let itr = context.db_find_i64(code.as_u64(), owner.as_u64(), ACCOUNTS_TABLE.as_u64(), sym_code)?;
+    pulse_assert(
+        itr >= 0,
+        ChainError::TransactionError("no balance object found".into()),
+    )?;
+    let balance = read_row::<Asset>(context, itr)?;
+    pulse_assert(
+        balance.amount() >= value.amount(),
+        ChainError::TransactionError("overdrawn balance".into()),
+    )?;
+
+    let remaining = Asset::new(balance.amount() - value.amount(), *value.symbol());
+    // The owner pays for their own row, as in the contract's sub_balance.
+    context.db_update_i64(itr, owner, pack_row(&remaining)?)
+}
+
+fn add_balance(
+    context: &mut ApplyContext,
+    code: &Name,
+    owner: &Name,
+    value: &Asset,
+    ram_payer: &Name,
+) -> Result<(), ChainError> {
+    let sym_code = value.symbol().code().as_u64();
+    let itr = context.db_find_i64(code.as_u64(), owner.as_u64(), ACCOUNTS_TABLE.as_u64(), sym_code)?;
+    if itr < 0 {
+        context.db_store_i64(
+            owner.as_u64(),
+            ACCOUNTS_TABLE.as_u64(),
+            ram_payer.as_u64(),
+            sym_code,
+            Bytes::new(pack_row(value)?),
+        )?;
+    } else {
+        let balance = read_row::<Asset>(context, itr)?;
+        let total = Asset::new(balance.amount() + value.amount(), *value.symbol());
+        // Payer 0 keeps the existing payer, the contract's `same_payer`.
+        context.db_update_i64(itr, &Name::new(0), pack_row(&total)?)?;
+    }
+    Ok(())
+}
+
+fn read_row<T: ReadTrait>(context: &ApplyContext, iterator: i32) -> Result<T, ChainError> {
+    context
+        .db_get_i64_with(iterator, |bytes| {
+            let mut pos = 0;
+            T::read(bytes, &mut pos)
+        })?
+        .map_err(|e| ChainError::TransactionError(format!("malformed token table row: {}", e)))
+}
+
+fn pack_row<T: WriteTrait>(row: &T) -> Result<Vec<u8>, ChainError> {
+    row.pack()
+        .map_err(|e| ChainError::TransactionError(format!("failed to pack token table row: {}", e)))
+}
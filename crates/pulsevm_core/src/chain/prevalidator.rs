@@ -0,0 +1,223 @@
+use std::{num::NonZeroUsize, sync::Mutex};
+
+use lru::LruCache;
+use pulsevm_error::ChainError;
+use pulsevm_ffi::Database;
+
+use crate::chain::{
+    accepted_tx_filter::AcceptedTxFilter,
+    id::Id,
+    recovery_cache::RecoveryCache,
+    time::{TimePoint, seconds},
+    transaction::PackedTransaction,
+};
+
+// Remembers every transaction id that already went through pre-validation,
+// whatever the verdict. An id is a hash of the signed content, so a repeat is
+// either a re-gossiped copy of something we hold or a replay of something we
+// rejected — both are dropped without repeating the expensive checks.
+const SEEN_CACHE_CAPACITY: usize = 65536;
+
+/// Stateless pre-validation for gossiped transactions, run on worker threads
+/// in front of mempool admission so the consensus path never touches spam.
+///
+/// The cheap checks read no chain state: expiration is bounded against the
+/// wall clock (mirroring `TransactionContext::validate_expiration`, which
+/// re-checks against the pending block timestamp), duplicates are tracked in a
+/// local seen-id cache, and signature recovery goes through the shared
+/// [`RecoveryCache`] so the work is not repeated when the transaction is
+/// executed. Transactions already accepted into the chain are screened by the
+/// controller's [`AcceptedTxFilter`]; only a filter hit touches the database,
+/// and only to confirm the id really is in the unexpired dedup table before
+/// rejecting. Anything this filter passes is still fully validated by the
+/// controller; anything it rejects would have been rejected there too.
+pub struct TransactionPrevalidator {
+    chain_id: Id,
+    // Snapshot of the chain's max transaction lifetime at construction; only
+    // a spam bound here, the authoritative check happens at execution.
+    max_transaction_lifetime: u32,
+    recovery_cache: RecoveryCache,
+    accepted: AcceptedTxFilter,
+    db: Database,
+    seen: Mutex<LruCache<Id, ()>>,
+}
+
+impl TransactionPrevalidator {
+    pub fn new(
+        chain_id: Id,
+        max_transaction_lifetime: u32,
+        recovery_cache: RecoveryCache,
+        accepted: AcceptedTxFilter,
+        db: Database,
+    ) -> Self {
+        Self {
+            chain_id,
+            max_transaction_lifetime,
+            recovery_cache,
+            accepted,
+            db,
+            seen: Mutex::new(LruCache::new(NonZeroUsize::new(SEEN_CACHE_CAPACITY).unwrap())),
+        }
+    }
+
+    /// Run every stateless check against the current wall clock.
+    pub fn prevalidate(&self, transaction: &PackedTransaction) -> Result<(), ChainError> {
+        self.prevalidate_at(transaction, TimePoint::now())
+    }
+
+    pub fn prevalidate_at(
+        &self,
+        transaction: &PackedTransaction,
+        now: TimePoint,
+    ) -> Result<(), ChainError> {
+        self.check_expiration(transaction, now)?;
+        self.check_duplicate(transaction.id())?;
+        self.check_already_accepted(transaction.id(), now)?;
+        self.recover_keys(transaction)?;
+        Ok(())
+    }
+
+    fn check_expiration(
+        &self,
+        transaction: &PackedTransaction,
+        now: TimePoint,
+    ) -> Result<(), ChainError> {
+        let expiration: TimePoint = transaction.get_transaction().header.expiration().into();
+
+        if expiration < now {
+            return Err(ChainError::TransactionError(
+                "transaction expired".to_string(),
+            ));
+        }
+
+        if expiration > now + seconds(self.max_transaction_lifetime as i64) {
+            return Err(ChainError::TransactionError(
+                "transaction has too long lifetime".to_string(),
+            ));
+        }
+
+        Ok(())
+    }
+
+    fn check_duplicate(&self, id: &Id) -> Result<(), ChainError> {
+        let mut seen = self
+            .seen
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+
+        if seen.put(id.clone(), ()).is_some() {
+            return Err(ChainError::TransactionError(
+                "duplicate transaction".to_string(),
+            ));
+        }
+
+        Ok(())
+    }
+
+    // A filter miss proves the id was not accepted within the expiration
+    // window, so the common fresh-transaction case never probes the database;
+    // a hit is confirmed against the authoritative dedup table so a Bloom
+    // false positive never rejects a fresh transaction.
+    fn check_already_accepted(&self, id: &Id, now: TimePoint) -> Result<(), ChainError> {
+        if !self.accepted.maybe_contains_at(id, now) {
+            return Ok(());
+        }
+
+        let digest = id.to_digest()?;
+        if self.db.is_known_unexpired_transaction(&digest)? {
+            return Err(ChainError::TransactionError(
+                "duplicate transaction".to_string(),
+            ));
+        }
+
+        Ok(())
+    }
+
+    fn recover_keys(&self, transaction: &PackedTransaction) -> Result<(), ChainError> {
+        if self.recovery_cache.get(transaction.id()).is_some() {
+            return Ok(());
+        }
+
+        let keys = transaction
+            .get_signed_transaction()
+            .recovered_keys(&self.chain_id)?;
+        self.recovery_cache.put(transaction.id().clone(), keys);
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use std::str::FromStr;
+
+    use pulsevm_ffi::TimePointSec;
+
+    use crate::{
+        ACTIVE_NAME,
+        chain::{
+            authority::PermissionLevel,
+            name::Name,
+            transaction::{Action, SignedTransaction, Transaction, TransactionHeader},
+        },
+    };
+
+    fn make_trx(expiration: u32) -> PackedTransaction {
+        let trx = Transaction::new(
+            TransactionHeader::new(
+                TimePointSec::new(expiration),
+                0,
+                0,
+                0u32.into(),
+                0,
+                0u32.into(),
+            ),
+            vec![],
+            vec![Action::new(
+                Name::new(name!("token")),
+                Name::new(name!("transfer")),
+                vec![expiration as u8],
+                vec![PermissionLevel::new(
+                    Name::new(name!("alice")).as_u64(),
+                    ACTIVE_NAME.as_u64(),
+                )],
+            )],
+        );
+        PackedTransaction::from_signed_transaction(SignedTransaction::new(
+            trx,
+            Default::default(),
+            vec![],
+        ))
+        .unwrap()
+    }
+
+    fn make_prevalidator() -> TransactionPrevalidator {
+        // An empty accepted filter never probes the default database.
+        TransactionPrevalidator::new(
+            Id::default(),
+            3600,
+            RecoveryCache::new(),
+            AcceptedTxFilter::new(),
+            Database::default(),
+        )
+    }
+
+    #[test]
+    fn test_fresh_transaction_passes_once() {
+        let prevalidator = make_prevalidator();
+        let trx = make_trx(100);
+        let now: TimePoint = TimePointSec::new(50).into();
+        assert!(prevalidator.prevalidate_at(&trx, now).is_ok());
+        // A re-gossiped copy is dropped as a duplicate.
+        assert!(prevalidator.prevalidate_at(&trx, now).is_err());
+    }
+
+    #[test]
+    fn test_expired_and_far_future_are_rejected() {
+        let prevalidator = make_prevalidator();
+        let now: TimePoint = TimePointSec::new(1000).into();
+        assert!(prevalidator.prevalidate_at(&make_trx(999), now).is_err());
+        assert!(prevalidator.prevalidate_at(&make_trx(1000 + 3601), now).is_err());
+    }
+}
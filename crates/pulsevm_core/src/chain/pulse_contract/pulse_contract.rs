@@ -1,3 +1,8 @@
+use std::{
+    collections::HashSet,
+    sync::{LazyLock, RwLock},
+};
+
 use pulsevm_billable_size::billable_size_v;
 use pulsevm_constants::{OVERHEAD_PER_ACCOUNT_RAM_BYTES, SETCODE_RAM_BYTES_MULTIPLIER};
 use pulsevm_error::ChainError;
@@ -111,6 +116,18 @@ pub fn newaccount(
     Ok(())
 }
 
+// Code hashes that already passed wasm validation. Validation is a pure
+// function of the bytes, so its verdict can be reused: the speculative
+// mempool execution of a setcode warms this set, and the block-path
+// re-execution of the same deploy skips a second multi-megabyte opcode
+// walk instead of stalling block production.
+static VALIDATED_CODE: LazyLock<RwLock<HashSet<[u8; 32]>>> =
+    LazyLock::new(|| RwLock::new(HashSet::new()));
+
+// Deploys are rare; a small cap with wholesale eviction keeps the set from
+// growing without bound on a long-lived node.
+const VALIDATED_CODE_CAP: usize = 256;
+
 pub fn setcode(
     context: &mut ApplyContext,
     db: &mut Database,
@@ -135,11 +152,31 @@ pub fn setcode(
 
     if code_size > 0 {
         code_hash = CxxDigest::hash(act.code.as_slice())?;
+        let hash_key: [u8; 32] = code_hash
+            .as_ref()
+            .unwrap()
+            .as_slice()
+            .try_into()
+            .map_err(|_| ChainError::InternalError("code hash is not 32 bytes".to_string()))?;
+
+        let already_validated = VALIDATED_CODE
+            .read()
+            .map(|set| set.contains(&hash_key))
+            .unwrap_or(false);
+
+        if !already_validated {
+            // Validate the code before accepting it
+            pulsevm_wasm_validation::validate_wasm(act.code.as_slice()).map_err(|e| {
+                ChainError::TransactionError(format!("contract code failed validation: {}", e))
+            })?;
 
-        // Validate the code before accepting it
-        pulsevm_wasm_validation::validate_wasm(act.code.as_slice()).map_err(|e| {
-            ChainError::TransactionError(format!("contract code failed validation: {}", e))
-        })?;
+            if let Ok(mut set) = VALIDATED_CODE.write() {
+                if set.len() >= VALIDATED_CODE_CAP {
+                    set.clear();
+                }
+                set.insert(hash_key);
+            }
+        }
     }
 
     let account = db.get_account_metadata(act.account.as_u64())?;
@@ -95,8 +95,8 @@ mod tests {
     #[test]
     fn test_new_account_serialization() {
         let new_account = NewAccount {
-            creator: Name::from_str("alice").unwrap(),
-            name: Name::from_str("newaccount").unwrap(),
+            creator: Name::new(name!("alice")),
+            name: Name::new(name!("newaccount")),
             owner: Authority::new(
                 1,
                 vec![KeyWeight {
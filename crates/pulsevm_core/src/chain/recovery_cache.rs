@@ -0,0 +1,51 @@
+use std::{
+    collections::BTreeSet,
+    num::NonZeroUsize,
+    sync::{Arc, Mutex},
+};
+
+use lru::LruCache;
+
+use crate::{chain::id::Id, crypto::PublicKey};
+
+// Signature recovery results keyed by transaction id. A transaction is
+// recovered on RPC admission, again when it is packed into a block, and once
+// more per verification/acceptance replay; the id is a hash of the signed
+// content and the signing digest binds the chain id, so a cached result can
+// never go stale within one process.
+#[derive(Clone)]
+pub struct RecoveryCache {
+    inner: Arc<Mutex<LruCache<Id, BTreeSet<PublicKey>>>>,
+}
+
+// Comfortably covers a full mempool plus the blocks in flight around it.
+const RECOVERY_CACHE_CAPACITY: usize = 16384;
+
+impl RecoveryCache {
+    pub fn new() -> Self {
+        Self {
+            inner: Arc::new(Mutex::new(LruCache::new(
+                NonZeroUsize::new(RECOVERY_CACHE_CAPACITY).unwrap(),
+            ))),
+        }
+    }
+
+    pub fn get(&self, id: &Id) -> Option<BTreeSet<PublicKey>> {
+        match self.inner.lock() {
+            Ok(mut cache) => cache.get(id).cloned(),
+            Err(_) => None, // treat a poisoned cache as empty
+        }
+    }
+
+    pub fn put(&self, id: Id, keys: BTreeSet<PublicKey>) {
+        if let Ok(mut cache) = self.inner.lock() {
+            cache.put(id, keys);
+        }
+    }
+}
+
+impl Default for RecoveryCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
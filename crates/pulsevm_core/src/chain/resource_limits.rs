@@ -1,5 +1,5 @@
 use pulsevm_error::ChainError;
-use pulsevm_ffi::{Database, ElasticLimitParameters};
+use pulsevm_ffi::{AccountRamDelta, Database, ElasticLimitParameters};
 
 use crate::name::Name;
 
@@ -35,6 +35,32 @@ impl ResourceLimitsManager {
         Ok(())
     }
 
+    /// Combined form of [`Self::get_account_cpu_limit`] followed by
+    /// [`Self::update_account_usage`]: one FFI crossing on the
+    /// per-transaction init path instead of two. Returns `(limit,
+    /// greylisted)` computed before the usage window is refreshed, matching
+    /// the order the separate calls had.
+    pub fn update_account_usage_and_get_cpu_limit(
+        db: &mut Database,
+        account: &Name,
+        time_slot: u32,
+        greylist_limit: Option<u32>,
+    ) -> Result<(i64, bool), ChainError> {
+        let res = db
+            .update_account_usage_and_get_cpu_limit(
+                account,
+                time_slot,
+                greylist_limit.unwrap_or(1000),
+            )
+            .map_err(|e| {
+                ChainError::DatabaseError(format!(
+                    "failed to update account usage for account {}: {}",
+                    account, e
+                ))
+            })?;
+        Ok((res.limit, res.greylisted))
+    }
+
     pub fn add_transaction_usage(
         db: &mut Database,
         account: &Name,
@@ -67,18 +93,25 @@ impl ResourceLimitsManager {
         Ok(())
     }
 
+    /// Applies a transaction's accumulated per-account RAM deltas in one
+    /// bridge crossing; accounts whose usage grew are limit-checked on the
+    /// C++ side in the same pass.
+    ///
+    /// The bridge already returns a typed error — a limit failure arrives
+    /// as [`ChainError::RamUsageExceeded`] — so it is propagated untouched
+    /// rather than re-wrapped into a `DatabaseError` string.
+    pub fn apply_ram_usage_deltas(
+        db: &mut Database,
+        deltas: &[AccountRamDelta],
+    ) -> Result<(), ChainError> {
+        db.apply_ram_usage_deltas(deltas)
+    }
+
     pub fn verify_account_ram_usage(
         db: &mut Database,
         account_name: &Name,
     ) -> Result<(), ChainError> {
         db.verify_account_ram_usage(account_name.as_u64())
-            .map_err(|e| {
-                ChainError::DatabaseError(format!(
-                    "failed to verify ram usage for account {}: {}",
-                    account_name, e
-                ))
-            })?;
-        Ok(())
     }
 
     pub fn get_account_ram_usage(db: &Database, account: &Name) -> Result<i64, ChainError> {
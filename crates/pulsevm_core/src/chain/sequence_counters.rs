@@ -0,0 +1,117 @@
+use std::collections::BTreeMap;
+
+use pulsevm_error::ChainError;
+use pulsevm_ffi::{AccountSequence, Database};
+
+/// Rust-side shadow of the action sequence counters: the global action
+/// sequence on the dynamic global properties and the per-account
+/// `recv_sequence`/`auth_sequence` on account metadata. Every action
+/// receipt draws three values from these counters, and incrementing them
+/// through chainbase costs an FFI crossing plus undo tracking per value.
+/// The shadow turns the increments into plain map updates and writes the
+/// final values back in one [`Database::flush_sequence_counters`] call per
+/// block.
+///
+/// Undo discipline mirrors the session stacking: each transaction runs on
+/// a clone of the block-level shadow, and the controller adopts the clone
+/// only when the transaction's child session is squashed — a failed
+/// transaction's increments are dropped with its session. The block-level
+/// shadow itself is cleared whenever the session lineage it grew on is
+/// undone (see the `sequence_shadow` handling in `Controller`).
+#[derive(Debug, Default, Clone)]
+pub struct SequenceCounters {
+    // `None` until the first action of the lineage seeds it from the
+    // database.
+    global_action_sequence: Option<u64>,
+    // Both maps hold the counter's current value (actions so far), keyed
+    // by account name; absent accounts are untouched this lineage.
+    recv_sequence: BTreeMap<u64, u64>,
+    auth_sequence: BTreeMap<u64, u64>,
+}
+
+impl SequenceCounters {
+    /// Increments and returns the global action sequence; `current_in_db`
+    /// is only consulted on the first call of the lineage.
+    pub fn next_global_sequence(
+        &mut self,
+        current_in_db: impl FnOnce() -> Result<u64, ChainError>,
+    ) -> Result<u64, ChainError> {
+        let next = match self.global_action_sequence {
+            Some(current) => current + 1,
+            None => current_in_db()? + 1,
+        };
+        self.global_action_sequence = Some(next);
+        Ok(next)
+    }
+
+    /// Increments and returns `account`'s receive sequence. `current_in_db`
+    /// seeds the first touch of the lineage; callers read it off the
+    /// already-cached account metadata.
+    pub fn next_recv_sequence(&mut self, account: u64, current_in_db: u64) -> u64 {
+        let counter = self.recv_sequence.entry(account).or_insert(current_in_db);
+        *counter += 1;
+        *counter
+    }
+
+    /// Increments and returns `account`'s authorization sequence; seeding
+    /// as in [`Self::next_recv_sequence`].
+    pub fn next_auth_sequence(&mut self, account: u64, current_in_db: u64) -> u64 {
+        let counter = self.auth_sequence.entry(account).or_insert(current_in_db);
+        *counter += 1;
+        *counter
+    }
+
+    /// Forgets all shadowed values; the next access re-seeds from the
+    /// database. Called whenever the undo session lineage the values were
+    /// accumulated on is unwound.
+    pub fn clear(&mut self) {
+        self.global_action_sequence = None;
+        self.recv_sequence.clear();
+        self.auth_sequence.clear();
+    }
+
+    /// Writes the shadowed values back to chainbase in one FFI crossing and
+    /// clears the shadow. Must run inside the undo session the counters
+    /// were accumulated under, so an unwound block also unwinds the flush.
+    pub fn flush(&mut self, db: &mut Database) -> Result<(), ChainError> {
+        let Some(global_action_sequence) = self.global_action_sequence.take() else {
+            // No action executed on this lineage; nothing to write.
+            debug_assert!(self.recv_sequence.is_empty() && self.auth_sequence.is_empty());
+            return Ok(());
+        };
+        let to_flush = |counters: &BTreeMap<u64, u64>| {
+            counters
+                .iter()
+                .map(|(&account, &sequence)| AccountSequence { account, sequence })
+                .collect::<Vec<_>>()
+        };
+        db.flush_sequence_counters(
+            global_action_sequence,
+            &to_flush(&self.recv_sequence),
+            &to_flush(&self.auth_sequence),
+        )?;
+        self.recv_sequence.clear();
+        self.auth_sequence.clear();
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn counters_increment_from_their_seeds() {
+        let mut counters = SequenceCounters::default();
+        assert_eq!(counters.next_global_sequence(|| Ok(41)).unwrap(), 42);
+        assert_eq!(counters.next_global_sequence(|| unreachable!()).unwrap(), 43);
+
+        assert_eq!(counters.next_recv_sequence(7, 10), 11);
+        assert_eq!(counters.next_recv_sequence(7, 999), 12); // seed ignored after first touch
+        assert_eq!(counters.next_auth_sequence(7, 0), 1);
+
+        counters.clear();
+        assert_eq!(counters.next_global_sequence(|| Ok(0)).unwrap(), 1);
+        assert_eq!(counters.next_recv_sequence(7, 12), 13);
+    }
+}
@@ -0,0 +1,154 @@
+use std::{
+    collections::VecDeque,
+    sync::{
+        LazyLock, Mutex,
+        atomic::{AtomicU64, Ordering},
+    },
+};
+
+use crate::chain::{id::Id, name::Name};
+
+// Retained slow-transaction records; the ring is meant to hold the tail of
+// the last few minutes, not a history — anything older has scrolled out of
+// the incident being debugged anyway.
+const RETAINED_RECORDS: usize = 64;
+
+// Action rows kept per record. A record keeps the true action count either
+// way; past the cap only the timing rows are dropped, so an inline fan-out
+// of thousands of actions cannot balloon the ring.
+pub const MAX_ACTIONS_PER_RECORD: usize = 32;
+
+// Transactions at or above this wall time leave a record by default. Well
+// under the 500ms block interval, but far enough above a healthy
+// transaction that an idle chain logs nothing.
+const DEFAULT_THRESHOLD_US: u64 = 50_000;
+
+/// Slow-transaction tracer behind the per-transaction latency histograms in
+/// [`crate::chain::metrics`].
+///
+/// The histograms say *that* the tail moved; this says *which* transactions
+/// moved it. Every execution pass whose wall time crosses the threshold
+/// leaves a structured record — action chain with per-action timing,
+/// host-call count, cpu/net billed — in a ring that
+/// `pulsevm.getSlowTransactions` serves. The threshold is runtime-tunable,
+/// so an operator can lower it to widen the net during an incident without
+/// restarting the node. A transaction executed on several paths (push,
+/// build, verify, accept) can appear once per slow pass; each row is one
+/// observed slow execution, not one transaction.
+pub static SLOW_TRX_LOG: LazyLock<SlowTransactionLog> = LazyLock::new(SlowTransactionLog::new);
+
+#[derive(Clone)]
+pub struct SlowActionRecord {
+    pub receiver: Name,
+    pub contract: Name,
+    pub action: Name,
+    pub elapsed_us: u32,
+}
+
+#[derive(Clone)]
+pub struct SlowTransactionRecord {
+    pub trx_id: Id,
+    pub block_num: u32,
+    pub wall_us: u64,
+    pub cpu_us: u64,
+    pub net_bytes: u64,
+    /// Stateful host calls the transaction issued — its chainbase FFI
+    /// round trips.
+    pub host_calls: u64,
+    /// True action count; `actions` holds at most
+    /// [`MAX_ACTIONS_PER_RECORD`] of them.
+    pub actions_total: u32,
+    pub actions: Vec<SlowActionRecord>,
+}
+
+pub struct SlowTransactionLog {
+    threshold_us: AtomicU64,
+    // Newest record at the back.
+    records: Mutex<VecDeque<SlowTransactionRecord>>,
+}
+
+impl SlowTransactionLog {
+    fn new() -> Self {
+        Self {
+            threshold_us: AtomicU64::new(DEFAULT_THRESHOLD_US),
+            records: Mutex::new(VecDeque::new()),
+        }
+    }
+
+    /// Whether `wall_us` crosses the slow threshold; callers gate on this
+    /// before building a record, so the fast path is one atomic load.
+    pub fn is_slow(&self, wall_us: u64) -> bool {
+        wall_us >= self.threshold_us.load(Ordering::Relaxed)
+    }
+
+    pub fn threshold_us(&self) -> u64 {
+        self.threshold_us.load(Ordering::Relaxed)
+    }
+
+    pub fn set_threshold_us(&self, threshold_us: u64) {
+        self.threshold_us.store(threshold_us, Ordering::Relaxed);
+    }
+
+    pub fn record(&self, record: SlowTransactionRecord) {
+        let mut records = self.lock();
+        records.push_back(record);
+        while records.len() > RETAINED_RECORDS {
+            records.pop_front();
+        }
+    }
+
+    /// Retained records, newest first.
+    pub fn snapshot(&self) -> Vec<SlowTransactionRecord> {
+        self.lock().iter().rev().cloned().collect()
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, VecDeque<SlowTransactionRecord>> {
+        // A panic mid-record at worst loses one entry; the ring stays usable.
+        self.records
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn record_with(block_num: u32, wall_us: u64) -> SlowTransactionRecord {
+        SlowTransactionRecord {
+            trx_id: Id::default(),
+            block_num,
+            wall_us,
+            cpu_us: wall_us / 2,
+            net_bytes: 128,
+            host_calls: 7,
+            actions_total: 1,
+            actions: Vec::new(),
+        }
+    }
+
+    #[test]
+    fn test_threshold_gates_and_is_tunable() {
+        let log = SlowTransactionLog::new();
+        assert!(!log.is_slow(DEFAULT_THRESHOLD_US - 1));
+        assert!(log.is_slow(DEFAULT_THRESHOLD_US));
+
+        log.set_threshold_us(1_000);
+        assert_eq!(log.threshold_us(), 1_000);
+        assert!(log.is_slow(1_000));
+    }
+
+    #[test]
+    fn test_ring_trims_oldest_and_snapshots_newest_first() {
+        let log = SlowTransactionLog::new();
+        for i in 0..(RETAINED_RECORDS as u32 + 3) {
+            log.record(record_with(i, 60_000));
+        }
+
+        let snapshot = log.snapshot();
+        assert_eq!(snapshot.len(), RETAINED_RECORDS);
+        // Newest first; the three oldest blocks fell off the front.
+        assert_eq!(snapshot[0].block_num, RETAINED_RECORDS as u32 + 2);
+        assert_eq!(snapshot.last().unwrap().block_num, 3);
+    }
+}
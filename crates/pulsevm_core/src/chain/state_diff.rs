@@ -0,0 +1,265 @@
+use std::{
+    collections::HashMap,
+    sync::{
+        Arc, LazyLock, Mutex,
+        atomic::{AtomicBool, Ordering},
+    },
+};
+
+use pulsevm_crypto::Bytes;
+use tokio::sync::broadcast;
+
+use crate::chain::{id::Id, name::Name};
+
+// Buffered accepted-block diff batches per subscriber. A subscriber that
+// falls this far behind starts losing batches (broadcast drops the oldest),
+// which consumers must treat as a signal to resynchronize from state.
+const DIFF_BROADCAST_CAPACITY: usize = 64;
+
+/// Push pipeline for live table-change notification.
+///
+/// Subscribers register (code, table) filters; the db intrinsics in
+/// [`crate::chain::apply_context`] match every key-value write against them
+/// and queue the hits, and acceptance publishes each block's matched writes
+/// as one batch on a broadcast channel — so a consumer watching a handful
+/// of tables sees their committed rows within the accept path's latency,
+/// without draining full state-history. The per-write cost when nobody
+/// subscribes is one relaxed atomic load.
+///
+/// Process-wide like the accounting ledger next door: writes happen inside
+/// apply contexts, which have no controller handle to reach through.
+pub static STATE_DIFF_HUB: LazyLock<StateDiffHub> = LazyLock::new(StateDiffHub::new);
+
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum StateDiffOp {
+    Store,
+    Update,
+    Remove,
+}
+
+/// One matched key-value write, in block execution order.
+#[derive(Clone)]
+pub struct StateDiffEvent {
+    pub code: Name,
+    pub scope: Name,
+    pub table: Name,
+    pub primary_key: u64,
+    pub op: StateDiffOp,
+    /// Row value after the write; empty for removals. Shares the
+    /// allocation the write itself used — queuing an event never copies
+    /// the row.
+    pub value: Bytes,
+}
+
+/// All matched writes of one accepted block, published as a single batch.
+pub struct StateDiffBlock {
+    pub block_num: u32,
+    pub block_id: Id,
+    pub events: Vec<StateDiffEvent>,
+}
+
+/// Live handle to the diff stream. Dropping it retires the filters it
+/// registered; once no subscription watches a (code, table) pair, writes to
+/// it go back to costing a single atomic load.
+pub struct StateDiffSubscription {
+    hub: &'static StateDiffHub,
+    keys: Vec<(u64, u64)>,
+    pub receiver: broadcast::Receiver<Arc<StateDiffBlock>>,
+}
+
+impl Drop for StateDiffSubscription {
+    fn drop(&mut self) {
+        self.hub.unregister(&self.keys);
+    }
+}
+
+struct Inner {
+    // (code, table) -> number of live subscriptions watching the pair.
+    filters: HashMap<(u64, u64), usize>,
+    // Matched writes of the execution pass in flight; cleared at the top of
+    // every block execution, published only on acceptance, so writes from a
+    // pass whose block is never accepted are discarded with the pass.
+    pending: Vec<StateDiffEvent>,
+}
+
+pub struct StateDiffHub {
+    // Mirrors "is the filter map non-empty"; the write-path fast path reads
+    // this instead of taking the lock.
+    active: AtomicBool,
+    inner: Mutex<Inner>,
+    sender: broadcast::Sender<Arc<StateDiffBlock>>,
+}
+
+impl StateDiffHub {
+    fn new() -> Self {
+        Self {
+            active: AtomicBool::new(false),
+            inner: Mutex::new(Inner {
+                filters: HashMap::new(),
+                pending: Vec::new(),
+            }),
+            sender: broadcast::channel(DIFF_BROADCAST_CAPACITY).0,
+        }
+    }
+
+    /// Whether any subscription exists at all — the cheapest possible gate,
+    /// for write paths that would have to look up their table names before
+    /// they could ask [`Self::matches`].
+    #[inline]
+    pub fn is_active(&self) -> bool {
+        self.active.load(Ordering::Relaxed)
+    }
+
+    /// Whether some subscription watches this (code, table) pair.
+    #[inline]
+    pub fn matches(&self, code: u64, table: u64) -> bool {
+        if !self.active.load(Ordering::Relaxed) {
+            return false;
+        }
+        self.lock().filters.contains_key(&(code, table))
+    }
+
+    /// Queues a matched write for the block in flight. Callers gate on
+    /// [`Self::matches`] first; this unconditionally buffers.
+    pub fn record(&self, event: StateDiffEvent) {
+        self.lock().pending.push(event);
+    }
+
+    /// Drops whatever the previous execution pass queued. Called at the top
+    /// of block execution, so a verify pass followed by an accept pass of
+    /// the same block keeps only the final one, and passes whose block never
+    /// gets accepted leave nothing behind.
+    pub fn begin_block(&self) {
+        self.lock().pending.clear();
+    }
+
+    /// Publishes the queued writes as this block's batch. Called only on
+    /// acceptance; a no-op send when nothing matched or nobody listens.
+    pub fn publish(&self, block_num: u32, block_id: &Id) {
+        let events = std::mem::take(&mut self.lock().pending);
+        if events.is_empty() || self.sender.receiver_count() == 0 {
+            return;
+        }
+        let _ = self.sender.send(Arc::new(StateDiffBlock {
+            block_num,
+            block_id: *block_id,
+            events,
+        }));
+    }
+
+    /// Registers filters for the given (code, table) pairs and returns a
+    /// handle receiving every accepted block's matched writes from now on.
+    pub fn subscribe(&'static self, tables: &[(Name, Name)]) -> StateDiffSubscription {
+        let keys: Vec<(u64, u64)> = tables
+            .iter()
+            .map(|(code, table)| (code.as_u64(), table.as_u64()))
+            .collect();
+        {
+            let mut inner = self.lock();
+            for key in &keys {
+                *inner.filters.entry(*key).or_insert(0) += 1;
+            }
+            self.active
+                .store(!inner.filters.is_empty(), Ordering::Relaxed);
+        }
+        StateDiffSubscription {
+            hub: self,
+            keys,
+            receiver: self.sender.subscribe(),
+        }
+    }
+
+    fn unregister(&self, keys: &[(u64, u64)]) {
+        let mut inner = self.lock();
+        for key in keys {
+            if let Some(count) = inner.filters.get_mut(key) {
+                *count -= 1;
+                if *count == 0 {
+                    inner.filters.remove(key);
+                }
+            }
+        }
+        self.active
+            .store(!inner.filters.is_empty(), Ordering::Relaxed);
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, Inner> {
+        // A panic mid-update at worst loses one block's batch; the hub
+        // stays usable.
+        self.inner
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use std::str::FromStr;
+
+    fn leaked_hub() -> &'static StateDiffHub {
+        Box::leak(Box::new(StateDiffHub::new()))
+    }
+
+    fn event(code: &str, table: &str, primary_key: u64) -> StateDiffEvent {
+        StateDiffEvent {
+            code: Name::from_str(code).unwrap(),
+            scope: Name::from_str(code).unwrap(),
+            table: Name::from_str(table).unwrap(),
+            primary_key,
+            op: StateDiffOp::Store,
+            value: Bytes::new(vec![1, 2, 3]),
+        }
+    }
+
+    #[test]
+    fn test_filters_gate_matching_and_retire_on_drop() {
+        let hub = leaked_hub();
+        let code = Name::new(name!("token"));
+        let table = Name::new(name!("accounts"));
+        assert!(!hub.is_active());
+        assert!(!hub.matches(code.as_u64(), table.as_u64()));
+
+        let first = hub.subscribe(&[(code, table)]);
+        let second = hub.subscribe(&[(code, table)]);
+        assert!(hub.matches(code.as_u64(), table.as_u64()));
+        assert!(!hub.matches(code.as_u64(), Name::new(name!("stat")).as_u64()));
+
+        // The pair stays registered until the last watcher is gone.
+        drop(first);
+        assert!(hub.matches(code.as_u64(), table.as_u64()));
+        drop(second);
+        assert!(!hub.is_active());
+    }
+
+    #[test]
+    fn test_publish_delivers_only_accepted_pass() {
+        let hub = leaked_hub();
+        let code = Name::new(name!("token"));
+        let table = Name::new(name!("accounts"));
+        let mut sub = hub.subscribe(&[(code, table)]);
+
+        // A pass whose block is never accepted leaves nothing behind.
+        hub.begin_block();
+        hub.record(event("token", "accounts", 1));
+
+        // Verify pass re-queues, accept publishes it.
+        hub.begin_block();
+        hub.record(event("token", "accounts", 2));
+        hub.record(event("token", "accounts", 3));
+        hub.publish(7, &Id::default());
+
+        let batch = sub.receiver.try_recv().unwrap();
+        assert_eq!(batch.block_num, 7);
+        assert_eq!(batch.events.len(), 2);
+        assert_eq!(batch.events[0].primary_key, 2);
+        assert_eq!(batch.events[1].primary_key, 3);
+        assert!(sub.receiver.try_recv().is_err());
+
+        // An empty block publishes nothing.
+        hub.begin_block();
+        hub.publish(8, &Id::default());
+        assert!(sub.receiver.try_recv().is_err());
+    }
+}
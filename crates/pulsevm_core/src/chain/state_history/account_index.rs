@@ -0,0 +1,223 @@
+use std::{
+    collections::HashMap,
+    fs::OpenOptions,
+    io::{self, BufReader, BufWriter, Read, Seek, SeekFrom, Write},
+    path::{Path, PathBuf},
+    sync::Mutex,
+};
+
+use super::ShLogError;
+
+/// Size of one index record: u64 receiver account (LE) + u64 receive
+/// sequence (LE) + u32 block_num (LE) + u32 offset of the owning packed
+/// transaction trace inside its block's payload (LE) + u32 action
+/// ordinal within that trace (LE).
+const RECORD_SIZE: u64 = 28;
+
+/// Where one indexed action lives: the block, the byte offset of the
+/// transaction trace that contains it inside that block's decompressed
+/// trace payload, and the action's ordinal within the trace. The
+/// receive sequence is the action's position in the receiver's history
+/// — the database's `next_recv_sequence` counter at execution time —
+/// so per-account entries are strictly ascending in append order.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AccountActionEntry {
+    pub recv_sequence: u64,
+    pub block_num: u32,
+    pub offset: u32,
+    pub action_ordinal: u32,
+}
+
+/// Secondary index over the trace log: receiver account → ordered list
+/// of every action delivered to it, keyed by receive sequence.
+///
+/// "Show me account X's recent actions" previously meant replaying the
+/// trace log block range by block range and filtering. With this index
+/// a page is one in-memory slice probe plus one `read_block_with` per
+/// returned action, deserializing the owning trace straight at its
+/// stored offset.
+///
+/// Records are written by the state-history writer thread right after
+/// the trace payload they point into, and fsynced by the same
+/// group-commit. Like the transaction index, it is advisory: a crash
+/// can lose the unsynced tail, trimming only the newest actions from
+/// query results — the traces themselves are still in the log.
+pub struct AccountActionIndex {
+    inner: Mutex<Inner>,
+}
+
+struct Inner {
+    file: BufWriter<std::fs::File>,
+    map: HashMap<u64, Vec<AccountActionEntry>>,
+}
+
+impl AccountActionIndex {
+    pub fn open<P: AsRef<Path>>(dir: P, name: &str) -> Result<Self, ShLogError> {
+        let path: PathBuf = dir.as_ref().join(format!("{name}.acctindex"));
+        let mut file = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .open(&path)?;
+
+        let mut map: HashMap<u64, Vec<AccountActionEntry>> = HashMap::new();
+        let mut valid_bytes = 0u64;
+        {
+            file.seek(SeekFrom::Start(0))?;
+            let mut r = BufReader::new(&file);
+            loop {
+                let mut buf = [0u8; RECORD_SIZE as usize];
+                match r.read_exact(&mut buf) {
+                    Ok(()) => {
+                        let account = u64::from_le_bytes(buf[0..8].try_into().unwrap());
+                        let entry = AccountActionEntry {
+                            recv_sequence: u64::from_le_bytes(buf[8..16].try_into().unwrap()),
+                            block_num: u32::from_le_bytes(buf[16..20].try_into().unwrap()),
+                            offset: u32::from_le_bytes(buf[20..24].try_into().unwrap()),
+                            action_ordinal: u32::from_le_bytes(buf[24..28].try_into().unwrap()),
+                        };
+                        map.entry(account).or_default().push(entry);
+                        valid_bytes += RECORD_SIZE;
+                    }
+                    Err(e) if e.kind() == io::ErrorKind::UnexpectedEof => break,
+                    Err(e) => return Err(ShLogError::Io(e)),
+                }
+            }
+        }
+        // Truncate a torn trailing record so the next append lands on a
+        // record boundary instead of permanently breaking the framing.
+        if file.metadata()?.len() > valid_bytes {
+            file.set_len(valid_bytes)?;
+        }
+        file.seek(SeekFrom::End(0))?;
+
+        Ok(Self {
+            inner: Mutex::new(Inner {
+                file: BufWriter::new(file),
+                map,
+            }),
+        })
+    }
+
+    /// Record a block's worth of delivered actions. Flushed to the OS
+    /// immediately; durability comes from the caller's group-commit
+    /// [`sync`](Self::sync).
+    pub fn append(&self, entries: &[(u64, AccountActionEntry)]) -> Result<(), ShLogError> {
+        let mut inner = self.inner.lock().unwrap();
+        let inner = &mut *inner;
+        for (account, entry) in entries {
+            inner.file.write_all(&account.to_le_bytes())?;
+            inner.file.write_all(&entry.recv_sequence.to_le_bytes())?;
+            inner.file.write_all(&entry.block_num.to_le_bytes())?;
+            inner.file.write_all(&entry.offset.to_le_bytes())?;
+            inner.file.write_all(&entry.action_ordinal.to_le_bytes())?;
+            inner.map.entry(*account).or_default().push(*entry);
+        }
+        inner.file.flush()?;
+        Ok(())
+    }
+
+    /// Force appended records to disk — called alongside the trace log's
+    /// own group-commit sync.
+    pub fn sync(&self) -> Result<(), ShLogError> {
+        let mut inner = self.inner.lock().unwrap();
+        inner.file.flush()?;
+        inner.file.get_ref().sync_data()?;
+        Ok(())
+    }
+
+    /// One page of an account's history: entries with receive sequence
+    /// `>= pos`, in sequence order, at most `limit` of them. Paired with
+    /// the account's total entry count so callers can report progress.
+    pub fn read_page(&self, account: u64, pos: u64, limit: usize) -> (Vec<AccountActionEntry>, u64) {
+        let inner = self.inner.lock().unwrap();
+        let Some(entries) = inner.map.get(&account) else {
+            return (Vec::new(), 0);
+        };
+        let start = entries.partition_point(|e| e.recv_sequence < pos);
+        let end = (start + limit).min(entries.len());
+        (entries[start..end].to_vec(), entries.len() as u64)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::{AtomicU32, Ordering};
+
+    fn entry(recv_sequence: u64, block_num: u32) -> AccountActionEntry {
+        AccountActionEntry {
+            recv_sequence,
+            block_num,
+            offset: 1,
+            action_ordinal: 1,
+        }
+    }
+
+    fn scratch_dir(tag: &str) -> PathBuf {
+        static N: AtomicU32 = AtomicU32::new(0);
+        let dir = std::env::temp_dir().join(format!(
+            "acctindex-test-{tag}-{}-{}",
+            std::process::id(),
+            N.fetch_add(1, Ordering::Relaxed)
+        ));
+        std::fs::create_dir_all(&dir).unwrap();
+        dir
+    }
+
+    #[test]
+    fn paged_reads_and_reopen() {
+        let dir = scratch_dir("roundtrip");
+        {
+            let index = AccountActionIndex::open(&dir, "trace_log").unwrap();
+            index
+                .append(&[(11, entry(1, 7)), (22, entry(1, 7)), (11, entry(2, 7))])
+                .unwrap();
+            index.append(&[(11, entry(3, 8))]).unwrap();
+
+            let (page, total) = index.read_page(11, 2, 10);
+            assert_eq!(total, 3);
+            assert_eq!(page, vec![entry(2, 7), entry(3, 8)]);
+            let (page, total) = index.read_page(11, 0, 1);
+            assert_eq!(total, 3);
+            assert_eq!(page, vec![entry(1, 7)]);
+            assert_eq!(index.read_page(99, 0, 10), (Vec::new(), 0));
+        }
+        // A reopen reloads every record from disk in append order.
+        let index = AccountActionIndex::open(&dir, "trace_log").unwrap();
+        let (page, total) = index.read_page(11, 0, 10);
+        assert_eq!(total, 3);
+        assert_eq!(page.len(), 3);
+        assert_eq!(index.read_page(22, 0, 10).1, 1);
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn torn_record_is_truncated_on_open() {
+        let dir = scratch_dir("torn");
+        {
+            let index = AccountActionIndex::open(&dir, "trace_log").unwrap();
+            index.append(&[(11, entry(1, 3)), (11, entry(2, 3))]).unwrap();
+            index.sync().unwrap();
+        }
+        // Chop into the last record — a torn write.
+        let path = dir.join("trace_log.acctindex");
+        let len = std::fs::metadata(&path).unwrap().len();
+        OpenOptions::new()
+            .write(true)
+            .open(&path)
+            .unwrap()
+            .set_len(len - 5)
+            .unwrap();
+
+        let index = AccountActionIndex::open(&dir, "trace_log").unwrap();
+        let (page, total) = index.read_page(11, 0, 10);
+        assert_eq!(total, 1);
+        assert_eq!(page, vec![entry(1, 3)]);
+        // The file is whole records again and appending continues cleanly.
+        assert_eq!(std::fs::metadata(&path).unwrap().len() % RECORD_SIZE, 0);
+        index.append(&[(11, entry(2, 4))]).unwrap();
+        assert_eq!(index.read_page(11, 0, 10).1, 2);
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+}
@@ -4,14 +4,34 @@ use std::{
     fs::{File, OpenOptions},
     io::{self, BufReader, BufWriter, Read, Seek, SeekFrom, Write},
     path::{Path, PathBuf},
-    sync::Mutex,
+    sync::{Arc, Mutex},
 };
 
+use flate2::{Compression, read::ZlibDecoder, write::ZlibEncoder};
+use memmap2::Mmap;
 use pulsevm_crypto::FixedBytes;
-use spdlog::error;
+use spdlog::{error, warn};
 
 use crate::chain::id::Id;
 
+/// How appends reach the disk. Reads are unaffected either way: they are
+/// served zero-copy out of a memory mapping, which already overlaps with
+/// execution through the page cache and would only gain a copy from
+/// going through a ring.
+///
+/// `Uring` chains each entry's log write, the optional fsync, and the
+/// index record into one io_uring submission — one syscall where the
+/// buffered path makes several, and the kernel orders the chain so the
+/// index record still lands after the log data. It degrades to `Std` at
+/// open time (with a warning) on kernels without io_uring and on
+/// non-Linux builds, so it is safe to enable fleet-wide.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum ShIoBackend {
+    #[default]
+    Std,
+    Uring,
+}
+
 /* -------------------- errors -------------------- */
 
 #[derive(Debug)]
@@ -54,13 +74,17 @@ impl From<io::Error> for ShLogError {
 
 /* -------------------- header + helpers -------------------- */
 
-/// On-disk header layout used by EOS SHiP logs. UNCHANGED from the
-/// previous version — same 48-byte layout, same little-endian fields:
+/// On-disk header layout used by EOS SHiP logs — same 48-byte layout,
+/// same little-endian fields:
 ///   struct state_history_log_header {
 ///      uint64_t magic;          // 8 bytes, LE
 ///      block_id_type block_id;  // 32 bytes, raw
-///      uint64_t payload_size;   // 8 bytes, LE
+///      uint64_t payload_size;   // 8 bytes, LE (on-disk size)
 ///   };
+/// The one format extension over the original: compressed entries set
+/// [`ENTRY_ZLIB_FLAG`] in `magic`. Entries written before compression
+/// landed carry a bare magic and read back unchanged, so old and new
+/// entries coexist in one log.
 #[derive(Clone, Copy, Debug)]
 struct StateHistoryLogHeader {
     magic: u64,
@@ -68,9 +92,19 @@ struct StateHistoryLogHeader {
     payload_size: u64,
 }
 
+/// Per-entry format-version bit OR'd into the header magic when the
+/// payload is zlib-deflated. The top bit can never collide with a real
+/// version magic: EOS' `ship_magic` packs a name constant into the high
+/// bits and no valid name sets bit 63.
+const ENTRY_ZLIB_FLAG: u64 = 1 << 63;
+
 impl StateHistoryLogHeader {
     const SIZE: u64 = 8 + 32 + 8;
 
+    fn is_compressed(&self) -> bool {
+        self.magic & ENTRY_ZLIB_FLAG != 0
+    }
+
     fn write<W: Write>(&self, mut w: W) -> io::Result<()> {
         w.write_all(&self.magic.to_le_bytes())?;
         w.write_all(&self.block_id.0.0)?;
@@ -85,16 +119,20 @@ impl StateHistoryLogHeader {
         r.seek(SeekFrom::Start(pos))?;
         let mut buf = [0u8; Self::SIZE as usize];
         r.read_exact(&mut buf)?;
+        Ok(Self::parse(&buf))
+    }
+
+    fn parse(buf: &[u8; Self::SIZE as usize]) -> Self {
         let magic = u64::from_le_bytes(buf[0..8].try_into().unwrap());
         let mut id_bytes = [0u8; 32];
         id_bytes.copy_from_slice(&buf[8..40]);
         let block_id = Id(FixedBytes(id_bytes));
         let payload_size = u64::from_le_bytes(buf[40..48].try_into().unwrap());
-        Ok(Self {
+        Self {
             magic,
             block_id,
             payload_size,
-        })
+        }
     }
 }
 
@@ -122,7 +160,7 @@ fn read_validated_header<R: Read + Seek>(
         return Err(ShLogError::Corrupt(pos));
     }
     let header = StateHistoryLogHeader::read_at(r, pos)?;
-    if header.magic != expect_magic {
+    if header.magic & !ENTRY_ZLIB_FLAG != expect_magic {
         return Err(ShLogError::BadMagic {
             at: pos,
             found: header.magic,
@@ -139,6 +177,77 @@ fn read_validated_header<R: Read + Seek>(
     Ok(header)
 }
 
+/// Mmap-side twin of `read_validated_header`: validate a header at `pos`
+/// against the mapped length and expected magic, with the same guarantee
+/// that `pos + SIZE + payload_size <= map.len()` so every payload slice
+/// taken afterwards is in bounds.
+fn validated_header_in(
+    map: &[u8],
+    pos: u64,
+    expect_magic: u64,
+) -> Result<StateHistoryLogHeader, ShLogError> {
+    let len_total = map.len() as u64;
+    if pos + StateHistoryLogHeader::SIZE > len_total {
+        return Err(ShLogError::Corrupt(pos));
+    }
+    let start = pos as usize;
+    let header = StateHistoryLogHeader::parse(
+        map[start..start + StateHistoryLogHeader::SIZE as usize]
+            .try_into()
+            .unwrap(),
+    );
+    if header.magic & !ENTRY_ZLIB_FLAG != expect_magic {
+        return Err(ShLogError::BadMagic {
+            at: pos,
+            found: header.magic,
+            expect: expect_magic,
+        });
+    }
+    let end = pos
+        .checked_add(StateHistoryLogHeader::SIZE)
+        .and_then(|v| v.checked_add(header.payload_size))
+        .ok_or(ShLogError::Corrupt(pos))?;
+    if end > len_total {
+        return Err(ShLogError::Corrupt(pos));
+    }
+    Ok(header)
+}
+
+/// Deflate `payload` for storage. Returns `None` when compression does
+/// not actually shrink it (tiny or incompressible payloads), in which
+/// case the entry is stored raw under a bare magic — so compression can
+/// never grow the log.
+fn deflate_if_smaller(payload: &[u8]) -> io::Result<Option<Vec<u8>>> {
+    let mut enc = ZlibEncoder::new(
+        Vec::with_capacity(payload.len() / 2),
+        Compression::default(),
+    );
+    enc.write_all(payload)?;
+    let out = enc.finish()?;
+    Ok((out.len() < payload.len()).then_some(out))
+}
+
+/// Inflate one stored entry payload. A deflate error here means the
+/// bytes at `pos` don't match what the flagged header promised.
+fn inflate(data: &[u8], pos: u64) -> Result<Vec<u8>, ShLogError> {
+    let mut out = Vec::new();
+    ZlibDecoder::new(data)
+        .read_to_end(&mut out)
+        .map_err(|_| ShLogError::Corrupt(pos))?;
+    Ok(out)
+}
+
+/// Map a read-only view of the log file.
+///
+/// Safety: the fd was resolved under the state lock, so it pins the inode
+/// the offsets refer to even if a concurrent prune renames a new file over
+/// `log_path`. Appends past the snapshot length are not visible in the map
+/// and are never dereferenced — `validated_header_in` bounds every access
+/// against `map.len()`.
+fn map_log(file: &File) -> Result<Mmap, ShLogError> {
+    Ok(unsafe { Mmap::map(file)? })
+}
+
 /// fsync the parent directory so a rename survives a crash.
 fn fsync_parent_dir(path: &Path) -> io::Result<()> {
     #[cfg(unix)]
@@ -158,6 +267,235 @@ fn tmp_path(path: &Path) -> PathBuf {
     PathBuf::from(os)
 }
 
+/* -------------------- io_uring append backend -------------------- */
+
+#[cfg(target_os = "linux")]
+mod uring_backend {
+    use std::{fmt, fs::File, io, os::unix::fs::FileExt, os::unix::io::AsRawFd};
+
+    use io_uring::{IoUring, opcode, squeue, types};
+
+    // user_data tags; completions arrive unordered.
+    const LOG_WRITE: u64 = 0;
+    const LOG_FSYNC: u64 = 1;
+    const IDX_WRITE: u64 = 2;
+
+    /// One ring per log, used synchronously by whichever thread holds the
+    /// log's state lock: submit the chain, reap it, return. Buffers only
+    /// need to outlive the call, so nothing is registered up front —
+    /// registered buffers want long-lived fixed-size slots, and entry
+    /// payloads are short-lived and arbitrarily sized.
+    pub(super) struct AppendRing {
+        ring: IoUring,
+    }
+
+    // `IoUring` has no `Debug` impl; `Inner` derives one.
+    impl fmt::Debug for AppendRing {
+        fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+            f.write_str("AppendRing")
+        }
+    }
+
+    impl AppendRing {
+        pub(super) fn new() -> io::Result<Self> {
+            // At most three entries in flight per append.
+            Ok(Self {
+                ring: IoUring::new(8)?,
+            })
+        }
+
+        /// Writes one log entry and its index record, fsyncing the log in
+        /// between when `sync` is set. The three submissions are linked,
+        /// so the kernel preserves the "log data before index record"
+        /// ordering the recovery logic relies on.
+        pub(super) fn append(
+            &mut self,
+            log: &File,
+            idx: &File,
+            log_off: u64,
+            idx_off: u64,
+            entry: &[u8],
+            idx_rec: &[u8],
+            sync: bool,
+        ) -> io::Result<()> {
+            let log_sqe =
+                opcode::Write::new(types::Fd(log.as_raw_fd()), entry.as_ptr(), entry.len() as u32)
+                    .offset(log_off)
+                    .build()
+                    .flags(squeue::Flags::IO_LINK)
+                    .user_data(LOG_WRITE);
+            let idx_sqe = opcode::Write::new(
+                types::Fd(idx.as_raw_fd()),
+                idx_rec.as_ptr(),
+                idx_rec.len() as u32,
+            )
+            .offset(idx_off)
+            .build()
+            .user_data(IDX_WRITE);
+
+            let mut count = 2;
+            {
+                let mut sq = self.ring.submission();
+                let full = |_| io::Error::other("io_uring submission queue full");
+                unsafe {
+                    sq.push(&log_sqe).map_err(full)?;
+                    if sync {
+                        let fsync_sqe = opcode::Fsync::new(types::Fd(log.as_raw_fd()))
+                            .flags(types::FsyncFlags::DATASYNC)
+                            .build()
+                            .flags(squeue::Flags::IO_LINK)
+                            .user_data(LOG_FSYNC);
+                        sq.push(&fsync_sqe).map_err(full)?;
+                        count = 3;
+                    }
+                    sq.push(&idx_sqe).map_err(full)?;
+                }
+            }
+            self.ring.submit_and_wait(count)?;
+
+            let mut results = [None::<i32>; 3];
+            for cqe in self.ring.completion() {
+                let tag = cqe.user_data() as usize;
+                if tag < results.len() {
+                    results[tag] = Some(cqe.result());
+                }
+            }
+
+            // A failed link cancels everything after it; finish whatever
+            // the kernel left undone with plain pwrites so a transient
+            // shortfall never tears the on-disk framing.
+            let log_res = results[LOG_WRITE as usize].unwrap_or(-libc::ECANCELED);
+            let log_repaired = log_res != entry.len() as i32;
+            Self::ensure_written(log, entry, log_off, log_res)?;
+            Self::ensure_written(
+                idx,
+                idx_rec,
+                idx_off,
+                results[IDX_WRITE as usize].unwrap_or(-libc::ECANCELED),
+            )?;
+            if sync {
+                // Redo the fsync if the chained one failed or ran before a
+                // repair write — `Ok(())` must still imply durable data.
+                let fsync_res = results[LOG_FSYNC as usize].unwrap_or(-libc::ECANCELED);
+                if log_repaired || fsync_res < 0 {
+                    log.sync_data()?;
+                }
+            }
+            Ok(())
+        }
+
+        fn ensure_written(file: &File, buf: &[u8], off: u64, res: i32) -> io::Result<()> {
+            let done = if res == -libc::ECANCELED {
+                0
+            } else if res < 0 {
+                return Err(io::Error::from_raw_os_error(-res));
+            } else {
+                res as usize
+            };
+            if done < buf.len() {
+                file.write_all_at(&buf[done..], off + done as u64)?;
+            }
+            Ok(())
+        }
+    }
+}
+
+/// Stub keeping the call sites free of per-platform conditions: `new`
+/// always fails, so `append` is unreachable and the open path falls back
+/// to the buffered backend.
+#[cfg(not(target_os = "linux"))]
+mod uring_backend {
+    use std::{fs::File, io};
+
+    #[derive(Debug)]
+    pub(super) struct AppendRing;
+
+    impl AppendRing {
+        pub(super) fn new() -> io::Result<Self> {
+            Err(io::Error::other("io_uring requires Linux"))
+        }
+
+        pub(super) fn append(
+            &mut self,
+            _log: &File,
+            _idx: &File,
+            _log_off: u64,
+            _idx_off: u64,
+            _entry: &[u8],
+            _idx_rec: &[u8],
+            _sync: bool,
+        ) -> io::Result<()> {
+            unreachable!("AppendRing cannot be constructed on this platform")
+        }
+    }
+}
+
+/* -------------------- position index -------------------- */
+
+/// Hot-tier position index: one `u64` header offset per block, indexed
+/// by `block_num - first`. Appends enforce contiguous block numbers, so
+/// the tree this replaced never held anything but a dense run — the
+/// flat array serves a lookup with array arithmetic and costs exactly
+/// 8 bytes per block, where a `BTreeMap<u32, u64>` node-hops through
+/// several times that for a multi-ten-million-block log.
+#[derive(Debug, Default)]
+struct PositionIndex {
+    first: u32,
+    positions: Vec<u64>,
+}
+
+impl PositionIndex {
+    fn is_empty(&self) -> bool {
+        self.positions.is_empty()
+    }
+
+    fn len(&self) -> usize {
+        self.positions.len()
+    }
+
+    fn first_block(&self) -> Option<u32> {
+        (!self.is_empty()).then_some(self.first)
+    }
+
+    fn last_block(&self) -> Option<u32> {
+        (!self.is_empty()).then(|| self.first + (self.positions.len() - 1) as u32)
+    }
+
+    fn get(&self, block: u32) -> Option<u64> {
+        let i = block.checked_sub(self.first)? as usize;
+        self.positions.get(i).copied()
+    }
+
+    /// Appends the next position. `block` must start the run or extend
+    /// it by one; a gap returns `false` so callers can treat the source
+    /// they are loading from as corrupt.
+    #[must_use]
+    fn push(&mut self, block: u32, pos: u64) -> bool {
+        if self.positions.is_empty() {
+            self.first = block;
+        } else if Some(block) != self.last_block().map(|l| l.wrapping_add(1)) {
+            return false;
+        }
+        self.positions.push(pos);
+        true
+    }
+
+    /// Drops the newest entry (torn-tail recovery).
+    fn pop_last(&mut self) {
+        self.positions.pop();
+    }
+
+    /// `(block_num, position)` pairs for the blocks in `[start, end]`,
+    /// clamped to the run.
+    fn iter_range(&self, start: u32, end: u32) -> impl Iterator<Item = (u32, u64)> + '_ {
+        let (lo, hi) = match (self.first_block(), self.last_block()) {
+            (Some(f), Some(l)) => (start.max(f), end.min(l)),
+            _ => (1, 0), // empty range
+        };
+        (lo..=hi).map(move |b| (b, self.positions[(b - self.first) as usize]))
+    }
+}
+
 /* -------------------- log struct -------------------- */
 
 /// All mutable state lives behind a single mutex. This removes the
@@ -167,9 +505,19 @@ fn tmp_path(path: &Path) -> PathBuf {
 struct Inner {
     log: BufWriter<File>,
     idx: BufWriter<File>,
-    map: BTreeMap<u32, u64>,   // block_num -> file offset (header start)
+    map: PositionIndex,
     range: Option<(u32, u32)>, // (first, last); None == empty log
     log_len: u64,              // logical end-of-log; running counter, no metadata() syscalls
+    idx_len: u64,              // logical end-of-index, same discipline as log_len
+    uring: Option<uring_backend::AppendRing>, // None == buffered std appends
+    // Cold tier: block_num -> (archive segment, offset of the header in
+    // it). Segments are immutable once renamed into place and share one
+    // Arc'd path per segment, so this map costs pointer + offset per
+    // archived block while the payload bytes live wherever `cold_dir`
+    // is mounted. `range` above stays hot-only — it drives the append
+    // contiguity check — and `StateHistoryLog::range()` merges the two.
+    cold_dir: Option<PathBuf>,
+    cold_map: BTreeMap<u32, (Arc<PathBuf>, u64)>,
 }
 
 #[derive(Debug)]
@@ -190,6 +538,18 @@ impl StateHistoryLog {
         dir: P,
         name: &str,
         magic: u64,
+    ) -> Result<Self, ShLogError> {
+        Self::open_with_backend(dir, name, magic, ShIoBackend::Std)
+    }
+
+    /// Like [`open_with_magic`](Self::open_with_magic), with an explicit
+    /// append backend. `Uring` falls back to `Std` with a warning when
+    /// the ring cannot be set up, so callers never need a platform check.
+    pub fn open_with_backend<P: AsRef<Path>>(
+        dir: P,
+        name: &str,
+        magic: u64,
+        backend: ShIoBackend,
     ) -> Result<Self, ShLogError> {
         let log_path = dir.as_ref().join(format!("{name}.log"));
         let idx_path = dir.as_ref().join(format!("{name}.index"));
@@ -206,7 +566,7 @@ impl StateHistoryLog {
             .open(&idx_path)?;
 
         // ---- load index, tracking how many bytes were valid ----
-        let mut map = BTreeMap::new();
+        let mut map = PositionIndex::default();
         let mut valid_idx_bytes = 0u64;
         {
             idx_file.seek(SeekFrom::Start(0))?;
@@ -217,7 +577,17 @@ impl StateHistoryLog {
                     Ok(()) => {
                         let block = u32::from_le_bytes(buf[0..4].try_into().unwrap());
                         let pos = u64::from_le_bytes(buf[4..12].try_into().unwrap());
-                        map.insert(block, pos);
+                        if !map.push(block, pos) {
+                            // A gap in the index can only be corruption —
+                            // appends are contiguous. Discard it and let
+                            // the rebuild-from-log path below take over.
+                            warn!(
+                                "[ship][{name}] index record for block {block} breaks the run; rebuilding index from the log"
+                            );
+                            map = PositionIndex::default();
+                            valid_idx_bytes = 0;
+                            break;
+                        }
                         valid_idx_bytes += IDX_RECORD_SIZE;
                     }
                     Err(e) if e.kind() == io::ErrorKind::UnexpectedEof => break,
@@ -241,13 +611,17 @@ impl StateHistoryLog {
             for (block, pos) in &entries {
                 w.write_all(&block.to_le_bytes())?;
                 w.write_all(&pos.to_le_bytes())?;
-                map.insert(*block, *pos);
+                if !map.push(*block, *pos) {
+                    return Err(ShLogError::MissedBlock(format!(
+                        "{name}.log: scan found block {block} out of sequence"
+                    )));
+                }
             }
             w.flush()?;
         } else {
             // Validate the tail entry the index points at.
-            let last = *map.keys().last().unwrap();
-            let tail_off = map[&last];
+            let last = map.last_block().unwrap();
+            let tail_off = map.get(last).unwrap();
             let len_total = log_file.metadata()?.len();
             match read_validated_header(&mut log_file, tail_off, len_total, magic) {
                 Ok(h) => {
@@ -264,7 +638,11 @@ impl StateHistoryLog {
                         for (block, pos) in &recovered {
                             w.write_all(&block.to_le_bytes())?;
                             w.write_all(&pos.to_le_bytes())?;
-                            map.insert(*block, *pos);
+                            if !map.push(*block, *pos) {
+                                return Err(ShLogError::MissedBlock(format!(
+                                    "{name}.log: recovered block {block} out of sequence"
+                                )));
+                            }
                         }
                         w.flush()?;
                     }
@@ -272,21 +650,35 @@ impl StateHistoryLog {
                 Err(_) => {
                     // Torn tail: drop it from log, index, and map.
                     log_file.set_len(tail_off)?;
-                    map.remove(&last);
+                    map.pop_last();
                     idx_file.set_len(valid_idx_bytes.saturating_sub(IDX_RECORD_SIZE))?;
                 }
             }
         }
 
         let log_len = log_file.metadata()?.len();
-        let range = match (map.keys().next(), map.keys().last()) {
-            (Some(&f), Some(&l)) => Some((f, l)),
-            _ => None,
-        };
+        let range = map.first_block().zip(map.last_block());
 
         log_file.seek(SeekFrom::End(0))?;
         idx_file.seek(SeekFrom::End(0))?;
 
+        // After recovery the index holds exactly one whole record per
+        // mapped entry, so its logical length follows from the map.
+        let idx_len = map.len() as u64 * IDX_RECORD_SIZE;
+
+        let uring = match backend {
+            ShIoBackend::Std => None,
+            ShIoBackend::Uring => match uring_backend::AppendRing::new() {
+                Ok(ring) => Some(ring),
+                Err(e) => {
+                    warn!(
+                        "[ship][{name}] io_uring unavailable ({e}); falling back to buffered appends"
+                    );
+                    None
+                }
+            },
+        };
+
         Ok(Self {
             name: name.to_string(),
             log_path,
@@ -298,19 +690,51 @@ impl StateHistoryLog {
                 map,
                 range,
                 log_len,
+                idx_len,
+                uring,
+                cold_dir: None,
+                cold_map: BTreeMap::new(),
             }),
         })
     }
 
-    /// Append one entry with EOS SHiP header.
+    /// Append one entry with EOS SHiP header. Payloads are zlib-deflated
+    /// on disk (trace payloads are highly repetitive) whenever that makes
+    /// them smaller; the header's [`ENTRY_ZLIB_FLAG`] records which form
+    /// each entry took and reads decompress transparently.
     ///
     /// Durability note: the log is `sync_data()`'d before the index
     /// record referencing it is written, so on-disk the index never
     /// points past valid log data. If per-append fsync is too costly
-    /// for your workload, it can be relaxed — open-time recovery
-    /// handles a log/index mismatch either way — but then `Ok(())`
-    /// no longer implies the block survives a power loss.
+    /// for your workload, use `append_relaxed` + a batched `sync` —
+    /// open-time recovery handles a log/index mismatch either way —
+    /// but then `Ok(())` no longer implies the block survives a power
+    /// loss.
     pub fn append(&self, block_id: Id, payload: &[u8]) -> Result<(), ShLogError> {
+        self.append_inner(block_id, payload, true)
+    }
+
+    /// Like `append`, but without the per-entry `sync_data`. Entries are
+    /// flushed to the OS (immediately visible to readers) but not forced
+    /// to disk; call [`sync`](Self::sync) to group-commit a batch. A
+    /// crash before the sync loses only the unsynced tail, which
+    /// open-time recovery truncates.
+    pub fn append_relaxed(&self, block_id: Id, payload: &[u8]) -> Result<(), ShLogError> {
+        self.append_inner(block_id, payload, false)
+    }
+
+    /// Force everything appended so far to disk — one fsync per file,
+    /// however many relaxed appends preceded it.
+    pub fn sync(&self) -> Result<(), ShLogError> {
+        let mut inner = self.inner.lock().unwrap();
+        inner.log.flush()?;
+        inner.log.get_ref().sync_data()?;
+        inner.idx.flush()?;
+        inner.idx.get_ref().sync_data()?;
+        Ok(())
+    }
+
+    fn append_inner(&self, block_id: Id, payload: &[u8], sync: bool) -> Result<(), ShLogError> {
         let block_num = num_from_block_id(&block_id);
         let mut inner = self.inner.lock().unwrap();
 
@@ -327,29 +751,80 @@ impl StateHistoryLog {
 
         let pos = inner.log_len;
 
-        // Re-position explicitly. This is a no-op in the happy path,
-        // but if a previous append failed mid-write it guarantees we
-        // overwrite the partial entry instead of appending after it.
-        // (BufWriter's Seek impl flushes its buffer first.)
-        inner.log.seek(SeekFrom::Start(pos))?;
+        let deflated = deflate_if_smaller(payload)?;
+        let stored: &[u8] = deflated.as_deref().unwrap_or(payload);
+        let magic = if deflated.is_some() {
+            self.magic | ENTRY_ZLIB_FLAG
+        } else {
+            self.magic
+        };
 
         let header = StateHistoryLogHeader {
-            magic: self.magic,
+            magic,
             block_id,
-            payload_size: payload.len() as u64,
+            payload_size: stored.len() as u64,
         };
-        header.write(&mut inner.log)?;
-        inner.log.write_all(payload)?;
-        inner.log.flush()?;
-        inner.log.get_ref().sync_data()?;
 
-        // Index record only after the log entry is durable.
-        inner.idx.write_all(&block_num.to_le_bytes())?;
-        inner.idx.write_all(&pos.to_le_bytes())?;
-        inner.idx.flush()?;
+        if inner.uring.is_some() {
+            let Inner {
+                log,
+                idx,
+                uring,
+                idx_len,
+                ..
+            } = &mut *inner;
+            // Offset-addressed submissions bypass the BufWriters; drain
+            // anything open-time recovery left buffered in them first
+            // (a no-op on every append after the first).
+            log.flush()?;
+            idx.flush()?;
+
+            let mut entry =
+                Vec::with_capacity(StateHistoryLogHeader::SIZE as usize + stored.len());
+            header.write(&mut entry)?;
+            entry.extend_from_slice(stored);
+            let mut idx_rec = [0u8; IDX_RECORD_SIZE as usize];
+            idx_rec[0..4].copy_from_slice(&block_num.to_le_bytes());
+            idx_rec[4..12].copy_from_slice(&pos.to_le_bytes());
+
+            // Writes land at `pos`/`idx_len`, which a failed previous
+            // append did not advance — partial entries get overwritten,
+            // same as the seek in the buffered path.
+            uring.as_mut().unwrap().append(
+                log.get_ref(),
+                idx.get_ref(),
+                pos,
+                *idx_len,
+                &entry,
+                &idx_rec,
+                sync,
+            )?;
+        } else {
+            // Re-position explicitly. This is a no-op in the happy path,
+            // but if a previous append failed mid-write it guarantees we
+            // overwrite the partial entry instead of appending after it.
+            // (BufWriter's Seek impl flushes its buffer first.)
+            inner.log.seek(SeekFrom::Start(pos))?;
+
+            header.write(&mut inner.log)?;
+            inner.log.write_all(stored)?;
+            inner.log.flush()?;
+            if sync {
+                inner.log.get_ref().sync_data()?;
+            }
 
-        inner.log_len = pos + StateHistoryLogHeader::SIZE + payload.len() as u64;
-        inner.map.insert(block_num, pos);
+            // Index record only after the log entry is durable (or, in
+            // relaxed mode, at least flushed ahead of it).
+            inner.idx.write_all(&block_num.to_le_bytes())?;
+            inner.idx.write_all(&pos.to_le_bytes())?;
+            inner.idx.flush()?;
+        }
+
+        inner.log_len = pos + StateHistoryLogHeader::SIZE + stored.len() as u64;
+        inner.idx_len += IDX_RECORD_SIZE;
+        // Contiguity was checked against `range` above, so this extends
+        // the run.
+        let _ = inner.map.push(block_num, pos);
         inner.range = Some(match inner.range {
             None => (block_num, block_num),
             Some((first, _)) => (first, block_num),
@@ -358,24 +833,42 @@ impl StateHistoryLog {
         Ok(())
     }
 
-    /// Read payload for a given block number.
+    /// Read payload for a given block number into an owned buffer.
     pub fn read_block(&self, block_num: u32) -> Result<Vec<u8>, ShLogError> {
-        // Open the reader handle while holding the lock so a concurrent
-        // prune (which renames a new file over log_path) can't swap the
-        // file out from under the offset we just looked up. Once we
-        // hold an fd, the old inode stays valid for the read.
-        let (pos, mut f) = {
+        self.read_block_with(block_num, |payload| payload.to_vec())
+    }
+
+    /// Serve one payload as a borrowed slice straight out of the
+    /// memory-mapped log — no intermediate copy for raw entries, one
+    /// inflate for compressed ones. The callback's result is returned;
+    /// copy inside the callback (or use `read_block`) when the payload
+    /// must outlive the call.
+    pub fn read_block_with<R>(
+        &self,
+        block_num: u32,
+        f: impl FnOnce(&[u8]) -> R,
+    ) -> Result<R, ShLogError> {
+        // Open the fd while holding the lock so a concurrent prune (which
+        // renames a new file over log_path) can't swap the file out from
+        // under the offset we just looked up. Once we hold an fd, the old
+        // inode stays valid for the mapping. A hot-map miss falls through
+        // to the cold tier: archive segments use the exact same entry
+        // format, so only the file we map differs.
+        let (pos, file) = {
             let inner = self.inner.lock().unwrap();
-            let pos = *inner
-                .map
-                .get(&block_num)
-                .ok_or(ShLogError::NotFound(block_num))?;
-            let f = OpenOptions::new().read(true).open(&self.log_path)?;
-            (pos, f)
+            if let Some(pos) = inner.map.get(block_num) {
+                let f = OpenOptions::new().read(true).open(&self.log_path)?;
+                (pos, f)
+            } else if let Some((seg, pos)) = inner.cold_map.get(&block_num) {
+                let f = OpenOptions::new().read(true).open(seg.as_ref())?;
+                (*pos, f)
+            } else {
+                return Err(ShLogError::NotFound(block_num));
+            }
         };
 
-        let len_total = f.metadata()?.len();
-        let header = match read_validated_header(&mut f, pos, len_total, self.magic) {
+        let map = map_log(&file)?;
+        let header = match validated_header_in(&map, pos, self.magic) {
             Ok(h) => h,
             Err(e) => {
                 error!(
@@ -393,42 +886,86 @@ impl StateHistoryLog {
             );
             return Err(ShLogError::Corrupt(pos));
         }
-        // Allocation is safe: read_validated_header proved
-        // pos + SIZE + payload_size <= len_total.
-        let mut buf = vec![0u8; header.payload_size as usize];
-        f.read_exact(&mut buf)?;
-        Ok(buf)
+        // Slice is in bounds: validated_header_in proved
+        // pos + SIZE + payload_size <= map.len().
+        let start = (pos + StateHistoryLogHeader::SIZE) as usize;
+        let stored = &map[start..start + header.payload_size as usize];
+        if header.is_compressed() {
+            Ok(f(&inflate(stored, pos)?))
+        } else {
+            Ok(f(stored))
+        }
     }
 
     /// Stream a [start, end] range (inclusive), callback gets (block_num, payload).
     ///
+    /// Payloads are borrowed slices into one memory-mapped view of the log,
+    /// advised for sequential access — replaying millions of blocks to a
+    /// downstream indexer walks the page cache instead of copying every
+    /// entry into a fresh buffer.
+    ///
     /// The lock is NOT held while the callback runs, so the callback
     /// may call back into this log without deadlocking.
     pub fn read_range<F>(&self, start: u32, end: u32, mut cb: F) -> Result<(), ShLogError>
     where
         F: FnMut(u32, &[u8]) -> Result<(), ShLogError>,
     {
-        let (pairs, f) = {
+        // Where each block in the range lives. Cold entries are collected
+        // first and hot entries inserted over them, so a block present in
+        // both tiers (crash between segment rename and hot prune) is
+        // served from the hot log.
+        enum Loc {
+            Hot(u64),
+            Cold(Arc<PathBuf>, u64),
+        }
+        let (locs, hot_file) = {
             let inner = self.inner.lock().unwrap();
-            let pairs: Vec<(u32, u64)> = inner
-                .map
+            let mut locs: BTreeMap<u32, Loc> = inner
+                .cold_map
                 .range(start..=end)
-                .map(|(k, v)| (*k, *v))
+                .map(|(k, (seg, pos))| (*k, Loc::Cold(seg.clone(), *pos)))
                 .collect();
+            for (k, v) in inner.map.iter_range(start, end) {
+                locs.insert(k, Loc::Hot(v));
+            }
             let f = OpenOptions::new().read(true).open(&self.log_path)?;
-            (pairs, f)
+            (locs, f)
         };
+        if locs.is_empty() {
+            return Ok(());
+        }
 
-        let len_total = f.metadata()?.len();
-        let mut r = BufReader::new(f);
-        for (block, pos) in pairs {
-            let header = read_validated_header(&mut r, pos, len_total, self.magic)?;
+        let hot_map = map_log(&hot_file)?;
+        #[cfg(unix)]
+        let _ = hot_map.advise(memmap2::Advice::Sequential);
+        // Archived blocks are contiguous runs within one segment, so a
+        // single mapping at a time covers the cold part of the walk.
+        let mut cold: Option<(Arc<PathBuf>, Mmap)> = None;
+        for (block, loc) in locs {
+            let (map, pos): (&[u8], u64) = match &loc {
+                Loc::Hot(pos) => (&hot_map, *pos),
+                Loc::Cold(seg, pos) => {
+                    if cold.as_ref().is_none_or(|(p, _)| !Arc::ptr_eq(p, seg)) {
+                        let f = OpenOptions::new().read(true).open(seg.as_ref())?;
+                        let m = map_log(&f)?;
+                        #[cfg(unix)]
+                        let _ = m.advise(memmap2::Advice::Sequential);
+                        cold = Some((seg.clone(), m));
+                    }
+                    (&cold.as_ref().unwrap().1, *pos)
+                }
+            };
+            let header = validated_header_in(map, pos, self.magic)?;
             if num_from_block_id(&header.block_id) != block {
                 return Err(ShLogError::Corrupt(pos));
             }
-            let mut buf = vec![0u8; header.payload_size as usize];
-            r.read_exact(&mut buf)?;
-            cb(block, &buf)?;
+            let data_start = (pos + StateHistoryLogHeader::SIZE) as usize;
+            let stored = &map[data_start..data_start + header.payload_size as usize];
+            if header.is_compressed() {
+                cb(block, &inflate(stored, pos)?)?;
+            } else {
+                cb(block, stored)?;
+            }
         }
         Ok(())
     }
@@ -465,11 +1002,7 @@ impl StateHistoryLog {
             _ => {}
         }
 
-        let keep: Vec<(u32, u64)> = inner
-            .map
-            .range(start_block..=u32::MAX)
-            .map(|(k, v)| (*k, *v))
-            .collect();
+        let keep: Vec<(u32, u64)> = inner.map.iter_range(start_block, u32::MAX).collect();
         if keep.is_empty() {
             return Ok(());
         }
@@ -499,7 +1032,7 @@ impl StateHistoryLog {
         // Running counter — never derived from metadata().len(), which
         // lags behind a BufWriter's logical position.
         let mut new_pos = 0u64;
-        let mut new_map = BTreeMap::new();
+        let mut new_map = PositionIndex::default();
 
         for (block, old_pos) in &keep {
             let header = read_validated_header(&mut in_log, *old_pos, in_len, self.magic)?;
@@ -515,7 +1048,9 @@ impl StateHistoryLog {
             out_idx.write_all(&block.to_le_bytes())?;
             out_idx.write_all(&new_pos.to_le_bytes())?;
 
-            new_map.insert(*block, new_pos);
+            // `keep` is a contiguous tail of the run, so each push extends
+            // the new index by one.
+            let _ = new_map.push(*block, new_pos);
             new_pos += StateHistoryLogHeader::SIZE + header.payload_size;
         }
 
@@ -551,39 +1086,307 @@ impl StateHistoryLog {
 
         inner.log = log_w;
         inner.idx = idx_w;
+        inner.idx_len = new_map.len() as u64 * IDX_RECORD_SIZE;
         inner.map = new_map;
         inner.range = Some((first_kept, last_kept));
         inner.log_len = new_pos;
+        // `inner.uring` survives untouched: the ring holds no file state,
+        // and the next append passes it the fresh descriptors.
+
+        Ok(())
+    }
+
+    /* -------------------- hot/cold tiering -------------------- */
 
+    /// Attach a cold-tier directory and index any archive segments
+    /// already in it. Until this is called the log is single-tier and
+    /// [`archive_before`](Self::archive_before) fails.
+    ///
+    /// Segments keep the exact entry format of the hot log (including
+    /// per-entry zlib), so only this local index — pointer plus offset
+    /// per archived block — stays resident; the bytes live wherever the
+    /// directory is mounted, which is how the cold tier lands on cheap
+    /// storage (a second disk, NFS, an object-store mount).
+    pub fn set_cold_dir<P: AsRef<Path>>(&self, dir: P) -> Result<(), ShLogError> {
+        std::fs::create_dir_all(&dir)?;
+        let prefix = format!("{}-", self.name);
+        let mut cold_map = BTreeMap::new();
+        for entry in std::fs::read_dir(&dir)? {
+            let path = entry?.path();
+            let Some(fname) = path.file_name().and_then(|s| s.to_str()) else {
+                continue;
+            };
+            // `{name}-{first}-{last}.cold`; anything else (tmp files from
+            // an interrupted archive, other logs' segments) is ignored.
+            if !fname.starts_with(&prefix) || !fname.ends_with(".cold") {
+                continue;
+            }
+            let mut f = OpenOptions::new().read(true).write(true).open(&path)?;
+            let entries = scan_entries(&mut f, 0, self.magic)?;
+            let seg = Arc::new(path);
+            for (block, pos) in entries {
+                cold_map.insert(block, (seg.clone(), pos));
+            }
+        }
+        let mut inner = self.inner.lock().unwrap();
+        inner.cold_dir = Some(dir.as_ref().to_path_buf());
+        inner.cold_map = cold_map;
         Ok(())
     }
 
+    /// Migrate every block below `start_block` out of the hot log into
+    /// one archive segment in the cold directory, then drop the migrated
+    /// range from the hot files. The newest block always stays hot, so
+    /// the append contiguity check keeps its anchor. Reads are
+    /// unaffected — `read_block`/`read_range` fetch archived blocks from
+    /// the segment transparently.
+    ///
+    /// Crash ordering mirrors prune: the segment is synced and renamed
+    /// into place before the hot rewrite, so a crash in between leaves a
+    /// block in both tiers (reads prefer hot) rather than in neither;
+    /// the next archive run prunes the duplicate without re-copying it.
+    pub fn archive_before(&self, start_block: u32) -> Result<(), ShLogError> {
+        let mut inner = self.inner.lock().unwrap();
+        let Some(cold_dir) = inner.cold_dir.clone() else {
+            return Err(ShLogError::Io(io::Error::other(
+                "no cold directory configured; call set_cold_dir first",
+            )));
+        };
+        let Some((first, last)) = inner.range else {
+            return Ok(());
+        };
+        let end = start_block.saturating_sub(1).min(last.saturating_sub(1));
+        if end < first {
+            return Ok(());
+        }
+
+        let to_copy: Vec<(u32, u64)> = inner
+            .map
+            .iter_range(first, end)
+            .filter(|(b, _)| !inner.cold_map.contains_key(b))
+            .collect();
+
+        if !to_copy.is_empty() {
+            let seg_path = cold_dir.join(format!(
+                "{}-{:010}-{:010}.cold",
+                self.name,
+                to_copy.first().unwrap().0,
+                to_copy.last().unwrap().0
+            ));
+            let tmp = tmp_path(&seg_path);
+            let out_file = OpenOptions::new()
+                .write(true)
+                .create(true)
+                .truncate(true)
+                .open(&tmp)?;
+            let mut out = BufWriter::new(&out_file);
+
+            let in_file = OpenOptions::new().read(true).open(&self.log_path)?;
+            let in_len = in_file.metadata()?.len();
+            let mut in_log = BufReader::new(in_file);
+
+            // Entries are copied in their stored form — already
+            // per-entry deflated where that shrank them — so archiving
+            // is a straight byte copy, no recompression pass.
+            let mut seg_pos = 0u64;
+            let mut offsets = Vec::with_capacity(to_copy.len());
+            for (block, old_pos) in &to_copy {
+                let header = read_validated_header(&mut in_log, *old_pos, in_len, self.magic)?;
+                if num_from_block_id(&header.block_id) != *block {
+                    return Err(ShLogError::Corrupt(*old_pos));
+                }
+                let mut buf = vec![0u8; header.payload_size as usize];
+                in_log.read_exact(&mut buf)?;
+                header.write(&mut out)?;
+                out.write_all(&buf)?;
+                offsets.push((*block, seg_pos));
+                seg_pos += StateHistoryLogHeader::SIZE + header.payload_size;
+            }
+
+            out.flush()?;
+            out_file.sync_all()?;
+            drop(out);
+            std::fs::rename(&tmp, &seg_path)?;
+            fsync_parent_dir(&seg_path)?;
+
+            let seg = Arc::new(seg_path);
+            for (block, pos) in offsets {
+                inner.cold_map.insert(block, (seg.clone(), pos));
+            }
+        }
+
+        // Drop the archived range from the hot tier — same rewrite
+        // machinery as prune_from, now that the segment is durable.
+        self.prune_locked(&mut inner, end + 1)
+    }
+
+    /// Migrate blocks below `start_block` into the cold tier like
+    /// [`archive_before`](Self::archive_before), but pass each payload
+    /// through `reduce` on the way — this is how the trace log keeps full
+    /// traces for recent blocks and only a summary (receipts and RAM
+    /// deltas) for older ones. The reduced entries are ordinary segment
+    /// entries, so reads serve them transparently.
+    ///
+    /// Unlike `archive_before` this is built to run continuously: at most
+    /// `max_blocks` blocks are migrated per call, and the hot-file
+    /// rewrite — the part whose cost scales with the whole hot log — is
+    /// deferred until at least `prune_slack` migrated blocks are still
+    /// sitting in the hot tier. Until that deferred prune runs a block
+    /// exists in both tiers and reads prefer the full hot copy, the same
+    /// benign state a crash mid-archive leaves behind.
+    ///
+    /// Returns how many blocks this call migrated; `Ok(0)` means the
+    /// retention target is already met.
+    pub fn reduce_before(
+        &self,
+        start_block: u32,
+        max_blocks: u32,
+        prune_slack: u32,
+        reduce: &mut dyn FnMut(u32, &[u8]) -> Result<Vec<u8>, ShLogError>,
+    ) -> Result<u32, ShLogError> {
+        let mut inner = self.inner.lock().unwrap();
+        let Some(cold_dir) = inner.cold_dir.clone() else {
+            return Err(ShLogError::Io(io::Error::other(
+                "no cold directory configured; call set_cold_dir first",
+            )));
+        };
+        let Some((first, last)) = inner.range else {
+            return Ok(0);
+        };
+        let end = start_block.saturating_sub(1).min(last.saturating_sub(1));
+
+        let to_reduce: Vec<(u32, u64)> = if end >= first {
+            inner
+                .map
+                .iter_range(first, end)
+                .filter(|(b, _)| !inner.cold_map.contains_key(b))
+                .take(max_blocks as usize)
+                .collect()
+        } else {
+            Vec::new()
+        };
+
+        if !to_reduce.is_empty() {
+            let seg_path = cold_dir.join(format!(
+                "{}-{:010}-{:010}.cold",
+                self.name,
+                to_reduce.first().unwrap().0,
+                to_reduce.last().unwrap().0
+            ));
+            let tmp = tmp_path(&seg_path);
+            let out_file = OpenOptions::new()
+                .write(true)
+                .create(true)
+                .truncate(true)
+                .open(&tmp)?;
+            let mut out = BufWriter::new(&out_file);
+
+            let in_file = OpenOptions::new().read(true).open(&self.log_path)?;
+            let in_len = in_file.metadata()?.len();
+            let mut in_log = BufReader::new(in_file);
+
+            let mut seg_pos = 0u64;
+            let mut offsets = Vec::with_capacity(to_reduce.len());
+            for (block, old_pos) in &to_reduce {
+                let header = read_validated_header(&mut in_log, *old_pos, in_len, self.magic)?;
+                if num_from_block_id(&header.block_id) != *block {
+                    return Err(ShLogError::Corrupt(*old_pos));
+                }
+                let mut buf = vec![0u8; header.payload_size as usize];
+                in_log.read_exact(&mut buf)?;
+                // The reducer sees the logical payload, so stored
+                // compression is undone here and re-applied to the
+                // (smaller) result under the usual shrink-only rule.
+                let full = if header.is_compressed() {
+                    inflate(&buf, *old_pos)?
+                } else {
+                    buf
+                };
+                let reduced = reduce(*block, &full)?;
+                let deflated = deflate_if_smaller(&reduced)?;
+                let stored: &[u8] = deflated.as_deref().unwrap_or(&reduced);
+                let magic = if deflated.is_some() {
+                    self.magic | ENTRY_ZLIB_FLAG
+                } else {
+                    self.magic
+                };
+                StateHistoryLogHeader {
+                    magic,
+                    block_id: header.block_id,
+                    payload_size: stored.len() as u64,
+                }
+                .write(&mut out)?;
+                out.write_all(stored)?;
+                offsets.push((*block, seg_pos));
+                seg_pos += StateHistoryLogHeader::SIZE + stored.len() as u64;
+            }
+
+            out.flush()?;
+            out_file.sync_all()?;
+            drop(out);
+            std::fs::rename(&tmp, &seg_path)?;
+            fsync_parent_dir(&seg_path)?;
+
+            let seg = Arc::new(seg_path);
+            for (block, pos) in offsets {
+                inner.cold_map.insert(block, (seg.clone(), pos));
+            }
+        }
+
+        // Deferred hot prune: drop the contiguous prefix of hot blocks the
+        // cold tier already covers, but only once enough piled up to be
+        // worth one rewrite of the hot file.
+        let covered = inner
+            .map
+            .iter_range(u32::MIN, u32::MAX)
+            .take_while(|(b, _)| inner.cold_map.contains_key(b))
+            .count();
+        if covered > 0 && covered as u32 >= prune_slack {
+            // The newest block is never migrated (`end < last`), so the
+            // run always extends past the covered prefix.
+            if let Some(first_hot) = inner.map.first_block() {
+                self.prune_locked(&mut inner, first_hot + covered as u32)?;
+            }
+        }
+
+        Ok(to_reduce.len() as u32)
+    }
+
     /* -------------------- getters -------------------- */
 
     /// Last appended block number, or 0 if the log is empty.
     /// Prefer `range()` for an unambiguous answer.
     pub fn last_block(&self) -> u32 {
-        self.inner
-            .lock()
-            .unwrap()
-            .range
-            .map(|(_, l)| l)
-            .unwrap_or(0)
+        self.range().map(|(_, l)| l).unwrap_or(0)
     }
 
+    /// Full serveable range across both tiers: oldest archived (or hot)
+    /// block through newest hot block.
     pub fn range(&self) -> Option<(u32, u32)> {
-        self.inner.lock().unwrap().range
+        let inner = self.inner.lock().unwrap();
+        let cold = match (inner.cold_map.keys().next(), inner.cold_map.keys().last()) {
+            (Some(&f), Some(&l)) => Some((f, l)),
+            _ => None,
+        };
+        match (cold, inner.range) {
+            (None, hot) => hot,
+            (cold, None) => cold,
+            (Some((cf, cl)), Some((hf, hl))) => Some((cf.min(hf), hl.max(cl))),
+        }
     }
 
     pub fn get_block_id(&self, block_num: u32) -> Result<Id, ShLogError> {
         let (pos, mut f) = {
             let inner = self.inner.lock().unwrap();
-            let pos = *inner
-                .map
-                .get(&block_num)
-                .ok_or(ShLogError::NotFound(block_num))?;
-            let f = OpenOptions::new().read(true).open(&self.log_path)?;
-            (pos, f)
+            if let Some(pos) = inner.map.get(block_num) {
+                let f = OpenOptions::new().read(true).open(&self.log_path)?;
+                (pos, f)
+            } else if let Some((seg, pos)) = inner.cold_map.get(&block_num) {
+                let f = OpenOptions::new().read(true).open(seg.as_ref())?;
+                (*pos, f)
+            } else {
+                return Err(ShLogError::NotFound(block_num));
+            }
         };
         let len_total = f.metadata()?.len();
         let header = read_validated_header(&mut f, pos, len_total, self.magic)?;
@@ -616,7 +1419,7 @@ fn scan_entries(
             break;
         }
         let header = StateHistoryLogHeader::read_at(file, pos)?;
-        if header.magic != expect_magic {
+        if header.magic & !ENTRY_ZLIB_FLAG != expect_magic {
             return Err(ShLogError::BadMagic {
                 at: pos,
                 found: header.magic,
@@ -718,8 +1521,10 @@ mod tests {
             f.seek(SeekFrom::Start(pos)).unwrap();
             let mut hdr = [0u8; 48];
             f.read_exact(&mut hdr).unwrap();
+            // Bit 63 is the per-entry compression flag; everything below
+            // it must match the log's magic.
             assert_eq!(
-                u64::from_le_bytes(hdr[0..8].try_into().unwrap()),
+                u64::from_le_bytes(hdr[0..8].try_into().unwrap()) & !(1u64 << 63),
                 magic,
                 "raw parse: bad magic at {pos}"
             );
@@ -780,6 +1585,32 @@ mod tests {
         assert!(matches!(log.read_block(missing), Err(ShLogError::NotFound(b)) if b == missing));
     }
 
+    #[test]
+    fn read_block_with_serves_borrowed_payload() {
+        let (dir, magic) = setup("mmapread");
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        let raw = parse_raw(&dir.log_path(), magic);
+
+        for (num, _, want_payload) in &raw {
+            // The callback sees the payload as a slice into the mapping;
+            // extract a value without copying the whole payload out.
+            let (len, first) = log
+                .read_block_with(*num, |payload| {
+                    assert_eq!(payload, want_payload.as_slice());
+                    (payload.len(), payload.first().copied())
+                })
+                .unwrap();
+            assert_eq!(len, want_payload.len());
+            assert_eq!(first, want_payload.first().copied());
+        }
+
+        let missing = raw.last().unwrap().0 + 1000;
+        assert!(matches!(
+            log.read_block_with(missing, |_| ()),
+            Err(ShLogError::NotFound(b)) if b == missing
+        ));
+    }
+
     #[test]
     fn read_range_streams_everything_in_order() {
         let (dir, magic) = setup("range");
@@ -910,6 +1741,31 @@ mod tests {
         assert_eq!(std::fs::metadata(dir.idx_path()).unwrap().len(), idx_len);
     }
 
+    #[test]
+    fn gapped_index_is_rebuilt_from_the_log() {
+        let (dir, magic) = setup("gapidx");
+        drop(StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap());
+
+        let raw = parse_raw(&dir.log_path(), magic);
+        let idx_len = std::fs::metadata(dir.idx_path()).unwrap().len();
+
+        // Cut the second record out of the index, leaving whole records
+        // whose block numbers skip one — corruption the flat position
+        // index cannot represent.
+        let idx = std::fs::read(dir.idx_path()).unwrap();
+        let mut gapped = idx[..IDX_RECORD_SIZE as usize].to_vec();
+        gapped.extend_from_slice(&idx[2 * IDX_RECORD_SIZE as usize..]);
+        std::fs::write(dir.idx_path(), &gapped).unwrap();
+
+        // Open discards the gapped index and rebuilds it from a log scan;
+        // every block reads back and the file is whole again.
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        for (num, _, payload) in &raw {
+            assert_eq!(&log.read_block(*num).unwrap(), payload);
+        }
+        assert_eq!(std::fs::metadata(dir.idx_path()).unwrap().len(), idx_len);
+    }
+
     #[test]
     fn append_is_contiguous_and_durable_across_reopen() {
         let (dir, magic) = setup("append");
@@ -940,6 +1796,65 @@ mod tests {
         assert_eq!(tail.2, b"hello ship");
     }
 
+    #[test]
+    fn compressed_append_shrinks_on_disk_and_reads_back() {
+        let (dir, magic) = setup("zlib");
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        let (_, last) = log.range().unwrap();
+
+        // Highly repetitive payload — representative of trace data.
+        let payload: Vec<u8> = b"transfer from alice to bob "
+            .iter()
+            .copied()
+            .cycle()
+            .take(8192)
+            .collect();
+        log.append(make_id(last + 1, 0xEE), &payload).unwrap();
+        // Tiny payloads don't shrink under zlib and must stay raw.
+        log.append(make_id(last + 2, 0xEF), b"tiny").unwrap();
+
+        // Every read path decompresses transparently.
+        assert_eq!(log.read_block(last + 1).unwrap(), payload);
+        log.read_block_with(last + 1, |p| assert_eq!(p, payload.as_slice()))
+            .unwrap();
+        let mut streamed = Vec::new();
+        log.read_range(last + 1, last + 2, |num, p| {
+            streamed.push((num, p.to_vec()));
+            Ok(())
+        })
+        .unwrap();
+        assert_eq!(streamed[0], (last + 1, payload.clone()));
+        assert_eq!(streamed[1], (last + 2, b"tiny".to_vec()));
+
+        // On disk: the big entry is flagged and much smaller than its
+        // input, the tiny one is stored verbatim with a bare magic.
+        let raw = parse_raw(&dir.log_path(), magic);
+        let (big, tiny) = (&raw[raw.len() - 2], &raw[raw.len() - 1]);
+        assert!(
+            big.2.len() < payload.len() / 4,
+            "entry did not compress: {} bytes on disk",
+            big.2.len()
+        );
+        assert_eq!(tiny.2, b"tiny");
+        let read_magic = |pos: u64| {
+            let mut f = File::open(dir.log_path()).unwrap();
+            f.seek(SeekFrom::Start(pos)).unwrap();
+            let mut m = [0u8; 8];
+            f.read_exact(&mut m).unwrap();
+            u64::from_le_bytes(m)
+        };
+        assert_ne!(read_magic(big.1) & (1 << 63), 0);
+        assert_eq!(read_magic(tiny.1) & (1 << 63), 0);
+
+        // Compressed entries survive a prune rewrite and a reopen.
+        log.prune_keep_last(2).unwrap();
+        drop(log);
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        assert_eq!(log.range().unwrap(), (last + 1, last + 2));
+        assert_eq!(log.read_block(last + 1).unwrap(), payload);
+        assert_eq!(log.read_block(last + 2).unwrap(), b"tiny");
+    }
+
     #[test]
     fn prune_keep_last_preserves_format_and_offsets() {
         let (dir, magic) = setup("prune");
@@ -1005,6 +1920,130 @@ mod tests {
         assert_eq!(mtime_before, mtime_after, "no-op prune rewrote the log");
     }
 
+    #[test]
+    fn archive_moves_old_blocks_to_cold_tier() {
+        let (dir, magic) = setup("tiering");
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        let raw = parse_raw(&dir.log_path(), magic);
+        let (first, last) = log.range().unwrap();
+
+        // Archiving without a cold dir attached is an error, not a
+        // silent prune.
+        assert!(log.archive_before(last).is_err());
+
+        let cold_dir = dir.path().join("cold");
+        log.set_cold_dir(&cold_dir).unwrap();
+        log.archive_before(last).unwrap();
+
+        // The serveable range is unchanged; on disk only the newest
+        // block is still hot and one segment holds the rest.
+        assert_eq!(log.range().unwrap(), (first, last));
+        let hot = parse_raw(&dir.log_path(), magic);
+        assert_eq!(hot.len(), 1);
+        assert_eq!(hot[0].0, last);
+        assert_eq!(std::fs::read_dir(&cold_dir).unwrap().count(), 1);
+
+        // Every block still reads back, whichever tier it lives in.
+        for (num, _, payload) in &raw {
+            assert_eq!(&log.read_block(*num).unwrap(), payload);
+            let id = log.get_block_id(*num).unwrap();
+            assert_eq!(num_from_block_id(&id), *num);
+        }
+
+        // read_range streams across the tier boundary in order.
+        let mut seen = Vec::new();
+        log.read_range(first, last, |num, payload| {
+            seen.push((num, payload.to_vec()));
+            Ok(())
+        })
+        .unwrap();
+        assert_eq!(seen.len(), raw.len());
+        for ((got_num, got), (want_num, _, want)) in seen.iter().zip(raw.iter()) {
+            assert_eq!(got_num, want_num);
+            assert_eq!(got, want);
+        }
+
+        // Appends continue against the hot tail.
+        log.append(make_id(last + 1, 0xC0), b"post-archive").unwrap();
+        assert_eq!(log.range().unwrap(), (first, last + 1));
+
+        // A reopen sees only the hot tier until the cold dir is
+        // re-attached, which rescans the segments.
+        drop(log);
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        assert_eq!(log.range().unwrap(), (last, last + 1));
+        log.set_cold_dir(&cold_dir).unwrap();
+        assert_eq!(log.range().unwrap(), (first, last + 1));
+        assert_eq!(log.read_block(first).unwrap(), raw[0].2);
+        assert_eq!(log.read_block(last + 1).unwrap(), b"post-archive");
+
+        // A second archive run moves the next old block into its own
+        // segment without touching the first one.
+        log.archive_before(last + 1).unwrap();
+        assert_eq!(std::fs::read_dir(&cold_dir).unwrap().count(), 2);
+        assert_eq!(log.read_block(last).unwrap(), raw.last().unwrap().2);
+        assert_eq!(log.range().unwrap(), (first, last + 1));
+    }
+
+    #[test]
+    fn reduce_before_rewrites_old_blocks_and_prunes_lazily() {
+        let dir = TestDir::new("reduce");
+        let magic = fixture_magic();
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        for n in 1u32..=10 {
+            // Big, compressible payloads so reduction visibly shrinks them.
+            let payload: Vec<u8> = format!("full trace payload for block {n} ")
+                .into_bytes()
+                .into_iter()
+                .cycle()
+                .take(4096)
+                .collect();
+            log.append(make_id(n, n as u8), &payload).unwrap();
+        }
+        let cold_dir = dir.path().join("cold");
+        log.set_cold_dir(&cold_dir).unwrap();
+
+        // Keep blocks 8..=10 full; the reducer keeps a 4-byte summary.
+        let mut reduce =
+            |block: u32, payload: &[u8]| -> Result<Vec<u8>, ShLogError> {
+                assert!(payload.len() == 4096, "reducer must see the full payload");
+                Ok(block.to_le_bytes().to_vec())
+            };
+
+        // First pass migrates a bounded batch and, below the slack, leaves
+        // the hot file untouched; reads still prefer the full hot copy of
+        // a block that exists in both tiers.
+        assert_eq!(log.reduce_before(8, 2, 4, &mut reduce).unwrap(), 2);
+        assert_eq!(parse_raw(&dir.log_path(), magic).len(), 10);
+        assert_eq!(log.read_block(1).unwrap().len(), 4096);
+
+        // Second pass reaches the slack and pays the one deferred prune;
+        // only now are the migrated blocks served reduced.
+        assert_eq!(log.reduce_before(8, 2, 4, &mut reduce).unwrap(), 2);
+        let hot = parse_raw(&dir.log_path(), magic);
+        assert_eq!(hot.first().unwrap().0, 5, "covered prefix was not pruned");
+        assert_eq!(hot.len(), 6);
+
+        // The serveable range is unchanged and every tier reads back:
+        // reduced summaries below the boundary, full payloads above it.
+        assert_eq!(log.range().unwrap(), (1, 10));
+        assert_eq!(log.read_block(1).unwrap(), 1u32.to_le_bytes());
+        assert_eq!(log.read_block(3).unwrap(), 3u32.to_le_bytes());
+        assert_eq!(log.read_block(8).unwrap().len(), 4096);
+
+        // Draining the rest stops at the retention boundary: blocks 8..=10
+        // stay full however often the pass runs.
+        assert_eq!(log.reduce_before(8, 100, 2, &mut reduce).unwrap(), 3);
+        assert_eq!(log.reduce_before(8, 100, 2, &mut reduce).unwrap(), 0);
+        assert_eq!(log.read_block(7).unwrap(), 7u32.to_le_bytes());
+        assert_eq!(log.read_block(10).unwrap().len(), 4096);
+        assert_eq!(parse_raw(&dir.log_path(), magic).len(), 3);
+
+        // Appends continue against the hot tail.
+        log.append(make_id(11, 0xDD), b"post-reduce").unwrap();
+        assert_eq!(log.range().unwrap(), (1, 11));
+    }
+
     #[test]
     fn wrong_magic_is_rejected() {
         let (dir, magic) = setup("badmagic");
@@ -1013,6 +2052,39 @@ mod tests {
         assert!(matches!(err, ShLogError::BadMagic { at: 0, .. }));
     }
 
+    #[test]
+    fn uring_backend_matches_buffered_format() {
+        // On kernels without io_uring (and on non-Linux) the backend
+        // falls back to buffered appends, so this degenerates into a
+        // second round-trip test rather than failing.
+        let dir = TestDir::new("uring");
+        let magic = fixture_magic();
+        let log =
+            StateHistoryLog::open_with_backend(dir.path(), "block_log", magic, ShIoBackend::Uring)
+                .unwrap();
+
+        let payload: Vec<u8> = b"uring append payload ".iter().copied().cycle().take(4096).collect();
+        log.append(make_id(1, 0x11), &payload).unwrap(); // per-entry fsync
+        log.append_relaxed(make_id(2, 0x22), b"relaxed").unwrap();
+        log.sync().unwrap();
+        assert_eq!(log.range().unwrap(), (1, 2));
+        assert_eq!(log.read_block(1).unwrap(), payload);
+        drop(log);
+
+        // The bytes on disk are the same format either backend writes: a
+        // plain buffered reopen must parse log and index unchanged.
+        let log = StateHistoryLog::open_with_magic(dir.path(), "block_log", magic).unwrap();
+        assert_eq!(log.range().unwrap(), (1, 2));
+        assert_eq!(log.read_block(1).unwrap(), payload);
+        assert_eq!(log.read_block(2).unwrap(), b"relaxed");
+        let raw = parse_raw(&dir.log_path(), magic);
+        assert_eq!(raw.len(), 2);
+        assert_eq!(
+            std::fs::metadata(dir.idx_path()).unwrap().len(),
+            2 * IDX_RECORD_SIZE
+        );
+    }
+
     #[test]
     fn fresh_empty_log_roundtrip() {
         let dir = TestDir::new("fresh");
@@ -1,5 +1,14 @@
 mod abi;
 pub use abi::*;
 
+mod account_index;
+pub use account_index::*;
+
 mod log;
 pub use log::*;
+
+mod trace_index;
+pub use trace_index::*;
+
+mod writer;
+pub use writer::*;
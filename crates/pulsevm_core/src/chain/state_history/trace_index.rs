@@ -0,0 +1,187 @@
+use std::{
+    collections::HashMap,
+    fs::OpenOptions,
+    io::{self, BufReader, BufWriter, Read, Seek, SeekFrom, Write},
+    path::{Path, PathBuf},
+    sync::Mutex,
+};
+
+use pulsevm_crypto::FixedBytes;
+
+use crate::chain::id::Id;
+
+use super::ShLogError;
+
+/// Size of one index record: 32-byte transaction id + u32 block_num (LE) +
+/// u32 offset of the packed trace inside its block's payload (LE).
+const RECORD_SIZE: u64 = 40;
+
+/// Secondary index over the trace log: transaction id → (block number,
+/// byte offset of that transaction's packed trace inside the block's
+/// decompressed trace payload).
+///
+/// The trace log itself is keyed by block number only, so without this
+/// index "show me the trace of transaction X" means scanning blocks. With
+/// it, a lookup is one in-memory probe plus one `read_block_with` of the
+/// owning block, and the reader starts deserializing at the stored offset
+/// instead of unpacking every trace in the block.
+///
+/// Records are written by the state-history writer thread right after the
+/// trace payload they point into, and fsynced by the same group-commit.
+/// The index is advisory: a crash can lose the unsynced tail, in which
+/// case affected transactions merely report "not found" — the traces
+/// themselves are still in the log.
+pub struct TransactionTraceIndex {
+    inner: Mutex<Inner>,
+}
+
+struct Inner {
+    file: BufWriter<std::fs::File>,
+    map: HashMap<Id, (u32, u32)>,
+}
+
+impl TransactionTraceIndex {
+    pub fn open<P: AsRef<Path>>(dir: P, name: &str) -> Result<Self, ShLogError> {
+        let path: PathBuf = dir.as_ref().join(format!("{name}.txindex"));
+        let mut file = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .open(&path)?;
+
+        let mut map = HashMap::new();
+        let mut valid_bytes = 0u64;
+        {
+            file.seek(SeekFrom::Start(0))?;
+            let mut r = BufReader::new(&file);
+            loop {
+                let mut buf = [0u8; RECORD_SIZE as usize];
+                match r.read_exact(&mut buf) {
+                    Ok(()) => {
+                        let mut id_bytes = [0u8; 32];
+                        id_bytes.copy_from_slice(&buf[0..32]);
+                        let block_num = u32::from_le_bytes(buf[32..36].try_into().unwrap());
+                        let offset = u32::from_le_bytes(buf[36..40].try_into().unwrap());
+                        map.insert(Id(FixedBytes(id_bytes)), (block_num, offset));
+                        valid_bytes += RECORD_SIZE;
+                    }
+                    Err(e) if e.kind() == io::ErrorKind::UnexpectedEof => break,
+                    Err(e) => return Err(ShLogError::Io(e)),
+                }
+            }
+        }
+        // Truncate a torn trailing record so the next append lands on a
+        // record boundary instead of permanently breaking the framing.
+        if file.metadata()?.len() > valid_bytes {
+            file.set_len(valid_bytes)?;
+        }
+        file.seek(SeekFrom::End(0))?;
+
+        Ok(Self {
+            inner: Mutex::new(Inner {
+                file: BufWriter::new(file),
+                map,
+            }),
+        })
+    }
+
+    /// Record where each of a block's traces sits inside its payload.
+    /// Flushed to the OS immediately; durability comes from the caller's
+    /// group-commit [`sync`](Self::sync).
+    pub fn append(&self, block_num: u32, entries: &[(Id, u32)]) -> Result<(), ShLogError> {
+        let mut inner = self.inner.lock().unwrap();
+        let inner = &mut *inner;
+        for (id, offset) in entries {
+            inner.file.write_all(&id.0.0)?;
+            inner.file.write_all(&block_num.to_le_bytes())?;
+            inner.file.write_all(&offset.to_le_bytes())?;
+            inner.map.insert(id.clone(), (block_num, *offset));
+        }
+        inner.file.flush()?;
+        Ok(())
+    }
+
+    /// Force appended records to disk — called alongside the trace log's
+    /// own group-commit sync.
+    pub fn sync(&self) -> Result<(), ShLogError> {
+        let mut inner = self.inner.lock().unwrap();
+        inner.file.flush()?;
+        inner.file.get_ref().sync_data()?;
+        Ok(())
+    }
+
+    /// One in-memory probe: (block number, payload offset) of the packed
+    /// trace, or `None` for transactions this node never traced.
+    pub fn lookup(&self, id: &Id) -> Option<(u32, u32)> {
+        self.inner.lock().unwrap().map.get(id).copied()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::{AtomicU32, Ordering};
+
+    fn make_id(filler: u8) -> Id {
+        Id(FixedBytes([filler; 32]))
+    }
+
+    fn scratch_dir(tag: &str) -> PathBuf {
+        static N: AtomicU32 = AtomicU32::new(0);
+        let dir = std::env::temp_dir().join(format!(
+            "txindex-test-{tag}-{}-{}",
+            std::process::id(),
+            N.fetch_add(1, Ordering::Relaxed)
+        ));
+        std::fs::create_dir_all(&dir).unwrap();
+        dir
+    }
+
+    #[test]
+    fn append_lookup_and_reopen() {
+        let dir = scratch_dir("roundtrip");
+        {
+            let index = TransactionTraceIndex::open(&dir, "trace_log").unwrap();
+            index.append(7, &[(make_id(1), 1), (make_id(2), 120)]).unwrap();
+            index.append(8, &[(make_id(3), 1)]).unwrap();
+            assert_eq!(index.lookup(&make_id(2)), Some((7, 120)));
+            assert_eq!(index.lookup(&make_id(9)), None);
+        }
+        // A reopen reloads every record from disk.
+        let index = TransactionTraceIndex::open(&dir, "trace_log").unwrap();
+        assert_eq!(index.lookup(&make_id(1)), Some((7, 1)));
+        assert_eq!(index.lookup(&make_id(3)), Some((8, 1)));
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn torn_record_is_truncated_on_open() {
+        let dir = scratch_dir("torn");
+        {
+            let index = TransactionTraceIndex::open(&dir, "trace_log").unwrap();
+            index.append(3, &[(make_id(1), 1), (make_id(2), 99)]).unwrap();
+            index.sync().unwrap();
+        }
+        // Chop into the last record — a torn write.
+        let path = dir.join("trace_log.txindex");
+        let len = std::fs::metadata(&path).unwrap().len();
+        OpenOptions::new()
+            .write(true)
+            .open(&path)
+            .unwrap()
+            .set_len(len - 5)
+            .unwrap();
+
+        let index = TransactionTraceIndex::open(&dir, "trace_log").unwrap();
+        assert_eq!(index.lookup(&make_id(1)), Some((3, 1)));
+        assert_eq!(index.lookup(&make_id(2)), None);
+        // The file is whole records again and appending continues cleanly.
+        assert_eq!(
+            std::fs::metadata(&path).unwrap().len() % RECORD_SIZE,
+            0
+        );
+        index.append(4, &[(make_id(4), 1)]).unwrap();
+        assert_eq!(index.lookup(&make_id(4)), Some((4, 1)));
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+}
@@ -0,0 +1,562 @@
+use std::{
+    sync::{
+        Arc,
+        mpsc::{Receiver, RecvTimeoutError, SyncSender, TrySendError, sync_channel},
+    },
+    thread::JoinHandle,
+    time::{Duration, Instant},
+};
+
+use pulsevm_serialization::{NumBytes, Read, Write, pack_with_buffer};
+use spdlog::error;
+
+use crate::chain::{
+    id::Id, memory_ledger::MEMORY_LEDGER, metrics::METRICS, transaction::TransactionTrace,
+};
+
+use super::{AccountActionEntry, AccountActionIndex, ShLogError, StateHistoryLog, TransactionTraceIndex};
+
+/// How many queued jobs block acceptance may run ahead of disk. Three
+/// jobs per block (block, traces, deltas) makes this ~85 blocks of
+/// backlog before `submit` blocks the accepting thread.
+const QUEUE_DEPTH: usize = 256;
+
+/// Upper bound on one group-commit batch so a deep backlog still syncs
+/// at a reasonable cadence instead of deferring durability indefinitely.
+const MAX_BATCH: usize = 64;
+
+/// How many blocks one trace-reduction pass migrates into the reduced
+/// tier. One pass per accepted block at this size drains a retention
+/// backlog several times faster than it grows without ever dominating
+/// the writer's queue.
+const REDUCE_BATCH: u32 = 16;
+
+/// How many reduced-but-still-hot blocks accumulate before the trace log
+/// pays the one hot-file rewrite that drops them. Larger values amortize
+/// the rewrite over more blocks at the cost of that much duplicated
+/// storage.
+const REDUCE_PRUNE_SLACK: u32 = 256;
+
+enum WriteJob {
+    /// Pre-packed payload (blocks, chain-state deltas).
+    Append {
+        log: Arc<StateHistoryLog>,
+        block_id: Id,
+        payload: Vec<u8>,
+    },
+    /// Traces are handed over unpacked so serialization of thousands of
+    /// traces per block also happens off the block path, in the writer
+    /// thread's warm pack buffer. When a transaction-id index rides along,
+    /// each trace's offset inside the packed payload is recorded in it;
+    /// an account-action index likewise gets one record per delivered
+    /// action, keyed by receiver and receive sequence.
+    AppendTraces {
+        log: Arc<StateHistoryLog>,
+        block_id: Id,
+        traces: Arc<Vec<TransactionTrace>>,
+        index: Option<Arc<TransactionTraceIndex>>,
+        account_index: Option<Arc<AccountActionIndex>>,
+    },
+    /// One bounded pass of tiered trace retention: migrate up to
+    /// [`REDUCE_BATCH`] blocks below `keep_from` into the reduced cold
+    /// tier, receipts and RAM deltas only.
+    ReduceTraces {
+        log: Arc<StateHistoryLog>,
+        keep_from: u32,
+    },
+}
+
+impl WriteJob {
+    fn log(&self) -> &Arc<StateHistoryLog> {
+        match self {
+            WriteJob::Append { log, .. } => log,
+            WriteJob::AppendTraces { log, .. } => log,
+            WriteJob::ReduceTraces { log, .. } => log,
+        }
+    }
+
+    // Payload bytes this job holds while queued, charged to the node
+    // memory ledger between enqueue and execution. Traces are counted at
+    // their serialized size — `num_bytes` walks them without packing —
+    // which understates their in-memory footprint but tracks the same
+    // growth during a storm.
+    fn queued_bytes(&self) -> u64 {
+        match self {
+            WriteJob::Append { payload, .. } => payload.len() as u64,
+            WriteJob::AppendTraces { traces, .. } => traces.num_bytes() as u64,
+            WriteJob::ReduceTraces { .. } => 0,
+        }
+    }
+}
+
+/// Dedicated writer thread for the state-history logs.
+///
+/// Block acceptance used to pay the fsync of three `StateHistoryLog`
+/// files inline; now it enqueues appends on a bounded channel and only
+/// blocks when the queue is full. The writer drains whatever is queued,
+/// appends it all with `append_relaxed`, then group-commits with one
+/// `sync` per touched log — so under load many blocks share one fsync.
+///
+/// With a zero `sync_window` the group-commit runs after every drained
+/// batch, which at steady one-block-per-500ms load still means one fsync
+/// per log per block. A non-zero window defers the commit until that
+/// much time has passed since the last one, so in the steady state the
+/// window's worth of blocks across all logs shares a single fsync each.
+///
+/// A crash can lose at most the tail appended since the last commit;
+/// `open_with_magic` already truncates torn tails and re-syncs the
+/// index on the next start, and the node re-derives recent history from
+/// the consensus layer.
+pub struct StateHistoryWriter {
+    tx: Option<SyncSender<WriteJob>>,
+    handle: Option<JoinHandle<()>>,
+}
+
+impl StateHistoryWriter {
+    pub fn spawn(sync_window: Duration) -> Self {
+        let (tx, rx) = sync_channel(QUEUE_DEPTH);
+        let handle = std::thread::Builder::new()
+            .name("ship-writer".to_string())
+            .spawn(move || writer_loop(rx, sync_window))
+            .expect("failed to spawn state-history writer thread");
+        StateHistoryWriter {
+            tx: Some(tx),
+            handle: Some(handle),
+        }
+    }
+
+    /// Queue one pre-packed payload. Blocks only when the queue is full.
+    pub fn submit(&self, log: &Arc<StateHistoryLog>, block_id: Id, payload: Vec<u8>) {
+        self.send(WriteJob::Append {
+            log: log.clone(),
+            block_id,
+            payload,
+        });
+    }
+
+    /// Queue a block's traces; they are packed on the writer thread, which
+    /// also records each trace's payload offset in `index` when one is given.
+    /// The traces arrive shared so the accepted-block broadcast can hold the
+    /// same `Arc` without a copy.
+    pub fn submit_traces(
+        &self,
+        log: &Arc<StateHistoryLog>,
+        block_id: Id,
+        traces: Arc<Vec<TransactionTrace>>,
+        index: Option<Arc<TransactionTraceIndex>>,
+        account_index: Option<Arc<AccountActionIndex>>,
+    ) {
+        self.send(WriteJob::AppendTraces {
+            log: log.clone(),
+            block_id,
+            traces,
+            index,
+            account_index,
+        });
+    }
+
+    /// Queue one incremental trace-reduction pass against `log`, keeping
+    /// blocks at or above `keep_from` full. Cheap to call every block:
+    /// a pass with nothing below the boundary left to migrate is a map
+    /// probe and returns immediately.
+    pub fn submit_trace_reduction(&self, log: &Arc<StateHistoryLog>, keep_from: u32) {
+        self.send(WriteJob::ReduceTraces {
+            log: log.clone(),
+            keep_from,
+        });
+    }
+
+    fn send(&self, job: WriteJob) {
+        let tx = self.tx.as_ref().expect("writer already shut down");
+        // Charged up front and released by the writer thread when the job
+        // executes; a job the channel drops gives its bytes straight back.
+        let queued_bytes = job.queued_bytes();
+        MEMORY_LEDGER.add_state_history_queued(queued_bytes);
+        // try_send first so the common case never takes the blocking
+        // path; a full queue falls back to a blocking send, which is the
+        // intended backpressure on block acceptance.
+        match tx.try_send(job) {
+            Ok(()) => {}
+            Err(TrySendError::Full(job)) => {
+                if tx.send(job).is_err() {
+                    MEMORY_LEDGER.sub_state_history_queued(queued_bytes);
+                    error!("[ship-writer] writer thread gone, dropping append");
+                }
+            }
+            Err(TrySendError::Disconnected(_)) => {
+                MEMORY_LEDGER.sub_state_history_queued(queued_bytes);
+                error!("[ship-writer] writer thread gone, dropping append");
+            }
+        }
+    }
+}
+
+impl Drop for StateHistoryWriter {
+    fn drop(&mut self) {
+        // Closing the channel lets the thread drain outstanding jobs and
+        // run its final group-commit before we join it.
+        self.tx.take();
+        if let Some(handle) = self.handle.take() {
+            let _ = handle.join();
+        }
+    }
+}
+
+/// Everything appended since the last group-commit, so one `sync` per
+/// touched file covers however many blocks the durability window held.
+#[derive(Default)]
+struct Dirty {
+    logs: Vec<Arc<StateHistoryLog>>,
+    indexes: Vec<Arc<TransactionTraceIndex>>,
+    account_indexes: Vec<Arc<AccountActionIndex>>,
+}
+
+impl Dirty {
+    fn is_empty(&self) -> bool {
+        self.logs.is_empty() && self.indexes.is_empty() && self.account_indexes.is_empty()
+    }
+
+    fn mark(&mut self, job: &WriteJob) {
+        // Reduction writes its segment through sync+rename itself and
+        // appends nothing, so it owes the group commit no fsync.
+        if matches!(job, WriteJob::ReduceTraces { .. }) {
+            return;
+        }
+        if !self.logs.iter().any(|l| Arc::ptr_eq(l, job.log())) {
+            self.logs.push(job.log().clone());
+        }
+        if let WriteJob::AppendTraces {
+            index,
+            account_index,
+            ..
+        } = job
+        {
+            if let Some(index) = index {
+                if !self.indexes.iter().any(|i| Arc::ptr_eq(i, index)) {
+                    self.indexes.push(index.clone());
+                }
+            }
+            if let Some(account_index) = account_index {
+                if !self
+                    .account_indexes
+                    .iter()
+                    .any(|i| Arc::ptr_eq(i, account_index))
+                {
+                    self.account_indexes.push(account_index.clone());
+                }
+            }
+        }
+    }
+
+    fn sync(&mut self) {
+        for log in self.logs.drain(..) {
+            if let Err(e) = log.sync() {
+                error!("[ship-writer] group-commit sync failed: {e}");
+            }
+        }
+        for index in self.indexes.drain(..) {
+            if let Err(e) = index.sync() {
+                error!("[ship-writer] trace index sync failed: {e}");
+            }
+        }
+        for index in self.account_indexes.drain(..) {
+            if let Err(e) = index.sync() {
+                error!("[ship-writer] account index sync failed: {e}");
+            }
+        }
+    }
+}
+
+fn writer_loop(rx: Receiver<WriteJob>, sync_window: Duration) {
+    let mut dirty = Dirty::default();
+    // Start of the current durability window: the time of the first
+    // append since the last group-commit. Every block is on disk within
+    // `sync_window` of being handed to the writer.
+    let mut window_start = Instant::now();
+
+    loop {
+        // With nothing unsynced there is no deadline to honor, so block
+        // indefinitely. With dirty files, wait at most until the window
+        // elapses, then commit even if no new work arrived.
+        let first = if dirty.is_empty() {
+            match rx.recv() {
+                Ok(job) => {
+                    window_start = Instant::now();
+                    Some(job)
+                }
+                Err(_) => break,
+            }
+        } else {
+            let deadline = window_start + sync_window;
+            match rx.recv_timeout(deadline.saturating_duration_since(Instant::now())) {
+                Ok(job) => Some(job),
+                Err(RecvTimeoutError::Timeout) => None,
+                Err(RecvTimeoutError::Disconnected) => break,
+            }
+        };
+
+        if let Some(first) = first {
+            let mut batch = vec![first];
+            while batch.len() < MAX_BATCH {
+                match rx.try_recv() {
+                    Ok(job) => batch.push(job),
+                    Err(_) => break,
+                }
+            }
+            for job in batch {
+                dirty.mark(&job);
+                MEMORY_LEDGER.sub_state_history_queued(job.queued_bytes());
+                perform(job);
+            }
+        }
+
+        // Group-commit once the durability window has passed. A zero
+        // window degenerates to one commit per drained batch.
+        if !dirty.is_empty() && window_start.elapsed() >= sync_window {
+            dirty.sync();
+        }
+    }
+
+    // Shutdown: commit whatever the window was still holding.
+    dirty.sync();
+}
+
+fn perform(job: WriteJob) {
+    if let WriteJob::ReduceTraces { log, keep_from } = job {
+        if let Err(e) = log.reduce_before(
+            keep_from,
+            REDUCE_BATCH,
+            REDUCE_PRUNE_SLACK,
+            &mut reduce_trace_payload,
+        ) {
+            error!("[ship-writer] trace reduction failed: {e}");
+        }
+        return;
+    }
+
+    let append_start = std::time::Instant::now();
+    let result = match job {
+        WriteJob::Append {
+            log,
+            block_id,
+            payload,
+        } => log.append_relaxed(block_id, &payload),
+        WriteJob::AppendTraces {
+            log,
+            block_id,
+            traces,
+            index,
+            account_index,
+        } => {
+            let block_num = u32::from_be_bytes(block_id.0.0[0..4].try_into().unwrap());
+            let result =
+                match pack_with_buffer(&*traces, |bytes| log.append_relaxed(block_id, bytes)) {
+                    Ok(res) => res,
+                    Err(e) => {
+                        error!("[ship-writer] failed to pack traces: {e}");
+                        return;
+                    }
+                };
+            // Index records go in only after the payload they point into
+            // is at least flushed, mirroring the log's own index ordering.
+            if result.is_ok() && (index.is_some() || account_index.is_some()) {
+                // The payload is the packed Vec: a length prefix, then
+                // each trace at the running offset of its predecessors.
+                let mut entries = Vec::with_capacity(traces.len());
+                let mut account_entries = Vec::new();
+                let mut offset = traces.len().num_bytes();
+                for trace in traces.iter() {
+                    entries.push((trace.id().clone(), offset as u32));
+                    if account_index.is_some() {
+                        for action_trace in trace.action_traces() {
+                            let Some(receipt) = &action_trace.receipt else {
+                                continue;
+                            };
+                            account_entries.push((
+                                receipt.receiver.as_u64(),
+                                AccountActionEntry {
+                                    recv_sequence: receipt.recv_sequence,
+                                    block_num,
+                                    offset: offset as u32,
+                                    action_ordinal: action_trace.action_ordinal,
+                                },
+                            ));
+                        }
+                    }
+                    offset += trace.num_bytes();
+                }
+                if let Some(index) = index {
+                    if let Err(e) = index.append(block_num, &entries) {
+                        error!("[ship-writer] trace index append failed: {e}");
+                    }
+                }
+                if let Some(account_index) = account_index {
+                    if let Err(e) = account_index.append(&account_entries) {
+                        error!("[ship-writer] account index append failed: {e}");
+                    }
+                }
+            }
+            result
+        }
+        WriteJob::ReduceTraces { .. } => unreachable!("handled above"),
+    };
+    METRICS.observe_state_history_append(append_start.elapsed());
+    if let Err(e) = result {
+        error!("[ship-writer] append failed: {e}");
+    }
+}
+
+/// Rewrite one packed `Vec<TransactionTrace>` payload down to its
+/// retention summary: action input data, console output and return
+/// values are dropped, while receipts (sequence numbers, digests),
+/// RAM deltas, ordinals and error fields survive — enough to settle a
+/// dispute over what executed and what it was billed, at a fraction of
+/// the storage. The result packs back into the same wire shape, so
+/// every trace reader handles reduced blocks unchanged.
+fn reduce_trace_payload(_block: u32, payload: &[u8]) -> Result<Vec<u8>, ShLogError> {
+    let mut pos = 0usize;
+    let mut traces = Vec::<TransactionTrace>::read(payload, &mut pos).map_err(|e| {
+        ShLogError::Io(std::io::Error::other(format!(
+            "unpacking traces for reduction: {e:?}"
+        )))
+    })?;
+    for trace in &mut traces {
+        for action_trace in &mut trace.action_traces {
+            action_trace.act.data = Default::default();
+            action_trace.console = String::new();
+            action_trace.return_value = Default::default();
+        }
+    }
+    traces.pack().map_err(|e| {
+        ShLogError::Io(std::io::Error::other(format!(
+            "packing reduced traces: {e:?}"
+        )))
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use pulsevm_name_macro::name;
+    use crate::chain::{
+        name::Name,
+        transaction::{Action, ActionReceipt, ActionTrace},
+    };
+    use pulsevm_crypto::{Bytes, Digest, FixedBytes};
+    use std::{collections::BTreeMap, str::FromStr};
+
+    fn make_id(block_num: u32, filler: u8) -> Id {
+        let mut b = [filler; 32];
+        b[0..4].copy_from_slice(&block_num.to_be_bytes());
+        Id(FixedBytes(b))
+    }
+
+    #[test]
+    fn trace_reduction_keeps_receipts_and_ram_deltas() {
+        let receiver = Name::new(name!("alice"));
+        let mut ram_deltas = BTreeMap::new();
+        ram_deltas.insert(receiver, 240i64);
+        let act = Action::new(
+            Name::new(name!("pulse.token")),
+            Name::new(name!("transfer")),
+            vec![0xAB; 512],
+            vec![],
+        );
+        let mut action_trace = ActionTrace::new(
+            make_id(7, 0x07),
+            7,
+            Default::default(),
+            act,
+            receiver,
+            false,
+            1,
+            0,
+            0,
+            ram_deltas.clone(),
+        );
+        action_trace.receipt = Some(ActionReceipt::new(
+            receiver,
+            Digest::default(),
+            42,
+            9,
+            BTreeMap::new(),
+            3,
+            2,
+        ));
+        action_trace.console = "debug output ".repeat(64);
+        action_trace.return_value = Bytes::from(vec![0xCD; 256]);
+        let trace = TransactionTrace {
+            id: make_id(7, 0x07),
+            block_num: 7,
+            action_traces: vec![action_trace],
+            ..Default::default()
+        };
+
+        let full = vec![trace].pack().unwrap();
+        let reduced = reduce_trace_payload(7, &full).unwrap();
+        assert!(
+            reduced.len() < full.len() / 4,
+            "reduction kept too much: {} of {} bytes",
+            reduced.len(),
+            full.len()
+        );
+
+        // The summary still parses as the same wire shape, with the heavy
+        // fields gone and the accounting fields intact.
+        let mut pos = 0usize;
+        let traces = Vec::<TransactionTrace>::read(&reduced, &mut pos).unwrap();
+        assert_eq!(traces.len(), 1);
+        let at = &traces[0].action_traces[0];
+        assert!(at.act.data.is_empty());
+        assert!(at.console.is_empty());
+        assert!(at.return_value.as_slice().is_empty());
+        assert_eq!(at.act.account, Name::new(name!("pulse.token")));
+        assert_eq!(at.account_ram_deltas, ram_deltas);
+        let receipt = at.receipt.as_ref().expect("receipt must survive");
+        assert_eq!(receipt.global_sequence, 42);
+        assert_eq!(receipt.recv_sequence, 9);
+        assert_eq!(traces[0].id, make_id(7, 0x07));
+    }
+
+    #[test]
+    fn writer_drains_queue_before_shutdown() {
+        let dir = std::env::temp_dir().join(format!("pulsevm_sh_writer_{}", std::process::id()));
+        std::fs::create_dir_all(&dir).unwrap();
+        let log = Arc::new(
+            StateHistoryLog::open_with_magic(&dir, "writer_log", 0xFEED_FACE_CAFE_F00D).unwrap(),
+        );
+
+        let writer = StateHistoryWriter::spawn(Duration::ZERO);
+        for num in 1u32..=20 {
+            writer.submit(&log, make_id(num, 0xAA), format!("payload {num}").into_bytes());
+        }
+        // Drop joins the thread after its final group-commit.
+        drop(writer);
+
+        assert_eq!(log.range().unwrap(), (1, 20));
+        assert_eq!(log.read_block(7).unwrap(), b"payload 7");
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn shutdown_commits_inside_an_open_window() {
+        let dir =
+            std::env::temp_dir().join(format!("pulsevm_sh_writer_win_{}", std::process::id()));
+        std::fs::create_dir_all(&dir).unwrap();
+        let log = Arc::new(
+            StateHistoryLog::open_with_magic(&dir, "writer_log", 0xFEED_FACE_CAFE_F00D).unwrap(),
+        );
+
+        // A window far longer than the test means no deadline fires; the
+        // shutdown path must still group-commit everything appended.
+        let writer = StateHistoryWriter::spawn(Duration::from_secs(3600));
+        for num in 1u32..=5 {
+            writer.submit(&log, make_id(num, 0xBB), format!("payload {num}").into_bytes());
+        }
+        drop(writer);
+
+        assert_eq!(log.range().unwrap(), (1, 5));
+        assert_eq!(log.read_block(3).unwrap(), b"payload 3");
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+}
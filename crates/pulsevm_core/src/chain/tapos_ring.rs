@@ -0,0 +1,109 @@
+use pulsevm_error::ChainError;
+
+use crate::chain::{block::BlockHeader, id::Id, utils::pulse_assert};
+
+// One slot per possible low-16 block number: the span TAPoS can address.
+const RING_SLOTS: usize = 1 << 16;
+
+/// Ring of the last 64k accepted blocks' TAPoS prefixes, indexed by the low
+/// 16 bits of the block number — the same truncation a transaction's
+/// `ref_block_num` carries.
+///
+/// Recording happens on every head update, so the ring always mirrors the
+/// accepted chain and a reference check is one array index instead of a
+/// block lookup. Each slot keeps the full block number alongside the prefix:
+/// a slot is authoritative only while the block that wrote it is still the
+/// newest with that low-16 number, and an empty or superseded slot skips the
+/// check rather than failing it (a node that just started has nothing to
+/// compare against, which must not reject valid traffic).
+pub struct TaposRing {
+    // (block number, ref_block_prefix); block number 0 marks an empty slot
+    // (the chain starts at block 1).
+    slots: Box<[(u32, u32)]>,
+}
+
+impl TaposRing {
+    pub fn new() -> Self {
+        Self {
+            slots: vec![(0u32, 0u32); RING_SLOTS].into_boxed_slice(),
+        }
+    }
+
+    /// TAPoS prefix of a block id: bytes 8..12 little-endian, matching the
+    /// `ref_block_prefix` wallets derive when they sign.
+    #[inline]
+    pub fn prefix_from_id(id: &Id) -> u32 {
+        u32::from_le_bytes(id.0.0[8..12].try_into().unwrap())
+    }
+
+    /// Records an accepted block. Called from the single head-update path,
+    /// so replay and live acceptance both keep the ring current.
+    pub fn record(&mut self, id: &Id) {
+        let block_num = BlockHeader::num_from_id(id);
+        self.slots[(block_num & 0xFFFF) as usize] = (block_num, Self::prefix_from_id(id));
+    }
+
+    /// Checks a transaction's reference block against the ring.
+    ///
+    /// `(0, 0)` passes unconditionally — it is the opt-out this node's own
+    /// transaction construction emits. A populated slot whose block number
+    /// still truncates to `ref_block_num` must match the prefix; anything
+    /// the ring cannot vouch for passes, so the check only ever rejects a
+    /// reference that provably names a block off the accepted chain.
+    pub fn verify(&self, ref_block_num: u16, ref_block_prefix: u32) -> Result<(), ChainError> {
+        if ref_block_num == 0 && ref_block_prefix == 0 {
+            return Ok(());
+        }
+        let (block_num, prefix) = self.slots[ref_block_num as usize];
+        if block_num == 0 {
+            return Ok(());
+        }
+        pulse_assert(
+            prefix == ref_block_prefix,
+            ChainError::TransactionError(format!(
+                "transaction's reference block {} does not match the accepted chain",
+                ref_block_num
+            )),
+        )
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use pulsevm_crypto::FixedBytes;
+
+    use super::*;
+
+    fn id_for(block_num: u32, prefix: u32) -> Id {
+        let mut bytes = [0u8; 32];
+        bytes[0..4].copy_from_slice(&block_num.to_be_bytes());
+        bytes[8..12].copy_from_slice(&prefix.to_le_bytes());
+        Id(FixedBytes(bytes))
+    }
+
+    #[test]
+    fn matches_recorded_prefix_and_rejects_mismatch() {
+        let mut ring = TaposRing::new();
+        ring.record(&id_for(1234, 0xDEADBEEF));
+        assert!(ring.verify(1234, 0xDEADBEEF).is_ok());
+        assert!(ring.verify(1234, 0xDEADBEF0).is_err());
+    }
+
+    #[test]
+    fn unknown_slots_and_opt_out_pass() {
+        let ring = TaposRing::new();
+        // Empty ring: nothing to vouch against, everything passes.
+        assert!(ring.verify(1234, 0xDEADBEEF).is_ok());
+        assert!(ring.verify(0, 0).is_ok());
+    }
+
+    #[test]
+    fn newer_block_supersedes_the_slot() {
+        let mut ring = TaposRing::new();
+        ring.record(&id_for(1234, 0x11111111));
+        // Same low-16 number, one ring revolution later.
+        ring.record(&id_for(1234 + (1 << 16), 0x22222222));
+        assert!(ring.verify(1234, 0x22222222).is_ok());
+        assert!(ring.verify(1234, 0x11111111).is_err());
+    }
+}
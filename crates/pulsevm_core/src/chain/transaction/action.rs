@@ -1,8 +1,8 @@
 use core::fmt;
 use std::sync::Arc;
 
-use pulsevm_crypto::Digest as OurDigest;
-use pulsevm_serialization::{NumBytes, Read, Write};
+use pulsevm_crypto::{Bytes, Digest as OurDigest};
+use pulsevm_serialization::{NumBytes, Read, ReadRef, Write};
 use serde::{Deserialize, Serialize};
 use sha2::Digest;
 
@@ -12,7 +12,8 @@ use crate::chain::{Name, authority::PermissionLevel};
 pub struct Action {
     pub account: Name,
     pub name: Name,
-    pub authorization: Vec<PermissionLevel>,
+    #[serde(with = "arc_slice_serde")]
+    pub authorization: Arc<[PermissionLevel]>,
     #[serde(with = "arc_bytes_serde")]
     pub data: Arc<[u8]>,
 }
@@ -38,7 +39,7 @@ impl Action {
             account,
             name,
             data: Arc::from(data),
-            authorization,
+            authorization: Arc::from(authorization),
         }
     }
 
@@ -69,10 +70,10 @@ impl Action {
     }
 }
 
-pub fn generate_action_digest(act: &Action, action_return_value: Option<Vec<u8>>) -> OurDigest {
+pub fn generate_action_digest(act: &Action, action_return_value: Option<Bytes>) -> OurDigest {
     let mut bytes = act.pack().unwrap();
     if let Some(return_value) = action_return_value {
-        bytes.extend(return_value);
+        bytes.extend_from_slice(return_value.as_slice());
     }
     OurDigest::hash(&bytes)
 }
@@ -96,6 +97,38 @@ impl Read for Action {
     }
 }
 
+/// Borrowed view of an [`Action`] decoded over the source buffer: the action
+/// data stays a slice into that buffer instead of being copied out. Convert
+/// with [`ActionRef::into_owned`] when the action must outlive the buffer.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ActionRef<'a> {
+    pub account: Name,
+    pub name: Name,
+    pub authorization: Vec<PermissionLevel>,
+    pub data: &'a [u8],
+}
+
+impl ActionRef<'_> {
+    pub fn into_owned(self) -> Action {
+        Action::new(self.account, self.name, self.data.to_vec(), self.authorization)
+    }
+}
+
+impl<'a> ReadRef<'a> for ActionRef<'a> {
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, pulsevm_serialization::ReadError> {
+        let account = Name::read(bytes, pos)?;
+        let name = Name::read(bytes, pos)?;
+        let authorization = Vec::<PermissionLevel>::read(bytes, pos)?;
+        let data = <&[u8]>::read_ref(bytes, pos)?;
+        Ok(ActionRef {
+            account,
+            name,
+            authorization,
+            data,
+        })
+    }
+}
+
 impl Write for Action {
     fn write(
         &self,
@@ -104,12 +137,33 @@ impl Write for Action {
     ) -> Result<(), pulsevm_serialization::WriteError> {
         self.account.write(bytes, pos)?;
         self.name.write(bytes, pos)?;
-        self.authorization.write(bytes, pos)?;
-        self.data.as_ref().to_vec().write(bytes, pos)?;
+        self.authorization.as_ref().write(bytes, pos)?;
+        self.data.as_ref().write(bytes, pos)?;
         Ok(())
     }
 }
 
+mod arc_slice_serde {
+    use serde::{Deserialize, Deserializer, Serialize, Serializer};
+    use std::sync::Arc;
+
+    pub fn serialize<S, T>(data: &Arc<[T]>, serializer: S) -> Result<S::Ok, S::Error>
+    where
+        S: Serializer,
+        T: Serialize,
+    {
+        serializer.collect_seq(data.iter())
+    }
+
+    pub fn deserialize<'de, D, T>(deserializer: D) -> Result<Arc<[T]>, D::Error>
+    where
+        D: Deserializer<'de>,
+        T: Deserialize<'de>,
+    {
+        Ok(Vec::<T>::deserialize(deserializer)?.into())
+    }
+}
+
 mod arc_bytes_serde {
     use serde::Serializer;
 
@@ -4,10 +4,11 @@ use pulsevm_crypto::Digest;
 use pulsevm_error::ChainError;
 use pulsevm_proc_macros::{NumBytes, Read, Write};
 use pulsevm_serialization::Write;
+use serde::Serialize;
 
 use crate::chain::name::Name;
 
-#[derive(Debug, Clone, PartialEq, Eq, Read, Write, NumBytes)]
+#[derive(Debug, Clone, PartialEq, Eq, Read, Write, NumBytes, Serialize)]
 pub struct ActionReceipt {
     pub receiver: Name,
     pub act_digest: Digest,
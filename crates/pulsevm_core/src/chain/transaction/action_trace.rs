@@ -1,8 +1,10 @@
 use core::fmt;
 use std::collections::BTreeMap;
 
+use pulsevm_crypto::Bytes;
 use pulsevm_ffi::BlockTimestamp;
 use pulsevm_proc_macros::{NumBytes, Read, Write};
+use serde::Serialize;
 
 use crate::chain::{
     id::Id,
@@ -10,7 +12,7 @@ use crate::chain::{
     transaction::{Action, ActionReceipt},
 };
 
-#[derive(Debug, Clone, PartialEq, Eq, Read, Write, NumBytes)]
+#[derive(Debug, Clone, PartialEq, Eq, Read, Write, NumBytes, Serialize)]
 pub struct ActionTrace {
     pub action_ordinal: u32,
     pub creator_action_ordinal: u32,
@@ -27,7 +29,9 @@ pub struct ActionTrace {
     pub account_ram_deltas: BTreeMap<Name, i64>,
     pub except: Option<u8>,
     pub error_code: Option<u64>,
-    pub return_value: Vec<u8>,
+    // Refcounted: shares the allocation produced by the wasm host call, so
+    // large return payloads are not re-copied into every trace hand-off.
+    pub return_value: Bytes,
 }
 
 impl ActionTrace {
@@ -59,7 +63,7 @@ impl ActionTrace {
             account_ram_deltas,
             except: None,
             error_code: None,
-            return_value: vec![],
+            return_value: Bytes::default(),
         }
     }
 
@@ -5,10 +5,10 @@ mod action_trace;
 pub use action_trace::ActionTrace;
 
 mod action;
-pub use action::{Action, generate_action_digest};
+pub use action::{Action, ActionRef, generate_action_digest};
 
 mod packed_transaction;
-pub use packed_transaction::PackedTransaction;
+pub use packed_transaction::{PackedTransaction, PackedTransactionRef};
 
 mod signed_transaction;
 pub use signed_transaction::SignedTransaction;
@@ -23,7 +23,7 @@ mod transaction_receipt_header;
 pub use transaction_receipt_header::{TransactionReceiptHeader, TransactionStatus};
 
 mod transaction_receipt;
-pub use transaction_receipt::TransactionReceipt;
+pub use transaction_receipt::{TransactionReceipt, TransactionReceiptRef};
 
 mod transaction_trace;
 pub use transaction_trace::TransactionTrace;
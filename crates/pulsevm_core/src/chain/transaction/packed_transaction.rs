@@ -1,33 +1,66 @@
-use std::{collections::BTreeSet, io::Read as IoRead};
+use std::{
+    borrow::Cow,
+    collections::BTreeSet,
+    io::Read as IoRead,
+    sync::{Arc, Mutex},
+};
 
 use flate2::read::ZlibDecoder;
 use pulsevm_constants::FIXED_NET_OVERHEAD_OF_PACKED_TRX;
-use pulsevm_crypto::Bytes;
+use pulsevm_crypto::{Bytes, Digest};
 use pulsevm_error::ChainError;
-use pulsevm_serialization::{NumBytes, Read, ReadError, Write, WriteError};
+use pulsevm_serialization::{NumBytes, Read, ReadError, ReadRef, VarUint32, Write, WriteError};
 use serde::{Serialize, ser::SerializeStruct};
 
 use crate::{
     chain::{
         id::Id,
-        transaction::{SignedTransaction, Transaction, TransactionCompression},
+        transaction::{
+            SignedTransaction, Transaction, TransactionCompression, TransactionReceiptHeader,
+        },
         utils::pulse_assert,
     },
     crypto::Signature,
 };
 
-#[derive(Debug, Clone, PartialEq, Eq)]
+/// Last receipt digest computed over this transaction, keyed by the receipt
+/// header it was computed under. Shared across clones: the copy retained in
+/// the mempool and the copy embedded in a block's receipt see the same memo,
+/// so rebuilding a block after a consensus flip reuses the leaf digests from
+/// the rejected attempt instead of re-serializing and re-hashing every
+/// transaction body.
+type ReceiptDigestMemo = Arc<Mutex<Option<(TransactionReceiptHeader, Digest)>>>;
+
+#[derive(Debug, Clone)]
 pub struct PackedTransaction {
     signatures: BTreeSet<Signature>,     // Signatures of the transaction
     compression: TransactionCompression, // Compression type used for the transaction
     packed_context_free_data: Bytes,     // Packed context-free data, if any
     packed_trx: Bytes,                   // Packed transaction, not signed, data
 
-    // Following fields are not serialized
-    unpacked_trx: SignedTransaction,
+    // Following fields are not serialized. The decoded transaction is
+    // shared, not owned: a packed transaction is cloned on its way through
+    // admission, gossip, block building and the transaction context, and
+    // every consumer reads the same immutable decode (with the id cached
+    // alongside) instead of deep-copying the action payloads per clone.
+    unpacked_trx: Arc<SignedTransaction>,
     trx_id: Id,
+    receipt_digest_memo: ReceiptDigestMemo,
+}
+
+// The memo is a cache, not part of the transaction's value; equality covers
+// the wire fields only (the id is derived from them).
+impl PartialEq for PackedTransaction {
+    fn eq(&self, other: &Self) -> bool {
+        self.signatures == other.signatures
+            && self.compression == other.compression
+            && self.packed_context_free_data == other.packed_context_free_data
+            && self.packed_trx == other.packed_trx
+    }
 }
 
+impl Eq for PackedTransaction {}
+
 impl PackedTransaction {
     #[inline]
     pub fn new(
@@ -35,20 +68,57 @@ impl PackedTransaction {
         compression: TransactionCompression,
         packed_context_free_data: Bytes,
         packed_trx: Bytes,
+    ) -> Result<Self, ChainError> {
+        Self::new_with_payload_digest(
+            signatures,
+            compression,
+            packed_context_free_data,
+            packed_trx,
+            None,
+        )
+    }
+
+    /// The decode path behind [`Self::new`]. `payload_digest`, when given,
+    /// is the digest of the uncompressed payload bytes, precomputed by
+    /// [`Self::read_batch`] in one batch-hash pass over a whole gossip
+    /// frame; it is only trusted where hashing the payload here would
+    /// produce the same value.
+    fn new_with_payload_digest(
+        signatures: BTreeSet<Signature>,
+        compression: TransactionCompression,
+        packed_context_free_data: Bytes,
+        packed_trx: Bytes,
+        payload_digest: Option<Digest>,
     ) -> Result<Self, ChainError> {
         let trx_bytes = maybe_decompress(compression, packed_trx.as_ref())?;
         let cfd_bytes = maybe_decompress(compression, packed_context_free_data.as_ref())?;
-        let unpacked_trx = Transaction::read(trx_bytes.as_slice(), &mut 0).map_err(|e| {
+        let unpacked_trx = Transaction::read(&trx_bytes, &mut 0).map_err(|e| {
             ChainError::SerializationError(format!("failed to unpack transaction: {}", e))
         })?;
         let unpacked_context_free_data = if cfd_bytes.len() > 0 {
-            Vec::<Bytes>::read(cfd_bytes.as_slice(), &mut 0).map_err(|e| {
+            Vec::<Bytes>::read(&cfd_bytes, &mut 0).map_err(|e| {
                 ChainError::SerializationError(format!("failed to unpack context free data: {}", e))
             })?
         } else {
             vec![]
         };
-        let trx_id: Id = unpacked_trx.id()?;
+
+        // The id is the hash of the transaction's canonical packed form.
+        // When the payload we just decoded is that form, hash it directly
+        // while it is still cache-hot instead of re-serializing the
+        // transaction only to hash the copy. The length check is what makes
+        // this sound: re-packing always emits minimal varints, and a
+        // non-minimal varint (or trailing bytes) can only make the payload
+        // longer, so matching lengths mean matching bytes.
+        let trx_id: Id = if unpacked_trx.num_bytes() == trx_bytes.len() {
+            let digest = match payload_digest {
+                Some(digest) => digest,
+                None => Digest::hash(&trx_bytes),
+            };
+            Id::new(digest.0)
+        } else {
+            unpacked_trx.id()?
+        };
 
         Ok(Self {
             signatures: signatures.clone(),
@@ -56,15 +126,47 @@ impl PackedTransaction {
             packed_context_free_data,
             packed_trx,
 
-            unpacked_trx: SignedTransaction::new(
+            unpacked_trx: Arc::new(SignedTransaction::new(
                 unpacked_trx,
                 signatures,
                 unpacked_context_free_data,
-            ),
+            )),
             trx_id: trx_id,
+            receipt_digest_memo: ReceiptDigestMemo::default(),
         })
     }
 
+    /// The receipt digest last computed over this transaction, if it was
+    /// computed under the same receipt header. [`TransactionReceipt::digest`]
+    /// consults and fills this; a rebuilt block whose execution produced the
+    /// same status and usage numbers gets its merkle leaves back for the cost
+    /// of a header compare.
+    ///
+    /// [`TransactionReceipt::digest`]: super::TransactionReceipt::digest
+    #[inline]
+    pub(crate) fn cached_receipt_digest(
+        &self,
+        header: &TransactionReceiptHeader,
+    ) -> Option<Digest> {
+        let memo = self
+            .receipt_digest_memo
+            .lock()
+            .unwrap_or_else(|p| p.into_inner());
+        match &*memo {
+            Some((cached_header, digest)) if cached_header == header => Some(*digest),
+            _ => None,
+        }
+    }
+
+    #[inline]
+    pub(crate) fn cache_receipt_digest(&self, header: &TransactionReceiptHeader, digest: Digest) {
+        let mut memo = self
+            .receipt_digest_memo
+            .lock()
+            .unwrap_or_else(|p| p.into_inner());
+        *memo = Some((header.clone(), digest));
+    }
+
     #[inline]
     pub fn get_signed_transaction(&self) -> &SignedTransaction {
         &self.unpacked_trx
@@ -75,6 +177,14 @@ impl PackedTransaction {
         self.unpacked_trx.transaction()
     }
 
+    /// Shared handle to the decode, for consumers that outlive this packed
+    /// transaction (trace storage, background workers); cloning it bumps a
+    /// refcount rather than re-deserializing or deep-copying.
+    #[inline]
+    pub fn shared_signed_transaction(&self) -> Arc<SignedTransaction> {
+        self.unpacked_trx.clone()
+    }
+
     #[inline]
     pub fn get_unprunable_size(&self) -> Result<u64, ChainError> {
         let mut size = FIXED_NET_OVERHEAD_OF_PACKED_TRX as u64;
@@ -120,10 +230,81 @@ impl PackedTransaction {
                 })?
                 .into(),
 
-            unpacked_trx: trx,
+            unpacked_trx: Arc::new(trx),
+            trx_id,
+            receipt_digest_memo: ReceiptDigestMemo::default(),
+        })
+    }
+
+    /// Like [`Self::from_signed_transaction`], but zstd-compresses the
+    /// packed payload when that actually shrinks it. Large deploys (a
+    /// setcode carrying megabytes of wasm) compress to a fraction of their
+    /// packed size; payloads that don't benefit keep
+    /// [`TransactionCompression::None`] so the receiver skips the inflate.
+    #[inline]
+    pub fn from_signed_transaction_compressed(
+        trx: SignedTransaction,
+    ) -> Result<Self, ChainError> {
+        let trx_id = trx.transaction().id().map_err(|e| {
+            ChainError::SerializationError(format!("failed to get transaction ID: {}", e))
+        })?;
+        let packed = trx.transaction().pack().map_err(|e| {
+            ChainError::SerializationError(format!("failed to pack transaction: {}", e))
+        })?;
+
+        let compressed = zstd::bulk::compress(&packed, zstd::DEFAULT_COMPRESSION_LEVEL)
+            .map_err(|e| ChainError::SerializationError(format!("zstd compress failed: {e}")))?;
+        let (compression, packed_trx) = if compressed.len() < packed.len() {
+            (TransactionCompression::Zstd, compressed)
+        } else {
+            (TransactionCompression::None, packed)
+        };
+
+        Ok(Self {
+            signatures: trx.signatures().clone(),
+            compression,
+            packed_context_free_data: Bytes::default(),
+            packed_trx: packed_trx.into(),
+
+            unpacked_trx: Arc::new(trx),
             trx_id,
+            receipt_digest_memo: ReceiptDigestMemo::default(),
         })
     }
+
+    /// Decodes a serialized `Vec<PackedTransaction>` (a gossip batch),
+    /// hashing every uncompressed payload in one [`Digest::hash_many`]
+    /// call over the frame's borrowed slices before the transactions are
+    /// built. The per-transaction decode then takes its id from the batch
+    /// pass instead of hashing each payload individually; compressed
+    /// payloads are rare on this path and fall back to the single-payload
+    /// route inside the constructor.
+    pub fn read_batch(data: &[u8], pos: &mut usize) -> Result<Vec<Self>, ReadError> {
+        let count = VarUint32::read(data, pos)?.0 as usize;
+        let mut refs = Vec::with_capacity(count.min(1024));
+        for _ in 0..count {
+            refs.push(PackedTransactionRef::read_ref(data, pos)?);
+        }
+
+        let uncompressed: Vec<&[u8]> = refs
+            .iter()
+            .filter(|r| r.compression == TransactionCompression::None)
+            .map(|r| r.packed_trx)
+            .collect();
+        let mut digests = Digest::hash_many(&uncompressed).into_iter();
+
+        let mut out = Vec::with_capacity(refs.len());
+        for r in refs {
+            let payload_digest = (r.compression == TransactionCompression::None)
+                .then(|| digests.next())
+                .flatten();
+            out.push(
+                r.into_owned_with_payload_digest(payload_digest)
+                    .map_err(|_| ReadError::ParseError)?,
+            );
+        }
+        Ok(out)
+    }
 }
 
 impl NumBytes for PackedTransaction {
@@ -180,23 +361,252 @@ impl Serialize for PackedTransaction {
     }
 }
 
+/// Borrowed view over a serialized `PackedTransaction`: the packed payloads
+/// reference the source buffer instead of being copied out, and the inner
+/// transaction is not unpacked. Callers that only need the raw fields (size
+/// accounting, header-level block parsing) pay no allocation; everything
+/// else goes through [`PackedTransactionRef::into_owned`], which runs the
+/// full `PackedTransaction::new` validation.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct PackedTransactionRef<'a> {
+    signatures: BTreeSet<Signature>,
+    compression: TransactionCompression,
+    packed_context_free_data: &'a [u8],
+    packed_trx: &'a [u8],
+}
+
+impl<'a> PackedTransactionRef<'a> {
+    #[inline]
+    pub fn packed_trx(&self) -> &'a [u8] {
+        self.packed_trx
+    }
+
+    #[inline]
+    pub fn into_owned(self) -> Result<PackedTransaction, ChainError> {
+        PackedTransaction::new(
+            self.signatures,
+            self.compression,
+            self.packed_context_free_data.into(),
+            self.packed_trx.into(),
+        )
+    }
+
+    /// Like [`Self::into_owned`], with the payload digest already computed
+    /// by [`PackedTransaction::read_batch`]'s batch-hash pass.
+    #[inline]
+    fn into_owned_with_payload_digest(
+        self,
+        payload_digest: Option<Digest>,
+    ) -> Result<PackedTransaction, ChainError> {
+        PackedTransaction::new_with_payload_digest(
+            self.signatures,
+            self.compression,
+            self.packed_context_free_data.into(),
+            self.packed_trx.into(),
+            payload_digest,
+        )
+    }
+}
+
+impl<'a> ReadRef<'a> for PackedTransactionRef<'a> {
+    #[inline]
+    fn read_ref(data: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let signatures = BTreeSet::<Signature>::read(data, pos)?;
+        let compression = TransactionCompression::read(data, pos)?;
+        let packed_context_free_data = <&[u8]>::read_ref(data, pos)?;
+        let packed_trx = <&[u8]>::read_ref(data, pos)?;
+        Ok(PackedTransactionRef {
+            signatures,
+            compression,
+            packed_context_free_data,
+            packed_trx,
+        })
+    }
+}
+
 #[inline]
+// Upper bound on a decompressed payload, well above anything net limits
+// admit. Nothing inflates past it: the zlib decoder stops reading at the
+// cap and zstd payloads are rejected from the frame header alone, so a
+// compression bomb costs one header parse, not an allocation.
+const MAX_DECOMPRESSED_TRANSACTION_BYTES: usize = 64 * 1024 * 1024;
+
 fn maybe_decompress(
     compression: TransactionCompression,
     data: &[u8],
-) -> Result<Vec<u8>, ChainError> {
+) -> Result<Cow<'_, [u8]>, ChainError> {
     match compression {
-        TransactionCompression::None => Ok(data.to_vec()),
+        // Uncompressed payloads are parsed in place, no copy.
+        TransactionCompression::None => Ok(Cow::Borrowed(data)),
         TransactionCompression::Zlib => {
             if data.is_empty() {
-                return Ok(Vec::new());
+                return Ok(Cow::Owned(Vec::new()));
             }
-            let mut decoder = ZlibDecoder::new(data);
+            let decoder = ZlibDecoder::new(data);
             let mut out = Vec::new();
-            decoder.read_to_end(&mut out).map_err(|e| {
-                ChainError::SerializationError(format!("zlib decompress failed: {e}"))
+            decoder
+                .take(MAX_DECOMPRESSED_TRANSACTION_BYTES as u64 + 1)
+                .read_to_end(&mut out)
+                .map_err(|e| {
+                    ChainError::SerializationError(format!("zlib decompress failed: {e}"))
+                })?;
+            pulse_assert(
+                out.len() <= MAX_DECOMPRESSED_TRANSACTION_BYTES,
+                ChainError::SerializationError(
+                    "decompressed transaction exceeds size limit".into(),
+                ),
+            )?;
+            Ok(Cow::Owned(out))
+        }
+        TransactionCompression::Zstd => {
+            if data.is_empty() {
+                return Ok(Cow::Owned(Vec::new()));
+            }
+            // The frame header carries the content size (every encoder fed
+            // from a whole buffer writes it); require it, so the bound is
+            // checked and the output sized before a byte is inflated.
+            let expected = zstd::zstd_safe::get_frame_content_size(data)
+                .map_err(|e| {
+                    ChainError::SerializationError(format!("bad zstd frame header: {e}"))
+                })?
+                .ok_or_else(|| {
+                    ChainError::SerializationError(
+                        "zstd frame is missing its content size".into(),
+                    )
+                })?;
+            pulse_assert(
+                expected <= MAX_DECOMPRESSED_TRANSACTION_BYTES as u64,
+                ChainError::SerializationError(
+                    "decompressed transaction exceeds size limit".into(),
+                ),
+            )?;
+            let out = zstd::bulk::decompress(data, expected as usize).map_err(|e| {
+                ChainError::SerializationError(format!("zstd decompress failed: {e}"))
             })?;
-            Ok(out)
+            Ok(Cow::Owned(out))
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use std::str::FromStr;
+
+    use pulsevm_ffi::TimePointSec;
+    use pulsevm_name::Name;
+
+    use super::*;
+    use crate::chain::transaction::{Action, TransactionHeader};
+    use pulsevm_name_macro::name;
+
+    fn deploy_like_transaction(payload: Vec<u8>) -> SignedTransaction {
+        SignedTransaction::new(
+            Transaction::new(
+                TransactionHeader::new(TimePointSec::new(100), 1, 2, 4.into(), 3, 0.into()),
+                vec![],
+                vec![Action::new(
+                    Name::new(name!("pulse")),
+                    Name::new(name!("setcode")),
+                    payload,
+                    vec![],
+                )],
+            ),
+            BTreeSet::new(),
+            vec![],
+        )
+    }
+
+    #[test]
+    fn compressed_round_trip_preserves_the_transaction() {
+        // Wasm-like payload: long and repetitive, so compression engages.
+        let trx = deploy_like_transaction(vec![0x42u8; 64 * 1024]);
+        let packed = PackedTransaction::from_signed_transaction_compressed(trx.clone()).unwrap();
+        assert_eq!(packed.compression, TransactionCompression::Zstd);
+        assert!(packed.packed_trx.len() < 64 * 1024);
+
+        let wire = packed.pack().unwrap();
+        let decoded = PackedTransaction::read(&wire, &mut 0).unwrap();
+        assert_eq!(decoded.id(), packed.id());
+        assert_eq!(decoded.get_transaction(), trx.transaction());
+    }
+
+    #[test]
+    fn incompressible_payloads_stay_uncompressed() {
+        let trx = deploy_like_transaction((0u32..64).flat_map(|i| i.to_le_bytes()).collect());
+        let packed = PackedTransaction::from_signed_transaction_compressed(trx).unwrap();
+        assert_eq!(packed.compression, TransactionCompression::None);
+    }
+
+    #[test]
+    fn receipt_digests_are_memoized_per_header() {
+        use crate::chain::transaction::{TransactionReceipt, TransactionStatus};
+
+        let trx = deploy_like_transaction(vec![1, 2, 3]);
+        let packed = PackedTransaction::from_signed_transaction(trx).unwrap();
+        let header = TransactionReceiptHeader::new(TransactionStatus::Executed, 10, 2u32.into());
+
+        let receipt = TransactionReceipt::new(header.clone(), packed.clone());
+        let digest = receipt.digest().unwrap();
+        // The memo lives behind an Arc, so the clone the receipt was built
+        // from shares it with the original held here.
+        assert_eq!(packed.cached_receipt_digest(&header), Some(digest));
+
+        // A receipt with different usage numbers misses the memo and
+        // recomputes; the leaf covers the header, so the digest moves too.
+        let other = TransactionReceiptHeader::new(TransactionStatus::Executed, 11, 2u32.into());
+        let recomputed = TransactionReceipt::new(other.clone(), packed.clone())
+            .digest()
+            .unwrap();
+        assert_ne!(recomputed, digest);
+        assert_eq!(packed.cached_receipt_digest(&other), Some(recomputed));
+    }
+
+    #[test]
+    fn batch_decode_matches_item_decode() {
+        let txs: Vec<PackedTransaction> = (0u8..4)
+            .map(|i| {
+                PackedTransaction::from_signed_transaction(deploy_like_transaction(vec![i; 32]))
+                    .unwrap()
+            })
+            .collect();
+        let wire = txs.pack().unwrap();
+        let batch = PackedTransaction::read_batch(&wire, &mut 0).unwrap();
+        assert_eq!(batch, txs);
+        // The batch pass hashed the wire payloads; the originals derived
+        // their ids from the re-packed transaction. Same id either way.
+        for (from_batch, original) in batch.iter().zip(&txs) {
+            assert_eq!(from_batch.id(), original.id());
+        }
+    }
+
+    #[test]
+    fn non_canonical_payloads_fall_back_to_the_repacked_id() {
+        let trx = deploy_like_transaction(vec![7; 16]);
+        let canonical = PackedTransaction::from_signed_transaction(trx.clone()).unwrap();
+
+        // A trailing byte decodes to the same transaction but fails the
+        // length check, so the id must come from the re-packed form and
+        // match the canonical encoding's id.
+        let mut padded = trx.transaction().pack().unwrap();
+        padded.push(0);
+        let packed = PackedTransaction::new(
+            BTreeSet::new(),
+            TransactionCompression::None,
+            Bytes::default(),
+            padded.into(),
+        )
+        .unwrap();
+        assert_eq!(packed.id(), canonical.id());
+    }
+
+    #[test]
+    fn oversized_zstd_frames_are_rejected_from_the_header() {
+        // A bare frame header claiming a terabyte: magic number, descriptor
+        // selecting an 8-byte content-size field with the single-segment
+        // flag, then the size itself. The guard must trip on the header
+        // alone — no payload follows to inflate.
+        let mut frame = vec![0x28, 0xB5, 0x2F, 0xFD, 0xE0];
+        frame.extend_from_slice(&(1u64 << 40).to_le_bytes());
+        assert!(maybe_decompress(TransactionCompression::Zstd, &frame).is_err());
+    }
+}
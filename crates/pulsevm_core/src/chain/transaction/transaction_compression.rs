@@ -11,6 +11,7 @@ use serde::{
 pub enum TransactionCompression {
     None = 0,
     Zlib = 1,
+    Zstd = 2,
 }
 
 impl TransactionCompression {
@@ -19,6 +20,7 @@ impl TransactionCompression {
         match n {
             0 => Ok(TransactionCompression::None),
             1 => Ok(TransactionCompression::Zlib),
+            2 => Ok(TransactionCompression::Zstd),
             _ => Err("unknown compression enum value"),
         }
     }
@@ -29,6 +31,8 @@ impl TransactionCompression {
             Ok(TransactionCompression::None)
         } else if s.eq_ignore_ascii_case("zlib") {
             Ok(TransactionCompression::Zlib)
+        } else if s.eq_ignore_ascii_case("zstd") {
+            Ok(TransactionCompression::Zstd)
         } else if let Ok(n) = s.parse::<u64>() {
             // Accept numeric strings like "0" / "1" too (handy for some clients)
             Self::from_u64(n)
@@ -43,6 +47,7 @@ impl Write for TransactionCompression {
         match self {
             TransactionCompression::None => u8::write(&0, bytes, pos),
             TransactionCompression::Zlib => u8::write(&1, bytes, pos),
+            TransactionCompression::Zstd => u8::write(&2, bytes, pos),
         }
     }
 }
@@ -59,6 +64,7 @@ impl Read for TransactionCompression {
         match value {
             0 => Ok(TransactionCompression::None),
             1 => Ok(TransactionCompression::Zlib),
+            2 => Ok(TransactionCompression::Zstd),
             _ => Err(ReadError::ParseError),
         }
     }
@@ -72,6 +78,7 @@ impl Serialize for TransactionCompression {
         let status = match self {
             TransactionCompression::None => "none",
             TransactionCompression::Zlib => "zlib",
+            TransactionCompression::Zstd => "zstd",
         };
         serializer.serialize_str(status)
     }
@@ -88,7 +95,7 @@ impl<'de> Deserialize<'de> for TransactionCompression {
             type Value = TransactionCompression;
 
             fn expecting(&self, f: &mut fmt::Formatter) -> fmt::Result {
-                f.write_str(r#"a string "none"/"zlib" or an integer 0/1"#)
+                f.write_str(r#"a string "none"/"zlib"/"zstd" or an integer 0/1/2"#)
             }
 
             // Handle "none"/"zlib" or numeric strings "0"/"1"
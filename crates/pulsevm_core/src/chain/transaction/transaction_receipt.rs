@@ -1,9 +1,12 @@
 use pulsevm_crypto::Digest;
+use pulsevm_error::ChainError;
 use pulsevm_proc_macros::{NumBytes, Read, Write};
-use pulsevm_serialization::{Write, WriteError};
+use pulsevm_serialization::{Read as _, ReadError, ReadRef, Write, WriteError};
 use serde::Serialize;
 
-use crate::chain::transaction::{PackedTransaction, TransactionReceiptHeader};
+use crate::chain::transaction::{
+    PackedTransaction, PackedTransactionRef, TransactionReceiptHeader,
+};
 
 #[derive(Debug, Clone, PartialEq, Eq, Read, Write, NumBytes, Serialize)]
 pub struct TransactionReceipt {
@@ -27,7 +30,52 @@ impl TransactionReceipt {
         &self.trx
     }
 
+    pub fn header(&self) -> &TransactionReceiptHeader {
+        &self.header
+    }
+
+    /// Merkle leaf digest of this receipt: the hash of the packed header and
+    /// transaction. The serialize-and-hash is memoized on the packed
+    /// transaction (keyed by the header, which the digest also covers), so
+    /// rebuilding a block from the same mempool contents after a consensus
+    /// flip reuses the leaves computed for the rejected attempt.
     pub fn digest(&self) -> Result<Digest, WriteError> {
-        Ok(Digest::hash(self.pack()?))
+        if let Some(cached) = self.trx.cached_receipt_digest(&self.header) {
+            return Ok(cached);
+        }
+        let digest = Digest::hash(self.pack()?);
+        self.trx.cache_receipt_digest(&self.header, digest);
+        Ok(digest)
+    }
+}
+
+/// Borrowed view of a [`TransactionReceipt`]; the wrapped transaction's
+/// packed payloads stay slices into the source buffer.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct TransactionReceiptRef<'a> {
+    header: TransactionReceiptHeader,
+    trx: PackedTransactionRef<'a>,
+}
+
+impl<'a> TransactionReceiptRef<'a> {
+    pub(crate) fn new(header: TransactionReceiptHeader, trx: PackedTransactionRef<'a>) -> Self {
+        TransactionReceiptRef { header, trx }
+    }
+
+    pub fn trx(&self) -> &PackedTransactionRef<'a> {
+        &self.trx
+    }
+
+    pub fn into_owned(self) -> Result<TransactionReceipt, ChainError> {
+        Ok(TransactionReceipt::new(self.header, self.trx.into_owned()?))
+    }
+}
+
+impl<'a> ReadRef<'a> for TransactionReceiptRef<'a> {
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let header = TransactionReceiptHeader::read(bytes, pos)?;
+        let _trx_variant = u8::read(bytes, pos)?; // always 1 for now
+        let trx = PackedTransactionRef::read_ref(bytes, pos)?;
+        Ok(TransactionReceiptRef { header, trx })
     }
 }
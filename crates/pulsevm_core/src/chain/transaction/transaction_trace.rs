@@ -1,5 +1,6 @@
 use pulsevm_ffi::BlockTimestamp;
 use pulsevm_proc_macros::{NumBytes, Read, Write};
+use serde::Serialize;
 
 use crate::chain::{
     account::AccountDelta,
@@ -7,7 +8,7 @@ use crate::chain::{
     transaction::{ActionTrace, TransactionReceiptHeader},
 };
 
-#[derive(Default, Clone, Read, Write, NumBytes)]
+#[derive(Default, Clone, Read, Write, NumBytes, Serialize)]
 pub struct TransactionTrace {
     pub id: Id,
     pub block_num: u32,
@@ -1,49 +1,174 @@
 use std::{
-    collections::{BTreeMap, BTreeSet, VecDeque},
-    sync::{Arc, RwLock},
+    collections::{BTreeMap, HashSet, VecDeque},
+    sync::{
+        Arc, RwLock,
+        atomic::{AtomicBool, AtomicU64, Ordering},
+    },
+    time::Instant,
 };
 
 use pulsevm_crypto::Digest;
 use pulsevm_error::ChainError;
-use pulsevm_ffi::{BlockTimestamp, Database, Microseconds, TimePoint, seconds};
+use pulsevm_ffi::{
+    AccountMetadataObject, AccountRamDelta, BlockTimestamp, Database, TimePoint, seconds,
+};
 use pulsevm_serialization::VarUint32;
 
 use crate::{
     authorization_manager::AuthorizationManager, block::BlockStatus, chain::{
         apply_context::ApplyContext,
         id::Id,
+        metrics::METRICS,
         name::Name,
         resource_limits::ResourceLimitsManager,
+        sequence_counters::SequenceCounters,
+        slow_transactions::{
+            MAX_ACTIONS_PER_RECORD, SLOW_TRX_LOG, SlowActionRecord, SlowTransactionRecord,
+        },
         transaction::{Action, ActionTrace, Transaction, TransactionStatus, TransactionTrace},
         utils::pulse_assert,
+        wasm_costs,
         wasm_runtime::WasmRuntime,
     }, controller::Controller, transaction::PackedTransaction,
 };
 
-#[derive(Default, Clone)]
-struct Billing {
-    paused_time: TimePoint,
-    pseudo_start: TimePoint,
-    billed_time: Microseconds,
+// Lock-free billing timer for CPU wall-clock tracking. pause/resume bracket
+// every wasm dispatch, so they must not take the context-wide lock or build
+// TimePoints from the system clock: the state is a monotonic anchor plus a
+// few atomics, making a pause/resume pair two clock reads and a handful of
+// atomic operations. A wall-clock budget derived from the chain's
+// max_transaction_cpu_usage is checked at the same boundaries so a runaway
+// transaction aborts at its deadline instead of running on.
+struct BillingTimer {
+    anchor: Instant,
+    // Nanoseconds since `anchor` at which the current billable segment
+    // started; `BILLING_PAUSED` while the timer is not running.
+    started_ns: AtomicU64,
+    // Billable nanoseconds accumulated from completed segments.
+    billed_ns: AtomicU64,
+    // Total billable budget in nanoseconds; 0 means no deadline.
+    budget_ns: AtomicU64,
+    // Set when CPU time is billed explicitly; pause/resume become no-ops.
+    explicit_billed: AtomicBool,
+}
+
+const BILLING_PAUSED: u64 = u64::MAX;
+
+// Smallest inline-action payload the per-transaction memo considers; below
+// this the memcmp and lock traffic cost more than the duplicate allocation.
+const INLINE_DATA_MEMO_MIN: usize = 512;
+
+impl BillingTimer {
+    fn new() -> Self {
+        BillingTimer {
+            anchor: Instant::now(),
+            started_ns: AtomicU64::new(0),
+            billed_ns: AtomicU64::new(0),
+            budget_ns: AtomicU64::new(0),
+            explicit_billed: AtomicBool::new(false),
+        }
+    }
+
+    fn now_ns(&self) -> u64 {
+        self.anchor.elapsed().as_nanos() as u64
+    }
+
+    fn set_budget_us(&self, us: u64) {
+        self.budget_ns
+            .store(us.saturating_mul(1_000), Ordering::Relaxed);
+    }
+
+    // Stops the billable clock; errors if the accumulated time went over
+    // budget during the segment that just ended.
+    fn pause(&self) -> Result<(), ChainError> {
+        if self.explicit_billed.load(Ordering::Relaxed) {
+            return Ok(());
+        }
+        let started = self.started_ns.swap(BILLING_PAUSED, Ordering::Relaxed);
+        if started == BILLING_PAUSED {
+            return Ok(());
+        }
+        let elapsed = self.now_ns().saturating_sub(started);
+        let billed = self.billed_ns.fetch_add(elapsed, Ordering::Relaxed) + elapsed;
+        self.check_deadline(billed)
+    }
+
+    fn resume(&self) -> Result<(), ChainError> {
+        if self.explicit_billed.load(Ordering::Relaxed) {
+            return Ok(());
+        }
+        if self.started_ns.load(Ordering::Relaxed) != BILLING_PAUSED {
+            return Ok(());
+        }
+        self.check_deadline(self.billed_ns.load(Ordering::Relaxed))?;
+        self.started_ns.store(self.now_ns(), Ordering::Relaxed);
+        Ok(())
+    }
+
+    // Wall-clock budget left on the transaction, `None` when no deadline is
+    // armed. Counts the running segment too, so a caller sampling mid-segment
+    // sees the true remainder.
+    fn remaining_budget_us(&self) -> Option<u64> {
+        let budget = self.budget_ns.load(Ordering::Relaxed);
+        if budget == 0 {
+            return None;
+        }
+        let mut billed = self.billed_ns.load(Ordering::Relaxed);
+        let started = self.started_ns.load(Ordering::Relaxed);
+        if started != BILLING_PAUSED {
+            billed = billed.saturating_add(self.now_ns().saturating_sub(started));
+        }
+        Some(budget.saturating_sub(billed) / 1_000)
+    }
+
+    fn check_deadline(&self, billed_ns: u64) -> Result<(), ChainError> {
+        let budget = self.budget_ns.load(Ordering::Relaxed);
+        if budget != 0 && billed_ns > budget {
+            return Err(ChainError::TransactionError(format!(
+                "transaction CPU deadline exceeded: billed {}us of {}us wall-clock budget",
+                billed_ns / 1_000,
+                budget / 1_000
+            )));
+        }
+        Ok(())
+    }
 }
 
 pub struct TransactionResult {
     pub trace: TransactionTrace,
     pub billed_cpu_time_us: u32,
     pub action_receipt_digests: VecDeque<Digest>,
+    /// Sequence shadow after this transaction's increments; taken by
+    /// `Controller::execute_transaction_with_keys` as the shadow the next
+    /// transaction continues from. A failed transaction never reaches
+    /// `finalize`, so its increments die with its undo session.
+    pub sequence_counters: SequenceCounters,
 }
 
 struct TransactionContextInner {
     initialized: bool,
     trace: TransactionTrace,
     bill_to_account: Option<Name>,
-    validate_ram_usage: BTreeSet<Name>,
-    explicit_billed_cpu_time: bool,
-    billing: Billing,
+    // RAM deltas accumulated Rust-side over the whole transaction and
+    // applied to chainbase in one pass at `finalize`; see `add_ram_usage`.
+    pending_ram_deltas: BTreeMap<Name, i64>,
     pending_block_timestamp: BlockTimestamp,
     cpu_limit: i64,
     executed_action_receipt_digests: VecDeque<Digest>,
     is_input: bool,
+    // Account-metadata addresses memoized for this transaction's lifetime;
+    // see `cached_account_metadata`.
+    account_metadata_cache: BTreeMap<u64, usize>,
+    // Last large inline-action payload scheduled; see `memoize_action_data`.
+    inline_data_memo: Option<Arc<[u8]>>,
+    // Stateful host calls issued across every action of this transaction,
+    // folded in from each action's apply context; lands in the
+    // slow-transaction record at `finalize`.
+    host_calls: u64,
+    // Action sequence counters, incremented Rust-side instead of through
+    // per-receipt chainbase modifies; starts as a clone of the block-level
+    // shadow and moves into the result at `finalize`.
+    sequence_counters: SequenceCounters,
 }
 
 #[derive(Clone)]
@@ -52,6 +177,7 @@ pub struct TransactionContext {
     wasm_runtime: WasmRuntime,
     block_status: BlockStatus,
     packed_transaction: PackedTransaction,
+    billing: Arc<BillingTimer>,
     inner: Arc<RwLock<TransactionContextInner>>,
 }
 
@@ -64,6 +190,7 @@ impl TransactionContext {
         transaction_id: &Id,
         block_status: BlockStatus,
         packed_transaction: PackedTransaction,
+        sequence_counters: SequenceCounters,
     ) -> Self {
         let mut trace = TransactionTrace::default();
         trace.id = *transaction_id;
@@ -74,21 +201,20 @@ impl TransactionContext {
             db,
             wasm_runtime,
             block_status,
+            billing: Arc::new(BillingTimer::new()),
             inner: Arc::new(RwLock::new(TransactionContextInner {
                 initialized: false,
                 trace,
                 bill_to_account: None,
-                validate_ram_usage: BTreeSet::new(),
-                explicit_billed_cpu_time: false,
-                billing: Billing {
-                    paused_time: TimePoint::default(),
-                    pseudo_start: TimePoint::now(),
-                    billed_time: Microseconds::default(),
-                },
+                pending_ram_deltas: BTreeMap::new(),
                 pending_block_timestamp,
                 cpu_limit: 0,
                 executed_action_receipt_digests: VecDeque::with_capacity(6),
                 is_input: false,
+                account_metadata_cache: BTreeMap::new(),
+                inline_data_memo: None,
+                host_calls: 0,
+                sequence_counters,
             })),
             packed_transaction,
         }
@@ -121,19 +247,15 @@ impl TransactionContext {
             let first_authorizer_name = Name::new(authorizer);
             inner.bill_to_account = Some(first_authorizer_name.clone());
 
-            let (cpu_limit, _) = ResourceLimitsManager::get_account_cpu_limit(
-                &self.db,
-                &first_authorizer_name,
-                Some(1000),
-            )?;
-            inner.cpu_limit = cpu_limit;
-
-            // Update usage values of accounts to reflect new time
-            ResourceLimitsManager::update_account_usage(
+            // Read the objective cpu limit and refresh the account's usage
+            // window to the pending slot in one FFI crossing.
+            let (cpu_limit, _) = ResourceLimitsManager::update_account_usage_and_get_cpu_limit(
                 &mut self.db,
                 &first_authorizer_name,
                 inner.pending_block_timestamp.slot(),
+                Some(1000),
             )?;
+            inner.cpu_limit = cpu_limit;
         }
 
         Ok(())
@@ -144,6 +266,7 @@ impl TransactionContext {
         packed_trx_unprunable_size: u64,
         packed_trx_prunable_size: u64,
         transaction: &Transaction,
+        auths_already_checked: bool,
     ) -> Result<(), ChainError> {
         let mut discounted_size_for_pruned_data = packed_trx_prunable_size;
         let global_properties = unsafe { &*self.db.get_global_properties()? };
@@ -165,8 +288,16 @@ impl TransactionContext {
             + discounted_size_for_pruned_data;
         let first_authorizer = transaction.first_authorizer();
 
+        // Arm the wall-clock deadline from the chain's per-transaction CPU
+        // ceiling; it is enforced on the billing pause/resume boundaries.
+        self.billing
+            .set_budget_us(chain_config.get_max_transaction_cpu_usage() as u64);
+
         self.validate_expiration(self.packed_transaction.get_transaction())?;
-        self.validate_referenced_accounts(self.packed_transaction.get_transaction())?;
+        self.validate_referenced_accounts(
+            self.packed_transaction.get_transaction(),
+            auths_already_checked,
+        )?;
         self.init(initial_net_usage, first_authorizer, true)?;
         self.record_transaction(
             &transaction.id()?,
@@ -247,23 +378,33 @@ impl TransactionContext {
         creator_action_ordinal: u32,
         closest_unnotified_ancestor_action_ordinal: u32,
     ) -> Result<u32, ChainError> {
-        let (trx_id, block_num, block_time, new_action_ordinal) = {
-            let inner = self.inner.read()?;
-            (
-                inner.trace.id,
-                inner.trace.block_num,
-                inner.trace.block_time.clone(),
-                inner.trace.action_traces.len() as u32 + 1,
-            )
-        };
-
-        let provided = self.get_action_trace(action_ordinal)?;
+        // One lock scope for the whole schedule: notification fan-out runs
+        // this once per recipient, and separate read/read/write acquisitions
+        // showed up on transactions with hundreds of inline actions.
         let mut inner = self.inner.write()?;
+        let (trx_id, block_num, block_time) = (
+            inner.trace.id,
+            inner.trace.block_num,
+            inner.trace.block_time.clone(),
+        );
+        let new_action_ordinal = inner.trace.action_traces.len() as u32 + 1;
+
+        // Only the action itself is needed from the provided trace; cloning
+        // the whole ActionTrace would also copy its console and receipt.
+        let act = match inner.trace.action_traces.get(action_ordinal as usize - 1) {
+            Some(t) => t.action().clone(),
+            None => {
+                return Err(ChainError::TransactionError(format!(
+                    "failed to get action trace by ordinal {}",
+                    action_ordinal
+                )));
+            }
+        };
         inner.trace.action_traces.push(ActionTrace::new(
             trx_id,
             block_num,
             block_time,
-            provided.action().clone(),
+            act,
             receiver.clone(),
             context_free,
             new_action_ordinal,
@@ -288,8 +429,8 @@ impl TransactionContext {
             self.db.clone(),
             self.wasm_runtime.clone(),
             self.clone(),
-            action.clone(),
-            receiver.clone(),
+            action,
+            receiver,
             action_ordinal,
             recurse_depth,
             self.get_cpu_limit()?,
@@ -299,15 +440,74 @@ impl TransactionContext {
         // Initialize the apply context with the action trace.
         let cpu_used = apply_context.exec(self)?;
         self.add_cpu_usage(cpu_used)?;
+        self.inner.write()?.host_calls += apply_context.host_calls()?;
 
         // Finalize the apply context
         for (account, ram_delta) in apply_context.account_ram_deltas()?.iter() {
             self.add_ram_usage(account, *ram_delta)?;
         }
 
+        // Hand the context's containers back for the next action; a failed
+        // action skips this and simply drops them.
+        apply_context.recycle()?;
+
         Ok(())
     }
 
+    /// Account-metadata lookup memoized for this transaction's lifetime.
+    /// Within one transaction chainbase only modifies these objects in place
+    /// (accounts are never destroyed, and undo unwinds after execution has
+    /// finished), so a cached address stays both valid and current — setcode
+    /// or sequence bumps are visible through it. A fan-out of inline actions
+    /// to one receiver then crosses the FFI once instead of once per action.
+    /// The cache cannot outlive the objects: pointers from a discarded
+    /// speculative session die with the context that cached them.
+    pub fn cached_account_metadata(
+        &self,
+        account: u64,
+    ) -> Result<&'static AccountMetadataObject, ChainError> {
+        {
+            let inner = self.inner.read()?;
+            if let Some(addr) = inner.account_metadata_cache.get(&account) {
+                return Ok(unsafe { &*(*addr as *const AccountMetadataObject) });
+            }
+        }
+        let meta = self.db.get_account_metadata(account)?;
+        let mut inner = self.inner.write()?;
+        inner
+            .account_metadata_cache
+            .insert(account, meta as *const AccountMetadataObject as usize);
+        Ok(meta)
+    }
+
+    /// Deduplicates large inline-action payloads against the last one
+    /// scheduled. `send_inline` unpacks every inline action out of wasm
+    /// memory into a fresh allocation, so a fan-out contract resending the
+    /// same blob to hundreds of receivers carries hundreds of identical
+    /// buffers through the schedule, traces and receipts. Handing back the
+    /// memoized `Arc` lets all of those copies share one allocation. One
+    /// slot is enough for the repeated-payload pattern, and payloads below
+    /// [`INLINE_DATA_MEMO_MIN`] are not worth the compare.
+    pub fn memoize_action_data(&self, data: Arc<[u8]>) -> Result<Arc<[u8]>, ChainError> {
+        if data.len() < INLINE_DATA_MEMO_MIN {
+            return Ok(data);
+        }
+        let mut inner = self.inner.write()?;
+        match &inner.inline_data_memo {
+            Some(cached) if **cached == *data => Ok(Arc::clone(cached)),
+            _ => {
+                inner.inline_data_memo = Some(Arc::clone(&data));
+                Ok(data)
+            }
+        }
+    }
+
+    /// Clones just the action out of a trace; cheap since the action payload
+    /// is reference-counted, unlike cloning the whole [`ActionTrace`].
+    pub fn get_action(&self, action_ordinal: u32) -> Result<Action, ChainError> {
+        self.with_action_trace(action_ordinal, |t| t.action().clone())
+    }
+
     pub fn get_action_trace(&self, action_ordinal: u32) -> Result<ActionTrace, ChainError> {
         let inner = self.inner.read()?;
         let trace = inner.trace.action_traces.get((action_ordinal as usize) - 1);
@@ -370,6 +570,46 @@ impl TransactionContext {
         Ok(inner.pending_block_timestamp.clone())
     }
 
+    pub fn block_status(&self) -> &BlockStatus {
+        &self.block_status
+    }
+
+    /// Next global action sequence, incremented in the Rust-side shadow;
+    /// the database is only read to seed the first action of the lineage.
+    pub fn next_global_sequence(&self) -> Result<u64, ChainError> {
+        let db = &self.db;
+        let mut inner = self.inner.write()?;
+        inner
+            .sequence_counters
+            .next_global_sequence(|| db.get_global_action_sequence())
+    }
+
+    /// Next receive sequence for `account`, whose metadata the caller has
+    /// already in hand (it seeds the shadow's first touch).
+    pub fn next_recv_sequence(
+        &self,
+        account: u64,
+        account_metadata: &AccountMetadataObject,
+    ) -> Result<u64, ChainError> {
+        let mut inner = self.inner.write()?;
+        Ok(inner
+            .sequence_counters
+            .next_recv_sequence(account, account_metadata.get_recv_sequence()))
+    }
+
+    /// Next authorization sequence for `account`; seeding as in
+    /// [`Self::next_recv_sequence`].
+    pub fn next_auth_sequence(
+        &self,
+        account: u64,
+        account_metadata: &AccountMetadataObject,
+    ) -> Result<u64, ChainError> {
+        let mut inner = self.inner.write()?;
+        Ok(inner
+            .sequence_counters
+            .next_auth_sequence(account, account_metadata.get_auth_sequence()))
+    }
+
     pub fn finalize(mut self) -> Result<TransactionResult, ChainError> {
         let mut inner = self.inner.write()?;
         let billed_cpu_time_us = inner.trace.receipt.cpu_usage_us;
@@ -394,8 +634,20 @@ impl TransactionContext {
             }
         }
 
-        for account in inner.validate_ram_usage.iter() {
-            ResourceLimitsManager::verify_account_ram_usage(&mut self.db, account)?;
+        // Apply the accumulated RAM deltas in one bridge crossing; the C++
+        // side skips zero deltas and limit-checks each account whose usage
+        // grew. A failed transaction never reaches this point, so its
+        // journal is simply dropped and undo never sees a usage write.
+        let ram_deltas: Vec<AccountRamDelta> = std::mem::take(&mut inner.pending_ram_deltas)
+            .iter()
+            .filter(|(_, delta)| **delta != 0)
+            .map(|(account, delta)| AccountRamDelta {
+                account: account.as_u64(),
+                delta: *delta,
+            })
+            .collect();
+        if !ram_deltas.is_empty() {
+            ResourceLimitsManager::apply_ram_usage_deltas(&mut self.db, &ram_deltas)?;
         }
 
         // During benchmarks this would throw an error because the accounts won't have enough CPU to cover the billed time, so we skip this step if we're benchmarking.
@@ -413,10 +665,46 @@ impl TransactionContext {
             )?;
         }
 
+        // Tail-latency telemetry: every pass lands in the per-transaction
+        // wall/cpu/net histograms, and one that crosses the slow threshold
+        // leaves its action chain and per-action timing in the ring behind
+        // `pulsevm.getSlowTransactions`. The billing anchor was set when the
+        // context was created, so its elapsed time is this pass's wall time.
+        let wall_us = self.billing.anchor.elapsed().as_micros() as u64;
+        METRICS.observe_transaction(wall_us, billed_cpu_time_us as u64, inner.trace.net_usage);
+        if SLOW_TRX_LOG.is_slow(wall_us) {
+            SLOW_TRX_LOG.record(SlowTransactionRecord {
+                trx_id: inner.trace.id,
+                block_num: inner.trace.block_num,
+                wall_us,
+                cpu_us: billed_cpu_time_us as u64,
+                net_bytes: inner.trace.net_usage,
+                host_calls: inner.host_calls,
+                actions_total: inner.trace.action_traces.len() as u32,
+                actions: inner
+                    .trace
+                    .action_traces
+                    .iter()
+                    .take(MAX_ACTIONS_PER_RECORD)
+                    .map(|t| SlowActionRecord {
+                        receiver: t.receiver().clone(),
+                        contract: t.action().account().clone(),
+                        action: t.action().name().clone(),
+                        elapsed_us: t.elapsed(),
+                    })
+                    .collect(),
+            });
+        }
+
+        // `finalize` consumes the context and nothing reads the trace or the
+        // digests through it afterwards (a pooled wasm session may still hold
+        // the inner alive, but never looks at it again), so both move into
+        // the result instead of being deep-cloned.
         Ok(TransactionResult {
-            trace: inner.trace.clone(),
+            trace: std::mem::take(&mut inner.trace),
             billed_cpu_time_us,
-            action_receipt_digests: inner.executed_action_receipt_digests.clone(),
+            action_receipt_digests: std::mem::take(&mut inner.executed_action_receipt_digests),
+            sequence_counters: std::mem::take(&mut inner.sequence_counters),
         })
     }
 
@@ -448,44 +736,31 @@ impl TransactionContext {
         Ok(())
     }
 
+    /// Accumulates the delta Rust-side; a busy transaction emits dozens of
+    /// tiny deltas for the same few accounts, and crossing the FFI for each
+    /// one is wasted traffic. The per-account totals hit chainbase once, at
+    /// `finalize`. Deferring is safe because nothing reads pending RAM
+    /// usage mid-transaction, and a failed transaction never finalizes.
     pub fn add_ram_usage(&mut self, account: &Name, ram_delta: i64) -> Result<(), ChainError> {
         let mut inner = self.inner.write()?;
 
-        ResourceLimitsManager::add_pending_ram_usage(&mut self.db, account, ram_delta)?;
-
-        if ram_delta > 0 {
-            inner.validate_ram_usage.insert(account.clone());
-        }
+        let entry = inner
+            .pending_ram_deltas
+            .entry(account.clone())
+            .or_insert(0);
+        *entry = entry.checked_add(ram_delta).ok_or_else(|| {
+            ChainError::ActionValidationError(format!("RAM usage overflow for account {}", account))
+        })?;
 
         Ok(())
     }
 
     pub fn pause_billing_timer(&self) -> Result<(), ChainError> {
-        let mut inner = self.inner.write()?;
-        if inner.explicit_billed_cpu_time {
-            return Ok(());
-        }
-        if inner.billing.pseudo_start == TimePoint::default() {
-            return Ok(());
-        }
-        inner.billing.paused_time = TimePoint::now();
-        inner.billing.billed_time = inner.billing.paused_time - inner.billing.pseudo_start;
-        inner.billing.pseudo_start = TimePoint::default();
-        Ok(())
+        self.billing.pause()
     }
 
     pub fn resume_billing_timer(&self) -> Result<(), ChainError> {
-        let mut inner = self.inner.write()?;
-        if inner.explicit_billed_cpu_time {
-            return Ok(());
-        }
-        if inner.billing.pseudo_start != TimePoint::default() {
-            return Ok(());
-        }
-        let now = TimePoint::now();
-        let _paused = now - inner.billing.paused_time; // if needed later
-        inner.billing.pseudo_start = now - inner.billing.billed_time;
-        Ok(())
+        self.billing.resume()
     }
 
     pub fn get_cpu_limit(&self) -> Result<i64, ChainError> {
@@ -493,6 +768,27 @@ impl TransactionContext {
         Ok(inner.cpu_limit)
     }
 
+    /// Caps a wasm dispatch's metering budget by the wall-clock budget left
+    /// on this transaction, converted through the calibrated
+    /// [`wasm_costs::METERING_POINTS_PER_US`] rate. The deadline timer only
+    /// fires on host-call boundaries; this bound covers the stretch between
+    /// them, so a contract that never leaves wasm (an endless compute loop)
+    /// exhausts its points at the deadline instead of running to the
+    /// account's full CPU allowance. The preemption itself stays in the
+    /// metering middleware — points run out and the instance traps — so no
+    /// thread ever has to interrupt a running store.
+    pub fn clamp_cpu_limit_to_deadline(&self, cpu_limit: i64) -> i64 {
+        let Some(remaining_us) = self.billing.remaining_budget_us() else {
+            return cpu_limit;
+        };
+        let cap = remaining_us
+            .saturating_mul(wasm_costs::METERING_POINTS_PER_US)
+            .min(i64::MAX as u64) as i64;
+        // A negative limit means "no account limit"; the deadline still
+        // applies.
+        if cpu_limit < 0 { cap } else { cpu_limit.min(cap) }
+    }
+
     pub fn record_transaction(&mut self, id: &Id, expiration: u32) -> Result<(), ChainError> {
         let id_digest = id.to_digest()?;
 
@@ -532,33 +828,66 @@ impl TransactionContext {
         Ok(())
     }
 
-    pub fn validate_referenced_accounts(&self, trx: &Transaction) -> Result<(), ChainError> {
-        if !trx.context_free_actions.is_empty() {
-            for action in trx.context_free_actions.iter() {
-                let code = self.db.find_account(action.account.as_u64())?;
-
-                if code.is_null() {
-                    return Err(ChainError::TransactionError(format!(
-                        "context free action {} references non-existent account {}",
-                        action.name(),
-                        action.account()
-                    )));
+    /// Every referenced account's existence is resolved in batched probes
+    /// (sorted unique names, one database lock per 64-name chunk, see
+    /// [`Database::accounts_exist`]) instead of a serial `find_account` per
+    /// reference; the per-action loops below then report errors in the same
+    /// order as before from the resolved set.
+    ///
+    /// When `auths_already_checked` is set, `check_authorization` resolved
+    /// every declared actor and permission for this transaction moments ago
+    /// (it runs first on all non-replay paths), so those are not re-fetched
+    /// here; only the code accounts are probed.
+    pub fn validate_referenced_accounts(
+        &self,
+        trx: &Transaction,
+        auths_already_checked: bool,
+    ) -> Result<(), ChainError> {
+        let mut referenced: Vec<u64> = Vec::new();
+        for action in trx.context_free_actions.iter() {
+            referenced.push(action.account.as_u64());
+        }
+        for action in trx.actions.iter() {
+            referenced.push(action.account.as_u64());
+            if !auths_already_checked {
+                for auth in action.authorization().iter() {
+                    referenced.push(auth.actor());
                 }
-
-                if action.authorization.len() > 0 {
-                    return Err(ChainError::TransactionError(format!(
-                        "context-free actions cannot have authorizations"
-                    )));
+            }
+        }
+        referenced.sort_unstable();
+        referenced.dedup();
+
+        let mut existing: HashSet<u64> = HashSet::with_capacity(referenced.len());
+        for chunk in referenced.chunks(64) {
+            let mask = self.db.accounts_exist(chunk)?;
+            for (i, name) in chunk.iter().enumerate() {
+                if mask & (1u64 << i) != 0 {
+                    existing.insert(*name);
                 }
             }
         }
 
+        for action in trx.context_free_actions.iter() {
+            if !existing.contains(&action.account.as_u64()) {
+                return Err(ChainError::TransactionError(format!(
+                    "context free action {} references non-existent account {}",
+                    action.name(),
+                    action.account()
+                )));
+            }
+
+            if action.authorization.len() > 0 {
+                return Err(ChainError::TransactionError(format!(
+                    "context-free actions cannot have authorizations"
+                )));
+            }
+        }
+
         let mut one_auth = false;
 
         for action in trx.actions.iter() {
-            let code = self.db.find_account(action.account.as_u64())?;
-
-            if code.is_null() {
+            if !existing.contains(&action.account.as_u64()) {
                 return Err(ChainError::TransactionError(format!(
                     "action {} references non-existent account {}",
                     action.name(),
@@ -568,9 +897,11 @@ impl TransactionContext {
 
             for auth in action.authorization().iter() {
                 one_auth = true;
-                let actor = self.db.find_account(auth.actor())?;
+                if auths_already_checked {
+                    continue;
+                }
 
-                if actor.is_null() {
+                if !existing.contains(&auth.actor()) {
                     return Err(ChainError::TransactionError(format!(
                         "action's authorizing actor '{}' does not exist",
                         Name::new(auth.actor)
@@ -0,0 +1,214 @@
+//! Deterministic wasm operator cost table for CPU metering.
+//!
+//! Costs are expressed in abstract metering units, where one unit is the
+//! measured cost of a simple ALU operation (`i64.add`) on the reference
+//! hosts. The table is versioned: any repricing bumps
+//! `WASM_COST_TABLE_VERSION`, and because metering charges feed CPU billing
+//! and the elastic resource limits, a version bump is a consensus-affecting
+//! change that must roll out with a protocol upgrade, not a quiet rebuild.
+//!
+//! The numbers are produced by the calibration harness in [`calibration`]
+//! (run via the `calibrate_wasm_costs` binary in `pulsevm_benchmark`), which
+//! micro-benchmarks one kernel per operator class through the same Cranelift
+//! backend the baseline execution tier uses and reports measured units next
+//! to the shipped cost. Version 2 repriced the classes that calibration
+//! showed far off wall time: `clz`/`ctz` are single instructions on every
+//! host we deploy on (was 105), integer division measures around twenty
+//! units (was 80), and calls carry more overhead than plain branches.
+
+use wasmer::wasmparser::Operator;
+
+/// Version of the shipped cost table; bump on any repricing.
+pub const WASM_COST_TABLE_VERSION: u32 = 2;
+
+/// Metering units the metered baseline tier executes per microsecond of wall
+/// clock on the slowest reference host, measured by the calibration harness
+/// alongside the per-operator costs. Used to convert a transaction's
+/// remaining wall-clock budget into a cap on the points handed to a wasm
+/// dispatch, so a pure compute loop exhausts its metering at the deadline
+/// instead of running to the account's full CPU allowance. Deliberately a
+/// floor: a host faster than this burns through the capped points before the
+/// wall deadline, never after it.
+pub const METERING_POINTS_PER_US: u64 = 1_000;
+
+// Per-class costs in metering units. One unit == one simple ALU op.
+const OP_DEFAULT: u64 = 1;
+const OP_DROP: u64 = 1;
+const OP_SELECT: u64 = 2;
+const OP_BRANCH: u64 = 2;
+const OP_BRANCH_IF: u64 = 3;
+const OP_CALL: u64 = 5;
+const OP_LOCAL: u64 = 1;
+const OP_GLOBAL: u64 = 2;
+const OP_MUL: u64 = 2;
+const OP_DIV: u64 = 20;
+const OP_BIT_SCAN: u64 = 1;
+// Length-dependent bulk-memory ops; priced conservatively for the small
+// copies contracts typically issue.
+const OP_BULK_MEMORY: u64 = 500;
+const OP_MEMORY_GROW: u64 = 1000;
+
+/// Metering cost of a single wasm operator. Passed to the `Metering`
+/// middleware of both compilation tiers, so charges are identical whichever
+/// tier executes the action.
+pub fn operator_cost(operator: &Operator) -> u64 {
+    match operator {
+        Operator::Drop => OP_DROP,
+        Operator::Select => OP_SELECT,
+        Operator::Br { .. } | Operator::BrTable { .. } | Operator::Return { .. } => OP_BRANCH,
+        Operator::Call { .. } | Operator::CallIndirect { .. } => OP_CALL,
+        Operator::BrIf { .. } => OP_BRANCH_IF,
+        Operator::GlobalGet { .. } | Operator::GlobalSet { .. } => OP_GLOBAL,
+        Operator::LocalGet { .. } | Operator::LocalSet { .. } | Operator::LocalTee { .. } => {
+            OP_LOCAL
+        }
+        Operator::I32Mul { .. }
+        | Operator::I64Mul { .. }
+        | Operator::F32Mul { .. }
+        | Operator::F64Mul { .. } => OP_MUL,
+        Operator::I32DivS { .. }
+        | Operator::I32DivU { .. }
+        | Operator::I32RemS { .. }
+        | Operator::I32RemU { .. }
+        | Operator::I64DivS { .. }
+        | Operator::I64DivU { .. }
+        | Operator::I64RemS { .. }
+        | Operator::I64RemU { .. } => OP_DIV,
+        Operator::I32Clz { .. }
+        | Operator::I64Clz { .. }
+        | Operator::I32Ctz { .. }
+        | Operator::I64Ctz { .. } => OP_BIT_SCAN,
+        Operator::MemoryCopy { .. } | Operator::MemoryFill { .. } => OP_BULK_MEMORY,
+        Operator::MemoryGrow { .. } => OP_MEMORY_GROW,
+        _ => OP_DEFAULT,
+    }
+}
+
+/// Micro-benchmark harness behind the shipped cost table. Each operator
+/// class gets a small wat kernel whose loop body repeats one operation unit;
+/// the harness times the kernel through the baseline Cranelift backend,
+/// nets out the loop scaffold with an empty-body kernel, and normalizes to
+/// the `i64.add` unit so measurements land in the same units as the table.
+pub mod calibration {
+    use std::time::Instant;
+
+    use pulsevm_error::ChainError;
+    use wasmer::{
+        Engine, Instance, Module, Store, TypedFunction, imports,
+        sys::{CompilerConfig, Cranelift, CraneliftOptLevel},
+    };
+
+    use super::*;
+
+    /// Times each operator class and pairs the measurement with the shipped
+    /// cost, so drift shows up as a ratio away from 1.
+    pub struct ClassMeasurement {
+        /// Operator class name as used in the cost table.
+        pub class: &'static str,
+        /// Cost the shipped table charges per operation of this class.
+        pub shipped_cost: u64,
+        /// Measured cost in table units (multiples of the `i64.add` unit).
+        pub measured_units: f64,
+    }
+
+    /// Loop iterations per timed call; together with the unroll factor this
+    /// keeps each kernel in the tens of milliseconds, long enough to swamp
+    /// the call overhead.
+    const ITERATIONS: i32 = 1_000_000;
+    /// Operation units per loop iteration.
+    const UNROLL: usize = 64;
+    /// Timed runs per kernel; the minimum is reported to shed scheduler
+    /// noise.
+    const RUNS: usize = 5;
+
+    // One operation unit per class. Operands are loop-carried locals so the
+    // compiler cannot fold the unit away; the divisor local stays nonzero.
+    const CLASSES: &[(&str, u64, &str)] = &[
+        ("default (i64.add)", OP_DEFAULT, "(local.set $a (i64.add (local.get $a) (local.get $b)))"),
+        ("drop", OP_DROP, "(drop (local.get $a))"),
+        ("select", OP_SELECT, "(local.set $a (select (local.get $a) (local.get $b) (i32.const 1)))"),
+        ("br_if (not taken)", OP_BRANCH_IF, "(block $skip (br_if $skip (i32.eqz (local.get $n))))"),
+        ("local.get/set", OP_LOCAL, "(local.set $a (local.get $a))"),
+        ("global.get/set", OP_GLOBAL, "(global.set $g (global.get $g))"),
+        ("i64.mul", OP_MUL, "(local.set $a (i64.mul (local.get $a) (local.get $b)))"),
+        ("i64.div_u", OP_DIV, "(local.set $a (i64.div_u (local.get $a) (local.get $b)))"),
+        ("i64.clz", OP_BIT_SCAN, "(local.set $a (i64.clz (local.get $a)))"),
+        ("memory.copy (64B)", OP_BULK_MEMORY, "(memory.copy (i32.const 0) (i32.const 4096) (i32.const 64))"),
+        ("memory.fill (64B)", OP_BULK_MEMORY, "(memory.fill (i32.const 0) (i32.const 0) (i32.const 64))"),
+    ];
+
+    fn kernel(body_unit: &str) -> String {
+        let body = body_unit.repeat(UNROLL);
+        format!(
+            "(module
+              (memory 1)
+              (global $g (mut i64) (i64.const 1))
+              (func (export \"run\") (param $n i32)
+                (local $a i64)
+                (local $b i64)
+                (local.set $a (i64.const 123456789))
+                (local.set $b (i64.const 3))
+                (block $exit
+                  (loop $top
+                    (br_if $exit (i32.eqz (local.get $n)))
+                    {body}
+                    (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+                    (br $top)))))"
+        )
+    }
+
+    // Same compiler and optimization level as the baseline execution tier,
+    // but without metering: the point is the raw cost metering should model.
+    fn calibration_engine() -> Engine {
+        let mut compiler = Cranelift::default();
+        compiler.opt_level(CraneliftOptLevel::Speed);
+        Engine::from(compiler)
+    }
+
+    /// Nanoseconds per operation unit for one kernel (scaffold included).
+    fn time_kernel(body_unit: &str) -> Result<f64, ChainError> {
+        let wat = kernel(body_unit);
+        let wasm =
+            wat::parse_str(&wat).map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
+        let mut store = Store::new(calibration_engine());
+        let module = Module::new(&store, &wasm)
+            .map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
+        let instance = Instance::new(&mut store, &module, &imports! {})
+            .map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
+        let run: TypedFunction<i32, ()> = instance
+            .exports
+            .get_typed_function(&store, "run")
+            .map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
+
+        // Warm-up run so compilation and paging costs stay out of the timing.
+        run.call(&mut store, ITERATIONS)
+            .map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
+
+        let mut best = f64::INFINITY;
+        for _ in 0..RUNS {
+            let start = Instant::now();
+            run.call(&mut store, ITERATIONS)
+                .map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
+            let elapsed = start.elapsed().as_nanos() as f64;
+            best = best.min(elapsed / (ITERATIONS as f64 * UNROLL as f64));
+        }
+        Ok(best)
+    }
+
+    /// Runs every class kernel and reports measurements in table units.
+    pub fn calibrate() -> Result<Vec<ClassMeasurement>, ChainError> {
+        let scaffold = time_kernel("")?;
+        let default_unit = (time_kernel(CLASSES[0].2)? - scaffold).max(f64::MIN_POSITIVE);
+
+        let mut measurements = Vec::with_capacity(CLASSES.len());
+        for (class, shipped_cost, body_unit) in CLASSES {
+            let net = (time_kernel(body_unit)? - scaffold).max(0.0);
+            measurements.push(ClassMeasurement {
+                class,
+                shipped_cost: *shipped_cost,
+                measured_units: net / default_unit,
+            });
+        }
+        Ok(measurements)
+    }
+}
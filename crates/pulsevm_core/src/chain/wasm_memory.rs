@@ -0,0 +1,423 @@
+use std::{
+    cell::UnsafeCell,
+    collections::HashMap,
+    ptr::NonNull,
+    sync::{Arc, LazyLock, Mutex},
+};
+
+use wasmer::{
+    MemoryError, MemoryType, Pages, TableType, Target,
+    sys::{
+        BaseTunables, Tunables,
+        vm::{
+            LinearMemory, MaybeInstanceOwned, MemoryStyle, Mmap, MmapType, TableStyle, VMMemory,
+            VMMemoryDefinition, VMTable, VMTableDefinition,
+        },
+    },
+};
+
+// Upper bound on idle regions held by the pool. Each entry is mostly
+// address-space reservation — `recycle` drops the resident pages — so the
+// cap is about not hoarding virtual memory for contracts that fell out of
+// the code cache, not about RSS.
+const MAX_POOLED_MEMORIES: usize = 32;
+
+/// Process-wide pool of linear-memory mappings, shared by every engine the
+/// wasm runtime creates.
+pub static WASM_MEMORY_POOL: LazyLock<Arc<WasmMemoryPool>> =
+    LazyLock::new(|| Arc::new(WasmMemoryPool::new()));
+
+struct PooledRegion {
+    mmap: Mmap,
+    // High-water mark of bytes ever made accessible in this mapping. The
+    // pages up to here are read-write but madvised away, so they read as
+    // zero and cost nothing until touched again.
+    accessible: usize,
+}
+
+/// Recycles the mmap regions behind contract linear memories.
+///
+/// Creating a fresh instance memory costs a multi-gigabyte reservation
+/// (`mmap`), committing the minimum pages (`mprotect`), and — on drop — an
+/// `munmap` with its TLB shootdown. Recycled regions instead get one
+/// `madvise(MADV_DONTNEED)`, which resets their pages to zero-fill-on-demand
+/// without touching the reservation, so per-action memory setup is reduced
+/// to page-table operations. Regions are keyed by total mapping size; with
+/// the default tunables every contract memory shares one size class, so the
+/// pool naturally tracks the working set of concurrently executing code.
+///
+/// NUMA: recycled regions keep their page-table placement, and anonymous
+/// pages land on the node that first touches them — so when the execution
+/// threads are pinned (`NodeConfig::exec_cpu_affinity`), the pool's
+/// regions settle node-local without any explicit placement here.
+pub struct WasmMemoryPool {
+    regions: Mutex<HashMap<usize, Vec<PooledRegion>>>,
+}
+
+impl WasmMemoryPool {
+    fn new() -> Self {
+        Self {
+            regions: Mutex::new(HashMap::new()),
+        }
+    }
+
+    fn take(&self, total_size: usize) -> Option<PooledRegion> {
+        let mut regions = self.regions.lock().ok()?;
+        regions.get_mut(&total_size).and_then(|slots| slots.pop())
+    }
+
+    fn recycle(&self, mmap: Mmap, accessible: usize) {
+        if mmap.len() == 0 {
+            return;
+        }
+        // Lazily zero the used pages: anonymous private memory reads as
+        // zero after MADV_DONTNEED, which is what a fresh instantiation
+        // needs and what the wasm spec requires of new memories. If the
+        // kernel refuses we cannot reuse the region, so let it unmap.
+        #[cfg(target_family = "unix")]
+        {
+            let dropped = accessible > 0 && unsafe {
+                libc::madvise(
+                    mmap.as_ptr() as *mut libc::c_void,
+                    accessible,
+                    libc::MADV_DONTNEED,
+                ) != 0
+            };
+            if dropped {
+                return;
+            }
+            let Ok(mut regions) = self.regions.lock() else {
+                return;
+            };
+            let pooled: usize = regions.values().map(|slots| slots.len()).sum();
+            if pooled >= MAX_POOLED_MEMORIES {
+                return;
+            }
+            regions
+                .entry(mmap.len())
+                .or_default()
+                .push(PooledRegion { mmap, accessible });
+        }
+        #[cfg(not(target_family = "unix"))]
+        {
+            let _ = (mmap, accessible);
+        }
+    }
+}
+
+/// A static-style linear memory whose backing mapping is drawn from and
+/// returned to [`WasmMemoryPool`]. Behaves like wasmer's own owned memory:
+/// the base pointer never moves, growth makes reserved pages accessible,
+/// and out-of-bounds accesses trap on the guard region.
+struct PooledLinearMemory {
+    mmap: Mmap,
+    // Bytes made accessible so far; never shrinks, so a recycled region
+    // skips the mprotect for any extent it has already paid for.
+    accessible: usize,
+    size: Pages,
+    ty: MemoryType,
+    style: MemoryStyle,
+    vm_memory_definition: MaybeInstanceOwned<VMMemoryDefinition>,
+    pool: Arc<WasmMemoryPool>,
+}
+
+// Same justification as wasmer's own memories: the raw pointers are only
+// dereferenced by wasm code and by the store that owns this memory.
+unsafe impl Send for PooledLinearMemory {}
+unsafe impl Sync for PooledLinearMemory {}
+
+impl std::fmt::Debug for PooledLinearMemory {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("PooledLinearMemory")
+            .field("size", &self.size)
+            .field("accessible", &self.accessible)
+            .field("ty", &self.ty)
+            .field("style", &self.style)
+            .finish_non_exhaustive()
+    }
+}
+
+impl PooledLinearMemory {
+    /// Builds a memory for `ty`, reusing a pooled mapping of the right size
+    /// when one is available. `vm_definition_location`, when given, points
+    /// into the owning instance's `VMContext` and receives the base pointer
+    /// and length the generated code reads.
+    unsafe fn new(
+        ty: &MemoryType,
+        style: &MemoryStyle,
+        vm_definition_location: Option<NonNull<VMMemoryDefinition>>,
+        pool: Arc<WasmMemoryPool>,
+    ) -> Result<Self, MemoryError> {
+        let (bound, offset_guard_size) = match style {
+            MemoryStyle::Static {
+                bound,
+                offset_guard_size,
+            } => (*bound, *offset_guard_size as usize),
+            MemoryStyle::Dynamic { .. } => {
+                return Err(MemoryError::InvalidMemory {
+                    reason: "the memory pool only backs static-style memories".to_string(),
+                });
+            }
+        };
+        if ty.minimum > bound {
+            return Err(MemoryError::MinimumMemoryTooLarge {
+                min_requested: ty.minimum,
+                max_allowed: bound,
+            });
+        }
+
+        let min_bytes = ty.minimum.bytes().0;
+        let total_size = bound.bytes().0 + offset_guard_size;
+
+        let (mut mmap, mut accessible) = match pool.take(total_size) {
+            Some(region) => (region.mmap, region.accessible),
+            None => {
+                let mmap = Mmap::accessible_reserved(min_bytes, total_size, None, MmapType::Private)
+                    .map_err(MemoryError::Region)?;
+                (mmap, min_bytes)
+            }
+        };
+        if accessible < min_bytes {
+            mmap.make_accessible(accessible, min_bytes - accessible)
+                .map_err(MemoryError::Region)?;
+            accessible = min_bytes;
+        }
+
+        let base = mmap.as_mut_ptr();
+        let vm_memory_definition = match vm_definition_location {
+            Some(ptr) => unsafe {
+                let md = ptr.as_ptr();
+                (*md).base = base;
+                (*md).current_length = min_bytes;
+                MaybeInstanceOwned::Instance(ptr)
+            },
+            None => MaybeInstanceOwned::Host(Box::new(UnsafeCell::new(VMMemoryDefinition {
+                base,
+                current_length: min_bytes,
+            }))),
+        };
+
+        Ok(Self {
+            mmap,
+            accessible,
+            size: ty.minimum,
+            ty: *ty,
+            style: *style,
+            vm_memory_definition,
+            pool,
+        })
+    }
+
+    fn bound(&self) -> Pages {
+        match self.style {
+            MemoryStyle::Static { bound, .. } => bound,
+            MemoryStyle::Dynamic { .. } => unreachable!("only static memories are pooled"),
+        }
+    }
+
+    fn set_length(&mut self, len: usize) {
+        unsafe {
+            let mut md_ptr = self.vm_memory_definition.as_ptr();
+            let md = md_ptr.as_mut();
+            md.current_length = len;
+        }
+    }
+}
+
+impl LinearMemory for PooledLinearMemory {
+    fn ty(&self) -> MemoryType {
+        let mut out = self.ty;
+        out.minimum = self.size;
+        out
+    }
+
+    fn size(&self) -> Pages {
+        self.size
+    }
+
+    fn style(&self) -> MemoryStyle {
+        self.style
+    }
+
+    fn grow(&mut self, delta: Pages) -> Result<Pages, MemoryError> {
+        if delta.0 == 0 {
+            return Ok(self.size);
+        }
+
+        let new_pages = self
+            .size
+            .checked_add(delta)
+            .ok_or(MemoryError::CouldNotGrow {
+                current: self.size,
+                attempted_delta: delta,
+            })?;
+        let maximum = self.ty.maximum.unwrap_or_else(|| self.bound());
+        if new_pages > maximum || new_pages > self.bound() {
+            return Err(MemoryError::CouldNotGrow {
+                current: self.size,
+                attempted_delta: delta,
+            });
+        }
+
+        let new_bytes = new_pages.bytes().0;
+        if new_bytes > self.accessible {
+            // A recycled region may already have these pages read-write
+            // from a previous life; then this branch is skipped entirely.
+            self.mmap
+                .make_accessible(self.accessible, new_bytes - self.accessible)
+                .map_err(MemoryError::Region)?;
+            self.accessible = new_bytes;
+        }
+
+        let prev_pages = self.size;
+        self.size = new_pages;
+        self.set_length(new_bytes);
+        Ok(prev_pages)
+    }
+
+    fn grow_at_least(&mut self, min_size: u64) -> Result<(), MemoryError> {
+        let cur_size = self.size.bytes().0 as u64;
+        if cur_size < min_size {
+            let growth = min_size - cur_size;
+            let delta = growth.div_ceil(wasmer::WASM_PAGE_SIZE as u64);
+            self.grow(Pages(delta as u32))?;
+        }
+        Ok(())
+    }
+
+    fn reset(&mut self) -> Result<(), MemoryError> {
+        self.size = Pages(0);
+        self.set_length(0);
+        Ok(())
+    }
+
+    fn vmmemory(&self) -> NonNull<VMMemoryDefinition> {
+        self.vm_memory_definition.as_ptr()
+    }
+
+    fn try_clone(&self) -> Result<Box<dyn LinearMemory + Send + Sync + 'static>, MemoryError> {
+        Err(MemoryError::InvalidMemory {
+            reason: "pooled memories cannot be cloned".to_string(),
+        })
+    }
+
+    fn copy(&self) -> Result<Box<dyn LinearMemory + Send + Sync + 'static>, MemoryError> {
+        Err(MemoryError::InvalidMemory {
+            reason: "pooled memories cannot be copied".to_string(),
+        })
+    }
+}
+
+impl Drop for PooledLinearMemory {
+    fn drop(&mut self) {
+        // The owning store is going away, so nothing references the mapping
+        // any more; hand it back instead of letting it unmap.
+        let mmap = std::mem::replace(&mut self.mmap, Mmap::new());
+        self.pool.recycle(mmap, self.accessible);
+    }
+}
+
+impl From<PooledLinearMemory> for VMMemory {
+    fn from(mem: PooledLinearMemory) -> Self {
+        Self(Box::new(mem))
+    }
+}
+
+/// [`BaseTunables`] with memory creation routed through [`WasmMemoryPool`].
+/// Styles, tables and limits are the defaults for the host target; only
+/// non-shared static memories (every contract memory on 64-bit) take the
+/// pooled path, anything else falls through to the stock allocator.
+pub struct PooledTunables {
+    base: BaseTunables,
+    pool: Arc<WasmMemoryPool>,
+}
+
+impl PooledTunables {
+    /// Tunables over the process-wide memory pool, for attaching to a
+    /// freshly built engine.
+    pub fn shared() -> Self {
+        Self {
+            base: BaseTunables::for_target(&Target::default()),
+            pool: Arc::clone(&WASM_MEMORY_POOL),
+        }
+    }
+}
+
+impl Tunables for PooledTunables {
+    fn memory_style(&self, memory: &MemoryType) -> MemoryStyle {
+        self.base.memory_style(memory)
+    }
+
+    fn table_style(&self, table: &TableType) -> TableStyle {
+        self.base.table_style(table)
+    }
+
+    fn create_host_memory(
+        &self,
+        ty: &MemoryType,
+        style: &MemoryStyle,
+    ) -> Result<VMMemory, MemoryError> {
+        if ty.shared || !matches!(style, MemoryStyle::Static { .. }) {
+            return self.base.create_host_memory(ty, style);
+        }
+        let memory =
+            unsafe { PooledLinearMemory::new(ty, style, None, Arc::clone(&self.pool))? };
+        Ok(memory.into())
+    }
+
+    unsafe fn create_vm_memory(
+        &self,
+        ty: &MemoryType,
+        style: &MemoryStyle,
+        vm_definition_location: NonNull<VMMemoryDefinition>,
+    ) -> Result<VMMemory, MemoryError> {
+        unsafe {
+            if ty.shared || !matches!(style, MemoryStyle::Static { .. }) {
+                return self.base.create_vm_memory(ty, style, vm_definition_location);
+            }
+            let memory = PooledLinearMemory::new(
+                ty,
+                style,
+                Some(vm_definition_location),
+                Arc::clone(&self.pool),
+            )?;
+            Ok(memory.into())
+        }
+    }
+
+    fn create_host_table(&self, ty: &TableType, style: &TableStyle) -> Result<VMTable, String> {
+        self.base.create_host_table(ty, style)
+    }
+
+    unsafe fn create_vm_table(
+        &self,
+        ty: &TableType,
+        style: &TableStyle,
+        vm_definition_location: NonNull<VMTableDefinition>,
+    ) -> Result<VMTable, String> {
+        unsafe { self.base.create_vm_table(ty, style, vm_definition_location) }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_recycled_region_reads_as_zero() {
+        let pool = WasmMemoryPool::new();
+        let size = 4 * wasmer::WASM_PAGE_SIZE;
+
+        let mut mmap = Mmap::with_at_least(size).unwrap();
+        mmap.as_mut_slice()[..4].copy_from_slice(&[1, 2, 3, 4]);
+        let total = mmap.len();
+
+        pool.recycle(mmap, size);
+        let region = pool.take(total).expect("region should have been pooled");
+        assert_eq!(region.accessible, size);
+        assert_eq!(&region.mmap.as_slice()[..4], &[0, 0, 0, 0]);
+
+        // The pool is empty again after the take.
+        assert!(pool.take(total).is_none());
+    }
+}
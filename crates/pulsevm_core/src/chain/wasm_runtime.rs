@@ -1,14 +1,19 @@
 use std::{
-    num::NonZeroUsize,
+    collections::{HashMap, HashSet},
+    fs,
+    path::{Path, PathBuf},
     sync::{Arc, RwLock},
+    thread,
 };
 
 use lru::LruCache;
 use pulsevm_crypto::Bytes;
+use spdlog::warn;
 use pulsevm_error::ChainError;
 use pulsevm_ffi::{BlockTimestamp, CxxDigest, Database};
 use wasmer::{
-    Engine, Function, FunctionEnv, Instance, Memory, Module, Store, imports, sys::CompilerConfig,
+    Engine, Function, FunctionEnv, Global, Imports, Instance, Memory, Module, Store, imports,
+    sys::{CompilerConfig, Cranelift, CraneliftOptLevel, NativeEngineExt},
     wasmparser::Operator,
 };
 use wasmer_compiler_llvm::{LLVM, LLVMOptLevel};
@@ -20,8 +25,11 @@ use wasmer_middlewares::{
 use crate::chain::{
     apply_context::ApplyContext,
     id::Id,
+    metrics::METRICS,
     name::Name,
     transaction::Action,
+    wasm_costs,
+    wasm_memory::PooledTunables,
     webassembly::{
         __addtf3, __ashlti3, __ashrti3, __cmptf2, __divtf3, __divti3, __eqtf2, __extenddftf2,
         __extendsftf2, __fixdfti, __fixsfti, __fixtfdi, __fixtfsi, __fixtfti, __fixunsdfti,
@@ -29,7 +37,7 @@ use crate::chain::{
         __floattidf, __floatunditf, __floatunsitf, __floatuntidf, __getf2, __gttf2, __letf2,
         __lshlti3, __lshrti3, __lttf2, __modti3, __multf3, __multi3, __negtf2, __netf2, __subtf3,
         __trunctfdf2, __trunctfsf2, __udivti3, __umodti3, __unordtf2, abort, assert_recover_key,
-        assert_ripemd160, assert_sha1, assert_sha224, assert_sha256, assert_sha512,
+        HashStream, assert_ripemd160, assert_sha1, assert_sha224, assert_sha256, assert_sha512,
         check_permission_authorization, check_transaction_authorization, current_time, db_end_i64,
         db_find_i64, db_get_i64, db_idx_double_end, db_idx_double_find_primary,
         db_idx_double_find_secondary, db_idx_double_lowerbound, db_idx_double_next,
@@ -44,11 +52,13 @@ use crate::chain::{
         db_idx128_next, db_idx128_previous, db_idx128_remove, db_idx128_store, db_idx128_update,
         db_idx128_upperbound, db_idx256_end, db_idx256_find_primary, db_idx256_find_secondary,
         db_idx256_lowerbound, db_idx256_next, db_idx256_previous, db_idx256_remove,
-        db_idx256_store, db_idx256_update, db_idx256_upperbound, db_lowerbound_i64, db_next_i64,
-        db_previous_i64, db_remove_i64, db_store_i64, db_update_i64, db_upperbound_i64,
+        db_idx256_store, db_idx256_update, db_idx256_upperbound, db_lowerbound_i64, db_multi_get, db_next_i64,
+        db_prefetch_range, db_previous_i64, db_remove_i64, db_store_i64, db_update_i64,
+        db_upperbound_i64,
         eosio_assert, expiration, get_account_creation_time, get_action, get_active_producers,
         get_blockchain_parameters_packed, get_context_free_data, get_permission_last_used,
-        get_resource_limits, is_privileged, memcmp, memcpy, memmove, memset, printdf, printhex,
+        get_resource_limits, hash_final, hash_init, hash_update, is_privileged, memcmp, memcpy,
+        memmove, memset, printdf, printhex,
         printi, printi128, printn, printqf, prints, prints_l, printsf, printui, printui128,
         pulse_assert, pulse_assert_code, pulse_assert_message, pulse_exit, read_action_data,
         read_transaction, recover_key, require_auth2, require_recipient, ripemd160,
@@ -59,7 +69,7 @@ use crate::chain::{
 };
 
 use super::webassembly::{
-    action_data_size, current_receiver, has_auth, is_account, require_auth, send_inline,
+    action_data_size, current_receiver, has_auth, is_account, read_only, require_auth, send_inline,
 };
 
 pub struct WasmContext {
@@ -69,7 +79,14 @@ pub struct WasmContext {
     context: ApplyContext,
     db: Database,
     memory: Option<Memory>,
+    // The Metering middleware's remaining-points global of the instance
+    // currently running on this env; captured after instantiation so host
+    // calls can sample in-flight gas (see `context_aware_check`).
+    metering_remaining: Option<Global>,
     return_value: Option<Bytes>,
+    // Open incremental hashing streams (see `HashStream` in
+    // webassembly/crypto.rs), indexed by the handle handed to the contract.
+    hash_streams: Vec<Option<HashStream>>,
 }
 
 impl WasmContext {
@@ -87,7 +104,9 @@ impl WasmContext {
             context,
             db,
             memory: None,
+            metering_remaining: None,
             return_value: None,
+            hash_streams: Vec::new(),
         }
     }
 
@@ -123,19 +142,194 @@ impl WasmContext {
         &self.memory
     }
 
+    pub fn metering_remaining(&self) -> &Option<Global> {
+        &self.metering_remaining
+    }
+
     pub fn set_action_return_value(&mut self, return_value: Bytes) {
         self.return_value = Some(return_value);
     }
+
+    pub fn hash_streams_mut(&mut self) -> &mut Vec<Option<HashStream>> {
+        &mut self.hash_streams
+    }
+
+    // Re-targets a pooled context at a new action so the host functions bound
+    // to this env (which live as long as the pooled store) can be reused
+    // across instantiations.
+    fn reset_for(
+        &mut self,
+        receiver: Name,
+        action: Action,
+        pending_block_timestamp: BlockTimestamp,
+        context: ApplyContext,
+        db: Database,
+    ) {
+        self.receiver = receiver.as_u64();
+        self.action = action;
+        self.pending_block_timestamp = pending_block_timestamp;
+        self.context = context;
+        self.db = db;
+        self.memory = None;
+        self.metering_remaining = None;
+        self.return_value = None;
+        // Streams never survive the action that opened them; keep the
+        // pool's capacity for the next one.
+        self.hash_streams.clear();
+    }
+}
+
+#[derive(Clone, Copy, PartialEq, Eq, Hash)]
+enum CompilationTier {
+    // Cranelift output, available almost immediately after setcode or on a
+    // cold cache; correct and fully metered, just slower to execute. A
+    // contract nobody dispatches again never leaves this tier, so one-shot
+    // deployments cost no LLVM time at all.
+    Baseline,
+    // LLVM output at default optimization, produced in the background once
+    // the dispatch count shows the contract is actually used.
+    Optimized,
+    // LLVM output at aggressive optimization: the tier for contracts whose
+    // dispatch frequency keeps climbing, recompiled in the background with
+    // the hit history as the profile and hot-swapped in. Loaded artifacts
+    // and the embedded system contracts enter here directly.
+    OptimizedHot,
+}
+
+impl CompilationTier {
+    // Promotion order; a background job only swaps its module in over a
+    // lower-ranked entry.
+    fn rank(self) -> u8 {
+        match self {
+            CompilationTier::Baseline => 0,
+            CompilationTier::Optimized => 1,
+            CompilationTier::OptimizedHot => 2,
+        }
+    }
 }
 
 #[derive(Clone)]
 struct CachedModule {
     module: Module,
     engine: Engine,
+    tier: CompilationTier,
+    // Byte weight charged against the cache budget: the on-chain wasm size
+    // for freshly compiled modules, the artifact file size for modules
+    // loaded from disk. The units are close enough for capacity control.
+    size_bytes: u64,
+    // Dispatches served from this entry since insertion; drives the
+    // eviction-time protection of frequently used contracts.
+    hits: u64,
 }
 
+// A reusable execution session: a store plus the full host-function import
+// set bound to it. Instantiating from a pooled session skips rebuilding the
+// ~150 typed host functions per action; every action still gets a fresh
+// Instance (and therefore fresh linear memory and globals), which is what
+// keeps reuse deterministic.
+struct ExecSession {
+    store: Store,
+    env: FunctionEnv<WasmContext>,
+    imports: Imports,
+    uses: u32,
+}
+
+// Stores keep every object created in them alive until the store is dropped,
+// so retire a session after this many instantiations.
+const MAX_SESSION_USES: u32 = 64;
+// Upper bound of idle sessions kept per (code hash, tier).
+const MAX_POOLED_SESSIONS: usize = 4;
+
+// Module cache byte budget until the node config overrides it.
+const DEFAULT_WASM_CACHE_MAX_BYTES: u64 = 1024 * 1024 * 1024;
+// An entry dispatched at least this often counts as a hot contract: when it
+// reaches the LRU tail during budget enforcement it is promoted back to the
+// front instead of evicted, so a spam deployer cycling throwaway contracts
+// churns around the hot set instead of through it.
+const PIN_HIT_THRESHOLD: u64 = 256;
+// Promotions allowed per enforcement sweep, so a sweep over a cache full of
+// hot entries still terminates and the budget is still enforced.
+const MAX_PIN_PROMOTES_PER_SWEEP: usize = 8;
+// Dispatches before a baseline contract earns a background LLVM build at
+// default optimization. Below this the Cranelift output is kept — most
+// contracts are deployed, poked a few times and never called again, and an
+// LLVM compile for those is pure waste.
+const OPTIMIZE_HIT_THRESHOLD: u64 = 16;
+// Dispatches before an optimized contract is recompiled at aggressive
+// optimization and hot-swapped. Reaching this count is the profile: only
+// the genuinely hot set — a handful of contracts on a busy chain — pays
+// the long O3 compile, and only those artifacts are persisted.
+const HOT_RECOMPILE_HIT_THRESHOLD: u64 = 1024;
+
 struct InnerWasmRuntime {
+    // Unbounded as far as the `lru` crate is concerned; capacity is the
+    // byte budget below, enforced by `cache_insert` after every insertion.
     code_cache: LruCache<Id, CachedModule>,
+    // Sum of `size_bytes` over the cached entries.
+    cache_bytes: u64,
+    cache_max_bytes: u64,
+    // Directory holding compiled module artifacts, keyed by code hash and
+    // wasmer version. Populated after every fresh compilation so a restarted
+    // node can mmap-deserialize hot contracts instead of recompiling them
+    // through LLVM.
+    artifact_dir: Option<PathBuf>,
+    // Code hashes with an LLVM recompilation currently running in the
+    // background, so repeated calls don't pile up duplicate jobs.
+    optimizing: HashSet<Id>,
+    // Idle execution sessions ready for reuse, keyed by code hash, tier (a
+    // session's store is tied to the engine that compiled the module) and
+    // whether the imports carry the read-only bindings.
+    session_pool: HashMap<(Id, CompilationTier, bool), Vec<ExecSession>>,
+}
+
+impl InnerWasmRuntime {
+    fn artifact_path(&self, id: &Id) -> Option<PathBuf> {
+        self.artifact_dir
+            .as_ref()
+            .map(|dir| dir.join(format!("{}-{}.wasmu", id, wasmer::VERSION)))
+    }
+
+    fn cache_insert(&mut self, id: Id, cached: CachedModule) {
+        self.cache_bytes += cached.size_bytes;
+        if let Some(prev) = self.code_cache.put(id, cached) {
+            self.cache_bytes -= prev.size_bytes;
+        }
+        self.enforce_cache_budget(Some(&id));
+    }
+
+    // Evicts least recently used modules until the byte budget holds again,
+    // promoting hot entries (see `PIN_HIT_THRESHOLD`) past the tail. `keep`
+    // — the entry just inserted — is never evicted, so a single module
+    // larger than the whole budget still runs.
+    fn enforce_cache_budget(&mut self, keep: Option<&Id>) {
+        let mut promotes = 0;
+        while self.cache_bytes > self.cache_max_bytes && self.code_cache.len() > 1 {
+            let (id, entry) = self.code_cache.pop_lru().unwrap();
+            if Some(&id) == keep {
+                self.code_cache.put(id, entry);
+                continue;
+            }
+            if entry.hits >= PIN_HIT_THRESHOLD && promotes < MAX_PIN_PROMOTES_PER_SWEEP {
+                promotes += 1;
+                self.code_cache.put(id, entry);
+                continue;
+            }
+            self.cache_bytes -= entry.size_bytes;
+            // The module's pooled sessions hold its engine alive; drop them
+            // with it.
+            self.session_pool.remove(&(id, entry.tier, false));
+            self.session_pool.remove(&(id, entry.tier, true));
+            METRICS.count_wasm_cache_eviction();
+        }
+        METRICS.set_wasm_cache_bytes(self.cache_bytes);
+    }
+}
+
+// System contract modules precompiled by build.rs from the wasm in
+// `reference_contracts/`; see `seed_embedded_modules`. The table is empty on
+// cross-compiled builds, where the artifacts could never deserialize.
+mod embedded {
+    include!(concat!(env!("OUT_DIR"), "/embedded_system_contracts.rs"));
 }
 
 #[derive(Clone)]
@@ -143,38 +337,249 @@ pub struct WasmRuntime {
     inner: Arc<RwLock<InnerWasmRuntime>>,
 }
 
-const COST_FUNCTION: fn(&Operator) -> u64 = |operator: &Operator| -> u64 {
-    match operator {
-        Operator::Drop => 2,
-        Operator::Select => 3,
-        Operator::Br { .. }
-        | Operator::BrTable { .. }
-        | Operator::Call { .. }
-        | Operator::CallIndirect { .. }
-        | Operator::Return { .. } => 2,
-        Operator::BrIf { .. } => 3,
-        Operator::GlobalGet { .. }
-        | Operator::GlobalSet { .. }
-        | Operator::LocalGet { .. }
-        | Operator::LocalSet { .. } => 3,
-        Operator::I32Mul { .. }
-        | Operator::I64Mul { .. }
-        | Operator::F32Mul { .. }
-        | Operator::F64Mul { .. } => 3,
-        Operator::I32DivS { .. }
-        | Operator::I32DivU { .. }
-        | Operator::I32RemS { .. }
-        | Operator::I32RemU { .. }
-        | Operator::I64DivS { .. }
-        | Operator::I64DivU { .. }
-        | Operator::I64RemS { .. }
-        | Operator::I64RemU { .. } => 80,
-        Operator::I32Clz { .. } | Operator::I64Clz { .. } => 105,
-        Operator::MemoryCopy { .. } | Operator::MemoryFill { .. } => 500,
-        Operator::MemoryGrow { .. } => 1000, // Higher cost for memory growth
-        _ => 1,                              // Default cost
+// Operator costs live in the versioned, calibrated table in `wasm_costs`;
+// both compilation tiers meter with the same function so charges are
+// identical whichever tier executes the action.
+const COST_FUNCTION: fn(&Operator) -> u64 = wasm_costs::operator_cost;
+
+// Builds the full host-function import set for a store. This creates ~150
+// typed functions and is the dominant cost of instantiation, which is why
+// sessions built from it are pooled and reused across actions. With
+// `read_only` set, every state-mutating intrinsic is rebound to a stub that
+// traps (see `webassembly::read_only`), so a read-only call cannot reach a
+// write path at all and needs no undo session.
+fn build_imports(mut store: &mut Store, env: &FunctionEnv<WasmContext>, read_only: bool) -> Imports {
+        let mut imports = imports! {
+        "env" => {
+            // Memory functions
+            "memcpy" => Function::new_typed_with_env(&mut store, &env, memcpy),
+            "memset" => Function::new_typed_with_env(&mut store, &env, memset),
+            "memcmp" => Function::new_typed_with_env(&mut store, &env, memcmp),
+            "memmove" => Function::new_typed_with_env(&mut store, &env, memmove),
+            // Builtins
+            "__ashlti3" => Function::new_typed_with_env(&mut store, &env, __ashlti3),
+            "__ashrti3" => Function::new_typed_with_env(&mut store, &env, __ashrti3),
+            "__lshlti3" => Function::new_typed_with_env(&mut store, &env, __lshlti3),
+            "__lshrti3" => Function::new_typed_with_env(&mut store, &env, __lshrti3),
+            "__divti3" => Function::new_typed_with_env(&mut store, &env, __divti3),
+            "__udivti3" => Function::new_typed_with_env(&mut store, &env, __udivti3),
+            "__multi3" => Function::new_typed_with_env(&mut store, &env, __multi3),
+            "__modti3" => Function::new_typed_with_env(&mut store, &env, __modti3),
+            "__umodti3" => Function::new_typed_with_env(&mut store, &env, __umodti3),
+            "__addtf3" => Function::new_typed_with_env(&mut store, &env, __addtf3),
+            "__subtf3" => Function::new_typed_with_env(&mut store, &env, __subtf3),
+            "__multf3" => Function::new_typed_with_env(&mut store, &env, __multf3),
+            "__divtf3" => Function::new_typed_with_env(&mut store, &env, __divtf3),
+            "__negtf2" => Function::new_typed_with_env(&mut store, &env, __negtf2),
+            "__extendsftf2" => Function::new_typed_with_env(&mut store, &env, __extendsftf2),
+            "__extenddftf2" => Function::new_typed_with_env(&mut store, &env, __extenddftf2),
+            "__trunctfdf2" => Function::new_typed_with_env(&mut store, &env, __trunctfdf2),
+            "__trunctfsf2" => Function::new_typed_with_env(&mut store, &env, __trunctfsf2),
+            "__fixtfsi" => Function::new_typed_with_env(&mut store, &env, __fixtfsi),
+            "__fixtfdi" => Function::new_typed_with_env(&mut store, &env, __fixtfdi),
+            "__fixtfti" => Function::new_typed_with_env(&mut store, &env, __fixtfti),
+            "__fixunstfsi" => Function::new_typed_with_env(&mut store, &env, __fixunstfsi),
+            "__fixunstfti" => Function::new_typed_with_env(&mut store, &env, __fixunstfti),
+            "__fixsfti" => Function::new_typed_with_env(&mut store, &env, __fixsfti),
+            "__fixdfti" => Function::new_typed_with_env(&mut store, &env, __fixdfti),
+            "__fixunssfti" => Function::new_typed_with_env(&mut store, &env, __fixunssfti),
+            "__fixunsdfti" => Function::new_typed_with_env(&mut store, &env, __fixunsdfti),
+            "__floatsidf" => Function::new_typed_with_env(&mut store, &env, __floatsidf),
+            "__floatsitf" => Function::new_typed_with_env(&mut store, &env, __floatsitf),
+            "__floatditf" => Function::new_typed_with_env(&mut store, &env, __floatditf),
+            "__floatunsitf" => Function::new_typed_with_env(&mut store, &env, __floatunsitf),
+            "__floatunditf" => Function::new_typed_with_env(&mut store, &env, __floatunditf),
+            "__floattidf" => Function::new_typed_with_env(&mut store, &env, __floattidf),
+            "__floatuntidf" => Function::new_typed_with_env(&mut store, &env, __floatuntidf),
+            "__eqtf2" => Function::new_typed_with_env(&mut store, &env, __eqtf2),
+            "__netf2" => Function::new_typed_with_env(&mut store, &env, __netf2),
+            "__getf2" => Function::new_typed_with_env(&mut store, &env, __getf2),
+            "__gttf2" => Function::new_typed_with_env(&mut store, &env, __gttf2),
+            "__letf2" => Function::new_typed_with_env(&mut store, &env, __letf2),
+            "__lttf2" => Function::new_typed_with_env(&mut store, &env, __lttf2),
+            "__cmptf2" => Function::new_typed_with_env(&mut store, &env, __cmptf2),
+            "__unordtf2" => Function::new_typed_with_env(&mut store, &env, __unordtf2),
+            "action_data_size" => Function::new_typed_with_env(&mut store, &env, action_data_size),
+            "read_action_data" => Function::new_typed_with_env(&mut store, &env, read_action_data),
+            "current_receiver" => Function::new_typed_with_env(&mut store, &env, current_receiver),
+            "set_action_return_value" => Function::new_typed_with_env(&mut store, &env, set_action_return_value),
+            "require_auth" => Function::new_typed_with_env(&mut store, &env, require_auth),
+            "has_auth" => Function::new_typed_with_env(&mut store, &env, has_auth),
+            "require_auth2" => Function::new_typed_with_env(&mut store, &env, require_auth2),
+            "require_recipient" => Function::new_typed_with_env(&mut store, &env, require_recipient),
+            "is_account" => Function::new_typed_with_env(&mut store, &env, is_account),
+            // Database functions for i64 tables
+            "db_find_i64" => Function::new_typed_with_env(&mut store, &env, db_find_i64),
+            "db_store_i64" => Function::new_typed_with_env(&mut store, &env, db_store_i64),
+            "db_get_i64" => Function::new_typed_with_env(&mut store, &env, db_get_i64),
+            "db_update_i64" => Function::new_typed_with_env(&mut store, &env, db_update_i64),
+            "db_remove_i64" => Function::new_typed_with_env(&mut store, &env, db_remove_i64),
+            "db_next_i64" => Function::new_typed_with_env(&mut store, &env, db_next_i64),
+            "db_previous_i64" => Function::new_typed_with_env(&mut store, &env, db_previous_i64),
+            "db_end_i64" => Function::new_typed_with_env(&mut store, &env, db_end_i64),
+            "db_lowerbound_i64" => Function::new_typed_with_env(&mut store, &env, db_lowerbound_i64),
+            "db_upperbound_i64" => Function::new_typed_with_env(&mut store, &env, db_upperbound_i64),
+            "db_prefetch_range" => Function::new_typed_with_env(&mut store, &env, db_prefetch_range),
+            "db_multi_get" => Function::new_typed_with_env(&mut store, &env, db_multi_get),
+            // Secondary index functions for i64 tables
+            "db_idx64_store" => Function::new_typed_with_env(&mut store, &env, db_idx64_store),
+            "db_idx64_update" => Function::new_typed_with_env(&mut store, &env, db_idx64_update),
+            "db_idx64_remove" => Function::new_typed_with_env(&mut store, &env, db_idx64_remove),
+            "db_idx64_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx64_find_secondary),
+            "db_idx64_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx64_find_primary),
+            "db_idx64_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx64_lowerbound),
+            "db_idx64_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx64_upperbound),
+            "db_idx64_end" => Function::new_typed_with_env(&mut store, &env, db_idx64_end),
+            "db_idx64_next" => Function::new_typed_with_env(&mut store, &env, db_idx64_next),
+            "db_idx64_previous" => Function::new_typed_with_env(&mut store, &env, db_idx64_previous),
+            // Index 128 functions
+            "db_idx128_store" => Function::new_typed_with_env(&mut store, &env, db_idx128_store),
+            "db_idx128_update" => Function::new_typed_with_env(&mut store, &env, db_idx128_update),
+            "db_idx128_remove" => Function::new_typed_with_env(&mut store, &env, db_idx128_remove),
+            "db_idx128_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx128_find_secondary),
+            "db_idx128_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx128_find_primary),
+            "db_idx128_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx128_lowerbound),
+            "db_idx128_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx128_upperbound),
+            "db_idx128_end" => Function::new_typed_with_env(&mut store, &env, db_idx128_end),
+            "db_idx128_next" => Function::new_typed_with_env(&mut store, &env, db_idx128_next),
+            "db_idx128_previous" => Function::new_typed_with_env(&mut store, &env, db_idx128_previous),
+            // Index 256 functions
+            "db_idx256_store" => Function::new_typed_with_env(&mut store, &env, db_idx256_store),
+            "db_idx256_update" => Function::new_typed_with_env(&mut store, &env, db_idx256_update),
+            "db_idx256_remove" => Function::new_typed_with_env(&mut store, &env, db_idx256_remove),
+            "db_idx256_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx256_find_secondary),
+            "db_idx256_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx256_find_primary),
+            "db_idx256_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx256_lowerbound),
+            "db_idx256_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx256_upperbound),
+            "db_idx256_end" => Function::new_typed_with_env(&mut store, &env, db_idx256_end),
+            "db_idx256_next" => Function::new_typed_with_env(&mut store, &env, db_idx256_next),
+            "db_idx256_previous" => Function::new_typed_with_env(&mut store, &env, db_idx256_previous),
+            // Index double functions
+            "db_idx_double_store" => Function::new_typed_with_env(&mut store, &env, db_idx_double_store),
+            "db_idx_double_update" => Function::new_typed_with_env(&mut store, &env, db_idx_double_update),
+            "db_idx_double_remove" => Function::new_typed_with_env(&mut store, &env, db_idx_double_remove),
+            "db_idx_double_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx_double_find_secondary),
+            "db_idx_double_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx_double_find_primary),
+            "db_idx_double_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx_double_lowerbound),
+            "db_idx_double_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx_double_upperbound),
+            "db_idx_double_end" => Function::new_typed_with_env(&mut store, &env, db_idx_double_end),
+            "db_idx_double_next" => Function::new_typed_with_env(&mut store, &env, db_idx_double_next),
+            "db_idx_double_previous" => Function::new_typed_with_env(&mut store, &env, db_idx_double_previous),
+            // Index long double functions
+            "db_idx_long_double_store" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_store),
+            "db_idx_long_double_update" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_update),
+            "db_idx_long_double_remove" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_remove),
+            "db_idx_long_double_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_find_secondary),
+            "db_idx_long_double_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_find_primary),
+            "db_idx_long_double_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_lowerbound),
+            "db_idx_long_double_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_upperbound),
+            "db_idx_long_double_end" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_end),
+            "db_idx_long_double_next" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_next),
+            "db_idx_long_double_previous" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_previous),
+            // System functions
+            "pulse_assert" => Function::new_typed_with_env(&mut store, &env, pulse_assert),
+            "eosio_assert" => Function::new_typed_with_env(&mut store, &env, eosio_assert),
+            "pulse_assert_message" => Function::new_typed_with_env(&mut store, &env, pulse_assert_message),
+            "eosio_assert_message" => Function::new_typed_with_env(&mut store, &env, pulse_assert_message),
+            "pulse_assert_code" => Function::new_typed_with_env(&mut store, &env, pulse_assert_code),
+            "eosio_assert_code" => Function::new_typed_with_env(&mut store, &env, pulse_assert_code),
+            "pulse_exit" => Function::new_typed_with_env(&mut store, &env, pulse_exit),
+            "eosio_exit" => Function::new_typed_with_env(&mut store, &env, pulse_exit),
+            "abort" => Function::new_typed_with_env(&mut store, &env, abort),
+            "current_time" => Function::new_typed_with_env(&mut store, &env, current_time),
+            // Crypto functions
+            "assert_recover_key" => Function::new_typed_with_env(&mut store, &env, assert_recover_key),
+            "recover_key" => Function::new_typed_with_env(&mut store, &env, recover_key),
+            "sha1" => Function::new_typed_with_env(&mut store, &env, sha1),
+            "sha224" => Function::new_typed_with_env(&mut store, &env, sha224),
+            "sha256" => Function::new_typed_with_env(&mut store, &env, sha256),
+            "sha512" => Function::new_typed_with_env(&mut store, &env, sha512),
+            "ripemd160" => Function::new_typed_with_env(&mut store, &env, ripemd160),
+            "assert_sha1" => Function::new_typed_with_env(&mut store, &env, assert_sha1),
+            "assert_sha224" => Function::new_typed_with_env(&mut store, &env, assert_sha224),
+            "assert_sha256" => Function::new_typed_with_env(&mut store, &env, assert_sha256),
+            "assert_sha512" => Function::new_typed_with_env(&mut store, &env, assert_sha512),
+            "assert_ripemd160" => Function::new_typed_with_env(&mut store, &env, assert_ripemd160),
+            // Incremental hashing: init returns a handle, update streams
+            // chunks into it, final writes the digest and frees the handle
+            "hash_init" => Function::new_typed_with_env(&mut store, &env, hash_init),
+            "hash_update" => Function::new_typed_with_env(&mut store, &env, hash_update),
+            "hash_final" => Function::new_typed_with_env(&mut store, &env, hash_final),
+            // Privilege and resource limit functions
+            "is_privileged" => Function::new_typed_with_env(&mut store, &env, is_privileged),
+            "set_privileged" => Function::new_typed_with_env(&mut store, &env, set_privileged),
+            "set_proposed_producers" => Function::new_typed_with_env(&mut store, &env, set_proposed_producers),
+            "get_blockchain_parameters_packed" => Function::new_typed_with_env(&mut store, &env, get_blockchain_parameters_packed),
+            "set_blockchain_parameters_packed" => Function::new_typed_with_env(&mut store, &env, set_blockchain_parameters_packed),
+            "set_resource_limits" => Function::new_typed_with_env(&mut store, &env, set_resource_limits),
+            "get_resource_limits" => Function::new_typed_with_env(&mut store, &env, get_resource_limits),
+            // Transaction functions
+            "send_inline" => Function::new_typed_with_env(&mut store, &env, send_inline),
+            "send_context_free_inline" => Function::new_typed_with_env(&mut store, &env, send_context_free_inline),
+            "read_transaction" => Function::new_typed_with_env(&mut store, &env, read_transaction),
+            "transaction_size" => Function::new_typed_with_env(&mut store, &env, transaction_size),
+            "expiration" => Function::new_typed_with_env(&mut store, &env, expiration),
+            "tapos_block_num" => Function::new_typed_with_env(&mut store, &env, tapos_block_num),
+            "tapos_block_prefix" => Function::new_typed_with_env(&mut store, &env, tapos_block_prefix),
+            "get_action" => Function::new_typed_with_env(&mut store, &env, get_action),
+            // Console functions
+            "prints" => Function::new_typed_with_env(&mut store, &env, prints),
+            "prints_l" => Function::new_typed_with_env(&mut store, &env, prints_l),
+            "printi" => Function::new_typed_with_env(&mut store, &env, printi),
+            "printui" => Function::new_typed_with_env(&mut store, &env, printui),
+            "printi128" => Function::new_typed_with_env(&mut store, &env, printi128),
+            "printui128" => Function::new_typed_with_env(&mut store, &env, printui128),
+            "printsf" => Function::new_typed_with_env(&mut store, &env, printsf),
+            "printdf" => Function::new_typed_with_env(&mut store, &env, printdf),
+            "printqf" => Function::new_typed_with_env(&mut store, &env, printqf),
+            "printn" => Function::new_typed_with_env(&mut store, &env, printn),
+            "printhex" => Function::new_typed_with_env(&mut store, &env, printhex),
+            // Permission functions
+            "check_transaction_authorization" => Function::new_typed_with_env(&mut store, &env, check_transaction_authorization),
+            "check_permission_authorization" => Function::new_typed_with_env(&mut store, &env, check_permission_authorization),
+            "get_permission_last_used" => Function::new_typed_with_env(&mut store, &env, get_permission_last_used),
+            "get_account_creation_time" => Function::new_typed_with_env(&mut store, &env, get_account_creation_time),
+            // Context free functions
+            "get_context_free_data" => Function::new_typed_with_env(&mut store, &env, get_context_free_data),
+            // Producer functions
+            "get_active_producers" => Function::new_typed_with_env(&mut store, &env, get_active_producers),
+        }
+    };
+
+    if read_only {
+        let overrides: [(&str, Function); 24] = [
+            ("db_store_i64", Function::new_typed_with_env(&mut store, &env, read_only::db_store_i64)),
+            ("db_update_i64", Function::new_typed_with_env(&mut store, &env, read_only::db_update_i64)),
+            ("db_remove_i64", Function::new_typed_with_env(&mut store, &env, read_only::db_remove_i64)),
+            ("db_idx64_store", Function::new_typed_with_env(&mut store, &env, read_only::db_idx64_store)),
+            ("db_idx64_update", Function::new_typed_with_env(&mut store, &env, read_only::db_idx64_update)),
+            ("db_idx64_remove", Function::new_typed_with_env(&mut store, &env, read_only::db_idx64_remove)),
+            ("db_idx128_store", Function::new_typed_with_env(&mut store, &env, read_only::db_idx128_store)),
+            ("db_idx128_update", Function::new_typed_with_env(&mut store, &env, read_only::db_idx128_update)),
+            ("db_idx128_remove", Function::new_typed_with_env(&mut store, &env, read_only::db_idx128_remove)),
+            ("db_idx256_store", Function::new_typed_with_env(&mut store, &env, read_only::db_idx256_store)),
+            ("db_idx256_update", Function::new_typed_with_env(&mut store, &env, read_only::db_idx256_update)),
+            ("db_idx256_remove", Function::new_typed_with_env(&mut store, &env, read_only::db_idx256_remove)),
+            ("db_idx_double_store", Function::new_typed_with_env(&mut store, &env, read_only::db_idx_double_store)),
+            ("db_idx_double_update", Function::new_typed_with_env(&mut store, &env, read_only::db_idx_double_update)),
+            ("db_idx_double_remove", Function::new_typed_with_env(&mut store, &env, read_only::db_idx_double_remove)),
+            ("db_idx_long_double_store", Function::new_typed_with_env(&mut store, &env, read_only::db_idx_long_double_store)),
+            ("db_idx_long_double_update", Function::new_typed_with_env(&mut store, &env, read_only::db_idx_long_double_update)),
+            ("db_idx_long_double_remove", Function::new_typed_with_env(&mut store, &env, read_only::db_idx_long_double_remove)),
+            ("send_inline", Function::new_typed_with_env(&mut store, &env, read_only::send_inline)),
+            ("send_context_free_inline", Function::new_typed_with_env(&mut store, &env, read_only::send_context_free_inline)),
+            ("set_privileged", Function::new_typed_with_env(&mut store, &env, read_only::set_privileged)),
+            ("set_resource_limits", Function::new_typed_with_env(&mut store, &env, read_only::set_resource_limits)),
+            ("set_proposed_producers", Function::new_typed_with_env(&mut store, &env, read_only::set_proposed_producers)),
+            ("set_blockchain_parameters_packed", Function::new_typed_with_env(&mut store, &env, read_only::set_blockchain_parameters_packed)),
+        ];
+        for (name, function) in overrides {
+            imports.define("env", name, function);
+        }
     }
-};
+
+    imports
+}
 
 impl WasmRuntime {
     pub fn new() -> Result<Self, ChainError> {
@@ -184,11 +589,194 @@ impl WasmRuntime {
         LLVM::canonicalize_nans(&mut compiler, true);
         LLVM::opt_level(&mut compiler, LLVMOptLevel::Aggressive);
 
-        Ok(Self {
+        let runtime = Self {
             inner: Arc::new(RwLock::new(InnerWasmRuntime {
-                code_cache: LruCache::new(NonZeroUsize::new(1024).unwrap()),
+                code_cache: LruCache::unbounded(),
+                cache_bytes: 0,
+                cache_max_bytes: DEFAULT_WASM_CACHE_MAX_BYTES,
+                artifact_dir: None,
+                optimizing: HashSet::new(),
+                session_pool: HashMap::new(),
             })),
-        })
+        };
+        runtime.seed_embedded_modules()?;
+        Ok(runtime)
+    }
+
+    // Seeds the module cache with the system contracts precompiled at build
+    // time, so a fresh chain executes pulse_bios / pulse_system at the
+    // optimized tier from its very first action instead of paying an LLVM
+    // compile at genesis. Best-effort: an artifact that does not deserialize
+    // on this machine (the binary may be running on a different CPU than it
+    // was built on) is skipped and the contract takes the normal compile
+    // path when first dispatched.
+    fn seed_embedded_modules(&self) -> Result<(), ChainError> {
+        let mut inner = self.inner.write()?;
+        for contract in embedded::EMBEDDED_SYSTEM_CONTRACTS {
+            let id = Id::new(contract.code_hash);
+            if inner.code_cache.contains(&id) {
+                continue;
+            }
+            let engine = Self::optimized_engine(LLVMOptLevel::Aggressive);
+            // Safety: the artifact was produced by this crate's build script
+            // from the in-tree reference contract, with the same wasmer
+            // version this binary links.
+            match unsafe { Module::deserialize(&engine, contract.artifact) } {
+                Ok(module) => {
+                    inner.cache_insert(
+                        id,
+                        CachedModule {
+                            module,
+                            engine,
+                            tier: CompilationTier::OptimizedHot,
+                            size_bytes: contract.artifact.len() as u64,
+                            hits: 0,
+                        },
+                    );
+                }
+                Err(e) => {
+                    warn!(
+                        "skipping embedded wasm artifact for {}: {}",
+                        contract.name, e
+                    );
+                }
+            }
+        }
+        Ok(())
+    }
+
+    // Fast-tier engine: Cranelift with the same metering middleware and NaN
+    // canonicalization as the LLVM tier, so metering charges and float
+    // results are identical across tiers.
+    fn baseline_engine() -> Engine {
+        let mut compiler = Cranelift::default();
+        let metering = Arc::new(Metering::new(1_000, COST_FUNCTION));
+        compiler.push_middleware(metering);
+        compiler.canonicalize_nans(true);
+        compiler.opt_level(CraneliftOptLevel::Speed);
+        let mut engine: Engine = compiler.into();
+        engine.set_tunables(PooledTunables::shared());
+        engine
+    }
+
+    // Optimized-tier engine: LLVM at the given optimization level, used for
+    // background recompilation and for loading persisted artifacts. The
+    // level only affects compilation — metering and NaN canonicalization
+    // are identical across every tier and level, so execution semantics and
+    // gas charges never depend on how hot a contract is.
+    fn optimized_engine(opt_level: LLVMOptLevel) -> Engine {
+        let mut compiler = LLVM::default();
+        let metering = Arc::new(Metering::new(1_000, COST_FUNCTION));
+        compiler.push_middleware(metering);
+        LLVM::canonicalize_nans(&mut compiler, true);
+        LLVM::opt_level(&mut compiler, opt_level);
+        let mut engine: Engine = compiler.into();
+        engine.set_tunables(PooledTunables::shared());
+        engine
+    }
+
+    // Enables the persistent compiled-module cache under the given directory
+    // (created if missing). Artifacts are keyed by code hash and wasmer
+    // version, so an engine upgrade simply leaves stale files behind instead
+    // of loading incompatible code.
+    pub fn set_artifact_dir(&self, dir: &Path) -> Result<(), ChainError> {
+        fs::create_dir_all(dir).map_err(|e| {
+            ChainError::WasmRuntimeError(format!(
+                "failed to create wasm artifact dir {}: {}",
+                dir.display(),
+                e
+            ))
+        })?;
+        let mut inner = self.inner.write()?;
+        inner.artifact_dir = Some(dir.to_path_buf());
+        Ok(())
+    }
+
+    // Sets the module cache's byte budget from the node config and shrinks
+    // the cache immediately if it is already past the new limit.
+    pub fn set_cache_limit(&self, max_bytes: u64) -> Result<(), ChainError> {
+        let mut inner = self.inner.write()?;
+        inner.cache_max_bytes = max_bytes;
+        inner.enforce_cache_budget(None);
+        Ok(())
+    }
+
+    // Kicks off a background LLVM compilation of the given code at the opt
+    // level matching `target_tier` and swaps the module into the cache when
+    // it finishes. Called with the inner lock held; the job itself
+    // re-acquires the lock only for the final swap. The artifact path is
+    // only passed for aggressive builds — the persisted cache holds the
+    // final form of a contract, not the intermediate one.
+    fn spawn_optimize_job(
+        &self,
+        inner: &mut InnerWasmRuntime,
+        id: Id,
+        code: Vec<u8>,
+        artifact_path: Option<PathBuf>,
+        target_tier: CompilationTier,
+    ) {
+        if !inner.optimizing.insert(id) {
+            return; // a job for this code hash is already running
+        }
+
+        let opt_level = match target_tier {
+            CompilationTier::OptimizedHot => LLVMOptLevel::Aggressive,
+            _ => LLVMOptLevel::Default,
+        };
+        let shared = Arc::clone(&self.inner);
+        thread::spawn(move || {
+            let engine = WasmRuntime::optimized_engine(opt_level);
+
+            match Module::new(&engine, code.as_slice()) {
+                Ok(module) => {
+                    // Persist the compiled artifact best-effort; a failed
+                    // write only costs a recompile on the next restart.
+                    if let Some(path) = &artifact_path {
+                        let tmp_path = path.with_extension("wasmu.tmp");
+                        let persisted = module
+                            .serialize_to_file(&tmp_path)
+                            .map_err(|e| e.to_string())
+                            .and_then(|_| fs::rename(&tmp_path, path).map_err(|e| e.to_string()));
+                        if let Err(e) = persisted {
+                            warn!("failed to persist wasm artifact {}: {}", path.display(), e);
+                            let _ = fs::remove_file(&tmp_path);
+                        }
+                    }
+
+                    if let Ok(mut inner) = shared.write() {
+                        // Only replace an entry still on a lower tier; the
+                        // contract may have been evicted, replaced by a
+                        // setcode, or already promoted past this job in the
+                        // meantime.
+                        if let Some(entry) = inner.code_cache.peek_mut(&id) {
+                            if entry.tier.rank() < target_tier.rank() {
+                                // Same wasm, so the byte weight and hit
+                                // history carry over.
+                                let (old_tier, size_bytes, hits) =
+                                    (entry.tier, entry.size_bytes, entry.hits);
+                                *entry = CachedModule {
+                                    module,
+                                    engine,
+                                    tier: target_tier,
+                                    size_bytes,
+                                    hits,
+                                };
+                                // Sessions of the replaced tier are obsolete now
+                                inner.session_pool.remove(&(id, old_tier, false));
+                                inner.session_pool.remove(&(id, old_tier, true));
+                            }
+                        }
+                        inner.optimizing.remove(&id);
+                    }
+                }
+                Err(e) => {
+                    warn!("background LLVM compilation failed for {}: {}", id, e);
+                    if let Ok(mut inner) = shared.write() {
+                        inner.optimizing.remove(&id);
+                    }
+                }
+            }
+        });
     }
 
     pub fn run(
@@ -200,248 +788,207 @@ impl WasmRuntime {
         code_hash: &CxxDigest,
         cpu_limit: i64,
     ) -> Result<u64, ChainError> {
+        self.run_internal(receiver, action, apply_context, db, code_hash, cpu_limit, false)
+            .map(|(cpu_used, _)| cpu_used)
+    }
+
+    // Same as `run`, but instantiates with the read-only import bindings (all
+    // state-mutating intrinsics trap; see `webassembly::read_only`) and also
+    // returns the action's return value, which is what a view call is after.
+    // Safe to invoke concurrently with block execution on any database
+    // handle, since nothing in the call can write.
+    pub fn run_read_only(
+        &mut self,
+        receiver: Name,
+        action: Action,
+        apply_context: ApplyContext,
+        db: Database,
+        code_hash: &CxxDigest,
+        cpu_limit: i64,
+    ) -> Result<(u64, Option<Bytes>), ChainError> {
+        self.run_internal(receiver, action, apply_context, db, code_hash, cpu_limit, true)
+    }
+
+    fn run_internal(
+        &mut self,
+        receiver: Name,
+        action: Action,
+        apply_context: ApplyContext,
+        db: Database,
+        code_hash: &CxxDigest,
+        cpu_limit: i64,
+        read_only: bool,
+    ) -> Result<(u64, Option<Bytes>), ChainError> {
         // Pause timer
         apply_context.pause_billing_timer()?;
 
         let id = Id::from(code_hash);
-        let module = {
+        let (module, pooled) = {
             let mut inner = self.inner.write()?;
 
             if !inner.code_cache.contains(&id) {
-                let code_object = db.get_code_object_by_hash(code_hash, 0, 0)?;
-                let code_object = unsafe { &*code_object };
-
-                // Create a temporary store just for module compilation
-                let mut compiler = LLVM::default();
-
-                // Add initial limit of 1,000 so start function can run if present
-                let metering = Arc::new(Metering::new(1_000, COST_FUNCTION));
-                compiler.push_middleware(metering);
-                LLVM::canonicalize_nans(&mut compiler, true);
-                LLVM::opt_level(&mut compiler, LLVMOptLevel::Aggressive);
-
-                let temp_engine: Engine = compiler.into();
-                let temp_store = Store::new(temp_engine.clone());
-
-                let module = Module::new(temp_store.engine(), code_object.get_code().as_slice())
-                    .map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
-                inner.code_cache.put(
-                    id,
-                    CachedModule {
-                        module,
-                        engine: temp_engine.clone(),
-                    },
-                );
+                METRICS.count_wasm_cache_miss();
+                let artifact_path = inner.artifact_path(&id);
+
+                // Try the on-disk artifact first; deserialization mmaps the
+                // precompiled code, so a restarted node skips LLVM entirely
+                // for contracts it has seen before.
+                let mut cached: Option<CachedModule> = None;
+                if let Some(path) = &artifact_path {
+                    if path.exists() {
+                        let engine = Self::optimized_engine(LLVMOptLevel::Aggressive);
+                        // Safety: the artifact was produced by this node with
+                        // the same wasmer version (it is part of the file
+                        // name) from validated on-chain code. Only aggressive
+                        // builds are persisted, so a loaded artifact is
+                        // already the top tier.
+                        match unsafe { Module::deserialize_from_file(&engine, path) } {
+                            Ok(module) => {
+                                let size_bytes =
+                                    fs::metadata(path).map(|m| m.len()).unwrap_or(0);
+                                cached = Some(CachedModule {
+                                    module,
+                                    engine,
+                                    tier: CompilationTier::OptimizedHot,
+                                    size_bytes,
+                                    hits: 0,
+                                });
+                            }
+                            Err(e) => {
+                                warn!(
+                                    "failed to deserialize wasm artifact {}, recompiling: {}",
+                                    path.display(),
+                                    e
+                                );
+                            }
+                        }
+                    }
+                }
+
+                // No artifact: compile the fast baseline tier so this action
+                // can run now. No LLVM job is queued yet — whether the
+                // contract deserves one is decided by its dispatch count
+                // below, so a deploy-and-forget contract never costs an
+                // LLVM compile.
+                let cached = match cached {
+                    Some(cached) => cached,
+                    None => {
+                        let code_object = db.get_code_object_by_hash(code_hash, 0, 0)?;
+                        let code_object = unsafe { &*code_object };
+                        let engine = Self::baseline_engine();
+                        let module = Module::new(&engine, code_object.get_code().as_slice())
+                            .map_err(|e| ChainError::WasmRuntimeError(e.to_string()))?;
+                        let size_bytes = code_object.get_code().as_slice().len() as u64;
+
+                        CachedModule {
+                            module,
+                            engine,
+                            tier: CompilationTier::Baseline,
+                            size_bytes,
+                            hits: 0,
+                        }
+                    }
+                };
+
+                inner.cache_insert(id, cached);
+            } else {
+                METRICS.count_wasm_cache_hit();
             }
 
-            inner.code_cache.get(&id).unwrap().clone()
+            let module = {
+                let entry = inner.code_cache.get_mut(&id).unwrap();
+                entry.hits += 1;
+                entry.clone()
+            };
+
+            // Frequency-driven promotion: the entry's own dispatch count is
+            // the profile. A contract that proves itself gets a default-level
+            // LLVM build; one that keeps climbing gets recompiled aggressively
+            // and persisted. The `optimizing` set keeps a running job from
+            // being queued twice on the dispatches in between.
+            let promote_to = match module.tier {
+                CompilationTier::Baseline if module.hits >= OPTIMIZE_HIT_THRESHOLD => {
+                    Some(CompilationTier::Optimized)
+                }
+                CompilationTier::Optimized if module.hits >= HOT_RECOMPILE_HIT_THRESHOLD => {
+                    Some(CompilationTier::OptimizedHot)
+                }
+                _ => None,
+            };
+            if let Some(target_tier) = promote_to {
+                if !inner.optimizing.contains(&id) {
+                    let code_object = db.get_code_object_by_hash(code_hash, 0, 0)?;
+                    let code_object = unsafe { &*code_object };
+                    let artifact_path = if target_tier == CompilationTier::OptimizedHot {
+                        inner.artifact_path(&id)
+                    } else {
+                        None
+                    };
+                    self.spawn_optimize_job(
+                        &mut inner,
+                        id,
+                        code_object.get_code().as_slice().to_vec(),
+                        artifact_path,
+                        target_tier,
+                    );
+                }
+            }
+
+            // Reuse a pooled session (store plus host import set) for this
+            // code hash and tier when one is available; building the imports
+            // is the dominant cost of instantiation. The instance itself is
+            // always created fresh so every action starts from untouched
+            // linear memory. Popped under the same lock as the module lookup
+            // so a dispatch on the hot path (e.g. a burst of inline actions
+            // to one contract) pays a single lock round-trip.
+            let pooled = inner
+                .session_pool
+                .get_mut(&(id, module.tier, read_only))
+                .and_then(|sessions| sessions.pop());
+
+            (module, pooled)
         };
 
-        let mut store = Store::new(module.engine.clone());
-        let wasm_context = WasmContext::new(
-            receiver.clone(),
-            action.clone(),
-            apply_context.pending_block_timestamp().clone(),
-            apply_context.clone(),
-            db.clone(),
-        );
-        let env = FunctionEnv::new(&mut store, wasm_context);
-        let import_object = imports! {
-            "env" => {
-                // Memory functions
-                "memcpy" => Function::new_typed_with_env(&mut store, &env, memcpy),
-                "memset" => Function::new_typed_with_env(&mut store, &env, memset),
-                "memcmp" => Function::new_typed_with_env(&mut store, &env, memcmp),
-                "memmove" => Function::new_typed_with_env(&mut store, &env, memmove),
-                // Builtins
-                "__ashlti3" => Function::new_typed_with_env(&mut store, &env, __ashlti3),
-                "__ashrti3" => Function::new_typed_with_env(&mut store, &env, __ashrti3),
-                "__lshlti3" => Function::new_typed_with_env(&mut store, &env, __lshlti3),
-                "__lshrti3" => Function::new_typed_with_env(&mut store, &env, __lshrti3),
-                "__divti3" => Function::new_typed_with_env(&mut store, &env, __divti3),
-                "__udivti3" => Function::new_typed_with_env(&mut store, &env, __udivti3),
-                "__multi3" => Function::new_typed_with_env(&mut store, &env, __multi3),
-                "__modti3" => Function::new_typed_with_env(&mut store, &env, __modti3),
-                "__umodti3" => Function::new_typed_with_env(&mut store, &env, __umodti3),
-                "__addtf3" => Function::new_typed_with_env(&mut store, &env, __addtf3),
-                "__subtf3" => Function::new_typed_with_env(&mut store, &env, __subtf3),
-                "__multf3" => Function::new_typed_with_env(&mut store, &env, __multf3),
-                "__divtf3" => Function::new_typed_with_env(&mut store, &env, __divtf3),
-                "__negtf2" => Function::new_typed_with_env(&mut store, &env, __negtf2),
-                "__extendsftf2" => Function::new_typed_with_env(&mut store, &env, __extendsftf2),
-                "__extenddftf2" => Function::new_typed_with_env(&mut store, &env, __extenddftf2),
-                "__trunctfdf2" => Function::new_typed_with_env(&mut store, &env, __trunctfdf2),
-                "__trunctfsf2" => Function::new_typed_with_env(&mut store, &env, __trunctfsf2),
-                "__fixtfsi" => Function::new_typed_with_env(&mut store, &env, __fixtfsi),
-                "__fixtfdi" => Function::new_typed_with_env(&mut store, &env, __fixtfdi),
-                "__fixtfti" => Function::new_typed_with_env(&mut store, &env, __fixtfti),
-                "__fixunstfsi" => Function::new_typed_with_env(&mut store, &env, __fixunstfsi),
-                "__fixunstfti" => Function::new_typed_with_env(&mut store, &env, __fixunstfti),
-                "__fixsfti" => Function::new_typed_with_env(&mut store, &env, __fixsfti),
-                "__fixdfti" => Function::new_typed_with_env(&mut store, &env, __fixdfti),
-                "__fixunssfti" => Function::new_typed_with_env(&mut store, &env, __fixunssfti),
-                "__fixunsdfti" => Function::new_typed_with_env(&mut store, &env, __fixunsdfti),
-                "__floatsidf" => Function::new_typed_with_env(&mut store, &env, __floatsidf),
-                "__floatsitf" => Function::new_typed_with_env(&mut store, &env, __floatsitf),
-                "__floatditf" => Function::new_typed_with_env(&mut store, &env, __floatditf),
-                "__floatunsitf" => Function::new_typed_with_env(&mut store, &env, __floatunsitf),
-                "__floatunditf" => Function::new_typed_with_env(&mut store, &env, __floatunditf),
-                "__floattidf" => Function::new_typed_with_env(&mut store, &env, __floattidf),
-                "__floatuntidf" => Function::new_typed_with_env(&mut store, &env, __floatuntidf),
-                "__eqtf2" => Function::new_typed_with_env(&mut store, &env, __eqtf2),
-                "__netf2" => Function::new_typed_with_env(&mut store, &env, __netf2),
-                "__getf2" => Function::new_typed_with_env(&mut store, &env, __getf2),
-                "__gttf2" => Function::new_typed_with_env(&mut store, &env, __gttf2),
-                "__letf2" => Function::new_typed_with_env(&mut store, &env, __letf2),
-                "__lttf2" => Function::new_typed_with_env(&mut store, &env, __lttf2),
-                "__cmptf2" => Function::new_typed_with_env(&mut store, &env, __cmptf2),
-                "__unordtf2" => Function::new_typed_with_env(&mut store, &env, __unordtf2),
-                "action_data_size" => Function::new_typed_with_env(&mut store, &env, action_data_size),
-                "read_action_data" => Function::new_typed_with_env(&mut store, &env, read_action_data),
-                "current_receiver" => Function::new_typed_with_env(&mut store, &env, current_receiver),
-                "set_action_return_value" => Function::new_typed_with_env(&mut store, &env, set_action_return_value),
-                "require_auth" => Function::new_typed_with_env(&mut store, &env, require_auth),
-                "has_auth" => Function::new_typed_with_env(&mut store, &env, has_auth),
-                "require_auth2" => Function::new_typed_with_env(&mut store, &env, require_auth2),
-                "require_recipient" => Function::new_typed_with_env(&mut store, &env, require_recipient),
-                "is_account" => Function::new_typed_with_env(&mut store, &env, is_account),
-                // Database functions for i64 tables
-                "db_find_i64" => Function::new_typed_with_env(&mut store, &env, db_find_i64),
-                "db_store_i64" => Function::new_typed_with_env(&mut store, &env, db_store_i64),
-                "db_get_i64" => Function::new_typed_with_env(&mut store, &env, db_get_i64),
-                "db_update_i64" => Function::new_typed_with_env(&mut store, &env, db_update_i64),
-                "db_remove_i64" => Function::new_typed_with_env(&mut store, &env, db_remove_i64),
-                "db_next_i64" => Function::new_typed_with_env(&mut store, &env, db_next_i64),
-                "db_previous_i64" => Function::new_typed_with_env(&mut store, &env, db_previous_i64),
-                "db_end_i64" => Function::new_typed_with_env(&mut store, &env, db_end_i64),
-                "db_lowerbound_i64" => Function::new_typed_with_env(&mut store, &env, db_lowerbound_i64),
-                "db_upperbound_i64" => Function::new_typed_with_env(&mut store, &env, db_upperbound_i64),
-                // Secondary index functions for i64 tables
-                "db_idx64_store" => Function::new_typed_with_env(&mut store, &env, db_idx64_store),
-                "db_idx64_update" => Function::new_typed_with_env(&mut store, &env, db_idx64_update),
-                "db_idx64_remove" => Function::new_typed_with_env(&mut store, &env, db_idx64_remove),
-                "db_idx64_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx64_find_secondary),
-                "db_idx64_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx64_find_primary),
-                "db_idx64_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx64_lowerbound),
-                "db_idx64_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx64_upperbound),
-                "db_idx64_end" => Function::new_typed_with_env(&mut store, &env, db_idx64_end),
-                "db_idx64_next" => Function::new_typed_with_env(&mut store, &env, db_idx64_next),
-                "db_idx64_previous" => Function::new_typed_with_env(&mut store, &env, db_idx64_previous),
-                // Index 128 functions
-                "db_idx128_store" => Function::new_typed_with_env(&mut store, &env, db_idx128_store),
-                "db_idx128_update" => Function::new_typed_with_env(&mut store, &env, db_idx128_update),
-                "db_idx128_remove" => Function::new_typed_with_env(&mut store, &env, db_idx128_remove),
-                "db_idx128_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx128_find_secondary),
-                "db_idx128_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx128_find_primary),
-                "db_idx128_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx128_lowerbound),
-                "db_idx128_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx128_upperbound),
-                "db_idx128_end" => Function::new_typed_with_env(&mut store, &env, db_idx128_end),
-                "db_idx128_next" => Function::new_typed_with_env(&mut store, &env, db_idx128_next),
-                "db_idx128_previous" => Function::new_typed_with_env(&mut store, &env, db_idx128_previous),
-                // Index 256 functions
-                "db_idx256_store" => Function::new_typed_with_env(&mut store, &env, db_idx256_store),
-                "db_idx256_update" => Function::new_typed_with_env(&mut store, &env, db_idx256_update),
-                "db_idx256_remove" => Function::new_typed_with_env(&mut store, &env, db_idx256_remove),
-                "db_idx256_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx256_find_secondary),
-                "db_idx256_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx256_find_primary),
-                "db_idx256_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx256_lowerbound),
-                "db_idx256_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx256_upperbound),
-                "db_idx256_end" => Function::new_typed_with_env(&mut store, &env, db_idx256_end),
-                "db_idx256_next" => Function::new_typed_with_env(&mut store, &env, db_idx256_next),
-                "db_idx256_previous" => Function::new_typed_with_env(&mut store, &env, db_idx256_previous),
-                // Index double functions
-                "db_idx_double_store" => Function::new_typed_with_env(&mut store, &env, db_idx_double_store),
-                "db_idx_double_update" => Function::new_typed_with_env(&mut store, &env, db_idx_double_update),
-                "db_idx_double_remove" => Function::new_typed_with_env(&mut store, &env, db_idx_double_remove),
-                "db_idx_double_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx_double_find_secondary),
-                "db_idx_double_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx_double_find_primary),
-                "db_idx_double_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx_double_lowerbound),
-                "db_idx_double_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx_double_upperbound),
-                "db_idx_double_end" => Function::new_typed_with_env(&mut store, &env, db_idx_double_end),
-                "db_idx_double_next" => Function::new_typed_with_env(&mut store, &env, db_idx_double_next),
-                "db_idx_double_previous" => Function::new_typed_with_env(&mut store, &env, db_idx_double_previous),
-                // Index long double functions
-                "db_idx_long_double_store" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_store),
-                "db_idx_long_double_update" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_update),
-                "db_idx_long_double_remove" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_remove),
-                "db_idx_long_double_find_secondary" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_find_secondary),
-                "db_idx_long_double_find_primary" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_find_primary),
-                "db_idx_long_double_lowerbound" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_lowerbound),
-                "db_idx_long_double_upperbound" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_upperbound),
-                "db_idx_long_double_end" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_end),
-                "db_idx_long_double_next" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_next),
-                "db_idx_long_double_previous" => Function::new_typed_with_env(&mut store, &env, db_idx_long_double_previous),
-                // System functions
-                "pulse_assert" => Function::new_typed_with_env(&mut store, &env, pulse_assert),
-                "eosio_assert" => Function::new_typed_with_env(&mut store, &env, eosio_assert),
-                "pulse_assert_message" => Function::new_typed_with_env(&mut store, &env, pulse_assert_message),
-                "eosio_assert_message" => Function::new_typed_with_env(&mut store, &env, pulse_assert_message),
-                "pulse_assert_code" => Function::new_typed_with_env(&mut store, &env, pulse_assert_code),
-                "eosio_assert_code" => Function::new_typed_with_env(&mut store, &env, pulse_assert_code),
-                "pulse_exit" => Function::new_typed_with_env(&mut store, &env, pulse_exit),
-                "eosio_exit" => Function::new_typed_with_env(&mut store, &env, pulse_exit),
-                "abort" => Function::new_typed_with_env(&mut store, &env, abort),
-                "current_time" => Function::new_typed_with_env(&mut store, &env, current_time),
-                // Crypto functions
-                "assert_recover_key" => Function::new_typed_with_env(&mut store, &env, assert_recover_key),
-                "recover_key" => Function::new_typed_with_env(&mut store, &env, recover_key),
-                "sha1" => Function::new_typed_with_env(&mut store, &env, sha1),
-                "sha224" => Function::new_typed_with_env(&mut store, &env, sha224),
-                "sha256" => Function::new_typed_with_env(&mut store, &env, sha256),
-                "sha512" => Function::new_typed_with_env(&mut store, &env, sha512),
-                "ripemd160" => Function::new_typed_with_env(&mut store, &env, ripemd160),
-                "assert_sha1" => Function::new_typed_with_env(&mut store, &env, assert_sha1),
-                "assert_sha224" => Function::new_typed_with_env(&mut store, &env, assert_sha224),
-                "assert_sha256" => Function::new_typed_with_env(&mut store, &env, assert_sha256),
-                "assert_sha512" => Function::new_typed_with_env(&mut store, &env, assert_sha512),
-                "assert_ripemd160" => Function::new_typed_with_env(&mut store, &env, assert_ripemd160),
-                // Privilege and resource limit functions
-                "is_privileged" => Function::new_typed_with_env(&mut store, &env, is_privileged),
-                "set_privileged" => Function::new_typed_with_env(&mut store, &env, set_privileged),
-                "set_proposed_producers" => Function::new_typed_with_env(&mut store, &env, set_proposed_producers),
-                "get_blockchain_parameters_packed" => Function::new_typed_with_env(&mut store, &env, get_blockchain_parameters_packed),
-                "set_blockchain_parameters_packed" => Function::new_typed_with_env(&mut store, &env, set_blockchain_parameters_packed),
-                "set_resource_limits" => Function::new_typed_with_env(&mut store, &env, set_resource_limits),
-                "get_resource_limits" => Function::new_typed_with_env(&mut store, &env, get_resource_limits),
-                // Transaction functions
-                "send_inline" => Function::new_typed_with_env(&mut store, &env, send_inline),
-                "send_context_free_inline" => Function::new_typed_with_env(&mut store, &env, send_context_free_inline),
-                "read_transaction" => Function::new_typed_with_env(&mut store, &env, read_transaction),
-                "transaction_size" => Function::new_typed_with_env(&mut store, &env, transaction_size),
-                "expiration" => Function::new_typed_with_env(&mut store, &env, expiration),
-                "tapos_block_num" => Function::new_typed_with_env(&mut store, &env, tapos_block_num),
-                "tapos_block_prefix" => Function::new_typed_with_env(&mut store, &env, tapos_block_prefix),
-                "get_action" => Function::new_typed_with_env(&mut store, &env, get_action),
-                // Console functions
-                "prints" => Function::new_typed_with_env(&mut store, &env, prints),
-                "prints_l" => Function::new_typed_with_env(&mut store, &env, prints_l),
-                "printi" => Function::new_typed_with_env(&mut store, &env, printi),
-                "printui" => Function::new_typed_with_env(&mut store, &env, printui),
-                "printi128" => Function::new_typed_with_env(&mut store, &env, printi128),
-                "printui128" => Function::new_typed_with_env(&mut store, &env, printui128),
-                "printsf" => Function::new_typed_with_env(&mut store, &env, printsf),
-                "printdf" => Function::new_typed_with_env(&mut store, &env, printdf),
-                "printqf" => Function::new_typed_with_env(&mut store, &env, printqf),
-                "printn" => Function::new_typed_with_env(&mut store, &env, printn),
-                "printhex" => Function::new_typed_with_env(&mut store, &env, printhex),
-                // Permission functions
-                "check_transaction_authorization" => Function::new_typed_with_env(&mut store, &env, check_transaction_authorization),
-                "check_permission_authorization" => Function::new_typed_with_env(&mut store, &env, check_permission_authorization),
-                "get_permission_last_used" => Function::new_typed_with_env(&mut store, &env, get_permission_last_used),
-                "get_account_creation_time" => Function::new_typed_with_env(&mut store, &env, get_account_creation_time),
-                // Context free functions
-                "get_context_free_data" => Function::new_typed_with_env(&mut store, &env, get_context_free_data),
-                // Producer functions
-                "get_active_producers" => Function::new_typed_with_env(&mut store, &env, get_active_producers),
+        let mut session = match pooled {
+            Some(mut session) => {
+                let ctx = session.env.as_mut(&mut session.store);
+                ctx.reset_for(
+                    receiver.clone(),
+                    action.clone(),
+                    apply_context.pending_block_timestamp().clone(),
+                    apply_context.clone(),
+                    db.clone(),
+                );
+                session
+            }
+            None => {
+                let mut store = Store::new(module.engine.clone());
+                let wasm_context = WasmContext::new(
+                    receiver.clone(),
+                    action.clone(),
+                    apply_context.pending_block_timestamp().clone(),
+                    apply_context.clone(),
+                    db.clone(),
+                );
+                let env = FunctionEnv::new(&mut store, wasm_context);
+                let imports = build_imports(&mut store, &env, read_only);
+                ExecSession {
+                    store,
+                    env,
+                    imports,
+                    uses: 0,
+                }
             }
         };
-        let instance = Instance::new(&mut store, &module.module, &import_object).map_err(|e| {
-            ChainError::WasmRuntimeError(format!("failed to create wasm instance: {}", e))
-        })?;
+
+        let instance = Instance::new(&mut session.store, &module.module, &session.imports)
+            .map_err(|e| {
+                ChainError::WasmRuntimeError(format!("failed to create wasm instance: {}", e))
+            })?;
 
         match instance.exports.get_memory("memory") {
             Ok(mem) => {
-                let ctx = env.as_mut(&mut store);
+                let ctx = session.env.as_mut(&mut session.store);
                 ctx.memory = Some(mem.clone());
             }
             Err(_) => {
@@ -459,11 +1006,19 @@ impl WasmRuntime {
         };
 
         // Set initial metering points based on resource limits
-        set_remaining_points(&mut store, &instance, cpu_limit);
+        set_remaining_points(&mut session.store, &instance, cpu_limit);
+
+        // Hand the Metering remaining-points global to the env so host calls
+        // can sample in-flight gas; `reset_for` cleared any previous
+        // instance's global on pooled sessions.
+        if let Ok(global) = instance.exports.get_global("wasmer_metering_remaining_points") {
+            let global = global.clone();
+            session.env.as_mut(&mut session.store).metering_remaining = Some(global);
+        }
 
         let apply_func = instance
             .exports
-            .get_typed_function::<(i64, i64, i64), ()>(&store, "apply")
+            .get_typed_function::<(i64, i64, i64), ()>(&session.store, "apply")
             .map_err(|_| ChainError::WasmRuntimeError(format!("failed to find apply function")))?;
 
         // Resume timer
@@ -471,7 +1026,7 @@ impl WasmRuntime {
 
         let result = apply_func
             .call(
-                &mut store,
+                &mut session.store,
                 receiver.as_u64() as i64,
                 action.account().as_u64() as i64,
                 action.name().as_u64() as i64,
@@ -485,7 +1040,27 @@ impl WasmRuntime {
                 // Otherwise wrap it
                 ChainError::ApplyError(format!("{}", e.message()))
             });
-        let remaining_points: MeteringPoints = get_remaining_points(&mut store, &instance);
+        let remaining_points: MeteringPoints =
+            get_remaining_points(&mut session.store, &instance);
+
+        // Taken out before the session is recycled; `reset_for` would clear
+        // it anyway on reuse.
+        let return_value = session.env.as_mut(&mut session.store).return_value.take();
+
+        // Recycle the session on the happy path. Errors drop it, and a store
+        // that has served many instantiations is retired because store-owned
+        // objects accumulate until the store itself is dropped.
+        session.uses += 1;
+        if result.is_ok() && session.uses < MAX_SESSION_USES {
+            let mut inner = self.inner.write()?;
+            let sessions = inner
+                .session_pool
+                .entry((id, module.tier, read_only))
+                .or_default();
+            if sessions.len() < MAX_POOLED_SESSIONS {
+                sessions.push(session);
+            }
+        }
 
         match remaining_points {
             MeteringPoints::Remaining(points) => {
@@ -494,7 +1069,7 @@ impl WasmRuntime {
                     return Err(e);
                 }
 
-                Ok(cpu_limit.saturating_sub(points) as u64)
+                Ok((cpu_limit.saturating_sub(points) as u64, return_value))
             }
             MeteringPoints::Exhausted => Err(ChainError::ApplyError(format!(
                 "CPU limit of {} exhausted during apply",
@@ -1,3 +1,4 @@
+use pulsevm_crypto::Bytes;
 use pulsevm_error::ChainError;
 use wasmer::{FunctionEnvMut, RuntimeError, WasmPtr};
 
@@ -47,7 +48,7 @@ pub fn set_action_return_value(
     buffer_ptr: WasmPtr<u8>,
     buffer_len: u32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
 
     let (env_data, store) = env.data_and_store_mut();
 
@@ -71,6 +72,13 @@ pub fn set_action_return_value(
     let slice = buffer_ptr.slice(&view, buffer_len)?;
     let mut return_value = vec![0u8; buffer_len as usize];
     slice.read_slice(&mut return_value)?;
-    env_data.set_action_return_value(return_value.into());
+    // The one copy on this path: wasm linear memory into the host buffer.
+    // Everything downstream — the apply context (digest and trace), the env
+    // (read-only call result) — shares this allocation by refcount.
+    let return_value: Bytes = return_value.into();
+    env_data
+        .apply_context()
+        .set_action_return_value(return_value.clone())?;
+    env_data.set_action_return_value(return_value);
     Ok(())
 }
@@ -2,8 +2,8 @@ use wasmer::{FunctionEnvMut, RuntimeError};
 
 use crate::chain::{wasm_runtime::WasmContext, webassembly::context_aware_check};
 
-pub fn require_auth(env: FunctionEnvMut<WasmContext>, account: u64) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+pub fn require_auth(mut env: FunctionEnvMut<WasmContext>, account: u64) -> Result<(), RuntimeError> {
+    context_aware_check(&mut env)?;
     let context = env.data().apply_context();
 
     if let Err(err) = context.require_authorization(&account.into(), None) {
@@ -13,8 +13,8 @@ pub fn require_auth(env: FunctionEnvMut<WasmContext>, account: u64) -> Result<()
     }
 }
 
-pub fn has_auth(env: FunctionEnvMut<WasmContext>, account: u64) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+pub fn has_auth(mut env: FunctionEnvMut<WasmContext>, account: u64) -> Result<i32, RuntimeError> {
+    context_aware_check(&mut env)?;
     let context = env.data().apply_context();
     let result = context.has_authorization(&account.into())?;
 
@@ -26,7 +26,7 @@ pub fn require_auth2(
     account: u64,
     permission: u64,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
 
     if let Err(err) = context.require_authorization(&account.into(), Some(permission.into())) {
@@ -40,7 +40,7 @@ pub fn require_recipient(
     mut env: FunctionEnvMut<WasmContext>,
     recipient: u64,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
 
     if let Err(err) = context.require_recipient(&recipient.into()) {
@@ -50,8 +50,8 @@ pub fn require_recipient(
     }
 }
 
-pub fn is_account(env: FunctionEnvMut<WasmContext>, recipient: u64) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+pub fn is_account(mut env: FunctionEnvMut<WasmContext>, recipient: u64) -> Result<i32, RuntimeError> {
+    context_aware_check(&mut env)?;
     let context = env.data().apply_context();
     let result = context.is_account(&recipient.into())?;
 
@@ -1,3 +1,9 @@
+use std::{
+    num::NonZeroUsize,
+    sync::{LazyLock, Mutex},
+};
+
+use lru::LruCache;
 use pulsevm_serialization::{Read, Write};
 use sha1::Digest as Sha1Digest;
 use wasmer::{FunctionEnvMut, RuntimeError, WasmPtr};
@@ -8,6 +14,46 @@ use crate::{
     utils::Digest,
 };
 
+// Multisig-heavy contracts recover the same (signature, digest) pairs on
+// every execution of a transaction — speculative admission, block packing
+// and acceptance — and secp256k1 recovery dominates those host calls.
+// Recovery is a pure function of its inputs, so results are cached
+// process-wide; the capacity comfortably covers the distinct recoveries of
+// the blocks in flight at any moment.
+const INTRINSIC_RECOVERY_CACHE_CAPACITY: usize = 8192;
+
+static INTRINSIC_RECOVERY_CACHE: LazyLock<Mutex<LruCache<(Vec<u8>, Vec<u8>), Vec<u8>>>> =
+    LazyLock::new(|| {
+        Mutex::new(LruCache::new(
+            NonZeroUsize::new(INTRINSIC_RECOVERY_CACHE_CAPACITY).unwrap(),
+        ))
+    });
+
+// Recovers the public key for `signature` over `digest`, consulting the
+// intrinsic recovery cache first. Returns the packed key, which is what both
+// host functions need. A poisoned cache lock is treated as a miss.
+fn recover_packed_key_cached(
+    sig_bytes: &[u8],
+    digest_bytes: &[u8],
+    signature: &Signature,
+    digest: &Digest,
+) -> Result<Vec<u8>, RuntimeError> {
+    let key = (sig_bytes.to_vec(), digest_bytes.to_vec());
+    if let Ok(mut cache) = INTRINSIC_RECOVERY_CACHE.lock() {
+        if let Some(packed) = cache.get(&key) {
+            return Ok(packed.clone());
+        }
+    }
+    let public_key = signature.recover_public_key(digest)?;
+    let packed = public_key
+        .pack()
+        .map_err(|e| RuntimeError::new(format!("failed to pack public key: {}", e)))?;
+    if let Ok(mut cache) = INTRINSIC_RECOVERY_CACHE.lock() {
+        cache.put(key, packed.clone());
+    }
+    Ok(packed)
+}
+
 pub fn assert_recover_key(
     mut env: FunctionEnvMut<WasmContext>,
     digest_ptr: WasmPtr<u8>,
@@ -38,9 +84,15 @@ pub fn assert_recover_key(
     let pubkey = PublicKey::read(pubkey_bytes.as_slice(), &mut 0).map_err(|e| {
         RuntimeError::new(format!("failed to read public key from wasm memory: {}", e))
     })?;
-    let recovered_pubkey = signature.recover_public_key(&digest)?;
+    let packed_recovered =
+        recover_packed_key_cached(&sig_bytes, &digest_bytes, &signature, &digest)?;
+    // Compare in packed form; packing is the canonical serialization, so
+    // this matches comparing the keys themselves.
+    let packed_expected = pubkey
+        .pack()
+        .map_err(|e| RuntimeError::new(format!("failed to pack public key: {}", e)))?;
 
-    if recovered_pubkey != pubkey {
+    if packed_recovered != packed_expected {
         return Err(RuntimeError::new(
             "assertion failed: recovered public key does not match expected public key",
         ));
@@ -73,10 +125,8 @@ pub fn recover_key(
     let mut digest_bytes = vec![0u8; 32];
     digest_slice.read_slice(&mut digest_bytes)?;
     let digest: Digest = Digest::from_data(&digest_bytes);
-    let public_key = signature.recover_public_key(&digest)?;
-    let packed_public_key = public_key
-        .pack()
-        .map_err(|e| RuntimeError::new(format!("failed to pack public key: {}", e)))?;
+    let packed_public_key =
+        recover_packed_key_cached(&sig_bytes, &digest_bytes, &signature, &digest)?;
     let copy_size = std::cmp::min(pub_len as usize, packed_public_key.len());
     let slice_out = pub_ptr.slice(&view, copy_size as u32)?;
     slice_out.write_slice(&packed_public_key[..copy_size])?;
@@ -399,3 +449,142 @@ pub fn assert_ripemd160(
 
     Ok(())
 }
+
+// Algorithm selectors for the incremental hashing intrinsics. Contracts
+// pass these to `hash_init`; the values are part of the host ABI and must
+// not be reordered.
+pub const HASH_ALGO_SHA1: u32 = 0;
+pub const HASH_ALGO_SHA224: u32 = 1;
+pub const HASH_ALGO_SHA256: u32 = 2;
+pub const HASH_ALGO_SHA512: u32 = 3;
+pub const HASH_ALGO_RIPEMD160: u32 = 4;
+
+// Streams a contract may hold open at once. Each state is a few hundred
+// bytes, so this bounds host memory without cramping legitimate use.
+const MAX_HASH_STREAMS: usize = 16;
+
+/// Host-side state of one incremental hashing stream.
+///
+/// The one-shot intrinsics (`sha256` and friends) force contracts to stage
+/// the whole payload contiguously in wasm memory just to hash it; the
+/// `hash_init`/`hash_update`/`hash_final` triple instead feeds chunks
+/// straight out of guest memory into state held here. Slots live on the
+/// `WasmContext` and are pooled: finalizing frees the slot for the next
+/// `hash_init` rather than growing the table, and the per-action reset
+/// drops whatever a misbehaving contract left open.
+pub enum HashStream {
+    Sha1(sha1::Sha1),
+    Sha224(sha2::Sha224),
+    Sha256(sha2::Sha256),
+    Sha512(sha2::Sha512),
+    Ripemd160(ripemd::Ripemd160),
+}
+
+impl HashStream {
+    fn new(algo: u32) -> Option<Self> {
+        match algo {
+            HASH_ALGO_SHA1 => Some(Self::Sha1(sha1::Sha1::new())),
+            HASH_ALGO_SHA224 => Some(Self::Sha224(sha2::Sha224::new())),
+            HASH_ALGO_SHA256 => Some(Self::Sha256(sha2::Sha256::new())),
+            HASH_ALGO_SHA512 => Some(Self::Sha512(sha2::Sha512::new())),
+            HASH_ALGO_RIPEMD160 => Some(Self::Ripemd160(ripemd::Ripemd160::new())),
+            _ => None,
+        }
+    }
+
+    fn update(&mut self, data: &[u8]) {
+        match self {
+            Self::Sha1(state) => state.update(data),
+            Self::Sha224(state) => state.update(data),
+            Self::Sha256(state) => state.update(data),
+            Self::Sha512(state) => state.update(data),
+            Self::Ripemd160(state) => state.update(data),
+        }
+    }
+
+    fn finalize(self) -> Vec<u8> {
+        match self {
+            Self::Sha1(state) => state.finalize().to_vec(),
+            Self::Sha224(state) => state.finalize().to_vec(),
+            Self::Sha256(state) => state.finalize().to_vec(),
+            Self::Sha512(state) => state.finalize().to_vec(),
+            Self::Ripemd160(state) => state.finalize().to_vec(),
+        }
+    }
+}
+
+pub fn hash_init(mut env: FunctionEnvMut<WasmContext>, algo: u32) -> Result<i32, RuntimeError> {
+    let stream = HashStream::new(algo)
+        .ok_or_else(|| RuntimeError::new(format!("unknown hash algorithm: {}", algo)))?;
+    let streams = env.data_mut().hash_streams_mut();
+
+    // Reuse a finalized slot before growing the pool.
+    if let Some(handle) = streams.iter().position(|slot| slot.is_none()) {
+        streams[handle] = Some(stream);
+        return Ok(handle as i32);
+    }
+    if streams.len() >= MAX_HASH_STREAMS {
+        return Err(RuntimeError::new("too many open hash streams"));
+    }
+    streams.push(Some(stream));
+    Ok((streams.len() - 1) as i32)
+}
+
+pub fn hash_update(
+    mut env: FunctionEnvMut<WasmContext>,
+    handle: i32,
+    data_ptr: WasmPtr<u8>,
+    data_size: u32,
+) -> Result<(), RuntimeError> {
+    let (env_data, store) = env.data_and_store_mut();
+    let memory = env_data
+        .memory()
+        .as_ref()
+        .ok_or_else(|| RuntimeError::new("Wasm memory not initialized"))?
+        .clone();
+    let view = memory.view(&store);
+
+    // Borrow the chunk from guest memory and feed it to the state
+    // directly; no staging copy on either side of the boundary.
+    let data_slice = data_ptr.slice(&view, data_size)?;
+    let data_access = data_slice
+        .access()
+        .map_err(|e| RuntimeError::new(format!("failed to access data pointer: {e}")))?;
+
+    let stream = env_data
+        .hash_streams_mut()
+        .get_mut(handle as usize)
+        .and_then(|slot| slot.as_mut())
+        .ok_or_else(|| RuntimeError::new("invalid hash stream handle"))?;
+    stream.update(data_access.as_ref());
+
+    Ok(())
+}
+
+pub fn hash_final(
+    mut env: FunctionEnvMut<WasmContext>,
+    handle: i32,
+    out_ptr: WasmPtr<u8>,
+    out_len: u32,
+) -> Result<i32, RuntimeError> {
+    let (env_data, store) = env.data_and_store_mut();
+    let memory = env_data
+        .memory()
+        .as_ref()
+        .ok_or_else(|| RuntimeError::new("Wasm memory not initialized"))?
+        .clone();
+
+    // Taking the stream frees its slot for the next `hash_init`.
+    let stream = env_data
+        .hash_streams_mut()
+        .get_mut(handle as usize)
+        .and_then(|slot| slot.take())
+        .ok_or_else(|| RuntimeError::new("invalid hash stream handle"))?;
+    let digest = stream.finalize();
+
+    let view = memory.view(&store);
+    let copy_size = std::cmp::min(out_len as usize, digest.len());
+    let slice_out = out_ptr.slice(&view, copy_size as u32)?;
+    slice_out.write_slice(&digest[..copy_size])?;
+    Ok(digest.len() as i32)
+}
@@ -16,7 +16,7 @@ pub fn db_find_i64(
     table: u64,
     id: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     let result = context.db_find_i64(code, scope, table, id)?;
     Ok(result)
@@ -31,7 +31,7 @@ pub fn db_store_i64(
     buffer_ptr: WasmPtr<u8>,
     buffer_len: u32,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -55,18 +55,25 @@ pub fn db_get_i64(
     buffer_ptr: WasmPtr<u8>,
     buffer_len: u32,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
         .as_ref()
         .expect("Wasm memory not initialized");
     let view = memory.view(&store);
-    let slice = buffer_ptr.slice(&view, buffer_len)?;
-    let mut dest_bytes = vec![0u8; buffer_len as usize];
     let context = env_data.apply_context();
-    let result = context.db_get_i64(itr, &mut dest_bytes, buffer_len as usize)?;
-    slice.write_slice(&dest_bytes)?;
+    // Single copy: the row value goes from the chainbase-borrowed view
+    // straight into wasm linear memory, with no intermediate buffer.
+    let result = context.db_get_i64_with(itr, |value| -> Result<i32, RuntimeError> {
+        if buffer_len == 0 {
+            return Ok(value.len() as i32);
+        }
+        let copy_size = core::cmp::min(buffer_len as usize, value.len());
+        let slice = buffer_ptr.slice(&view, copy_size as u32)?;
+        slice.write_slice(&value[..copy_size])?;
+        Ok(copy_size as i32)
+    })??;
     Ok(result)
 }
 
@@ -77,7 +84,7 @@ pub fn db_update_i64(
     buffer_ptr: WasmPtr<u8>,
     buffer_len: u32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -96,7 +103,7 @@ pub fn db_update_i64(
 }
 
 pub fn db_remove_i64(mut env: FunctionEnvMut<WasmContext>, itr: i32) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     context.db_remove_i64(itr)?;
     Ok(())
@@ -107,7 +114,7 @@ pub fn db_next_i64(
     itr: i32,
     primary_ptr: WasmPtr<u8>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     let mut next_primary = 0u64;
     let res = context.db_next_i64(itr, &mut next_primary)?;
@@ -132,7 +139,7 @@ pub fn db_previous_i64(
     itr: i32,
     primary_ptr: WasmPtr<u8>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     let mut next_primary = 0u64;
     let res = context.db_previous_i64(itr, &mut next_primary)?;
@@ -159,7 +166,7 @@ pub fn db_lowerbound_i64(
     table: u64,
     primary: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     let res = context.db_lowerbound_i64(code.into(), scope.into(), table.into(), primary)?;
     Ok(res)
@@ -172,7 +179,7 @@ pub fn db_upperbound_i64(
     table: u64,
     primary: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     let res = context.db_upperbound_i64(code.into(), scope.into(), table.into(), primary)?;
     Ok(res)
@@ -184,11 +191,119 @@ pub fn db_end_i64(
     scope: u64,
     table: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     Ok(context.db_end_i64(code.into(), scope.into(), table.into())?)
 }
 
+/// Hint that the contract is about to scan `[lower, upper]` of the given
+/// table: rows are materialized into the iterator cache and the readahead
+/// buffer ahead of the lowerbound/next walk. Has no observable effect on
+/// iteration results.
+pub fn db_prefetch_range(
+    mut env: FunctionEnvMut<WasmContext>,
+    code: u64,
+    scope: u64,
+    table: u64,
+    lower: u64,
+    upper: u64,
+) -> Result<(), RuntimeError> {
+    context_aware_check(&mut env)?;
+    let context = env.data_mut().apply_context_mut();
+    context.db_prefetch_range(code, scope, table, lower, upper)?;
+    Ok(())
+}
+
+// Upper bound on rows one `db_multi_get` call may resolve, so a single host
+// call cannot be asked for an unbounded amount of work.
+const DB_MULTI_GET_MAX_ROWS: u32 = 256;
+
+/// Batched point lookup: resolves one row of `code`/`table` per
+/// `(scope, key)` pair in a single host call, with results identical to a
+/// sequential `db_find_i64` + `db_get_i64` per pair. Entries are packed
+/// into `buffer_ptr` in pair order as a little-endian `u32` length followed
+/// by the row bytes; a missing row packs the length `0xffffffff` and no
+/// bytes. Returns the total packed size. Call with `buffer_len == 0` to
+/// size the buffer first; a non-zero buffer too small for the full result
+/// traps, so a contract never sees a truncated entry.
+pub fn db_multi_get(
+    mut env: FunctionEnvMut<WasmContext>,
+    code: u64,
+    table: u64,
+    scopes_ptr: WasmPtr<u64>,
+    keys_ptr: WasmPtr<u64>,
+    count: u32,
+    buffer_ptr: WasmPtr<u8>,
+    buffer_len: u32,
+) -> Result<i32, RuntimeError> {
+    context_aware_check(&mut env)?;
+    if count > DB_MULTI_GET_MAX_ROWS {
+        return Err(RuntimeError::new(format!(
+            "db_multi_get row count {} exceeds the limit of {}",
+            count, DB_MULTI_GET_MAX_ROWS
+        )));
+    }
+    let (env_data, store) = env.data_and_store_mut();
+
+    // Clone the memory handle so the borrow on env_data is released
+    let memory = env_data
+        .memory()
+        .as_ref()
+        .expect("Wasm memory not initialized")
+        .clone();
+    let view = memory.view(&store);
+
+    let mut scopes = vec![0u64; count as usize];
+    scopes_ptr.slice(&view, count)?.read_slice(&mut scopes)?;
+    let mut keys = vec![0u64; count as usize];
+    keys_ptr.slice(&view, count)?.read_slice(&mut keys)?;
+
+    let context = env_data.apply_context_mut();
+
+    // Resolve every pair up front: the finds populate the iterator cache,
+    // so the size and copy passes below never cross the bridge again.
+    let mut iterators = Vec::with_capacity(count as usize);
+    for (&scope, &key) in scopes.iter().zip(keys.iter()) {
+        iterators.push(context.db_find_i64(code, scope, table, key)?);
+    }
+
+    let mut total: usize = 0;
+    for &itr in &iterators {
+        total += 4;
+        if itr >= 0 {
+            total += context.db_get_i64_with(itr, |value| value.len())?;
+        }
+    }
+    if buffer_len == 0 {
+        return Ok(total as i32);
+    }
+    if (buffer_len as usize) < total {
+        return Err(RuntimeError::new(format!(
+            "db_multi_get buffer of {} bytes cannot hold the {} byte result",
+            buffer_len, total
+        )));
+    }
+
+    let base = buffer_ptr.offset() as u64;
+    let mut offset: u64 = 0;
+    for &itr in &iterators {
+        if itr < 0 {
+            view.write(base + offset, &u32::MAX.to_le_bytes())?;
+            offset += 4;
+            continue;
+        }
+        // Single copy per row, straight from the chainbase-borrowed view
+        // into wasm linear memory.
+        let len = context.db_get_i64_with(itr, |value| -> Result<usize, RuntimeError> {
+            view.write(base + offset, &(value.len() as u32).to_le_bytes())?;
+            view.write(base + offset + 4, value)?;
+            Ok(value.len())
+        })??;
+        offset += 4 + len as u64;
+    }
+    Ok(total as i32)
+}
+
 pub fn db_idx64_store(
     mut env: FunctionEnvMut<WasmContext>,
     scope: u64,
@@ -197,7 +312,7 @@ pub fn db_idx64_store(
     id: u64,
     secondary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -216,7 +331,7 @@ pub fn db_idx64_update(
     payer: u64,
     secondary_ptr: WasmPtr<u64>,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -231,7 +346,7 @@ pub fn db_idx64_update(
 }
 
 pub fn db_idx64_remove(mut env: FunctionEnvMut<WasmContext>, itr: i32) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     context.db_idx64_remove(itr)?;
     Ok(())
@@ -245,7 +360,7 @@ pub fn db_idx64_find_secondary(
     secondary_ptr: WasmPtr<u64>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -284,7 +399,7 @@ pub fn db_idx64_find_primary(
     secondary_ptr: WasmPtr<u64>,
     primary: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -320,7 +435,7 @@ pub fn db_idx64_lowerbound(
     secondary_ptr: WasmPtr<u64>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -360,7 +475,7 @@ pub fn db_idx64_upperbound(
     secondary_ptr: WasmPtr<u64>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -398,7 +513,7 @@ pub fn db_idx64_end(
     scope: u64,
     table: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     Ok(context.db_idx64_end(code.into(), scope.into(), table.into())?)
 }
@@ -408,7 +523,7 @@ pub fn db_idx64_next(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -428,7 +543,7 @@ pub fn db_idx64_previous(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -451,7 +566,7 @@ pub fn db_idx128_store(
     id: u64,
     secondary_ptr: WasmPtr<u128>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -470,7 +585,7 @@ pub fn db_idx128_update(
     payer: u64,
     secondary_ptr: WasmPtr<u128>,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -488,7 +603,7 @@ pub fn db_idx128_remove(
     mut env: FunctionEnvMut<WasmContext>,
     itr: i32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     context.db_idx128_remove(itr)?;
     Ok(())
@@ -502,7 +617,7 @@ pub fn db_idx128_find_secondary(
     secondary_ptr: WasmPtr<u128>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -541,7 +656,7 @@ pub fn db_idx128_find_primary(
     secondary_ptr: WasmPtr<u128>,
     primary: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -577,7 +692,7 @@ pub fn db_idx128_lowerbound(
     secondary_ptr: WasmPtr<u128>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -617,7 +732,7 @@ pub fn db_idx128_upperbound(
     secondary_ptr: WasmPtr<u128>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -655,7 +770,7 @@ pub fn db_idx128_end(
     scope: u64,
     table: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     Ok(context.db_idx128_end(code.into(), scope.into(), table.into())?)
 }
@@ -665,7 +780,7 @@ pub fn db_idx128_next(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -685,7 +800,7 @@ pub fn db_idx128_previous(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -709,7 +824,7 @@ pub fn db_idx256_store(
     secondary_ptr: WasmPtr<u8>,
     _secondary_len: u32,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -729,7 +844,7 @@ pub fn db_idx256_update(
     secondary_ptr: WasmPtr<u8>,
     _secondary_len: u32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -747,7 +862,7 @@ pub fn db_idx256_remove(
     mut env: FunctionEnvMut<WasmContext>,
     itr: i32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     context.db_idx256_remove(itr)?;
     Ok(())
@@ -762,7 +877,7 @@ pub fn db_idx256_find_secondary(
     _secondary_len: u32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -802,7 +917,7 @@ pub fn db_idx256_find_primary(
     _secondary_len: u32,
     primary: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -839,7 +954,7 @@ pub fn db_idx256_lowerbound(
     _secondary_len: u32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -880,7 +995,7 @@ pub fn db_idx256_upperbound(
     _secondary_len: u32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -918,7 +1033,7 @@ pub fn db_idx256_end(
     scope: u64,
     table: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     Ok(context.db_idx256_end(code.into(), scope.into(), table.into())?)
 }
@@ -928,7 +1043,7 @@ pub fn db_idx256_next(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -948,7 +1063,7 @@ pub fn db_idx256_previous(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -971,7 +1086,7 @@ pub fn db_idx_double_store(
     id: u64,
     secondary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -990,7 +1105,7 @@ pub fn db_idx_double_update(
     payer: u64,
     secondary_ptr: WasmPtr<u64>,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -1008,7 +1123,7 @@ pub fn db_idx_double_remove(
     mut env: FunctionEnvMut<WasmContext>,
     itr: i32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     context.db_idx_double_remove(itr)?;
     Ok(())
@@ -1022,7 +1137,7 @@ pub fn db_idx_double_find_secondary(
     secondary_ptr: WasmPtr<u64>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1061,7 +1176,7 @@ pub fn db_idx_double_find_primary(
     secondary_ptr: WasmPtr<u64>,
     primary: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1097,7 +1212,7 @@ pub fn db_idx_double_lowerbound(
     secondary_ptr: WasmPtr<u64>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1137,7 +1252,7 @@ pub fn db_idx_double_upperbound(
     secondary_ptr: WasmPtr<u64>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1175,7 +1290,7 @@ pub fn db_idx_double_end(
     scope: u64,
     table: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     Ok(context.db_idx_double_end(code.into(), scope.into(), table.into())?)
 }
@@ -1185,7 +1300,7 @@ pub fn db_idx_double_next(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -1205,7 +1320,7 @@ pub fn db_idx_double_previous(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -1228,7 +1343,7 @@ pub fn db_idx_long_double_store(
     id: u64,
     secondary_ptr: WasmPtr<u8>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -1247,7 +1362,7 @@ pub fn db_idx_long_double_update(
     payer: u64,
     secondary_ptr: WasmPtr<u8>,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -1265,7 +1380,7 @@ pub fn db_idx_long_double_remove(
     mut env: FunctionEnvMut<WasmContext>,
     itr: i32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     context.db_idx_long_double_remove(itr)?;
     Ok(())
@@ -1279,7 +1394,7 @@ pub fn db_idx_long_double_find_secondary(
     secondary_ptr: WasmPtr<u8>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1318,7 +1433,7 @@ pub fn db_idx_long_double_find_primary(
     secondary_ptr: WasmPtr<u8>,
     primary: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1354,7 +1469,7 @@ pub fn db_idx_long_double_lowerbound(
     secondary_ptr: WasmPtr<u8>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1394,7 +1509,7 @@ pub fn db_idx_long_double_upperbound(
     secondary_ptr: WasmPtr<u8>,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
 
     // Clone the memory handle so the borrow on env_data is released
@@ -1432,7 +1547,7 @@ pub fn db_idx_long_double_end(
     scope: u64,
     table: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     Ok(context.db_idx_long_double_end(code.into(), scope.into(), table.into())?)
 }
@@ -1442,7 +1557,7 @@ pub fn db_idx_long_double_next(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -1462,7 +1577,7 @@ pub fn db_idx_long_double_previous(
     itr: i32,
     primary_ptr: WasmPtr<u64>,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
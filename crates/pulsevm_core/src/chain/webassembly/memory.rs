@@ -1,7 +1,33 @@
-use wasmer::{FunctionEnvMut, RuntimeError, WasmPtr};
+use wasmer::{FunctionEnvMut, MemoryView, RuntimeError, WasmPtr};
 
 use crate::wasm_runtime::WasmContext;
 
+// The memory builtins run on every serialized-state copy a contract makes,
+// so they work directly on the linear memory instead of staging through
+// heap-allocated scratch buffers. `copy_within`, `fill` and slice `cmp`
+// lower to the platform's vectorized memmove/memset/memcmp, which also
+// covers the small fixed sizes (16/64 bytes) contracts copy most often.
+//
+// Safety of the direct access: a host function executes while the calling
+// wasm instance is suspended on this thread, the store is not shared across
+// threads, and no other view borrow is live, so the linear memory cannot be
+// concurrently read, written, or grown.
+
+/// Validates `offset + len` against the view and returns it as a usize range.
+#[inline]
+fn checked_range(
+    view: &MemoryView,
+    offset: u32,
+    len: u32,
+    what: &str,
+) -> Result<std::ops::Range<usize>, RuntimeError> {
+    let end = offset as u64 + len as u64;
+    if end > view.data_size() {
+        return Err(RuntimeError::new(format!("{what}: invalid range")));
+    }
+    Ok(offset as usize..end as usize)
+}
+
 #[inline]
 pub fn memmove(
     mut env: FunctionEnvMut<WasmContext>,
@@ -20,21 +46,12 @@ pub fn memmove(
         .ok_or_else(|| RuntimeError::new("Wasm memory not initialized"))?;
     let view = memory.view(&store);
 
-    // Bounds-check both ranges before allocating anything. `slice` uses checked
-    // arithmetic, so offset + len near u32::MAX cannot wrap into a valid range.
-    let src = src_ptr
-        .slice(&view, src_size)
-        .map_err(|e| RuntimeError::new(format!("memmove: invalid source range: {e}")))?;
-    let dest = dest_ptr
-        .slice(&view, src_size)
-        .map_err(|e| RuntimeError::new(format!("memmove: invalid destination range: {e}")))?;
-
-    // Safe to allocate now: src_size is bounded by linear memory size.
-    let mut buf = vec![0u8; src_size as usize];
-    src.read_slice(&mut buf)
-        .map_err(|e| RuntimeError::new(format!("memmove: read failed: {e}")))?;
-    dest.write_slice(&buf)
-        .map_err(|e| RuntimeError::new(format!("memmove: write failed: {e}")))?;
+    let src = checked_range(&view, src_ptr.offset(), src_size, "memmove: source")?;
+    let dest = checked_range(&view, dest_ptr.offset(), src_size, "memmove: destination")?;
+
+    // Safety: see module comment.
+    let data = unsafe { view.data_unchecked_mut() };
+    data.copy_within(src, dest.start);
 
     Ok(dest_ptr)
 }
@@ -66,21 +83,13 @@ pub fn memcpy(
         .ok_or_else(|| RuntimeError::new("Wasm memory not initialized"))?;
     let view = memory.view(&store);
 
-    // Bounds-check both ranges before allocating anything. `slice` uses checked
-    // arithmetic, so offset + len near u32::MAX cannot wrap into a valid range.
-    let src = src_ptr
-        .slice(&view, src_size)
-        .map_err(|e| RuntimeError::new(format!("memcpy: invalid source range: {e}")))?;
-    let dest = dest_ptr
-        .slice(&view, src_size)
-        .map_err(|e| RuntimeError::new(format!("memcpy: invalid destination range: {e}")))?;
-
-    // Safe to allocate now: src_size is bounded by linear memory size.
-    let mut buf = vec![0u8; src_size as usize];
-    src.read_slice(&mut buf)
-        .map_err(|e| RuntimeError::new(format!("memcpy: read failed: {e}")))?;
-    dest.write_slice(&buf)
-        .map_err(|e| RuntimeError::new(format!("memcpy: write failed: {e}")))?;
+    let src = checked_range(&view, src_ptr.offset(), src_size, "memcpy: source")?;
+    let dest = checked_range(&view, dest_ptr.offset(), src_size, "memcpy: destination")?;
+
+    // Safety: see module comment. The ranges are disjoint (checked above),
+    // but copy_within tolerates overlap anyway.
+    let data = unsafe { view.data_unchecked_mut() };
+    data.copy_within(src, dest.start);
 
     Ok(dest_ptr)
 }
@@ -103,17 +112,12 @@ pub fn memset(
         .ok_or_else(|| RuntimeError::new("Wasm memory not initialized"))?;
     let view = memory.view(&store);
 
-    // Bounds-check before allocating anything. `slice` uses checked arithmetic,
-    // so offset + len near u32::MAX cannot wrap into a valid range.
-    let dest = dest_ptr
-        .slice(&view, size)
-        .map_err(|e| RuntimeError::new(format!("memset: invalid destination range: {e}")))?;
+    let dest = checked_range(&view, dest_ptr.offset(), size, "memset: destination")?;
 
     // std::memset semantics: int -> unsigned char (low byte only).
-    // Safe to allocate now: size is bounded by linear memory size.
-    let buf = vec![value as u8; size as usize];
-    dest.write_slice(&buf)
-        .map_err(|e| RuntimeError::new(format!("memset: write failed: {e}")))?;
+    // Safety: see module comment.
+    let data = unsafe { view.data_unchecked_mut() };
+    data[dest].fill(value as u8);
 
     Ok(dest_ptr)
 }
@@ -136,26 +140,15 @@ pub fn memcmp(
         .ok_or_else(|| RuntimeError::new("Wasm memory not initialized"))?;
     let view = memory.view(&store);
 
-    // Bounds-check both ranges before allocating anything. `slice` uses checked
-    // arithmetic, so offset + len near u32::MAX cannot wrap into a valid range.
-    let dest = dest_ptr
-        .slice(&view, length)
-        .map_err(|e| RuntimeError::new(format!("memcmp: invalid destination range: {e}")))?;
-    let src = src_ptr
-        .slice(&view, length)
-        .map_err(|e| RuntimeError::new(format!("memcmp: invalid source range: {e}")))?;
-
-    // Safe to allocate now: length is bounded by linear memory size.
-    let mut dest_buf = vec![0u8; length as usize];
-    dest.read_slice(&mut dest_buf)
-        .map_err(|e| RuntimeError::new(format!("memcmp: read failed: {e}")))?;
-    let mut src_buf = vec![0u8; length as usize];
-    src.read_slice(&mut src_buf)
-        .map_err(|e| RuntimeError::new(format!("memcmp: read failed: {e}")))?;
+    let dest = checked_range(&view, dest_ptr.offset(), length, "memcmp: destination")?;
+    let src = checked_range(&view, src_ptr.offset(), length, "memcmp: source")?;
+
+    // Safety: see module comment.
+    let data = unsafe { view.data_unchecked() };
 
     // Normalized to -1/0/1, matching nodeos (raw memcmp magnitude is
     // implementation-defined and would be a determinism leak)
-    Ok(match dest_buf.cmp(&src_buf) {
+    Ok(match data[dest].cmp(&data[src]) {
         std::cmp::Ordering::Less => -1,
         std::cmp::Ordering::Equal => 0,
         std::cmp::Ordering::Greater => 1,
@@ -31,15 +31,19 @@ pub use privileged::*;
 mod producer;
 pub use producer::*;
 
+// Not glob-exported: the stubs deliberately share the names of the intrinsics
+// they replace for read-only calls.
+pub mod read_only;
+
 mod system;
 use pulsevm_ffi::{Float128, I128, U128, U256};
 pub use system::*;
 
 mod transaction;
 pub use transaction::*;
-use wasmer::{FunctionEnvMut, MemoryView, RuntimeError, WasmPtr};
+use wasmer::{FunctionEnvMut, MemoryView, RuntimeError, Value, WasmPtr};
 
-use crate::wasm_runtime::WasmContext;
+use crate::{metrics::METRICS, wasm_runtime::WasmContext};
 
 fn read_u64(view: &MemoryView, ptr: WasmPtr<u64>) -> Result<u64, RuntimeError> {
     let mut bytes = [0u8; 8];
@@ -113,7 +117,23 @@ fn write_float128(view: &MemoryView, ptr: WasmPtr<u8>, val: Float128) -> Result<
     Ok(())
 }
 
-pub fn context_aware_check(env: &FunctionEnvMut<WasmContext>) -> Result<(), RuntimeError> {
+pub fn context_aware_check(env: &mut FunctionEnvMut<WasmContext>) -> Result<(), RuntimeError> {
+    // Every stateful intrinsic funnels through this check, so it doubles as
+    // the counting point for host-call metrics, both node-wide and
+    // per-action.
+    METRICS.count_host_call();
+    env.data().apply_context().count_host_call();
+    // Host calls are also the metering checkpoint: sampling the Metering
+    // middleware's remaining-points global here publishes in-flight gas for
+    // watchdogs and scrapes without touching the metered instruction stream
+    // (any instrumentation injected into the wasm itself would change gas
+    // accounting and invalidate cached artifacts). One global read and one
+    // relaxed store, so the hot dispatch path pays essentially nothing.
+    if let Some(global) = env.data().metering_remaining().clone() {
+        if let Value::I64(points) = global.get(env) {
+            METRICS.set_wasm_remaining_points(points.max(0) as u64);
+        }
+    }
     if env.data().apply_context().is_context_free() {
         return Err(RuntimeError::new(
             "cannot call this function from a context-free action",
@@ -1,6 +1,6 @@
 use std::collections::BTreeSet;
 
-use pulsevm_ffi::{PermissionLevel, microseconds, seconds};
+use pulsevm_ffi::{BlockTimestamp, PermissionLevel, microseconds, seconds};
 use pulsevm_serialization::Read;
 use wasmer::{FunctionEnvMut, RuntimeError, WasmPtr};
 
@@ -18,7 +18,7 @@ pub fn check_transaction_authorization(
     perms_ptr: WasmPtr<u8>,
     perms_length: u32,
 ) -> Result<u32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let memory = env_data
         .memory()
@@ -97,7 +97,7 @@ pub fn check_permission_authorization(
     perms_size: u32,
     delay_us: u64,
 ) -> Result<u32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     // EOS_ASSERT: delay must fit in an i64.
     if delay_us > i64::MAX as u64 {
         return Err(RuntimeError::new("provided delay is too large"));
@@ -155,11 +155,11 @@ pub fn check_permission_authorization(
 }
 
 pub fn get_permission_last_used(
-    env: FunctionEnvMut<WasmContext>,
+    mut env: FunctionEnvMut<WasmContext>,
     account: u64,
     permission: u64,
 ) -> Result<i64, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let env_data = env.data();
     let db = env_data.db();
     let permission = AuthorizationManager::get_permission(db, account, permission)?;
@@ -168,16 +168,15 @@ pub fn get_permission_last_used(
 }
 
 pub fn get_account_creation_time(
-    env: FunctionEnvMut<WasmContext>,
+    mut env: FunctionEnvMut<WasmContext>,
     account: u64,
 ) -> Result<i64, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let env_data = env.data();
     let db = env_data.db();
     let account = db.get_account(account)?;
-    Ok(account
-        .get_creation_date()
-        .to_time_point()
-        .time_since_epoch()
-        .count())
+    // Pull only the slot across the bridge; the slot-to-microseconds
+    // conversion is pure Rust and allocation-free.
+    let creation: BlockTimestamp = account.get_creation_date().into();
+    Ok(creation.to_time_point().time_since_epoch().count())
 }
@@ -22,7 +22,7 @@ pub fn set_proposed_producers(
     _data_ptr: WasmPtr<u8>,
     _data_len: u32,
 ) -> Result<i64, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     privileged_check(context)?;
     // TODO: Implement set_proposed_producers logic
@@ -34,7 +34,7 @@ pub fn get_blockchain_parameters_packed(
     _data_ptr: WasmPtr<u8>,
     _data_len: u32,
 ) -> Result<u32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     privileged_check(context)?;
     Ok(0)
@@ -46,7 +46,7 @@ pub fn set_blockchain_parameters_packed(
     data_len: u32,
 ) -> Result<(), RuntimeError> {
     {
-        context_aware_check(&env)?;
+        context_aware_check(&mut env)?;
         let context = env.data_mut().apply_context_mut();
         privileged_check(context)?;
     }
@@ -72,7 +72,7 @@ pub fn is_privileged(
     mut env: FunctionEnvMut<WasmContext>,
     account: u64,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     privileged_check(context)?;
     let db = env.data().db();
@@ -86,7 +86,7 @@ pub fn set_privileged(
     account: u64,
     is_priv: i32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let context = env.data_mut().apply_context_mut();
     privileged_check(context)?;
     context.set_privileged(account, is_priv == 1)?;
@@ -100,7 +100,7 @@ pub fn set_resource_limits(
     net_weight: i64,
     cpu_weight: i64,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     pulse_assert(
         ram_bytes >= -1,
         ChainError::WasmRuntimeError(format!(
@@ -140,7 +140,7 @@ pub fn get_resource_limits(
     net_weight_ptr: WasmPtr<u8>,
     cpu_weight_ptr: WasmPtr<u8>,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     let (env_data, store) = env.data_and_store_mut();
     let context = env_data.apply_context_mut();
     privileged_check(context)?;
@@ -3,11 +3,11 @@ use wasmer::{FunctionEnvMut, RuntimeError, WasmPtr};
 use crate::{chain::webassembly::context_aware_check, wasm_runtime::WasmContext};
 
 pub fn get_active_producers(
-    env: FunctionEnvMut<WasmContext>,
+    mut env: FunctionEnvMut<WasmContext>,
     _data_ptr: WasmPtr<u8>,
     _data_len: u32,
 ) -> Result<i32, RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     // TODO: Implement get_active_producers logic
     Ok(0)
 }
@@ -0,0 +1,55 @@
+use wasmer::{FunctionEnvMut, RuntimeError, WasmPtr};
+
+use crate::wasm_runtime::WasmContext;
+
+// Stubs bound in place of the state-mutating intrinsics when a module is
+// instantiated for a read-only call. Read-only calls run without an undo
+// session, so a write reaching the database could never be rolled back;
+// replacing the bindings at import time makes the write paths unreachable
+// instead of relying on a runtime flag inside each host function. Every stub
+// keeps the signature of the intrinsic it shadows (the import is typed) and
+// traps with a message naming the rejected call.
+
+macro_rules! read_only_stubs {
+    ($( fn $name:ident ( $( $arg:ident : $ty:ty ),* ) -> $ret:ty; )*) => {
+        $(
+            #[allow(unused_variables)]
+            pub fn $name(
+                env: FunctionEnvMut<WasmContext>,
+                $( $arg: $ty, )*
+            ) -> Result<$ret, RuntimeError> {
+                Err(RuntimeError::new(concat!(
+                    stringify!($name),
+                    " is not allowed in a read-only call"
+                )))
+            }
+        )*
+    };
+}
+
+read_only_stubs! {
+    fn db_store_i64(scope: u64, table: u64, payer: u64, id: u64, buffer_ptr: WasmPtr<u8>, buffer_len: u32) -> i32;
+    fn db_update_i64(itr: i32, payer: u64, buffer_ptr: WasmPtr<u8>, buffer_len: u32) -> ();
+    fn db_remove_i64(itr: i32) -> ();
+    fn db_idx64_store(scope: u64, table: u64, payer: u64, id: u64, secondary_ptr: WasmPtr<u64>) -> i32;
+    fn db_idx64_update(itr: i32, payer: u64, secondary_ptr: WasmPtr<u64>) -> ();
+    fn db_idx64_remove(itr: i32) -> ();
+    fn db_idx128_store(scope: u64, table: u64, payer: u64, id: u64, secondary_ptr: WasmPtr<u128>) -> i32;
+    fn db_idx128_update(itr: i32, payer: u64, secondary_ptr: WasmPtr<u128>) -> ();
+    fn db_idx128_remove(itr: i32) -> ();
+    fn db_idx256_store(scope: u64, table: u64, payer: u64, id: u64, secondary_ptr: WasmPtr<u8>, secondary_len: u32) -> i32;
+    fn db_idx256_update(itr: i32, payer: u64, secondary_ptr: WasmPtr<u8>, secondary_len: u32) -> ();
+    fn db_idx256_remove(itr: i32) -> ();
+    fn db_idx_double_store(scope: u64, table: u64, payer: u64, id: u64, secondary_ptr: WasmPtr<u64>) -> i32;
+    fn db_idx_double_update(itr: i32, payer: u64, secondary_ptr: WasmPtr<u64>) -> ();
+    fn db_idx_double_remove(itr: i32) -> ();
+    fn db_idx_long_double_store(scope: u64, table: u64, payer: u64, id: u64, secondary_ptr: WasmPtr<u8>) -> i32;
+    fn db_idx_long_double_update(itr: i32, payer: u64, secondary_ptr: WasmPtr<u8>) -> ();
+    fn db_idx_long_double_remove(itr: i32) -> ();
+    fn send_inline(ptr: WasmPtr<u8>, length: u32) -> ();
+    fn send_context_free_inline(ptr: WasmPtr<u8>, length: u32) -> ();
+    fn set_privileged(account: u64, is_priv: i32) -> ();
+    fn set_resource_limits(account: u64, ram_bytes: i64, net_weight: i64, cpu_weight: i64) -> ();
+    fn set_proposed_producers(data_ptr: WasmPtr<u8>, data_len: u32) -> i64;
+    fn set_blockchain_parameters_packed(data_ptr: WasmPtr<u8>, data_len: u32) -> ();
+}
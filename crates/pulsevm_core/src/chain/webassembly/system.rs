@@ -144,8 +144,8 @@ pub fn abort(_env: FunctionEnvMut<WasmContext>) -> Result<(), RuntimeError> {
     return Err(RuntimeError::new("abort called"));
 }
 
-pub fn current_time(env: FunctionEnvMut<WasmContext>) -> Result<u64, RuntimeError> {
-    context_aware_check(&env)?;
+pub fn current_time(mut env: FunctionEnvMut<WasmContext>) -> Result<u64, RuntimeError> {
+    context_aware_check(&mut env)?;
     let result = env
         .data()
         .pending_block_timestamp()
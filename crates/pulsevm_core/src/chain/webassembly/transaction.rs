@@ -12,7 +12,7 @@ pub fn send_inline(
     ptr: WasmPtr<u8>,
     length: u32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
 
     {
         let (env_data, _) = env.data_and_store_mut();
@@ -47,7 +47,7 @@ pub fn send_context_free_inline(
     ptr: WasmPtr<u8>,
     length: u32,
 ) -> Result<(), RuntimeError> {
-    context_aware_check(&env)?;
+    context_aware_check(&mut env)?;
     {
         let (env_data, _) = env.data_and_store_mut();
         let mut db = env_data.db_mut();
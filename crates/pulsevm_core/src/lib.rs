@@ -3,3 +3,5 @@ pub use chain::*;
 
 // Re-export database
 pub use pulsevm_ffi::Database;
+// FFI bridge cycle counters, served by the RPC layer.
+pub use pulsevm_ffi::ffi_stats;
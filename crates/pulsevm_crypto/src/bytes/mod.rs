@@ -1,15 +1,24 @@
 use core::fmt;
+use core::ops::RangeBounds;
 
 use pulsevm_serialization::{NumBytes, Read, ReadError, Write};
 use serde::{Deserialize, Serialize};
 
+use ::bytes::Bytes as SharedBuf;
+
+/// Immutable byte buffer backed by a refcounted allocation.
+///
+/// `Clone` bumps a reference count and [`Bytes::slice`] returns a view
+/// into the same allocation, so a payload can flow from the network
+/// buffer through the mempool, execution, and trace storage without
+/// being copied at each hand-off.
 #[derive(Debug, Clone, PartialEq, Eq, Hash, Default)]
-pub struct Bytes(pub Vec<u8>);
+pub struct Bytes(SharedBuf);
 
 impl Bytes {
     #[inline]
     pub fn new(data: Vec<u8>) -> Self {
-        Bytes(data)
+        Bytes(SharedBuf::from(data))
     }
 
     #[inline]
@@ -31,12 +40,25 @@ impl Bytes {
     pub fn as_ref(&self) -> &[u8] {
         &self.0
     }
+
+    /// Returns a sub-range of this buffer sharing the same allocation.
+    #[inline]
+    pub fn slice(&self, range: impl RangeBounds<usize>) -> Self {
+        Bytes(self.0.slice(range))
+    }
+
+    /// Converts into an owned `Vec<u8>`, reclaiming the allocation without
+    /// a copy when this is the only handle to it.
+    #[inline]
+    pub fn into_vec(self) -> Vec<u8> {
+        self.0.into()
+    }
 }
 
 impl fmt::Display for Bytes {
     #[inline]
     fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
-        hex::encode(self.0.as_slice()).fmt(f)
+        hex::encode(self.0.as_ref()).fmt(f)
     }
 }
 
@@ -59,21 +81,28 @@ impl<'de> Deserialize<'de> for Bytes {
     {
         let hex_string = String::deserialize(deserializer)?;
         let bytes = hex::decode(hex_string).map_err(serde::de::Error::custom)?;
-        Ok(Bytes(bytes))
+        Ok(Bytes::new(bytes))
     }
 }
 
 impl From<Vec<u8>> for Bytes {
     #[inline]
     fn from(data: Vec<u8>) -> Self {
-        Bytes(data)
+        Bytes(SharedBuf::from(data))
     }
 }
 
 impl From<&[u8]> for Bytes {
     #[inline]
     fn from(data: &[u8]) -> Self {
-        Bytes(data.to_vec())
+        Bytes(SharedBuf::copy_from_slice(data))
+    }
+}
+
+impl From<SharedBuf> for Bytes {
+    #[inline]
+    fn from(data: SharedBuf) -> Self {
+        Bytes(data)
     }
 }
 
@@ -98,7 +127,7 @@ impl Read for Bytes {
         let end = start + len;
         *pos = end;
 
-        Ok(Bytes(bytes[start..end].to_vec()))
+        Ok(Bytes(SharedBuf::copy_from_slice(&bytes[start..end])))
     }
 }
 
@@ -136,4 +165,17 @@ mod tests {
         let bytes = Bytes::new(vec![0x12, 0x34, 0x56, 0x78]);
         assert_eq!(bytes.to_string(), "12345678");
     }
+
+    #[test]
+    fn test_bytes_clone_shares_allocation() {
+        let bytes = Bytes::new(vec![0x12, 0x34, 0x56, 0x78]);
+        let clone = bytes.clone();
+        assert_eq!(bytes.as_slice().as_ptr(), clone.as_slice().as_ptr());
+
+        let slice = bytes.slice(1..3);
+        assert_eq!(slice.as_slice(), &[0x34, 0x56]);
+        assert_eq!(slice.as_slice().as_ptr(), unsafe {
+            bytes.as_slice().as_ptr().add(1)
+        });
+    }
 }
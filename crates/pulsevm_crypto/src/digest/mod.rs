@@ -1,9 +1,16 @@
 use core::fmt;
+use std::thread;
 
 use pulsevm_serialization::{NumBytes, Read, Write};
 use serde::Serialize;
 use sha2::Digest as ShaDigest;
 
+use crate::fixed_bytes::encode_hex;
+
+/// Minimum batch size before `hash_many` fans out across worker threads;
+/// below this the per-thread overhead outweighs the hashing work.
+const PARALLEL_HASH_THRESHOLD: usize = 256;
+
 #[derive(Clone, Copy, Debug, PartialEq, Eq, Default)]
 pub struct Digest(pub [u8; 32]);
 
@@ -16,6 +23,60 @@ impl Digest {
         Digest(out)
     }
 
+    /// Hashes the concatenation of `a` and `b` without materializing it.
+    /// This is the merkle pairing hot path, where the inputs are two digests
+    /// already sitting in separate buffers.
+    #[inline]
+    pub fn hash_pair(a: impl AsRef<[u8]>, b: impl AsRef<[u8]>) -> Self {
+        let mut hasher = sha2::Sha256::new();
+        hasher.update(a.as_ref());
+        hasher.update(b.as_ref());
+        let mut out = [0u8; 32];
+        out.copy_from_slice(hasher.finalize().as_ref());
+        Digest(out)
+    }
+
+    /// Hashes a batch of independent messages, returning digests in input
+    /// order. Each lane runs the hardware compression function sha2 dispatches
+    /// to at runtime (SHA-NI on x86, the SHA2 extension on aarch64), and
+    /// large batches are striped across worker threads so every core hashes a
+    /// lane; small batches stay on the calling thread.
+    pub fn hash_many(inputs: &[impl AsRef<[u8]> + Sync]) -> Vec<Digest> {
+        if inputs.len() < PARALLEL_HASH_THRESHOLD {
+            return inputs.iter().map(Digest::hash).collect();
+        }
+
+        let workers = thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1)
+            .min(inputs.len());
+        if workers <= 1 {
+            return inputs.iter().map(Digest::hash).collect();
+        }
+
+        let mut out = vec![Digest::default(); inputs.len()];
+        thread::scope(|scope| {
+            // Contiguous stripes keep results in input order; each worker
+            // writes only its own disjoint slice of the output.
+            let mut rest = out.as_mut_slice();
+            let chunk = inputs.len().div_ceil(workers);
+            let mut start = 0;
+            while !rest.is_empty() {
+                let len = chunk.min(rest.len());
+                let (stripe, tail) = rest.split_at_mut(len);
+                let inputs = &inputs[start..start + len];
+                scope.spawn(move || {
+                    for (slot, input) in stripe.iter_mut().zip(inputs) {
+                        *slot = Digest::hash(input);
+                    }
+                });
+                start += len;
+                rest = tail;
+            }
+        });
+        out
+    }
+
     #[inline]
     pub fn as_bytes(&self) -> &[u8; 32] {
         &self.0
@@ -24,7 +85,8 @@ impl Digest {
 
 impl fmt::Display for Digest {
     fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
-        write!(f, "{}", hex::encode(self.0))
+        let mut buf = [0u8; 64];
+        f.write_str(encode_hex(&self.0, &mut buf))
     }
 }
 
@@ -70,7 +132,32 @@ impl Serialize for Digest {
     where
         S: serde::Serializer,
     {
-        let hex_string = hex::encode(self.0);
-        serializer.serialize_str(&hex_string)
+        let mut buf = [0u8; 64];
+        serializer.serialize_str(encode_hex(&self.0, &mut buf))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_hash_pair_matches_concatenation() {
+        let a = [0x11u8; 32];
+        let b = [0x22u8; 32];
+        let mut combined = Vec::with_capacity(64);
+        combined.extend_from_slice(&a);
+        combined.extend_from_slice(&b);
+        assert_eq!(Digest::hash_pair(&a, &b), Digest::hash(&combined));
+    }
+
+    #[test]
+    fn test_hash_many_matches_single() {
+        // Straddle the parallel threshold in both directions.
+        for count in [0usize, 1, 255, 256, 257, 1000] {
+            let inputs: Vec<Vec<u8>> = (0..count).map(|i| i.to_le_bytes().to_vec()).collect();
+            let expected: Vec<Digest> = inputs.iter().map(Digest::hash).collect();
+            assert_eq!(Digest::hash_many(&inputs), expected);
+        }
     }
 }
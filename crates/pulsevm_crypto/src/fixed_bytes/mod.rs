@@ -4,6 +4,23 @@ use pulsevm_serialization::{NumBytes, Read, Write};
 use serde::Serialize;
 use sha2::Digest;
 
+const HEX_CHARS: &[u8; 16] = b"0123456789abcdef";
+
+/// Hex-encodes `bytes` into the front of `buf` and returns the encoded
+/// prefix. Two table loads per byte into a caller-provided stack buffer:
+/// the loop has a fixed trip count at every call site, so it vectorizes
+/// without an explicit SIMD dependency, and nothing touches the heap —
+/// unlike `hex::encode`, which builds a `String` per call.
+pub(crate) fn encode_hex<'a>(bytes: &[u8], buf: &'a mut [u8]) -> &'a str {
+    let len = bytes.len() * 2;
+    debug_assert!(buf.len() >= len);
+    for (i, b) in bytes.iter().enumerate() {
+        buf[i * 2] = HEX_CHARS[(b >> 4) as usize];
+        buf[i * 2 + 1] = HEX_CHARS[(b & 0x0F) as usize];
+    }
+    core::str::from_utf8(&buf[..len]).unwrap_or_default()
+}
+
 #[derive(Clone, Copy, Debug, PartialEq, Eq, Hash)]
 pub struct FixedBytes<const N: usize>(pub [u8; N]);
 
@@ -25,7 +42,12 @@ impl FixedBytes<32> {
 impl<const N: usize> fmt::Display for FixedBytes<N> {
     #[inline]
     fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
-        write!(f, "{}", hex::encode(self.0))
+        // Encode in 32-byte chunks so one stack buffer covers any N.
+        let mut buf = [0u8; 64];
+        for chunk in self.0.chunks(32) {
+            f.write_str(encode_hex(chunk, &mut buf))?;
+        }
+        Ok(())
     }
 }
 
@@ -78,7 +100,12 @@ impl<const N: usize> Serialize for FixedBytes<N> {
     where
         S: serde::Serializer,
     {
-        serializer.serialize_str(self.to_string().as_str())
+        if N <= 32 {
+            let mut buf = [0u8; 64];
+            serializer.serialize_str(encode_hex(&self.0, &mut buf))
+        } else {
+            serializer.serialize_str(&hex::encode(self.0))
+        }
     }
 }
 
@@ -102,3 +129,29 @@ impl<const N: usize> TryFrom<Vec<u8>> for FixedBytes<N> {
         Ok(FixedBytes(bytes))
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_display_matches_hex_encode() {
+        let mut bytes = [0u8; 32];
+        for (i, b) in bytes.iter_mut().enumerate() {
+            *b = i as u8 ^ 0xA5;
+        }
+        let fixed = FixedBytes(bytes);
+        assert_eq!(fixed.to_string(), hex::encode(bytes));
+    }
+
+    #[test]
+    fn test_display_chunks_beyond_buffer() {
+        // Wider than the 32-byte chunk, so Display takes two passes.
+        let mut bytes = [0u8; 48];
+        for (i, b) in bytes.iter_mut().enumerate() {
+            *b = (255 - i) as u8;
+        }
+        let fixed = FixedBytes(bytes);
+        assert_eq!(fixed.to_string(), hex::encode(bytes));
+    }
+}
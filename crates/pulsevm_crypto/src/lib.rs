@@ -1,5 +1,5 @@
 mod bytes;
-pub use bytes::Bytes;
+pub use crate::bytes::Bytes;
 
 mod digest;
 pub use digest::Digest;
@@ -8,4 +8,4 @@ mod fixed_bytes;
 pub use fixed_bytes::FixedBytes;
 
 mod merkle_tree;
-pub use merkle_tree::merkle;
+pub use merkle_tree::{IncrementalMerkle, merkle, merkle_parallel};
@@ -1,7 +1,12 @@
 use std::collections::VecDeque;
+use std::thread;
 
 use crate::Digest;
 
+/// Minimum number of leaves before `merkle_parallel` fans out to worker
+/// threads; below this the per-thread overhead outweighs the hashing work.
+const PARALLEL_MERKLE_THRESHOLD: usize = 256;
+
 /// Canonicalize left by clearing bit 0x80 on first byte
 #[inline]
 pub fn make_canonical_left(val: &Digest) -> Digest {
@@ -24,11 +29,7 @@ pub fn make_canonical_pair(a: Digest, b: Digest) -> Digest {
     let left = make_canonical_left(&a);
     let right = make_canonical_right(&b);
 
-    let mut combined = Vec::with_capacity(64);
-    combined.extend_from_slice(&left.0);
-    combined.extend_from_slice(&right.0);
-
-    Digest::hash(&combined)
+    Digest::hash_pair(&left.0, &right.0)
 }
 
 /// Compute Merkle root from a list of digests
@@ -54,3 +55,161 @@ pub fn merkle(ids: &mut VecDeque<Digest>) -> Digest {
 
     ids[0]
 }
+
+/// Compute the same Merkle root as `merkle`, hashing each level's pairs in
+/// parallel for large inputs. The pairing order is identical — chunks of the
+/// pair range are assigned to workers in order and concatenated in order —
+/// so the result is bit-for-bit the serial root. Small inputs fall through
+/// to the serial path.
+pub fn merkle_parallel(ids: &mut VecDeque<Digest>) -> Digest {
+    if ids.len() < PARALLEL_MERKLE_THRESHOLD {
+        return merkle(ids);
+    }
+
+    let mut level: Vec<Digest> = ids.drain(..).collect();
+    let workers = thread::available_parallelism().map(|n| n.get()).unwrap_or(1);
+
+    while level.len() > 1 {
+        if level.len() % 2 != 0 {
+            level.push(*level.last().unwrap());
+        }
+
+        let pairs = level.len() / 2;
+
+        if workers <= 1 || pairs < PARALLEL_MERKLE_THRESHOLD / 2 {
+            for i in 0..pairs {
+                level[i] = make_canonical_pair(level[2 * i], level[2 * i + 1]);
+            }
+            level.truncate(pairs);
+        } else {
+            let chunk = pairs.div_ceil(workers);
+            let next: Vec<Digest> = thread::scope(|scope| {
+                let level = &level;
+                let handles: Vec<_> = (0..pairs)
+                    .step_by(chunk)
+                    .map(|start| {
+                        scope.spawn(move || {
+                            (start..(start + chunk).min(pairs))
+                                .map(|i| make_canonical_pair(level[2 * i], level[2 * i + 1]))
+                                .collect::<Vec<Digest>>()
+                        })
+                    })
+                    .collect();
+                handles
+                    .into_iter()
+                    .flat_map(|h| h.join().expect("merkle worker panicked"))
+                    .collect()
+            });
+            level = next;
+        }
+    }
+
+    level[0]
+}
+
+/// Incremental merkle accumulator. Leaves are appended one at a time and the
+/// root is maintained as they arrive, so reading the root after n appends is
+/// O(1) and each append touches only the O(log n) active frontier nodes. The
+/// pairing rules (canonicalization, odd tails duplicated) match `merkle`, so
+/// the root is bit-for-bit what `merkle` would return over the same leaves.
+#[derive(Debug, Clone, Default)]
+pub struct IncrementalMerkle {
+    active_nodes: Vec<Digest>,
+    node_count: u64,
+}
+
+impl IncrementalMerkle {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Number of leaves appended so far.
+    pub fn node_count(&self) -> u64 {
+        self.node_count
+    }
+
+    /// Depth of the tree implied by `count` leaves, including the leaf level.
+    fn max_depth(count: u64) -> u32 {
+        if count <= 1 {
+            1
+        } else {
+            64 - (count - 1).leading_zeros() + 1
+        }
+    }
+
+    /// Append a leaf and return the new root.
+    pub fn append(&mut self, digest: Digest) -> Digest {
+        let mut partial = false;
+        let max_depth = Self::max_depth(self.node_count + 1);
+        let mut index = self.node_count;
+        let mut top = digest;
+        let mut active_iter = self.active_nodes.iter();
+        let mut updated_active_nodes: Vec<Digest> = Vec::with_capacity(max_depth as usize);
+
+        for _ in 1..max_depth {
+            if index & 1 == 0 {
+                // Left child with no right sibling yet: remember it for when
+                // the sibling arrives, and pair it with itself to mirror the
+                // odd-tail duplication of the full computation.
+                if !partial {
+                    updated_active_nodes.push(top);
+                }
+                top = make_canonical_pair(top, top);
+                partial = true;
+            } else {
+                // Right child: combine with the stored left sibling. Once the
+                // subtree is full the left value is no longer needed.
+                let left = *active_iter
+                    .next()
+                    .expect("incremental merkle active node list out of sync");
+                if partial {
+                    updated_active_nodes.push(left);
+                }
+                top = make_canonical_pair(left, top);
+            }
+            index >>= 1;
+        }
+
+        updated_active_nodes.push(top);
+        self.active_nodes = updated_active_nodes;
+        self.node_count += 1;
+        top
+    }
+
+    /// Current root; the empty accumulator matches `merkle` on no leaves.
+    pub fn root(&self) -> Digest {
+        if self.node_count == 0 {
+            return Digest([0u8; 32]);
+        }
+        *self.active_nodes.last().unwrap()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_incremental_matches_full_computation() {
+        let mut accumulator = IncrementalMerkle::new();
+        let mut leaves: VecDeque<Digest> = VecDeque::new();
+        assert_eq!(accumulator.root(), merkle(&mut leaves.clone()));
+        for i in 0..1000u64 {
+            let leaf = Digest::hash(&i.to_le_bytes());
+            accumulator.append(leaf);
+            leaves.push_back(leaf);
+            assert_eq!(accumulator.root(), merkle(&mut leaves.clone()));
+        }
+    }
+
+    #[test]
+    fn test_parallel_matches_serial() {
+        for count in [0usize, 1, 2, 3, 255, 256, 257, 1000] {
+            let digests: Vec<Digest> =
+                (0..count).map(|i| Digest::hash(&i.to_le_bytes())).collect();
+            let mut serial: VecDeque<Digest> = digests.iter().copied().collect();
+            let mut parallel: VecDeque<Digest> = digests.into_iter().collect();
+            assert_eq!(merkle(&mut serial), merkle_parallel(&mut parallel));
+        }
+    }
+}
@@ -29,6 +29,8 @@ pub enum ChainError {
     ApplyError(String),
     #[error("database error: {0}")]
     DatabaseError(String),
+    #[error("ram usage exceeded: {0}")]
+    RamUsageExceeded(String),
     #[error("invalid argument: {0}")]
     InvalidArgument(String),
     #[error("serialization error: {0}")]
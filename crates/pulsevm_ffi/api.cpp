@@ -1,6 +1,10 @@
 #include "api.hpp"
 #include <pulsevm_ffi/src/bridge.rs.h>
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 namespace pulsevm { namespace chain {
 
     const string KEYi64 = "i64";
@@ -43,32 +47,54 @@ namespace pulsevm { namespace chain {
         return core_symbol;
     }
 
-    string get_table_type( const abi_def& abi, const name& table_name ) {
-        for( const auto& t : abi.tables ) {
-            if( t.name == table_name ){
-                return t.index_type;
-            }
-        }
-        EOS_ASSERT( false, chain::contract_table_query_exception, "Table ${table} is not specified in the ABI", ("table",table_name) );
+    string get_table_type( const abi_serializer& abis, const name& table_name ) {
+        auto table_type = abis.get_table_type( table_name );
+        EOS_ASSERT( !table_type.empty(), chain::contract_table_query_exception, "Table ${table} is not specified in the ABI", ("table",table_name) );
+        return table_type;
     }
 
-    abi_def get_abi( const database_wrapper& db, uint64_t account ) {
+    std::shared_ptr<const abi_serializer> get_cached_abi_serializer( const database_wrapper& db, uint64_t account ) {
+        static std::mutex cache_mutex;
+        static std::unordered_map<fc::sha256, std::shared_ptr<const abi_serializer>> cache;
+        // ABIs in play at any one time are bounded by the number of deployed
+        // contracts being queried; past this the cache is simply dropped and
+        // rebuilt on demand, which is cheaper than LRU bookkeeping for an
+        // event (mass setabi churn) that does not happen in practice.
+        static constexpr size_t max_cached_serializers = 256;
+
         const account_object *code_accnt = db.find<account_object, by_name>(name(account));
         EOS_ASSERT(code_accnt != nullptr, chain::account_query_exception, "failed to retrieve account for ${account}", ("account", account) );
+
+        const auto abi_hash = fc::sha256::hash(code_accnt->abi.data(), code_accnt->abi.size());
+        {
+            std::lock_guard<std::mutex> guard(cache_mutex);
+            auto itr = cache.find(abi_hash);
+            if( itr != cache.end() )
+                return itr->second;
+        }
+
+        // Compile outside the lock; concurrent first queries for the same ABI
+        // may race to build it, but they all produce the same serializer.
         abi_def abi;
         abi_serializer::to_abi(code_accnt->abi, abi);
-        return abi;
+        auto abis = std::make_shared<const abi_serializer>(std::move(abi), abi_serializer::create_yield_function(abi_serializer_max_time));
+
+        std::lock_guard<std::mutex> guard(cache_mutex);
+        if( cache.size() >= max_cached_serializers )
+            cache.clear();
+        cache.emplace(abi_hash, abis);
+        return abis;
     }
 
     rust::String get_account_info_without_core_symbol( const database_wrapper& db, uint64_t account, uint32_t head_block_num, const TimePoint& head_block_time ) {
         auto result = get_account_info( db, account, std::nullopt, head_block_num, head_block_time );
-        auto json = fc::json::to_pretty_string( result );
+        auto json = fc::json::to_string( result, fc::time_point::maximum() );
         return rust::String( json.c_str() );
     }
 
     rust::String get_account_info_with_core_symbol( const database_wrapper& db, uint64_t account, rust::Str expected_core_symbol, uint32_t head_block_num, const TimePoint& head_block_time ) {
         auto result = get_account_info( db, account, symbol::from_string(string(expected_core_symbol.data(), expected_core_symbol.size())), head_block_num, head_block_time );
-        auto json = fc::json::to_pretty_string( result );
+        auto json = fc::json::to_string( result, fc::time_point::maximum() );
         return rust::String( json.c_str() );
     }
 
@@ -231,8 +257,7 @@ namespace pulsevm { namespace chain {
     }
 
     rust::String get_currency_balance( const database_wrapper& db, uint64_t code, uint64_t account, std::optional<string> symbol ) {
-        const abi_def abi = get_abi( db, code );
-        (void)get_table_type( abi, name("accounts") );
+        (void)get_table_type( *get_cached_abi_serializer( db, code ), name("accounts") );
 
         vector<asset> results;
         walk_key_value_table(db, name(code), name(account), "accounts"_n, [&](const key_value_object& obj){
@@ -252,7 +277,7 @@ namespace pulsevm { namespace chain {
             return !(symbol && boost::iequals(cursor.symbol_name(), *symbol));
         });
 
-        auto json = fc::json::to_pretty_string( results );
+        auto json = fc::json::to_string( results, fc::time_point::maximum() );
         return rust::String( json.c_str() );
     }
 
@@ -267,8 +292,7 @@ namespace pulsevm { namespace chain {
     rust::String get_currency_stats( const database_wrapper& db, uint64_t code, rust::Str symbol ) {
         fc::mutable_variant_object results;
 
-        const abi_def abi = get_abi( db, code );
-        (void)get_table_type( abi, name("stat") );
+        (void)get_table_type( *get_cached_abi_serializer( db, code ), name("stat") );
 
         uint64_t scope = ( string_to_symbol( 0, boost::algorithm::to_upper_copy(string(symbol.data(), symbol.size())).c_str() ) >> 8 );
 
@@ -286,7 +310,53 @@ namespace pulsevm { namespace chain {
             return true;
         });
 
-        auto json = fc::json::to_pretty_string( results );
+        auto json = fc::json::to_string( results, fc::time_point::maximum() );
+        return rust::String( json.c_str() );
+    }
+
+    rust::String get_db_allocation_stats( const database_wrapper& db ) {
+        auto pool = []( const chainbase::node_allocator_stats& s ) {
+            return fc::mutable_variant_object
+                ( "node_size", s.node_size )
+                ( "in_use", s.in_use )
+                ( "free_count", s.free_count )
+                ( "slab_count", s.slab_count )
+                ( "slab_bytes", s.slab_bytes );
+        };
+        fc::variants indices;
+        for( const auto& stats : db.get_allocation_stats() ) {
+            indices.emplace_back( fc::mutable_variant_object
+                ( "type_name", stats.type_name )
+                ( "row_count", stats.row_count )
+                ( "nodes", pool(stats.nodes) )
+                ( "old_values", pool(stats.old_values) ) );
+        }
+        fc::mutable_variant_object result;
+        result( "free_memory_bytes", db.get_free_memory() );
+        result( "indices", std::move(indices) );
+
+        auto json = fc::json::to_string( fc::variant(result), fc::time_point::maximum() );
+        return rust::String( json.c_str() );
+    }
+
+    rust::String get_db_commit_stats( const database_wrapper& db ) {
+        auto stats = db.get_last_commit_stats();
+        // Heaviest index first; that is the end-of-block critical path.
+        std::sort( stats.begin(), stats.end(),
+                   []( const auto& a, const auto& b ) { return a.elapsed_ns > b.elapsed_ns; } );
+        uint64_t total_ns = 0;
+        fc::variants indices;
+        for( const auto& s : stats ) {
+            total_ns += s.elapsed_ns;
+            indices.emplace_back( fc::mutable_variant_object
+                ( "type_name", s.type_name )
+                ( "elapsed_ns", s.elapsed_ns ) );
+        }
+        fc::mutable_variant_object result;
+        result( "total_index_ns", total_ns );
+        result( "indices", std::move(indices) );
+
+        auto json = fc::json::to_string( fc::variant(result), fc::time_point::maximum() );
         return rust::String( json.c_str() );
     }
 
@@ -317,7 +387,7 @@ namespace pulsevm { namespace chain {
         }
 
         if( upper_bound_lookup_tuple < lower_bound_lookup_tuple ) {
-            auto json_result = fc::json::to_pretty_string( result );
+            auto json_result = fc::json::to_string( result, deadline );
             return rust::String( json_result.c_str() );
         }
 
@@ -346,7 +416,44 @@ namespace pulsevm { namespace chain {
             walk_table_range( lower, upper );
         }
 
-        auto json_result = fc::json::to_pretty_string( result );
+        auto json_result = fc::json::to_string( result, deadline );
+        return rust::String( json_result.c_str() );
+    }
+
+    rust::String get_table_stats(
+        const database_wrapper& db,
+        uint64_t code,
+        rust::Str scope,
+        uint64_t table,
+        rust::Str index_position
+    ) {
+        get_table_rows_params params;
+        params.code = name(code);
+        params.scope = string(scope.data(), scope.size());
+        params.table = name(table);
+        params.index_position = string(index_position.data(), index_position.size());
+
+        bool primary = false;
+        const uint64_t table_with_index = get_table_index_name( params, primary );
+        uint64_t scope_value = convert_to_type<uint64_t>(params.scope, "scope");
+
+        get_table_stats_result result;
+        const auto* t_id = db.find<table_id_object, by_code_scope_table>(boost::make_tuple(params.code, name(scope_value), params.table));
+        if( t_id != nullptr ) {
+            result.exists = true;
+            result.row_count = t_id->count;
+            if( primary ) {
+                result.index_row_count = t_id->count;
+            } else {
+                // Secondary indices live in their own table_id_object under
+                // the packed index name; its count is the number of index
+                // entries the query would walk.
+                const auto* index_t_id = db.find<table_id_object, by_code_scope_table>(boost::make_tuple(params.code, name(scope_value), name(table_with_index)));
+                result.index_row_count = index_t_id != nullptr ? index_t_id->count : 0;
+            }
+        }
+
+        auto json_result = fc::json::to_string( result, fc::time_point::maximum() );
         return rust::String( json_result.c_str() );
     }
 
@@ -383,26 +490,99 @@ namespace pulsevm { namespace chain {
         };
         auto deadline = fc::time_point::now().safe_add( fc::microseconds(30 * 1000 * 1000) ); // 30 seconds from now
         auto result = get_table_rows_internal(db, params, deadline);
-        auto json_result = fc::json::to_pretty_string( result );
+        auto json_result = fc::json::to_string( result, deadline );
         return rust::String( json_result.c_str() );
     }
 
+    TableRowsBinaryResult get_table_rows_binary(
+        const database_wrapper& db,
+        uint64_t code,
+        rust::Str scope,
+        uint64_t table,
+        rust::Str lower_bound,
+        rust::Str upper_bound,
+        uint32_t limit,
+        bool reverse
+    ) {
+        TableRowsBinaryResult result;
+        result.more = false;
+
+        // Only the hash of the stored ABI travels with the page; the
+        // serializer is never compiled or consulted, which is the point of
+        // this mode — the consumer decodes the bytes itself.
+        const account_object* code_accnt = db.find<account_object, by_name>(name(code));
+        EOS_ASSERT( code_accnt != nullptr, chain::account_query_exception,
+                    "failed to retrieve account for ${account}", ("account", name(code)) );
+        result.abi_hash = rust::String(
+            fc::sha256::hash(code_accnt->abi.data(), code_accnt->abi.size()).str().c_str() );
+
+        uint64_t scope_value = convert_to_type<uint64_t>( string(scope.data(), scope.size()), "scope" );
+        const auto* t_id = db.find<table_id_object, by_code_scope_table>(
+            boost::make_tuple(name(code), name(scope_value), name(table)) );
+        if( t_id == nullptr )
+            return result;
+
+        const auto& idx = db.get_index<key_value_index, by_scope_primary>();
+        auto lower_bound_lookup_tuple = std::make_tuple( t_id->id, std::numeric_limits<uint64_t>::lowest() );
+        auto upper_bound_lookup_tuple = std::make_tuple( t_id->id, std::numeric_limits<uint64_t>::max() );
+        if( lower_bound.size() )
+            std::get<1>(lower_bound_lookup_tuple) =
+                convert_to_type<uint64_t>( string(lower_bound.data(), lower_bound.size()), "lower_bound" );
+        if( upper_bound.size() )
+            std::get<1>(upper_bound_lookup_tuple) =
+                convert_to_type<uint64_t>( string(upper_bound.data(), upper_bound.size()), "upper_bound" );
+        if( upper_bound_lookup_tuple < lower_bound_lookup_tuple )
+            return result;
+
+        if( limit > max_return_items )
+            limit = max_return_items;
+
+        auto walk_table_row_range = [&]( auto itr, auto end_itr ) {
+            for( uint32_t count = 0; count < limit && itr != end_itr; ++count, ++itr ) {
+                const auto& obj = *itr;
+                // Each row is its little-endian u32 length followed by the
+                // serialized value, straight out of chainbase.
+                const uint32_t len = obj.value.size();
+                result.rows.reserve( result.rows.size() + 4 + len );
+                result.rows.push_back( uint8_t(len) );
+                result.rows.push_back( uint8_t(len >> 8) );
+                result.rows.push_back( uint8_t(len >> 16) );
+                result.rows.push_back( uint8_t(len >> 24) );
+                for( const char c : obj.value )
+                    result.rows.push_back( static_cast<uint8_t>(c) );
+            }
+            if( itr != end_itr ) {
+                result.more = true;
+                result.next_key = rust::String( std::to_string(itr->primary_key).c_str() );
+            }
+        };
+
+        auto lower = idx.lower_bound( lower_bound_lookup_tuple );
+        auto upper = idx.upper_bound( upper_bound_lookup_tuple );
+        if( reverse ) {
+            walk_table_row_range( boost::make_reverse_iterator(upper), boost::make_reverse_iterator(lower) );
+        } else {
+            walk_table_row_range( lower, upper );
+        }
+        return result;
+    }
+
     get_table_rows_result get_table_rows_internal( const database_wrapper& db, const get_table_rows_params& p, const fc::time_point& deadline ) {
-        abi_def abi = get_abi( db, p.code.to_uint64_t() );
+        auto abis = get_cached_abi_serializer( db, p.code.to_uint64_t() );
         bool primary = false;
         auto table_with_index = get_table_index_name( p, primary );
         if( primary ) {
             EOS_ASSERT( p.table == table_with_index, chain::contract_table_query_exception, "Invalid table name ${t}", ( "t", p.table ));
-            auto table_type = get_table_type( abi, p.table );
+            auto table_type = get_table_type( *abis, p.table );
             if( table_type == KEYi64 || p.key_type == "i64" || p.key_type == "name" ) {
-                return get_table_rows_ex<key_value_index>(db, p, std::move(abi), deadline);
+                return get_table_rows_ex<key_value_index>(db, p, *abis, deadline);
             }
-            EOS_ASSERT( false, chain::contract_table_query_exception,  "Invalid table type ${type}", ("type",table_type)("abi",abi));
+            EOS_ASSERT( false, chain::contract_table_query_exception,  "Invalid table type ${type}", ("type",table_type));
         } else {
             EOS_ASSERT( !p.key_type.empty(), chain::contract_table_query_exception, "key type required for non-primary index" );
 
             if (p.key_type == i64 || p.key_type == "name") {
-                return get_table_rows_by_seckey<index64_index, uint64_t>(db, p, std::move(abi), deadline, [](uint64_t v)->uint64_t {
+                return get_table_rows_by_seckey<index64_index, uint64_t>(db, p, *abis, deadline, [](uint64_t v)->uint64_t {
                     return v;
                 });
             }
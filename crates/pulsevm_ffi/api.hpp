@@ -9,6 +9,8 @@
 #include <fc/io/json.hpp>
 #include <fc/variant.hpp>
 
+#include <memory>
+
 #include "database.hpp"
 
 namespace pulsevm { namespace chain {
@@ -129,6 +131,12 @@ namespace pulsevm { namespace chain {
       string              next_key; ///< fill lower_bound with this value to fetch more rows
    };
 
+   struct get_table_stats_result {
+      bool        exists = false;      ///< the (code, scope, table) tuple resolves to a table
+      uint32_t    row_count = 0;       ///< rows in the primary table
+      uint32_t    index_row_count = 0; ///< rows in the index table the query walks; equals row_count for primary-index queries
+   };
+
    static void copy_inline_row(const key_value_object& obj, vector<char>& data) {
       data.resize( obj.value.size() );
       memcpy( data.data(), obj.value.data(), obj.value.size() );
@@ -168,7 +176,12 @@ namespace pulsevm { namespace chain {
    template<typename Type>
    string convert_to_string(const Type& source, const string& key_type, const string& encode_type, const string& desc);
 
-   abi_def get_abi( const database_wrapper& db, uint64_t account );
+   // Compiled abi_serializer for an account's stored ABI, cached process-wide
+   // and keyed by the hash of the raw ABI bytes. ABIs only change on setabi,
+   // so hot query paths reuse the resolved type graph instead of re-parsing
+   // the ABI and rebuilding the serializer on every request; a changed ABI
+   // hashes to a new key and the stale entry is never hit again.
+   std::shared_ptr<const abi_serializer> get_cached_abi_serializer( const database_wrapper& db, uint64_t account );
    using get_account_return_t = std::function<t_or_exception<get_account_results>()>;
    rust::String get_account_info_without_core_symbol( const database_wrapper& db, uint64_t account, uint32_t head_block_num, const TimePoint& head_block_time );
    rust::String get_account_info_with_core_symbol( const database_wrapper& db, uint64_t account, rust::Str expected_core_symbol, uint32_t head_block_num, const TimePoint& head_block_time );
@@ -176,6 +189,12 @@ namespace pulsevm { namespace chain {
    rust::String get_currency_balance_with_symbol( const database_wrapper& db, uint64_t code, uint64_t account, rust::Str symbol );
    rust::String get_currency_balance_without_symbol( const database_wrapper& db, uint64_t code, uint64_t account );
    rust::String get_currency_stats( const database_wrapper& db, uint64_t code, rust::Str symbol );
+   // Per-index node-pool occupancy (live rows, free-list depth, slab
+   // footprint) plus overall free segment memory, serialized as JSON.
+   rust::String get_db_allocation_stats( const database_wrapper& db );
+   // Per-index wall time of the most recent chainbase commit, heaviest
+   // first, serialized as JSON.
+   rust::String get_db_commit_stats( const database_wrapper& db );
    rust::String get_table_by_scope(
       const database_wrapper& db,
       uint64_t code,
@@ -185,6 +204,17 @@ namespace pulsevm { namespace chain {
       uint32_t limit,
       bool reverse
    );
+   // Row counts for the table a get_table_rows query would walk, serialized
+   // as JSON. Two O(log n) table_id_object lookups at most — the counts are
+   // the ones chainbase already maintains — so the RPC layer can size a scan
+   // or reject a hopeless query before paying for any row.
+   rust::String get_table_stats(
+      const database_wrapper& db,
+      uint64_t code,
+      rust::Str scope,
+      uint64_t table,
+      rust::Str index_position
+   );
    rust::String get_table_rows(
       const database_wrapper& db,
       bool json,
@@ -202,9 +232,27 @@ namespace pulsevm { namespace chain {
       bool show_payer
    );
 
+   // Raw-row variant of get_table_rows for service-to-service consumers:
+   // a page of rows leaves chainbase as one length-prefixed byte blob and
+   // the ABI is never compiled or consulted — only its hash travels along
+   // so the client can pair the bytes with the ABI revision to decode
+   // against. Primary-index scans only; secondary-index queries stay on
+   // the JSON path.
+   struct TableRowsBinaryResult;
+   TableRowsBinaryResult get_table_rows_binary(
+      const database_wrapper& db,
+      uint64_t code,
+      rust::Str scope,
+      uint64_t table,
+      rust::Str lower_bound,
+      rust::Str upper_bound,
+      uint32_t limit,
+      bool reverse
+   );
+
    get_table_rows_result get_table_rows_internal( const database_wrapper& db, const get_table_rows_params& p, const fc::time_point& deadline );
    template <typename IndexType>
-   get_table_rows_result get_table_rows_ex( const database_wrapper& db, const get_table_rows_params& p, abi_def&& abi, const fc::time_point& deadline ) {
+   get_table_rows_result get_table_rows_ex( const database_wrapper& db, const get_table_rows_params& p, const abi_serializer& abis, const fc::time_point& deadline ) {
         fc::time_point params_deadline = p.time_limit_ms ? std::min(fc::time_point::now().safe_add(fc::milliseconds(p.time_limit_ms)), deadline) : deadline;
 
         struct http_params_t {
@@ -276,10 +324,8 @@ namespace pulsevm { namespace chain {
         }
         
          get_table_rows_result result;
-         abi_serializer abis;
-         abis.set_abi(std::move(abi), abi_serializer::create_yield_function(abi_serializer_max_time));
          auto table_type = abis.get_table_type(http_params.table);
-         
+
          for (auto& row : http_params.rows) {
                fc::variant data_var;
                if( http_params.json ) {
@@ -305,7 +351,7 @@ namespace pulsevm { namespace chain {
 
    template <typename IndexType, typename SecKeyType, typename ConvFn>
    get_table_rows_result
-   get_table_rows_by_seckey( const database_wrapper& db, const get_table_rows_params& p, abi_def&& abi, const fc::time_point& deadline, ConvFn conv ) {
+   get_table_rows_by_seckey( const database_wrapper& db, const get_table_rows_params& p, const abi_serializer& abis, const fc::time_point& deadline, ConvFn conv ) {
 
       fc::time_point params_deadline = p.time_limit_ms ? std::min(fc::time_point::now().safe_add(fc::milliseconds(p.time_limit_ms)), deadline) : deadline;
 
@@ -397,10 +443,8 @@ namespace pulsevm { namespace chain {
       }
 
       get_table_rows_result result;
-      abi_serializer abis;
-      abis.set_abi(std::move(abi), abi_serializer::create_yield_function(abi_serializer_max_time));
       auto table_type = abis.get_table_type(http_params.table);
-      
+
       for (auto& row : http_params.rows) {
          fc::variant data_var;
          if( http_params.json ) {
@@ -434,4 +478,5 @@ FC_REFLECT( pulsevm::chain::get_account_results,
 FC_REFLECT( pulsevm::chain::get_table_by_scope_result_row, (code)(scope)(table)(payer)(count));
 FC_REFLECT( pulsevm::chain::get_table_by_scope_result, (rows)(more) );
 FC_REFLECT( pulsevm::chain::get_table_rows_result, (rows)(more)(next_key) );
+FC_REFLECT( pulsevm::chain::get_table_stats_result, (exists)(row_count)(index_row_count) );
 FC_REFLECT( pulsevm::chain::get_currency_stats_result, (supply)(max_supply)(issuer));
\ No newline at end of file
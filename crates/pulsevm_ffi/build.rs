@@ -83,7 +83,6 @@ fn main() {
         .file("database.cpp")
         .file("utils.cpp")
         .file("name.cpp")
-        .file("iterator_cache.cpp")
         .file("api.cpp")
         .file("builtins.cpp")
         // Include directories
@@ -9,7 +9,9 @@ template <typename Try, typename Fail>
 void trycatch(Try &&func, Fail &&fail) noexcept try {
   func();
 } catch (const fc::exception& e) {
-  fail(e.top_message());
+  // "#<code># <message>" — the numeric fc error code travels in-band so the
+  // Rust side (ffi_error.rs) can classify without matching on message text.
+  fail("#" + std::to_string(e.code()) + "# " + e.top_message());
 } catch (const std::exception& e) {
   fail(e.what());
 } catch (...) {
@@ -14,12 +14,14 @@ U128 index128_object_secondary_key_as_u128(const index128_object& o) {
 std::unique_ptr<pulsevm::chain::database_wrapper> open_database(
     rust::Str path,
     DatabaseOpenFlags flags,
-    uint64_t size
+    uint64_t size,
+    DbMapMode map_mode,
+    bool numa_interleave
 ) {
     // Convert rust::Str to std::filesystem::path
     std::string path_str(path.data(), path.size());
     std::filesystem::path fs_path(path_str);
-    
+
     // Convert flags enum to chainbase flags
     chainbase::database::open_flags db_flags;
     if (static_cast<uint32_t>(flags) == 0) {
@@ -27,9 +29,21 @@ std::unique_ptr<pulsevm::chain::database_wrapper> open_database(
     } else {
         db_flags = chainbase::database::open_flags::read_write;
     }
-    
+
+    // Convert map mode enum to chainbase's mapping mode
+    chainbase::pinnable_mapped_file::map_mode db_map_mode;
+    switch (static_cast<uint32_t>(map_mode)) {
+        case 1: db_map_mode = chainbase::pinnable_mapped_file::mapped_private; break;
+        case 2: db_map_mode = chainbase::pinnable_mapped_file::heap; break;
+        case 3: db_map_mode = chainbase::pinnable_mapped_file::locked; break;
+        default: db_map_mode = chainbase::pinnable_mapped_file::mapped; break;
+    }
+
+    // Applies to the mapping created by the database constructor below
+    chainbase::pinnable_mapped_file::set_numa_interleave(numa_interleave);
+
     // Create and return database
-    return std::make_unique<pulsevm::chain::database_wrapper>(fs_path, db_flags, size);
+    return std::make_unique<pulsevm::chain::database_wrapper>(fs_path, db_flags, size, false, db_map_mode);
 }
 
 void database_wrapper::initialize_database(const genesis_state& genesis) {
@@ -141,6 +155,70 @@ void database_wrapper::set_global_properties(const ChainConfigV0& cfg) {
     });
 }
 
+void database_wrapper::flush_sequence_counters(
+    uint64_t global_action_sequence,
+    rust::Slice<const AccountSequence> recv_sequences,
+    rust::Slice<const AccountSequence> auth_sequences
+) {
+    this->modify( this->get_dynamic_global_properties(), [&]( auto& dgp ) {
+        dgp.global_action_sequence = global_action_sequence;
+    });
+    for( const auto& rs : recv_sequences ) {
+        const auto& amo = this->get<account_metadata_object,by_name>( name(rs.account) );
+        this->modify( amo, [&]( auto& am ) {
+            am.recv_sequence = rs.sequence;
+        });
+    }
+    for( const auto& as : auth_sequences ) {
+        const auto& amo = this->get<account_metadata_object,by_name>( name(as.account) );
+        this->modify( amo, [&]( auto& am ) {
+            am.auth_sequence = as.sequence;
+        });
+    }
+}
+
+void database_wrapper::apply_ram_usage_deltas( rust::Slice<const AccountRamDelta> deltas ) {
+    for( const auto& d : deltas ) {
+        if( d.delta == 0 ) continue;
+        this->add_pending_ram_usage( d.account, d.delta );
+        // A net-negative or zero delta cannot push an account over its limit.
+        if( d.delta > 0 ) {
+            this->verify_account_ram_usage( d.account );
+        }
+    }
+}
+
+rust::Vec<PermissionLink> database_wrapper::collect_permission_links() const {
+    rust::Vec<PermissionLink> links;
+    const auto& index = this->get_index<permission_link_index, by_action_name>();
+    for( const auto& link : index ) {
+        links.push_back( PermissionLink{
+            link.account.to_uint64_t(),
+            link.code.to_uint64_t(),
+            link.message_type.to_uint64_t(),
+            link.required_permission.to_uint64_t()
+        });
+    }
+    return links;
+}
+
+rust::Vec<PermissionAuthorityKey> database_wrapper::collect_permission_authority_keys() const {
+    rust::Vec<PermissionAuthorityKey> rows;
+    const auto& index = this->get_index<permission_index, by_owner>();
+    for( const auto& perm : index ) {
+        for( const auto& k : perm.auth.keys ) {
+            auto key = std::make_shared<public_key_type>( k.key.to_public_key() );
+            rows.push_back( PermissionAuthorityKey{
+                key,
+                perm.owner.to_uint64_t(),
+                perm.perm_name.to_uint64_t(),
+                static_cast<uint32_t>(k.weight) >= perm.auth.threshold
+            });
+        }
+    }
+    return rows;
+}
+
 void database_wrapper::update_account_code(
     const account_metadata_object& account,
     rust::Slice<const std::uint8_t> new_code, 
@@ -188,6 +266,12 @@ NetLimitResult database_wrapper::get_account_net_limit(uint64_t name, uint32_t g
     return {arl.available, greylisted};
 }
 
+CpuLimitResult database_wrapper::update_account_usage_and_get_cpu_limit(uint64_t account, uint32_t time_slot, uint32_t greylist_limit) {
+    auto res = get_account_cpu_limit(account, greylist_limit);
+    update_account_usage(account, time_slot);
+    return res;
+}
+
 const permission_object& database_wrapper::create_permission(
     uint64_t account,
     uint64_t permission_name,
@@ -338,33 +422,83 @@ void database_wrapper::set_block_parameters(const ElasticLimitParameters& cpu_li
 }
 
 rust::Vec<uint8_t> database_wrapper::pack_deltas(bool full_snapshot) const {
-    fc::datastream<size_t> ps;
-    pulsevm::state_history::pack_deltas(ps, *this, full_snapshot);
-    size_t sz = ps.tellp();
-
-    std::vector<char> temp_buffer(sz);
-    fc::datastream<char*> ds(temp_buffer.data(), sz);
+    // A growing stream makes the sizing pre-pass unnecessary, so delta
+    // generation walks the per-session modified-object lists once instead
+    // of twice.
+    fc::datastream<std::vector<char>> ds;
     pulsevm::state_history::pack_deltas(ds, *this, full_snapshot);
+    const std::vector<char>& buffer = ds.storage();
 
     rust::Vec<uint8_t> out;
-    out.reserve(sz);
-    for (const auto& byte : temp_buffer) {
+    out.reserve(buffer.size());
+    for (const auto& byte : buffer) {
         out.push_back(static_cast<uint8_t>(byte));
     }
 
     return out;
 }
 
-void database_wrapper::clear_expired_input_transactions(const TimePoint& cutoff) {
+uint32_t database_wrapper::clear_expired_input_transactions(const TimePoint& cutoff, uint32_t max_removals) {
     //Look for expired transactions in the deduplication list, and remove them.
     auto& transaction_idx = this->get_mutable_index<transaction_multi_index>();
     const auto& dedupe_index = transaction_idx.indices().get<by_expiration>();
-    const auto total = dedupe_index.size();
     uint32_t num_removed = 0;
-    while( (!dedupe_index.empty()) && ( fc::time_point(fc::microseconds(cutoff.elapsed.count)) > dedupe_index.begin()->expiration.to_time_point() ) ) {
+    while( num_removed < max_removals && (!dedupe_index.empty()) && ( fc::time_point(fc::microseconds(cutoff.elapsed.count)) > dedupe_index.begin()->expiration.to_time_point() ) ) {
         transaction_idx.remove(*dedupe_index.begin());
         ++num_removed;
     }
+    return num_removed;
+}
+
+void database_wrapper::bulk_load_begin() {
+    EOS_ASSERT( !_bulk_load_active, database_exception, "bulk load mode already active" );
+    EOS_ASSERT( !has_undo_session(), database_exception,
+                "cannot enter bulk load mode with a live undo session" );
+    _bulk_load_active = true;
+}
+
+void database_wrapper::bulk_load_end( int64_t revision ) {
+    EOS_ASSERT( _bulk_load_active, database_exception, "bulk load mode not active" );
+    _bulk_load_active = false;
+    chainbase::database::set_revision( revision );
+}
+
+int64_t database_wrapper::bulk_load_store_sorted( uint64_t code, uint64_t scope, uint64_t table, uint64_t payer,
+                                                  rust::Slice<const uint64_t> ids,
+                                                  rust::Slice<const uint8_t> values,
+                                                  rust::Slice<const uint64_t> value_sizes ) {
+    EOS_ASSERT( _bulk_load_active, database_exception, "bulk load mode not active" );
+    EOS_ASSERT( ids.size() == value_sizes.size(), database_exception,
+                "bulk load id and value size counts differ" );
+    EOS_ASSERT( payer != 0, invalid_table_payer, "must specify a valid account to pay for new record" );
+
+    const table_id_object* tab = find_table( code, scope, table );
+    if( tab == nullptr ) {
+        tab = &create_table( code, scope, table, payer );
+    }
+    auto tableid = tab->id;
+
+    int64_t ram_delta = 0;
+    size_t offset = 0;
+    for( size_t i = 0; i < ids.size(); ++i ) {
+        EOS_ASSERT( i == 0 || ids[i] > ids[i - 1], database_exception,
+                    "bulk load rows must arrive sorted by ascending primary key" );
+        size_t len = value_sizes[i];
+        EOS_ASSERT( offset + len <= values.size(), database_exception,
+                    "bulk load value buffer shorter than its size list" );
+        this->create_back<key_value_object>( [&]( auto& o ) {
+            o.t_id        = tableid;
+            o.primary_key = ids[i];
+            o.value.assign( reinterpret_cast<const char*>(values.data()) + offset, len );
+            o.payer       = name(payer);
+        });
+        offset += len;
+        ram_delta += len + config::billable_size_v<key_value_object>;
+    }
+    this->modify( *tab, [&]( auto& t ) {
+        t.count += ids.size();
+    });
+    return ram_delta;
 }
 
 inline unsigned __int128 to_u128(const U128& v) {
@@ -403,6 +537,22 @@ inline Float128 from_float128(const float128_t& f) {
     return Float128{ f.v[0], f.v[1] };   // lo = v[0], hi = v[1]
 }
 
+U256 index256_object_secondary_key_as_u256(const index256_object& o) {
+    return from_u256(o.get_secondary_key());
+}
+
+uint64_t index_double_object_secondary_key_bits(const index_double_object& o) {
+    return o.get_secondary_key().v;
+}
+
+Float128 index_long_double_object_secondary_key(const index_long_double_object& o) {
+    return from_float128(o.get_secondary_key());
+}
+
+int64_t table_id_value(const table_id& id) {
+    return id._id;
+}
+
 const index128_object& database_wrapper::create_index128_object( const table_id_object& tab, uint64_t payer, uint64_t id, U128 secondary ) {
     unsigned __int128 sec = to_u128(secondary);
     auto tableid = tab.id;
@@ -428,140 +578,36 @@ void database_wrapper::update_index128_object( const index128_object& obj, uint6
     });
 }
 
-void database_wrapper::db_idx128_remove( iterator_cache<index128_object>& keyval_cache, int iterator, u_int64_t receiver ) {
-    const index128_object& obj = keyval_cache.get( iterator );
-    const auto& table_obj = keyval_cache.get_table( obj.t_id );
-    EOS_ASSERT( table_obj.code == name(receiver), table_access_violation, "db access violation" );
-
-    this->modify( table_obj, [&]( auto& t ) {
-        --t.count;
-    });
-    this->remove( obj );
-
-    if (table_obj.count == 0) {
-        this->remove_table(table_obj);
-    }
-
-    keyval_cache.remove( iterator );
+const index128_object* database_wrapper::db_idx128_find_secondary_obj( const table_id_object& tab, U128 secondary ) const {
+    return idx_find_secondary_obj<index128_object>( tab, to_u128(secondary) );
 }
 
-int database_wrapper::db_idx128_find_secondary( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128 secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    unsigned __int128 sec = to_u128(secondary);
-
-    const auto* obj = this->find<index128_object, by_secondary>( boost::make_tuple( tab->id, sec ) );
-    if( !obj ) return table_end_itr;
-
-    primary = obj->primary_key;
-
-    return keyval_cache.add( *obj );
+const index128_object* database_wrapper::db_idx128_find_primary_obj( const table_id_object& tab, uint64_t primary ) const {
+    return idx_find_primary_obj<index128_object>( tab, primary );
 }
 
-int database_wrapper::db_idx128_find_primary( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128& secondary, uint64_t primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-
-    const auto* obj = this->find<index128_object, by_primary>( boost::make_tuple( tab->id, primary ) );
-    if( !obj ) return table_end_itr;
-
-    secondary = from_u128(obj->secondary_key);
-
-    return keyval_cache.add( *obj );
+const index128_object* database_wrapper::db_idx128_lowerbound_obj( const table_id_object& tab, U128 secondary ) const {
+    return idx_lowerbound_obj<index128_object>( tab, to_u128(secondary) );
 }
 
-int database_wrapper::db_idx128_lowerbound( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    unsigned __int128 sec = to_u128(secondary);
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index128_object>::type, by_secondary>();
-    auto itr = idx.lower_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = from_u128(itr->secondary_key);
-
-    return keyval_cache.add( *itr );
+const index128_object* database_wrapper::db_idx128_upperbound_obj( const table_id_object& tab, U128 secondary ) const {
+    return idx_upperbound_obj<index128_object>( tab, to_u128(secondary) );
 }
 
-int database_wrapper::db_idx128_upperbound( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    unsigned __int128 sec = to_u128(secondary);
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index128_object>::type, by_secondary>();
-    auto itr = idx.upper_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = from_u128(itr->secondary_key);
-
-    return keyval_cache.add( *itr );
+const index128_object* database_wrapper::db_idx128_next_obj( const index128_object& obj ) const {
+    return idx_next_obj<index128_object>( obj );
 }
 
-int database_wrapper::db_idx128_end( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    return keyval_cache.cache_table( *tab );
+const index128_object* database_wrapper::db_idx128_previous_obj( const index128_object& obj ) const {
+    return idx_previous_obj<index128_object>( obj );
 }
 
-int database_wrapper::db_idx128_next( iterator_cache<index128_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    if( iterator < -1 ) return -1; // cannot increment past end iterator of index
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index128_object>::type, by_secondary>();
-
-    auto itr = idx.iterator_to(obj);
-    ++itr;
-
-    if( itr == idx.end() || itr->t_id != obj.t_id ) return keyval_cache.get_end_iterator_by_table_id(obj.t_id);
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+const index128_object* database_wrapper::db_idx128_last_obj( const table_id_object& tab ) const {
+    return idx_last_obj<index128_object>( tab );
 }
 
-int database_wrapper::db_idx128_previous( iterator_cache<index128_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index128_object>::type, by_secondary>();
-
-    if( iterator < -1 ) // is end iterator
-    {
-        auto tab = keyval_cache.find_table_by_end_iterator(iterator);
-        EOS_ASSERT( tab, invalid_table_iterator, "not a valid end iterator" );
-
-        auto itr = idx.upper_bound(tab->id);
-        if( idx.begin() == idx.end() || itr == idx.begin() ) return -1; // Empty index
-
-        --itr;
-
-        if( itr->t_id != tab->id ) return -1; // Empty index
-
-        primary = itr->primary_key;
-        return keyval_cache.add(*itr);
-    }
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-
-    auto itr = idx.iterator_to(obj);
-    if( itr == idx.begin() ) return -1; // cannot decrement past beginning iterator of index
-
-    --itr;
-
-    if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of index
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+void database_wrapper::db_idx128_remove_obj( const index128_object& obj, const table_id_object& table_obj, u_int64_t receiver ) {
+    idx_remove_obj<index128_object>( obj, table_obj, receiver );
 }
 
 const index256_object& database_wrapper::create_index256_object( const table_id_object& tab, uint64_t payer, uint64_t id, U256 secondary ) {
@@ -589,140 +635,36 @@ void database_wrapper::update_index256_object( const index256_object& obj, uint6
     });
 }
 
-void database_wrapper::db_idx256_remove( iterator_cache<index256_object>& keyval_cache, int iterator, u_int64_t receiver ) {
-    const index256_object& obj = keyval_cache.get( iterator );
-    const auto& table_obj = keyval_cache.get_table( obj.t_id );
-    EOS_ASSERT( table_obj.code == name(receiver), table_access_violation, "db access violation" );
-
-    this->modify( table_obj, [&]( auto& t ) {
-        --t.count;
-    });
-    this->remove( obj );
-
-    if (table_obj.count == 0) {
-        this->remove_table(table_obj);
-    }
-
-    keyval_cache.remove( iterator );
+const index256_object* database_wrapper::db_idx256_find_secondary_obj( const table_id_object& tab, U256 secondary ) const {
+    return idx_find_secondary_obj<index256_object>( tab, to_u256(secondary) );
 }
 
-int database_wrapper::db_idx256_find_secondary( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256 secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    auto sec = to_u256(secondary);
-
-    const auto* obj = this->find<index256_object, by_secondary>( boost::make_tuple( tab->id, sec ) );
-    if( !obj ) return table_end_itr;
-
-    primary = obj->primary_key;
-
-    return keyval_cache.add( *obj );
+const index256_object* database_wrapper::db_idx256_find_primary_obj( const table_id_object& tab, uint64_t primary ) const {
+    return idx_find_primary_obj<index256_object>( tab, primary );
 }
 
-int database_wrapper::db_idx256_find_primary( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256& secondary, uint64_t primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-
-    const auto* obj = this->find<index256_object, by_primary>( boost::make_tuple( tab->id, primary ) );
-    if( !obj ) return table_end_itr;
-
-    secondary = from_u256(obj->secondary_key);
-
-    return keyval_cache.add( *obj );
+const index256_object* database_wrapper::db_idx256_lowerbound_obj( const table_id_object& tab, U256 secondary ) const {
+    return idx_lowerbound_obj<index256_object>( tab, to_u256(secondary) );
 }
 
-int database_wrapper::db_idx256_lowerbound( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    auto sec = to_u256(secondary);
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index256_object>::type, by_secondary>();
-    auto itr = idx.lower_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = from_u256(itr->secondary_key);
-
-    return keyval_cache.add( *itr );
+const index256_object* database_wrapper::db_idx256_upperbound_obj( const table_id_object& tab, U256 secondary ) const {
+    return idx_upperbound_obj<index256_object>( tab, to_u256(secondary) );
 }
 
-int database_wrapper::db_idx256_upperbound( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    auto sec = to_u256(secondary);
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index256_object>::type, by_secondary>();
-    auto itr = idx.upper_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = from_u256(itr->secondary_key);
-
-    return keyval_cache.add( *itr );
+const index256_object* database_wrapper::db_idx256_next_obj( const index256_object& obj ) const {
+    return idx_next_obj<index256_object>( obj );
 }
 
-int database_wrapper::db_idx256_end( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    return keyval_cache.cache_table( *tab );
+const index256_object* database_wrapper::db_idx256_previous_obj( const index256_object& obj ) const {
+    return idx_previous_obj<index256_object>( obj );
 }
 
-int database_wrapper::db_idx256_next( iterator_cache<index256_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    if( iterator < -1 ) return -1; // cannot increment past end iterator of index
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index256_object>::type, by_secondary>();
-
-    auto itr = idx.iterator_to(obj);
-    ++itr;
-
-    if( itr == idx.end() || itr->t_id != obj.t_id ) return keyval_cache.get_end_iterator_by_table_id(obj.t_id);
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+const index256_object* database_wrapper::db_idx256_last_obj( const table_id_object& tab ) const {
+    return idx_last_obj<index256_object>( tab );
 }
 
-int database_wrapper::db_idx256_previous( iterator_cache<index256_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index256_object>::type, by_secondary>();
-
-    if( iterator < -1 ) // is end iterator
-    {
-        auto tab = keyval_cache.find_table_by_end_iterator(iterator);
-        EOS_ASSERT( tab, invalid_table_iterator, "not a valid end iterator" );
-
-        auto itr = idx.upper_bound(tab->id);
-        if( idx.begin() == idx.end() || itr == idx.begin() ) return -1; // Empty index
-
-        --itr;
-
-        if( itr->t_id != tab->id ) return -1; // Empty index
-
-        primary = itr->primary_key;
-        return keyval_cache.add(*itr);
-    }
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-
-    auto itr = idx.iterator_to(obj);
-    if( itr == idx.begin() ) return -1; // cannot decrement past beginning iterator of index
-
-    --itr;
-
-    if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of index
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+void database_wrapper::db_idx256_remove_obj( const index256_object& obj, const table_id_object& table_obj, u_int64_t receiver ) {
+    idx_remove_obj<index256_object>( obj, table_obj, receiver );
 }
 
 const index_double_object& database_wrapper::create_idx_double_object( const table_id_object& tab, uint64_t payer, uint64_t id, uint64_t secondary ) {
@@ -749,140 +691,36 @@ void database_wrapper::update_idx_double_object( const index_double_object& obj,
     });
 }
 
-void database_wrapper::db_idx_double_remove( iterator_cache<index_double_object>& keyval_cache, int iterator, u_int64_t receiver ) {
-    const index_double_object& obj = keyval_cache.get( iterator );
-    const auto& table_obj = keyval_cache.get_table( obj.t_id );
-    EOS_ASSERT( table_obj.code == name(receiver), table_access_violation, "db access violation" );
-
-    this->modify( table_obj, [&]( auto& t ) {
-        --t.count;
-    });
-    this->remove( obj );
-
-    if (table_obj.count == 0) {
-        this->remove_table(table_obj);
-    }
-
-    keyval_cache.remove( iterator );
+const index_double_object* database_wrapper::db_idx_double_find_secondary_obj( const table_id_object& tab, uint64_t secondary ) const {
+    return idx_find_secondary_obj<index_double_object>( tab, float64_t { secondary } );
 }
 
-int database_wrapper::db_idx_double_find_secondary( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-
-    auto sec = float64_t { secondary };
-    const auto* obj = this->find<index_double_object, by_secondary>( boost::make_tuple( tab->id, sec ) );
-    if( !obj ) return table_end_itr;
-
-    primary = obj->primary_key;
-
-    return keyval_cache.add( *obj );
+const index_double_object* database_wrapper::db_idx_double_find_primary_obj( const table_id_object& tab, uint64_t primary ) const {
+    return idx_find_primary_obj<index_double_object>( tab, primary );
 }
 
-int database_wrapper::db_idx_double_find_primary( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-
-    const auto* obj = this->find<index_double_object, by_primary>( boost::make_tuple( tab->id, primary ) );
-    if( !obj ) return table_end_itr;
-
-    secondary = obj->secondary_key.v;
-
-    return keyval_cache.add( *obj );
+const index_double_object* database_wrapper::db_idx_double_lowerbound_obj( const table_id_object& tab, uint64_t secondary ) const {
+    return idx_lowerbound_obj<index_double_object>( tab, float64_t { secondary } );
 }
 
-int database_wrapper::db_idx_double_lowerbound( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_double_object>::type, by_secondary>();
-    auto sec = float64_t { secondary };
-    auto itr = idx.lower_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = itr->secondary_key.v;
-
-    return keyval_cache.add( *itr );
+const index_double_object* database_wrapper::db_idx_double_upperbound_obj( const table_id_object& tab, uint64_t secondary ) const {
+    return idx_upperbound_obj<index_double_object>( tab, float64_t { secondary } );
 }
 
-int database_wrapper::db_idx_double_upperbound( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_double_object>::type, by_secondary>();
-    auto sec = float64_t { secondary };
-    auto itr = idx.upper_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = itr->secondary_key.v;
-
-    return keyval_cache.add( *itr );
+const index_double_object* database_wrapper::db_idx_double_next_obj( const index_double_object& obj ) const {
+    return idx_next_obj<index_double_object>( obj );
 }
 
-int database_wrapper::db_idx_double_end( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    return keyval_cache.cache_table( *tab );
+const index_double_object* database_wrapper::db_idx_double_previous_obj( const index_double_object& obj ) const {
+    return idx_previous_obj<index_double_object>( obj );
 }
 
-int database_wrapper::db_idx_double_next( iterator_cache<index_double_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    if( iterator < -1 ) return -1; // cannot increment past end iterator of index
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_double_object>::type, by_secondary>();
-
-    auto itr = idx.iterator_to(obj);
-    ++itr;
-
-    if( itr == idx.end() || itr->t_id != obj.t_id ) return keyval_cache.get_end_iterator_by_table_id(obj.t_id);
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+const index_double_object* database_wrapper::db_idx_double_last_obj( const table_id_object& tab ) const {
+    return idx_last_obj<index_double_object>( tab );
 }
 
-int database_wrapper::db_idx_double_previous( iterator_cache<index_double_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_double_object>::type, by_secondary>();
-
-    if( iterator < -1 ) // is end iterator
-    {
-        auto tab = keyval_cache.find_table_by_end_iterator(iterator);
-        EOS_ASSERT( tab, invalid_table_iterator, "not a valid end iterator" );
-
-        auto itr = idx.upper_bound(tab->id);
-        if( idx.begin() == idx.end() || itr == idx.begin() ) return -1; // Empty index
-
-        --itr;
-
-        if( itr->t_id != tab->id ) return -1; // Empty index
-
-        primary = itr->primary_key;
-        return keyval_cache.add(*itr);
-    }
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-
-    auto itr = idx.iterator_to(obj);
-    if( itr == idx.begin() ) return -1; // cannot decrement past beginning iterator of index
-
-    --itr;
-
-    if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of index
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+void database_wrapper::db_idx_double_remove_obj( const index_double_object& obj, const table_id_object& table_obj, u_int64_t receiver ) {
+    idx_remove_obj<index_double_object>( obj, table_obj, receiver );
 }
 
 const index_long_double_object& database_wrapper::create_idx_long_double_object( const table_id_object& tab, uint64_t payer, uint64_t id, Float128 secondary ) {
@@ -910,140 +748,36 @@ void database_wrapper::update_idx_long_double_object( const index_long_double_ob
     });
 }
 
-void database_wrapper::db_idx_long_double_remove( iterator_cache<index_long_double_object>& keyval_cache, int iterator, u_int64_t receiver ) {
-    const index_long_double_object& obj = keyval_cache.get( iterator );
-    const auto& table_obj = keyval_cache.get_table( obj.t_id );
-    EOS_ASSERT( table_obj.code == name(receiver), table_access_violation, "db access violation" );
-
-    this->modify( table_obj, [&]( auto& t ) {
-        --t.count;
-    });
-    this->remove( obj );
-
-    if (table_obj.count == 0) {
-        this->remove_table(table_obj);
-    }
-
-    keyval_cache.remove( iterator );
+const index_long_double_object* database_wrapper::db_idx_long_double_find_secondary_obj( const table_id_object& tab, Float128 secondary ) const {
+    return idx_find_secondary_obj<index_long_double_object>( tab, to_float128(secondary) );
 }
 
-int database_wrapper::db_idx_long_double_find_secondary( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128 secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    auto sec = to_float128(secondary);
-
-    const auto* obj = this->find<index_long_double_object, by_secondary>( boost::make_tuple( tab->id, sec ) );
-    if( !obj ) return table_end_itr;
-
-    primary = obj->primary_key;
-
-    return keyval_cache.add( *obj );
+const index_long_double_object* database_wrapper::db_idx_long_double_find_primary_obj( const table_id_object& tab, uint64_t primary ) const {
+    return idx_find_primary_obj<index_long_double_object>( tab, primary );
 }
 
-int database_wrapper::db_idx_long_double_find_primary( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128& secondary, uint64_t primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-
-    const auto* obj = this->find<index_long_double_object, by_primary>( boost::make_tuple( tab->id, primary ) );
-    if( !obj ) return table_end_itr;
-
-    secondary = from_float128(obj->secondary_key);
-
-    return keyval_cache.add( *obj );
+const index_long_double_object* database_wrapper::db_idx_long_double_lowerbound_obj( const table_id_object& tab, Float128 secondary ) const {
+    return idx_lowerbound_obj<index_long_double_object>( tab, to_float128(secondary) );
 }
 
-int database_wrapper::db_idx_long_double_lowerbound( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    auto sec = to_float128(secondary);
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_long_double_object>::type, by_secondary>();
-    auto itr = idx.lower_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = from_float128(itr->secondary_key);
-
-    return keyval_cache.add( *itr );
+const index_long_double_object* database_wrapper::db_idx_long_double_upperbound_obj( const table_id_object& tab, Float128 secondary ) const {
+    return idx_upperbound_obj<index_long_double_object>( tab, to_float128(secondary) );
 }
 
-int database_wrapper::db_idx_long_double_upperbound( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128& secondary, uint64_t& primary ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    auto table_end_itr = keyval_cache.cache_table( *tab );
-    auto sec = to_float128(secondary);
-
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_long_double_object>::type, by_secondary>();
-    auto itr = idx.upper_bound( boost::make_tuple( tab->id, sec ) );
-    if( itr == idx.end() ) return table_end_itr;
-    if( itr->t_id != tab->id ) return table_end_itr;
-
-    primary = itr->primary_key;
-    secondary = from_float128(itr->secondary_key);
-
-    return keyval_cache.add( *itr );
+const index_long_double_object* database_wrapper::db_idx_long_double_next_obj( const index_long_double_object& obj ) const {
+    return idx_next_obj<index_long_double_object>( obj );
 }
 
-int database_wrapper::db_idx_long_double_end( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table ) {
-    auto tab = this->find_table( code, scope, table );
-    if( !tab ) return -1;
-
-    return keyval_cache.cache_table( *tab );
+const index_long_double_object* database_wrapper::db_idx_long_double_previous_obj( const index_long_double_object& obj ) const {
+    return idx_previous_obj<index_long_double_object>( obj );
 }
 
-int database_wrapper::db_idx_long_double_next( iterator_cache<index_long_double_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    if( iterator < -1 ) return -1; // cannot increment past end iterator of index
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_long_double_object>::type, by_secondary>();
-
-    auto itr = idx.iterator_to(obj);
-    ++itr;
-
-    if( itr == idx.end() || itr->t_id != obj.t_id ) return keyval_cache.get_end_iterator_by_table_id(obj.t_id);
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+const index_long_double_object* database_wrapper::db_idx_long_double_last_obj( const table_id_object& tab ) const {
+    return idx_last_obj<index_long_double_object>( tab );
 }
 
-int database_wrapper::db_idx_long_double_previous( iterator_cache<index_long_double_object>& keyval_cache, int iterator, uint64_t& primary ) {
-    const auto& idx = this->get_index<typename chainbase::get_index_type<index_long_double_object>::type, by_secondary>();
-
-    if( iterator < -1 ) // is end iterator
-    {
-        auto tab = keyval_cache.find_table_by_end_iterator(iterator);
-        EOS_ASSERT( tab, invalid_table_iterator, "not a valid end iterator" );
-
-        auto itr = idx.upper_bound(tab->id);
-        if( idx.begin() == idx.end() || itr == idx.begin() ) return -1; // Empty index
-
-        --itr;
-
-        if( itr->t_id != tab->id ) return -1; // Empty index
-
-        primary = itr->primary_key;
-        return keyval_cache.add(*itr);
-    }
-
-    const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-
-    auto itr = idx.iterator_to(obj);
-    if( itr == idx.begin() ) return -1; // cannot decrement past beginning iterator of index
-
-    --itr;
-
-    if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of index
-
-    primary = itr->primary_key;
-    return keyval_cache.add(*itr);
+void database_wrapper::db_idx_long_double_remove_obj( const index_long_double_object& obj, const table_id_object& table_obj, u_int64_t receiver ) {
+    idx_remove_obj<index_long_double_object>( obj, table_obj, receiver );
 }
 
 }
\ No newline at end of file
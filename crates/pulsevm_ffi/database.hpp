@@ -5,16 +5,24 @@
 #include <rust/cxx.h>
 
 #include "type_defs.hpp"
-#include "iterator_cache.hpp"
 #include "objects.hpp"
 #include <fc/io/datastream.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <string>
 #include <filesystem>
+#include <thread>
+#include <vector>
 
 namespace pulsevm { namespace chain {
 
+    struct AccountSequence; // Forward declaration
+    struct AccountRamDelta; // Forward declaration
+    struct PermissionLink; // Forward declaration
     struct Authority; // Forward declaration
     struct CpuLimitResult; // Forward declaration
     struct NetLimitResult; // Forward declaration
@@ -30,6 +38,9 @@ namespace pulsevm { namespace chain {
 
     U128 index128_object_secondary_key_as_u128(const index128_object& o);
     U256 index256_object_secondary_key_as_u256(const index256_object& o);
+    uint64_t index_double_object_secondary_key_bits(const index_double_object& o);
+    Float128 index_long_double_object_secondary_key(const index_long_double_object& o);
+    int64_t table_id_value(const table_id& id);
 
 class database_wrapper : public chainbase::database {
 public:
@@ -39,32 +50,119 @@ public:
     void set_revision(int64_t revision) {
         chainbase::database::set_revision(revision);
     }
+
+    uint64_t flush_dirty_pages(uint64_t max_pages) {
+        return chainbase::database::flush_dirty_pages(max_pages);
+    }
+
+    // Records the currently resident page set of the chainbase mapping to
+    // `profile_path`; returns the number of pages recorded.
+    uint64_t save_hot_pages(rust::Str profile_path) const {
+        return chainbase::database::save_hot_pages(std::string(profile_path));
+    }
+
+    // Prefaults the page set recorded at `profile_path` via readahead
+    // advice; returns the number of pages covered. A missing or stale
+    // profile prefaults nothing.
+    uint64_t prefault_hot_pages(rust::Str profile_path) const {
+        return chainbase::database::prefault_hot_pages(std::string(profile_path));
+    }
+
+    uint64_t get_free_memory_bytes() const {
+        return chainbase::database::get_free_memory();
+    }
+
+    // Online capacity growth: extend the shared-memory file to `new_size`
+    // bytes without restarting the node. The underlying remap moves the
+    // segment's base address, so the base class drops every index
+    // registration and we immediately rebuild them; the caller must ensure
+    // no database references, iterators or undo sessions are live across
+    // the call (the Rust wrapper's write lock provides that).
+    void grow(uint64_t new_size) {
+        chainbase::database::grow(new_size);
+        add_indices();
+    }
     
     // Add your non-template wrapper methods
+    //
+    // Index registration is split into two phases. Resolving each index's
+    // shared-memory object (find-or-construct plus layout validation) is the
+    // expensive part of a cold start — it faults in the segment pages the
+    // index headers and undo stacks live on — and is independent per index,
+    // so it fans out across worker threads. Registration into the database's
+    // index list then runs serially, in declaration order, because that
+    // order defines the database's revision bookkeeping.
     void add_indices() {
-        this->add_index<account_index>();
-        this->add_index<account_metadata_index>();
-        this->add_index<permission_index>();
-        this->add_index<permission_usage_index>();
-        this->add_index<permission_link_index>();
-        this->add_index<key_value_index>();
-        this->add_index<index64_index>();
-        this->add_index<index128_index>();
-        this->add_index<index256_index>();
-        this->add_index<index_double_index>();
-        this->add_index<index_long_double_index>();
-        this->add_index<global_property_multi_index>();
-        this->add_index<dynamic_global_property_multi_index>();
-        this->add_index<table_id_multi_index>();
-        this->add_index<resource_limits::resource_limits_index>();
-        this->add_index<resource_limits::resource_usage_index>();
-        this->add_index<resource_limits::resource_limits_state_index>();
-        this->add_index<resource_limits::resource_limits_config_index>();
-        this->add_index<protocol_state_multi_index>();
-        this->add_index<account_ram_correction_index>();
-        this->add_index<code_index>();
-        this->add_index<database_header_multi_index>();
-        this->add_index<transaction_multi_index>();
+        struct index_job {
+            std::function<void()> prepare;      // worker thread: find/construct + validate
+            std::function<void()> register_fn;  // main thread, in declaration order
+            std::exception_ptr failure;
+        };
+        std::vector<index_job> jobs;
+
+        auto plan = [&]<typename Index>() {
+            auto prepared = std::make_shared<std::pair<chainbase::generic_index<Index>*, bool>>(nullptr, false);
+            index_job job;
+            job.prepare = [this, prepared]() {
+                prepared->first = this->prepare_index<Index>(prepared->second);
+            };
+            job.register_fn = [this, prepared]() {
+                this->register_prepared_index<Index>(prepared->first, prepared->second);
+            };
+            jobs.push_back(std::move(job));
+        };
+
+        plan.template operator()<account_index>();
+        plan.template operator()<account_metadata_index>();
+        plan.template operator()<permission_index>();
+        plan.template operator()<permission_usage_index>();
+        plan.template operator()<permission_link_index>();
+        plan.template operator()<key_value_index>();
+        plan.template operator()<index64_index>();
+        plan.template operator()<index128_index>();
+        plan.template operator()<index256_index>();
+        plan.template operator()<index_double_index>();
+        plan.template operator()<index_long_double_index>();
+        plan.template operator()<global_property_multi_index>();
+        plan.template operator()<dynamic_global_property_multi_index>();
+        plan.template operator()<table_id_multi_index>();
+        plan.template operator()<resource_limits::resource_limits_index>();
+        plan.template operator()<resource_limits::resource_usage_index>();
+        plan.template operator()<resource_limits::resource_limits_state_index>();
+        plan.template operator()<resource_limits::resource_limits_config_index>();
+        plan.template operator()<protocol_state_multi_index>();
+        plan.template operator()<account_ram_correction_index>();
+        plan.template operator()<code_index>();
+        plan.template operator()<database_header_multi_index>();
+        plan.template operator()<transaction_multi_index>();
+
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1)) {
+                try {
+                    jobs[i].prepare();
+                } catch (...) {
+                    jobs[i].failure = std::current_exception();
+                }
+            }
+        };
+        size_t thread_count = std::min<size_t>(
+            jobs.size(), std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count - 1);
+        for (size_t i = 1; i < thread_count; ++i)
+            workers.emplace_back(worker);
+        worker();
+        for (auto& w : workers)
+            w.join();
+
+        // Rethrow the first failure in declaration order, so errors surface
+        // the same way the serial walk reported them.
+        for (auto& job : jobs) {
+            if (job.failure)
+                std::rethrow_exception(job.failure);
+            job.register_fn();
+        }
     }
 
     void initialize_database(const genesis_state& genesis);
@@ -137,6 +235,11 @@ public:
         });
     }
 
+    // Folds the per-transaction init pair — objective cpu limit read plus
+    // zero-usage window refresh — into one bridge crossing. Order matches
+    // the former callers: the limit is computed before the decay is applied.
+    CpuLimitResult update_account_usage_and_get_cpu_limit(uint64_t account, uint32_t time_slot, uint32_t greylist_limit);
+
     void add_transaction_usage(uint64_t account, uint64_t cpu_usage, uint64_t net_usage, uint32_t time_slot ) {
         const auto& state = this->get<resource_limits::resource_limits_state_object>();
         const auto& config = this->get<resource_limits::resource_limits_config_object>();
@@ -235,6 +338,11 @@ public:
         });
     }
 
+    // Batched write-back of the Rust-side RAM journal: one crossing applies
+    // every per-account delta a transaction accumulated and folds the limit
+    // check in for accounts whose usage grew.
+    void apply_ram_usage_deltas( rust::Slice<const AccountRamDelta> deltas );
+
     void verify_account_ram_usage( uint64_t account ) {
         int64_t ram_bytes; int64_t net_weight; int64_t cpu_weight;
         get_account_limits( account, ram_bytes, net_weight, cpu_weight );
@@ -479,16 +587,12 @@ public:
         });
     }
 
-    int db_find_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id, CxxKeyValueIteratorCache& keyval_cache ) {
-        const auto* tab = find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        auto table_end_itr = keyval_cache.cache_table( *tab );
-
-        const key_value_object* obj = this->find<key_value_object, by_scope_primary>( boost::make_tuple( tab->id, id ) );
-        if( !obj ) return table_end_itr;
-
-        return keyval_cache.add( *obj );
+    // Cache-free tree-step primitives for the contract db host functions.
+    // Iterator bookkeeping lives on the Rust side (pulsevm_ffi::IteratorCache);
+    // these only perform the multi-index step and hand back raw row pointers,
+    // so they cannot throw and need no error marshaling across the bridge.
+    const key_value_object* db_find_i64_obj( const table_id_object& tab, uint64_t id ) const {
+        return this->find<key_value_object, by_scope_primary>( boost::make_tuple( tab.id, id ) );
     }
 
     const key_value_object& create_key_value_object( const table_id_object& tab, uint64_t payer, uint64_t id, rust::Slice<const std::uint8_t> buffer ) {
@@ -750,6 +854,18 @@ public:
       } FC_CAPTURE_AND_RETHROW((authorizer_account)(scope)(act_name))
    }
 
+    // Enumerates every permission link in by_action_name order, i.e. sorted
+    // by (account, code, message_type) as raw name values. Feeds the
+    // Rust-side link mirror rebuild; see `Database::lookup_linked_permission`
+    // in src/database.rs.
+    rust::Vec<PermissionLink> collect_permission_links() const;
+
+    // Enumerates every direct key factor of every permission authority,
+    // one row per (key, permission) pair. Feeds the Rust-side
+    // key→permission reverse index rebuild; see
+    // `Database::key_satisfies_permission_alone` in src/database.rs.
+    rust::Vec<PermissionAuthorityKey> collect_permission_authority_keys() const;
+
     const dynamic_global_property_object& get_dynamic_global_properties() const {
         return this->get<dynamic_global_property_object>();
     }
@@ -760,138 +876,108 @@ public:
 
     void set_global_properties(const ChainConfigV0& chain_config);
 
-    uint64_t next_recv_sequence( const account_metadata_object& receiver_account ) {
-        this->modify( receiver_account, [&]( auto& ra ) {
-            ++ra.recv_sequence;
-        });
-
-        return receiver_account.recv_sequence;
-    }
-
-    uint64_t next_auth_sequence( u_int64_t actor ) {
-        const auto& amo = this->get<account_metadata_object,by_name>( name(actor) );
-        this->modify( amo, [&](auto& am ){
-            ++am.auth_sequence;
-        });
-        return amo.auth_sequence;
+    uint64_t get_global_action_sequence() const {
+        return this->get_dynamic_global_properties().global_action_sequence;
     }
 
-    uint64_t next_global_sequence() {
-        const auto& p = this->get_dynamic_global_properties();
-        
-        this->modify( p, [&]( auto& dgp ) {
-            ++dgp.global_action_sequence;
-        });
+    // Batched write-back of the Rust-side sequence shadow: the action
+    // sequence counters are incremented as plain integers during block
+    // execution and land here once per block, instead of one modify per
+    // action receipt.
+    void flush_sequence_counters( uint64_t global_action_sequence,
+                                  rust::Slice<const AccountSequence> recv_sequences,
+                                  rust::Slice<const AccountSequence> auth_sequences );
 
-        return p.global_action_sequence;
+    const key_value_object* db_lowerbound_i64_obj( const table_id_object& tab, uint64_t id ) const {
+        const auto& idx = this->get_index<key_value_index, by_scope_primary>();
+        auto itr = idx.lower_bound( boost::make_tuple( tab.id, id ) );
+        if( itr == idx.end() || itr->t_id != tab.id ) return nullptr;
+        return &*itr;
     }
 
-    int64_t db_remove_i64( iterator_cache<key_value_object>& keyval_cache, int iterator, u_int64_t receiver ) {
-        const key_value_object& obj = keyval_cache.get( iterator );
-        const auto& table_obj = keyval_cache.get_table( obj.t_id );
-        EOS_ASSERT( table_obj.code == name(receiver), table_access_violation, "db access violation" );
-        auto delta = -(obj.value.size() + config::billable_size_v<key_value_object>);
-
-        this->modify( table_obj, [&]( auto& t ) {
-            --t.count;
-        });
-        this->remove( obj );
-
-        if (table_obj.count == 0) {
-            this->remove_table(table_obj);
-        }
-
-        keyval_cache.remove( iterator );
-
-        return delta;
+    const key_value_object* db_upperbound_i64_obj( const table_id_object& tab, uint64_t id ) const {
+        const auto& idx = this->get_index<key_value_index, by_scope_primary>();
+        auto itr = idx.upper_bound( boost::make_tuple( tab.id, id ) );
+        if( itr == idx.end() || itr->t_id != tab.id ) return nullptr;
+        return &*itr;
     }
 
-    int db_next_i64( iterator_cache<key_value_object>& keyval_cache, int iterator, uint64_t& primary ) {
-        if( iterator < -1 ) return -1; // cannot increment past end iterator of table
-
-        const auto& obj = keyval_cache.get( iterator ); // Check for iterator != -1 happens in this call
+    /// Successor of `obj` within its table, or nullptr at the table end.
+    const key_value_object* db_next_i64_obj( const key_value_object& obj ) const {
         const auto& idx = this->get_index<key_value_index, by_scope_primary>();
-
         auto itr = idx.iterator_to( obj );
         ++itr;
-
-        if( itr == idx.end() || itr->t_id != obj.t_id ) return keyval_cache.get_end_iterator_by_table_id(obj.t_id);
-
-        primary = itr->primary_key;
-        return keyval_cache.add( *itr );
-    }
-
-    int db_previous_i64( iterator_cache<key_value_object>& keyval_cache, int iterator, uint64_t& primary ) {
+        if( itr == idx.end() || itr->t_id != obj.t_id ) return nullptr;
+        return &*itr;
+    }
+
+    /// Bulk successor walk for range scans: collects up to the window size
+    /// (the smaller of the two out slices) rows following `obj` in its table
+    /// in one call. A lookahead iterator runs a few nodes ahead of the
+    /// collection point issuing prefetches for the tree node and the row
+    /// payload, so the node-to-node pointer chase through the shared mapping
+    /// overlaps its cache misses instead of serializing them. Returns the
+    /// number of rows written; fewer than the window means the table is
+    /// exhausted. Row addresses are returned as uintptr values for the Rust
+    /// iterator cache, which already holds rows by raw pointer.
+    size_t db_next_i64_window( const key_value_object& obj,
+                               rust::Slice<uint64_t> out_primaries,
+                               rust::Slice<size_t> out_rows ) const {
+        static constexpr size_t prefetch_distance = 4;
         const auto& idx = this->get_index<key_value_index, by_scope_primary>();
 
-        if( iterator < -1 ) // is end iterator
-        {
-            auto tab = keyval_cache.find_table_by_end_iterator(iterator);
-            EOS_ASSERT( tab, invalid_table_iterator, "not a valid end iterator" );
-
-            auto itr = idx.upper_bound(tab->id);
-            if( idx.begin() == idx.end() || itr == idx.begin() ) return -1; // Empty table
-
-            --itr;
-
-            if( itr->t_id != tab->id ) return -1; // Empty table
-
-            primary = itr->primary_key;
-            return keyval_cache.add(*itr);
+        auto ahead = idx.iterator_to( obj );
+        bool ahead_done = false;
+        auto step_ahead = [&]() {
+            if( ahead_done ) return;
+            ++ahead;
+            if( ahead == idx.end() || ahead->t_id != obj.t_id ) {
+                ahead_done = true;
+                return;
+            }
+            __builtin_prefetch( std::addressof( *ahead ) );
+            __builtin_prefetch( ahead->value.data() );
+        };
+        for( size_t i = 0; i < prefetch_distance; ++i ) step_ahead();
+
+        const size_t window = std::min( out_primaries.size(), out_rows.size() );
+        size_t n = 0;
+        auto cur = idx.iterator_to( obj );
+        while( n < window ) {
+            ++cur;
+            if( cur == idx.end() || cur->t_id != obj.t_id ) break;
+            step_ahead();
+            const key_value_object& row = *cur;
+            out_primaries[n] = row.primary_key;
+            out_rows[n] = reinterpret_cast<size_t>( std::addressof( row ) );
+            ++n;
         }
-
-        const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-
-        auto itr = idx.iterator_to(obj);
-        if( itr == idx.begin() ) return -1; // cannot decrement past beginning iterator of table
-
-        --itr;
-
-        if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of table
-
-        primary = itr->primary_key;
-        return keyval_cache.add(*itr);
+        return n;
     }
 
-    int db_end_i64( iterator_cache<key_value_object>& keyval_cache,  uint64_t code,  uint64_t scope,  uint64_t table ) {
-        const auto* tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        return keyval_cache.cache_table( *tab );
-    }
-
-    int db_lowerbound_i64( iterator_cache<key_value_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
-        const auto* tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        auto table_end_itr = keyval_cache.cache_table( *tab );
-
+    /// Predecessor of `obj` within its table, or nullptr at the table begin.
+    const key_value_object* db_previous_i64_obj( const key_value_object& obj ) const {
         const auto& idx = this->get_index<key_value_index, by_scope_primary>();
-        auto itr = idx.lower_bound( boost::make_tuple( tab->id, id ) );
-        if( itr == idx.end() ) return table_end_itr;
-        if( itr->t_id != tab->id ) return table_end_itr;
-
-        return keyval_cache.add( *itr );
+        auto itr = idx.iterator_to( obj );
+        if( itr == idx.begin() ) return nullptr;
+        --itr;
+        if( itr->t_id != obj.t_id ) return nullptr;
+        return &*itr;
     }
 
-    int db_upperbound_i64( iterator_cache<key_value_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
-        const auto* tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        auto table_end_itr = keyval_cache.cache_table( *tab );
-
+    /// Last row of the table, or nullptr if the table is empty.
+    const key_value_object* db_last_i64_obj( const table_id_object& tab ) const {
         const auto& idx = this->get_index<key_value_index, by_scope_primary>();
-        auto itr = idx.upper_bound( boost::make_tuple( tab->id, id ) );
-        if( itr == idx.end() ) return table_end_itr;
-        if( itr->t_id != tab->id ) return table_end_itr;
-
-        return keyval_cache.add( *itr );
+        auto itr = idx.upper_bound( tab.id );
+        if( idx.begin() == idx.end() || itr == idx.begin() ) return nullptr;
+        --itr;
+        if( itr->t_id != tab.id ) return nullptr;
+        return &*itr;
     }
 
-    void db_idx64_remove( iterator_cache<index64_object>& keyval_cache, int iterator, u_int64_t receiver ) {
-        const index64_object& obj = keyval_cache.get( iterator );
-        const auto& table_obj = keyval_cache.get_table( obj.t_id );
+    int64_t db_remove_i64_obj( const key_value_object& obj, const table_id_object& table_obj, u_int64_t receiver ) {
         EOS_ASSERT( table_obj.code == name(receiver), table_access_violation, "db access violation" );
+        auto delta = -(obj.value.size() + config::billable_size_v<key_value_object>);
 
         this->modify( table_obj, [&]( auto& t ) {
             --t.count;
@@ -902,167 +988,83 @@ public:
             this->remove_table(table_obj);
         }
 
-        keyval_cache.remove( iterator );
+        return delta;
     }
 
-    int db_idx64_find_secondary( iterator_cache<index64_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t secondary, uint64_t& primary ) {
-        auto tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        auto table_end_itr = keyval_cache.cache_table( *tab );
-
-        const auto* obj = this->find<index64_object, by_secondary>( boost::make_tuple( tab->id, secondary ) );
-        if( !obj ) return table_end_itr;
-
-        primary = obj->primary_key;
-
-        return keyval_cache.add( *obj );
+    const index64_object* db_idx64_find_secondary_obj( const table_id_object& tab, uint64_t secondary ) const {
+        return idx_find_secondary_obj<index64_object>( tab, secondary );
     }
 
-    int db_idx64_find_primary( iterator_cache<index64_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t primary ) {
-        auto tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        auto table_end_itr = keyval_cache.cache_table( *tab );
-
-        const auto* obj = this->find<index64_object, by_primary>( boost::make_tuple( tab->id, primary ) );
-        if( !obj ) return table_end_itr;
-
-        secondary = obj->secondary_key;
-
-        return keyval_cache.add( *obj );
+    const index64_object* db_idx64_find_primary_obj( const table_id_object& tab, uint64_t primary ) const {
+        return idx_find_primary_obj<index64_object>( tab, primary );
     }
 
-    int db_idx64_lowerbound( iterator_cache<index64_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t& primary ) {
-        auto tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        auto table_end_itr = keyval_cache.cache_table( *tab );
-
-        const auto& idx = this->get_index<typename chainbase::get_index_type<index64_object>::type, by_secondary>();
-        auto itr = idx.lower_bound( boost::make_tuple( tab->id, secondary ) );
-        if( itr == idx.end() ) return table_end_itr;
-        if( itr->t_id != tab->id ) return table_end_itr;
-
-        primary = itr->primary_key;
-        secondary = itr->secondary_key;
-
-        return keyval_cache.add( *itr );
+    const index64_object* db_idx64_lowerbound_obj( const table_id_object& tab, uint64_t secondary ) const {
+        return idx_lowerbound_obj<index64_object>( tab, secondary );
     }
 
-    int db_idx64_upperbound( iterator_cache<index64_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t& primary ) {
-        auto tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        auto table_end_itr = keyval_cache.cache_table( *tab );
-
-        const auto& idx = this->get_index<typename chainbase::get_index_type<index64_object>::type, by_secondary>();
-        auto itr = idx.upper_bound( boost::make_tuple( tab->id, secondary ) );
-        if( itr == idx.end() ) return table_end_itr;
-        if( itr->t_id != tab->id ) return table_end_itr;
-
-        primary = itr->primary_key;
-        secondary = itr->secondary_key;
-
-        return keyval_cache.add( *itr );
+    const index64_object* db_idx64_upperbound_obj( const table_id_object& tab, uint64_t secondary ) const {
+        return idx_upperbound_obj<index64_object>( tab, secondary );
     }
 
-    int db_idx64_end( iterator_cache<index64_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table ) {
-        auto tab = this->find_table( code, scope, table );
-        if( !tab ) return -1;
-
-        return keyval_cache.cache_table( *tab );
+    const index64_object* db_idx64_next_obj( const index64_object& obj ) const {
+        return idx_next_obj<index64_object>( obj );
     }
 
-    int db_idx64_next( iterator_cache<index64_object>& keyval_cache, int iterator, uint64_t& primary ) {
-        if( iterator < -1 ) return -1; // cannot increment past end iterator of index
-
-        const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-        const auto& idx = this->get_index<typename chainbase::get_index_type<index64_object>::type, by_secondary>();
-
-        auto itr = idx.iterator_to(obj);
-        ++itr;
-
-        if( itr == idx.end() || itr->t_id != obj.t_id ) return keyval_cache.get_end_iterator_by_table_id(obj.t_id);
-
-        primary = itr->primary_key;
-        return keyval_cache.add(*itr);
+    const index64_object* db_idx64_previous_obj( const index64_object& obj ) const {
+        return idx_previous_obj<index64_object>( obj );
     }
 
-    int db_idx64_previous( iterator_cache<index64_object>& keyval_cache, int iterator, uint64_t& primary ) {
-        const auto& idx = this->get_index<typename chainbase::get_index_type<index64_object>::type, by_secondary>();
-
-        if( iterator < -1 ) // is end iterator
-        {
-            auto tab = keyval_cache.find_table_by_end_iterator(iterator);
-            EOS_ASSERT( tab, invalid_table_iterator, "not a valid end iterator" );
-
-            auto itr = idx.upper_bound(tab->id);
-            if( idx.begin() == idx.end() || itr == idx.begin() ) return -1; // Empty index
-
-            --itr;
-
-            if( itr->t_id != tab->id ) return -1; // Empty index
-
-            primary = itr->primary_key;
-            return keyval_cache.add(*itr);
-        }
-
-        const auto& obj = keyval_cache.get(iterator); // Check for iterator != -1 happens in this call
-
-        auto itr = idx.iterator_to(obj);
-        if( itr == idx.begin() ) return -1; // cannot decrement past beginning iterator of index
-
-        --itr;
-
-        if( itr->t_id != obj.t_id ) return -1; // cannot decrement past beginning iterator of index
+    const index64_object* db_idx64_last_obj( const table_id_object& tab ) const {
+        return idx_last_obj<index64_object>( tab );
+    }
 
-        primary = itr->primary_key;
-        return keyval_cache.add(*itr);
+    void db_idx64_remove_obj( const index64_object& obj, const table_id_object& table_obj, u_int64_t receiver ) {
+        idx_remove_obj<index64_object>( obj, table_obj, receiver );
     }
 
     void update_index128_object( const index128_object& obj, uint64_t payer, U128 secondary );
-    void db_idx128_remove( iterator_cache<index128_object>& keyval_cache, int iterator, u_int64_t receiver );
-    int db_idx128_find_secondary( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128 secondary, uint64_t& primary );
-    int db_idx128_find_primary( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128& secondary, uint64_t primary );
-    int db_idx128_lowerbound( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128& secondary, uint64_t& primary );
-    int db_idx128_upperbound( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U128& secondary, uint64_t& primary );
-    int db_idx128_end( iterator_cache<index128_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table );
-    int db_idx128_next( iterator_cache<index128_object>& keyval_cache, int iterator, uint64_t& primary );
-    int db_idx128_previous( iterator_cache<index128_object>& keyval_cache, int iterator, uint64_t& primary );
+    const index128_object* db_idx128_find_secondary_obj( const table_id_object& tab, U128 secondary ) const;
+    const index128_object* db_idx128_find_primary_obj( const table_id_object& tab, uint64_t primary ) const;
+    const index128_object* db_idx128_lowerbound_obj( const table_id_object& tab, U128 secondary ) const;
+    const index128_object* db_idx128_upperbound_obj( const table_id_object& tab, U128 secondary ) const;
+    const index128_object* db_idx128_next_obj( const index128_object& obj ) const;
+    const index128_object* db_idx128_previous_obj( const index128_object& obj ) const;
+    const index128_object* db_idx128_last_obj( const table_id_object& tab ) const;
+    void db_idx128_remove_obj( const index128_object& obj, const table_id_object& table_obj, u_int64_t receiver );
 
     const index256_object& create_index256_object( const table_id_object& tab, uint64_t payer, uint64_t id, U256 secondary );
     void update_index256_object( const index256_object& obj, uint64_t payer, U256 secondary );
-    void db_idx256_remove( iterator_cache<index256_object>& keyval_cache, int iterator, u_int64_t receiver );
-    int db_idx256_find_secondary( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256 secondary, uint64_t& primary );
-    int db_idx256_find_primary( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256& secondary, uint64_t primary );
-    int db_idx256_lowerbound( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256& secondary, uint64_t& primary );
-    int db_idx256_upperbound( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, U256& secondary, uint64_t& primary );
-    int db_idx256_end( iterator_cache<index256_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table );
-    int db_idx256_next( iterator_cache<index256_object>& keyval_cache, int iterator, uint64_t& primary );
-    int db_idx256_previous( iterator_cache<index256_object>& keyval_cache, int iterator, uint64_t& primary );
+    const index256_object* db_idx256_find_secondary_obj( const table_id_object& tab, U256 secondary ) const;
+    const index256_object* db_idx256_find_primary_obj( const table_id_object& tab, uint64_t primary ) const;
+    const index256_object* db_idx256_lowerbound_obj( const table_id_object& tab, U256 secondary ) const;
+    const index256_object* db_idx256_upperbound_obj( const table_id_object& tab, U256 secondary ) const;
+    const index256_object* db_idx256_next_obj( const index256_object& obj ) const;
+    const index256_object* db_idx256_previous_obj( const index256_object& obj ) const;
+    const index256_object* db_idx256_last_obj( const table_id_object& tab ) const;
+    void db_idx256_remove_obj( const index256_object& obj, const table_id_object& table_obj, u_int64_t receiver );
 
     const index_double_object& create_idx_double_object( const table_id_object& tab, uint64_t payer, uint64_t id, uint64_t secondary );
     void update_idx_double_object( const index_double_object& obj, uint64_t payer, uint64_t secondary );
-    void db_idx_double_remove( iterator_cache<index_double_object>& keyval_cache, int iterator, u_int64_t receiver );
-    int db_idx_double_find_secondary( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t secondary, uint64_t& primary );
-    int db_idx_double_find_primary( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t primary );
-    int db_idx_double_lowerbound( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t& primary );
-    int db_idx_double_upperbound( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, uint64_t& secondary, uint64_t& primary );
-    int db_idx_double_end( iterator_cache<index_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table );
-    int db_idx_double_next( iterator_cache<index_double_object>& keyval_cache, int iterator, uint64_t& primary );
-    int db_idx_double_previous( iterator_cache<index_double_object>& keyval_cache, int iterator, uint64_t& primary );
+    const index_double_object* db_idx_double_find_secondary_obj( const table_id_object& tab, uint64_t secondary ) const;
+    const index_double_object* db_idx_double_find_primary_obj( const table_id_object& tab, uint64_t primary ) const;
+    const index_double_object* db_idx_double_lowerbound_obj( const table_id_object& tab, uint64_t secondary ) const;
+    const index_double_object* db_idx_double_upperbound_obj( const table_id_object& tab, uint64_t secondary ) const;
+    const index_double_object* db_idx_double_next_obj( const index_double_object& obj ) const;
+    const index_double_object* db_idx_double_previous_obj( const index_double_object& obj ) const;
+    const index_double_object* db_idx_double_last_obj( const table_id_object& tab ) const;
+    void db_idx_double_remove_obj( const index_double_object& obj, const table_id_object& table_obj, u_int64_t receiver );
 
     const index_long_double_object& create_idx_long_double_object( const table_id_object& tab, uint64_t payer, uint64_t id, Float128 secondary );
     void update_idx_long_double_object( const index_long_double_object& obj, uint64_t payer, Float128 secondary );
-    void db_idx_long_double_remove( iterator_cache<index_long_double_object>& keyval_cache, int iterator, u_int64_t receiver );
-    int db_idx_long_double_find_secondary( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128 secondary, uint64_t& primary );
-    int db_idx_long_double_find_primary( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128& secondary, uint64_t primary );
-    int db_idx_long_double_lowerbound( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128& secondary, uint64_t& primary );
-    int db_idx_long_double_upperbound( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table, Float128& secondary, uint64_t& primary );
-    int db_idx_long_double_end( iterator_cache<index_long_double_object>& keyval_cache, uint64_t code, uint64_t scope, uint64_t table );
-    int db_idx_long_double_next( iterator_cache<index_long_double_object>& keyval_cache, int iterator, uint64_t& primary );
-    int db_idx_long_double_previous( iterator_cache<index_long_double_object>& keyval_cache, int iterator, uint64_t& primary );
+    const index_long_double_object* db_idx_long_double_find_secondary_obj( const table_id_object& tab, Float128 secondary ) const;
+    const index_long_double_object* db_idx_long_double_find_primary_obj( const table_id_object& tab, uint64_t primary ) const;
+    const index_long_double_object* db_idx_long_double_lowerbound_obj( const table_id_object& tab, Float128 secondary ) const;
+    const index_long_double_object* db_idx_long_double_upperbound_obj( const table_id_object& tab, Float128 secondary ) const;
+    const index_long_double_object* db_idx_long_double_next_obj( const index_long_double_object& obj ) const;
+    const index_long_double_object* db_idx_long_double_previous_obj( const index_long_double_object& obj ) const;
+    const index_long_double_object* db_idx_long_double_last_obj( const table_id_object& tab ) const;
+    void db_idx_long_double_remove_obj( const index_long_double_object& obj, const table_id_object& table_obj, u_int64_t receiver );
 
     uint64_t get_virtual_block_cpu_limit() const {
         const auto& state = this->get<resource_limits::resource_limits_state_object>();
@@ -1103,13 +1105,107 @@ public:
         }
     }
 
-    void clear_expired_input_transactions(const TimePoint& cutoff);
+    // Removes at most max_removals expired entries (oldest first) and returns
+    // how many were removed; the bound keeps the per-block sweep cost constant
+    // under expiry storms, with the backlog draining over subsequent blocks.
+    uint32_t clear_expired_input_transactions(const TimePoint& cutoff, uint32_t max_removals);
 
     std::unique_ptr<chainbase::database::session> create_undo_session(bool enabled) {
         return std::make_unique<chainbase::database::session>(this->start_undo_session(enabled));
     }
 
+    // --- Bulk-load mode ---------------------------------------------------
+    // For genesis bootstraps and large state imports. Creates outside an
+    // undo session are already untracked, so the win is the insert path
+    // itself: rows arrive sorted by primary key and append through the
+    // hinted end-insertion in undo_index::emplace_back instead of paying a
+    // tree descent per row per index. begin() refuses to enter the mode
+    // while any undo session is live; end() seals the import by setting the
+    // database revision. Tables must be imported in creation order so each
+    // new row lands at the end of the global (t_id, primary) ordering.
+    void bulk_load_begin();
+    void bulk_load_end( int64_t revision );
+    int64_t bulk_load_store_sorted( uint64_t code, uint64_t scope, uint64_t table, uint64_t payer,
+                                    rust::Slice<const uint64_t> ids,
+                                    rust::Slice<const uint8_t> values,
+                                    rust::Slice<const uint64_t> value_sizes );
+
     rust::Vec<uint8_t> pack_deltas(bool full_snapshot) const;
+
+private:
+    bool _bulk_load_active = false;
+
+    // Shared stepping logic for the five secondary-index families. As with the
+    // key_value primitives above, nullptr means miss / end / begin; the typed
+    // db_idx*_obj shims handle the bridge-type conversions.
+    template<typename ObjectType>
+    const ObjectType* idx_find_secondary_obj( const table_id_object& tab, const typename ObjectType::secondary_key_type& secondary ) const {
+        return this->find<ObjectType, by_secondary>( boost::make_tuple( tab.id, secondary ) );
+    }
+
+    template<typename ObjectType>
+    const ObjectType* idx_find_primary_obj( const table_id_object& tab, uint64_t primary ) const {
+        return this->find<ObjectType, by_primary>( boost::make_tuple( tab.id, primary ) );
+    }
+
+    template<typename ObjectType>
+    const ObjectType* idx_lowerbound_obj( const table_id_object& tab, const typename ObjectType::secondary_key_type& secondary ) const {
+        const auto& idx = this->get_index<typename chainbase::get_index_type<ObjectType>::type, by_secondary>();
+        auto itr = idx.lower_bound( boost::make_tuple( tab.id, secondary ) );
+        if( itr == idx.end() || itr->t_id != tab.id ) return nullptr;
+        return &*itr;
+    }
+
+    template<typename ObjectType>
+    const ObjectType* idx_upperbound_obj( const table_id_object& tab, const typename ObjectType::secondary_key_type& secondary ) const {
+        const auto& idx = this->get_index<typename chainbase::get_index_type<ObjectType>::type, by_secondary>();
+        auto itr = idx.upper_bound( boost::make_tuple( tab.id, secondary ) );
+        if( itr == idx.end() || itr->t_id != tab.id ) return nullptr;
+        return &*itr;
+    }
+
+    template<typename ObjectType>
+    const ObjectType* idx_next_obj( const ObjectType& obj ) const {
+        const auto& idx = this->get_index<typename chainbase::get_index_type<ObjectType>::type, by_secondary>();
+        auto itr = idx.iterator_to( obj );
+        ++itr;
+        if( itr == idx.end() || itr->t_id != obj.t_id ) return nullptr;
+        return &*itr;
+    }
+
+    template<typename ObjectType>
+    const ObjectType* idx_previous_obj( const ObjectType& obj ) const {
+        const auto& idx = this->get_index<typename chainbase::get_index_type<ObjectType>::type, by_secondary>();
+        auto itr = idx.iterator_to( obj );
+        if( itr == idx.begin() ) return nullptr;
+        --itr;
+        if( itr->t_id != obj.t_id ) return nullptr;
+        return &*itr;
+    }
+
+    template<typename ObjectType>
+    const ObjectType* idx_last_obj( const table_id_object& tab ) const {
+        const auto& idx = this->get_index<typename chainbase::get_index_type<ObjectType>::type, by_secondary>();
+        auto itr = idx.upper_bound( tab.id );
+        if( idx.begin() == idx.end() || itr == idx.begin() ) return nullptr;
+        --itr;
+        if( itr->t_id != tab.id ) return nullptr;
+        return &*itr;
+    }
+
+    template<typename ObjectType>
+    void idx_remove_obj( const ObjectType& obj, const table_id_object& table_obj, u_int64_t receiver ) {
+        EOS_ASSERT( table_obj.code == name(receiver), table_access_violation, "db access violation" );
+
+        this->modify( table_obj, [&]( auto& t ) {
+            --t.count;
+        });
+        this->remove( obj );
+
+        if (table_obj.count == 0) {
+            this->remove_table(table_obj);
+        }
+    }
 };
 
 // Wrapper methods for database operations
@@ -1119,14 +1215,17 @@ void undo(::chainbase::database& db);
 void commit(::chainbase::database& db, int64_t revision);
 int64_t revision(const ::chainbase::database& db);
 
-// Forward declare the enum from the bridge
+// Forward declare the enums from the bridge
 enum class DatabaseOpenFlags : uint32_t;
+enum class DbMapMode : uint32_t;
 
 // Bridge function to open database
 std::unique_ptr<pulsevm::chain::database_wrapper> open_database(
     rust::Str path,
     DatabaseOpenFlags flags,
-    uint64_t size
+    uint64_t size,
+    DbMapMode map_mode,
+    bool numa_interleave
 );
 
 } }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "multi_index_includes.hpp"
 #include "block_timestamp.hpp"
 
+#include <cstddef>
+
 namespace pulsevm { namespace chain {
 
    class account_object : public chainbase::object<account_object_type, account_object> {
@@ -18,6 +20,11 @@ namespace pulsevm { namespace chain {
    };
    using account_id_type = account_object::id_type;
 
+   // Already hot-first: id and name (the by_name lookup and its answer) lead,
+   // and the abi blob header starts at 24 — one cache line covers the object.
+   static_assert( offsetof(account_object, abi) == 24,
+                  "id, name and creation_date must stay ahead of the abi blob" );
+
    struct by_name;
    using account_index = chainbase::shared_multi_index_container<
       account_object,
@@ -35,17 +42,24 @@ namespace pulsevm { namespace chain {
          privileged = 1
       };
 
+      // Fields are ordered hot-first, not grouped by meaning: the action
+      // dispatch read (who is it, which code, how to run it) is id, name,
+      // code_hash, flags, vm_type/vm_version, and packing those together
+      // keeps the whole read inside the node's first 64-byte cache line.
+      // The per-action sequence counters start the second line, so bumping
+      // them dirties a line the dispatch read never needed. The reflection
+      // order below is unchanged — serialized form is not affected.
       id_type               id;
       account_name          name; //< name should not be changed within a chainbase modifier lambda
-      uint64_t              recv_sequence = 0;
-      uint64_t              auth_sequence = 0;
-      uint64_t              code_sequence = 0;
-      uint64_t              abi_sequence  = 0;
       digest_type           code_hash;
-      time_point            last_code_update;
       uint32_t              flags = 0;
       uint8_t               vm_type = 0;
       uint8_t               vm_version = 0;
+      time_point            last_code_update;
+      uint64_t              recv_sequence = 0;
+      uint64_t              auth_sequence = 0;
+      uint64_t              code_sequence = 0;
+      uint64_t              abi_sequence  = 0;
 
       uint64_t get_recv_sequence() const { return recv_sequence; }
       uint64_t get_auth_sequence() const { return auth_sequence; }
@@ -63,6 +77,17 @@ namespace pulsevm { namespace chain {
       }
    };
 
+   // Guards for the hot-first layout above; these fail the build instead of
+   // silently regressing if a field is added or reordered.
+   static_assert( offsetof(account_metadata_object, name) == 8,
+                  "name must follow id on the first cache line" );
+   static_assert( offsetof(account_metadata_object, code_hash) == 16,
+                  "code_hash must sit directly after the identity fields" );
+   static_assert( offsetof(account_metadata_object, vm_version) + sizeof(uint8_t) <= 64,
+                  "the dispatch read (id, name, code_hash, flags, vm_*) must fit one cache line" );
+   static_assert( offsetof(account_metadata_object, recv_sequence) == 64,
+                  "sequence counters must start on the second cache line" );
+
    struct by_name;
    using account_metadata_index = chainbase::shared_multi_index_container<
       account_metadata_object,
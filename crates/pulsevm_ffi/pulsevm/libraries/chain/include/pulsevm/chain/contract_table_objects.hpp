@@ -8,8 +8,14 @@
 #include <softfloat.hpp>
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace pulsevm { namespace chain {
 
    /**
@@ -25,6 +31,7 @@ namespace pulsevm { namespace chain {
       name           payer;
       uint32_t       count = 0; /// the number of elements in the table
 
+      int64_t get_id() const { return id._id; }
       const name& get_code() const { return code; }
       const name& get_scope() const { return scope; }
       const name& get_table() const { return table; }
@@ -142,8 +149,47 @@ namespace pulsevm { namespace chain {
    typedef secondary_index<uint128_t,index128_object_type>::index_index  index128_index;
 
    typedef std::array<uint128_t, 2> key256_t;
-   typedef secondary_index<key256_t,index256_object_type>::index_object index256_object;
-   typedef secondary_index<key256_t,index256_object_type>::index_index  index256_index;
+
+   /**
+    *  Orders 256-bit keys exactly like std::less<key256_t> — array element 0
+    *  first, each uint128 numerically — but decides with one vector compare
+    *  where AVX2 is available: a 256-bit byte-equality compare plus movemask
+    *  locates the deciding 64-bit limb, and a single scalar compare of that
+    *  limb orders the keys. The tree walk behind db_idx256_* runs this once
+    *  per node, so the comparator dominates lookups on large indices.
+    *
+    *  The ordering (and therefore the tree layout and on-chain iteration
+    *  order) is identical to the previous std::less comparator.
+    */
+   struct key256_less {
+      bool operator()( const key256_t& lhs, const key256_t& rhs ) const {
+#if defined(__AVX2__)
+         const __m256i a = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( lhs.data() ) );
+         const __m256i b = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( rhs.data() ) );
+         const uint32_t ne = ~static_cast<uint32_t>(
+            _mm256_movemask_epi8( _mm256_cmpeq_epi8( a, b ) ) );
+         if( ne == 0 ) return false; // keys are equal
+         // Limb significance in memory order: element 0 outranks element 1,
+         // and within each little-endian uint128 the high limb sits at the
+         // larger offset, so the 64-bit limbs rank 1, 0, 3, 2.
+         static constexpr int rank[4] = { 1, 0, 3, 2 };
+         for( int limb : rank ) {
+            if( ( ne >> ( limb * 8 ) ) & 0xFF ) {
+               uint64_t x, y;
+               std::memcpy( &x, reinterpret_cast<const char*>( lhs.data() ) + limb * 8, 8 );
+               std::memcpy( &y, reinterpret_cast<const char*>( rhs.data() ) + limb * 8, 8 );
+               return x < y;
+            }
+         }
+         return false; // unreachable: ne != 0 flags at least one limb
+#else
+         return lhs < rhs;
+#endif
+      }
+   };
+
+   typedef secondary_index<key256_t,index256_object_type,key256_less>::index_object index256_object;
+   typedef secondary_index<key256_t,index256_object_type,key256_less>::index_index  index256_index;
 
    struct soft_double_less {
       bool operator()( const float64_t& lhs, const float64_t& rhs ) const {
@@ -151,9 +197,30 @@ namespace pulsevm { namespace chain {
       }
    };
 
+   /**
+    *  Inline replica of softfloat's f128_lt for the non-NaN case, bit-for-bit
+    *  the same expression the library evaluates — two limb compares instead
+    *  of an opaque call per tree level. NaN keys (which must also raise the
+    *  softfloat invalid flag) take the original call, so behavior is
+    *  unchanged; only the call overhead on the hot comparison path is gone.
+    */
    struct soft_long_double_less {
       bool operator()( const float128_t& lhs, const float128_t& rhs ) const {
-         return f128_lt( lhs, rhs );
+         const uint64_t aHi = lhs.v[1], aLo = lhs.v[0];
+         const uint64_t bHi = rhs.v[1], bLo = rhs.v[0];
+         const auto is_nan = []( uint64_t hi, uint64_t lo ) {
+            return ( ~hi & UINT64_C( 0x7FFF000000000000 ) ) == 0
+                && ( lo || ( hi & UINT64_C( 0x0000FFFFFFFFFFFF ) ) );
+         };
+         if( __builtin_expect( is_nan( aHi, aLo ) || is_nan( bHi, bLo ), false ) )
+            return f128_lt( lhs, rhs );
+         const bool signA = aHi >> 63;
+         const bool signB = bHi >> 63;
+         if( signA != signB )
+            return signA
+                && ( ( ( aHi | bHi ) & UINT64_C( 0x7FFFFFFFFFFFFFFF ) ) | aLo | bLo );
+         const bool lt_mag = ( aHi < bHi ) || ( aHi == bHi && aLo < bLo );
+         return ( ( aHi != bHi ) || ( aLo != bLo ) ) && ( signA ^ lt_mag );
       }
    };
 
@@ -3,6 +3,8 @@
 #include "database_utils.hpp"
 #include "multi_index_includes.hpp"
 
+#include <cstddef>
+
 namespace pulsevm { namespace chain {
 
    class permission_usage_object : public chainbase::object<permission_usage_object_type, permission_usage_object> {
@@ -36,9 +38,16 @@ namespace pulsevm { namespace chain {
       int64_t get_parent_id() const { return parent._id; }
       const name& get_owner() const { return owner; }
       const name& get_name() const { return perm_name; }
+      int64_t get_last_updated_us() const { return last_updated.time_since_epoch().count(); }
       const shared_authority& get_authority() const { return auth; }
    };
 
+   // The fixed fields — every key the by_parent/by_owner/by_name walks
+   // compare, plus last_updated — occupy exactly the first 48 bytes, so one
+   // cache line covers them with the auth header starting right behind.
+   // Fails the build if a new field pushes the keys apart.
+   static_assert( offsetof(permission_object, auth) == 48,
+                  "permission keys (parent, owner, perm_name) must stay on the first cache line" );
 
    struct by_parent;
    struct by_owner;
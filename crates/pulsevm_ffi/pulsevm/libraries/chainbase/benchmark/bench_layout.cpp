@@ -0,0 +1,107 @@
+// Measures what the account_metadata_object field order costs per lookup.
+//
+// The per-action dispatch read is: name, code_hash, flags, vm_type. With the
+// sequence counters declared between name and code_hash (the old order) that
+// read spans two cache lines; with the hot fields packed up front it fits in
+// one. The two structs below reproduce both layouts field-for-field and the
+// benchmark walks a larger-than-LLC array of each in random order — the
+// access pattern of by_name lookups landing all over the index — touching
+// only the dispatch fields.
+//
+// Build with `make chainbase_bench_layout` (EXCLUDE_FROM_ALL, like the other
+// benchmarks here).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+// Field order before the hot-first packing: the sequence counters push
+// code_hash to offset 48 and flags/vm_type past the first cache line.
+struct split_line_meta {
+   int64_t  id;
+   uint64_t name;
+   uint64_t recv_sequence;
+   uint64_t auth_sequence;
+   uint64_t code_sequence;
+   uint64_t abi_sequence;
+   uint64_t code_hash[4];
+   int64_t  last_code_update;
+   uint32_t flags;
+   uint8_t  vm_type;
+   uint8_t  vm_version;
+};
+
+// Hot-first order, matching account_object.hpp: the dispatch fields end at
+// offset 54 and the sequence counters start the second line.
+struct hot_first_meta {
+   int64_t  id;
+   uint64_t name;
+   uint64_t code_hash[4];
+   uint32_t flags;
+   uint8_t  vm_type;
+   uint8_t  vm_version;
+   int64_t  last_code_update;
+   uint64_t recv_sequence;
+   uint64_t auth_sequence;
+   uint64_t code_sequence;
+   uint64_t abi_sequence;
+};
+
+static_assert(sizeof(split_line_meta) == sizeof(hot_first_meta),
+              "the reorder must not change the object's size (or its billing)");
+
+// 4M objects * 96 bytes = 384 MiB per layout, far past any L3, so every
+// random touch is a real memory access.
+constexpr std::size_t object_count = std::size_t(1) << 22;
+
+template<typename T>
+double run(const char* tag, const std::vector<uint32_t>& order) {
+   std::vector<T> objs(object_count);
+   for (std::size_t i = 0; i < object_count; ++i) {
+      objs[i].id           = int64_t(i);
+      objs[i].name         = i * 0x9E3779B97F4A7C15ull;
+      objs[i].code_hash[0] = i;
+      objs[i].flags        = uint32_t(i & 1);
+      objs[i].vm_type      = 0;
+   }
+
+   uint64_t sink = 0;
+   const auto start = std::chrono::high_resolution_clock::now();
+   for (uint32_t idx : order) {
+      const T& o = objs[idx];
+      // The dispatch read: who is it, which code, how to run it.
+      sink += o.name ^ o.code_hash[0] ^ o.flags ^ o.vm_type;
+   }
+   const auto end = std::chrono::high_resolution_clock::now();
+
+   const double ns =
+      std::chrono::duration<double, std::nano>(end - start).count() / double(object_count);
+   std::printf("%-12s %8.2f ns/lookup  (checksum %016llx)\n", tag, ns,
+               (unsigned long long)sink);
+   return ns;
+}
+
+int main() {
+   // One shuffled visit order shared by both layouts, so they pay for the
+   // same miss pattern and differ only in lines touched per object.
+   std::vector<uint32_t> order(object_count);
+   for (std::size_t i = 0; i < object_count; ++i)
+      order[i] = uint32_t(i);
+   boost::random::mt19937 gen(42);
+   for (std::size_t i = object_count - 1; i > 0; --i) {
+      boost::random::uniform_int_distribution<std::size_t> dist(0, i);
+      std::swap(order[i], order[dist(gen)]);
+   }
+
+   // First pass warms the allocator and page tables; report the second.
+   run<split_line_meta>("(warm-up)", order);
+   const double split = run<split_line_meta>("split-line", order);
+   const double hot   = run<hot_first_meta>("hot-first", order);
+   std::printf("hot-first costs %.1f%% of the split-line layout per lookup\n",
+               hot / split * 100.0);
+   return 0;
+}
@@ -0,0 +1,99 @@
+// Measures per-transaction squash cost: many child undo sessions each
+// modifying a slice of a populated table, merged into a block-level root
+// session either with squash() (compresses duplicate old values, walking
+// every object modified in the child) or squash_fast() (drops the undo
+// state only, O(1)).
+#include <chainbase/undo_index.hpp>
+#include <chainbase/chainbase.hpp>
+#include <filesystem>
+#include <iostream>
+#include <chrono>
+
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+namespace bip = boost::interprocess;
+namespace fs  = std::filesystem;
+namespace bmi = boost::multi_index;
+
+template<typename T>
+using test_allocator_base = chainbase::chainbase_node_allocator<T, chainbase::segment_manager>;
+
+template<typename T>
+class test_allocator : public test_allocator_base<T> {
+public:
+   using base = test_allocator_base<T>;
+   test_allocator(chainbase::segment_manager *mgr) : base(mgr) {}
+   template<typename U>   test_allocator(const test_allocator<U>& o) : base(o.get_segment_manager()) {}
+   template<typename U>   struct rebind { using other = test_allocator<U>; };
+   typename base::pointer allocate(std::size_t count) {
+      return base::allocate(count);
+   }
+};
+
+struct elem_t {
+   template<typename C, typename A>
+   elem_t(C&& c, A&&) {
+      c(*this);
+   }
+
+   uint64_t id;
+   uint64_t val;
+};
+
+template<typename T>
+struct key_impl;
+template<typename C, typename T>
+struct key_impl<T C::*> { template<auto F> using fn = boost::multi_index::member<C, T, F>; };
+
+template<auto Fn>
+using key = typename key_impl<decltype(Fn)>::template fn<Fn>;
+
+using clock_t = std::chrono::high_resolution_clock;
+
+int main()
+{
+   fs::path temp = fs::temp_directory_path() / "pinnable_mapped_file_squash";
+   try {
+      constexpr size_t num_rows      = 1 * 1024 * 1024;
+      constexpr size_t num_txns      = 4096;
+      constexpr size_t mods_per_txn  = 512;
+
+      chainbase::pinnable_mapped_file db(temp, true, 256 * num_rows, false, chainbase::pinnable_mapped_file::map_mode::mapped);
+      test_allocator<elem_t> alloc(db.get_segment_manager());
+      chainbase::undo_index<elem_t, test_allocator<elem_t>, bmi::ordered_unique<key<&elem_t::id>>> i0(alloc);
+
+      for (size_t i = 0; i < num_rows; ++i) {
+         i0.emplace([](elem_t& e) { e.val = 0; });
+      }
+
+      auto run = [&](const char* label, bool fast) {
+         auto root = i0.start_undo_session(true);
+         auto start = clock_t::now();
+         size_t next = 0;
+         for (size_t t = 0; t < num_txns; ++t) {
+            auto child = i0.start_undo_session(true);
+            for (size_t m = 0; m < mods_per_txn; ++m) {
+               const elem_t* e = i0.find(next++ % num_rows);
+               i0.modify(*e, [](elem_t& e) { ++e.val; });
+            }
+            if (fast)
+               child.squash_fast();
+            else
+               child.squash();
+         }
+         float elapsed = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(clock_t::now() - start).count();
+         printf("%-24s %4zu txns x %4zu mods %10.2fms\n", label, num_txns, mods_per_txn, elapsed);
+         // root session rolls everything back on destruction, so both
+         // runs start from the same table contents.
+      };
+
+      run("squash_and_compress", false);
+      run("squash_fast", true);
+   } catch (...) {
+      fs::remove_all(temp);
+      throw;
+   }
+   fs::remove_all(temp);
+   return 0;
+}
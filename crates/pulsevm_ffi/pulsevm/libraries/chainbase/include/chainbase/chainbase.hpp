@@ -132,7 +132,9 @@ namespace chainbase {
          virtual ~abstract_session(){};
          virtual void push()             = 0;
          virtual void squash()           = 0;
+         virtual void squash_fast()      = 0;
          virtual void undo()             = 0;
+         virtual void revert()           = 0;
    };
 
    template<typename SessionType>
@@ -143,7 +145,9 @@ namespace chainbase {
 
          virtual void push() override  { _session.push();  }
          virtual void squash() override{ _session.squash(); }
+         virtual void squash_fast() override { _session.squash_fast(); }
          virtual void undo() override  { _session.undo();  }
+         virtual void revert() override { _session.revert(); }
       private:
          SessionType _session;
    };
@@ -165,6 +169,8 @@ namespace chainbase {
          virtual uint64_t row_count()const = 0;
          virtual const std::string& type_name()const = 0;
          virtual std::pair<uint64_t, uint64_t> undo_stack_revision_range()const = 0;
+         // (node pool, undo old-value pool) occupancy for this index.
+         virtual std::pair<node_allocator_stats, node_allocator_stats> allocation_stats()const = 0;
 
          virtual void remove_object( int64_t id ) = 0;
 
@@ -192,6 +198,7 @@ namespace chainbase {
          virtual uint64_t row_count()const override { return _base.indices().size(); }
          virtual const std::string& type_name() const override { return BaseIndex_name; }
          virtual std::pair<uint64_t, uint64_t> undo_stack_revision_range()const override { return _base.undo_stack_revision_range(); }
+         virtual std::pair<node_allocator_stats, node_allocator_stats> allocation_stats()const override { return _base.get_allocation_stats(); }
 
          virtual void     remove_object( int64_t id ) override { return _base.remove_object( id ); }
       private:
@@ -282,12 +289,28 @@ namespace chainbase {
                   _index_sessions.clear();
                }
 
+               /// O(1) merge into the enclosing session; see
+               /// undo_index::session::squash_fast for the trade-off.
+               void squash_fast()
+               {
+                  for( auto& i : _index_sessions ) i->squash_fast();
+                  _index_sessions.clear();
+               }
+
                void undo()
                {
                   for( auto& i : _index_sessions ) i->undo();
                   _index_sessions.clear();
                }
 
+               /// Rolls back to the session's base state without ending the
+               /// session: the index sessions stay armed, so the same
+               /// session object can serve another speculative execution.
+               void revert()
+               {
+                  for( auto& i : _index_sessions ) i->revert();
+               }
+
             private:
                friend class database;
                session(){}
@@ -302,6 +325,13 @@ namespace chainbase {
              return _index_list[0]->revision();
          }
 
+         /// True when at least one undo session is live on the indices.
+         bool has_undo_session()const {
+             if( _index_list.size() == 0 ) return false;
+             auto range = _index_list[0]->undo_stack_revision_range();
+             return range.first != range.second;
+         }
+
          void undo();
          void squash();
          void commit( int64_t revision );
@@ -315,8 +345,17 @@ namespace chainbase {
              for( auto i : _index_list ) i->set_revision( revision );
          }
 
+         /// Resolve (find or, on a fresh database, construct) an index's
+         /// shared-memory object and validate its layout. This is the
+         /// expensive half of add_index — it faults in the segment pages the
+         /// index header and undo stack live on — and touches no database
+         /// member state besides reads, so callers may run it for several
+         /// index types concurrently: named find/construct go through the
+         /// segment manager's own mutex, and the read-only path is a pure
+         /// lock-free lookup. Registration of the result must still happen
+         /// serially via register_prepared_index().
          template<typename MultiIndexType>
-         void add_index() {
+         generic_index<MultiIndexType>* prepare_index( bool& first_time_adding ) {
             const uint16_t type_id = generic_index<MultiIndexType>::value_type::type_id;
             typedef generic_index<MultiIndexType>          index_type;
             typedef typename index_type::allocator_type    index_alloc;
@@ -332,7 +371,7 @@ namespace chainbase {
                idx_ptr = _db_file.get_segment_manager()->find_no_lock< index_type >( type_name.c_str() ).first;
             else
                idx_ptr = _db_file.get_segment_manager()->find< index_type >( type_name.c_str() ).first;
-            bool first_time_adding = false;
+            first_time_adding = false;
             if( !idx_ptr ) {
                if( _read_only ) {
                   BOOST_THROW_EXCEPTION( std::runtime_error( "unable to find index for " + type_name + " in read only database" ) );
@@ -342,6 +381,19 @@ namespace chainbase {
              }
 
             idx_ptr->validate();
+            return idx_ptr;
+         }
+
+         /// Serial half of add_index: undo-stack consistency against the
+         /// indices registered so far, then insertion into the index map and
+         /// list. Must be called in the same order for every process that
+         /// opens the database, one thread at a time.
+         template<typename MultiIndexType>
+         void register_prepared_index( generic_index<MultiIndexType>* idx_ptr, bool first_time_adding ) {
+            const uint16_t type_id = generic_index<MultiIndexType>::value_type::type_id;
+            typedef generic_index<MultiIndexType>          index_type;
+
+            std::string type_name = boost::core::demangle( typeid( typename index_type::value_type ).name() );
 
             // Ensure the undo stack of added index is consistent with the other indices in the database
             if( _index_list.size() > 0 ) {
@@ -383,6 +435,29 @@ namespace chainbase {
             _index_list.push_back( new_index );
          }
 
+         template<typename MultiIndexType>
+         void add_index() {
+            bool first_time_adding = false;
+            auto idx_ptr = prepare_index<MultiIndexType>( first_time_adding );
+            register_prepared_index<MultiIndexType>( idx_ptr, first_time_adding );
+         }
+
+         /// Grow the shared-memory file to new_shared_file_size bytes while
+         /// the process keeps running. The remap moves the segment's base
+         /// address, so every index registration — which holds references
+         /// into the segment — is dropped here; the caller must re-add all
+         /// indices, in the original order, before touching the database
+         /// again, and must not hold undo sessions or object references
+         /// across the call.
+         void grow( uint64_t new_shared_file_size ) {
+            if ( _read_only_mode ) {
+               BOOST_THROW_EXCEPTION( std::logic_error( "attempting to grow database in read-only mode" ) );
+            }
+            _index_list.clear();
+            _index_map.clear();
+            _db_file.grow( new_shared_file_size );
+         }
+
          segment_manager* get_segment_manager() {
             return _db_file.get_segment_manager();
          }
@@ -396,6 +471,42 @@ namespace chainbase {
             return _db_file.get_segment_manager()->get_free_memory();
          }
 
+         /// Pool occupancy for one registered index: the node pool backing
+         /// live rows and the pool backing undo old-value copies.
+         struct index_allocation_stats {
+            std::string          type_name;
+            uint64_t             row_count = 0;
+            node_allocator_stats nodes;
+            node_allocator_stats old_values;
+         };
+
+         /// Wall time one index spent in its share of the most recent
+         /// commit(); see get_last_commit_stats().
+         struct index_commit_stats {
+            std::string type_name;
+            uint64_t    elapsed_ns = 0;
+         };
+
+         /// Per-index timing of the most recent commit(), in registration
+         /// order. Empty until the first commit. Read it from the committing
+         /// thread only — the vector is rewritten by every commit.
+         const vector<index_commit_stats>& get_last_commit_stats()const {
+            return _commit_stats;
+         }
+
+         /// Snapshot of every index's allocator pools, in registration
+         /// order. Lets operators see where shared memory actually goes and
+         /// how much is parked on free lists versus live rows.
+         vector<index_allocation_stats> get_allocation_stats()const {
+            vector<index_allocation_stats> result;
+            result.reserve( _index_list.size() );
+            for( auto i : _index_list ) {
+               auto [nodes, old_values] = i->allocation_stats();
+               result.push_back( { i->type_name(), i->row_count(), nodes, old_values } );
+            }
+            return result;
+         }
+
          template<typename MultiIndexType>
          const generic_index<MultiIndexType>& get_index()const
          {
@@ -500,6 +611,19 @@ namespace chainbase {
              return get_mutable_index<index_type>().emplace( std::forward<Constructor>(con) );
          }
 
+         // Bulk-load variant of create: the new object must sort after every
+         // existing object in each ordered index. See undo_index::emplace_back
+         // for the precondition and the cost model.
+         template<typename ObjectType, typename Constructor>
+         const ObjectType& create_back( Constructor&& con )
+         {
+             if ( _read_only_mode ) {
+                BOOST_THROW_EXCEPTION( std::logic_error( "attempting to create a record in read-only mode" ) );
+             }
+             typedef typename get_index_type<ObjectType>::type index_type;
+             return get_mutable_index<index_type>().emplace_back( std::forward<Constructor>(con) );
+         }
+
          database_index_row_count_multiset row_count_per_index()const {
             database_index_row_count_multiset ret;
             for(const auto& ai_ptr : _index_map) {
@@ -524,6 +648,18 @@ namespace chainbase {
             return _db_file.check_memory_and_flush_if_needed();
          }
 
+         size_t flush_dirty_pages(size_t max_pages) {
+            return _db_file.flush_dirty_pages(max_pages);
+         }
+
+         size_t save_hot_pages(const std::filesystem::path& profile) const {
+            return _db_file.save_hot_pages(profile);
+         }
+
+         size_t prefault_hot_pages(const std::filesystem::path& profile) const {
+            return _db_file.prefault_hot_pages(profile);
+         }
+
       private:
          pinnable_mapped_file                                        _db_file;
          bool                                                        _read_only = false;
@@ -547,6 +683,13 @@ namespace chainbase {
           * This is a full map (size 2^16) of all possible index designed for constant time lookup
           */
          vector<unique_ptr<abstract_index>>                          _index_map;
+
+         /**
+          * Per-index wall time of the most recent commit(), in registration
+          * order. Process-heap state, not shared memory; rewritten by every
+          * commit.
+          */
+         vector<index_commit_stats>                                  _commit_stats;
    };
 
    template<typename Object, typename... Args>
@@ -9,11 +9,35 @@ namespace chainbase {
 
    namespace bip = boost::interprocess;
 
+   // Live occupancy of one node pool: how many fixed-size nodes are handed
+   // out, how many sit on the free list, and how much segment memory the
+   // pool's slabs have claimed. Per index these numbers are the allocation
+   // histogram of the object mix — node size times in_use is the live
+   // footprint, slab_bytes minus that and the free list is what slab
+   // granularity currently wastes.
+   struct node_allocator_stats {
+      std::size_t node_size  = 0; // bytes per node, intrusive hooks included
+      std::size_t in_use     = 0; // nodes allocated and not yet returned
+      std::size_t free_count = 0; // nodes parked on the free list
+      std::size_t slab_count = 0; // segment extents backing the pool
+      std::size_t slab_bytes = 0; // total bytes reserved in those extents
+   };
+
    template<typename T, typename S>
    class chainbase_node_allocator {
     public:
       using value_type = T;
       using pointer = bip::offset_ptr<T>;
+
+      // First slab is small so sparsely populated indices stay cheap; each
+      // refill doubles up to the cap, so heavily populated pools (millions
+      // of key_value nodes) are backed by a handful of large extents
+      // instead of thousands of interleaved 64-node slabs. Fewer, larger
+      // extents are exactly what keeps the segment's free space coalescible
+      // when pools from different indices grow at the same time.
+      static constexpr std::size_t initial_slab_nodes = 64;
+      static constexpr std::size_t max_slab_nodes     = 8192;
+
       chainbase_node_allocator(segment_manager* manager) : _manager{manager} {}
       chainbase_node_allocator(const chainbase_node_allocator& other) : _manager(other._manager) {}
       template<typename U>
@@ -26,6 +50,8 @@ namespace chainbase {
             list_item* result = &*_freelist;
             _freelist = _freelist->_next;
             result->~list_item();
+            --_free_count;
+            ++_in_use;
             return pointer{(T*)result};
          } else {
             return pointer{(T*)_manager->allocate(num*sizeof(T))};
@@ -34,10 +60,15 @@ namespace chainbase {
       void deallocate(const pointer& p, std::size_t num) {
          if (num == 1) {
             _freelist = new (&*p) list_item{_freelist};
+            ++_free_count;
+            --_in_use;
          } else {
             _manager->deallocate(&*p);
          }
       }
+      node_allocator_stats get_stats() const {
+         return { sizeof(T), _in_use, _free_count, _slab_count, _slab_bytes };
+      }
       bool operator==(const chainbase_node_allocator& other) const { return this == &other; }
       bool operator!=(const chainbase_node_allocator& other) const { return this != &other; }
       segment_manager* get_segment_manager() const { return _manager.get(); }
@@ -47,9 +78,15 @@ namespace chainbase {
       void get_some() {
          static_assert(sizeof(T) >= sizeof(list_item), "Too small for free list");
          static_assert(sizeof(T) % alignof(list_item) == 0, "Bad alignment for free list");
-         char* result = (char*)_manager->allocate(sizeof(T) * 64);
+         const std::size_t nodes = _next_slab_nodes;
+         char* result = (char*)_manager->allocate(sizeof(T) * nodes);
+         _slab_count += 1;
+         _slab_bytes += sizeof(T) * nodes;
+         _free_count += nodes;
+         if (_next_slab_nodes < max_slab_nodes)
+            _next_slab_nodes *= 2;
          _freelist = bip::offset_ptr<list_item>{(list_item*)result};
-         for(int i = 0; i < 63; ++i) {
+         for(std::size_t i = 0; i < nodes - 1; ++i) {
             char* next = result + sizeof(T);
             new(result) list_item{bip::offset_ptr<list_item>{(list_item*)next}};
             result = next;
@@ -59,6 +96,11 @@ namespace chainbase {
       struct list_item { bip::offset_ptr<list_item> _next; };
       bip::offset_ptr<segment_manager> _manager;
       bip::offset_ptr<list_item> _freelist{};
+      std::size_t _next_slab_nodes = initial_slab_nodes;
+      std::size_t _in_use = 0;
+      std::size_t _free_count = 0;
+      std::size_t _slab_count = 0;
+      std::size_t _slab_bytes = 0;
    };
 
 }  // namepsace chainbase
@@ -66,6 +66,46 @@ class pinnable_mapped_file {
       segment_manager* get_segment_manager() const { return _segment_manager;}
       size_t           check_memory_and_flush_if_needed();
 
+      // Grows the database file to `new_database_size` bytes and extends the
+      // segment manager's free memory accordingly, without restarting the
+      // process. Only supported in `mapped` mode for writable instances:
+      // there all dirtied pages live in the MAP_SHARED page cache, so the
+      // mapping can be dropped and recreated over the enlarged file without
+      // losing anything. The remap almost certainly lands at a different
+      // address, so every raw pointer and reference into the segment held
+      // outside shared memory is invalid afterwards — callers must drop all
+      // index registrations, undo sessions and cached object references
+      // before the call and re-resolve them after it.
+      void             grow(size_t new_database_size);
+
+      // Writes back at most `max_pages` worth of the mapping to the database
+      // file, advancing an internal cursor so repeated calls sweep the whole
+      // mapping. Lets a caller smooth writeback into small rate-limited
+      // batches instead of leaving gigabytes for the kernel (or the
+      // destructor) to flush at once. Returns the number of pages covered.
+      size_t           flush_dirty_pages(size_t max_pages);
+
+      // Records which pages of the file-backed mapping are currently
+      // resident (per mincore) as a bitmap in `profile`, so the next start
+      // can fault the same working set back in ahead of use. Returns the
+      // number of resident pages recorded; 0 for non-file-backed mappings,
+      // where residency is meaningless.
+      size_t           save_hot_pages(const std::filesystem::path& profile) const;
+
+      // Reads a bitmap written by save_hot_pages and asks the kernel to
+      // read the marked pages ahead (MADV_WILLNEED over coalesced runs).
+      // A missing, stale or truncated profile is not an error — whatever
+      // prefix still matches the mapping is used and the rest ignored.
+      // Returns the number of pages covered by the advice.
+      size_t           prefault_hot_pages(const std::filesystem::path& profile) const;
+
+      // When enabled, mappings created by subsequently constructed instances are
+      // interleaved across all NUMA nodes the process is allowed to allocate from,
+      // so a database larger than one node's memory does not pile up on a single
+      // node. Only affects anonymous and copy-on-write pages; MAP_SHARED file
+      // pages are placed by the page cache and ignore the policy.
+      static void set_numa_interleave(bool interleave) { _numa_interleave = interleave; }
+
       template<typename T>
       static std::optional<allocator<T>> get_allocator(void *object) {
          if (!_segment_manager_map.empty()) {
@@ -90,6 +130,8 @@ class pinnable_mapped_file {
       static bool                                   all_zeros(const std::byte* data, size_t sz);
       void                                          setup_non_file_mapping();
       void                                          setup_copy_on_write_mapping();
+      static void                                   advise_transparent_hugepages(void* addr, size_t size);
+      void                                          interleave_across_numa_nodes(void* addr, size_t size) const;
       std::pair<std::byte*, size_t>                 get_region_to_save() const;
 
       bip::file_lock                                _mapped_file_lock;
@@ -101,6 +143,7 @@ class pinnable_mapped_file {
 
       bip::file_mapping                             _file_mapping;
       bip::mapped_region                            _file_mapped_region;
+      size_t                                        _flush_cursor = 0;
       void*                                         _non_file_mapped_mapping = nullptr;
       size_t                                        _non_file_mapped_mapping_size = 0;
 
@@ -113,6 +156,7 @@ class pinnable_mapped_file {
       segment_manager*                              _segment_manager = nullptr;
 
       static std::vector<pinnable_mapped_file*>     _instance_tracker;
+      static bool                                   _numa_interleave;
 
       using segment_manager_map_t = boost::container::flat_map<void*, void *>;
       static segment_manager_map_t                  _segment_manager_map;
@@ -18,6 +18,23 @@ namespace chainbase {
 
    namespace bip = boost::interprocess;
 
+   // Copy-on-write string with an inline small-buffer. Values at or below
+   // sbo_capacity bytes live directly inside the object — and therefore
+   // inside the undo_index node that owns it — instead of behind a
+   // refcounted segment allocation. For contract row payloads (the median
+   // row is well under the buffer size) a read stays within the node's own
+   // cache lines and a store skips the shared-segment allocator entirely;
+   // copies of small values degrade from refcount sharing to a memcpy,
+   // which at this size is cheaper than the pointer chase it replaces.
+   // Values above the threshold keep the original refcounted
+   // copy-on-write representation.
+   //
+   // Representation: `_data` null means the value is the first
+   // `_inline_size` bytes of `_inline_data`; `_data` set means heap
+   // storage as before (and `_inline_size` is zero). Note this changes
+   // sizeof(shared_cow_string), so database files created before the
+   // inline buffer are rejected by undo_index validation and need a
+   // replay or snapshot restore.
    class shared_cow_string {
       struct impl {
          uint32_t reference_count;
@@ -30,6 +47,8 @@ namespace chainbase {
       using iterator       = const char*;
       using const_iterator = const char*;
 
+      static constexpr std::size_t sbo_capacity = 64;
+
       shared_cow_string() = default;
 
       template<typename Iter>
@@ -57,23 +76,27 @@ namespace chainbase {
       }
 
       shared_cow_string(const shared_cow_string& o) {
-         if (get_allocator(this) == o.get_allocator()) {
+         if (o._data == nullptr) {
+            std::memcpy(_inline_data, o._inline_data, o._inline_size);
+            _inline_size = o._inline_size;
+         } else if (get_allocator(this) == o.get_allocator()) {
             _data = o._data;
-            if (_data != nullptr)
-               ++_data->reference_count;
+            ++_data->reference_count;
          } else {
-            if (o._data)
-               new (this) shared_cow_string(o.data(), o.size());
+            new (this) shared_cow_string(o.data(), o.size());
          }
       }
 
       shared_cow_string(shared_cow_string&& o) noexcept {
-         if (get_allocator() == o.get_allocator()) {
+         if (o._data == nullptr) {
+            std::memcpy(_inline_data, o._inline_data, o._inline_size);
+            _inline_size = o._inline_size;
+            o._inline_size = 0;
+         } else if (get_allocator() == o.get_allocator()) {
             _data = o._data;
             o._data = nullptr;
          } else {
-            if (o._data)
-               new (this) shared_cow_string(o.data(), o.size());
+            new (this) shared_cow_string(o.data(), o.size());
          }
       }
 
@@ -84,10 +107,16 @@ namespace chainbase {
 
       shared_cow_string& operator=(const shared_cow_string& o) {
          if (this != &o) {
-            if (get_allocator() == o.get_allocator()) {
+            if (o._data == nullptr) {
+               dec_refcount();
+               _data = nullptr;
+               std::memcpy(_inline_data, o._inline_data, o._inline_size);
+               _inline_size = o._inline_size;
+            } else if (get_allocator() == o.get_allocator()) {
                dec_refcount();
                _data = o._data;
-               if (_data != nullptr) 
+               _inline_size = 0;
+               if (_data != nullptr)
                   ++_data->reference_count;
             } else {
                assign(o.data(), o.size());
@@ -98,9 +127,16 @@ namespace chainbase {
 
       shared_cow_string& operator=(shared_cow_string&& o)  noexcept {
          if (this != &o) {
-            if (get_allocator() == o.get_allocator()) {
+            if (o._data == nullptr) {
+               dec_refcount();
+               _data = nullptr;
+               std::memcpy(_inline_data, o._inline_data, o._inline_size);
+               _inline_size = o._inline_size;
+               o._inline_size = 0;
+            } else if (get_allocator() == o.get_allocator()) {
                dec_refcount();
                _data = o._data;
+               _inline_size = 0;
                o._data = nullptr;
             } else {
                assign(o.data(), o.size());
@@ -121,7 +157,7 @@ namespace chainbase {
          if (!copy_in_place(nullptr, new_size)) {
             _alloc(nullptr, new_size);
          }
-         static_cast<F&&>(f)(_data->data, new_size);
+         static_cast<F&&>(f)(mutable_data(), new_size);
       }
 
       void assign(const char* ptr, std::size_t size) {
@@ -135,22 +171,20 @@ namespace chainbase {
       }
 
       const char* data() const {
-         return _data ? _data->data : nullptr;
+         return _data ? _data->data : _inline_data;
       }
 
       char* mutable_data() {
          assert (!_data || _data->reference_count == 1);
-         return _data ? _data->data : nullptr;
+         return _data ? _data->data : _inline_data;
       }
 
       std::size_t size() const {
-         return _data ? _data->size : 0;
+         return _data ? _data->size : _inline_size;
       }
 
       const_iterator begin() const { return data(); }
-      const_iterator end() const {
-         return _data ? _data->data + _data->size : nullptr;
-      }
+      const_iterator end() const   { return data() + size(); }
 
       int compare(std::size_t start, std::size_t count, const char* other, std::size_t other_size) const {
          std::size_t sz = size();
@@ -206,7 +240,7 @@ namespace chainbase {
             std::forward<Alloc>(alloc).deallocate((char*)&*_data, sizeof(impl) + _data->size + 1);
          }
       }
-      
+
       void dec_refcount() {
          auto alloc = get_allocator(this);
          if (alloc)
@@ -216,6 +250,13 @@ namespace chainbase {
       }
 
       bool copy_in_place(const char* ptr, std::size_t size) {
+         if (_data == nullptr && size <= sbo_capacity) {
+            // inline values stay inline, whatever the new size
+            if (ptr)
+               std::memmove(_inline_data, ptr, size);
+            _inline_size = static_cast<uint8_t>(size);
+            return true;
+         }
          if (_data && _data->reference_count == 1 && _data->size == size) {
             // we hold the only reference and size matches, not need to dealloc/realloc
             if (ptr)
@@ -227,17 +268,28 @@ namespace chainbase {
 
       template<class Alloc>
       void _alloc(Alloc&& alloc, const char* ptr, std::size_t size) {
-         impl* new_data = nullptr;
-         if (size > 0) {
-            new_data = (impl*)&*std::forward<Alloc>(alloc).allocate(sizeof(impl) + size + 1);
-            new_data->reference_count = 1;
-            new_data->size = size;
-            if (ptr)
-               std::memcpy(new_data->data, ptr, size);
-            new_data->data[size] = '\0';
+         if (size <= sbo_capacity) {
+            // `ptr` may point into our current heap block, so copy before
+            // the refcount drop can free it.
+            char tmp[sbo_capacity];
+            if (ptr && size)
+               std::memcpy(tmp, ptr, size);
+            dec_refcount(std::forward<Alloc>(alloc));
+            _data = nullptr;
+            if (ptr && size)
+               std::memcpy(_inline_data, tmp, size);
+            _inline_size = static_cast<uint8_t>(size);
+            return;
          }
-         dec_refcount(std::forward<Alloc>(alloc));
+         impl* new_data = (impl*)&*std::forward<Alloc>(alloc).allocate(sizeof(impl) + size + 1);
+         new_data->reference_count = 1;
+         new_data->size = size;
+         if (ptr)
+            std::memcpy(new_data->data, ptr, size);
+         new_data->data[size] = '\0';
+         dec_refcount(std::forward<Alloc>(alloc)); // has to be after copy above
          _data = new_data;
+         _inline_size = 0;
       }
 
       void _alloc(const char* ptr, std::size_t size) {
@@ -249,6 +301,8 @@ namespace chainbase {
       }
 
       bip::offset_ptr<impl> _data { nullptr };
+      char                  _inline_data[sbo_capacity];
+      uint8_t               _inline_size = 0;
    };
 
 }  // namespace chainbase
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chainbase/scope_exit.hpp>
+#include <chainbase/chainbase_node_allocator.hpp>
 #include <boost/multi_index_container_fwd.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/intrusive/avltree.hpp>
@@ -253,7 +254,7 @@ namespace chainbase {
       static_assert((... && is_valid_index<Indices>), "Only ordered_unique indices are supported");
 
       undo_index() = default;
-      explicit undo_index(const Allocator& a) : _undo_stack{a}, _allocator{a}, _old_values_allocator{a} {}
+      explicit undo_index(const Allocator& a) : _undo_stack{a}, _allocator{a}, _old_values_allocator{a}, _flat_old_values{a} {}
       ~undo_index() {
          dispose_undo();
          clear_impl<1>();
@@ -264,6 +265,24 @@ namespace chainbase {
          if( sizeof(node) != _size_of_value_type || sizeof(*this) != _size_of_this )
             BOOST_THROW_EXCEPTION( std::runtime_error("content of memory does not match data expected by executable") );
       }
+
+      // Occupancy of the two pools this index allocates from: live nodes
+      // and old values retained for the undo stack.
+      std::pair<node_allocator_stats, node_allocator_stats> get_allocation_stats()const {
+         if constexpr (use_flat_undo) {
+            // The flat journal bypasses the old-values pool; report its
+            // occupancy in the same shape, with dead-but-unreclaimed
+            // records counted as free.
+            node_allocator_stats old_stats;
+            old_stats.node_size  = sizeof(old_node);
+            old_stats.in_use     = _flat_old_live;
+            old_stats.free_count = _flat_old_values.size() - _flat_old_live;
+            old_stats.slab_bytes = _flat_old_values.size() * sizeof(old_node);
+            return { _allocator.get_stats(), old_stats };
+         } else {
+            return { _allocator.get_stats(), _old_values_allocator.get_stats() };
+         }
+      }
     
       struct node : hook<Indices, Allocator>..., value_holder<T> {
          using value_type = T;
@@ -296,6 +315,14 @@ namespace chainbase {
       using pointer = value_type*;
       using const_iterator = typename index0_set_type::const_iterator;
 
+      // Objects at or below this size whose type is trivially copyable take
+      // the flat-journal undo path below; resource_usage rows and sequence
+      // counters (a handful of integers, modified by nearly every
+      // transaction) are the intended beneficiaries.
+      static constexpr std::size_t flat_undo_max_bytes = 128;
+      static constexpr bool use_flat_undo =
+         std::is_trivially_copyable_v<T> && sizeof(T) <= flat_undo_max_bytes;
+
       // The undo stack is implemented as a deque of undo_states
       // that index into a pair of singly linked lists.
       //
@@ -370,6 +397,35 @@ namespace chainbase {
          return p->_item;
       }
 
+      // Bulk-load fast path for sorted imports: the caller guarantees the
+      // new object sorts strictly after every existing object in every
+      // ordered index. The by-id index appends as always; each ordered index
+      // takes an end-hinted insertion, so the per-row O(log n) descent per
+      // index becomes an amortized O(1) append. The precondition is verified
+      // against each index's last element, so a mis-sorted call fails like a
+      // uniqueness violation instead of corrupting a tree.
+      // Exception safety: strong
+      template<typename Constructor>
+      const value_type& emplace_back( Constructor&& c ) {
+         auto p = alloc_traits::allocate(_allocator, 1);
+         auto guard0 = scope_exit{[&]{ alloc_traits::deallocate(_allocator, p, 1); }};
+         auto new_id = _next_id;
+         auto constructor = [&]( value_type& v ) {
+            v.id = new_id;
+            c( v );
+         };
+         alloc_traits::construct(_allocator, &*p, constructor, constructor_tag());
+         auto guard1 = scope_exit{[&]{ alloc_traits::destroy(_allocator, &*p); }};
+         if(!insert_back_impl<1>(p->_item))
+            BOOST_THROW_EXCEPTION( std::logic_error{ "could not bulk-insert object, input is not sorted after the existing rows" } );
+         std::get<0>(_indices).push_back(p->_item); // cannot fail and we know that it will definitely insert at the end.
+         on_create(p->_item);
+         ++_next_id;
+         guard1.cancel();
+         guard0.cancel();
+         return p->_item;
+      }
+
       // Exception safety: basic.
       // If the modifier leaves the object in a state that conflicts
       // with another object, it will either be reverted or erased.
@@ -469,10 +525,26 @@ namespace chainbase {
             if ( _apply ) _index.squash();
             _apply = false;
          }
+         // Merge into the parent session by dropping this session's undo
+         // state only — the old/removed node lists are left as they are, so
+         // this is O(1) instead of O(objects modified in this session).
+         // Duplicate old values the compress pass would have folded stay on
+         // the list; undo() skips them by mtime and last_undo_session()
+         // compresses lazily, so they cost memory until the parent commits,
+         // never correctness.
+         void squash_fast() {
+            if ( _apply ) _index.squash_fast();
+            _apply = false;
+         }
          void undo() {
             if ( _apply ) _index.undo();
             _apply = false;
          }
+         // Rolls the index back to this session's base state but leaves the
+         // session armed for reuse; see undo_index::revert.
+         void revert() {
+            if ( _apply ) _index.revert();
+         }
        private:
          undo_index& _index;
          bool _apply = true;
@@ -573,6 +645,62 @@ namespace chainbase {
       // Resets the contents to the state at the top of the undo stack.
       void undo() noexcept {
          if (_undo_stack.empty()) return;
+         rollback_top();
+         _undo_stack.pop_back();
+         --_revision;
+      }
+
+      // Rolls the contents back to the state at the top of the undo stack
+      // like undo(), but keeps the session armed: the back undo_state is
+      // re-initialized in place instead of popped, so one session can be
+      // reused across many speculative executions without the undo-stack
+      // churn of tearing it down and starting another.
+      void revert() noexcept {
+         if (_undo_stack.empty()) return;
+         rollback_top();
+         // Re-arm the back state exactly as add_session() would initialize a
+         // fresh one; the rollback removed everything this session had
+         // contributed to the old/removed lists, so the ends point at the
+         // enclosing session's entries (or null) again.
+         undo_state& undo_info = _undo_stack.back();
+         undo_info.old_values_end = _old_values.empty()?nullptr:&*_old_values.begin();
+         undo_info.removed_values_end = _removed_values.empty()?nullptr:&*_removed_values.begin();
+         undo_info.old_next_id = _next_id;
+         undo_info.ctime = ++_monotonic_revision;
+      }
+
+      // Combines the top two states on the undo stack
+      void squash() noexcept {
+         squash_and_compress();
+      }
+
+      void squash_fast() noexcept {
+         if (_undo_stack.empty()) {
+            return;
+         } else if (_undo_stack.size() == 1) {
+            dispose_undo();
+         }
+         _undo_stack.pop_back();
+         --_revision;
+      }
+
+      void squash_and_compress() noexcept {
+         if(_undo_stack.size() >= 2) {
+            compress_impl(_undo_stack[_undo_stack.size() - 2]);
+         }
+         squash_fast();
+      }
+
+      void compress_last_undo_session() noexcept {
+         compress_impl(_undo_stack.back());
+      }
+
+    private:
+
+      // Shared rollback of undo() and revert(): reverses every change
+      // recorded in the back undo_state, leaving the stack entry itself for
+      // the caller to pop or re-arm.
+      void rollback_top() noexcept {
          undo_state& undo_info = _undo_stack.back();
          // erase all new_ids
          auto& by_id = std::get<0>(_indices);
@@ -611,38 +739,8 @@ namespace chainbase {
             }
          });
          _next_id = undo_info.old_next_id;
-         _undo_stack.pop_back();
-         --_revision;
-      }
-
-      // Combines the top two states on the undo stack
-      void squash() noexcept {
-         squash_and_compress();
-      }
-
-      void squash_fast() noexcept {
-         if (_undo_stack.empty()) {
-            return;
-         } else if (_undo_stack.size() == 1) {
-            dispose_undo();
-         }
-         _undo_stack.pop_back();
-         --_revision;
       }
 
-      void squash_and_compress() noexcept {
-         if(_undo_stack.size() >= 2) {
-            compress_impl(_undo_stack[_undo_stack.size() - 2]);
-         }
-         squash_fast();
-      }
-
-      void compress_last_undo_session() noexcept {
-         compress_impl(_undo_stack.back());
-      }
-
-    private:
-
       // Removes elements of the last undo session that would be redundant
       // if all the sessions after @c session were squashed.
       //
@@ -697,6 +795,26 @@ namespace chainbase {
          return true;
       }
 
+      // End-hinted counterpart of insert_impl for emplace_back: rejects any
+      // row that does not sort strictly after the index's current last
+      // element, then inserts with an end hint.
+      template<int N = 1>
+      bool insert_back_impl(value_type& p) {
+         if constexpr (N < sizeof...(Indices)) {
+            auto& idx = std::get<N>(_indices);
+            if(!idx.empty() && !idx.value_comp()(*std::prev(idx.end()), p))
+               return false;
+            auto iter = idx.insert_unique(idx.end(), p);
+            auto guard = scope_exit{[&idx,iter=iter]{ idx.erase(iter); }};
+            if(insert_back_impl<N+1>(p)) {
+               guard.cancel();
+               return true;
+            }
+            return false;
+         }
+         return true;
+      }
+
       // Moves a modified node into the correct location
       template<bool unique, int N = 0>
       bool post_modify(value_type& p) {
@@ -752,6 +870,19 @@ namespace chainbase {
             auto& undo_info = _undo_stack.back();
             if ( to_node(obj)._mtime >= undo_info.ctime ) {
                // Nothing to do
+            } else if constexpr (use_flat_undo) {
+               // Small trivially-copyable objects record their old value
+               // inline in the flat journal instead of an allocated node;
+               // the record still links into _old_values, so every
+               // consumer of the list is unaffected.
+               _flat_old_values.emplace_back(obj);
+               old_node& rec = _flat_old_values.back();
+               rec._mtime = to_node(obj)._mtime;
+               rec._current = &to_node(obj);
+               ++_flat_old_live;
+               _old_values.push_front(rec._item);
+               to_node(obj)._mtime = _monotonic_revision;
+               return &rec._item;
             } else {
                // Not in removed_values
                auto p = old_alloc_traits::allocate(_old_values_allocator, 1);
@@ -783,9 +914,26 @@ namespace chainbase {
          dispose_node(static_cast<node&>(*boost::intrusive::get_parent_from_member(&node_ref, &value_holder<value_type>::_item)));
       }
       void dispose_old(old_node& node_ref) noexcept {
-         old_node* p{&node_ref};
-         old_alloc_traits::destroy(_old_values_allocator, p);
-         old_alloc_traits::deallocate(_old_values_allocator, p, 1);
+         if constexpr (use_flat_undo) {
+            // The payload is trivially destructible; mark the record dead
+            // and reclaim the contiguous dead run at the journal's front.
+            // commit() disposes oldest records first, so the front run is
+            // the common case and the journal behaves as a ring; holes a
+            // compress pass leaves mid-journal are recovered once the
+            // front reaches them.
+            node_ref._current = nullptr;
+            if (--_flat_old_live == 0) {
+               _flat_old_values.clear();
+            } else {
+               while (!_flat_old_values.empty() && _flat_old_values.front()._current == nullptr) {
+                  _flat_old_values.pop_front();
+               }
+            }
+         } else {
+            old_node* p{&node_ref};
+            old_alloc_traits::destroy(_old_values_allocator, p);
+            old_alloc_traits::deallocate(_old_values_allocator, p, 1);
+         }
       }
       void dispose_old(value_type& node_ref) noexcept {
          dispose_old(static_cast<old_node&>(*boost::intrusive::get_parent_from_member(&node_ref, &value_holder<value_type>::_item)));
@@ -857,12 +1005,25 @@ namespace chainbase {
          static_cast<hook<index0_type, Allocator>&>(to_node(obj))._color = val;
       }
       using old_alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<old_node>;
+      // Flat journal backing the old_nodes of small trivially-copyable
+      // value types: records live inline in a deque (stable addresses, so
+      // they link into _old_values like any other old_node) instead of
+      // going through the node pool one allocation per modify. For types
+      // on the generic path the member collapses to an empty placeholder.
+      using flat_old_values_type = boost::container::deque<old_node, rebind_alloc_t<Allocator, old_node>>;
+      struct no_flat_old_values {
+         no_flat_old_values() = default;
+         template<typename A>
+         explicit no_flat_old_values(const A&) {}
+      };
       indices_type _indices;
       boost::container::deque<undo_state, rebind_alloc_t<Allocator, undo_state>> _undo_stack;
       list_base<old_node, index0_type> _old_values;
       list_base<node, index0_type> _removed_values;
       rebind_alloc_t<Allocator, node> _allocator;
       rebind_alloc_t<Allocator, old_node> _old_values_allocator;
+      std::conditional_t<use_flat_undo, flat_old_values_type, no_flat_old_values> _flat_old_values;
+      std::size_t _flat_old_live = 0;
       id_type _next_id = 0;
       uint64_t _revision = 0;
       uint64_t _monotonic_revision = 0;
@@ -1,7 +1,11 @@
 #include <chainbase/chainbase.hpp>
 #include <boost/array.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #ifndef _WIN32
 #include <sys/mman.h>
@@ -43,14 +47,64 @@ namespace chainbase {
       }
    }
 
+   // Commit cost concentrates in the handful of large indices; a few
+   // workers capture nearly all of the available overlap and anything more
+   // just contends on the segment mutex.
+   static constexpr std::size_t max_commit_threads = 4;
+
    void database::commit( int64_t revision )
    {
       if ( _read_only_mode )
          BOOST_THROW_EXCEPTION( std::logic_error( "attempting to commit in read-only mode" ) );
-      for( auto& item : _index_list )
-      {
-         item->commit( revision );
+
+      // Per-index commits are independent: each one only drops its own
+      // undo state — its intrusive old/removed-value lists, its undo deque
+      // and its node-allocator free lists, none of which are shared across
+      // indices. The single shared structure is the segment manager, which
+      // serializes the occasional bulk deallocation under its own mutex.
+      // Shared-COW value buffers are only ever referenced from within one
+      // index, so their non-atomic refcounts stay on that index's thread.
+      // undo_index::commit is noexcept, so no error crosses a thread.
+      const std::size_t index_count = _index_list.size();
+      _commit_stats.assign( index_count, {} );
+
+      auto commit_one = [&]( std::size_t i ) {
+         const auto start = std::chrono::steady_clock::now();
+         _index_list[i]->commit( revision );
+         const auto elapsed = std::chrono::steady_clock::now() - start;
+         _commit_stats[i].type_name  = _index_list[i]->type_name();
+         _commit_stats[i].elapsed_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count();
+      };
+
+      const unsigned hw = std::thread::hardware_concurrency();
+      const std::size_t workers =
+         std::min( { index_count, std::size_t( hw ? hw : 1 ), max_commit_threads } );
+      if( workers <= 1 ) {
+         for( std::size_t i = 0; i < index_count; ++i )
+            commit_one( i );
+         return;
       }
+
+      // Indices are claimed off a shared counter rather than pre-sliced, so
+      // one heavyweight index (key_value, typically) does not leave its
+      // slice-mates idle behind it.
+      std::atomic<std::size_t> next{0};
+      auto drain = [&]() {
+         for(;;) {
+            const std::size_t i = next.fetch_add( 1, std::memory_order_relaxed );
+            if( i >= index_count )
+               break;
+            commit_one( i );
+         }
+      };
+      std::vector<std::thread> threads;
+      threads.reserve( workers - 1 );
+      for( std::size_t t = 1; t < workers; ++t )
+         threads.emplace_back( drain );
+      drain();
+      for( auto& t : threads )
+         t.join();
    }
 
    void database::undo_all()
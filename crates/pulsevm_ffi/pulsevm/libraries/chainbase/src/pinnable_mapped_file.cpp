@@ -5,13 +5,17 @@
 #include <boost/asio/signal_set.hpp>
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
 //#include <unistd.h>
 
 #ifdef __linux__
+#include <sys/mman.h>
 #include <linux/mman.h>
+#include <linux/mempolicy.h>
 #include <sys/vfs.h>
 #include <linux/magic.h>
 #include <sys/sysinfo.h>
+#include <sys/syscall.h>
 #endif
 
 // use mlock2() on Linux to avoid a noop intercept of mlock() when ASAN is enabled (still present in compiler-rt 18.1)
@@ -25,6 +29,7 @@ namespace chainbase {
 
 std::vector<pinnable_mapped_file*> pinnable_mapped_file::_instance_tracker;
 pinnable_mapped_file::segment_manager_map_t  pinnable_mapped_file::_segment_manager_map;
+bool pinnable_mapped_file::_numa_interleave = false;
    
 const char* chainbase_error_category::name() const noexcept {
    return "chainbase";
@@ -197,7 +202,15 @@ pinnable_mapped_file::pinnable_mapped_file(const std::filesystem::path& dir, boo
          _file_mapped_region = bip::mapped_region(); // delete old r/w mapping before creating new one
 
          setup_copy_on_write_mapping();
+
+         // dirtied pages are private copies, so both the THP advice and the
+         // interleave policy take effect as they fault in
+         advise_transparent_hugepages(_file_mapped_region.get_address(), _file_mapped_region.get_size());
+         if(_numa_interleave)
+            interleave_across_numa_nodes(_file_mapped_region.get_address(), _file_mapped_region.get_size());
       } else {
+         // advisory only; kernels without file-backed THP simply ignore it
+         advise_transparent_hugepages(_file_mapped_region.get_address(), _file_mapped_region.get_size());
          _segment_manager = file_mapped_segment_manager;
       }
    }
@@ -218,6 +231,9 @@ pinnable_mapped_file::pinnable_mapped_file(const std::filesystem::path& dir, boo
       });
 
       setup_non_file_mapping();
+      // must happen before load_database_file() first-touches the pages
+      if(_numa_interleave)
+         interleave_across_numa_nodes(_non_file_mapped_mapping, _non_file_mapped_mapping_size);
       _file_mapped_region = bip::mapped_region();
       load_database_file(sig_ios);
 
@@ -294,6 +310,230 @@ size_t pinnable_mapped_file::check_memory_and_flush_if_needed() {
    return written_pages;
 }
 
+// Incrementally writes dirty state back to the database file in bounded
+// batches. In `mapped` mode the page cache already holds the authoritative
+// data, so we only schedule writeback (msync with MS_ASYNC) for a bounded
+// window, keeping the kernel's dirty backlog small enough that it never
+// stalls flushing gigabytes at once. In `mapped_private` mode the dirty pages
+// are private copies, so the window is copied back to the file with the same
+// pagemap-assisted path save_database_file() uses; the Soft-Dirty bits are
+// left alone, so the shutdown save stays correct. Heap and locked modes write
+// back at shutdown only and are not swept.
+size_t pinnable_mapped_file::flush_dirty_pages(size_t max_pages) {
+   if(!_writable || _non_file_mapped_mapping || max_pages == 0)
+      return 0;
+
+   const size_t pagesz = pagemap_accessor::page_size();
+   auto [src, sz] = get_region_to_save();
+   if(_flush_cursor >= sz)
+      _flush_cursor = 0;
+   const size_t batch = std::min(max_pages * pagesz, sz - _flush_cursor);
+
+   if(_sharable) {
+#ifndef _WIN32
+      if(msync(src + _flush_cursor, batch, MS_ASYNC))
+         std::cerr << "CHAINBASE: ERROR: async writeback of \"" << _database_name << "\" failed: " << strerror(errno) << '\n';
+#endif
+   } else {
+      // only tracked instances have usable Soft-Dirty bits (see setup_copy_on_write_mapping)
+      if(std::find(_instance_tracker.begin(), _instance_tracker.end(), this) == _instance_tracker.end())
+         return 0;
+      pagemap_accessor pagemap;
+      size_t written_pages = 0;
+      if(!pagemap.update_file_from_region({ src + _flush_cursor, batch }, _file_mapping, _flush_cursor, false, written_pages))
+         return 0;
+   }
+
+   _flush_cursor += batch;
+   return batch / pagesz;
+}
+
+// Hot-page profile layout: this header followed by one bit per page of the
+// mapping, set when the page was resident at save time.
+struct hot_page_profile_header {
+   uint32_t magic     = 0x48504843; // "CHPH"
+   uint32_t version   = 1;
+   uint64_t page_size = 0;
+   uint64_t num_pages = 0;
+};
+
+size_t pinnable_mapped_file::save_hot_pages(const std::filesystem::path& profile) const {
+#ifdef __linux__
+   if(_non_file_mapped_mapping)
+      return 0;
+
+   const size_t pagesz    = pagemap_accessor::page_size();
+   std::byte*   addr      = (std::byte*)_file_mapped_region.get_address();
+   const size_t sz        = _file_mapped_region.get_size();
+   const size_t num_pages = (sz + pagesz - 1) / pagesz;
+
+   std::vector<unsigned char> resident(num_pages);
+   if(mincore((void*)addr, sz, resident.data()))
+      return 0;
+
+   hot_page_profile_header hdr;
+   hdr.page_size = pagesz;
+   hdr.num_pages = num_pages;
+
+   std::vector<unsigned char> bitmap((num_pages + 7) / 8);
+   size_t hot = 0;
+   for(size_t i = 0; i < num_pages; ++i) {
+      if(resident[i] & 1) {
+         bitmap[i / 8] |= 1u << (i % 8);
+         ++hot;
+      }
+   }
+
+   // Write to a temporary and rename, so a crash mid-save never leaves a
+   // torn profile for the next start to read.
+   std::filesystem::path tmp = profile;
+   tmp += ".tmp";
+   {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      if(!out)
+         return 0;
+      out.write((const char*)&hdr, sizeof(hdr));
+      out.write((const char*)bitmap.data(), bitmap.size());
+      if(!out)
+         return 0;
+   }
+   std::error_code ec;
+   std::filesystem::rename(tmp, profile, ec);
+   return ec ? 0 : hot;
+#else
+   (void)profile;
+   return 0;
+#endif
+}
+
+size_t pinnable_mapped_file::prefault_hot_pages(const std::filesystem::path& profile) const {
+#ifdef __linux__
+   if(_non_file_mapped_mapping)
+      return 0;
+
+   std::ifstream in(profile, std::ios::binary);
+   if(!in)
+      return 0;
+
+   hot_page_profile_header hdr, expected;
+   in.read((char*)&hdr, sizeof(hdr));
+   if(!in || hdr.magic != expected.magic || hdr.version != expected.version ||
+      hdr.page_size != pagemap_accessor::page_size())
+      return 0;
+
+   const size_t pagesz = hdr.page_size;
+   std::byte*   addr   = (std::byte*)_file_mapped_region.get_address();
+   const size_t sz     = _file_mapped_region.get_size();
+   // A profile from before a grow still describes a valid prefix of the
+   // mapping; anything past the current size is dropped.
+   const size_t num_pages = std::min<uint64_t>(hdr.num_pages, sz / pagesz);
+
+   std::vector<unsigned char> bitmap((hdr.num_pages + 7) / 8);
+   in.read((char*)bitmap.data(), bitmap.size());
+   if(!in)
+      return 0;
+
+   auto is_hot = [&](size_t i) { return (bitmap[i / 8] >> (i % 8)) & 1; };
+
+   size_t prefaulted = 0;
+   size_t i          = 0;
+   while(i < num_pages) {
+      if(!is_hot(i)) {
+         ++i;
+         continue;
+      }
+      size_t run = i + 1;
+      while(run < num_pages && is_hot(run))
+         ++run;
+      if(madvise(addr + i * pagesz, (run - i) * pagesz, MADV_WILLNEED) == 0)
+         prefaulted += run - i;
+      i = run;
+   }
+   return prefaulted;
+#else
+   (void)profile;
+   return 0;
+#endif
+}
+
+// Online growth: extend the database file and the segment manager's free
+// memory while the process keeps running. Only `mapped` mode qualifies — its
+// MAP_SHARED pages are authoritative in the page cache, so unmapping and
+// remapping over the enlarged file loses nothing. The other modes keep their
+// state in private or anonymous memory whose relationship to the file is only
+// reconciled at shutdown, so growing them online would have to copy the whole
+// database; they keep requiring a restart with a larger --database-size.
+void pinnable_mapped_file::grow(size_t new_database_size) {
+   if(!_writable || !_sharable)
+      BOOST_THROW_EXCEPTION(std::logic_error("online database growth is only supported for writable databases in mapped mode"));
+   if(new_database_size % _db_size_multiple_requirement) {
+      std::string what_str("Database must be mulitple of " + std::to_string(_db_size_multiple_requirement) + " bytes");
+      BOOST_THROW_EXCEPTION(std::system_error(make_error_code(db_error_code::bad_size), what_str));
+   }
+   if(new_database_size <= _database_size)
+      return;
+   const size_t extra = new_database_size - _database_size;
+
+   // Drop the mapping before resizing so no stale view of the old extent
+   // survives, then remap the whole enlarged file. The new address will
+   // almost certainly differ, which is why callers must re-resolve every
+   // reference into the segment afterwards.
+   _segment_manager_map.erase(_segment_manager);
+   _segment_manager = nullptr;
+   _file_mapped_region = bip::mapped_region();
+   _file_mapping = bip::file_mapping();
+
+   std::filesystem::resize_file(_data_file_path, new_database_size);
+
+   _file_mapping = bip::file_mapping(_data_file_path.generic_string().c_str(), bip::read_write);
+   _file_mapped_region = bip::mapped_region(_file_mapping, bip::read_write);
+   advise_transparent_hugepages(_file_mapped_region.get_address(), _file_mapped_region.get_size());
+
+   auto* sm = reinterpret_cast<segment_manager*>((char*)_file_mapped_region.get_address()+header_size);
+   sm->grow(extra);
+
+   _segment_manager = sm;
+   _database_size = new_database_size;
+   _flush_cursor = 0;
+
+   std::byte* start = (std::byte*)_segment_manager;
+   assert(_segment_manager_map.find(start) == _segment_manager_map.end());
+   _segment_manager_map[start] = start + _segment_manager->get_size();
+}
+
+// Ask the kernel to back a mapping with transparent hugepages. This is purely
+// advisory: the region keeps working on plain 4KB pages when THP is disabled or
+// the mapping type is not eligible, so failures are deliberately ignored.
+void pinnable_mapped_file::advise_transparent_hugepages([[maybe_unused]] void* addr, [[maybe_unused]] size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+   madvise(addr, size, MADV_HUGEPAGE);
+#endif
+}
+
+// Spread the pages of a mapping evenly across every NUMA node the process may
+// allocate from. Implemented with the raw get_mempolicy()/mbind() syscalls so we
+// don't grow a libnuma dependency; the policy is applied before the pages are
+// first touched, which is when placement actually happens.
+void pinnable_mapped_file::interleave_across_numa_nodes([[maybe_unused]] void* addr, [[maybe_unused]] size_t size) const {
+#if defined(__linux__) && defined(SYS_mbind) && defined(MPOL_F_MEMS_ALLOWED)
+   constexpr unsigned long max_nodes = 1024;
+   unsigned long allowed_nodes[max_nodes / (sizeof(unsigned long) * 8)] = {};
+   if(syscall(SYS_get_mempolicy, nullptr, allowed_nodes, max_nodes, nullptr, MPOL_F_MEMS_ALLOWED) != 0)
+      return;
+
+   unsigned node_count = 0;
+   for(unsigned long word : allowed_nodes)
+      node_count += __builtin_popcountl(word);
+   if(node_count < 2)
+      return; // single node, nothing to interleave across
+
+   if(syscall(SYS_mbind, addr, size, MPOL_INTERLEAVE, allowed_nodes, max_nodes, 0) == 0)
+      std::cerr << "CHAINBASE: Database \"" << _database_name << "\" interleaved across " << node_count << " NUMA nodes" << '\n';
+   else
+      std::cerr << "CHAINBASE: Failed to set NUMA interleave policy for database \"" << _database_name << "\": " << strerror(errno) << '\n';
+#endif
+}
+
 void pinnable_mapped_file::setup_non_file_mapping() {
    int common_map_opts = MAP_PRIVATE|MAP_ANONYMOUS;
 
@@ -339,6 +579,8 @@ void pinnable_mapped_file::setup_non_file_mapping() {
    _non_file_mapped_mapping = mmap(NULL, _non_file_mapped_mapping_size, PROT_READ|PROT_WRITE, common_map_opts, -1, 0);
    if(_non_file_mapped_mapping == MAP_FAILED)
       BOOST_THROW_EXCEPTION(std::runtime_error(std::string("Failed to map database ") + _database_name + ": " + strerror(errno)));
+   // no pre-reserved hugepages available; fall back to transparent hugepages
+   advise_transparent_hugepages(_non_file_mapped_mapping, _non_file_mapped_mapping_size);
 #endif
 }
 
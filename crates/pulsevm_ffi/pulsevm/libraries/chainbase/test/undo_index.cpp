@@ -342,6 +342,58 @@ EXCEPTION_TEST_CASE(test_modify_push) {
    fs::remove_all( temp );
 }
 
+// Trivially copyable and well under the size threshold, so modifications
+// go through the flat undo journal instead of allocated old_nodes.
+struct small_element_t {
+   template<typename C>
+   small_element_t(C&& c, chainbase::constructor_tag) { c(*this); }
+
+   uint64_t id;
+   uint64_t value;
+};
+
+EXCEPTION_TEST_CASE(test_flat_undo_small_objects) {
+   fs::path temp = fs::temp_directory_path() / "pinnable_mapped_file";
+   try {
+      chainbase::pinnable_mapped_file db(temp, true, 1024 * 1024, false, chainbase::pinnable_mapped_file::map_mode::mapped);
+      test_allocator<small_element_t> alloc(db.get_segment_manager());
+      undo_index_in_segment<small_element_t, test_allocator<small_element_t>,
+                            boost::multi_index::ordered_unique<key<&small_element_t::id>>> i0(alloc);
+      static_assert(std::decay_t<decltype(*i0)>::use_flat_undo,
+                    "small trivially copyable elements must take the flat journal");
+      i0->emplace([](small_element_t& elem) { elem.value = 1; });
+      i0->emplace([](small_element_t& elem) { elem.value = 2; });
+      {
+         auto session0 = i0->start_undo_session(true);
+         i0->modify(*i0->find(0), [](small_element_t& elem) { elem.value = 10; });
+         {
+            auto session1 = i0->start_undo_session(true);
+            i0->modify(*i0->find(0), [](small_element_t& elem) { elem.value = 100; });
+            i0->modify(*i0->find(1), [](small_element_t& elem) { elem.value = 20; });
+            session1.squash();
+         }
+         BOOST_TEST(i0->find(0)->value == 100);
+         BOOST_TEST(i0->find(1)->value == 20);
+      }
+      // The outer session's destructor undoes everything, restoring the
+      // pre-session values from the journal-backed records.
+      BOOST_TEST(i0->find(0)->value == 1);
+      BOOST_TEST(i0->find(1)->value == 2);
+      {
+         auto session = i0->start_undo_session(true);
+         i0->modify(*i0->find(1), [](small_element_t& elem) { elem.value = 42; });
+         session.push();
+         i0->commit(i0->revision());
+      }
+      BOOST_TEST(!i0->has_undo_session());
+      BOOST_TEST(i0->find(1)->value == 42);
+   } catch ( ... ) {
+      fs::remove_all( temp );
+      throw;
+   }
+   fs::remove_all( temp );
+}
+
 EXCEPTION_TEST_CASE(test_remove_undo) {
    fs::path temp = fs::temp_directory_path() / "pinnable_mapped_file";
    try {
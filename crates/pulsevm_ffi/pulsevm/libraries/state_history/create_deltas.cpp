@@ -79,7 +79,15 @@ void pack_deltas(Stream& ds, const chainbase::database& db, bool full_snapshot)
       fc::raw::pack(ds, make_history_context_wrapper(db, get_table_id(row.t_id._id), row));
    };
 
-   auto process_table = [&](auto& ds, auto* name, auto& index, auto& pack_row) {
+   // Each changed table is packed exactly once, into its own growing
+   // buffer, while walking the undo session's modified-object lists; the
+   // table count and every table header fall out of the same pass. The
+   // old shape walked each undo list several times over — once to decide
+   // whether the table contributes, once to count entries, once to pack —
+   // with an O(log n) by-id lookup per old value on every walk.
+   std::vector<std::vector<char>> packed_tables;
+
+   auto process_table = [&](auto* name, auto& index, auto& pack_row) {
 
       auto pack_row_v0 = [&](auto& ds, bool present, auto& row) {
          fc::raw::pack(ds, present);
@@ -93,97 +101,83 @@ void pack_deltas(Stream& ds, const chainbase::database& db, bool full_snapshot)
          if (index.indices().empty())
             return;
 
-         fc::raw::pack(ds, fc::unsigned_int(0)); // table_delta = std::variant<table_delta_v0> and fc::unsigned_int struct_version
-         fc::raw::pack(ds, name);
-         fc::raw::pack(ds, fc::unsigned_int(index.indices().size()));
+         fc::datastream<std::vector<char>> ts;
+         fc::raw::pack(ts, fc::unsigned_int(0)); // table_delta = std::variant<table_delta_v0> and fc::unsigned_int struct_version
+         fc::raw::pack(ts, name);
+         fc::raw::pack(ts, fc::unsigned_int(index.indices().size()));
          for (auto& row : index.indices()) {
-            pack_row_v0(ds, true, row);
+            pack_row_v0(ts, true, row);
          }
+         packed_tables.emplace_back(std::move(ts.storage()));
       } else {
          auto undo = index.last_undo_session();
 
-         size_t num_entries =
-             std::count_if(undo.old_values.begin(), undo.old_values.end(),
-                           [&index](const auto& old) { return include_delta(old, index.get(old.id)); }) +
-             std::distance(undo.removed_values.begin(), undo.removed_values.end()) +
-             std::distance(undo.new_values.begin(), undo.new_values.end());
-
-         if (num_entries) {
-            fc::raw::pack(ds, fc::unsigned_int(0)); // table_delta = std::variant<table_delta_v0> and fc::unsigned_int struct_version
-            fc::raw::pack(ds, name);
-            fc::raw::pack(ds, fc::unsigned_int((uint32_t)num_entries));
-
-            for (auto& old : undo.old_values) {
-               auto& row = index.get(old.id);
-               if (include_delta(old, row)) {
-                  pack_row_v0(ds, true, row);
-               }
+         // Pack the rows first, counting as we go, so include_delta and
+         // the by-id lookup run once per modified object; the entry count
+         // is prepended afterwards.
+         fc::datastream<std::vector<char>> rows;
+         uint32_t num_entries = 0;
+
+         for (auto& old : undo.old_values) {
+            auto& row = index.get(old.id);
+            if (include_delta(old, row)) {
+               pack_row_v0(rows, true, row);
+               ++num_entries;
             }
+         }
 
-            for (auto& old : undo.removed_values) {
-               pack_row_v0(ds, false, old);
-            }
+         for (auto& old : undo.removed_values) {
+            pack_row_v0(rows, false, old);
+            ++num_entries;
+         }
 
-            for (auto& row : undo.new_values) {
-               pack_row_v0(ds, true, row);
-            }
+         for (auto& row : undo.new_values) {
+            pack_row_v0(rows, true, row);
+            ++num_entries;
          }
-      }
-   };
 
-   auto has_table = [&](auto x) -> int {
-      auto& index = db.get_index<std::remove_pointer_t<decltype(x)>>();
-      if (full_snapshot) {
-         return !index.indices().empty();
-      } else {
-         auto undo = index.last_undo_session();
-         return std::find_if(undo.old_values.begin(), undo.old_values.end(),
-                           [&index](const auto& old) { return include_delta(old, index.get(old.id)); }) != undo.old_values.end() ||
-             !undo.removed_values.empty() || !undo.new_values.empty();
+         if (num_entries) {
+            fc::datastream<std::vector<char>> ts;
+            fc::raw::pack(ts, fc::unsigned_int(0)); // table_delta = std::variant<table_delta_v0> and fc::unsigned_int struct_version
+            fc::raw::pack(ts, name);
+            fc::raw::pack(ts, fc::unsigned_int(num_entries));
+            ts.write(rows.storage().data(), rows.storage().size());
+            packed_tables.emplace_back(std::move(ts.storage()));
+         }
       }
    };
 
-   int num_tables = std::apply(
-       [&has_table](auto... args) { return (has_table(args) + ... ); },
-       std::tuple<chain::account_index*, chain::account_metadata_index*, chain::code_index*,
-                  chain::table_id_multi_index*, chain::key_value_index*, chain::index64_index*, chain::index128_index*,
-                  chain::index256_index*, chain::global_property_multi_index*,
-                  chain::protocol_state_multi_index*, chain::permission_index*, chain::permission_link_index*,
-                  chain::resource_limits::resource_limits_index*, chain::resource_limits::resource_usage_index*,
-                  chain::resource_limits::resource_limits_state_index*,
-                  chain::resource_limits::resource_limits_config_index*>());
-
-   fc::raw::pack(ds, fc::unsigned_int(num_tables));
-
-   process_table(ds, "account", db.get_index<chain::account_index>(), pack_row);
-   process_table(ds, "account_metadata", db.get_index<chain::account_metadata_index>(), pack_row);
-   process_table(ds, "code", db.get_index<chain::code_index>(), pack_row);
-
-   process_table(ds, "contract_table", db.get_index<chain::table_id_multi_index>(), pack_row);
-   process_table(ds, "contract_row", db.get_index<chain::key_value_index>(), pack_contract_row);
-   process_table(ds, "contract_index64", db.get_index<chain::index64_index>(), pack_contract_row);
-   process_table(ds, "contract_index128", db.get_index<chain::index128_index>(), pack_contract_row);
-   process_table(ds, "contract_index256", db.get_index<chain::index256_index>(), pack_contract_row);
-
-   process_table(ds, "global_property", db.get_index<chain::global_property_multi_index>(), pack_row);
-   process_table(ds, "protocol_state", db.get_index<chain::protocol_state_multi_index>(), pack_row);
-
-   process_table(ds, "permission", db.get_index<chain::permission_index>(), pack_row);
-   process_table(ds, "permission_link", db.get_index<chain::permission_link_index>(), pack_row);
-
-   process_table(ds, "resource_limits", db.get_index<chain::resource_limits::resource_limits_index>(), pack_row);
-   process_table(ds, "resource_usage", db.get_index<chain::resource_limits::resource_usage_index>(), pack_row);
-   process_table(ds, "resource_limits_state", db.get_index<chain::resource_limits::resource_limits_state_index>(),
+   process_table("account", db.get_index<chain::account_index>(), pack_row);
+   process_table("account_metadata", db.get_index<chain::account_metadata_index>(), pack_row);
+   process_table("code", db.get_index<chain::code_index>(), pack_row);
+
+   process_table("contract_table", db.get_index<chain::table_id_multi_index>(), pack_row);
+   process_table("contract_row", db.get_index<chain::key_value_index>(), pack_contract_row);
+   process_table("contract_index64", db.get_index<chain::index64_index>(), pack_contract_row);
+   process_table("contract_index128", db.get_index<chain::index128_index>(), pack_contract_row);
+   process_table("contract_index256", db.get_index<chain::index256_index>(), pack_contract_row);
+
+   process_table("global_property", db.get_index<chain::global_property_multi_index>(), pack_row);
+   process_table("protocol_state", db.get_index<chain::protocol_state_multi_index>(), pack_row);
+
+   process_table("permission", db.get_index<chain::permission_index>(), pack_row);
+   process_table("permission_link", db.get_index<chain::permission_link_index>(), pack_row);
+
+   process_table("resource_limits", db.get_index<chain::resource_limits::resource_limits_index>(), pack_row);
+   process_table("resource_usage", db.get_index<chain::resource_limits::resource_usage_index>(), pack_row);
+   process_table("resource_limits_state", db.get_index<chain::resource_limits::resource_limits_state_index>(),
                  pack_row);
-   process_table(ds, "resource_limits_config", db.get_index<chain::resource_limits::resource_limits_config_index>(),
+   process_table("resource_limits_config", db.get_index<chain::resource_limits::resource_limits_config_index>(),
                  pack_row);
 
+   fc::raw::pack(ds, fc::unsigned_int((uint32_t)packed_tables.size()));
+   for (auto& table : packed_tables) {
+      ds.write(table.data(), table.size());
+   }
 }
 
-template void pack_deltas<fc::datastream<char*>>(
-    fc::datastream<char*>&, const chainbase::database&, bool);
-template void pack_deltas<fc::datastream<size_t>>(
-    fc::datastream<size_t>&, const chainbase::database&, bool);
+template void pack_deltas<fc::datastream<std::vector<char>>>(
+    fc::datastream<std::vector<char>>&, const chainbase::database&, bool);
 
 } // namespace state_history
 } // namespace pulsevm
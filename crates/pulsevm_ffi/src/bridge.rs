@@ -7,6 +7,20 @@ pub mod ffi {
         ReadWrite = 1,
     }
 
+    /// How chainbase maps the shared memory file, mirroring
+    /// `pinnable_mapped_file::map_mode`.
+    #[repr(u32)]
+    enum DbMapMode {
+        /// Plain MAP_SHARED file mapping (the default).
+        Mapped = 0,
+        /// Copy-on-write file mapping, written back to disk at exit.
+        MappedPrivate = 1,
+        /// File copied at startup into an anonymous hugepage-backed mapping.
+        Heap = 2,
+        /// Like Heap, but additionally mlock'ed in memory.
+        Locked = 3,
+    }
+
     struct CpuLimitResult {
         limit: i64,
         greylisted: bool,
@@ -17,6 +31,52 @@ pub mod ffi {
         greylisted: bool,
     }
 
+    /// One account's sequence counter, as flushed by
+    /// `flush_sequence_counters`.
+    struct AccountSequence {
+        account: u64,
+        sequence: u64,
+    }
+
+    /// One account's accumulated RAM delta, as applied by
+    /// `apply_ram_usage_deltas`.
+    struct AccountRamDelta {
+        account: u64,
+        delta: i64,
+    }
+
+    /// One page of `get_table_rows_binary`: raw rows as a single blob,
+    /// each row prefixed with its little-endian u32 length. No ABI work
+    /// happens server-side in this mode; `abi_hash` (sha256 of the code
+    /// account's stored ABI) lets the consumer pair the bytes with the
+    /// ABI revision to decode them against.
+    struct TableRowsBinaryResult {
+        rows: Vec<u8>,
+        more: bool,
+        next_key: String,
+        abi_hash: String,
+    }
+
+    /// One permission link row, as enumerated by
+    /// `collect_permission_links` when the Rust-side link mirror rebuilds.
+    struct PermissionLink {
+        account: u64,
+        code: u64,
+        message_type: u64,
+        required_permission: u64,
+    }
+
+    /// One (public key, permission) membership row, as enumerated by
+    /// `collect_permission_authority_keys` when the Rust-side key→permission
+    /// reverse index rebuilds. `satisfies_alone` precomputes whether the
+    /// key's weight meets the authority threshold by itself.
+    struct PermissionAuthorityKey {
+        key: SharedPtr<CxxPublicKey>,
+        owner: u64,
+        name: u64,
+        satisfies_alone: bool,
+    }
+
     struct Ratio {
         numerator: u64,
         denominator: u64,
@@ -152,7 +212,6 @@ pub mod ffi {
         include!("utils.hpp");
         include!("name.hpp");
         include!("database.hpp");
-        include!("iterator_cache.hpp");
         include!("api.hpp");
         include!("builtins.hpp");
 
@@ -160,6 +219,8 @@ pub mod ffi {
             path: &str,
             flags: DatabaseOpenFlags,
             size: u64,
+            map_mode: DbMapMode,
+            numa_interleave: bool,
         ) -> UniquePtr<Database>;
 
         #[cxx_name = "database_wrapper"]
@@ -192,6 +253,7 @@ pub mod ffi {
         pub fn get_parent_id(self: &PermissionObject) -> i64;
         pub fn get_owner(self: &PermissionObject) -> &CxxName;
         pub fn get_name(self: &PermissionObject) -> &CxxName;
+        pub fn get_last_updated_us(self: &PermissionObject) -> i64;
         pub fn get_authority(self: &PermissionObject) -> &CxxSharedAuthority;
 
         #[cxx_name = "permission_usage_object"]
@@ -211,6 +273,7 @@ pub mod ffi {
 
         #[cxx_name = "table_id_object"]
         type TableObject;
+        pub fn get_id(self: &TableObject) -> i64;
         pub fn get_code(self: &TableObject) -> &CxxName;
         pub fn get_scope(self: &TableObject) -> &CxxName;
         pub fn get_table(self: &TableObject) -> &CxxName;
@@ -261,11 +324,28 @@ pub mod ffi {
         // Methods on database
         #[allow(dead_code)]
         pub fn flush(self: Pin<&mut Database>) -> Result<()>;
+        /// Writes back at most `max_pages` of the chainbase mapping,
+        /// sweeping across calls; returns the pages covered by the batch.
+        pub fn flush_dirty_pages(self: Pin<&mut Database>, max_pages: u64) -> Result<u64>;
+        /// Records the resident page set of the chainbase mapping to
+        /// `profile_path`; returns the pages recorded.
+        pub fn save_hot_pages(self: &Database, profile_path: &str) -> Result<u64>;
+        /// Prefaults the page set recorded at `profile_path` with readahead
+        /// advice; returns the pages covered. Missing or stale profiles
+        /// prefault nothing.
+        pub fn prefault_hot_pages(self: &Database, profile_path: &str) -> Result<u64>;
         pub fn undo(self: Pin<&mut Database>) -> Result<()>;
         pub fn commit(self: Pin<&mut Database>, revision: i64) -> Result<()>;
         pub fn revision(self: &Database) -> i64;
+        /// Unallocated bytes left in the chainbase shared-memory segment.
+        pub fn get_free_memory_bytes(self: &Database) -> u64;
         pub fn set_revision(self: Pin<&mut Database>, revision: i64) -> Result<()>;
         pub fn add_indices(self: Pin<&mut Database>);
+        /// Grow the shared-memory segment to `new_size` bytes in place and
+        /// rebuild the index registrations over the remapped file. Fails for
+        /// non-`mapped` database modes and for sizes that are not a multiple
+        /// of 1MB; a size at or below the current one is a no-op.
+        pub fn grow(self: Pin<&mut Database>, new_size: u64) -> Result<()>;
         pub fn create_undo_session(
             self: Pin<&mut Database>,
             enabled: bool,
@@ -330,6 +410,12 @@ pub mod ffi {
             account: u64,
             time_slot: u32,
         ) -> Result<()>;
+        pub fn update_account_usage_and_get_cpu_limit(
+            self: Pin<&mut Database>,
+            account: u64,
+            time_slot: u32,
+            greylist_limit: u32,
+        ) -> Result<CpuLimitResult>;
         pub fn add_transaction_usage(
             self: Pin<&mut Database>,
             account: u64,
@@ -343,6 +429,10 @@ pub mod ffi {
             ram_bytes: i64,
         ) -> Result<()>;
         pub fn verify_account_ram_usage(self: Pin<&mut Database>, account_name: u64) -> Result<()>;
+        pub fn apply_ram_usage_deltas(
+            self: Pin<&mut Database>,
+            deltas: &[AccountRamDelta],
+        ) -> Result<()>;
         pub fn get_account_ram_usage(self: &Database, account_name: u64) -> Result<i64>;
         pub fn set_account_limits(
             self: Pin<&mut Database>,
@@ -377,12 +467,16 @@ pub mod ffi {
             net_limit_parameters: &ElasticLimitParameters,
         ) -> Result<()>;
         pub fn process_block_usage(self: Pin<&mut Database>, block_num: u32) -> Result<()>;
+        // Pure multi-index lookups: like the tree-step primitives below,
+        // these cannot throw, so they skip Result and the per-call
+        // exception-frame setup cxx generates for fallible functions —
+        // find_table in particular runs on every contract db host call.
         pub fn find_table(
             self: &Database,
             code: u64,
             scope: u64,
             table: u64,
-        ) -> Result<*const TableObject>;
+        ) -> *const TableObject;
         pub fn create_table(
             self: Pin<&mut Database>,
             code: u64,
@@ -390,14 +484,8 @@ pub mod ffi {
             table: u64,
             payer: u64,
         ) -> Result<&TableObject>;
-        pub fn db_find_i64(
-            self: Pin<&mut Database>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            id: u64,
-            keyval_cache: Pin<&mut CxxKeyValueIteratorCache>,
-        ) -> Result<i32>;
+        pub fn db_find_i64_obj(self: &Database, tab: &TableObject, id: u64)
+        -> *const KeyValueObject;
         pub fn create_key_value_object(
             self: Pin<&mut Database>,
             table: &TableObject,
@@ -451,8 +539,8 @@ pub mod ffi {
             secondary_key: U256,
         ) -> Result<()>;
         pub fn remove_table(self: Pin<&mut Database>, table: &TableObject) -> Result<()>;
-        pub fn is_account(self: &Database, account: u64) -> Result<bool>;
-        pub fn find_permission(self: &Database, id: i64) -> Result<*const PermissionObject>;
+        pub fn is_account(self: &Database, account: u64) -> bool;
+        pub fn find_permission(self: &Database, id: i64) -> *const PermissionObject;
         pub fn find_permission_by_actor_and_permission(
             self: &Database,
             actor: u64,
@@ -476,242 +564,142 @@ pub mod ffi {
             code_name: u64,
             requirement_type: u64,
         ) -> Result<i64>;
-        pub fn next_recv_sequence(
+        pub fn get_global_action_sequence(self: &Database) -> u64;
+        pub fn flush_sequence_counters(
             self: Pin<&mut Database>,
-            receiver_account: &AccountMetadataObject,
-        ) -> Result<u64>;
-        pub fn next_auth_sequence(self: Pin<&mut Database>, actor: u64) -> Result<u64>;
-        pub fn next_global_sequence(self: Pin<&mut Database>) -> Result<u64>;
-        pub fn db_remove_i64(
+            global_action_sequence: u64,
+            recv_sequences: &[AccountSequence],
+            auth_sequences: &[AccountSequence],
+        ) -> Result<()>;
+        pub fn db_remove_i64_obj(
             self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxKeyValueIteratorCache>,
-            iterator: i32,
+            obj: &KeyValueObject,
+            table: &TableObject,
             receiver: u64,
         ) -> Result<i64>;
-        pub fn db_next_i64(
+        // Bulk-load mode: see the comment block in `database.hpp`.
+        pub fn bulk_load_begin(self: Pin<&mut Database>) -> Result<()>;
+        pub fn bulk_load_end(self: Pin<&mut Database>, revision: i64) -> Result<()>;
+        pub fn bulk_load_store_sorted(
             self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxKeyValueIteratorCache>,
-            iterator: i32,
-            primary: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_previous_i64(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxKeyValueIteratorCache>,
-            iterator: i32,
-            primary: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_end_i64(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxKeyValueIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-        ) -> Result<i32>;
-        pub fn db_lowerbound_i64(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxKeyValueIteratorCache>,
             code: u64,
             scope: u64,
             table: u64,
-            id: u64,
-        ) -> Result<i32>;
-        pub fn db_upperbound_i64(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxKeyValueIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            id: u64,
-        ) -> Result<i32>;
+            payer: u64,
+            ids: &[u64],
+            values: &[u8],
+            value_sizes: &[u64],
+        ) -> Result<i64>;
+        pub fn db_next_i64_obj(self: &Database, obj: &KeyValueObject) -> *const KeyValueObject;
+        /// Bulk successor walk with node prefetch; fills primary keys and row
+        /// addresses (as `usize`, re-borrowed by the caller) and returns the
+        /// rows written. See `database.hpp` for the window semantics.
+        pub fn db_next_i64_window(
+            self: &Database,
+            obj: &KeyValueObject,
+            out_primaries: &mut [u64],
+            out_rows: &mut [usize],
+        ) -> usize;
+        pub fn db_previous_i64_obj(self: &Database, obj: &KeyValueObject)
+        -> *const KeyValueObject;
+        pub fn db_last_i64_obj(self: &Database, tab: &TableObject) -> *const KeyValueObject;
+        pub fn db_lowerbound_i64_obj(self: &Database, tab: &TableObject, id: u64)
+        -> *const KeyValueObject;
+        pub fn db_upperbound_i64_obj(self: &Database, tab: &TableObject, id: u64)
+        -> *const KeyValueObject;
 
         // Index 64 methods
-        pub fn db_idx64_remove(
+        pub fn db_idx64_remove_obj(
             self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            iterator: i32,
+            obj: &Index64Object,
+            table: &TableObject,
             receiver: u64,
         ) -> Result<()>;
-        pub fn db_idx64_find_secondary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
+        pub fn db_idx64_find_secondary_obj(
+            self: &Database,
+            tab: &TableObject,
             secondary_key: u64,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx64_find_primary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut u64,
+        ) -> *const Index64Object;
+        pub fn db_idx64_find_primary_obj(
+            self: &Database,
+            tab: &TableObject,
             primary_key: u64,
-        ) -> Result<i32>;
-        pub fn db_idx64_lowerbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut u64,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx64_upperbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut u64,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx64_end(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-        ) -> Result<i32>;
-        pub fn db_idx64_next(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx64_previous(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex64IteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
+        ) -> *const Index64Object;
+        pub fn db_idx64_lowerbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: u64,
+        ) -> *const Index64Object;
+        pub fn db_idx64_upperbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: u64,
+        ) -> *const Index64Object;
+        pub fn db_idx64_next_obj(self: &Database, obj: &Index64Object) -> *const Index64Object;
+        pub fn db_idx64_previous_obj(self: &Database, obj: &Index64Object) -> *const Index64Object;
+        pub fn db_idx64_last_obj(self: &Database, tab: &TableObject) -> *const Index64Object;
 
         // Index 128 methods
-        pub fn db_idx128_remove(
+        pub fn db_idx128_remove_obj(
             self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            iterator: i32,
+            obj: &Index128Object,
+            table: &TableObject,
             receiver: u64,
         ) -> Result<()>;
-        pub fn db_idx128_find_secondary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
+        pub fn db_idx128_find_secondary_obj(
+            self: &Database,
+            tab: &TableObject,
             secondary_key: U128,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx128_find_primary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut U128,
+        ) -> *const Index128Object;
+        pub fn db_idx128_find_primary_obj(
+            self: &Database,
+            tab: &TableObject,
             primary_key: u64,
-        ) -> Result<i32>;
-        pub fn db_idx128_lowerbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut U128,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx128_upperbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut U128,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx128_end(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-        ) -> Result<i32>;
-        pub fn db_idx128_next(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx128_previous(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex128IteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
+        ) -> *const Index128Object;
+        pub fn db_idx128_lowerbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: U128,
+        ) -> *const Index128Object;
+        pub fn db_idx128_upperbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: U128,
+        ) -> *const Index128Object;
+        pub fn db_idx128_next_obj(self: &Database, obj: &Index128Object) -> *const Index128Object;
+        pub fn db_idx128_previous_obj(self: &Database, obj: &Index128Object) -> *const Index128Object;
+        pub fn db_idx128_last_obj(self: &Database, tab: &TableObject) -> *const Index128Object;
 
         // Index 256 methods
-        pub fn db_idx256_remove(
+        pub fn db_idx256_remove_obj(
             self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            iterator: i32,
+            obj: &Index256Object,
+            table: &TableObject,
             receiver: u64,
         ) -> Result<()>;
-        pub fn db_idx256_find_secondary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
+        pub fn db_idx256_find_secondary_obj(
+            self: &Database,
+            tab: &TableObject,
             secondary_key: U256,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx256_find_primary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut U256,
+        ) -> *const Index256Object;
+        pub fn db_idx256_find_primary_obj(
+            self: &Database,
+            tab: &TableObject,
             primary_key: u64,
-        ) -> Result<i32>;
-        pub fn db_idx256_lowerbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut U256,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx256_upperbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut U256,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx256_end(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-        ) -> Result<i32>;
-        pub fn db_idx256_next(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx256_previous(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndex256IteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
+        ) -> *const Index256Object;
+        pub fn db_idx256_lowerbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: U256,
+        ) -> *const Index256Object;
+        pub fn db_idx256_upperbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: U256,
+        ) -> *const Index256Object;
+        pub fn db_idx256_next_obj(self: &Database, obj: &Index256Object) -> *const Index256Object;
+        pub fn db_idx256_previous_obj(self: &Database, obj: &Index256Object) -> *const Index256Object;
+        pub fn db_idx256_last_obj(self: &Database, tab: &TableObject) -> *const Index256Object;
 
         // Index double methods
         pub fn create_idx_double_object(
@@ -727,67 +715,35 @@ pub mod ffi {
             payer: u64,
             secondary_key: u64,
         ) -> Result<()>;
-        pub fn db_idx_double_remove(
+        pub fn db_idx_double_remove_obj(
             self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            iterator: i32,
+            obj: &IndexDoubleObject,
+            table: &TableObject,
             receiver: u64,
         ) -> Result<()>;
-        pub fn db_idx_double_find_secondary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
+        pub fn db_idx_double_find_secondary_obj(
+            self: &Database,
+            tab: &TableObject,
             secondary_key: u64,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_double_find_primary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut u64,
+        ) -> *const IndexDoubleObject;
+        pub fn db_idx_double_find_primary_obj(
+            self: &Database,
+            tab: &TableObject,
             primary_key: u64,
-        ) -> Result<i32>;
-        pub fn db_idx_double_lowerbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut u64,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_double_upperbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut u64,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_double_end(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-        ) -> Result<i32>;
-        pub fn db_idx_double_next(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_double_previous(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexDoubleIteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
+        ) -> *const IndexDoubleObject;
+        pub fn db_idx_double_lowerbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: u64,
+        ) -> *const IndexDoubleObject;
+        pub fn db_idx_double_upperbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: u64,
+        ) -> *const IndexDoubleObject;
+        pub fn db_idx_double_next_obj(self: &Database, obj: &IndexDoubleObject) -> *const IndexDoubleObject;
+        pub fn db_idx_double_previous_obj(self: &Database, obj: &IndexDoubleObject) -> *const IndexDoubleObject;
+        pub fn db_idx_double_last_obj(self: &Database, tab: &TableObject) -> *const IndexDoubleObject;
 
         // Index long double methods
         pub fn create_idx_long_double_object(
@@ -803,67 +759,35 @@ pub mod ffi {
             payer: u64,
             secondary_key: Float128,
         ) -> Result<()>;
-        pub fn db_idx_long_double_remove(
+        pub fn db_idx_long_double_remove_obj(
             self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            iterator: i32,
+            obj: &IndexLongDoubleObject,
+            table: &TableObject,
             receiver: u64,
         ) -> Result<()>;
-        pub fn db_idx_long_double_find_secondary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
+        pub fn db_idx_long_double_find_secondary_obj(
+            self: &Database,
+            tab: &TableObject,
             secondary_key: Float128,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_long_double_find_primary(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut Float128,
+        ) -> *const IndexLongDoubleObject;
+        pub fn db_idx_long_double_find_primary_obj(
+            self: &Database,
+            tab: &TableObject,
             primary_key: u64,
-        ) -> Result<i32>;
-        pub fn db_idx_long_double_lowerbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut Float128,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_long_double_upperbound(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-            secondary_key: &mut Float128,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_long_double_end(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            code: u64,
-            scope: u64,
-            table: u64,
-        ) -> Result<i32>;
-        pub fn db_idx_long_double_next(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
-        pub fn db_idx_long_double_previous(
-            self: Pin<&mut Database>,
-            keyval_cache: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            iterator: i32,
-            primary_key: &mut u64,
-        ) -> Result<i32>;
+        ) -> *const IndexLongDoubleObject;
+        pub fn db_idx_long_double_lowerbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: Float128,
+        ) -> *const IndexLongDoubleObject;
+        pub fn db_idx_long_double_upperbound_obj(
+            self: &Database,
+            tab: &TableObject,
+            secondary_key: Float128,
+        ) -> *const IndexLongDoubleObject;
+        pub fn db_idx_long_double_next_obj(self: &Database, obj: &IndexLongDoubleObject) -> *const IndexLongDoubleObject;
+        pub fn db_idx_long_double_previous_obj(self: &Database, obj: &IndexLongDoubleObject) -> *const IndexLongDoubleObject;
+        pub fn db_idx_long_double_last_obj(self: &Database, tab: &TableObject) -> *const IndexLongDoubleObject;
 
         pub fn remove_permission(
             self: Pin<&mut Database>,
@@ -903,6 +827,10 @@ pub mod ffi {
             code: u64,
             requirement_type: u64,
         ) -> Result<*const CxxName>;
+        pub fn collect_permission_links(self: &Database) -> Result<Vec<PermissionLink>>;
+        pub fn collect_permission_authority_keys(
+            self: &Database,
+        ) -> Result<Vec<PermissionAuthorityKey>>;
         pub fn get_global_properties(self: &Database) -> Result<&GlobalPropertyObject>;
         pub fn set_global_properties(self: Pin<&mut Database>, cfg: &ChainConfigV0) -> Result<()>;
         pub fn get_virtual_block_cpu_limit(self: &Database) -> Result<u64>;
@@ -918,158 +846,21 @@ pub mod ffi {
         pub fn clear_expired_input_transactions(
             self: Pin<&mut Database>,
             cutoff: &TimePoint,
-        ) -> Result<()>;
+            max_removals: u32,
+        ) -> Result<u32>;
 
         // Methods on undo_session
         pub fn push(self: Pin<&mut UndoSession>) -> Result<()>;
         pub fn squash(self: Pin<&mut UndoSession>) -> Result<()>;
+        /// O(1) merge into the enclosing session, skipping the duplicate
+        /// compression that squash() performs per modified object.
+        pub fn squash_fast(self: Pin<&mut UndoSession>) -> Result<()>;
         pub fn undo(self: Pin<&mut UndoSession>) -> Result<()>;
-
-        pub type CxxKeyValueIteratorCache;
-        pub fn new_key_value_iterator_cache() -> UniquePtr<CxxKeyValueIteratorCache>;
-        pub fn cache_table(
-            self: Pin<&mut CxxKeyValueIteratorCache>,
-            table: &TableObject,
-        ) -> Result<i32>;
-        pub fn get_table(
-            self: &CxxKeyValueIteratorCache,
-            table_id: &TableId,
-        ) -> Result<&TableObject>;
-        pub fn get_end_iterator_by_table_id(
-            self: &CxxKeyValueIteratorCache,
-            table_id: &TableId,
-        ) -> Result<i32>;
-        pub fn find_table_by_end_iterator(
-            self: &CxxKeyValueIteratorCache,
-            ei: i32,
-        ) -> Result<*const TableObject>;
-        pub fn get(self: &CxxKeyValueIteratorCache, iterator: i32) -> Result<&KeyValueObject>;
-        pub fn remove(self: Pin<&mut CxxKeyValueIteratorCache>, iterator: i32) -> Result<()>;
-        pub fn add(self: Pin<&mut CxxKeyValueIteratorCache>, obj: &KeyValueObject) -> Result<i32>;
-
-        pub type CxxIndex64IteratorCache;
-        pub fn new_index64_iterator_cache() -> UniquePtr<CxxIndex64IteratorCache>;
-        pub fn cache_table(
-            self: Pin<&mut CxxIndex64IteratorCache>,
-            table: &TableObject,
-        ) -> Result<i32>;
-        pub fn get_table(
-            self: &CxxIndex64IteratorCache,
-            table_id: &TableId,
-        ) -> Result<&TableObject>;
-        pub fn get_end_iterator_by_table_id(
-            self: &CxxIndex64IteratorCache,
-            table_id: &TableId,
-        ) -> Result<i32>;
-        pub fn find_table_by_end_iterator(
-            self: &CxxIndex64IteratorCache,
-            ei: i32,
-        ) -> Result<*const TableObject>;
-        pub fn get(self: &CxxIndex64IteratorCache, iterator: i32) -> Result<&Index64Object>;
-        pub fn remove(self: Pin<&mut CxxIndex64IteratorCache>, iterator: i32) -> Result<()>;
-        pub fn add(self: Pin<&mut CxxIndex64IteratorCache>, obj: &Index64Object) -> Result<i32>;
-
-        pub type CxxIndex128IteratorCache;
-        pub fn new_index128_iterator_cache() -> UniquePtr<CxxIndex128IteratorCache>;
-        pub fn cache_table(
-            self: Pin<&mut CxxIndex128IteratorCache>,
-            table: &TableObject,
-        ) -> Result<i32>;
-        pub fn get_table(
-            self: &CxxIndex128IteratorCache,
-            table_id: &TableId,
-        ) -> Result<&TableObject>;
-        pub fn get_end_iterator_by_table_id(
-            self: &CxxIndex128IteratorCache,
-            table_id: &TableId,
-        ) -> Result<i32>;
-        pub fn find_table_by_end_iterator(
-            self: &CxxIndex128IteratorCache,
-            ei: i32,
-        ) -> Result<*const TableObject>;
-        pub fn get(self: &CxxIndex128IteratorCache, iterator: i32) -> Result<&Index128Object>;
-        pub fn remove(self: Pin<&mut CxxIndex128IteratorCache>, iterator: i32) -> Result<()>;
-        pub fn add(self: Pin<&mut CxxIndex128IteratorCache>, obj: &Index128Object) -> Result<i32>;
-
-        pub type CxxIndex256IteratorCache;
-        pub fn new_index256_iterator_cache() -> UniquePtr<CxxIndex256IteratorCache>;
-        pub fn cache_table(
-            self: Pin<&mut CxxIndex256IteratorCache>,
-            table: &TableObject,
-        ) -> Result<i32>;
-        pub fn get_table(
-            self: &CxxIndex256IteratorCache,
-            table_id: &TableId,
-        ) -> Result<&TableObject>;
-        pub fn get_end_iterator_by_table_id(
-            self: &CxxIndex256IteratorCache,
-            table_id: &TableId,
-        ) -> Result<i32>;
-        pub fn find_table_by_end_iterator(
-            self: &CxxIndex256IteratorCache,
-            ei: i32,
-        ) -> Result<*const TableObject>;
-        pub fn get(self: &CxxIndex256IteratorCache, iterator: i32) -> Result<&Index256Object>;
-        pub fn remove(self: Pin<&mut CxxIndex256IteratorCache>, iterator: i32) -> Result<()>;
-        pub fn add(self: Pin<&mut CxxIndex256IteratorCache>, obj: &Index256Object) -> Result<i32>;
-
-        pub type CxxIndexDoubleIteratorCache;
-        pub fn new_index_double_iterator_cache() -> UniquePtr<CxxIndexDoubleIteratorCache>;
-        pub fn cache_table(
-            self: Pin<&mut CxxIndexDoubleIteratorCache>,
-            table: &TableObject,
-        ) -> Result<i32>;
-        pub fn get_table(
-            self: &CxxIndexDoubleIteratorCache,
-            table_id: &TableId,
-        ) -> Result<&TableObject>;
-        pub fn get_end_iterator_by_table_id(
-            self: &CxxIndexDoubleIteratorCache,
-            table_id: &TableId,
-        ) -> Result<i32>;
-        pub fn find_table_by_end_iterator(
-            self: &CxxIndexDoubleIteratorCache,
-            ei: i32,
-        ) -> Result<*const TableObject>;
-        pub fn get(self: &CxxIndexDoubleIteratorCache, iterator: i32)
-        -> Result<&IndexDoubleObject>;
-        pub fn remove(self: Pin<&mut CxxIndexDoubleIteratorCache>, iterator: i32) -> Result<()>;
-        pub fn add(
-            self: Pin<&mut CxxIndexDoubleIteratorCache>,
-            obj: &IndexDoubleObject,
-        ) -> Result<i32>;
-
-        pub type CxxIndexLongDoubleIteratorCache;
-        pub fn new_index_long_double_iterator_cache() -> UniquePtr<CxxIndexLongDoubleIteratorCache>;
-        pub fn cache_table(
-            self: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            table: &TableObject,
-        ) -> Result<i32>;
-        pub fn get_table(
-            self: &CxxIndexLongDoubleIteratorCache,
-            table_id: &TableId,
-        ) -> Result<&TableObject>;
-        pub fn get_end_iterator_by_table_id(
-            self: &CxxIndexLongDoubleIteratorCache,
-            table_id: &TableId,
-        ) -> Result<i32>;
-        pub fn find_table_by_end_iterator(
-            self: &CxxIndexLongDoubleIteratorCache,
-            ei: i32,
-        ) -> Result<*const TableObject>;
-        pub fn get(
-            self: &CxxIndexLongDoubleIteratorCache,
-            iterator: i32,
-        ) -> Result<&IndexLongDoubleObject>;
-        pub fn remove(self: Pin<&mut CxxIndexLongDoubleIteratorCache>, iterator: i32)
-        -> Result<()>;
-        pub fn add(
-            self: Pin<&mut CxxIndexLongDoubleIteratorCache>,
-            obj: &IndexLongDoubleObject,
-        ) -> Result<i32>;
+        /// Rolls back to the session's base state without ending the
+        /// session; the session object stays live for reuse.
+        pub fn revert(self: Pin<&mut UndoSession>) -> Result<()>;
 
         pub type CxxBlockTimestamp;
-        pub fn to_time_point(self: &CxxBlockTimestamp) -> SharedPtr<CxxTimePoint>;
         pub fn get_slot(self: &CxxBlockTimestamp) -> u32;
 
         pub type CxxChainConfig;
@@ -1130,14 +921,6 @@ pub mod ffi {
         pub fn make_digest_from_existing_hash(data: &[u8]) -> Result<UniquePtr<CxxDigest>>;
         pub fn make_shared_digest_from_existing_hash(data: &[u8]) -> SharedPtr<CxxDigest>;
         pub fn make_shared_digest_from_string(key_str: &str) -> SharedPtr<CxxDigest>;
-        pub fn make_time_point_from_now() -> SharedPtr<CxxTimePoint>;
-        #[allow(dead_code)]
-        pub fn make_block_timestamp_from_now() -> SharedPtr<CxxBlockTimestamp>;
-        #[allow(dead_code)]
-        pub fn make_block_timestamp_from_slot(slot: u32) -> SharedPtr<CxxBlockTimestamp>;
-        pub fn make_time_point_from_i64(us: i64) -> SharedPtr<CxxTimePoint>;
-        #[allow(dead_code)]
-        pub fn make_time_point_from_microseconds(us: &CxxMicroseconds) -> SharedPtr<CxxTimePoint>;
         pub fn parse_genesis_state(json: &str) -> Result<UniquePtr<CxxGenesisState>>;
         pub fn parse_public_key(key_str: &str) -> Result<SharedPtr<CxxPublicKey>>;
         pub fn parse_public_key_from_bytes(data: &[u8]) -> Result<SharedPtr<CxxPublicKey>>;
@@ -1170,8 +953,11 @@ pub mod ffi {
         pub fn random_private_key() -> SharedPtr<CxxPrivateKey>;
         pub fn random_private_key_r1() -> SharedPtr<CxxPrivateKey>;
         pub fn extract_chain_id_from_genesis_state(genesis: &CxxGenesisState) -> Vec<u8>;
-        #[allow(dead_code)]
         pub fn index128_object_secondary_key_as_u128(obj: &Index128Object) -> U128;
+        pub fn index256_object_secondary_key_as_u256(obj: &Index256Object) -> U256;
+        pub fn index_double_object_secondary_key_bits(obj: &IndexDoubleObject) -> u64;
+        pub fn index_long_double_object_secondary_key(obj: &IndexLongDoubleObject) -> Float128;
+        pub fn table_id_value(id: &TableId) -> i64;
 
         pub type CxxName;
 
@@ -1209,6 +995,8 @@ pub mod ffi {
             account: u64,
         ) -> Result<String>;
         pub fn get_currency_stats(db: &Database, code: u64, symbol: &str) -> Result<String>;
+        pub fn get_db_allocation_stats(db: &Database) -> Result<String>;
+        pub fn get_db_commit_stats(db: &Database) -> Result<String>;
         pub fn get_table_by_scope(
             db: &Database,
             code: u64,
@@ -1218,6 +1006,13 @@ pub mod ffi {
             limit: u32,
             reverse: bool,
         ) -> Result<String>;
+        pub fn get_table_stats(
+            db: &Database,
+            code: u64,
+            scope: &str,
+            table: u64,
+            index_position: &str,
+        ) -> Result<String>;
         pub fn get_table_rows(
             db: &Database,
             json: bool,
@@ -1234,6 +1029,16 @@ pub mod ffi {
             reverse: bool,
             show_payer: bool,
         ) -> Result<String>;
+        pub fn get_table_rows_binary(
+            db: &Database,
+            code: u64,
+            scope: &str,
+            table: u64,
+            lower_bound: &str,
+            upper_bound: &str,
+            limit: u32,
+            reverse: bool,
+        ) -> Result<TableRowsBinaryResult>;
 
         // State history
         pub fn pack_deltas(self: &Database, full_snapshot: bool) -> Result<Vec<u8>>;
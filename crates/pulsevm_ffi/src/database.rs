@@ -1,3 +1,4 @@
+use std::collections::{HashMap, HashSet};
 use std::sync::{Arc, RwLock};
 
 use cxx::UniquePtr;
@@ -9,28 +10,307 @@ use crate::{
     IndexDoubleIteratorCache, IndexLongDoubleIteratorCache, IndexLongDoubleObject, KeyValueObject,
     bridge::ffi::{
         self, Authority, CxxDigest, CxxGenesisState, ElasticLimitParameters, Index64Object,
-        Index128Object, Index256Object, IndexDoubleObject, TableObject, TimePoint, U128, U256,
+        Index128Object, Index256Object, IndexDoubleObject, TableObject, TimePoint, U256,
         get_account_info_with_core_symbol, get_account_info_without_core_symbol,
         get_currency_balance_with_symbol, get_currency_balance_without_symbol, get_currency_stats,
-        get_table_by_scope, get_table_rows,
+        get_db_allocation_stats, get_db_commit_stats, get_table_by_scope, get_table_rows,
+        get_table_rows_binary, get_table_stats,
     },
     iterator_cache::{Index256IteratorCache, KeyValueIteratorCache},
 };
 
+// Upper bound on remembered absent tables; the cache resets rather than
+// evicts when it fills, which keeps the fast path a single hash probe.
+const ABSENT_TABLE_CACHE_MAX: usize = 65536;
+
+// Upper bound on remembered resolved tables; past it, stale-generation
+// entries are purged first and the cache resets only if that isn't enough.
+const RESOLVED_TABLE_CACHE_MAX: usize = 65536;
+
+/// Positive counterpart of the absent-table set: (code, scope, table)
+/// triples resolved to their chainbase table object.
+///
+/// Table resolution is the most repeated FFI pattern — every contract db
+/// host call starts with one — and the per-action iterator caches rebuild
+/// from scratch each action, so a hot table (an AMM pool, a token stat
+/// row's table) is re-resolved thousands of times per block. Entries here
+/// survive across actions and transactions, turning those repeats into one
+/// hash probe. Each entry is stamped with the generation it was resolved
+/// in: an undo unwind bumps the generation instead of sweeping the map, so
+/// invalidation is O(1) and stale entries are simply never returned until
+/// they are overwritten or purged at the size cap. `remove_table` evicts
+/// its entry eagerly.
+struct ResolvedTableCache {
+    generation: u64,
+    entries: HashMap<(u64, u64, u64), (*const TableObject, u64)>,
+}
+
+impl ResolvedTableCache {
+    fn new() -> Self {
+        Self {
+            generation: 0,
+            entries: HashMap::new(),
+        }
+    }
+
+    fn get(&self, code: u64, scope: u64, table: u64) -> Option<*const TableObject> {
+        match self.entries.get(&(code, scope, table)) {
+            Some((ptr, stamp)) if *stamp == self.generation => Some(*ptr),
+            _ => None,
+        }
+    }
+
+    fn insert(&mut self, code: u64, scope: u64, table: u64, ptr: *const TableObject) {
+        if self.entries.len() >= RESOLVED_TABLE_CACHE_MAX {
+            let generation = self.generation;
+            self.entries.retain(|_, (_, stamp)| *stamp == generation);
+            if self.entries.len() >= RESOLVED_TABLE_CACHE_MAX {
+                self.entries.clear();
+            }
+        }
+        self.entries
+            .insert((code, scope, table), (ptr, self.generation));
+    }
+
+    fn remove(&mut self, code: u64, scope: u64, table: u64) {
+        self.entries.remove(&(code, scope, table));
+    }
+
+    /// Retires every entry at once; the map itself is left in place so the
+    /// unwind path never pays a sweep proportional to the cache size.
+    fn retire_all(&mut self) {
+        self.generation += 1;
+    }
+}
+
+/// Sorted struct-of-arrays mirror of the permission link table.
+///
+/// Link lookups run once per declared authorization of every action, while
+/// the links themselves are few and change only on `linkauth`/`unlinkauth`.
+/// Mirroring them into parallel arrays sorted by (account, code,
+/// message_type) turns each lookup into a binary search over contiguous
+/// u64s — branch-predictable and cache-dense — instead of a chainbase tree
+/// walk across the FFI. The key arrays match the by_action_name index
+/// ordering, so a rebuild copies the index in iteration order.
+struct PermissionLinkMirror {
+    accounts: Vec<u64>,
+    codes: Vec<u64>,
+    message_types: Vec<u64>,
+    required_permissions: Vec<u64>,
+}
+
+impl PermissionLinkMirror {
+    fn from_rows(rows: Vec<ffi::PermissionLink>) -> Self {
+        let mut mirror = PermissionLinkMirror {
+            accounts: Vec::with_capacity(rows.len()),
+            codes: Vec::with_capacity(rows.len()),
+            message_types: Vec::with_capacity(rows.len()),
+            required_permissions: Vec::with_capacity(rows.len()),
+        };
+        for row in rows {
+            mirror.accounts.push(row.account);
+            mirror.codes.push(row.code);
+            mirror.message_types.push(row.message_type);
+            mirror.required_permissions.push(row.required_permission);
+        }
+        mirror
+    }
+
+    /// Binary search for the key; `Err` carries the insertion point.
+    fn position(&self, key: (u64, u64, u64)) -> Result<usize, usize> {
+        let mut lo = 0usize;
+        let mut hi = self.accounts.len();
+        while lo < hi {
+            let mid = lo + (hi - lo) / 2;
+            let probe = (self.accounts[mid], self.codes[mid], self.message_types[mid]);
+            if probe < key {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if lo < self.accounts.len()
+            && (self.accounts[lo], self.codes[lo], self.message_types[lo]) == key
+        {
+            Ok(lo)
+        } else {
+            Err(lo)
+        }
+    }
+
+    /// Specific (account, code, message_type) link first, then the
+    /// contract-wide default (empty message type) — the same fallback the
+    /// chainbase lookup performs.
+    fn lookup(&self, account: u64, code: u64, message_type: u64) -> Option<u64> {
+        if let Ok(at) = self.position((account, code, message_type)) {
+            return Some(self.required_permissions[at]);
+        }
+        if let Ok(at) = self.position((account, code, 0)) {
+            return Some(self.required_permissions[at]);
+        }
+        None
+    }
+
+    fn upsert(&mut self, account: u64, code: u64, message_type: u64, required: u64) {
+        match self.position((account, code, message_type)) {
+            Ok(at) => self.required_permissions[at] = required,
+            Err(at) => {
+                self.accounts.insert(at, account);
+                self.codes.insert(at, code);
+                self.message_types.insert(at, message_type);
+                self.required_permissions.insert(at, required);
+            }
+        }
+    }
+
+    fn remove(&mut self, account: u64, code: u64, message_type: u64) {
+        if let Ok(at) = self.position((account, code, message_type)) {
+            self.accounts.remove(at);
+            self.codes.remove(at);
+            self.message_types.remove(at);
+            self.required_permissions.remove(at);
+        }
+    }
+}
+
+/// Reverse index public key → permissions whose authority references the
+/// key directly, keyed by the packed key bytes.
+///
+/// `get_required_keys` is called by wallets before every transaction, and
+/// the overwhelmingly common shape is one candidate key against a plain
+/// single-key authority. Each entry precomputes whether the key's weight
+/// meets the authority threshold on its own, so that case resolves with
+/// one hash probe instead of an authority tree walk across the FFI. A
+/// permission's entries are per key, so authorities referencing several
+/// keys contribute one row each.
+struct KeyPermissionMirror {
+    entries: HashMap<Vec<u8>, Vec<(u64, u64, bool)>>,
+}
+
+impl KeyPermissionMirror {
+    fn from_rows(rows: Vec<ffi::PermissionAuthorityKey>) -> Self {
+        let mut mirror = KeyPermissionMirror {
+            entries: HashMap::with_capacity(rows.len()),
+        };
+        for row in rows {
+            mirror
+                .entries
+                .entry(row.key.packed_bytes())
+                .or_default()
+                .push((row.owner, row.name, row.satisfies_alone));
+        }
+        mirror
+    }
+
+    /// `Some(alone)` when the key is a direct factor of (owner, name);
+    /// `None` says nothing about nested account factors, so callers must
+    /// fall back to the full authority walk rather than conclude "unsatisfiable".
+    fn lookup(&self, key: &[u8], owner: u64, name: u64) -> Option<bool> {
+        self.entries.get(key).and_then(|permissions| {
+            permissions
+                .iter()
+                .find(|(o, n, _)| *o == owner && *n == name)
+                .map(|(_, _, alone)| *alone)
+        })
+    }
+
+    /// Adds one row per key factor of `authority`, replacing rows a
+    /// previous version of the same permission left behind.
+    fn insert_authority(&mut self, owner: u64, name: u64, authority: &Authority) {
+        for key_weight in authority.keys() {
+            let alone = key_weight.weight as u32 >= authority.threshold();
+            let permissions = self
+                .entries
+                .entry(key_weight.key.packed_bytes())
+                .or_default();
+            match permissions
+                .iter_mut()
+                .find(|(o, n, _)| *o == owner && *n == name)
+            {
+                Some(entry) => entry.2 = alone,
+                None => permissions.push((owner, name, alone)),
+            }
+        }
+    }
+
+    /// Drops the rows `authority`'s key factors contributed for (owner, name).
+    fn remove_authority(&mut self, owner: u64, name: u64, authority: &Authority) {
+        for key_weight in authority.keys() {
+            let packed = key_weight.key.packed_bytes();
+            if let Some(permissions) = self.entries.get_mut(&packed) {
+                permissions.retain(|(o, n, _)| *o != owner || *n != name);
+                if permissions.is_empty() {
+                    self.entries.remove(&packed);
+                }
+            }
+        }
+    }
+}
+
 #[derive(Clone)]
 pub struct Database {
     inner: Arc<RwLock<UniquePtr<ffi::Database>>>,
+    // Negative-lookup cache for `find_table`: (code, scope, table) triples
+    // recently observed to have no table object, so repeated probes of
+    // nonexistent tables never cross the FFI. A triple is dropped when
+    // `create_table` materializes it; the whole set must be cleared (see
+    // `clear_absent_table_cache`) whenever an undo session unwinds, since
+    // undoing a `remove_table` resurrects a table without any create.
+    absent_tables: Arc<RwLock<HashSet<(u64, u64, u64)>>>,
+    // Cross-action positive table resolution cache (see
+    // `ResolvedTableCache`). Entries are retired by a generation bump (see
+    // `clear_resolved_table_cache`) whenever an undo session unwinds, since
+    // the unwind can remove or resurrect table objects behind the wrappers.
+    resolved_tables: Arc<RwLock<ResolvedTableCache>>,
+    // Flat mirror of the permission link table (see `PermissionLinkMirror`),
+    // rebuilt lazily on the first lookup after it is dropped. Like
+    // `absent_tables`, it must be cleared (see
+    // `clear_permission_link_mirror`) whenever an undo session unwinds,
+    // since the unwind can revert link changes behind the wrapper's back.
+    permission_links: Arc<RwLock<Option<PermissionLinkMirror>>>,
+    // Reverse index public key → permissions referencing it (see
+    // `KeyPermissionMirror`), rebuilt lazily on the first lookup after it
+    // is dropped and kept current through the permission mutation wrappers.
+    // Cleared (see `clear_key_permission_mirror`) whenever an undo session
+    // unwinds, which can revert permission changes behind the wrappers.
+    key_permissions: Arc<RwLock<Option<KeyPermissionMirror>>>,
 }
 
 impl Database {
     pub fn new(path: &str, size: u64) -> Result<Self, String> {
-        let db = ffi::open_database(path, ffi::DatabaseOpenFlags::ReadWrite, size);
+        Self::new_with_map_mode(path, size, ffi::DbMapMode::Mapped, false)
+    }
+
+    /// Opens the database with an explicit chainbase mapping mode.
+    ///
+    /// `Heap` and `Locked` copy the database file into an anonymous
+    /// hugepage-backed mapping at startup, trading load time for far fewer TLB
+    /// misses on large state databases. `numa_interleave` spreads the mapping
+    /// across all NUMA nodes the process may allocate from instead of filling
+    /// up whichever node faults the pages in first.
+    pub fn new_with_map_mode(
+        path: &str,
+        size: u64,
+        map_mode: ffi::DbMapMode,
+        numa_interleave: bool,
+    ) -> Result<Self, String> {
+        let db = ffi::open_database(
+            path,
+            ffi::DatabaseOpenFlags::ReadWrite,
+            size,
+            map_mode,
+            numa_interleave,
+        );
 
         if db.is_null() {
             Err("Failed to open database".to_string())
         } else {
             Ok(Database {
                 inner: Arc::new(RwLock::new(db)),
+                absent_tables: Arc::new(RwLock::new(HashSet::new())),
+                resolved_tables: Arc::new(RwLock::new(ResolvedTableCache::new())),
+                permission_links: Arc::new(RwLock::new(None)),
+                key_permissions: Arc::new(RwLock::new(None)),
             })
         }
     }
@@ -43,11 +323,56 @@ impl Database {
     }
 
     pub fn commit(&mut self, revision: i64) -> Result<(), ChainError> {
+        let _ffi = crate::ffi_timed!("commit");
         self.inner
             .write()?
             .pin_mut()
             .commit(revision)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Writes back at most `max_pages` dirty pages of the chainbase mapping,
+    /// sweeping the whole mapping across calls. Driven by the background
+    /// flusher so commit-time writeback happens in small batches instead of
+    /// one kernel-sized stall.
+    pub fn flush_dirty_pages(&self, max_pages: u64) -> Result<u64, ChainError> {
+        let mut guard = self.inner.write()?;
+        if guard.is_null() {
+            // shutdown already closed the database; nothing left to flush
+            return Ok(0);
+        }
+        guard
+            .pin_mut()
+            .flush_dirty_pages(max_pages)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Records the currently resident page set of the chainbase mapping to
+    /// `profile_path`, so the next start can prefault the same working set.
+    /// Returns the number of pages recorded.
+    pub fn save_hot_pages(&self, profile_path: &str) -> Result<u64, ChainError> {
+        let guard = self.inner.read()?;
+        if guard.is_null() {
+            // shutdown already closed the database; nothing to record
+            return Ok(0);
+        }
+        guard
+            .save_hot_pages(profile_path)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Prefaults the page set a previous run recorded at `profile_path` with
+    /// readahead advice, warming the mapping before the first blocks run.
+    /// A missing or stale profile prefaults nothing. Returns the number of
+    /// pages covered.
+    pub fn prefault_hot_pages(&self, profile_path: &str) -> Result<u64, ChainError> {
+        let guard = self.inner.read()?;
+        if guard.is_null() {
+            return Ok(0);
+        }
+        guard
+            .prefault_hot_pages(profile_path)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn undo(&mut self) -> Result<(), ChainError> {
@@ -55,19 +380,32 @@ impl Database {
             .write()?
             .pin_mut()
             .undo()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        // Unwinding can resurrect removed tables; see
+        // `clear_absent_table_cache`.
+        self.clear_absent_table_cache()
     }
 
     pub fn revision(&self) -> i64 {
         self.inner.read().unwrap().revision()
     }
 
+    /// Unallocated bytes left in the chainbase shared-memory segment.
+    pub fn free_memory_bytes(&self) -> u64 {
+        let guard = self.inner.read().unwrap();
+        if guard.is_null() {
+            // shutdown already closed the database
+            return 0;
+        }
+        guard.get_free_memory_bytes()
+    }
+
     pub fn set_revision(&mut self, revision: i64) -> Result<(), ChainError> {
         self.inner
             .write()?
             .pin_mut()
             .set_revision(revision)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn add_indices(&mut self) -> Result<(), ChainError> {
@@ -75,13 +413,46 @@ impl Database {
         Ok(())
     }
 
+    /// Grow the shared-memory segment to `new_size` bytes without
+    /// restarting the node. Holds the database write lock for the whole
+    /// remap, so no reads, writes or FFI references are in flight while
+    /// the segment's base address moves.
+    pub fn grow(&mut self, new_size: u64) -> Result<(), ChainError> {
+        self.inner
+            .write()?
+            .pin_mut()
+            .grow(new_size)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        // The remap may have moved the segment's base address, so every
+        // cached `*const TableObject` is dangling — retire them before any
+        // db host call can hit the cache. The absent set holds no pointers
+        // but predates the remap too; drop it with the same broom.
+        self.clear_resolved_table_cache()?;
+        self.clear_absent_table_cache()
+    }
+
     pub fn initialize_database(&mut self, genesis: &CxxGenesisState) -> Result<(), ChainError> {
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
             .initialize_database(genesis)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Enters bulk-load mode for genesis bootstraps and large state imports.
+    /// Undo tracking stays off (the C++ side refuses while any undo session
+    /// is live) and rows inserted through the returned session append via
+    /// hinted end-insertion instead of paying a tree descent per row per
+    /// index. Call [`BulkLoadSession::finish`] to seal the import at its
+    /// final revision.
+    pub fn bulk_load_session(&self) -> Result<BulkLoadSession, ChainError> {
+        self.inner
+            .write()?
+            .pin_mut()
+            .bulk_load_begin()
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        Ok(BulkLoadSession { db: self.clone() })
     }
 
     pub fn create_account(
@@ -94,16 +465,17 @@ impl Database {
 
         let acct_ref = pinned
             .create_account(account_name, creation_date)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(acct_ref as *const ffi::AccountObject)
     }
 
     pub fn find_account(&self, account_name: u64) -> Result<*const ffi::AccountObject, ChainError> {
+        let _ffi = crate::ffi_timed!("find_account");
         let guard = self.inner.read()?;
         let account = guard
             .find_account(account_name)
-            .map_err(|e| ChainError::InternalError(format!("failed to get account: {}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, "failed to get account"))?;
 
         Ok(account)
     }
@@ -112,10 +484,11 @@ impl Database {
         &self,
         account_name: u64,
     ) -> Result<&'static ffi::AccountObject, ChainError> {
+        let _ffi = crate::ffi_timed!("get_account");
         let guard = self.inner.read()?;
         let account = guard
             .find_account(account_name)
-            .map_err(|e| ChainError::InternalError(format!("failed to get account: {}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, "failed to get account"))?;
 
         if account.is_null() {
             return Err(ChainError::InternalError(format!(
@@ -137,7 +510,7 @@ impl Database {
 
         let res = pinned
             .create_account_metadata(account_name, is_privileged)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(res as *const ffi::AccountMetadataObject)
     }
@@ -146,10 +519,11 @@ impl Database {
         &self,
         account_name: u64,
     ) -> Result<*const ffi::AccountMetadataObject, ChainError> {
+        let _ffi = crate::ffi_timed!("find_account_metadata");
         let guard = self.inner.read()?;
 
         guard.find_account_metadata(account_name).map_err(|e| {
-            ChainError::InternalError(format!("failed to find account metadata: {}", e))
+            crate::ffi_error::chain_error_from_ffi(e, "failed to find account metadata")
         })
     }
 
@@ -159,16 +533,17 @@ impl Database {
 
         pinned
             .set_privileged(account, is_privileged)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_account_metadata(
         &self,
         account_name: u64,
     ) -> Result<&'static ffi::AccountMetadataObject, ChainError> {
+        let _ffi = crate::ffi_timed!("get_account_metadata");
         let guard = self.inner.read()?;
         let res = guard.find_account_metadata(account_name).map_err(|e| {
-            ChainError::InternalError(format!("failed to find account metadata: {}", e))
+            crate::ffi_error::chain_error_from_ffi(e, "failed to find account metadata")
         })?;
 
         if res.is_null() {
@@ -190,7 +565,7 @@ impl Database {
 
         pinned
             .unlink_account_code(old_code_entry)
-            .map_err(|e| ChainError::ActionValidationError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn update_account_code(
@@ -216,7 +591,7 @@ impl Database {
                 vm_type,
                 vm_version,
             )
-            .map_err(|e| ChainError::ActionValidationError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn update_account_abi(
@@ -230,19 +605,20 @@ impl Database {
 
         pinned
             .update_account_abi(account, account_metadata, abi)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn create_undo_session(
         &mut self,
         enabled: bool,
     ) -> Result<cxx::UniquePtr<ffi::UndoSession>, ChainError> {
+        let _ffi = crate::ffi_timed!("create_undo_session");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
             .create_undo_session(enabled)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn initialize_resource_limits(&mut self) -> Result<(), ChainError> {
@@ -251,7 +627,7 @@ impl Database {
 
         pinned
             .initialize_resource_limits()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn initialize_account_resource_limits(
@@ -263,7 +639,7 @@ impl Database {
 
         pinned
             .initialize_account_resource_limits(account_name)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn update_account_usage(
@@ -276,7 +652,24 @@ impl Database {
 
         pinned
             .update_account_usage(account.as_u64(), time_slot)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// One-crossing form of [`Self::get_account_cpu_limit`] followed by
+    /// [`Self::update_account_usage`], for the per-transaction init path.
+    pub fn update_account_usage_and_get_cpu_limit(
+        &mut self,
+        account: &Name,
+        time_slot: u32,
+        greylist_limit: u32,
+    ) -> Result<ffi::CpuLimitResult, ChainError> {
+        let _ffi = crate::ffi_timed!("update_account_usage_and_get_cpu_limit");
+        let mut guard = self.inner.write()?;
+        let pinned = guard.pin_mut();
+
+        pinned
+            .update_account_usage_and_get_cpu_limit(account.as_u64(), time_slot, greylist_limit)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn add_transaction_usage(
@@ -286,12 +679,13 @@ impl Database {
         net_usage: u64,
         time_slot: u32,
     ) -> Result<(), ChainError> {
+        let _ffi = crate::ffi_timed!("add_transaction_usage");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
             .add_transaction_usage(account.as_u64(), cpu_usage, net_usage, time_slot)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn add_pending_ram_usage(
@@ -304,7 +698,7 @@ impl Database {
 
         pinned
             .add_pending_ram_usage(account_name, ram_bytes)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn verify_account_ram_usage(&mut self, account_name: u64) -> Result<(), ChainError> {
@@ -313,7 +707,22 @@ impl Database {
 
         pinned
             .verify_account_ram_usage(account_name)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Applies a transaction's accumulated per-account RAM deltas in one
+    /// bridge crossing, verifying the limit of each account that grew.
+    pub fn apply_ram_usage_deltas(
+        &mut self,
+        deltas: &[ffi::AccountRamDelta],
+    ) -> Result<(), ChainError> {
+        let _ffi = crate::ffi_timed!("apply_ram_usage_deltas");
+        let mut guard = self.inner.write()?;
+        let pinned = guard.pin_mut();
+
+        pinned
+            .apply_ram_usage_deltas(deltas)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_account_ram_usage(&self, account_name: u64) -> Result<i64, ChainError> {
@@ -321,7 +730,7 @@ impl Database {
 
         guard
             .get_account_ram_usage(account_name)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn set_account_limits(
@@ -336,7 +745,7 @@ impl Database {
 
         pinned
             .set_account_limits(account_name, ram_bytes, net_weight, cpu_weight)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_account_limits(
@@ -350,7 +759,7 @@ impl Database {
 
         guard
             .get_account_limits(account_name, ram_bytes, net_weight, cpu_weight)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_total_cpu_weight(&self) -> Result<u64, ChainError> {
@@ -358,7 +767,7 @@ impl Database {
 
         guard
             .get_total_cpu_weight()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_total_net_weight(&self) -> Result<u64, ChainError> {
@@ -366,7 +775,7 @@ impl Database {
 
         guard
             .get_total_net_weight()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_account_net_limit(
@@ -378,7 +787,7 @@ impl Database {
 
         guard
             .get_account_net_limit(name, greylist_limit)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_account_cpu_limit(
@@ -390,7 +799,7 @@ impl Database {
 
         guard
             .get_account_cpu_limit(name, greylist_limit)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn process_account_limit_updates(&mut self) -> Result<(), ChainError> {
@@ -399,7 +808,7 @@ impl Database {
 
         pinned
             .process_account_limit_updates()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn set_block_parameters(
@@ -412,16 +821,70 @@ impl Database {
 
         pinned
             .set_block_parameters(cpu_limit_parameters, net_limit_parameters)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn process_block_usage(&mut self, block_num: u32) -> Result<(), ChainError> {
+        let _ffi = crate::ffi_timed!("process_block_usage");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
             .process_block_usage(block_num)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Remembers that `(code, scope, table)` has no table object, so later
+    /// probes short-circuit before the FFI. Resets the set instead of
+    /// evicting when it fills.
+    fn note_table_absent(&self, code: u64, scope: u64, table: u64) -> Result<(), ChainError> {
+        let mut absent = self.absent_tables.write()?;
+        if absent.len() >= ABSENT_TABLE_CACHE_MAX {
+            absent.clear();
+        }
+        absent.insert((code, scope, table));
+        Ok(())
+    }
+
+    /// Forgets every remembered absent table. Must be called whenever an
+    /// undo session on this database unwinds: undoing a table removal
+    /// resurrects the table without `create_table` ever seeing it, so any
+    /// absence observed since could be stale.
+    pub fn clear_absent_table_cache(&self) -> Result<(), ChainError> {
+        self.absent_tables.write()?.clear();
+        Ok(())
+    }
+
+    /// Retires every resolved-table entry by bumping the cache generation.
+    /// Must be called whenever an undo session on this database unwinds:
+    /// the unwind can remove table objects (dangling the cached pointers)
+    /// or resurrect removed ones without going through the wrappers.
+    pub fn clear_resolved_table_cache(&self) -> Result<(), ChainError> {
+        self.resolved_tables.write()?.retire_all();
+        Ok(())
+    }
+
+    /// Table resolution behind the persistent cache: a current-generation
+    /// entry answers without touching the FFI, and a fresh resolution is
+    /// remembered for the actions and transactions that follow. Negative
+    /// results are the absent set's job, so they are not stored here.
+    fn resolve_table(
+        &self,
+        db: &UniquePtr<ffi::Database>,
+        code: u64,
+        scope: u64,
+        table: u64,
+    ) -> Result<*const TableObject, ChainError> {
+        if let Some(ptr) = self.resolved_tables.read()?.get(code, scope, table) {
+            return Ok(ptr);
+        }
+        let res = db.find_table(code, scope, table);
+        if !res.is_null() {
+            self.resolved_tables
+                .write()?
+                .insert(code, scope, table, res);
+        }
+        Ok(res)
     }
 
     pub fn find_table(
@@ -430,10 +893,15 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<*const TableObject, ChainError> {
+        let _ffi = crate::ffi_timed!("find_table");
+        if self.absent_tables.read()?.contains(&(code, scope, table)) {
+            return Ok(std::ptr::null());
+        }
         let guard = self.inner.read()?;
-        let res = guard
-            .find_table(code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+        let res = self.resolve_table(&guard, code, scope, table)?;
+        if res.is_null() {
+            self.note_table_absent(code, scope, table)?;
+        }
 
         Ok(res)
     }
@@ -444,10 +912,8 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<*const TableObject, ChainError> {
-        let guard = self.inner.read()?;
-        let res = guard
-            .find_table(code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+        let _ffi = crate::ffi_timed!("get_table");
+        let res = self.find_table(code, scope, table)?;
 
         if res.is_null() {
             return Err(ChainError::InternalError(format!(
@@ -466,11 +932,18 @@ impl Database {
         table: u64,
         payer: u64,
     ) -> Result<*const TableObject, ChainError> {
+        let _ffi = crate::ffi_timed!("create_table");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
         let res = pinned
             .create_table(code, scope, table, payer)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        // The table exists now; any remembered absence is obsolete, and the
+        // fresh object can be served from the resolution cache right away.
+        self.absent_tables.write()?.remove(&(code, scope, table));
+        self.resolved_tables
+            .write()?
+            .insert(code, scope, table, res as *const TableObject);
         Ok(res as *const TableObject)
     }
 
@@ -482,11 +955,27 @@ impl Database {
         id: u64,
         keyval_cache: &mut KeyValueIteratorCache,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let _ffi = crate::ffi_timed!("db_find_i64");
+        if self.absent_tables.read()?.contains(&(code, scope, table)) {
+            return Ok(-1);
+        }
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            self.note_table_absent(code, scope, table)?;
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_find_i64_obj(tab, id);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
 
-        { pinned.db_find_i64(code, scope, table, id, keyval_cache.pin_mut()) }
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        Ok(keyval_cache.add(unsafe { &*obj }))
     }
 
     pub fn create_key_value_object(
@@ -496,12 +985,13 @@ impl Database {
         id: u64,
         buffer: &[u8],
     ) -> Result<*const KeyValueObject, ChainError> {
+        let _ffi = crate::ffi_timed!("create_key_value_object");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         let res = pinned
             .create_key_value_object(table, payer, id, buffer)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
         Ok(res as *const KeyValueObject)
     }
 
@@ -512,12 +1002,13 @@ impl Database {
         id: u64,
         secondary_key: u64,
     ) -> Result<*const Index64Object, ChainError> {
+        let _ffi = crate::ffi_timed!("create_index64_object");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         let res = pinned
             .create_index64_object(table, payer, id, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
         Ok(res as *const Index64Object)
     }
 
@@ -527,12 +1018,13 @@ impl Database {
         payer: u64,
         buffer: &[u8],
     ) -> Result<(), ChainError> {
+        let _ffi = crate::ffi_timed!("update_key_value_object");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
             .update_key_value_object(obj, payer, buffer)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn update_index64_object(
@@ -541,38 +1033,62 @@ impl Database {
         payer: u64,
         secondary_key: u64,
     ) -> Result<(), ChainError> {
+        let _ffi = crate::ffi_timed!("update_index64_object");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
             .update_index64_object(obj, payer, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn remove_table(&mut self, table: &TableObject) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .remove_table(table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let code = table.get_code().to_uint64_t();
+        let scope = table.get_scope().to_uint64_t();
+        let table_name = table.get_table().to_uint64_t();
+        {
+            let mut guard = self.inner.write()?;
+            let pinned = guard.pin_mut();
+
+            pinned
+                .remove_table(table)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
+        self.resolved_tables
+            .write()?
+            .remove(code, scope, table_name);
+        Ok(())
     }
 
     pub fn is_account(&self, account: u64) -> Result<bool, ChainError> {
+        let _ffi = crate::ffi_timed!("is_account");
         let guard = self.inner.read()?;
 
-        guard
-            .is_account(account)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        Ok(guard.is_account(account))
+    }
+
+    // Batched variant of is_account: probes up to 64 names under a single
+    // database lock and returns an existence bitmask where bit i is set when
+    // names[i] is an account. Callers pass sorted, deduplicated names and
+    // chunk larger sets.
+    pub fn accounts_exist(&self, names: &[u64]) -> Result<u64, ChainError> {
+        let _ffi = crate::ffi_timed!("accounts_exist");
+        debug_assert!(names.len() <= 64, "accounts_exist takes at most 64 names");
+        let guard = self.inner.read()?;
+
+        let mut mask = 0u64;
+        for (i, name) in names.iter().take(64).enumerate() {
+            if guard.is_account(*name) {
+                mask |= 1u64 << i;
+            }
+        }
+        Ok(mask)
     }
 
     pub fn find_permission(&self, id: i64) -> Result<*const ffi::PermissionObject, ChainError> {
         let guard = self.inner.read()?;
-        let res = guard
-            .find_permission(id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
 
-        Ok(res)
+        Ok(guard.find_permission(id))
     }
 
     pub fn find_permission_by_actor_and_permission(
@@ -580,10 +1096,11 @@ impl Database {
         actor: u64,
         permission: u64,
     ) -> Result<*const ffi::PermissionObject, ChainError> {
+        let _ffi = crate::ffi_timed!("find_permission_by_actor_and_permission");
         let guard = self.inner.read()?;
         let res = guard
             .find_permission_by_actor_and_permission(actor, permission)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(res)
     }
@@ -593,10 +1110,11 @@ impl Database {
         actor: u64,
         permission: u64,
     ) -> Result<*const ffi::PermissionObject, ChainError> {
+        let _ffi = crate::ffi_timed!("get_permission_by_actor_and_permission");
         let guard = self.inner.read()?;
         let res = guard
             .find_permission_by_actor_and_permission(actor, permission)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         if res.is_null() {
             return Err(ChainError::InternalError(format!(
@@ -610,12 +1128,32 @@ impl Database {
     }
 
     pub fn delete_auth(&mut self, account: u64, permission_name: u64) -> Result<i64, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .delete_auth(account, permission_name)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        // Capture the doomed permission's authority first (only when the
+        // key mirror is live) so its rows can be retired after the delete.
+        let old_authority = if self.key_permissions.read()?.is_some() {
+            let ptr = self.find_permission_by_actor_and_permission(account, permission_name)?;
+            if ptr.is_null() {
+                None
+            } else {
+                Some(unsafe { &*ptr }.get_authority().to_authority())
+            }
+        } else {
+            None
+        };
+        let delta = {
+            let mut guard = self.inner.write()?;
+            let pinned = guard.pin_mut();
+
+            pinned
+                .delete_auth(account, permission_name)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?
+        };
+        if let Some(old_authority) = old_authority {
+            if let Some(mirror) = self.key_permissions.write()?.as_mut() {
+                mirror.remove_authority(account, permission_name, &old_authority);
+            }
+        }
+        Ok(delta)
     }
 
     pub fn link_auth(
@@ -625,12 +1163,18 @@ impl Database {
         requirement_name: u64,
         requirement_type: u64,
     ) -> Result<i64, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .link_auth(account_name, code_name, requirement_name, requirement_type)
-            .map_err(|e| ChainError::ActionValidationError(format!("{}", e)))
+        let delta = {
+            let mut guard = self.inner.write()?;
+            let pinned = guard.pin_mut();
+
+            pinned
+                .link_auth(account_name, code_name, requirement_name, requirement_type)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?
+        };
+        if let Some(mirror) = self.permission_links.write()?.as_mut() {
+            mirror.upsert(account_name, code_name, requirement_type, requirement_name);
+        }
+        Ok(delta)
     }
 
     pub fn unlink_auth(
@@ -639,12 +1183,18 @@ impl Database {
         code_name: u64,
         requirement_type: u64,
     ) -> Result<i64, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .unlink_auth(account_name, code_name, requirement_type)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let delta = {
+            let mut guard = self.inner.write()?;
+            let pinned = guard.pin_mut();
+
+            pinned
+                .unlink_auth(account_name, code_name, requirement_type)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?
+        };
+        if let Some(mirror) = self.permission_links.write()?.as_mut() {
+            mirror.remove(account_name, code_name, requirement_type);
+        }
+        Ok(delta)
     }
 
     pub fn get_code_object_by_hash(
@@ -656,39 +1206,35 @@ impl Database {
         let guard = self.inner.read()?;
         let res = guard
             .get_code_object_by_hash(code_hash, vm_type, vm_version)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(res)
     }
 
-    pub fn next_recv_sequence(
-        &mut self,
-        receiver_account: &AccountMetadataObject,
-    ) -> Result<u64, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .next_recv_sequence(receiver_account)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn next_auth_sequence(&mut self, actor: u64) -> Result<u64, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .next_auth_sequence(actor)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+    /// Current value of the global action sequence counter, without
+    /// incrementing it. Seeds the Rust-side sequence shadow at the first
+    /// action of a block.
+    pub fn get_global_action_sequence(&self) -> Result<u64, ChainError> {
+        let guard = self.inner.read()?;
+        Ok(guard.get_global_action_sequence())
     }
 
-    pub fn next_global_sequence(&mut self) -> Result<u64, ChainError> {
+    /// Writes the sequence shadow back to the dynamic global properties and
+    /// account metadata in one FFI crossing; called once per block within
+    /// the block's undo session.
+    pub fn flush_sequence_counters(
+        &mut self,
+        global_action_sequence: u64,
+        recv_sequences: &[ffi::AccountSequence],
+        auth_sequences: &[ffi::AccountSequence],
+    ) -> Result<(), ChainError> {
+        let _ffi = crate::ffi_timed!("flush_sequence_counters");
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
-            .next_global_sequence()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .flush_sequence_counters(global_action_sequence, recv_sequences, auth_sequences)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn db_remove_i64(
@@ -697,12 +1243,22 @@ impl Database {
         iterator: i32,
         receiver: u64,
     ) -> Result<i64, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let _ffi = crate::ffi_timed!("db_remove_i64");
+        let obj = keyval_cache.get(iterator)? as *const KeyValueObject;
+        let obj = unsafe { &*obj };
+        let table_obj = keyval_cache.get_table(obj.get_table_id())? as *const TableObject;
+        let table_obj = unsafe { &*table_obj };
 
-        pinned
-            .db_remove_i64(keyval_cache.pin_mut(), iterator, receiver)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let delta = {
+            let mut guard = self.inner.write()?;
+            guard
+                .pin_mut()
+                .db_remove_i64_obj(obj, table_obj, receiver)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?
+        };
+
+        keyval_cache.remove(iterator)?;
+        Ok(delta)
     }
 
     pub fn db_idx64_remove(
@@ -711,12 +1267,20 @@ impl Database {
         iterator: i32,
         receiver: u64,
     ) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let obj = keyval_cache.get(iterator)? as *const Index64Object;
+        let obj = unsafe { &*obj };
+        let table_obj = keyval_cache.get_table(obj.get_table_id())? as *const TableObject;
+        let table_obj = unsafe { &*table_obj };
+
+        {
+            let mut guard = self.inner.write()?;
+            guard
+                .pin_mut()
+                .db_idx64_remove_obj(obj, table_obj, receiver)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
 
-        pinned
-            .db_idx64_remove(keyval_cache.pin_mut(), iterator, receiver)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        keyval_cache.remove(iterator)
     }
 
     pub fn db_idx64_find_secondary(
@@ -728,19 +1292,25 @@ impl Database {
         secondary_key: u64,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let _ffi = crate::ffi_timed!("db_idx64_find_secondary");
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx64_find_secondary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx64_find_secondary_obj(tab, secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx64_find_primary(
@@ -752,19 +1322,24 @@ impl Database {
         secondary: &mut u64,
         primary_key: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx64_find_primary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary,
-                primary_key,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx64_find_primary_obj(tab, primary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *secondary = obj.get_secondary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx64_lowerbound(
@@ -776,19 +1351,26 @@ impl Database {
         secondary_key: &mut u64,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let _ffi = crate::ffi_timed!("db_idx64_lowerbound");
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx64_lowerbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx64_lowerbound_obj(tab, *secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = obj.get_secondary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx64_upperbound(
@@ -800,19 +1382,25 @@ impl Database {
         secondary_key: &mut u64,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx64_upperbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx64_upperbound_obj(tab, *secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = obj.get_secondary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx64_end(
@@ -822,12 +1410,14 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx64_end(keyval_cache.pin_mut(), code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+
+        Ok(keyval_cache.cache_table(unsafe { &*tab }))
     }
 
     pub fn db_idx64_next(
@@ -836,12 +1426,23 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let _ffi = crate::ffi_timed!("db_idx64_next");
+        if iterator < -1 {
+            return Ok(-1); // cannot increment past end iterator of index
+        }
 
-        pinned
-            .db_idx64_next(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let guard = self.inner.read()?;
+        let obj = keyval_cache.get(iterator)? as *const Index64Object;
+        let obj = unsafe { &*obj };
+
+        let next = guard.db_idx64_next_obj(obj);
+        if next.is_null() {
+            return keyval_cache.get_end_iterator_by_table_id(obj.get_table_id());
+        }
+        let next = unsafe { &*next };
+
+        *primary = next.get_primary_key();
+        Ok(keyval_cache.add(next))
     }
 
     pub fn db_idx64_previous(
@@ -850,12 +1451,35 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx64_previous(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        if iterator < -1 {
+            // is end iterator
+            let tab = keyval_cache
+                .find_table_by_end_iterator(iterator)?
+                .ok_or_else(|| ChainError::InternalError("not a valid end iterator".to_string()))?
+                as *const TableObject;
+            let obj = guard.db_idx64_last_obj(unsafe { &*tab });
+            if obj.is_null() {
+                return Ok(-1); // Empty index
+            }
+            let obj = unsafe { &*obj };
+
+            *primary = obj.get_primary_key();
+            return Ok(keyval_cache.add(obj));
+        }
+
+        let obj = keyval_cache.get(iterator)? as *const Index64Object;
+        let obj = unsafe { &*obj };
+
+        let prev = guard.db_idx64_previous_obj(obj);
+        if prev.is_null() {
+            return Ok(-1); // cannot decrement past beginning iterator of index
+        }
+        let prev = unsafe { &*prev };
+
+        *primary = prev.get_primary_key();
+        Ok(keyval_cache.add(prev))
     }
 
     pub fn create_index128_object(
@@ -870,7 +1494,7 @@ impl Database {
 
         let res = pinned
             .create_index128_object(table, payer, id, secondary_key.into())
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
         Ok(res as *const Index128Object)
     }
 
@@ -885,7 +1509,7 @@ impl Database {
 
         pinned
             .update_index128_object(obj, payer, secondary_key.into())
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn db_idx128_remove(
@@ -894,12 +1518,20 @@ impl Database {
         iterator: i32,
         receiver: u64,
     ) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let obj = keyval_cache.get(iterator)? as *const Index128Object;
+        let obj = unsafe { &*obj };
+        let table_obj = keyval_cache.get_table(obj.get_table_id())? as *const TableObject;
+        let table_obj = unsafe { &*table_obj };
+
+        {
+            let mut guard = self.inner.write()?;
+            guard
+                .pin_mut()
+                .db_idx128_remove_obj(obj, table_obj, receiver)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
 
-        pinned
-            .db_idx128_remove(keyval_cache.pin_mut(), iterator, receiver)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        keyval_cache.remove(iterator)
     }
 
     pub fn db_idx128_find_secondary(
@@ -911,21 +1543,24 @@ impl Database {
         secondary_key: u128,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let secondary_key_u128: U128 = secondary_key.into();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx128_find_secondary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key_u128,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx128_find_secondary_obj(tab, secondary_key.into());
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx128_find_primary(
@@ -937,21 +1572,24 @@ impl Database {
         secondary: &mut u128,
         primary_key: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let mut secondary_u128: U128 = (*secondary).into();
-        let res = pinned
-            .db_idx128_find_primary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                &mut secondary_u128,
-                primary_key,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        *secondary = secondary_u128.into();
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx128_find_primary_obj(tab, primary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *secondary = ffi::index128_object_secondary_key_as_u128(obj).into();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx128_lowerbound(
@@ -963,22 +1601,25 @@ impl Database {
         secondary_key: &mut u128,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let mut secondary_key_u128: U128 = (*secondary_key).into();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx128_lowerbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                &mut secondary_key_u128,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        *secondary_key = secondary_key_u128.into();
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx128_lowerbound_obj(tab, (*secondary_key).into());
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index128_object_secondary_key_as_u128(obj).into();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx128_upperbound(
@@ -990,21 +1631,25 @@ impl Database {
         secondary_key: &mut u128,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let mut secondary_key_u128: U128 = (*secondary_key).into();
-        let res = pinned
-            .db_idx128_upperbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                &mut secondary_key_u128,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        *secondary_key = secondary_key_u128.into();
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx128_upperbound_obj(tab, (*secondary_key).into());
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index128_object_secondary_key_as_u128(obj).into();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx128_end(
@@ -1014,12 +1659,14 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx128_end(keyval_cache.pin_mut(), code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+
+        Ok(keyval_cache.cache_table(unsafe { &*tab }))
     }
 
     pub fn db_idx128_next(
@@ -1028,12 +1675,22 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        if iterator < -1 {
+            return Ok(-1); // cannot increment past end iterator of index
+        }
 
-        pinned
-            .db_idx128_next(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let guard = self.inner.read()?;
+        let obj = keyval_cache.get(iterator)? as *const Index128Object;
+        let obj = unsafe { &*obj };
+
+        let next = guard.db_idx128_next_obj(obj);
+        if next.is_null() {
+            return keyval_cache.get_end_iterator_by_table_id(obj.get_table_id());
+        }
+        let next = unsafe { &*next };
+
+        *primary = next.get_primary_key();
+        Ok(keyval_cache.add(next))
     }
 
     pub fn db_idx128_previous(
@@ -1042,12 +1699,35 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx128_previous(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        if iterator < -1 {
+            // is end iterator
+            let tab = keyval_cache
+                .find_table_by_end_iterator(iterator)?
+                .ok_or_else(|| ChainError::InternalError("not a valid end iterator".to_string()))?
+                as *const TableObject;
+            let obj = guard.db_idx128_last_obj(unsafe { &*tab });
+            if obj.is_null() {
+                return Ok(-1); // Empty index
+            }
+            let obj = unsafe { &*obj };
+
+            *primary = obj.get_primary_key();
+            return Ok(keyval_cache.add(obj));
+        }
+
+        let obj = keyval_cache.get(iterator)? as *const Index128Object;
+        let obj = unsafe { &*obj };
+
+        let prev = guard.db_idx128_previous_obj(obj);
+        if prev.is_null() {
+            return Ok(-1); // cannot decrement past beginning iterator of index
+        }
+        let prev = unsafe { &*prev };
+
+        *primary = prev.get_primary_key();
+        Ok(keyval_cache.add(prev))
     }
 
     pub fn create_index256_object(
@@ -1062,7 +1742,7 @@ impl Database {
 
         let res = pinned
             .create_index256_object(table, payer, id, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
         Ok(res as *const Index256Object)
     }
 
@@ -1077,7 +1757,7 @@ impl Database {
 
         pinned
             .update_index256_object(obj, payer, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn db_idx256_remove(
@@ -1086,12 +1766,20 @@ impl Database {
         iterator: i32,
         receiver: u64,
     ) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let obj = keyval_cache.get(iterator)? as *const Index256Object;
+        let obj = unsafe { &*obj };
+        let table_obj = keyval_cache.get_table(obj.get_table_id())? as *const TableObject;
+        let table_obj = unsafe { &*table_obj };
+
+        {
+            let mut guard = self.inner.write()?;
+            guard
+                .pin_mut()
+                .db_idx256_remove_obj(obj, table_obj, receiver)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
 
-        pinned
-            .db_idx256_remove(keyval_cache.pin_mut(), iterator, receiver)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        keyval_cache.remove(iterator)
     }
 
     pub fn db_idx256_find_secondary(
@@ -1103,20 +1791,24 @@ impl Database {
         secondary_key: U256,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx256_find_secondary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx256_find_secondary_obj(tab, secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx256_find_primary(
@@ -1128,19 +1820,24 @@ impl Database {
         secondary: &mut U256,
         primary_key: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let res = pinned
-            .db_idx256_find_primary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary,
-                primary_key,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx256_find_primary_obj(tab, primary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *secondary = ffi::index256_object_secondary_key_as_u256(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx256_lowerbound(
@@ -1152,20 +1849,30 @@ impl Database {
         secondary_key: &mut U256,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx256_lowerbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx256_lowerbound_obj(
+            tab,
+            U256 {
+                value: secondary_key.value,
+            },
+        );
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index256_object_secondary_key_as_u256(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx256_upperbound(
@@ -1177,19 +1884,30 @@ impl Database {
         secondary_key: &mut U256,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let res = pinned
-            .db_idx256_upperbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx256_upperbound_obj(
+            tab,
+            U256 {
+                value: secondary_key.value,
+            },
+        );
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index256_object_secondary_key_as_u256(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx256_end(
@@ -1199,12 +1917,14 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx256_end(keyval_cache.pin_mut(), code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+
+        Ok(keyval_cache.cache_table(unsafe { &*tab }))
     }
 
     pub fn db_idx256_next(
@@ -1213,12 +1933,22 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        if iterator < -1 {
+            return Ok(-1); // cannot increment past end iterator of index
+        }
 
-        pinned
-            .db_idx256_next(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let guard = self.inner.read()?;
+        let obj = keyval_cache.get(iterator)? as *const Index256Object;
+        let obj = unsafe { &*obj };
+
+        let next = guard.db_idx256_next_obj(obj);
+        if next.is_null() {
+            return keyval_cache.get_end_iterator_by_table_id(obj.get_table_id());
+        }
+        let next = unsafe { &*next };
+
+        *primary = next.get_primary_key();
+        Ok(keyval_cache.add(next))
     }
 
     pub fn db_idx256_previous(
@@ -1227,12 +1957,35 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx256_previous(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        if iterator < -1 {
+            // is end iterator
+            let tab = keyval_cache
+                .find_table_by_end_iterator(iterator)?
+                .ok_or_else(|| ChainError::InternalError("not a valid end iterator".to_string()))?
+                as *const TableObject;
+            let obj = guard.db_idx256_last_obj(unsafe { &*tab });
+            if obj.is_null() {
+                return Ok(-1); // Empty index
+            }
+            let obj = unsafe { &*obj };
+
+            *primary = obj.get_primary_key();
+            return Ok(keyval_cache.add(obj));
+        }
+
+        let obj = keyval_cache.get(iterator)? as *const Index256Object;
+        let obj = unsafe { &*obj };
+
+        let prev = guard.db_idx256_previous_obj(obj);
+        if prev.is_null() {
+            return Ok(-1); // cannot decrement past beginning iterator of index
+        }
+        let prev = unsafe { &*prev };
+
+        *primary = prev.get_primary_key();
+        Ok(keyval_cache.add(prev))
     }
 
     pub fn create_idx_double_object(
@@ -1247,7 +2000,7 @@ impl Database {
 
         let res = pinned
             .create_idx_double_object(table, payer, id, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
         Ok(res as *const IndexDoubleObject)
     }
 
@@ -1262,7 +2015,7 @@ impl Database {
 
         pinned
             .update_idx_double_object(obj, payer, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn db_idx_double_remove(
@@ -1271,12 +2024,20 @@ impl Database {
         iterator: i32,
         receiver: u64,
     ) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let obj = keyval_cache.get(iterator)? as *const IndexDoubleObject;
+        let obj = unsafe { &*obj };
+        let table_obj = keyval_cache.get_table(obj.get_table_id())? as *const TableObject;
+        let table_obj = unsafe { &*table_obj };
+
+        {
+            let mut guard = self.inner.write()?;
+            guard
+                .pin_mut()
+                .db_idx_double_remove_obj(obj, table_obj, receiver)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
 
-        pinned
-            .db_idx_double_remove(keyval_cache.pin_mut(), iterator, receiver)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        keyval_cache.remove(iterator)
     }
 
     pub fn db_idx_double_find_secondary(
@@ -1288,20 +2049,24 @@ impl Database {
         secondary_key: u64,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx_double_find_secondary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_double_find_secondary_obj(tab, secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_double_find_primary(
@@ -1313,19 +2078,24 @@ impl Database {
         secondary: &mut u64,
         primary_key: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let res = pinned
-            .db_idx_double_find_primary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary,
-                primary_key,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_double_find_primary_obj(tab, primary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *secondary = ffi::index_double_object_secondary_key_bits(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_double_lowerbound(
@@ -1337,20 +2107,25 @@ impl Database {
         secondary_key: &mut u64,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx_double_lowerbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_double_lowerbound_obj(tab, *secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index_double_object_secondary_key_bits(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_double_upperbound(
@@ -1362,19 +2137,25 @@ impl Database {
         secondary_key: &mut u64,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let res = pinned
-            .db_idx_double_upperbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_double_upperbound_obj(tab, *secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index_double_object_secondary_key_bits(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_double_end(
@@ -1384,12 +2165,14 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx_double_end(keyval_cache.pin_mut(), code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+
+        Ok(keyval_cache.cache_table(unsafe { &*tab }))
     }
 
     pub fn db_idx_double_next(
@@ -1398,12 +2181,22 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        if iterator < -1 {
+            return Ok(-1); // cannot increment past end iterator of index
+        }
 
-        pinned
-            .db_idx_double_next(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let guard = self.inner.read()?;
+        let obj = keyval_cache.get(iterator)? as *const IndexDoubleObject;
+        let obj = unsafe { &*obj };
+
+        let next = guard.db_idx_double_next_obj(obj);
+        if next.is_null() {
+            return keyval_cache.get_end_iterator_by_table_id(obj.get_table_id());
+        }
+        let next = unsafe { &*next };
+
+        *primary = next.get_primary_key();
+        Ok(keyval_cache.add(next))
     }
 
     pub fn db_idx_double_previous(
@@ -1412,12 +2205,35 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx_double_previous(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        if iterator < -1 {
+            // is end iterator
+            let tab = keyval_cache
+                .find_table_by_end_iterator(iterator)?
+                .ok_or_else(|| ChainError::InternalError("not a valid end iterator".to_string()))?
+                as *const TableObject;
+            let obj = guard.db_idx_double_last_obj(unsafe { &*tab });
+            if obj.is_null() {
+                return Ok(-1); // Empty index
+            }
+            let obj = unsafe { &*obj };
+
+            *primary = obj.get_primary_key();
+            return Ok(keyval_cache.add(obj));
+        }
+
+        let obj = keyval_cache.get(iterator)? as *const IndexDoubleObject;
+        let obj = unsafe { &*obj };
+
+        let prev = guard.db_idx_double_previous_obj(obj);
+        if prev.is_null() {
+            return Ok(-1); // cannot decrement past beginning iterator of index
+        }
+        let prev = unsafe { &*prev };
+
+        *primary = prev.get_primary_key();
+        Ok(keyval_cache.add(prev))
     }
 
     pub fn create_idx_long_double_object(
@@ -1432,7 +2248,7 @@ impl Database {
 
         let res = pinned
             .create_idx_long_double_object(table, payer, id, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
         Ok(res as *const IndexLongDoubleObject)
     }
 
@@ -1447,7 +2263,7 @@ impl Database {
 
         pinned
             .update_idx_long_double_object(obj, payer, secondary_key)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn db_idx_long_double_remove(
@@ -1456,12 +2272,20 @@ impl Database {
         iterator: i32,
         receiver: u64,
     ) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let obj = keyval_cache.get(iterator)? as *const IndexLongDoubleObject;
+        let obj = unsafe { &*obj };
+        let table_obj = keyval_cache.get_table(obj.get_table_id())? as *const TableObject;
+        let table_obj = unsafe { &*table_obj };
+
+        {
+            let mut guard = self.inner.write()?;
+            guard
+                .pin_mut()
+                .db_idx_long_double_remove_obj(obj, table_obj, receiver)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
 
-        pinned
-            .db_idx_long_double_remove(keyval_cache.pin_mut(), iterator, receiver)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        keyval_cache.remove(iterator)
     }
 
     pub fn db_idx_long_double_find_secondary(
@@ -1473,20 +2297,24 @@ impl Database {
         secondary_key: Float128,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx_long_double_find_secondary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_long_double_find_secondary_obj(tab, secondary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_long_double_find_primary(
@@ -1498,19 +2326,24 @@ impl Database {
         secondary: &mut Float128,
         primary_key: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let res = pinned
-            .db_idx_long_double_find_primary(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary,
-                primary_key,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_long_double_find_primary_obj(tab, primary_key);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *secondary = ffi::index_long_double_object_secondary_key(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_long_double_lowerbound(
@@ -1522,20 +2355,31 @@ impl Database {
         secondary_key: &mut Float128,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        let res = pinned
-            .db_idx_long_double_lowerbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_long_double_lowerbound_obj(
+            tab,
+            Float128 {
+                lo: secondary_key.lo,
+                hi: secondary_key.hi,
+            },
+        );
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index_long_double_object_secondary_key(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_long_double_upperbound(
@@ -1547,19 +2391,31 @@ impl Database {
         secondary_key: &mut Float128,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-        let res = pinned
-            .db_idx_long_double_upperbound(
-                keyval_cache.pin_mut(),
-                code,
-                scope,
-                table,
-                secondary_key,
-                primary,
-            )
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-        Ok(res)
+        let guard = self.inner.read()?;
+
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_idx_long_double_upperbound_obj(
+            tab,
+            Float128 {
+                lo: secondary_key.lo,
+                hi: secondary_key.hi,
+            },
+        );
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+        let obj = unsafe { &*obj };
+
+        *primary = obj.get_primary_key();
+        *secondary_key = ffi::index_long_double_object_secondary_key(obj);
+        Ok(keyval_cache.add(obj))
     }
 
     pub fn db_idx_long_double_end(
@@ -1569,12 +2425,14 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx_long_double_end(keyval_cache.pin_mut(), code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+
+        Ok(keyval_cache.cache_table(unsafe { &*tab }))
     }
 
     pub fn db_idx_long_double_next(
@@ -1583,12 +2441,22 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        if iterator < -1 {
+            return Ok(-1); // cannot increment past end iterator of index
+        }
 
-        pinned
-            .db_idx_long_double_next(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let guard = self.inner.read()?;
+        let obj = keyval_cache.get(iterator)? as *const IndexLongDoubleObject;
+        let obj = unsafe { &*obj };
+
+        let next = guard.db_idx_long_double_next_obj(obj);
+        if next.is_null() {
+            return keyval_cache.get_end_iterator_by_table_id(obj.get_table_id());
+        }
+        let next = unsafe { &*next };
+
+        *primary = next.get_primary_key();
+        Ok(keyval_cache.add(next))
     }
 
     pub fn db_idx_long_double_previous(
@@ -1597,12 +2465,35 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_idx_long_double_previous(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        if iterator < -1 {
+            // is end iterator
+            let tab = keyval_cache
+                .find_table_by_end_iterator(iterator)?
+                .ok_or_else(|| ChainError::InternalError("not a valid end iterator".to_string()))?
+                as *const TableObject;
+            let obj = guard.db_idx_long_double_last_obj(unsafe { &*tab });
+            if obj.is_null() {
+                return Ok(-1); // Empty index
+            }
+            let obj = unsafe { &*obj };
+
+            *primary = obj.get_primary_key();
+            return Ok(keyval_cache.add(obj));
+        }
+
+        let obj = keyval_cache.get(iterator)? as *const IndexLongDoubleObject;
+        let obj = unsafe { &*obj };
+
+        let prev = guard.db_idx_long_double_previous_obj(obj);
+        if prev.is_null() {
+            return Ok(-1); // cannot decrement past beginning iterator of index
+        }
+        let prev = unsafe { &*prev };
+
+        *primary = prev.get_primary_key();
+        Ok(keyval_cache.add(prev))
     }
 
     pub fn db_next_i64(
@@ -1611,12 +2502,73 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        if iterator < -1 {
+            return Ok(-1); // cannot increment past end iterator of table
+        }
 
-        pinned
-            .db_next_i64(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let guard = self.inner.read()?;
+        let obj = keyval_cache.get(iterator)? as *const KeyValueObject;
+        let obj = unsafe { &*obj };
+
+        let next = guard.db_next_i64_obj(obj);
+        if next.is_null() {
+            return keyval_cache.get_end_iterator_by_table_id(obj.get_table_id());
+        }
+        let next = unsafe { &*next };
+
+        *primary = next.get_primary_key();
+        Ok(keyval_cache.add(next))
+    }
+
+    // Batched variant of db_next_i64: advances up to `iterators.len()` times
+    // under a single database lock and returns how many slots were filled. The
+    // last filled slot holds the terminating end iterator (or -1) when the
+    // table is exhausted within the batch. The whole window is walked by one
+    // C++ call that prefetches tree nodes ahead of the collection point,
+    // instead of one successor chase per bridge crossing.
+    pub fn db_next_i64_batch(
+        &mut self,
+        keyval_cache: &mut KeyValueIteratorCache,
+        iterator: i32,
+        iterators: &mut [i32],
+        primaries: &mut [u64],
+    ) -> Result<usize, ChainError> {
+        if iterators.is_empty() {
+            return Ok(0);
+        }
+        if iterator < -1 {
+            iterators[0] = -1;
+            return Ok(1);
+        }
+
+        let guard = self.inner.read()?;
+        let obj = keyval_cache.get(iterator)? as *const KeyValueObject;
+        let obj = unsafe { &*obj };
+
+        let window = iterators.len().min(primaries.len());
+        let mut rows = vec![0usize; window];
+        let filled = guard.db_next_i64_window(obj, &mut primaries[..window], &mut rows);
+
+        for i in 0..filled {
+            // Addresses come straight out of the index walk above; the rows
+            // stay pinned for as long as the iterator cache may hand them out.
+            let row = unsafe { &*(rows[i] as *const KeyValueObject) };
+            iterators[i] = keyval_cache.add(row);
+        }
+
+        if filled < window {
+            // Window ran off the table: terminate with the end iterator, as
+            // the single-step path does.
+            let last = if filled == 0 {
+                obj
+            } else {
+                unsafe { &*(rows[filled - 1] as *const KeyValueObject) }
+            };
+            iterators[filled] = keyval_cache.get_end_iterator_by_table_id(last.get_table_id())?;
+            return Ok(filled + 1);
+        }
+
+        Ok(filled)
     }
 
     pub fn db_previous_i64(
@@ -1625,12 +2577,35 @@ impl Database {
         iterator: i32,
         primary: &mut u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_previous_i64(keyval_cache.pin_mut(), iterator, primary)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        if iterator < -1 {
+            // is end iterator
+            let tab = keyval_cache
+                .find_table_by_end_iterator(iterator)?
+                .ok_or_else(|| ChainError::InternalError("not a valid end iterator".to_string()))?
+                as *const TableObject;
+            let obj = guard.db_last_i64_obj(unsafe { &*tab });
+            if obj.is_null() {
+                return Ok(-1); // Empty table
+            }
+            let obj = unsafe { &*obj };
+
+            *primary = obj.get_primary_key();
+            return Ok(keyval_cache.add(obj));
+        }
+
+        let obj = keyval_cache.get(iterator)? as *const KeyValueObject;
+        let obj = unsafe { &*obj };
+
+        let prev = guard.db_previous_i64_obj(obj);
+        if prev.is_null() {
+            return Ok(-1); // cannot decrement past beginning iterator of table
+        }
+        let prev = unsafe { &*prev };
+
+        *primary = prev.get_primary_key();
+        Ok(keyval_cache.add(prev))
     }
 
     pub fn db_end_i64(
@@ -1640,12 +2615,14 @@ impl Database {
         scope: u64,
         table: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_end_i64(keyval_cache.pin_mut(), code, scope, table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+
+        Ok(keyval_cache.cache_table(unsafe { &*tab }))
     }
 
     pub fn db_lowerbound_i64(
@@ -1656,12 +2633,22 @@ impl Database {
         table: u64,
         id: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_lowerbound_i64(keyval_cache.pin_mut(), code, scope, table, id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_lowerbound_i64_obj(tab, id);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+
+        Ok(keyval_cache.add(unsafe { &*obj }))
     }
 
     pub fn db_upperbound_i64(
@@ -1672,24 +2659,43 @@ impl Database {
         table: u64,
         id: u64,
     ) -> Result<i32, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
+        let guard = self.inner.read()?;
 
-        pinned
-            .db_upperbound_i64(keyval_cache.pin_mut(), code, scope, table, id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let tab = self.resolve_table(&guard, code, scope, table)?;
+        if tab.is_null() {
+            return Ok(-1);
+        }
+        let tab = unsafe { &*tab };
+
+        let table_end_itr = keyval_cache.cache_table(tab);
+
+        let obj = guard.db_upperbound_i64_obj(tab, id);
+        if obj.is_null() {
+            return Ok(table_end_itr);
+        }
+
+        Ok(keyval_cache.add(unsafe { &*obj }))
     }
 
     pub fn remove_permission(
         &mut self,
         permission: &ffi::PermissionObject,
     ) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .remove_permission(permission)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let owner = permission.get_owner().to_uint64_t();
+        let name = permission.get_name().to_uint64_t();
+        let old_authority = permission.get_authority().to_authority();
+        {
+            let mut guard = self.inner.write()?;
+            let pinned = guard.pin_mut();
+
+            pinned
+                .remove_permission(permission)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
+        if let Some(mirror) = self.key_permissions.write()?.as_mut() {
+            mirror.remove_authority(owner, name, &old_authority);
+        }
+        Ok(())
     }
 
     pub fn create_permission(
@@ -1700,12 +2706,17 @@ impl Database {
         auth: &Authority,
         creation_time: &TimePoint,
     ) -> Result<*const ffi::PermissionObject, ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        let res = pinned
-            .create_permission(account, name, parent, auth, creation_time)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+        let res = {
+            let mut guard = self.inner.write()?;
+            let pinned = guard.pin_mut();
+
+            pinned
+                .create_permission(account, name, parent, auth, creation_time)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?
+        };
+        if let Some(mirror) = self.key_permissions.write()?.as_mut() {
+            mirror.insert_authority(account, name, auth);
+        }
 
         Ok(res as *const ffi::PermissionObject)
     }
@@ -1718,7 +2729,7 @@ impl Database {
         let guard = self.inner.read()?;
         let res = guard
             .permission_satisfies_other_permission(permission, other_permission)
-            .map_err(|e| ChainError::TransactionError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(res)
     }
@@ -1729,12 +2740,24 @@ impl Database {
         authority: &Authority,
         pending_block_time: &TimePoint,
     ) -> Result<(), ChainError> {
-        let mut guard = self.inner.write()?;
-        let pinned = guard.pin_mut();
-
-        pinned
-            .modify_permission(permission, authority, pending_block_time)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        // The old authority must be captured before the in-place modify so
+        // the rows it contributed to the key mirror can be retired.
+        let owner = permission.get_owner().to_uint64_t();
+        let name = permission.get_name().to_uint64_t();
+        let old_authority = permission.get_authority().to_authority();
+        {
+            let mut guard = self.inner.write()?;
+            let pinned = guard.pin_mut();
+
+            pinned
+                .modify_permission(permission, authority, pending_block_time)
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        }
+        if let Some(mirror) = self.key_permissions.write()?.as_mut() {
+            mirror.remove_authority(owner, name, &old_authority);
+            mirror.insert_authority(owner, name, authority);
+        }
+        Ok(())
     }
 
     pub fn update_permission_usage(
@@ -1747,7 +2770,7 @@ impl Database {
 
         pinned
             .update_permission_usage(permission, pending_block_time)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_permission_last_used(
@@ -1757,34 +2780,93 @@ impl Database {
         let guard = self.inner.read()?;
         let res = guard
             .get_permission_last_used(permission)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(res)
     }
 
+    /// Serves from the flat link mirror — two binary searches over
+    /// contiguous arrays, no FFI — rebuilding it from the chainbase index
+    /// when it was dropped by an unwind (or never built).
     pub fn lookup_linked_permission(
         &self,
         account: u64,
         code: u64,
         requirement_type: u64,
     ) -> Result<Option<u64>, ChainError> {
-        let guard = self.inner.read()?;
-        let res = guard
-            .lookup_linked_permission(account, code, requirement_type)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+        {
+            let links = self.permission_links.read()?;
+            if let Some(mirror) = links.as_ref() {
+                return Ok(mirror.lookup(account, code, requirement_type));
+            }
+        }
 
-        if res.is_null() {
-            return Ok(None);
+        let rows = {
+            let guard = self.inner.read()?;
+            guard
+                .collect_permission_links()
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?
+        };
+        let mirror = PermissionLinkMirror::from_rows(rows);
+        let result = mirror.lookup(account, code, requirement_type);
+        *self.permission_links.write()? = Some(mirror);
+        Ok(result)
+    }
+
+    /// Drops the permission link mirror so the next lookup rebuilds it from
+    /// chainbase. Must be called whenever an undo session unwinds, which can
+    /// revert link changes without going through `link_auth`/`unlink_auth`.
+    pub fn clear_permission_link_mirror(&self) -> Result<(), ChainError> {
+        *self.permission_links.write()? = None;
+        Ok(())
+    }
+
+    /// Answers "is `key` a direct factor of permission (owner, name), and
+    /// does its weight meet the threshold alone?" from the key→permission
+    /// reverse index — one hash probe, no FFI — rebuilding the index from
+    /// the permission table when it was dropped by an unwind (or never
+    /// built). `key` is the packed public key bytes. `None` only means the
+    /// key is not a direct factor; nested account factors may still satisfy
+    /// the permission, so callers fall back to the full authority walk.
+    pub fn key_satisfies_permission_alone(
+        &self,
+        key: &[u8],
+        owner: u64,
+        name: u64,
+    ) -> Result<Option<bool>, ChainError> {
+        {
+            let mirror = self.key_permissions.read()?;
+            if let Some(mirror) = mirror.as_ref() {
+                return Ok(mirror.lookup(key, owner, name));
+            }
         }
 
-        Ok(Some(unsafe { &*res }.to_uint64_t()))
+        let rows = {
+            let guard = self.inner.read()?;
+            guard
+                .collect_permission_authority_keys()
+                .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?
+        };
+        let mirror = KeyPermissionMirror::from_rows(rows);
+        let result = mirror.lookup(key, owner, name);
+        *self.key_permissions.write()? = Some(mirror);
+        Ok(result)
+    }
+
+    /// Drops the key→permission reverse index so the next lookup rebuilds
+    /// it from chainbase. Must be called whenever an undo session unwinds,
+    /// which can revert permission changes without going through the
+    /// mutation wrappers above.
+    pub fn clear_key_permission_mirror(&self) -> Result<(), ChainError> {
+        *self.key_permissions.write()? = None;
+        Ok(())
     }
 
     pub fn get_global_properties(&self) -> Result<*const ffi::GlobalPropertyObject, ChainError> {
         let guard = self.inner.read()?;
         let res = guard
             .get_global_properties()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(res)
     }
@@ -1795,7 +2877,7 @@ impl Database {
 
         pinned
             .set_global_properties(cfg)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
 
         Ok(())
     }
@@ -1804,28 +2886,28 @@ impl Database {
         let guard = self.inner.read()?;
         guard
             .get_virtual_block_cpu_limit()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_virtual_block_net_limit(&self) -> Result<u64, ChainError> {
         let guard = self.inner.read()?;
         guard
             .get_virtual_block_net_limit()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_block_cpu_limit(&self) -> Result<u64, ChainError> {
         let guard = self.inner.read()?;
         guard
             .get_block_cpu_limit()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_block_net_limit(&self) -> Result<u64, ChainError> {
         let guard = self.inner.read()?;
         guard
             .get_block_net_limit()
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn is_known_unexpired_transaction(
@@ -1836,7 +2918,7 @@ impl Database {
 
         guard
             .is_known_unexpired_transaction(trx_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn record_transaction(
@@ -1849,19 +2931,20 @@ impl Database {
 
         pinned
             .record_transaction(trx_id, expiration)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn clear_expired_input_transactions(
         &mut self,
         cutoff: &TimePoint,
-    ) -> Result<(), ChainError> {
+        max_removals: u32,
+    ) -> Result<u32, ChainError> {
         let mut guard = self.inner.write()?;
         let pinned = guard.pin_mut();
 
         pinned
-            .clear_expired_input_transactions(cutoff)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .clear_expired_input_transactions(cutoff, max_removals)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_currency_balance_with_symbol(
@@ -1873,7 +2956,7 @@ impl Database {
         let guard = self.inner.read()?;
 
         get_currency_balance_with_symbol(guard.as_ref().unwrap(), code, account, symbol)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_currency_balance_without_symbol(
@@ -1884,14 +2967,31 @@ impl Database {
         let guard = self.inner.read()?;
 
         get_currency_balance_without_symbol(guard.as_ref().unwrap(), code, account)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_currency_stats(&self, code: u64, symbol: &str) -> Result<String, ChainError> {
         let guard = self.inner.read()?;
 
         get_currency_stats(guard.as_ref().unwrap(), code, symbol)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Per-index allocator pool occupancy plus free segment memory, as JSON.
+    pub fn get_db_allocation_stats(&self) -> Result<String, ChainError> {
+        let guard = self.inner.read()?;
+
+        get_db_allocation_stats(guard.as_ref().unwrap())
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Per-index wall time of the most recent chainbase commit, heaviest
+    /// index first, as JSON. Empty until a block has committed.
+    pub fn get_db_commit_stats(&self) -> Result<String, ChainError> {
+        let guard = self.inner.read()?;
+
+        get_db_commit_stats(guard.as_ref().unwrap())
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_table_by_scope(
@@ -1914,7 +3014,24 @@ impl Database {
             limit,
             reverse,
         )
-        .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Row counts for the table a `get_table_rows` query would walk,
+    /// serialized as JSON (`exists`, `row_count`, `index_row_count`). Two
+    /// O(log n) lookups at most, so the RPC layer can consult it before
+    /// committing to a scan.
+    pub fn get_table_stats(
+        &self,
+        code: u64,
+        scope: &str,
+        table: u64,
+        index_position: &str,
+    ) -> Result<String, ChainError> {
+        let guard = self.inner.read()?;
+
+        get_table_stats(guard.as_ref().unwrap(), code, scope, table, index_position)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_table_rows(
@@ -1951,7 +3068,35 @@ impl Database {
             reverse,
             show_payer,
         )
-        .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Raw-row page of a primary-index table scan. Rows come back as one
+    /// length-prefixed blob plus the stored ABI's hash; the serializer is
+    /// never touched server-side.
+    pub fn get_table_rows_binary(
+        &self,
+        code: u64,
+        scope: &str,
+        table: u64,
+        lower_bound: &str,
+        upper_bound: &str,
+        limit: u32,
+        reverse: bool,
+    ) -> Result<ffi::TableRowsBinaryResult, ChainError> {
+        let guard = self.inner.read()?;
+
+        get_table_rows_binary(
+            guard.as_ref().unwrap(),
+            code,
+            scope,
+            table,
+            lower_bound,
+            upper_bound,
+            limit,
+            reverse,
+        )
+        .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_account_info_without_core_symbol(
@@ -1968,7 +3113,7 @@ impl Database {
             head_block_num,
             head_block_time,
         )
-        .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn get_account_info_with_core_symbol(
@@ -1987,7 +3132,7 @@ impl Database {
             head_block_num,
             head_block_time,
         )
-        .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
     }
 
     pub fn pack_deltas(&self, full_snapshot: bool) -> Result<Vec<u8>, ChainError> {
@@ -1995,7 +3140,54 @@ impl Database {
 
         guard
             .pack_deltas(full_snapshot)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+}
+
+/// Live bulk-load mode on a [`Database`]; see [`Database::bulk_load_session`].
+/// Rows must arrive sorted by ascending primary key within a table, and
+/// tables in creation order, so every insert lands at the end of the global
+/// index ordering — the C++ side rejects out-of-order input.
+pub struct BulkLoadSession {
+    db: Database,
+}
+
+impl BulkLoadSession {
+    /// Appends `ids.len()` sorted rows to `(code, scope, table)`, creating
+    /// the table if needed; `values` concatenates the row payloads with
+    /// `value_sizes[i]` bytes for row i. Returns the RAM bytes the rows
+    /// bill to `payer`, for the importer's resource accounting.
+    pub fn store_sorted_rows(
+        &mut self,
+        code: u64,
+        scope: u64,
+        table: u64,
+        payer: u64,
+        ids: &[u64],
+        values: &[u8],
+        value_sizes: &[u64],
+    ) -> Result<i64, ChainError> {
+        self.db
+            .inner
+            .write()?
+            .pin_mut()
+            .bulk_load_store_sorted(code, scope, table, payer, ids, values, value_sizes)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))
+    }
+
+    /// Seals the import: leaves bulk-load mode and sets the database
+    /// revision so replay resumes after the imported state.
+    pub fn finish(self, revision: i64) -> Result<(), ChainError> {
+        self.db
+            .inner
+            .write()?
+            .pin_mut()
+            .bulk_load_end(revision)
+            .map_err(|e| crate::ffi_error::chain_error_from_ffi(e, ""))?;
+        // Tables created through the bulk path bypass the wrapper's
+        // negative-lookup bookkeeping; drop any stale absences.
+        self.db.clear_absent_table_cache()?;
+        Ok(())
     }
 }
 
@@ -2033,12 +3225,210 @@ mod tests {
             "0100076163636f756e7401010e00000000000090b1ca0000000000"
         );
     }
+
+    #[test]
+    fn test_permission_link_mirror() {
+        let dir = TempDir::new().unwrap();
+        let path = dir.path().to_str().unwrap();
+        let mut db = Database::new(path, 1 * 1024 * 1024 * 1024).unwrap();
+        db.add_indices().unwrap();
+        let account = string_to_name("alice").unwrap().to_uint64_t();
+        let code = string_to_name("token").unwrap().to_uint64_t();
+        // pulse.any links are accepted without a matching permission row,
+        // which keeps this test free of authority setup.
+        let any = string_to_name("pulse.any").unwrap().to_uint64_t();
+        let transfer = string_to_name("transfer").unwrap().to_uint64_t();
+        let issue = string_to_name("issue").unwrap().to_uint64_t();
+        db.create_account(account, 0).unwrap();
+        db.create_account(code, 0).unwrap();
+
+        // First lookup builds the mirror from an empty link index.
+        assert_eq!(
+            db.lookup_linked_permission(account, code, transfer)
+                .unwrap(),
+            None
+        );
+
+        // A specific link, and the contract-wide default (empty type).
+        db.link_auth(account, code, any, transfer).unwrap();
+        db.link_auth(account, code, any, 0).unwrap();
+        assert_eq!(
+            db.lookup_linked_permission(account, code, transfer)
+                .unwrap(),
+            Some(any)
+        );
+        assert_eq!(
+            db.lookup_linked_permission(account, code, issue).unwrap(),
+            Some(any)
+        );
+
+        // Unlinking the specific link falls back to the default.
+        db.unlink_auth(account, code, transfer).unwrap();
+        assert_eq!(
+            db.lookup_linked_permission(account, code, transfer)
+                .unwrap(),
+            Some(any)
+        );
+        db.unlink_auth(account, code, 0).unwrap();
+        assert_eq!(
+            db.lookup_linked_permission(account, code, transfer)
+                .unwrap(),
+            None
+        );
+
+        // A dropped mirror rebuilds from chainbase and agrees.
+        db.link_auth(account, code, any, transfer).unwrap();
+        db.clear_permission_link_mirror().unwrap();
+        assert!(db.permission_links.read().unwrap().is_none());
+        assert_eq!(
+            db.lookup_linked_permission(account, code, transfer)
+                .unwrap(),
+            Some(any)
+        );
+    }
+
+    #[test]
+    fn test_key_permission_mirror() {
+        let dir = TempDir::new().unwrap();
+        let path = dir.path().to_str().unwrap();
+        let mut db = Database::new(path, 1 * 1024 * 1024 * 1024).unwrap();
+        db.add_indices().unwrap();
+        let account = string_to_name("alice").unwrap().to_uint64_t();
+        let owner = string_to_name("owner").unwrap().to_uint64_t();
+        let active = string_to_name("active").unwrap().to_uint64_t();
+        db.create_account(account, 0).unwrap();
+
+        let key =
+            crate::parse_public_key("PUB_K1_5bbkxaLdB5bfVZW6DJY8M74vwT2m61PqwywNUa5azfkJTvYa5H")
+                .unwrap();
+        let packed = key.packed_bytes();
+        let single = Authority::new(
+            1,
+            vec![crate::KeyWeight::new(key.clone(), 1)],
+            vec![],
+            vec![],
+        );
+
+        // First lookup builds the mirror from an empty permission table.
+        assert_eq!(
+            db.key_satisfies_permission_alone(&packed, account, owner)
+                .unwrap(),
+            None
+        );
+
+        // A single-key authority satisfies alone; the mirror tracks the
+        // create without a rebuild.
+        let owner_perm = db
+            .create_permission(account, owner, 0, &single, &TimePoint::default())
+            .unwrap();
+        assert_eq!(
+            db.key_satisfies_permission_alone(&packed, account, owner)
+                .unwrap(),
+            Some(true)
+        );
+
+        // Raising the threshold past the key's weight flips the bit.
+        let underweight = Authority::new(
+            2,
+            vec![crate::KeyWeight::new(key.clone(), 1)],
+            vec![],
+            vec![],
+        );
+        db.modify_permission(unsafe { &*owner_perm }, &underweight, &TimePoint::default())
+            .unwrap();
+        assert_eq!(
+            db.key_satisfies_permission_alone(&packed, account, owner)
+                .unwrap(),
+            Some(false)
+        );
+
+        // Deleting the permission retires its rows.
+        let active_perm = db
+            .create_permission(account, active, 0, &single, &TimePoint::default())
+            .unwrap();
+        assert!(!active_perm.is_null());
+        db.delete_auth(account, active).unwrap();
+        assert_eq!(
+            db.key_satisfies_permission_alone(&packed, account, active)
+                .unwrap(),
+            None
+        );
+
+        // A dropped mirror rebuilds from chainbase and agrees.
+        db.clear_key_permission_mirror().unwrap();
+        assert!(db.key_permissions.read().unwrap().is_none());
+        assert_eq!(
+            db.key_satisfies_permission_alone(&packed, account, owner)
+                .unwrap(),
+            Some(false)
+        );
+    }
+
+    #[test]
+    fn test_absent_table_cache_invalidation() {
+        let dir = TempDir::new().unwrap();
+        let path = dir.path().to_str().unwrap();
+        let mut db = Database::new(path, 1 * 1024 * 1024 * 1024).unwrap();
+        db.add_indices().unwrap();
+        let code = string_to_name("test").unwrap().to_uint64_t();
+
+        // A miss is remembered...
+        assert!(db.find_table(code, 1, 2).unwrap().is_null());
+        assert!(db.absent_tables.read().unwrap().contains(&(code, 1, 2)));
+
+        // ...until the table materializes.
+        db.create_table(code, 1, 2, code).unwrap();
+        assert!(!db.find_table(code, 1, 2).unwrap().is_null());
+
+        // An unwind forgets everything remembered.
+        assert!(db.find_table(code, 3, 4).unwrap().is_null());
+        db.clear_absent_table_cache().unwrap();
+        assert!(db.absent_tables.read().unwrap().is_empty());
+    }
+
+    #[test]
+    fn test_resolved_table_cache() {
+        let dir = TempDir::new().unwrap();
+        let path = dir.path().to_str().unwrap();
+        let mut db = Database::new(path, 1 * 1024 * 1024 * 1024).unwrap();
+        db.add_indices().unwrap();
+        let code = string_to_name("test").unwrap().to_uint64_t();
+
+        // A create primes the cache; the next find is served from it.
+        let created = db.create_table(code, 1, 2, code).unwrap();
+        assert_eq!(
+            db.resolved_tables.read().unwrap().get(code, 1, 2),
+            Some(created)
+        );
+        assert_eq!(db.find_table(code, 1, 2).unwrap(), created);
+
+        // Removing the table evicts its entry eagerly.
+        db.remove_table(unsafe { &*created }).unwrap();
+        assert_eq!(db.resolved_tables.read().unwrap().get(code, 1, 2), None);
+        assert!(db.find_table(code, 1, 2).unwrap().is_null());
+
+        // An unwind retires entries by generation without sweeping them;
+        // a later resolution re-stamps the same triple.
+        db.clear_absent_table_cache().unwrap();
+        let recreated = db.create_table(code, 1, 2, code).unwrap();
+        db.clear_resolved_table_cache().unwrap();
+        assert_eq!(db.resolved_tables.read().unwrap().get(code, 1, 2), None);
+        assert_eq!(db.find_table(code, 1, 2).unwrap(), recreated);
+        assert_eq!(
+            db.resolved_tables.read().unwrap().get(code, 1, 2),
+            Some(recreated)
+        );
+    }
 }
 
 impl Default for Database {
     fn default() -> Self {
         Self {
             inner: Arc::new(RwLock::new(UniquePtr::null())),
+            absent_tables: Arc::new(RwLock::new(HashSet::new())),
+            resolved_tables: Arc::new(RwLock::new(ResolvedTableCache::new())),
+            permission_links: Arc::new(RwLock::new(None)),
+            key_permissions: Arc::new(RwLock::new(None)),
         }
     }
 }
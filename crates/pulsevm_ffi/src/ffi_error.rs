@@ -0,0 +1,90 @@
+//! Typed classification of C++ exceptions crossing the cxx bridge.
+//!
+//! `catcher.hpp` front-loads the numeric `fc::exception` code onto the
+//! message as `#<code># <text>`, so classification here is a prefix parse
+//! and an integer range match — no matching on human-readable message
+//! text, and no `format!` machinery on the paths that throw as part of
+//! normal operation (a RAM limit check failing during speculative
+//! execution is flow control, not a fault). Exceptions without the prefix
+//! (`std::exception`, foreign throws) fall through to `InternalError`
+//! exactly as before.
+
+use pulsevm_error::ChainError;
+
+/// Family bases from `pulsevm/chain/exceptions.hpp`; subcodes occupy the
+/// last three digits, so integer division by 1000 recovers the family.
+const TRANSACTION_FAMILY: u64 = 3040;
+const ACTION_VALIDATE_FAMILY: u64 = 3050;
+const DATABASE_FAMILY: u64 = 3060;
+const WASM_FAMILY: u64 = 3070;
+const RESOURCE_EXHAUSTED_FAMILY: u64 = 3080;
+const AUTHORIZATION_FAMILY: u64 = 3090;
+const ABI_FAMILY: u64 = 3015;
+
+const RAM_USAGE_EXCEEDED: u64 = 3080001;
+
+/// Splits the `#<code># ` prefix emitted by `catcher.hpp`, returning the
+/// code and the bare message, or `None` when the exception did not come
+/// from `fc`.
+fn split_code(message: &str) -> Option<(u64, &str)> {
+    let rest = message.strip_prefix('#')?;
+    let end = rest.find('#')?;
+    let code = rest[..end].parse::<u64>().ok()?;
+    Some((code, rest[end + 1..].trim_start()))
+}
+
+/// Returns the message with the `#<code># ` prefix removed, for callers
+/// outside this crate that surface a bridge error's text verbatim (key and
+/// signature parsing in `pulsevm_core`).
+pub fn strip_error_code(message: &str) -> &str {
+    split_code(message).map_or(message, |(_, text)| text)
+}
+
+/// Maps a bridge exception to a typed [`ChainError`]. `context` names the
+/// operation for the diagnostic variants; the typed variants carry only the
+/// C++ message, which already identifies account and amounts.
+pub(crate) fn chain_error_from_ffi(e: cxx::Exception, context: &str) -> ChainError {
+    let message = e.what();
+    let Some((code, text)) = split_code(message) else {
+        if context.is_empty() {
+            return ChainError::InternalError(message.to_string());
+        }
+        return ChainError::InternalError(format!("{}: {}", context, message));
+    };
+
+    if code == RAM_USAGE_EXCEEDED {
+        // Fires per over-limit account while building blocks under load;
+        // keep it to the one unavoidable allocation.
+        return ChainError::RamUsageExceeded(text.to_string());
+    }
+
+    let detail = if context.is_empty() {
+        text.to_string()
+    } else {
+        format!("{}: {}", context, text)
+    };
+    match code / 1000 {
+        TRANSACTION_FAMILY | RESOURCE_EXHAUSTED_FAMILY => ChainError::TransactionError(detail),
+        ACTION_VALIDATE_FAMILY => ChainError::ActionValidationError(detail),
+        DATABASE_FAMILY => ChainError::DatabaseError(detail),
+        WASM_FAMILY => ChainError::WasmRuntimeError(detail),
+        AUTHORIZATION_FAMILY => ChainError::AuthorizationError(detail),
+        ABI_FAMILY => ChainError::SerializationError(detail),
+        _ => ChainError::InternalError(detail),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::split_code;
+
+    #[test]
+    fn code_prefix_parses_and_strips() {
+        let (code, text) = split_code("#3080001# account alice has insufficient ram").unwrap();
+        assert_eq!(code, 3080001);
+        assert_eq!(text, "account alice has insufficient ram");
+
+        assert!(split_code("plain std::exception text").is_none());
+        assert!(split_code("#not-a-number# text").is_none());
+    }
+}
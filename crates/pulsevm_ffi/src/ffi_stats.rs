@@ -0,0 +1,221 @@
+use std::sync::{
+    LazyLock,
+    atomic::{AtomicBool, AtomicPtr, AtomicU64, Ordering},
+};
+
+/// Process-wide cycle accounting for time spent inside the C++ bridge.
+///
+/// Block time divides between wasm, Rust, and the chainbase FFI, and only
+/// the first two were visible to the existing collectors. Each instrumented
+/// wrapper in `database.rs` declares a static [`FfiSite`] through the
+/// `ffi_timed!` macro; sites register themselves on a lock-free intrusive
+/// list the first time they record, so the set of counters is exactly the
+/// set of call sites that actually ran.
+///
+/// Disabled by default: recording is then one relaxed load and a branch, and
+/// the timestamp counter is never read. Enabled (via `pulsevm.getFfiStats`),
+/// a call costs two `rdtsc` reads and two relaxed adds. Totals are
+/// cumulative; the RPC's reset parameter brackets a capture window, and the
+/// per-block divisor comes from the block counter fed by `count_block`.
+pub static FFI_STATS: LazyLock<FfiStats> = LazyLock::new(FfiStats::new);
+
+/// One bridge call site's counters. Declared `static` at the call site so
+/// recording is a direct field access, no lookup.
+pub struct FfiSite {
+    name: &'static str,
+    calls: AtomicU64,
+    cycles: AtomicU64,
+    registered: AtomicBool,
+    next: AtomicPtr<FfiSite>,
+}
+
+impl FfiSite {
+    pub const fn new(name: &'static str) -> Self {
+        Self {
+            name,
+            calls: AtomicU64::new(0),
+            cycles: AtomicU64::new(0),
+            registered: AtomicBool::new(false),
+            next: AtomicPtr::new(std::ptr::null_mut()),
+        }
+    }
+}
+
+/// Point-in-time totals for one site, served over RPC.
+pub struct FfiSiteSnapshot {
+    pub name: &'static str,
+    pub calls: u64,
+    pub cycles: u64,
+}
+
+pub struct FfiStats {
+    enabled: AtomicBool,
+    blocks: AtomicU64,
+    head: AtomicPtr<FfiSite>,
+}
+
+impl FfiStats {
+    fn new() -> Self {
+        Self {
+            enabled: AtomicBool::new(false),
+            blocks: AtomicU64::new(0),
+            head: AtomicPtr::new(std::ptr::null_mut()),
+        }
+    }
+
+    pub fn set_enabled(&self, enabled: bool) {
+        self.enabled.store(enabled, Ordering::Relaxed);
+    }
+
+    pub fn is_enabled(&self) -> bool {
+        self.enabled.load(Ordering::Relaxed)
+    }
+
+    /// Called once per executed block, so the snapshot can express totals as
+    /// per-block averages.
+    pub fn count_block(&self) {
+        if self.is_enabled() {
+            self.blocks.fetch_add(1, Ordering::Relaxed);
+        }
+    }
+
+    /// Scope guard timing one bridge call; records on drop. Disabled, it
+    /// never reads the timestamp counter.
+    #[inline]
+    pub fn timer(&'static self, site: &'static FfiSite) -> FfiTimer {
+        FfiTimer {
+            site,
+            start: self.is_enabled().then(cycles_now),
+        }
+    }
+
+    fn record(&self, site: &'static FfiSite, cycles: u64) {
+        site.calls.fetch_add(1, Ordering::Relaxed);
+        site.cycles.fetch_add(cycles, Ordering::Relaxed);
+        // First record from this site: splice it onto the registry list.
+        // `swap` makes exactly one thread the publisher.
+        if !site.registered.swap(true, Ordering::AcqRel) {
+            let site_ptr = site as *const FfiSite as *mut FfiSite;
+            let mut head = self.head.load(Ordering::Acquire);
+            loop {
+                site.next.store(head, Ordering::Relaxed);
+                match self.head.compare_exchange_weak(
+                    head,
+                    site_ptr,
+                    Ordering::AcqRel,
+                    Ordering::Acquire,
+                ) {
+                    Ok(_) => break,
+                    Err(current) => head = current,
+                }
+            }
+        }
+    }
+
+    /// Registered sites, heaviest first, plus the block divisor.
+    pub fn snapshot(&self) -> (Vec<FfiSiteSnapshot>, u64) {
+        let mut sites = Vec::new();
+        let mut cursor = self.head.load(Ordering::Acquire);
+        while let Some(site) = unsafe { cursor.as_ref() } {
+            sites.push(FfiSiteSnapshot {
+                name: site.name,
+                calls: site.calls.load(Ordering::Relaxed),
+                cycles: site.cycles.load(Ordering::Relaxed),
+            });
+            cursor = site.next.load(Ordering::Acquire);
+        }
+        sites.sort_by(|a, b| b.cycles.cmp(&a.cycles));
+        (sites, self.blocks.load(Ordering::Relaxed))
+    }
+
+    pub fn reset(&self) {
+        self.blocks.store(0, Ordering::Relaxed);
+        let mut cursor = self.head.load(Ordering::Acquire);
+        while let Some(site) = unsafe { cursor.as_ref() } {
+            site.calls.store(0, Ordering::Relaxed);
+            site.cycles.store(0, Ordering::Relaxed);
+            cursor = site.next.load(Ordering::Acquire);
+        }
+    }
+}
+
+pub struct FfiTimer {
+    site: &'static FfiSite,
+    start: Option<u64>,
+}
+
+impl Drop for FfiTimer {
+    fn drop(&mut self) {
+        if let Some(start) = self.start {
+            FFI_STATS.record(self.site, cycles_now().wrapping_sub(start));
+        }
+    }
+}
+
+/// Timestamp counter: `rdtsc` where available, monotonic nanoseconds
+/// elsewhere (the snapshot reports relative weight either way).
+#[inline]
+fn cycles_now() -> u64 {
+    #[cfg(target_arch = "x86_64")]
+    unsafe {
+        core::arch::x86_64::_rdtsc()
+    }
+    #[cfg(not(target_arch = "x86_64"))]
+    {
+        static EPOCH: LazyLock<std::time::Instant> = LazyLock::new(std::time::Instant::now);
+        EPOCH.elapsed().as_nanos() as u64
+    }
+}
+
+/// Declares a [`FfiSite`] for the enclosing bridge wrapper and returns the
+/// scope guard timing it. One line per instrumented function:
+///
+/// ```ignore
+/// let _ffi = ffi_timed!("find_account");
+/// ```
+#[macro_export]
+macro_rules! ffi_timed {
+    ($name:literal) => {{
+        static SITE: $crate::ffi_stats::FfiSite = $crate::ffi_stats::FfiSite::new($name);
+        $crate::ffi_stats::FFI_STATS.timer(&SITE)
+    }};
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn disabled_collector_records_nothing() {
+        let stats = FfiStats::new();
+        assert!(!stats.is_enabled());
+        stats.count_block();
+        let (sites, blocks) = stats.snapshot();
+        assert!(sites.is_empty());
+        assert_eq!(blocks, 0);
+    }
+
+    #[test]
+    fn sites_register_once_and_reset_in_place() {
+        static SITE: FfiSite = FfiSite::new("test_site");
+        // Record through the global so the guard path is the one exercised;
+        // the site static is local to this test.
+        FFI_STATS.set_enabled(true);
+        {
+            let _t = FFI_STATS.timer(&SITE);
+        }
+        {
+            let _t = FFI_STATS.timer(&SITE);
+        }
+        FFI_STATS.set_enabled(false);
+
+        let (sites, _) = FFI_STATS.snapshot();
+        let mine = sites.iter().find(|s| s.name == "test_site").unwrap();
+        assert_eq!(mine.calls, 2);
+
+        FFI_STATS.reset();
+        let (sites, _) = FFI_STATS.snapshot();
+        let mine = sites.iter().find(|s| s.name == "test_site").unwrap();
+        assert_eq!(mine.calls, 0);
+    }
+}
@@ -1,477 +1,173 @@
-use std::{ops::Deref, pin::Pin};
+use std::collections::HashMap;
 
 use pulsevm_error::ChainError;
 
 use crate::{
     Index64Object, KeyValueObject, TableId, TableObject,
     bridge::ffi::{
-        CxxIndex64IteratorCache, CxxIndex128IteratorCache, CxxIndex256IteratorCache,
-        CxxIndexDoubleIteratorCache, CxxIndexLongDoubleIteratorCache, CxxKeyValueIteratorCache,
-        Index128Object, Index256Object, IndexDoubleObject, IndexLongDoubleObject,
-        new_index_double_iterator_cache, new_index_long_double_iterator_cache,
-        new_index64_iterator_cache, new_index128_iterator_cache, new_index256_iterator_cache,
-        new_key_value_iterator_cache,
+        Index128Object, Index256Object, IndexDoubleObject, IndexLongDoubleObject, table_id_value,
     },
 };
 
-pub struct KeyValueIteratorCache {
-    inner: cxx::UniquePtr<CxxKeyValueIteratorCache>,
-}
-
-impl KeyValueIteratorCache {
+/// Iterator bookkeeping for the contract db host functions.
+///
+/// Rows and tables live in chainbase, so the cache only holds raw pointers
+/// handed back by the database primitives; entries stay valid for the duration
+/// of the action that created them, matching how the wasm iterator protocol is
+/// specified. Iterator `-1` is the invalid iterator and each cached table gets
+/// its own end iterator below `-1`, encoded as `-(table_index + 2)`.
+pub struct IteratorCache<T> {
+    table_cache: HashMap<i64, (*const TableObject, i32)>,
+    end_iterator_to_table: Vec<*const TableObject>,
+    iterator_to_object: Vec<*const T>,
+    object_to_iterator: HashMap<*const T, i32>,
+}
+
+impl<T> IteratorCache<T> {
     pub fn new() -> Self {
-        let inner = new_key_value_iterator_cache();
-        KeyValueIteratorCache { inner }
-    }
-
-    pub fn pin_mut(&mut self) -> Pin<&mut CxxKeyValueIteratorCache> {
-        self.inner.pin_mut()
-    }
-
-    pub fn cache_table(&mut self, table: &TableObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .cache_table(table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn get_table(&self, table_id: &TableId) -> Result<&TableObject, ChainError> {
-        self.inner
-            .get_table(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn get_end_iterator_by_table_id(&self, table_id: &TableId) -> Result<i32, ChainError> {
-        self.inner
-            .get_end_iterator_by_table_id(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn find_table_by_end_iterator(&self, ei: i32) -> Result<Option<&TableObject>, ChainError> {
-        let res = self
-            .inner
-            .find_table_by_end_iterator(ei)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-
-        match res.is_null() {
-            true => Ok(None),
-            false => unsafe { Ok(Some(&*res)) },
+        Self {
+            table_cache: HashMap::new(),
+            end_iterator_to_table: Vec::new(),
+            iterator_to_object: Vec::new(),
+            object_to_iterator: HashMap::new(),
         }
     }
 
-    pub fn get(&self, id: i32) -> Result<&KeyValueObject, ChainError> {
-        self.inner
-            .get(id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn remove(&mut self, iterator: i32) -> Result<(), ChainError> {
-        self.inner
-            .pin_mut()
-            .remove(iterator)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn add(&mut self, obj: &KeyValueObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .add(obj)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-}
-
-impl Deref for KeyValueIteratorCache {
-    type Target = cxx::UniquePtr<CxxKeyValueIteratorCache>;
-
-    fn deref(&self) -> &Self::Target {
-        &self.inner
-    }
-}
-
-unsafe impl Send for KeyValueIteratorCache {}
-unsafe impl Sync for KeyValueIteratorCache {}
-
-pub struct Index64IteratorCache {
-    inner: cxx::UniquePtr<CxxIndex64IteratorCache>,
-}
-
-impl Index64IteratorCache {
-    pub fn new() -> Self {
-        let inner = new_index64_iterator_cache();
-        Index64IteratorCache { inner }
-    }
-
-    pub fn pin_mut(&mut self) -> Pin<&mut CxxIndex64IteratorCache> {
-        self.inner.pin_mut()
-    }
-
-    pub fn cache_table(&mut self, table: &TableObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .cache_table(table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+    fn index_to_end_iterator(index: usize) -> i32 {
+        -(index as i32 + 2)
     }
 
-    pub fn get_table(&self, table_id: &TableId) -> Result<&TableObject, ChainError> {
-        self.inner
-            .get_table(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn get_end_iterator_by_table_id(&self, table_id: &TableId) -> Result<i32, ChainError> {
-        self.inner
-            .get_end_iterator_by_table_id(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+    fn end_iterator_to_index(ei: i32) -> usize {
+        (-ei - 2) as usize
     }
 
-    pub fn find_table_by_end_iterator(&self, ei: i32) -> Result<Option<&TableObject>, ChainError> {
-        let res = self
-            .inner
-            .find_table_by_end_iterator(ei)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-
-        match res.is_null() {
-            true => Ok(None),
-            false => unsafe { Ok(Some(&*res)) },
+    /// Registers `table` and returns its end iterator, reusing the existing
+    /// one if the table has been cached before.
+    pub fn cache_table(&mut self, table: &TableObject) -> i32 {
+        if let Some((_, ei)) = self.table_cache.get(&table.get_id()) {
+            return *ei;
         }
-    }
-
-    pub fn get(&self, id: i32) -> Result<&Index64Object, ChainError> {
-        self.inner
-            .get(id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn remove(&mut self, iterator: i32) -> Result<(), ChainError> {
-        self.inner
-            .pin_mut()
-            .remove(iterator)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn add(&mut self, obj: &Index64Object) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .add(obj)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-}
-
-impl Deref for Index64IteratorCache {
-    type Target = cxx::UniquePtr<CxxIndex64IteratorCache>;
-
-    fn deref(&self) -> &Self::Target {
-        &self.inner
-    }
-}
-
-unsafe impl Send for Index64IteratorCache {}
-unsafe impl Sync for Index64IteratorCache {}
-
-pub struct Index128IteratorCache {
-    inner: cxx::UniquePtr<CxxIndex128IteratorCache>,
-}
-
-impl Index128IteratorCache {
-    pub fn new() -> Self {
-        let inner = new_index128_iterator_cache();
-        Index128IteratorCache { inner }
-    }
-
-    pub fn pin_mut(&mut self) -> Pin<&mut CxxIndex128IteratorCache> {
-        self.inner.pin_mut()
-    }
 
-    pub fn cache_table(&mut self, table: &TableObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .cache_table(table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let ei = Self::index_to_end_iterator(self.end_iterator_to_table.len());
+        self.end_iterator_to_table.push(table);
+        self.table_cache
+            .insert(table.get_id(), (table as *const TableObject, ei));
+        ei
     }
 
     pub fn get_table(&self, table_id: &TableId) -> Result<&TableObject, ChainError> {
-        self.inner
-            .get_table(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn get_end_iterator_by_table_id(&self, table_id: &TableId) -> Result<i32, ChainError> {
-        self.inner
-            .get_end_iterator_by_table_id(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn find_table_by_end_iterator(&self, ei: i32) -> Result<Option<&TableObject>, ChainError> {
-        let res = self
-            .inner
-            .find_table_by_end_iterator(ei)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-
-        match res.is_null() {
-            true => Ok(None),
-            false => unsafe { Ok(Some(&*res)) },
+        match self.table_cache.get(&table_id_value(table_id)) {
+            Some((table, _)) => Ok(unsafe { &**table }),
+            None => Err(ChainError::InternalError(
+                "an invariant was broken, table should be in cache".to_string(),
+            )),
         }
     }
 
-    pub fn get(&self, id: i32) -> Result<&Index128Object, ChainError> {
-        self.inner
-            .get(id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn remove(&mut self, iterator: i32) -> Result<(), ChainError> {
-        self.inner
-            .pin_mut()
-            .remove(iterator)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn add(&mut self, obj: &Index128Object) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .add(obj)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-}
-
-impl Deref for Index128IteratorCache {
-    type Target = cxx::UniquePtr<CxxIndex128IteratorCache>;
-
-    fn deref(&self) -> &Self::Target {
-        &self.inner
-    }
-}
-
-unsafe impl Send for Index128IteratorCache {}
-unsafe impl Sync for Index128IteratorCache {}
-
-pub struct Index256IteratorCache {
-    inner: cxx::UniquePtr<CxxIndex256IteratorCache>,
-}
-
-impl Index256IteratorCache {
-    pub fn new() -> Self {
-        let inner = new_index256_iterator_cache();
-        Index256IteratorCache { inner }
-    }
-
-    pub fn pin_mut(&mut self) -> Pin<&mut CxxIndex256IteratorCache> {
-        self.inner.pin_mut()
-    }
-
-    pub fn cache_table(&mut self, table: &TableObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .cache_table(table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn get_table(&self, table_id: &TableId) -> Result<&TableObject, ChainError> {
-        self.inner
-            .get_table(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
     pub fn get_end_iterator_by_table_id(&self, table_id: &TableId) -> Result<i32, ChainError> {
-        self.inner
-            .get_end_iterator_by_table_id(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        match self.table_cache.get(&table_id_value(table_id)) {
+            Some((_, ei)) => Ok(*ei),
+            None => Err(ChainError::InternalError(
+                "an invariant was broken, table should be in cache".to_string(),
+            )),
+        }
     }
 
     pub fn find_table_by_end_iterator(&self, ei: i32) -> Result<Option<&TableObject>, ChainError> {
-        let res = self
-            .inner
-            .find_table_by_end_iterator(ei)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-
-        match res.is_null() {
-            true => Ok(None),
-            false => unsafe { Ok(Some(&*res)) },
+        if ei >= -1 {
+            return Err(ChainError::InternalError("not an end iterator".to_string()));
         }
-    }
-
-    pub fn get(&self, id: i32) -> Result<&Index256Object, ChainError> {
-        self.inner
-            .get(id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn remove(&mut self, iterator: i32) -> Result<(), ChainError> {
-        self.inner
-            .pin_mut()
-            .remove(iterator)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn add(&mut self, obj: &Index256Object) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .add(obj)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-}
-
-impl Deref for Index256IteratorCache {
-    type Target = cxx::UniquePtr<CxxIndex256IteratorCache>;
-
-    fn deref(&self) -> &Self::Target {
-        &self.inner
-    }
-}
-
-unsafe impl Send for Index256IteratorCache {}
-unsafe impl Sync for Index256IteratorCache {}
-
-pub struct IndexDoubleIteratorCache {
-    inner: cxx::UniquePtr<CxxIndexDoubleIteratorCache>,
-}
-
-impl IndexDoubleIteratorCache {
-    pub fn new() -> Self {
-        let inner = new_index_double_iterator_cache();
-        IndexDoubleIteratorCache { inner }
-    }
-
-    pub fn pin_mut(&mut self) -> Pin<&mut CxxIndexDoubleIteratorCache> {
-        self.inner.pin_mut()
-    }
-
-    pub fn cache_table(&mut self, table: &TableObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .cache_table(table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
 
-    pub fn get_table(&self, table_id: &TableId) -> Result<&TableObject, ChainError> {
-        self.inner
-            .get_table(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn get_end_iterator_by_table_id(&self, table_id: &TableId) -> Result<i32, ChainError> {
-        self.inner
-            .get_end_iterator_by_table_id(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let index = Self::end_iterator_to_index(ei);
+        match self.end_iterator_to_table.get(index) {
+            Some(table) => Ok(Some(unsafe { &**table })),
+            None => Ok(None),
+        }
     }
 
-    pub fn find_table_by_end_iterator(&self, ei: i32) -> Result<Option<&TableObject>, ChainError> {
-        let res = self
-            .inner
-            .find_table_by_end_iterator(ei)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-
-        match res.is_null() {
-            true => Ok(None),
-            false => unsafe { Ok(Some(&*res)) },
+    pub fn get(&self, iterator: i32) -> Result<&T, ChainError> {
+        if iterator == -1 {
+            return Err(ChainError::InternalError("invalid iterator".to_string()));
+        }
+        if iterator < 0 {
+            return Err(ChainError::InternalError(
+                "dereference of end iterator".to_string(),
+            ));
         }
-    }
 
-    pub fn get(&self, id: i32) -> Result<&IndexDoubleObject, ChainError> {
-        self.inner
-            .get(id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        match self.iterator_to_object.get(iterator as usize) {
+            Some(obj) if !obj.is_null() => Ok(unsafe { &**obj }),
+            Some(_) => Err(ChainError::InternalError(
+                "dereference of deleted object".to_string(),
+            )),
+            None => Err(ChainError::InternalError(
+                "iterator out of range".to_string(),
+            )),
+        }
     }
 
     pub fn remove(&mut self, iterator: i32) -> Result<(), ChainError> {
-        self.inner
-            .pin_mut()
-            .remove(iterator)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn add(&mut self, obj: &IndexDoubleObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .add(obj)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-}
-
-impl Deref for IndexDoubleIteratorCache {
-    type Target = cxx::UniquePtr<CxxIndexDoubleIteratorCache>;
-
-    fn deref(&self) -> &Self::Target {
-        &self.inner
-    }
-}
-
-unsafe impl Send for IndexDoubleIteratorCache {}
-unsafe impl Sync for IndexDoubleIteratorCache {}
-
-pub struct IndexLongDoubleIteratorCache {
-    inner: cxx::UniquePtr<CxxIndexLongDoubleIteratorCache>,
-}
+        if iterator == -1 {
+            return Err(ChainError::InternalError("invalid iterator".to_string()));
+        }
+        if iterator < 0 {
+            return Err(ChainError::InternalError(
+                "cannot call remove on end iterators".to_string(),
+            ));
+        }
 
-impl IndexLongDoubleIteratorCache {
-    pub fn new() -> Self {
-        let inner = new_index_long_double_iterator_cache();
-        IndexLongDoubleIteratorCache { inner }
-    }
+        let slot = self
+            .iterator_to_object
+            .get_mut(iterator as usize)
+            .ok_or_else(|| ChainError::InternalError("iterator out of range".to_string()))?;
 
-    pub fn pin_mut(&mut self) -> Pin<&mut CxxIndexLongDoubleIteratorCache> {
-        self.inner.pin_mut()
-    }
+        if slot.is_null() {
+            return Ok(());
+        }
 
-    pub fn cache_table(&mut self, table: &TableObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .cache_table(table)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
+        let obj = std::mem::replace(slot, std::ptr::null());
+        self.object_to_iterator.remove(&obj);
 
-    pub fn get_table(&self, table_id: &TableId) -> Result<&TableObject, ChainError> {
-        self.inner
-            .get_table(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        Ok(())
     }
 
-    pub fn get_end_iterator_by_table_id(&self, table_id: &TableId) -> Result<i32, ChainError> {
-        self.inner
-            .get_end_iterator_by_table_id(table_id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+    /// Empties the cache while keeping the container capacity, so a recycled
+    /// cache serves its next action without regrowing its tables.
+    pub fn clear(&mut self) {
+        self.table_cache.clear();
+        self.end_iterator_to_table.clear();
+        self.iterator_to_object.clear();
+        self.object_to_iterator.clear();
     }
 
-    pub fn find_table_by_end_iterator(&self, ei: i32) -> Result<Option<&TableObject>, ChainError> {
-        let res = self
-            .inner
-            .find_table_by_end_iterator(ei)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))?;
-
-        match res.is_null() {
-            true => Ok(None),
-            false => unsafe { Ok(Some(&*res)) },
+    /// Caches `obj` and returns its iterator, reusing the existing one if the
+    /// row has been handed out before.
+    pub fn add(&mut self, obj: &T) -> i32 {
+        if let Some(iterator) = self.object_to_iterator.get(&(obj as *const T)) {
+            return *iterator;
         }
-    }
-
-    pub fn get(&self, id: i32) -> Result<&IndexLongDoubleObject, ChainError> {
-        self.inner
-            .get(id)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
 
-    pub fn remove(&mut self, iterator: i32) -> Result<(), ChainError> {
-        self.inner
-            .pin_mut()
-            .remove(iterator)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
-    }
-
-    pub fn add(&mut self, obj: &IndexLongDoubleObject) -> Result<i32, ChainError> {
-        self.inner
-            .pin_mut()
-            .add(obj)
-            .map_err(|e| ChainError::InternalError(format!("{}", e)))
+        let iterator = self.iterator_to_object.len() as i32;
+        self.iterator_to_object.push(obj);
+        self.object_to_iterator.insert(obj, iterator);
+        iterator
     }
 }
 
-impl Deref for IndexLongDoubleIteratorCache {
-    type Target = cxx::UniquePtr<CxxIndexLongDoubleIteratorCache>;
-
-    fn deref(&self) -> &Self::Target {
-        &self.inner
+impl<T> Default for IteratorCache<T> {
+    fn default() -> Self {
+        Self::new()
     }
 }
 
-unsafe impl Send for IndexLongDoubleIteratorCache {}
-unsafe impl Sync for IndexLongDoubleIteratorCache {}
+// The cached pointers reference chainbase shared memory, which outlives the
+// cache and is only mutated under the database lock.
+unsafe impl<T> Send for IteratorCache<T> {}
+unsafe impl<T> Sync for IteratorCache<T> {}
+
+pub type KeyValueIteratorCache = IteratorCache<KeyValueObject>;
+pub type Index64IteratorCache = IteratorCache<Index64Object>;
+pub type Index128IteratorCache = IteratorCache<Index128Object>;
+pub type Index256IteratorCache = IteratorCache<Index256Object>;
+pub type IndexDoubleIteratorCache = IteratorCache<IndexDoubleObject>;
+pub type IndexLongDoubleIteratorCache = IteratorCache<IndexLongDoubleObject>;
@@ -1,16 +1,20 @@
 mod bridge;
 mod database;
+mod ffi_error;
+pub mod ffi_stats;
 mod iterator_cache;
 mod objects;
 mod types;
 
 pub use crate::bridge::ffi::DatabaseOpenFlags;
+pub use crate::bridge::ffi::DbMapMode;
 pub use crate::bridge::ffi::{
-    AccountMetadataObject, AccountObject, Authority, CodeObject, ElasticLimitParameters,
+    AccountMetadataObject, AccountObject, AccountRamDelta, AccountSequence, Authority, CodeObject,
+    ElasticLimitParameters,
     GlobalPropertyObject, Index64Object, Index128Object, Index256Object, IndexDoubleObject,
     IndexLongDoubleObject, KeyValueObject, KeyWeight, PermissionLevel, PermissionLevelWeight,
     PermissionLinkObject, PermissionObject, PermissionUsageObject, Ratio, TableId, TableObject,
-    WaitWeight,
+    TableRowsBinaryResult, WaitWeight,
 };
 pub use crate::bridge::ffi::{
     BlockTimestamp, ChainConfigV0, CxxBlockTimestamp, CxxChainConfig, CxxDigest, CxxGenesisState,
@@ -18,6 +22,7 @@ pub use crate::bridge::ffi::{
     Microseconds, TimePoint, TimePointSec, U128, U256,
 };
 pub use crate::bridge::ffi::{CxxName, string_to_name, u64_to_name};
+pub use crate::bridge::ffi::UndoSession;
 pub use crate::bridge::ffi::{
     addtf3, cmptf2, divtf3, eqtf2, extenddftf2, extendsftf2, fixdfti, fixsfti, fixtfdi, fixtfsi,
     fixtfti, fixunsdfti, fixunssfti, fixunstfdi, fixunstfsi, fixunstfti, floatditf, floatsidf,
@@ -29,7 +34,8 @@ pub use crate::bridge::ffi::{
     recover_public_key_from_signature, sign_digest_with_private_key, subtf3, trunctfdf2,
     trunctfsf2, unordtf2,
 };
-pub use crate::database::Database;
+pub use crate::database::{BulkLoadSession, Database};
+pub use crate::ffi_error::strip_error_code;
 pub use crate::iterator_cache::{
     Index64IteratorCache, Index128IteratorCache, Index256IteratorCache, IndexDoubleIteratorCache,
     IndexLongDoubleIteratorCache, KeyValueIteratorCache,
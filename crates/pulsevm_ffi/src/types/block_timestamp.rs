@@ -7,7 +7,7 @@ use serde::{
 };
 use time::{Duration, OffsetDateTime, PrimitiveDateTime, macros::format_description};
 
-use crate::{CxxTimePoint, TimePoint, bridge::ffi::BlockTimestamp};
+use crate::{CxxBlockTimestamp, CxxTimePoint, TimePoint, bridge::ffi::BlockTimestamp};
 
 impl BlockTimestamp {
     pub const BLOCK_INTERVAL_MS: i32 = 500;
@@ -83,6 +83,15 @@ impl From<BlockTimestamp> for TimePoint {
     }
 }
 
+impl From<&CxxBlockTimestamp> for BlockTimestamp {
+    /// Boundary conversion: the slot crosses the FFI as a plain `u32`; all
+    /// arithmetic on the result stays in Rust.
+    #[inline]
+    fn from(ts: &CxxBlockTimestamp) -> BlockTimestamp {
+        BlockTimestamp::new(ts.get_slot())
+    }
+}
+
 impl From<&CxxTimePoint> for BlockTimestamp {
     #[inline]
     fn from(ts: &CxxTimePoint) -> BlockTimestamp {
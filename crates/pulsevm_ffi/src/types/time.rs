@@ -4,7 +4,6 @@ use std::{
     str::FromStr,
 };
 
-use cxx::SharedPtr;
 use pulsevm_serialization::{NumBytes, Read, Write};
 use serde::{
     Deserialize, Deserializer, Serialize, Serializer,
@@ -12,10 +11,7 @@ use serde::{
 };
 use time::{OffsetDateTime, PrimitiveDateTime, macros::format_description};
 
-use crate::{
-    CxxTimePoint,
-    bridge::ffi::{Microseconds, TimePoint, make_time_point_from_i64, make_time_point_from_now},
-};
+use crate::bridge::ffi::{Microseconds, TimePoint};
 
 const EOS_FMT_MILLIS_NOZ: &[time::format_description::FormatItem<'_>] =
     format_description!("[year]-[month]-[day]T[hour]:[minute]:[second].[subsecond digits:3]");
@@ -26,16 +22,6 @@ const EOS_FMT_MILLIS_Z: &[time::format_description::FormatItem<'_>] =
 const EOS_FMT_SECS_NOZ: &[time::format_description::FormatItem<'_>] =
     format_description!("[year]-[month]-[day]T[hour]:[minute]:[second]");
 
-impl CxxTimePoint {
-    pub fn new(microseconds: i64) -> SharedPtr<CxxTimePoint> {
-        make_time_point_from_i64(microseconds)
-    }
-
-    pub fn now() -> SharedPtr<CxxTimePoint> {
-        make_time_point_from_now()
-    }
-}
-
 impl Microseconds {
     #[inline]
     pub const fn new(count: i64) -> Self {
@@ -38,18 +38,6 @@ std::shared_ptr<CxxDigest> make_shared_digest_from_string(rust::Str key_str) {
     return std::make_shared<CxxDigest>(hash);
 }
 
-std::shared_ptr<CxxTimePoint> make_time_point_from_now() {
-    return std::make_shared<CxxTimePoint>(CxxTimePoint::now());
-}
-
-std::shared_ptr<CxxBlockTimestamp> make_block_timestamp_from_now() {
-    return std::make_shared<CxxBlockTimestamp>(CxxTimePoint::now());
-}
-
-std::shared_ptr<CxxBlockTimestamp> make_block_timestamp_from_slot( uint32_t slot ) {
-    return std::make_shared<CxxBlockTimestamp>(slot);
-}
-
 rust::String signature_to_string(const fc::crypto::signature& signature) {
     std::string s = signature.to_string(fc::yield_function_t());
     return rust::String(s);
@@ -60,14 +48,6 @@ rust::String public_key_to_string(const fc::crypto::public_key& public_key) {
     return rust::String(s);
 }
 
-std::shared_ptr<CxxTimePoint> make_time_point_from_i64(int64_t us) {
-    return std::make_shared<CxxTimePoint>(CxxTimePoint(CxxMicroseconds(us)));
-}
-
-std::shared_ptr<CxxTimePoint> make_time_point_from_microseconds(const CxxMicroseconds& us) {
-    return std::make_shared<CxxTimePoint>(CxxTimePoint(us));
-}
-
 std::unique_ptr<CxxGenesisState> make_empty_genesis_state() {
     return std::make_unique<CxxGenesisState>();
 }
@@ -13,11 +13,6 @@ namespace pulsevm { namespace chain {
     std::shared_ptr<CxxDigest> make_shared_digest_from_existing_hash(rust::Slice<const std::uint8_t> data);
     std::unique_ptr<CxxDigest> make_digest_from_existing_hash(rust::Slice<const std::uint8_t> data);
     std::shared_ptr<CxxDigest> make_shared_digest_from_string(rust::Str key_str);
-    std::shared_ptr<CxxTimePoint> make_time_point_from_now();
-    std::shared_ptr<CxxBlockTimestamp> make_block_timestamp_from_now();
-    std::shared_ptr<CxxBlockTimestamp> make_block_timestamp_from_slot( uint32_t slot );
-    std::shared_ptr<CxxTimePoint> make_time_point_from_i64(int64_t us);
-    std::shared_ptr<CxxTimePoint> make_time_point_from_microseconds(const CxxMicroseconds& us);
     std::unique_ptr<CxxGenesisState> make_empty_genesis_state();
     std::unique_ptr<CxxGenesisState> parse_genesis_state(rust::Str json);
     std::shared_ptr<CxxPublicKey> parse_public_key(rust::Str key_str);
@@ -1,4 +1,4 @@
-use std::sync::Mutex;
+use std::sync::RwLock;
 
 use actix_web::{HttpResponse, get, post, web};
 use pulsevm_core::{id::Id, transaction::Transaction};
@@ -8,9 +8,12 @@ use spdlog::info;
 
 use crate::manager::{ManagerError, WalletManager};
 
-/// Shared state for the HTTP server.
+/// Shared state for the HTTP server. The outer lock is only taken in write
+/// mode by the endpoints that change the wallet set (create, open, unlock's
+/// auto-open); everything else shares read access and relies on the
+/// per-wallet locks inside the manager, so sign requests run in parallel.
 pub struct AppState {
-    pub manager: Mutex<WalletManager>,
+    pub manager: RwLock<WalletManager>,
 }
 
 // ---------- Error response format (matches EOSIO error format) ----------
@@ -162,6 +165,9 @@ struct SignDigestRequest {
 #[derive(Deserialize)]
 struct SignTransactionRequest(Transaction, Vec<String>, Id); // [transaction, public_keys, chain_id]
 
+#[derive(Deserialize)]
+struct SignDigestsRequest(Vec<(String, String)>); // [[digest_hex, public_key], ...]
+
 // ---------- Endpoint handlers ----------
 
 /// POST /v1/wallet/create
@@ -170,7 +176,7 @@ struct SignTransactionRequest(Transaction, Vec<String>, Id); // [transaction, pu
 #[post("/v1/wallet/create")]
 async fn wallet_create(data: web::Data<AppState>, body: web::Json<String>) -> HttpResponse {
     let name = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mut mgr = data.manager.write().unwrap();
     match mgr.create(&name) {
         Ok(password) => HttpResponse::Created().json(password),
         Err(e) => manager_err_to_response(e),
@@ -182,7 +188,7 @@ async fn wallet_create(data: web::Data<AppState>, body: web::Json<String>) -> Ht
 #[post("/v1/wallet/open")]
 async fn wallet_open(data: web::Data<AppState>, body: web::Json<String>) -> HttpResponse {
     let name = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mut mgr = data.manager.write().unwrap();
     match mgr.open(&name) {
         Ok(()) => HttpResponse::Ok().json(serde_json::json!({})),
         Err(e) => manager_err_to_response(e),
@@ -194,7 +200,7 @@ async fn wallet_open(data: web::Data<AppState>, body: web::Json<String>) -> Http
 #[post("/v1/wallet/lock")]
 async fn wallet_lock(data: web::Data<AppState>, body: web::Json<String>) -> HttpResponse {
     let name = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.lock(&name) {
         Ok(()) => HttpResponse::Ok().json(serde_json::json!({})),
         Err(e) => manager_err_to_response(e),
@@ -204,7 +210,7 @@ async fn wallet_lock(data: web::Data<AppState>, body: web::Json<String>) -> Http
 /// POST /v1/wallet/lock_all
 #[post("/v1/wallet/lock_all")]
 async fn wallet_lock_all(data: web::Data<AppState>) -> HttpResponse {
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.lock_all() {
         Ok(()) => HttpResponse::Ok().json(serde_json::json!({})),
         Err(e) => manager_err_to_response(e),
@@ -216,7 +222,7 @@ async fn wallet_lock_all(data: web::Data<AppState>) -> HttpResponse {
 #[post("/v1/wallet/unlock")]
 async fn wallet_unlock(data: web::Data<AppState>, body: web::Json<UnlockRequest>) -> HttpResponse {
     let req = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mut mgr = data.manager.write().unwrap();
     match mgr.unlock(&req.0, &req.1) {
         Ok(()) => HttpResponse::Ok().json(serde_json::json!({})),
         Err(e) => manager_err_to_response(e),
@@ -231,7 +237,7 @@ async fn wallet_import_key(
     body: web::Json<ImportKeyRequest>,
 ) -> HttpResponse {
     let req = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.import_key(&req.0, &req.1) {
         Ok(()) => HttpResponse::Created().json(serde_json::json!({})),
         Err(e) => manager_err_to_response(e),
@@ -246,7 +252,7 @@ async fn wallet_remove_key(
     body: web::Json<RemoveKeyRequest>,
 ) -> HttpResponse {
     let req = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.remove_key(&req.0, &req.1, &req.2) {
         Ok(()) => HttpResponse::Ok().json(serde_json::json!({})),
         Err(e) => manager_err_to_response(e),
@@ -261,7 +267,7 @@ async fn wallet_create_key(
     body: web::Json<CreateKeyRequest>,
 ) -> HttpResponse {
     let req = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.create_key(&req.0) {
         Ok(pub_key) => HttpResponse::Created().json(pub_key),
         Err(e) => manager_err_to_response(e),
@@ -271,7 +277,7 @@ async fn wallet_create_key(
 /// POST /v1/wallet/list_wallets
 #[post("/v1/wallet/list_wallets")]
 async fn wallet_list_wallets(data: web::Data<AppState>) -> HttpResponse {
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     let wallets = mgr.list_wallets();
     HttpResponse::Ok().json(wallets)
 }
@@ -279,7 +285,7 @@ async fn wallet_list_wallets(data: web::Data<AppState>) -> HttpResponse {
 /// Also support GET for list_wallets (cleos uses GET sometimes)
 #[get("/v1/wallet/list_wallets")]
 async fn wallet_list_wallets_get(data: web::Data<AppState>) -> HttpResponse {
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     let wallets = mgr.list_wallets();
     HttpResponse::Ok().json(wallets)
 }
@@ -292,7 +298,7 @@ async fn wallet_list_keys(
     body: web::Json<ListKeysRequest>,
 ) -> HttpResponse {
     let req = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.list_keys(&req.0, &req.1) {
         Ok(keys) => {
             // Return as array of [pub_key, priv_key] pairs (EOSIO format)
@@ -309,7 +315,7 @@ async fn wallet_list_keys(
 /// POST /v1/wallet/get_public_keys
 #[post("/v1/wallet/get_public_keys")]
 async fn wallet_get_public_keys(data: web::Data<AppState>) -> HttpResponse {
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.get_public_keys() {
         Ok(keys) => HttpResponse::Ok().json(keys),
         Err(e) => manager_err_to_response(e),
@@ -319,7 +325,7 @@ async fn wallet_get_public_keys(data: web::Data<AppState>) -> HttpResponse {
 /// GET /v1/wallet/get_public_keys
 #[get("/v1/wallet/get_public_keys")]
 async fn wallet_get_public_keys_get(data: web::Data<AppState>) -> HttpResponse {
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.get_public_keys() {
         Ok(keys) => HttpResponse::Ok().json(keys),
         Err(e) => manager_err_to_response(e),
@@ -331,7 +337,7 @@ async fn wallet_get_public_keys_get(data: web::Data<AppState>) -> HttpResponse {
 #[post("/v1/wallet/set_timeout")]
 async fn wallet_set_timeout(data: web::Data<AppState>, body: web::Json<u64>) -> HttpResponse {
     let secs = body.into_inner();
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     mgr.set_timeout(secs);
     HttpResponse::Ok().json(serde_json::json!({}))
 }
@@ -358,7 +364,7 @@ async fn wallet_sign_digest(
         }
     };
 
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.sign_digest(&digest_bytes, &[public_key]) {
         Ok(sigs) => {
             // Return the first signature
@@ -378,6 +384,58 @@ async fn wallet_sign_digest(
     }
 }
 
+/// POST /v1/wallet/sign_digests
+/// Body: [["digest_hex", "public_key"], ...]
+/// Returns: ["signature", ...] in request order.
+///
+/// Batch form of sign_digest: a block producer signs every block plus API
+/// transactions, so one request and one manager lock covering N digests
+/// amortizes the HTTP round trip instead of paying it per signature.
+#[post("/v1/wallet/sign_digests")]
+async fn wallet_sign_digests(
+    data: web::Data<AppState>,
+    body: web::Json<SignDigestsRequest>,
+) -> HttpResponse {
+    let entries = body.into_inner().0;
+
+    let mut decoded = Vec::with_capacity(entries.len());
+    for (digest_hex, public_key) in entries {
+        match hex::decode(&digest_hex) {
+            Ok(bytes) => decoded.push((bytes, public_key)),
+            Err(_) => {
+                return error_response(
+                    500,
+                    3120000,
+                    "wallet_exception",
+                    "Wallet exception",
+                    "Invalid digest hex",
+                );
+            }
+        }
+    }
+
+    let mgr = data.manager.read().unwrap();
+    let mut signatures = Vec::with_capacity(decoded.len());
+    for (digest, public_key) in decoded {
+        match mgr.sign_digest(&digest, &[public_key]) {
+            Ok(sigs) => match sigs.values().next() {
+                Some(sig) => signatures.push(sig.clone()),
+                None => {
+                    return error_response(
+                        500,
+                        3120004,
+                        "wallet_missing_pub_key_exception",
+                        "Missing public key",
+                        "No signature produced",
+                    );
+                }
+            },
+            Err(e) => return manager_err_to_response(e),
+        }
+    }
+    HttpResponse::Ok().json(signatures)
+}
+
 /// POST /v1/wallet/sign_transaction
 /// Body: [transaction_json, [public_keys], "chain_id"]
 #[post("/v1/wallet/sign_transaction")]
@@ -391,7 +449,7 @@ async fn wallet_sign_transaction(
     let chain_id = req.2;
     let digest = _transaction.signing_digest(&chain_id, &Vec::new()).unwrap(); // TODO: Handle error gracefully
 
-    let mut mgr = data.manager.lock().unwrap();
+    let mgr = data.manager.read().unwrap();
     match mgr.sign_digest(&digest, &public_keys) {
         Ok(sigs) => {
             // Attach signatures to the transaction
@@ -430,6 +488,7 @@ pub fn configure_routes(cfg: &mut web::ServiceConfig) {
         .service(wallet_get_public_keys_get)
         .service(wallet_set_timeout)
         .service(wallet_sign_digest)
+        .service(wallet_sign_digests)
         .service(wallet_sign_transaction)
         .service(keosd_stop);
 }
@@ -5,7 +5,7 @@ mod logging;
 mod manager;
 mod wallet;
 
-use std::{path::PathBuf, sync::Mutex};
+use std::{path::PathBuf, sync::RwLock};
 
 use actix_web::{App, HttpServer, middleware, web};
 use clap::Parser;
@@ -46,7 +46,7 @@ async fn main() -> std::io::Result<()> {
     let manager = manager::WalletManager::new(wallet_dir, cli.unlock_timeout)
         .expect("Failed to initialize wallet manager");
     let state = web::Data::new(api::AppState {
-        manager: Mutex::new(manager),
+        manager: RwLock::new(manager),
     });
 
     let mut server = HttpServer::new(move || {
@@ -2,6 +2,10 @@ use std::{
     collections::BTreeMap,
     fs,
     path::PathBuf,
+    sync::{
+        Mutex, RwLock,
+        atomic::{AtomicU64, Ordering},
+    },
     time::{Duration, Instant},
 };
 
@@ -23,11 +27,18 @@ pub enum ManagerError {
     LockFileError(String),
 }
 
+/// Lock granularity: the manager itself only needs exclusive access when the
+/// wallet *set* changes (create/open/unlock's auto-open), so those keep
+/// `&mut self` and the HTTP layer takes its outer lock in write mode for them
+/// alone. Everything else — signing above all — takes `&self` and goes
+/// through the per-wallet `RwLock`, so concurrent `sign_digest` calls on the
+/// same unlocked wallet read the immutable key map in parallel instead of
+/// queueing behind one manager-wide mutex.
 pub struct WalletManager {
-    wallets: BTreeMap<String, Wallet>,
+    wallets: BTreeMap<String, RwLock<Wallet>>,
     wallet_dir: PathBuf,
-    timeout: Duration,
-    last_activity: Instant,
+    timeout_secs: AtomicU64,
+    last_activity: Mutex<Instant>,
 }
 
 impl WalletManager {
@@ -44,7 +55,7 @@ impl WalletManager {
                     if let Some(stem) = path.file_stem().and_then(|s| s.to_str()) {
                         match Wallet::open(stem, &wallet_dir) {
                             Ok(wallet) => {
-                                wallets.insert(stem.to_string(), wallet);
+                                wallets.insert(stem.to_string(), RwLock::new(wallet));
                             }
                             Err(e) => {
                                 // Log but don't fail — a corrupt file shouldn't
@@ -60,17 +71,19 @@ impl WalletManager {
         Ok(WalletManager {
             wallets,
             wallet_dir,
-            timeout: Duration::from_secs(timeout_secs),
-            last_activity: Instant::now(),
+            timeout_secs: AtomicU64::new(timeout_secs),
+            last_activity: Mutex::new(Instant::now()),
         })
     }
 
     /// Check and enforce auto-lock timeout.
-    fn check_timeout(&mut self) {
-        if self.timeout.as_secs() > 0 && self.last_activity.elapsed() > self.timeout {
+    fn check_timeout(&self) {
+        let timeout_secs = self.timeout_secs.load(Ordering::Relaxed);
+        let mut last_activity = self.last_activity.lock().unwrap();
+        if timeout_secs > 0 && last_activity.elapsed() > Duration::from_secs(timeout_secs) {
             self.lock_all_wallets();
         }
-        self.last_activity = Instant::now();
+        *last_activity = Instant::now();
     }
 
     /// Create a new wallet. Returns the generated password.
@@ -91,7 +104,7 @@ impl WalletManager {
         let password = generate_password();
 
         let wallet = Wallet::create(name, &password, &self.wallet_dir)?;
-        self.wallets.insert(name.to_string(), wallet);
+        self.wallets.insert(name.to_string(), RwLock::new(wallet));
 
         Ok(password)
     }
@@ -105,18 +118,18 @@ impl WalletManager {
         }
 
         let wallet = Wallet::open(name, &self.wallet_dir)?;
-        self.wallets.insert(name.to_string(), wallet);
+        self.wallets.insert(name.to_string(), RwLock::new(wallet));
         Ok(())
     }
 
     /// List all opened wallets. Names with '*' suffix indicate unlocked wallets.
-    pub fn list_wallets(&mut self) -> Vec<String> {
+    pub fn list_wallets(&self) -> Vec<String> {
         self.check_timeout();
 
         self.wallets
             .iter()
             .map(|(name, w)| {
-                if w.is_locked() {
+                if w.read().unwrap().is_locked() {
                     name.clone()
                 } else {
                     format!("{} *", name)
@@ -126,27 +139,27 @@ impl WalletManager {
     }
 
     /// Lock a specific wallet.
-    pub fn lock(&mut self, name: &str) -> Result<(), ManagerError> {
+    pub fn lock(&self, name: &str) -> Result<(), ManagerError> {
         self.check_timeout();
 
         let wallet = self
             .wallets
-            .get_mut(name)
+            .get(name)
             .ok_or_else(|| ManagerError::WalletNotFound(name.to_string()))?;
 
-        wallet.lock();
+        wallet.write().unwrap().lock();
         Ok(())
     }
 
     /// Lock all wallets.
-    pub fn lock_all_wallets(&mut self) {
-        for wallet in self.wallets.values_mut() {
-            wallet.lock();
+    pub fn lock_all_wallets(&self) {
+        for wallet in self.wallets.values() {
+            wallet.write().unwrap().lock();
         }
     }
 
     /// Lock all (public API version).
-    pub fn lock_all(&mut self) -> Result<(), ManagerError> {
+    pub fn lock_all(&self) -> Result<(), ManagerError> {
         self.check_timeout();
         self.lock_all_wallets();
         Ok(())
@@ -166,26 +179,26 @@ impl WalletManager {
             .get_mut(name)
             .ok_or_else(|| ManagerError::WalletNotFound(name.to_string()))?;
 
-        wallet.unlock(password)?;
+        wallet.get_mut().unwrap().unlock(password)?;
         Ok(())
     }
 
     /// Import a WIF private key into the named wallet.
-    pub fn import_key(&mut self, name: &str, wif: &str) -> Result<(), ManagerError> {
+    pub fn import_key(&self, name: &str, wif: &str) -> Result<(), ManagerError> {
         self.check_timeout();
 
         let wallet = self
             .wallets
-            .get_mut(name)
+            .get(name)
             .ok_or_else(|| ManagerError::WalletNotFound(name.to_string()))?;
 
-        wallet.import_key(wif)?;
+        wallet.write().unwrap().import_key(wif)?;
         Ok(())
     }
 
     /// Remove a key from a wallet (requires password).
     pub fn remove_key(
-        &mut self,
+        &self,
         name: &str,
         password: &str,
         public_key: &str,
@@ -194,29 +207,29 @@ impl WalletManager {
 
         let wallet = self
             .wallets
-            .get_mut(name)
+            .get(name)
             .ok_or_else(|| ManagerError::WalletNotFound(name.to_string()))?;
 
-        wallet.remove_key(password, public_key)?;
+        wallet.write().unwrap().remove_key(password, public_key)?;
         Ok(())
     }
 
     /// Create a new key pair inside the named wallet. Returns the public key.
-    pub fn create_key(&mut self, name: &str) -> Result<String, ManagerError> {
+    pub fn create_key(&self, name: &str) -> Result<String, ManagerError> {
         self.check_timeout();
 
         let wallet = self
             .wallets
-            .get_mut(name)
+            .get(name)
             .ok_or_else(|| ManagerError::WalletNotFound(name.to_string()))?;
 
-        let pub_key = wallet.create_key()?;
+        let pub_key = wallet.write().unwrap().create_key()?;
         Ok(pub_key)
     }
 
     /// List keys for a specific wallet (requires name and password).
     pub fn list_keys(
-        &mut self,
+        &self,
         name: &str,
         password: &str,
     ) -> Result<BTreeMap<String, String>, ManagerError> {
@@ -227,18 +240,19 @@ impl WalletManager {
             .get(name)
             .ok_or_else(|| ManagerError::WalletNotFound(name.to_string()))?;
 
-        let keys = wallet.list_keys(password)?;
+        let keys = wallet.read().unwrap().list_keys(password)?;
         Ok(keys)
     }
 
     /// Get all public keys from all unlocked wallets.
-    pub fn get_public_keys(&mut self) -> Result<Vec<String>, ManagerError> {
+    pub fn get_public_keys(&self) -> Result<Vec<String>, ManagerError> {
         self.check_timeout();
 
         let mut all_keys = Vec::new();
         let mut has_unlocked = false;
 
         for wallet in self.wallets.values() {
+            let wallet = wallet.read().unwrap();
             if !wallet.is_locked() {
                 has_unlocked = true;
                 if let Ok(keys) = wallet.list_public_keys() {
@@ -257,8 +271,11 @@ impl WalletManager {
     }
 
     /// Sign a digest with the key matching one of the provided public keys.
+    /// Takes only read locks, so concurrent calls on unlocked wallets sign
+    /// in parallel; the key map never changes while a wallet stays unlocked
+    /// unless an import/remove takes the write lock.
     pub fn sign_digest(
-        &mut self,
+        &self,
         digest: &[u8],
         public_keys: &[String],
     ) -> Result<BTreeMap<String, String>, ManagerError> {
@@ -269,6 +286,7 @@ impl WalletManager {
         for pubkey in public_keys {
             let mut found = false;
             for wallet in self.wallets.values() {
+                let wallet = wallet.read().unwrap();
                 if wallet.is_locked() {
                     continue;
                 }
@@ -287,9 +305,9 @@ impl WalletManager {
     }
 
     /// Set the auto-lock timeout (in seconds).
-    pub fn set_timeout(&mut self, secs: u64) {
-        self.timeout = Duration::from_secs(secs);
-        self.last_activity = Instant::now();
+    pub fn set_timeout(&self, secs: u64) {
+        self.timeout_secs.store(secs, Ordering::Relaxed);
+        *self.last_activity.lock().unwrap() = Instant::now();
     }
 }
 
@@ -394,7 +394,7 @@ mod manager_tests {
 
     #[test]
     fn lock_nonexistent_wallet_fails() {
-        let (_dir, mut mgr) = setup();
+        let (_dir, mgr) = setup();
         assert!(mgr.lock("nope").is_err());
     }
 
@@ -428,7 +428,7 @@ mod manager_tests {
 
     #[test]
     fn import_key_into_nonexistent_wallet_fails() {
-        let (_dir, mut mgr) = setup();
+        let (_dir, mgr) = setup();
         let (wif, _) = keys::generate_keypair().unwrap();
         assert!(mgr.import_key("nope", &wif).is_err());
     }
@@ -533,6 +533,35 @@ mod manager_tests {
         assert_eq!(sigs[&pub_key].len(), 128); // 64 bytes hex
     }
 
+    #[test]
+    fn sign_digest_concurrent_on_same_wallet() {
+        let (_dir, mut mgr) = setup();
+        mgr.create("test").unwrap();
+        let (wif, pub_key) = keys::generate_keypair().unwrap();
+        mgr.import_key("test", &wif).unwrap();
+
+        // Signing takes only read locks, so concurrent requests against the
+        // same unlocked wallet must all succeed without serializing.
+        let mgr = std::sync::Arc::new(mgr);
+        let handles: Vec<_> = (0..8)
+            .map(|i| {
+                let mgr = mgr.clone();
+                let pub_key = pub_key.clone();
+                std::thread::spawn(move || {
+                    let digest = [i as u8; 32];
+                    for _ in 0..4 {
+                        let sigs = mgr.sign_digest(&digest, &[pub_key.clone()]).unwrap();
+                        assert_eq!(sigs.len(), 1);
+                        assert!(sigs.contains_key(&pub_key));
+                    }
+                })
+            })
+            .collect();
+        for handle in handles {
+            handle.join().unwrap();
+        }
+    }
+
     #[test]
     fn sign_digest_with_missing_key_fails() {
         let (_dir, mut mgr) = setup();
@@ -564,7 +593,7 @@ mod manager_tests {
 
     #[test]
     fn set_timeout() {
-        let (_dir, mut mgr) = setup();
+        let (_dir, mgr) = setup();
         // Just verify it doesn't panic
         mgr.set_timeout(0);
         mgr.set_timeout(3600);
@@ -598,7 +627,7 @@ mod api_tests {
     use super::*;
     use actix_web::{http::StatusCode, test};
     use pulsevm_keosd::{api, keys, manager::WalletManager};
-    use std::sync::Mutex;
+    use std::sync::RwLock;
 
     /// Helper: create an actix-web test app with a fresh WalletManager.
     async fn test_app() -> (
@@ -612,7 +641,7 @@ mod api_tests {
         let dir = TempDir::new().unwrap();
         let mgr = WalletManager::new(dir.path().to_path_buf(), 900).unwrap();
         let state = web::Data::new(api::AppState {
-            manager: Mutex::new(mgr),
+            manager: RwLock::new(mgr),
         });
 
         let app =
@@ -1008,6 +1037,60 @@ mod api_tests {
         assert!(hex::decode(&sig).is_ok());
     }
 
+    #[actix_rt::test]
+    async fn api_sign_digests_batch() {
+        let (_dir, app) = test_app().await;
+
+        let req = test::TestRequest::post()
+            .uri("/v1/wallet/create")
+            .set_json("batchsign")
+            .to_request();
+        test::call_service(&app, req).await;
+
+        let (wif, pub_key) = keys::generate_keypair().unwrap();
+        let req = test::TestRequest::post()
+            .uri("/v1/wallet/import_key")
+            .set_json(vec!["batchsign", &wif])
+            .to_request();
+        test::call_service(&app, req).await;
+
+        let digest1 = "01".repeat(32);
+        let digest2 = "02".repeat(32);
+        let req = test::TestRequest::post()
+            .uri("/v1/wallet/sign_digests")
+            .set_json(vec![(&digest1, &pub_key), (&digest2, &pub_key)])
+            .to_request();
+        let resp = test::call_service(&app, req).await;
+        assert_eq!(resp.status(), StatusCode::OK);
+
+        let sigs: Vec<String> = test::read_body_json(resp).await;
+        assert_eq!(sigs.len(), 2);
+        assert_ne!(sigs[0], sigs[1]); // distinct digests, distinct signatures
+        for sig in &sigs {
+            assert_eq!(sig.len(), 128);
+            assert!(hex::decode(sig).is_ok());
+        }
+    }
+
+    #[actix_rt::test]
+    async fn api_sign_digests_missing_key_fails() {
+        let (_dir, app) = test_app().await;
+
+        let req = test::TestRequest::post()
+            .uri("/v1/wallet/create")
+            .set_json("batchfail")
+            .to_request();
+        test::call_service(&app, req).await;
+
+        let digest = "ab".repeat(32);
+        let req = test::TestRequest::post()
+            .uri("/v1/wallet/sign_digests")
+            .set_json(vec![(&digest, "EOSnonexistent")])
+            .to_request();
+        let resp = test::call_service(&app, req).await;
+        assert_eq!(resp.status(), StatusCode::INTERNAL_SERVER_ERROR);
+    }
+
     #[actix_rt::test]
     async fn api_sign_digest_missing_key_fails() {
         let (_dir, app) = test_app().await;
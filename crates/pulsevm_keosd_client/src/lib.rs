@@ -88,13 +88,42 @@ impl From<std::io::Error> for ClientError {
 // ---------------------------------------------------------------------------
 
 enum Transport {
-    /// TCP connection via reqwest.
+    /// TCP connection via reqwest. The reqwest client keeps a connection
+    /// pool, so repeated requests reuse sockets (and TLS sessions) without
+    /// any extra work here.
     Tcp {
         base_url: String,
         client: reqwest::Client,
     },
-    /// Unix domain socket connection using raw HTTP over UDS.
-    Unix { socket_path: PathBuf },
+    /// Unix domain socket connection using raw HTTP over UDS. The stream
+    /// is kept alive between requests and responses are framed by
+    /// Content-Length, so a producer signing every block does not pay a
+    /// connect per signature.
+    Unix {
+        socket_path: PathBuf,
+        conn: UnixConn,
+    },
+}
+
+/// Persistent Unix-socket connection slot. `None` until the first request
+/// or after an I/O error; the mutex serializes requests so responses can
+/// never interleave on the shared stream.
+#[cfg(unix)]
+struct UnixConn(tokio::sync::Mutex<Option<tokio::net::UnixStream>>);
+
+#[cfg(not(unix))]
+struct UnixConn;
+
+impl UnixConn {
+    #[cfg(unix)]
+    fn new() -> Self {
+        UnixConn(tokio::sync::Mutex::new(None))
+    }
+
+    #[cfg(not(unix))]
+    fn new() -> Self {
+        UnixConn
+    }
 }
 
 impl Transport {
@@ -108,7 +137,11 @@ impl Transport {
                 let bytes = resp.bytes().await?.to_vec();
                 Ok((status, bytes))
             }
-            Transport::Unix { socket_path } => unix_post(socket_path, path, body).await,
+            Transport::Unix { socket_path, conn } => {
+                let body_bytes = serde_json::to_vec(body)?;
+                let head = request_head("POST", path, Some(body_bytes.len()));
+                unix_request(socket_path, conn, &head, &body_bytes).await
+            }
         }
     }
 
@@ -123,93 +156,151 @@ impl Transport {
                 let bytes = resp.bytes().await?.to_vec();
                 Ok((status, bytes))
             }
-            Transport::Unix { socket_path } => unix_get(socket_path, path).await,
+            Transport::Unix { socket_path, conn } => {
+                let head = request_head("GET", path, None);
+                unix_request(socket_path, conn, &head, &[]).await
+            }
         }
     }
 }
 
-/// Perform an HTTP POST over a Unix domain socket using raw I/O.
+/// Build an HTTP/1.1 request head. `body_len` is `Some` for requests that
+/// carry a JSON body. Keep-alive is requested so the server leaves the
+/// connection open for the next call.
+fn request_head(method: &str, path: &str, body_len: Option<usize>) -> String {
+    let mut head = format!(
+        "{} {} HTTP/1.1\r\nHost: localhost\r\nConnection: keep-alive\r\n",
+        method, path
+    );
+    if let Some(len) = body_len {
+        head.push_str(&format!(
+            "Content-Type: application/json\r\nContent-Length: {}\r\n",
+            len
+        ));
+    }
+    head.push_str("\r\n");
+    head
+}
+
+/// Send one request over the persistent Unix-socket connection, connecting
+/// on first use and reconnecting once if a kept-alive stream turns out to
+/// have been closed by the server between calls.
 #[cfg(unix)]
-async fn unix_post(
+async fn unix_request(
     socket_path: &Path,
-    path: &str,
-    body: &Value,
+    conn: &UnixConn,
+    head: &str,
+    body: &[u8],
 ) -> Result<(u16, Vec<u8>), ClientError> {
-    use tokio::io::{AsyncReadExt, AsyncWriteExt};
     use tokio::net::UnixStream;
 
-    let body_bytes = serde_json::to_vec(body)?;
-    let request = format!(
-        "POST {} HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\nContent-Length: {}\r\nConnection: close\r\n\r\n",
-        path,
-        body_bytes.len()
-    );
-
-    let mut stream = UnixStream::connect(socket_path).await?;
-    stream.write_all(request.as_bytes()).await?;
-    stream.write_all(&body_bytes).await?;
-    stream.flush().await?;
-
-    let mut response = Vec::new();
-    stream.read_to_end(&mut response).await?;
-
-    parse_http_response(&response)
+    let mut slot = conn.0.lock().await;
+    loop {
+        let fresh = slot.is_none();
+        if fresh {
+            *slot = Some(UnixStream::connect(socket_path).await?);
+        }
+        let stream = slot.as_mut().expect("connected above");
+        match send_request(stream, head, body).await {
+            Ok((status, bytes, reusable)) => {
+                if !reusable {
+                    *slot = None;
+                }
+                return Ok((status, bytes));
+            }
+            Err(e) => {
+                *slot = None;
+                // Only a request over a previously kept-alive stream gets a
+                // retry: the server may have closed it between calls.
+                if fresh {
+                    return Err(e);
+                }
+            }
+        }
+    }
 }
 
-/// Perform an HTTP GET over a Unix domain socket using raw I/O.
+/// Write one request and read exactly one response off the stream. Returns
+/// (status, body, reusable) where `reusable` is false if the response had
+/// no Content-Length or the server announced `Connection: close`.
 #[cfg(unix)]
-async fn unix_get(socket_path: &Path, path: &str) -> Result<(u16, Vec<u8>), ClientError> {
+async fn send_request(
+    stream: &mut tokio::net::UnixStream,
+    head: &str,
+    body: &[u8],
+) -> Result<(u16, Vec<u8>, bool), ClientError> {
     use tokio::io::{AsyncReadExt, AsyncWriteExt};
-    use tokio::net::UnixStream;
-
-    let request = format!(
-        "GET {} HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n",
-        path
-    );
 
-    let mut stream = UnixStream::connect(socket_path).await?;
-    stream.write_all(request.as_bytes()).await?;
+    stream.write_all(head.as_bytes()).await?;
+    stream.write_all(body).await?;
     stream.flush().await?;
 
-    let mut response = Vec::new();
-    stream.read_to_end(&mut response).await?;
-
-    parse_http_response(&response)
+    let mut buf = Vec::with_capacity(1024);
+    let header_end = loop {
+        if let Some(pos) = find_header_end(&buf) {
+            break pos;
+        }
+        let mut chunk = [0u8; 4096];
+        let n = stream.read(&mut chunk).await?;
+        if n == 0 {
+            return Err(ClientError::UnixSocket(
+                "connection closed before response headers".to_string(),
+            ));
+        }
+        buf.extend_from_slice(&chunk[..n]);
+    };
+
+    let (status, content_length, keep_alive) = parse_response_head(&buf[..header_end])?;
+    let mut response_body = buf.split_off(header_end + 4);
+    match content_length {
+        Some(len) => {
+            while response_body.len() < len {
+                let mut chunk = [0u8; 4096];
+                let n = stream.read(&mut chunk).await?;
+                if n == 0 {
+                    return Err(ClientError::UnixSocket(
+                        "connection closed mid-body".to_string(),
+                    ));
+                }
+                response_body.extend_from_slice(&chunk[..n]);
+            }
+            response_body.truncate(len);
+            Ok((status, response_body, keep_alive))
+        }
+        None => {
+            // Without a length the only framing is EOF, so drain the stream
+            // and retire the connection.
+            stream.read_to_end(&mut response_body).await?;
+            Ok((status, response_body, false))
+        }
+    }
 }
 
 #[cfg(not(unix))]
-async fn unix_post(
+async fn unix_request(
     _socket_path: &Path,
-    _path: &str,
-    _body: &Value,
+    _conn: &UnixConn,
+    _head: &str,
+    _body: &[u8],
 ) -> Result<(u16, Vec<u8>), ClientError> {
     Err(ClientError::UnixSocket(
         "Unix sockets not supported on this platform".to_string(),
     ))
 }
 
-#[cfg(not(unix))]
-async fn unix_get(_socket_path: &Path, _path: &str) -> Result<(u16, Vec<u8>), ClientError> {
-    Err(ClientError::UnixSocket(
-        "Unix sockets not supported on this platform".to_string(),
-    ))
+/// Find the `\r\n\r\n` header terminator, returning its offset.
+fn find_header_end(buf: &[u8]) -> Option<usize> {
+    buf.windows(4).position(|w| w == b"\r\n\r\n")
 }
 
-/// Parse a raw HTTP/1.1 response into (status_code, body_bytes).
-fn parse_http_response(raw: &[u8]) -> Result<(u16, Vec<u8>), ClientError> {
-    let raw_str = String::from_utf8_lossy(raw);
-
-    // Find the end of headers
-    let header_end = raw_str.find("\r\n\r\n").ok_or_else(|| {
-        ClientError::Parse("Malformed HTTP response: no header terminator".to_string())
-    })?;
-
-    let headers = &raw_str[..header_end];
-    let body = &raw[header_end + 4..];
+/// Parse an HTTP/1.1 response head (everything before the blank line) into
+/// (status_code, content_length, keep_alive).
+fn parse_response_head(head: &[u8]) -> Result<(u16, Option<usize>, bool), ClientError> {
+    let head = String::from_utf8_lossy(head);
+    let mut lines = head.lines();
 
     // Parse status line: "HTTP/1.1 200 OK"
-    let status_line = headers
-        .lines()
+    let status_line = lines
         .next()
         .ok_or_else(|| ClientError::Parse("Empty HTTP response".to_string()))?;
     let status_code: u16 = status_line
@@ -218,7 +309,21 @@ fn parse_http_response(raw: &[u8]) -> Result<(u16, Vec<u8>), ClientError> {
         .and_then(|s| s.parse().ok())
         .ok_or_else(|| ClientError::Parse(format!("Cannot parse status from: {}", status_line)))?;
 
-    Ok((status_code, body.to_vec()))
+    let mut content_length = None;
+    let mut keep_alive = true; // HTTP/1.1 default
+    for line in lines {
+        let Some((name, value)) = line.split_once(':') else {
+            continue;
+        };
+        let value = value.trim();
+        if name.eq_ignore_ascii_case("content-length") {
+            content_length = value.parse().ok();
+        } else if name.eq_ignore_ascii_case("connection") {
+            keep_alive = !value.eq_ignore_ascii_case("close");
+        }
+    }
+
+    Ok((status_code, content_length, keep_alive))
 }
 
 // ---------------------------------------------------------------------------
@@ -257,6 +362,7 @@ impl KeosdClient {
         KeosdClient {
             transport: Transport::Unix {
                 socket_path: socket_path.as_ref().to_path_buf(),
+                conn: UnixConn::new(),
             },
         }
     }
@@ -472,6 +578,21 @@ impl KeosdClient {
         .await
     }
 
+    /// Sign a batch of hex-encoded digests in a single request. Each entry
+    /// pairs a digest with the public key that should sign it; signatures
+    /// come back in request order. One round trip (and one wallet lock on
+    /// the server) covers the whole batch, which is what a block producer
+    /// wants when it signs a block plus pending API transactions together.
+    ///
+    /// `POST /v1/wallet/sign_digests`
+    pub async fn sign_digests(
+        &self,
+        requests: &[(String, String)],
+    ) -> Result<Vec<String>, ClientError> {
+        self.post("/v1/wallet/sign_digests", &serde_json::json!(requests))
+            .await
+    }
+
     /// Sign a transaction with the specified public keys and chain ID.
     /// Returns the transaction JSON with `signatures` attached.
     ///
@@ -511,25 +632,47 @@ mod tests {
     use super::*;
 
     #[test]
-    fn parse_http_response_ok() {
-        let raw = b"HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n\"hello\"";
-        let (status, body) = parse_http_response(raw).unwrap();
+    fn parse_response_head_ok() {
+        let head = b"HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 7";
+        let (status, content_length, keep_alive) = parse_response_head(head).unwrap();
         assert_eq!(status, 200);
-        assert_eq!(body, b"\"hello\"");
+        assert_eq!(content_length, Some(7));
+        assert!(keep_alive);
     }
 
     #[test]
-    fn parse_http_response_error() {
-        let raw = b"HTTP/1.1 500 Internal Server Error\r\nContent-Type: application/json\r\n\r\n{\"code\":500}";
-        let (status, body) = parse_http_response(raw).unwrap();
+    fn parse_response_head_connection_close() {
+        let head = b"HTTP/1.1 500 Internal Server Error\r\nConnection: close";
+        let (status, content_length, keep_alive) = parse_response_head(head).unwrap();
         assert_eq!(status, 500);
-        assert_eq!(body, b"{\"code\":500}");
+        assert_eq!(content_length, None);
+        assert!(!keep_alive);
     }
 
     #[test]
-    fn parse_http_response_malformed() {
-        let raw = b"garbage data";
-        assert!(parse_http_response(raw).is_err());
+    fn parse_response_head_malformed() {
+        assert!(parse_response_head(b"garbage data").is_err());
+    }
+
+    #[test]
+    fn find_header_end_frames_response() {
+        let raw = b"HTTP/1.1 200 OK\r\nContent-Length: 7\r\n\r\n\"hello\"";
+        let pos = find_header_end(raw).unwrap();
+        assert_eq!(&raw[pos + 4..], b"\"hello\"");
+        assert!(find_header_end(b"HTTP/1.1 200 OK\r\n").is_none());
+    }
+
+    #[test]
+    fn request_head_keeps_connection_alive() {
+        let head = request_head("POST", "/v1/wallet/sign_digests", Some(42));
+        assert!(head.starts_with("POST /v1/wallet/sign_digests HTTP/1.1\r\n"));
+        assert!(head.contains("Connection: keep-alive\r\n"));
+        assert!(head.contains("Content-Length: 42\r\n"));
+        assert!(head.ends_with("\r\n\r\n"));
+
+        let get = request_head("GET", "/v1/wallet/list_wallets", None);
+        assert!(!get.contains("Content-Length"));
+        assert!(get.ends_with("\r\n\r\n"));
     }
 
     #[test]
@@ -555,7 +698,7 @@ mod tests {
     fn client_unix_constructor() {
         let client = KeosdClient::unix("/tmp/keosd.sock");
         match &client.transport {
-            Transport::Unix { socket_path } => {
+            Transport::Unix { socket_path, .. } => {
                 assert_eq!(socket_path, &PathBuf::from("/tmp/keosd.sock"))
             }
             _ => panic!("Expected Unix transport"),
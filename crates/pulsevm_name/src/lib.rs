@@ -10,7 +10,7 @@ use syn::{
 };
 
 mod utils;
-pub use utils::{NAME_CHARS, NAME_MAX_LEN, name_from_bytes, name_to_bytes};
+pub use utils::{NAME_CHARS, NAME_MAX_LEN, name_from_bytes, name_from_str, name_to_bytes};
 
 #[derive(Clone, Copy, Debug, PartialEq)]
 pub enum ParseNameError {
@@ -45,9 +45,32 @@ impl Name {
         self.0 == 0
     }
 
-    pub fn as_bytes(&self) -> [u8; NAME_MAX_LEN] {
+    /// Parses a name at compile time when used in a `const` context; the
+    /// `name!` proc macro is the usual spelling, this serves call sites
+    /// that cannot take the proc-macro dependency.
+    pub const fn from_str_const(s: &str) -> Result<Self, ParseNameError> {
+        match name_from_str(s) {
+            Ok(value) => Ok(Self(value)),
+            Err(e) => Err(e),
+        }
+    }
+
+    pub const fn as_bytes(&self) -> [u8; NAME_MAX_LEN] {
         name_to_bytes(self.0)
     }
+
+    /// Renders into a caller-provided stack buffer and returns the name
+    /// with trailing dots trimmed, so `Display` and serialization skip the
+    /// intermediate `String`.
+    fn trimmed<'a>(&self, buf: &'a mut [u8; NAME_MAX_LEN]) -> &'a str {
+        *buf = name_to_bytes(self.0);
+        let mut len = NAME_MAX_LEN;
+        while len > 0 && buf[len - 1] == b'.' {
+            len -= 1;
+        }
+        // The buffer only ever holds bytes out of NAME_CHARS, all ASCII.
+        str::from_utf8(&buf[..len]).unwrap_or_default()
+    }
 }
 
 impl From<u64> for Name {
@@ -62,10 +85,25 @@ impl From<Name> for u64 {
     }
 }
 
+/// Counts runtime string-to-name parses. Internal call sites with a
+/// constant string should use the compile-time `name!` macro instead;
+/// watching this counter while exercising a code path is how we find the
+/// stragglers. Only maintained in debug builds.
+#[cfg(debug_assertions)]
+static RUNTIME_NAME_PARSES: std::sync::atomic::AtomicU64 = std::sync::atomic::AtomicU64::new(0);
+
+#[cfg(debug_assertions)]
+pub fn runtime_parse_count() -> u64 {
+    RUNTIME_NAME_PARSES.load(std::sync::atomic::Ordering::Relaxed)
+}
+
 impl FromStr for Name {
     type Err = ChainError;
 
     fn from_str(s: &str) -> Result<Self, Self::Err> {
+        #[cfg(debug_assertions)]
+        RUNTIME_NAME_PARSES.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+
         // First try to parse as u64
         if let Ok(value) = s.parse::<u64>() {
             return Ok(value.into()); // assuming `u64: Into<YourType>`
@@ -90,11 +128,8 @@ impl fmt::Debug for Name {
 impl fmt::Display for Name {
     #[inline]
     fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
-        let bytes = self.as_bytes();
-        let value = str::from_utf8(&bytes)
-            .map(|s| s.trim_end_matches('.'))
-            .map_err(|_| fmt::Error)?;
-        write!(f, "{}", value)
+        let mut buf = [b'.'; NAME_MAX_LEN];
+        f.write_str(self.trimmed(&mut buf))
     }
 }
 
@@ -123,7 +158,8 @@ impl Serialize for Name {
     where
         S: serde::Serializer,
     {
-        serializer.serialize_str(&self.to_string())
+        let mut buf = [b'.'; NAME_MAX_LEN];
+        serializer.serialize_str(self.trimmed(&mut buf))
     }
 }
 
@@ -142,7 +178,7 @@ impl Parse for Name {
         let name = input.parse::<LitStr>()?.value();
         name_from_bytes(name.bytes())
             .map(Self)
-            .map_err(|_e| input.error("failed to parse name"))
+            .map_err(|e| input.error(format!("failed to parse name: {}", e)))
     }
 }
 
@@ -168,4 +204,42 @@ mod tests {
         let name = Name::from_str("oracles").unwrap();
         assert_eq!(name.as_u64(), 6138663577826885632);
     }
+
+    #[test]
+    fn test_const_parse_matches_runtime() {
+        const NEWACCOUNT: Name = match Name::from_str_const("newaccount") {
+            Ok(name) => name,
+            Err(_) => Name::new(0),
+        };
+        assert_eq!(
+            NEWACCOUNT.as_u64(),
+            name_from_bytes("newaccount".bytes()).unwrap()
+        );
+        assert_eq!(NEWACCOUNT.to_string(), "newaccount");
+    }
+
+    #[test]
+    fn test_const_parse_rejects_bad_input() {
+        assert_eq!(name_from_str("Bad"), Err(ParseNameError::BadChar(b'B')));
+        assert_eq!(
+            name_from_str("aaaaaaaaaaaak"),
+            Err(ParseNameError::BadChar(b'k'))
+        );
+        assert_eq!(name_from_str("aaaaaaaaaaaaaa"), Err(ParseNameError::TooLong));
+    }
+
+    #[cfg(debug_assertions)]
+    #[test]
+    fn test_runtime_parse_counter() {
+        let before = runtime_parse_count();
+        let _ = Name::from_str("oracles").unwrap();
+        assert!(runtime_parse_count() > before);
+    }
+
+    #[test]
+    fn test_thirteen_char_round_trip() {
+        let value = name_from_str("12345abcdefgj").unwrap();
+        assert_eq!(value, name_from_bytes("12345abcdefgj".bytes()).unwrap());
+        assert_eq!(Name::new(value).to_string(), "12345abcdefgj");
+    }
 }
@@ -3,6 +3,28 @@ use crate::ParseNameError;
 pub const NAME_CHARS: [u8; 32] = *b".12345abcdefghijklmnopqrstuvwxyz";
 pub const NAME_MAX_LEN: usize = 13;
 
+/// Symbol value for every possible byte, with `0xFF` marking characters
+/// outside the base32 alphabet. One indexed load replaces the three-way
+/// range compare the decoder used to do per character, and the table is
+/// `const` so the compile-time parser shares it.
+const NAME_SYMBOLS: [u8; 256] = build_symbol_table();
+
+const fn build_symbol_table() -> [u8; 256] {
+    let mut table = [0xFF_u8; 256];
+    table[b'.' as usize] = 0;
+    let mut c = b'1';
+    while c <= b'5' {
+        table[c as usize] = c - b'1' + 1;
+        c += 1;
+    }
+    let mut c = b'a';
+    while c <= b'z' {
+        table[c as usize] = c - b'a' + 6;
+        c += 1;
+    }
+    table
+}
+
 #[inline]
 pub fn name_from_bytes<I>(mut iter: I) -> Result<u64, ParseNameError>
 where
@@ -50,37 +72,74 @@ where
     Ok(value)
 }
 
+/// `const` counterpart of [`name_from_bytes`] over a string slice, for name
+/// constants in crates that do not pull in the `name!` proc macro. Same
+/// alphabet, same 13-character limit, evaluated entirely at compile time
+/// when used in a `const` context.
+pub const fn name_from_str(s: &str) -> Result<u64, ParseNameError> {
+    let bytes = s.as_bytes();
+    let mut value = 0_u64;
+    let mut len = 0_u64;
+    let head = if bytes.len() < 12 { bytes.len() } else { 12 };
+
+    while (len as usize) < head {
+        let c = bytes[len as usize];
+        let v = NAME_SYMBOLS[c as usize];
+        if v == 0xFF {
+            return Err(ParseNameError::BadChar(c));
+        }
+        value = (value << 5) | v as u64;
+        len += 1;
+    }
+
+    if len == 0 {
+        return Ok(0);
+    }
+
+    value <<= 4 + 5 * (12 - len);
+
+    if bytes.len() > 12 {
+        let c = bytes[12];
+        let v = NAME_SYMBOLS[c as usize];
+        // The 13th character carries only 4 bits: '.', '1'-'5' or 'a'-'j'.
+        if v > 0x0F {
+            return Err(ParseNameError::BadChar(c));
+        }
+        value |= v as u64;
+
+        if bytes.len() > 13 {
+            return Err(ParseNameError::TooLong);
+        }
+    }
+
+    Ok(value)
+}
+
 /// Converts a character to a symbol.
 #[inline]
 fn char_to_value(c: u8) -> Option<u8> {
-    if c == b'.' {
-        Some(0)
-    } else if c >= b'1' && c <= b'5' {
-        Some(c - b'1' + 1)
-    } else if c >= b'a' && c <= b'z' {
-        Some(c - b'a' + 6)
-    } else {
-        None
+    match NAME_SYMBOLS[c as usize] {
+        0xFF => None,
+        v => Some(v),
     }
 }
 
 #[inline]
 #[must_use]
-pub fn name_to_bytes(value: u64) -> [u8; NAME_MAX_LEN] {
+pub const fn name_to_bytes(value: u64) -> [u8; NAME_MAX_LEN] {
     let mut chars = [b'.'; NAME_MAX_LEN];
     if value == 0 {
         return chars;
     }
 
-    let mask = 0xF800_0000_0000_0000;
-    let mut v = value;
-    for (i, c) in chars.iter_mut().enumerate() {
-        let index = (v & mask) >> (if i == 12 { 60 } else { 59 });
-        let index = usize::try_from(index).unwrap_or_default();
-        if let Some(v) = NAME_CHARS.get(index) {
-            *c = *v;
-        }
-        v <<= 5;
+    // Every index is masked into the table's range, so the encode loop is
+    // a fixed 12 loads plus one for the 4-bit 13th character — no bounds
+    // branches on the hot `Display`/serialization path.
+    let mut i = 0;
+    while i < 12 {
+        chars[i] = NAME_CHARS[((value >> (59 - 5 * i)) & 0x1F) as usize];
+        i += 1;
     }
+    chars[12] = NAME_CHARS[(value & 0x0F) as usize];
     chars
 }
@@ -7,6 +7,9 @@ pub use varint::*;
 
 mod primitives;
 
+mod read_ref;
+pub use read_ref::ReadRef;
+
 pub trait NumBytes {
     /// Count the number of bytes a type is expected to use.
     fn num_bytes(&self) -> usize;
@@ -56,7 +59,10 @@ impl From<WriteError> for ChainError {
     }
 }
 
-pub trait Write: Sized + NumBytes {
+// No `Sized` bound: `Write` is implemented for `[T]` so slice-backed
+// fields serialize without going through an owned `Vec`, and every
+// method only takes `&self`.
+pub trait Write: NumBytes {
     fn write(&self, bytes: &mut [u8], pos: &mut usize) -> Result<(), WriteError>;
 
     #[inline(always)]
@@ -66,6 +72,41 @@ pub trait Write: Sized + NumBytes {
         self.write(&mut bytes, &mut 0)?;
         Ok(bytes)
     }
+
+    /// Serialize into a caller-provided buffer instead of allocating a fresh
+    /// `Vec`. The buffer is sized exactly to `num_bytes` up front (its
+    /// capacity is reused across calls), so repeated serialization into the
+    /// same buffer allocates only when the payload outgrows every previous
+    /// one.
+    #[inline(always)]
+    fn pack_into(&self, buf: &mut Vec<u8>) -> Result<(), WriteError> {
+        let num_bytes = self.num_bytes();
+        buf.clear();
+        buf.resize(num_bytes, 0);
+        self.write(buf, &mut 0)
+    }
+}
+
+std::thread_local! {
+    static PACK_BUFFER: core::cell::RefCell<Vec<u8>> = const { core::cell::RefCell::new(Vec::new()) };
+}
+
+/// Serialize `value` into a thread-local reusable buffer and hand the bytes
+/// to `f`. Hot paths that pack large values once per block (trace storage,
+/// state-history appends) keep one arena per thread instead of growing and
+/// dropping a fresh `Vec` every time. Re-entrant calls (packing from inside
+/// `f`) fall back to a fresh buffer rather than aliasing the arena.
+pub fn pack_with_buffer<T: Write, R>(
+    value: &T,
+    f: impl FnOnce(&[u8]) -> R,
+) -> Result<R, WriteError> {
+    PACK_BUFFER.with(|cell| match cell.try_borrow_mut() {
+        Ok(mut buf) => {
+            value.pack_into(&mut buf)?;
+            Ok(f(&buf))
+        }
+        Err(_) => Ok(f(&value.pack()?)),
+    })
 }
 
 #[derive(Debug, Clone)]
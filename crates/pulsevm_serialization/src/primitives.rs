@@ -6,14 +6,43 @@ use std::{
 
 use crate::{NumBytes, Read, ReadError, VarUint32, Write, WriteError};
 
-#[inline]
-fn take<const N: usize>(bytes: &mut &[u8]) -> Result<[u8; N], ReadError> {
-    if bytes.len() < N {
-        return Err(ReadError::NotEnoughBytes);
+// Fixed-size byte arrays serialize as raw bytes, no length prefix: the
+// width is part of the type, matching how the fixed-width crypto types
+// (signatures, keys, digests) lay themselves out on the wire. The const
+// generic keeps every instantiation a single bounds check and memcpy —
+// no per-element loop, no intermediate allocation.
+impl<const N: usize> NumBytes for [u8; N] {
+    #[inline]
+    fn num_bytes(&self) -> usize {
+        N
+    }
+}
+
+impl<const N: usize> Read for [u8; N] {
+    #[inline]
+    fn read(bytes: &[u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let end = pos.checked_add(N).ok_or(ReadError::NotEnoughBytes)?;
+        if bytes.len() < end {
+            return Err(ReadError::NotEnoughBytes);
+        }
+        let mut out = [0u8; N];
+        out.copy_from_slice(&bytes[*pos..end]);
+        *pos = end;
+        Ok(out)
+    }
+}
+
+impl<const N: usize> Write for [u8; N] {
+    #[inline]
+    fn write(&self, bytes: &mut [u8], pos: &mut usize) -> Result<(), WriteError> {
+        let end = pos.checked_add(N).ok_or(WriteError::NotEnoughSpace)?;
+        if bytes.len() < end {
+            return Err(WriteError::NotEnoughSpace);
+        }
+        bytes[*pos..end].copy_from_slice(self);
+        *pos = end;
+        Ok(())
     }
-    let (head, tail) = bytes.split_at(N);
-    *bytes = tail;
-    Ok(head.try_into().unwrap())
 }
 
 impl NumBytes for usize {
@@ -205,11 +234,7 @@ impl Read for usize {
 impl Read for u8 {
     #[inline]
     fn read(bytes: &[u8], pos: &mut usize) -> Result<Self, ReadError> {
-        // adapt for your current signature; or change your trait to take &mut &[u8]
-        let mut b = &bytes[*pos..];
-        let arr = take::<1>(&mut b)?;
-        *pos += 1; // if you keep the pos API
-        Ok(u8::from_le_bytes(arr))
+        Ok(u8::from_le_bytes(<[u8; 1]>::read(bytes, pos)?))
     }
 }
 
@@ -224,11 +249,7 @@ impl Read for i8 {
 impl Read for u16 {
     #[inline]
     fn read(bytes: &[u8], pos: &mut usize) -> Result<Self, ReadError> {
-        // adapt for your current signature; or change your trait to take &mut &[u8]
-        let mut b = &bytes[*pos..];
-        let arr = take::<2>(&mut b)?;
-        *pos += 2; // if you keep the pos API
-        Ok(u16::from_le_bytes(arr))
+        Ok(u16::from_le_bytes(<[u8; 2]>::read(bytes, pos)?))
     }
 }
 
@@ -243,11 +264,7 @@ impl Read for i16 {
 impl Read for u32 {
     #[inline]
     fn read(bytes: &[u8], pos: &mut usize) -> Result<Self, ReadError> {
-        // adapt for your current signature; or change your trait to take &mut &[u8]
-        let mut b = &bytes[*pos..];
-        let arr = take::<4>(&mut b)?;
-        *pos += 4; // if you keep the pos API
-        Ok(u32::from_le_bytes(arr))
+        Ok(u32::from_le_bytes(<[u8; 4]>::read(bytes, pos)?))
     }
 }
 
@@ -262,11 +279,7 @@ impl Read for i32 {
 impl Read for u64 {
     #[inline]
     fn read(bytes: &[u8], pos: &mut usize) -> Result<Self, ReadError> {
-        // adapt for your current signature; or change your trait to take &mut &[u8]
-        let mut b = &bytes[*pos..];
-        let arr = take::<8>(&mut b)?;
-        *pos += 8; // if you keep the pos API
-        Ok(u64::from_le_bytes(arr))
+        Ok(u64::from_le_bytes(<[u8; 8]>::read(bytes, pos)?))
     }
 }
 
@@ -608,6 +621,17 @@ impl<T: Write> Write for Option<T> {
     }
 }
 
+impl<T: Write> Write for [T] {
+    #[inline]
+    fn write(&self, bytes: &mut [u8], pos: &mut usize) -> Result<(), WriteError> {
+        self.len().write(bytes, pos)?;
+        for item in self.iter() {
+            item.write(bytes, pos)?;
+        }
+        Ok(())
+    }
+}
+
 impl<T: Write> Write for Vec<T> {
     #[inline]
     fn write(&self, bytes: &mut [u8], pos: &mut usize) -> Result<(), WriteError> {
@@ -706,9 +730,47 @@ impl<T: Write> Write for Arc<T> {
 mod tests {
     use super::*;
 
+    #[test]
+    fn fixed_arrays_round_trip_without_length_prefix() {
+        let arr = [1u8, 2, 3, 4, 5];
+        assert_eq!(arr.num_bytes(), 5);
+
+        let packed = arr.pack().unwrap();
+        assert_eq!(packed, arr); // raw bytes, no prefix
+        assert_eq!(<[u8; 5]>::read(&packed, &mut 0).unwrap(), arr);
+
+        // A short buffer fails the single up-front bounds check.
+        assert!(matches!(
+            <[u8; 5]>::read(&packed[..4], &mut 0),
+            Err(ReadError::NotEnoughBytes)
+        ));
+    }
+
     #[test]
     fn string_num_bytes() {
         assert_eq!("".to_string().num_bytes(), 1);
         assert_eq!("hello".to_string().num_bytes(), 6);
     }
+
+    #[test]
+    fn pack_into_reuses_capacity() {
+        let mut buf = Vec::new();
+        let big = vec![7u8; 1024];
+        big.pack_into(&mut buf).unwrap();
+        assert_eq!(buf, big.pack().unwrap());
+        let capacity = buf.capacity();
+
+        // A smaller payload reuses the allocation and sizes exactly.
+        let small = vec![1u8, 2, 3];
+        small.pack_into(&mut buf).unwrap();
+        assert_eq!(buf, small.pack().unwrap());
+        assert_eq!(buf.capacity(), capacity);
+    }
+
+    #[test]
+    fn pack_with_buffer_sees_packed_bytes() {
+        let value = "hello".to_string();
+        let bytes = crate::pack_with_buffer(&value, |bytes| bytes.to_vec()).unwrap();
+        assert_eq!(bytes, value.pack().unwrap());
+    }
 }
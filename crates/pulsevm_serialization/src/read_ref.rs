@@ -0,0 +1,145 @@
+use std::borrow::Cow;
+use std::collections::VecDeque;
+
+use crate::{Read, ReadError};
+
+/// Borrowed-read counterpart of [`Read`]. Where `Read` materializes owned
+/// `String`s and `Vec<u8>`s for every length-prefixed field, `read_ref`
+/// decodes over the source buffer and hands out slices that borrow from it,
+/// so hot paths (block parsing over a gossip buffer) allocate nothing for
+/// payload fields. The wire format is identical to `Read`; convert to owned
+/// data only when the decoded value outlives the buffer.
+pub trait ReadRef<'a>: Sized {
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError>;
+}
+
+// Fixed-size values carry no payload to borrow; delegate to `Read`.
+macro_rules! read_ref_via_read {
+    ($($t:ty),*) => {$(
+        impl<'a> ReadRef<'a> for $t {
+            #[inline]
+            fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+                <$t as Read>::read(bytes, pos)
+            }
+        }
+    )*};
+}
+
+read_ref_via_read!(bool, u8, i8, u16, i16, u32, i32, u64, i64, f32, f64, usize);
+
+/// Length-prefixed byte payload borrowed from the buffer; same wire format
+/// as `Vec<u8>` and `Bytes`.
+impl<'a> ReadRef<'a> for &'a [u8] {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let len = usize::read(bytes, pos)?;
+
+        if bytes.len() < *pos + len {
+            return Err(ReadError::NotEnoughBytes);
+        }
+
+        let slice = &bytes[*pos..*pos + len];
+        *pos += len;
+        Ok(slice)
+    }
+}
+
+/// Length-prefixed UTF-8 borrowed from the buffer; same wire format as
+/// `String`.
+impl<'a> ReadRef<'a> for &'a str {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let slice = <&[u8]>::read_ref(bytes, pos)?;
+        str::from_utf8(slice).map_err(|_| ReadError::ParseError)
+    }
+}
+
+impl<'a> ReadRef<'a> for Cow<'a, [u8]> {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        Ok(Cow::Borrowed(<&[u8]>::read_ref(bytes, pos)?))
+    }
+}
+
+impl<'a> ReadRef<'a> for Cow<'a, str> {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        Ok(Cow::Borrowed(<&str>::read_ref(bytes, pos)?))
+    }
+}
+
+impl<'a, T: ReadRef<'a>> ReadRef<'a> for Vec<T> {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let len = usize::read(bytes, pos)?;
+        let mut vec = Vec::with_capacity(len);
+        for _ in 0..len {
+            vec.push(T::read_ref(bytes, pos)?);
+        }
+        Ok(vec)
+    }
+}
+
+impl<'a, T: ReadRef<'a>> ReadRef<'a> for VecDeque<T> {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let len = usize::read(bytes, pos)?;
+        let mut vec = VecDeque::with_capacity(len);
+        for _ in 0..len {
+            vec.push_back(T::read_ref(bytes, pos)?);
+        }
+        Ok(vec)
+    }
+}
+
+impl<'a, T: ReadRef<'a>> ReadRef<'a> for Option<T> {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let is_some = bool::read(bytes, pos)?;
+        if is_some {
+            Ok(Some(T::read_ref(bytes, pos)?))
+        } else {
+            Ok(None)
+        }
+    }
+}
+
+impl<'a, T1: ReadRef<'a>, T2: ReadRef<'a>> ReadRef<'a> for (T1, T2) {
+    #[inline]
+    fn read_ref(bytes: &'a [u8], pos: &mut usize) -> Result<Self, ReadError> {
+        let first = T1::read_ref(bytes, pos)?;
+        let second = T2::read_ref(bytes, pos)?;
+        Ok((first, second))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::Write;
+
+    #[test]
+    fn borrowed_bytes_match_owned_read() {
+        let payload = vec![1u8, 2, 3, 4];
+        let packed = payload.pack().unwrap();
+
+        let mut pos = 0;
+        let borrowed = <&[u8]>::read_ref(&packed, &mut pos).unwrap();
+        assert_eq!(borrowed, payload.as_slice());
+        assert_eq!(pos, packed.len());
+
+        // Same wire format, no truncation tolerance.
+        assert!(<&[u8]>::read_ref(&packed[..packed.len() - 1], &mut 0).is_err());
+    }
+
+    #[test]
+    fn borrowed_str_validates_utf8() {
+        let packed = "hello".to_string().pack().unwrap();
+        let s = <&str>::read_ref(&packed, &mut 0).unwrap();
+        assert_eq!(s, "hello");
+
+        let mut bad = packed.clone();
+        bad[1] = 0xff;
+        assert!(<&str>::read_ref(&bad, &mut 0).is_err());
+    }
+}
@@ -3,7 +3,14 @@ mod unittests;
 
 #[cfg(test)]
 mod tests {
-    use std::{collections::BTreeSet, fs, path::Path, str::FromStr, sync::Arc, u32, vec};
+    use std::{
+        collections::BTreeSet,
+        fs,
+        path::Path,
+        str::FromStr,
+        sync::{Arc, LazyLock},
+        u32, vec,
+    };
 
     use pulsevm_core::{
         ACTIVE_NAME, CODE_NAME, ChainError, Database, OWNER_NAME, PULSE_NAME,
@@ -40,42 +47,100 @@ mod tests {
         pub pending_block_state: Option<PendingBlockState>,
     }
 
+    /// Fully bootstrapped genesis state — chain initialized and the bios
+    /// contract deployed — built once per test process and cloned into every
+    /// test's own temp directory. Bootstrapping dominates test setup time, so
+    /// sharing it lets the suite run fully parallel; each test still gets a
+    /// private database it can mutate freely.
+    static GENESIS_TEMPLATE: LazyLock<tempfile::TempDir> = LazyLock::new(build_genesis_template);
+
+    fn build_genesis_template() -> tempfile::TempDir {
+        let dir = tempfile::tempdir().expect("Failed to create template dir");
+        let private_key = get_private_key(PULSE_NAME.into(), "active");
+        let mut controller = Controller::new();
+        controller
+            .initialize(
+                &test_chain_id(),
+                &test_node_config(&private_key),
+                &generate_genesis(&private_key),
+                dir.path().to_str().unwrap(),
+            )
+            .expect("Failed to initialize template controller");
+
+        let mut suite = Testing {
+            controller,
+            pending_block_state: None,
+        };
+        suite
+            .set_bios_contract()
+            .expect("Failed to set bios contract");
+
+        // Close the database so the template's data file on disk is complete
+        // and carries a clean-shutdown marker; clones of a live mapping would
+        // be rejected as dirty when opened.
+        suite
+            .controller
+            .shutdown()
+            .expect("Failed to shut down template controller");
+        dir
+    }
+
+    /// Recursively copies the template directory into `dst`. `fs::copy`
+    /// lowers to `copy_file_range` on Linux, which clones data blocks
+    /// instead of copying them on filesystems with reflink support, so the
+    /// state file costs a metadata update there and a plain copy elsewhere.
+    fn clone_dir(src: &Path, dst: &Path) -> std::io::Result<()> {
+        for entry in fs::read_dir(src)? {
+            let entry = entry?;
+            let target = dst.join(entry.file_name());
+            if entry.file_type()?.is_dir() {
+                fs::create_dir_all(&target)?;
+                clone_dir(&entry.path(), &target)?;
+            } else {
+                fs::copy(entry.path(), &target)?;
+            }
+        }
+        Ok(())
+    }
+
+    fn test_chain_id() -> Id {
+        Id::from_str("c8c4a47932fc0a938972f48f32489e7e91f024697e498ceb3d3c3afcf28f68b6").unwrap()
+    }
+
+    fn test_node_config(private_key: &PrivateKey) -> Vec<u8> {
+        json!({
+            "producer_name": "pulse",
+            "producer_key": private_key.to_string(),
+        })
+        .to_string()
+        .into_bytes()
+    }
+
     impl Testing {
         pub async fn new() -> Self {
             let temp_dir = tempfile::tempdir().expect("Failed to create temp dir");
-            let chain_id =
-                Id::from_str("c8c4a47932fc0a938972f48f32489e7e91f024697e498ceb3d3c3afcf28f68b6")
-                    .unwrap();
-            let mut controller = Controller::new();
+            clone_dir(GENESIS_TEMPLATE.path(), temp_dir.path())
+                .expect("Failed to clone genesis template");
+
             let private_key = get_private_key(PULSE_NAME.into(), "active");
-            let genesis = generate_genesis(&private_key);
-            let config_bytes = json!({
-                "producer_name": "pulse",
-                "producer_key": private_key.to_string(),
-            })
-            .to_string()
-            .into_bytes();
-
-            // Initialize controller
+            let mut controller = Controller::new();
+
+            // The cloned database carries a positive revision, so initialize
+            // reopens it as existing state: genesis bootstrap and the bios
+            // deploy from the template are not repeated.
             controller
                 .initialize(
-                    &chain_id,
-                    &config_bytes,
-                    &genesis,
+                    &test_chain_id(),
+                    &test_node_config(&private_key),
+                    &generate_genesis(&private_key),
                     temp_dir.path().to_str().unwrap(),
                 )
                 .expect("Failed to initialize controller");
 
-            let mut suite = Testing {
+            Testing {
                 controller,
                 pending_block_state: None,
-            };
-
-            suite
-                .set_bios_contract()
-                .expect("Failed to set bios contract");
-
-            suite
+            }
         }
 
         pub fn create_accounts(
@@ -33,7 +33,7 @@ mod auth_tests {
                 authorization: vec![PermissionLevel {
                     actor: name!("aligncheck").into(),
                     permission: name!("active").into(),
-                }],
+                }].into(),
                 data: Arc::from(vec![]),
             });
             let trx = trx.sign(
@@ -66,7 +66,7 @@ mod auth_tests {
             authorization: vec![PermissionLevel {
                 actor: name!("entrycheck").into(),
                 permission: name!("active").into(),
-            }],
+            }].into(),
             data: Arc::from(vec![]),
         });
         let trx = trx.sign(
@@ -92,7 +92,7 @@ mod auth_tests {
             authorization: vec![PermissionLevel {
                 actor: name!("entrycheck").into(),
                 permission: name!("active").into(),
-            }],
+            }].into(),
             data: Arc::from(vec![]),
         });
         let trx = trx.sign(
@@ -126,7 +126,7 @@ mod auth_tests {
             authorization: vec![PermissionLevel {
                 actor: name!("loop").into(),
                 permission: name!("active").into(),
-            }],
+            }].into(),
             data: Arc::from(vec![]),
         });
         let trx = trx.sign(
@@ -16,9 +16,11 @@
 //! | Memory store/load offset          | < 33 MiB                    |
 //! | `apply(i64, i64, i64)` export     | required                    |
 
+use std::thread;
+
 use wasmparser::{
-    BinaryReaderError, Export, ExternalKind, FuncType, GlobalType, MemoryType, Operator, Parser,
-    Payload, TableType, ValType,
+    BinaryReaderError, Export, ExternalKind, FuncType, FunctionBody, GlobalType, MemoryType,
+    Operator, Parser, Payload, TableType, ValType,
 };
 
 // ---------------------------------------------------------------------------
@@ -132,23 +134,28 @@ pub type Result<T> = std::result::Result<T, ValidationError>;
 // Collected module-level information
 // ---------------------------------------------------------------------------
 
-/// Intermediate representation collected during a single pass of the WASM binary.
+/// State carried across sections during the single streaming pass.
+///
+/// Sections are validated as they are read rather than collected and
+/// re-walked afterwards, so no per-entry data is buffered: only the type
+/// table and the function-type indices survive the pass, because the export
+/// section needs them to resolve the `apply` signature (types and functions
+/// precede exports in the binary section order, which the parser enforces).
 #[derive(Default)]
 struct ModuleInfo {
-    /// (min_pages, max_pages) for each defined memory.
-    memories: Vec<MemoryType>,
-    /// Defined tables.
-    tables: Vec<TableType>,
-    /// Defined globals.
-    globals: Vec<GlobalType>,
     /// Function type indices – one entry per function *definition* (not import).
     func_type_indices: Vec<u32>,
     /// All declared types (function signatures).
     types: Vec<FuncType>,
-    /// Exports.
-    exports: Vec<(String, ExternalKind, u32)>,
     /// Number of imported functions (needed to map export index → local func).
     num_imported_functions: u32,
+    /// Running byte total of mutable globals, imported and defined.
+    mutable_global_bytes: u32,
+    /// Whether the first memory / table has been checked already.
+    seen_memory: bool,
+    seen_table: bool,
+    /// Whether an `apply (i64, i64, i64) -> ()` function export was found.
+    apply_exported: bool,
 }
 
 // ---------------------------------------------------------------------------
@@ -167,110 +174,103 @@ fn val_type_byte_size(ty: &ValType) -> u32 {
 }
 
 // ---------------------------------------------------------------------------
-// Module-level validators (mirrors the C++ `*_validation_visitor` structs)
+// Module-level validators (mirrors the C++ `*_validation_visitor` structs),
+// applied per entry as each section streams past
 // ---------------------------------------------------------------------------
 
-/// `memories_validation_visitor::validate`
-fn validate_memories(info: &ModuleInfo) -> Result<()> {
-    if let Some(mem) = info.memories.first() {
+impl ModuleInfo {
+    /// `memories_validation_visitor::validate` – only the first memory is
+    /// constrained, matching the C++ visitor.
+    fn check_memory(&mut self, mem: &MemoryType) -> Result<()> {
+        if self.seen_memory {
+            return Ok(());
+        }
+        self.seen_memory = true;
         let min_bytes = (mem.initial as u64) * constraints::WASM_PAGE_SIZE;
         if min_bytes > constraints::MAXIMUM_LINEAR_MEMORY {
             return Err(ValidationError::MemoryTooLarge);
         }
+        Ok(())
     }
-    Ok(())
-}
 
-/// `tables_validation_visitor::validate`
-fn validate_tables(info: &ModuleInfo) -> Result<()> {
-    if let Some(table) = info.tables.first() {
+    /// `tables_validation_visitor::validate` – first table only, as above.
+    fn check_table(&mut self, table: &TableType) -> Result<()> {
+        if self.seen_table {
+            return Ok(());
+        }
+        self.seen_table = true;
         if (table.initial as u64) > constraints::MAXIMUM_TABLE_ELEMENTS {
             return Err(ValidationError::TableTooLarge);
         }
+        Ok(())
     }
-    Ok(())
-}
 
-/// `globals_validation_visitor::validate`
-///
-/// Note: the original C++ uses fall-through switch semantics (no `break`),
-/// which means i64/f64 add 8 bytes total and i32/f32 add 4 bytes.
-fn validate_globals(info: &ModuleInfo) -> Result<()> {
-    let mut mutable_globals_total_size: u32 = 0;
-    for global in &info.globals {
+    /// `globals_validation_visitor::validate`, one global at a time.
+    ///
+    /// Note: the original C++ uses fall-through switch semantics (no
+    /// `break`), which means i64/f64 add 8 bytes total and i32/f32 add 4.
+    fn check_global(&mut self, global: &GlobalType) -> Result<()> {
         if !global.mutable {
-            continue;
+            return Ok(());
         }
         match global.content_type {
             ValType::I64 | ValType::F64 => {
                 // C++ fall-through: 4 (from i64/f64 case) + 4 (from i32/f32 case) = 8
-                mutable_globals_total_size += 8;
+                self.mutable_global_bytes += 8;
             }
             ValType::I32 | ValType::F32 => {
-                mutable_globals_total_size += 4;
+                self.mutable_global_bytes += 4;
             }
             _ => {
                 return Err(ValidationError::UnexpectedGlobalType);
             }
         }
+        if self.mutable_global_bytes > constraints::MAXIMUM_MUTABLE_GLOBALS {
+            return Err(ValidationError::TooManyMutableGlobals);
+        }
+        Ok(())
     }
-    if mutable_globals_total_size > constraints::MAXIMUM_MUTABLE_GLOBALS {
-        return Err(ValidationError::TooManyMutableGlobals);
-    }
-    Ok(())
-}
 
-/// `maximum_function_stack_visitor::validate`
-fn validate_function_stack(info: &ModuleInfo) -> Result<()> {
-    for &type_idx in &info.func_type_indices {
-        if let Some(func_type) = info.types.get(type_idx as usize) {
+    /// `maximum_function_stack_visitor::validate` for one function's type.
+    ///
+    /// Non-parameter locals are accounted for in the code-section body walk;
+    /// with only type info available here the check is that params alone do
+    /// not already exceed the limit.
+    fn check_function_params(&self, type_idx: u32) -> Result<()> {
+        if let Some(func_type) = self.types.get(type_idx as usize) {
             let param_bytes: u32 = func_type.params().iter().map(val_type_byte_size).sum();
-            // Non-parameter locals are validated separately in the code section
-            // pass, but we record the param contribution here. The local bytes
-            // are accumulated when we parse the code section bodies.
-            //
-            // For the *module-level* check we only have type info (no locals yet),
-            // so we just verify params don't already exceed the limit.
             if param_bytes > constraints::MAXIMUM_FUNC_LOCAL_BYTES {
                 return Err(ValidationError::FunctionStackTooLarge);
             }
         }
+        Ok(())
     }
-    Ok(())
-}
 
-/// `ensure_apply_exported_visitor::validate`
-///
-/// Searches for an export named `"apply"` that is a function with signature
-/// `(i64, i64, i64) -> ()`.
-fn validate_apply_export(info: &ModuleInfo) -> Result<()> {
-    for (name, kind, index) in &info.exports {
-        if *kind != ExternalKind::Func || name != "apply" {
-            continue;
+    /// `ensure_apply_exported_visitor::validate`, resolved as the export
+    /// section streams: records whether an export named `"apply"` is a
+    /// function with signature `(i64, i64, i64) -> ()`. Types and function
+    /// indices are already complete here, so no export names are buffered.
+    fn check_apply_export(&mut self, name: &str, kind: ExternalKind, index: u32) {
+        if kind != ExternalKind::Func || name != "apply" {
+            return;
         }
-        // Map the export function index to a type. Export indices are in the
-        // combined function index space: imports first, then definitions.
-        let type_idx = if *index < info.num_imported_functions {
-            // Imported function – we don't track import types in this
-            // simplified impl, so we skip. In practice the apply function
-            // should always be defined, not imported.
-            continue;
-        } else {
-            let local_idx = (*index - info.num_imported_functions) as usize;
-            match info.func_type_indices.get(local_idx) {
-                Some(&ti) => ti,
-                None => continue,
-            }
+        // Export indices are in the combined function index space: imports
+        // first, then definitions. An imported apply is not accepted — in
+        // practice the apply function is always defined.
+        if index < self.num_imported_functions {
+            return;
+        }
+        let local_idx = (index - self.num_imported_functions) as usize;
+        let Some(&type_idx) = self.func_type_indices.get(local_idx) else {
+            return;
         };
-
-        if let Some(func_type) = info.types.get(type_idx as usize) {
+        if let Some(func_type) = self.types.get(type_idx as usize) {
             let expected_params: &[ValType] = &[ValType::I64, ValType::I64, ValType::I64];
             if func_type.params() == expected_params && func_type.results().is_empty() {
-                return Ok(());
+                self.apply_exported = true;
             }
         }
     }
-    Err(ValidationError::ApplyNotExported)
 }
 
 // ---------------------------------------------------------------------------
@@ -610,6 +610,7 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
 
     let parser = Parser::new(0);
     let mut info = ModuleInfo::default();
+    let mut bodies: Vec<FunctionBody> = Vec::new();
 
     for payload in parser.parse_all(wasm) {
         let payload = payload?;
@@ -638,13 +639,13 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
                             info.num_imported_functions += 1;
                         }
                         wasmparser::TypeRef::Memory(mem) => {
-                            info.memories.push(mem);
+                            info.check_memory(&mem)?;
                         }
                         wasmparser::TypeRef::Table(table) => {
-                            info.tables.push(table);
+                            info.check_table(&table)?;
                         }
                         wasmparser::TypeRef::Global(global) => {
-                            info.globals.push(global);
+                            info.check_global(&global)?;
                         }
                         _ => {}
                     }
@@ -657,6 +658,7 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
 
                 for func in reader {
                     let type_idx = func?;
+                    info.check_function_params(type_idx)?;
                     info.func_type_indices.push(type_idx);
                     count += 1;
                 }
@@ -669,7 +671,7 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
             // ----- Memory section ------------------------------------------
             Payload::MemorySection(reader) => {
                 for mem in reader {
-                    info.memories.push(mem?);
+                    info.check_memory(&mem?)?;
                 }
             }
 
@@ -677,7 +679,7 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
             Payload::TableSection(reader) => {
                 for table in reader {
                     let table = table?;
-                    info.tables.push(table.ty);
+                    info.check_table(&table.ty)?;
                 }
             }
 
@@ -685,7 +687,7 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
             Payload::GlobalSection(reader) => {
                 for global in reader {
                     let global = global?;
-                    info.globals.push(global.ty);
+                    info.check_global(&global.ty)?;
                 }
             }
 
@@ -693,7 +695,7 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
             Payload::ExportSection(reader) => {
                 for export in reader {
                     let Export { name, kind, index } = export?;
-                    info.exports.push((name.to_string(), kind, index));
+                    info.check_apply_export(name, kind, index);
                 }
             }
 
@@ -718,62 +720,101 @@ pub fn validate_wasm(wasm: &[u8]) -> Result<()> {
 
             // ----- Code section --------------------------------------------
             Payload::CodeSectionEntry(body) => {
-                // Determine which local function index this is.
-                // `CodeSectionEntry` payloads arrive in order, starting from 0.
-                // We use a simple counter via the length of func_type_indices
-                // already consumed. We need to figure out the function's type
-                // to include param bytes.
-                let local_func_idx = {
-                    // We will use a static-like approach: count how many code
-                    // bodies we have seen. We track this via a separate counter
-                    // stored on `info`, but since ModuleInfo doesn't have one,
-                    // we compute it from the number of types already validated.
-                    // Instead, just compute local bytes directly.
-                    0usize // placeholder – we compute bytes below
-                };
-                let _ = local_func_idx; // suppress warning
-
-                // --- Validate function locals + params --------------------
-                let locals_reader = body.get_locals_reader()?;
-                let mut local_bytes: u32 = 0;
-
-                for local in locals_reader {
-                    let (count, val_type) = local?;
-                    local_bytes += count * val_type_byte_size(&val_type);
-                }
+                // Only the body's range is kept; the code section follows
+                // every structural section, so by the time bodies stream in,
+                // a module failing a cheap check has already been rejected.
+                // The opcode walk itself runs (possibly striped across
+                // threads) after the pass.
+                bodies.push(body);
+            }
 
-                // We can't easily correlate code bodies to func type indices
-                // in a single streaming pass without a counter, so we do a
-                // conservative check: local bytes alone must not exceed the
-                // limit (params are validated separately in
-                // `validate_function_stack`). The combined check happens in
-                // the full-module validators after the pass.
-                if local_bytes > constraints::MAXIMUM_FUNC_LOCAL_BYTES {
-                    return Err(ValidationError::FunctionStackTooLarge);
-                }
+            _ => {}
+        }
+    }
 
-                // --- Validate instructions --------------------------------
-                let ops_reader = body.get_operators_reader()?;
-                let mut nesting_depth: u32 = 0;
+    // ---- Whole-module checks that need the full pass -----------------------
+    if !info.apply_exported {
+        return Err(ValidationError::ApplyNotExported);
+    }
 
-                for op in ops_reader {
-                    let op = op?;
-                    validate_opcode_whitelist(&op)?;
-                    validate_operator_offset(&op)?;
-                    validate_nesting(&op, &mut nesting_depth)?;
-                }
-            }
+    // ---- Function bodies ---------------------------------------------------
+    validate_code_bodies(&bodies)
+}
 
-            _ => {}
+/// Byte-size of the code section above which function bodies are validated
+/// across worker threads; below this the per-thread overhead outweighs the
+/// opcode walk.
+const PARALLEL_VALIDATION_THRESHOLD: usize = 128 * 1024;
+
+/// Validates every function body, fanning large contracts out across worker
+/// threads. Bodies are independent — each walk is locals plus a linear pass
+/// over the instructions — so stripes of contiguous bodies run concurrently.
+/// The error returned is always the one from the earliest offending body,
+/// keeping messages identical to the sequential walk regardless of thread
+/// timing.
+fn validate_code_bodies(bodies: &[FunctionBody]) -> Result<()> {
+    let total_bytes: usize = bodies.iter().map(|b| b.range().len()).sum();
+    let workers = thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1)
+        .min(bodies.len());
+
+    if total_bytes < PARALLEL_VALIDATION_THRESHOLD || workers <= 1 {
+        for body in bodies {
+            validate_function_body(body)?;
         }
+        return Ok(());
     }
 
-    // ---- Module-level validators ------------------------------------------
-    validate_memories(&info)?;
-    validate_tables(&info)?;
-    validate_globals(&info)?;
-    validate_function_stack(&info)?;
-    validate_apply_export(&info)?;
+    thread::scope(|scope| {
+        let chunk = bodies.len().div_ceil(workers);
+        let handles: Vec<_> = bodies
+            .chunks(chunk)
+            .map(|stripe| {
+                scope.spawn(move || -> Result<()> {
+                    for body in stripe {
+                        validate_function_body(body)?;
+                    }
+                    Ok(())
+                })
+            })
+            .collect();
+
+        // Stripes hold contiguous runs of bodies and each stops at its first
+        // violation, so joining in order surfaces the earliest error.
+        for handle in handles {
+            handle.join().expect("validation worker panicked")?;
+        }
+        Ok(())
+    })
+}
+
+/// `validate()` for a single function body: locals byte budget, opcode
+/// whitelist, memory-offset bound and nesting depth.
+fn validate_function_body(body: &FunctionBody) -> Result<()> {
+    // Local bytes alone must not exceed the limit; params are accounted for
+    // separately by `check_function_params` as the function section streams.
+    let locals_reader = body.get_locals_reader()?;
+    let mut local_bytes: u32 = 0;
+
+    for local in locals_reader {
+        let (count, val_type) = local?;
+        local_bytes += count * val_type_byte_size(&val_type);
+    }
+
+    if local_bytes > constraints::MAXIMUM_FUNC_LOCAL_BYTES {
+        return Err(ValidationError::FunctionStackTooLarge);
+    }
+
+    let ops_reader = body.get_operators_reader()?;
+    let mut nesting_depth: u32 = 0;
+
+    for op in ops_reader {
+        let op = op?;
+        validate_opcode_whitelist(&op)?;
+        validate_operator_offset(&op)?;
+        validate_nesting(&op, &mut nesting_depth)?;
+    }
 
     Ok(())
 }
@@ -1528,4 +1569,44 @@ mod tests {
         let wasm = wat::parse_str(&wat).unwrap();
         assert!(validate_wasm(&wasm).is_err());
     }
+
+    /// A many-function module whose code section crosses
+    /// `PARALLEL_VALIDATION_THRESHOLD`, forcing the striped path.
+    fn large_module(poison_last_fn: bool) -> Vec<u8> {
+        let mut wat = String::from(
+            "(module \
+         (memory $0 1) \
+         (export \"apply\" (func $apply)) \
+         (func $apply (param $0 i64) (param $1 i64) (param $2 i64))",
+        );
+        for i in 0..64 {
+            write!(wat, " (func $f{i}").unwrap();
+            for _ in 0..1000 {
+                wat.push_str(" (drop (i64.const 7))");
+            }
+            if poison_last_fn && i == 63 {
+                // Vector ops are outside the opcode whitelist.
+                wat.push_str(" (drop (v128.const i32x4 1 2 3 4))");
+            }
+            wat.push(')');
+        }
+        wat.push(')');
+        wat::parse_str(&wat).unwrap()
+    }
+
+    #[test]
+    fn test_parallel_validation_of_large_module() {
+        let wasm = large_module(false);
+        assert!(wasm.len() > PARALLEL_VALIDATION_THRESHOLD);
+        assert!(validate_wasm(&wasm).is_ok());
+    }
+
+    #[test]
+    fn test_parallel_validation_surfaces_body_error() {
+        let wasm = large_module(true);
+        assert!(matches!(
+            validate_wasm(&wasm).unwrap_err(),
+            ValidationError::BlacklistedOpcode(_)
+        ));
+    }
 }